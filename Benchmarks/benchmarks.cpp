@@ -0,0 +1,1808 @@
+#include "nostrautils/NostraUtils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+/*
+ * A minimal benchmark harness. Each benchmark is declared using NOU_BENCHMARK() and prints its results using
+ * report(). The executable runs all benchmarks, or only the ones whose names are passed as arguments.
+ *
+ * The numbers are only meaningful in an optimized build (CMAKE_BUILD_TYPE=Release).
+ */
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Benchmark
+	{
+		const char *m_name;
+		void (*m_function)();
+	};
+
+	NOU::NOU_DAT_ALG::Vector<Benchmark>& benchmarks()
+	{
+		static NOU::NOU_DAT_ALG::Vector<Benchmark> ret;
+		return ret;
+	}
+
+	struct BenchmarkRegistrar
+	{
+		BenchmarkRegistrar(const char *name, void (*function)())
+		{
+			benchmarks().pushBack(Benchmark{ name, function });
+		}
+	};
+
+	/**
+	\return The time in seconds that the passed invocable took to execute.
+	*/
+	template<typename F>
+	double measure(F &&function)
+	{
+		Clock::time_point start = Clock::now();
+
+		function();
+
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	/**
+	\brief Prints a single result of the current benchmark.
+	*/
+	void report(const char *label, double value, const char *unit)
+	{
+		std::printf("  %-56s %14.2f %s\n", label, value, unit);
+	}
+
+	/**
+	\return The thread counts that scaling benchmarks are run with: the powers of two up to the amount of
+	        hardware threads, but at least up to 4 and at most up to \p limit.
+	*/
+	NOU::NOU_DAT_ALG::Vector<NOU::sizeType> threadCounts(NOU::sizeType limit = 32)
+	{
+		NOU::sizeType max = NOU::NOU_CORE::max<NOU::sizeType>(std::thread::hardware_concurrency(), 4);
+		max = NOU::NOU_CORE::min(max, limit);
+
+		NOU::NOU_DAT_ALG::Vector<NOU::sizeType> ret;
+
+		for (NOU::sizeType i = 1; i <= max; i *= 2)
+			ret.pushBack(i);
+
+		return ret;
+	}
+
+	/**
+	\brief Yields until the counter has reached the passed value.
+	*/
+	void waitFor(const std::atomic<NOU::sizeType> &counter, NOU::sizeType value)
+	{
+		while (counter.load(std::memory_order_acquire) < value)
+			std::this_thread::yield();
+	}
+
+	const char* modeName(NOU::NOU_THREAD::SchedulerMode mode)
+	{
+		return mode == NOU::NOU_THREAD::SchedulerMode::TASK_HEAP ? "TASK_HEAP" : "WORK_STEALING";
+	}
+}
+
+#define NOU_BENCHMARK(name)                                                                                  \
+	static void benchmark##name();                                                                           \
+	static BenchmarkRegistrar benchmarkRegistrar##name(#name, &benchmark##name);                             \
+	static void benchmark##name()
+
+
+
+//each task submits two children until the depth is 0
+static void submitTree(NOU::NOU_THREAD::ThreadManager *manager, std::atomic<NOU::sizeType> *counter,
+	NOU::sizeType depth)
+{
+	if (depth > 0)
+	{
+		manager->submit(&submitTree, manager, counter, depth - 1);
+		manager->submit(&submitTree, manager, counter, depth - 1);
+	}
+
+	counter->fetch_add(1, std::memory_order_release);
+}
+
+NOU_BENCHMARK(ThreadManager)
+{
+	const NOU::sizeType flatCount = 200000;
+	const NOU::sizeType treeDepth = 17;
+	const NOU::sizeType treeCount = (NOU::sizeType(1) << (treeDepth + 1)) - 1;
+
+	for (NOU::NOU_THREAD::SchedulerMode mode : { NOU::NOU_THREAD::SchedulerMode::TASK_HEAP,
+		NOU::NOU_THREAD::SchedulerMode::WORK_STEALING })
+	{
+		for (NOU::sizeType threads : threadCounts())
+		{
+			NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+			configuration.schedulerMode = mode;
+			configuration.threadCount = threads;
+
+			NOU::NOU_THREAD::ThreadManager manager(configuration);
+
+			std::atomic<NOU::sizeType> counter(0);
+			char label[128];
+
+			//short tasks that are all pushed by the main thread
+			double flat = measure([&]()
+			{
+				for (NOU::sizeType i = 0; i < flatCount; i++)
+				{
+					manager.submit([](std::atomic<NOU::sizeType> *c)
+					{
+						c->fetch_add(1, std::memory_order_release);
+					}, &counter);
+				}
+
+				waitFor(counter, flatCount);
+			});
+
+			std::snprintf(label, sizeof(label), "%s, %zu threads, flat", modeName(mode), threads);
+			report(label, flatCount / flat, "tasks/s");
+
+			counter.store(0);
+
+			//short tasks that are pushed by the tasks themselves
+			double tree = measure([&]()
+			{
+				manager.submit(&submitTree, &manager, &counter, treeDepth);
+				waitFor(counter, treeCount);
+			});
+
+			std::snprintf(label, sizeof(label), "%s, %zu threads, nested", modeName(mode), threads);
+			report(label, treeCount / tree, "tasks/s");
+		}
+	}
+}
+
+
+
+/**
+\brief Runs \p producers threads that push \p total values (in sum) and \p consumers threads that pop them.
+       \p tryPush and \p tryPop must not block, on failure the thread yields and tries again.
+
+\return The time in seconds until all values have been popped.
+*/
+template<typename PUSH, typename POP>
+static double runProducersConsumers(NOU::sizeType producers, NOU::sizeType consumers, NOU::sizeType total,
+	PUSH tryPush, POP tryPop)
+{
+	std::atomic<NOU::sizeType> popped(0);
+	std::atomic<NOU::boolean> start(false);
+
+	NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> threads;
+
+	for (NOU::sizeType i = 0; i < producers; i++)
+	{
+		NOU::sizeType count = total / producers + (i < total % producers ? 1 : 0);
+
+		threads.pushBack(NOU::NOU_THREAD::ThreadWrapper([&start, &tryPush, count]()
+		{
+			while (!start.load())
+				std::this_thread::yield();
+
+			for (NOU::sizeType j = 0; j < count; j++)
+			{
+				while (!tryPush(static_cast<NOU::uint64>(j)))
+					std::this_thread::yield();
+			}
+		}));
+	}
+
+	for (NOU::sizeType i = 0; i < consumers; i++)
+	{
+		threads.pushBack(NOU::NOU_THREAD::ThreadWrapper([&start, &popped, &tryPop, total]()
+		{
+			while (!start.load())
+				std::this_thread::yield();
+
+			NOU::uint64 value;
+
+			while (popped.load(std::memory_order_relaxed) < total)
+			{
+				if (tryPop(value))
+					popped.fetch_add(1, std::memory_order_relaxed);
+				else
+					std::this_thread::yield();
+			}
+		}));
+	}
+
+	return measure([&]()
+	{
+		start.store(true);
+
+		for (NOU::sizeType i = 0; i < threads.size(); i++)
+			threads[i].join();
+	});
+}
+
+NOU_BENCHMARK(ConcurrentQueue)
+{
+	const NOU::sizeType total = 2000000;
+	const NOU::sizeType capacity = 1024;
+
+	for (NOU::sizeType threads : { 1, 4, 16 })
+	{
+		char label[128];
+
+		{
+			NOU::NOU_DAT_ALG::ConcurrentQueue<NOU::uint64> queue(capacity);
+
+			double time = runProducersConsumers(threads, threads, total,
+				[&queue](NOU::uint64 value) { return queue.tryPush(value); },
+				[&queue](NOU::uint64 &out) { return queue.tryPop(out); });
+
+			std::snprintf(label, sizeof(label), "ConcurrentQueue MPMC, %zuP%zuC", threads, threads);
+			report(label, total / time, "ops/s");
+		}
+
+		if (threads == 1)
+		{
+			NOU::NOU_DAT_ALG::ConcurrentQueue<NOU::uint64, NOU::NOU_DAT_ALG::ConcurrentQueueMode::SPSC>
+				queue(capacity);
+
+			double time = runProducersConsumers(1, 1, total,
+				[&queue](NOU::uint64 value) { return queue.tryPush(value); },
+				[&queue](NOU::uint64 &out) { return queue.tryPop(out); });
+
+			report("ConcurrentQueue SPSC, 1P1C", total / time, "ops/s");
+		}
+
+		{
+			//the same capacity as the lock-free queues
+			NOU::NOU_DAT_ALG::FastQueue<NOU::uint64> queue(capacity);
+			NOU::NOU_THREAD::Mutex mutex;
+
+			double time = runProducersConsumers(threads, threads, total,
+				[&queue, &mutex, capacity](NOU::uint64 value)
+				{
+					NOU::NOU_THREAD::Lock lock(mutex);
+
+					if (queue.size() == capacity)
+						return false;
+
+					queue.pushBack(value);
+					return true;
+				},
+				[&queue, &mutex](NOU::uint64 &out)
+				{
+					NOU::NOU_THREAD::Lock lock(mutex);
+
+					if (queue.size() == 0)
+						return false;
+
+					out = queue.popFront();
+					return true;
+				});
+
+			std::snprintf(label, sizeof(label), "FastQueue + Mutex, %zuP%zuC", threads, threads);
+			report(label, total / time, "ops/s");
+		}
+	}
+}
+
+
+
+NOU_BENCHMARK(Parallel)
+{
+	const NOU::sizeType count = 10000000;
+
+	NOU::NOU_DAT_ALG::Vector<NOU::uint64> values(count);
+
+	for (NOU::sizeType i = 0; i < count; i++)
+		values.pushBack(i);
+
+	NOU::uint64 *data = values.data();
+
+	auto transform = [data](NOU::sizeType i) { data[i] = data[i] * 2654435761u + 1; };
+
+	double sequential = measure([&]()
+	{
+		for (NOU::sizeType i = 0; i < count; i++)
+			transform(i);
+	});
+
+	double parallel = measure([&]() { NOU::NOU_THREAD::parallelFor(0, count, transform); });
+
+	report("for loop, 1e7 elements", sequential * 1000, "ms");
+	report("parallelFor, 1e7 elements", parallel * 1000, "ms");
+
+	volatile NOU::uint64 sink = 0;
+
+	sequential = measure([&]()
+	{
+		NOU::uint64 sum = 0;
+
+		for (NOU::sizeType i = 0; i < count; i++)
+			sum += data[i];
+
+		sink = sum;
+	});
+
+	parallel = measure([&]()
+	{
+		sink = NOU::NOU_THREAD::parallelReduce(0, count, 0, [data](NOU::sizeType i) { return data[i]; });
+	});
+
+	//the same reduction with an accumulator that can be inlined
+	double inlined = measure([&]()
+	{
+		sink = NOU::NOU_THREAD::parallelReduce(0, count, 0, [data](NOU::sizeType i) { return data[i]; },
+			[](NOU::uint64 previous, NOU::uint64 current) { return previous + current; });
+	});
+
+	report("sum loop, 1e7 elements", sequential * 1000, "ms");
+	report("parallelReduce, 1e7 elements", parallel * 1000, "ms");
+	report("parallelReduce (lambda accumulator), 1e7 elements", inlined * 1000, "ms");
+
+	//the same pseudo random values for both sorts
+	NOU::NOU_DAT_ALG::Vector<NOU::uint64> copy(count);
+
+	for (NOU::sizeType i = 0; i < count; i++)
+	{
+		data[i] = (i * 0x9E3779B97F4A7C15ull) >> 17;
+		copy.pushBack(data[i]);
+	}
+
+	sequential = measure([&]()
+	{
+		NOU::NOU_DAT_ALG::qsort(copy.data(), 0, static_cast<NOU::int64>(count) - 1);
+	});
+
+	parallel = measure([&]() { NOU::NOU_THREAD::parallelQuicksort(values); });
+
+	report("qsort, 1e7 elements", sequential * 1000, "ms");
+	report("parallelQuicksort, 1e7 elements", parallel * 1000, "ms");
+}
+
+
+
+//distinct, scattered keys; the keys count..2*count-1 are never inserted
+static NOU::uint64 hashMapKey(NOU::sizeType i)
+{
+	return static_cast<NOU::uint64>(i) * 0x9E3779B97F4A7C15ull;
+}
+
+/**
+\brief Inserts \p count keys into \p map, then looks up all of them and the same amount of missing keys.
+       \p contains must return whether a key is mapped.
+*/
+template<typename MAP, typename CONTAINS>
+static void runHashMap(const char *name, MAP &map, NOU::sizeType count, CONTAINS contains)
+{
+	char label[128];
+	volatile NOU::sizeType sink = 0;
+
+	double insert = measure([&]()
+	{
+		for (NOU::sizeType i = 0; i < count; i++)
+			map.map(hashMapKey(i), static_cast<NOU::uint64>(i));
+	});
+
+	double hit = measure([&]()
+	{
+		NOU::sizeType found = 0;
+
+		for (NOU::sizeType i = 0; i < count; i++)
+			found += contains(map, hashMapKey(i));
+
+		sink = found;
+	});
+
+	double miss = measure([&]()
+	{
+		NOU::sizeType found = 0;
+
+		for (NOU::sizeType i = count; i < 2 * count; i++)
+			found += contains(map, hashMapKey(i));
+
+		sink = found;
+	});
+
+	std::snprintf(label, sizeof(label), "%s, %zu keys, insert", name, count);
+	report(label, insert / count * 1e9, "ns/op");
+	std::snprintf(label, sizeof(label), "%s, %zu keys, lookup hit", name, count);
+	report(label, hit / count * 1e9, "ns/op");
+	std::snprintf(label, sizeof(label), "%s, %zu keys, lookup miss", name, count);
+	report(label, miss / count * 1e9, "ns/op");
+}
+
+NOU_BENCHMARK(HashMap)
+{
+	using Flat = NOU::NOU_DAT_ALG::FlatHashMap<NOU::uint64, NOU::uint64>;
+	using Bucket = NOU::NOU_DAT_ALG::HashMap<NOU::uint64, NOU::uint64>;
+
+	auto flatContains = [](const Flat &map, NOU::uint64 key) { return map.find(key) != nullptr; };
+	auto bucketContains = [](const Bucket &map, NOU::uint64 key) { return map.containsKey(key); };
+
+	for (NOU::sizeType count : { 1000, 100000, 10000000 })
+	{
+		{
+			//grows from the minimum capacity
+			Flat map;
+			runHashMap("FlatHashMap", map, count, flatContains);
+		}
+
+		{
+			//HashMap never rehashes, this gives it one bucket per key
+			Bucket map(count);
+			runHashMap("HashMap, one bucket per key", map, count, bucketContains);
+		}
+
+		//with the default 20 buckets, 1e7 keys would need ~1e12 key comparisons
+		if (count <= 100000)
+		{
+			Bucket map;
+			runHashMap("HashMap, default buckets", map, count, bucketContains);
+		}
+	}
+}
+
+
+
+/**
+\brief Runs \p threads threads that, in sum, allocate and deallocate \p total objects. Each thread allocates
+       a few objects at once before deallocating them again.
+
+\return The time in seconds until all threads are done.
+*/
+template<typename ALLOCATE, typename DEALLOCATE>
+static double runAllocatorChurn(NOU::sizeType threads, NOU::sizeType total, ALLOCATE allocate,
+	DEALLOCATE deallocate)
+{
+	const NOU::sizeType live = 16;
+
+	std::atomic<NOU::boolean> start(false);
+
+	NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> workers;
+
+	for (NOU::sizeType i = 0; i < threads; i++)
+	{
+		workers.pushBack(NOU::NOU_THREAD::ThreadWrapper([&start, &allocate, &deallocate, total, threads, live]()
+		{
+			NOU::uint64 *objects[live];
+
+			while (!start.load())
+				std::this_thread::yield();
+
+			for (NOU::sizeType j = 0; j < total / threads; j += live)
+			{
+				for (NOU::sizeType k = 0; k < live; k++)
+					objects[k] = allocate(static_cast<NOU::uint64>(k));
+
+				for (NOU::sizeType k = 0; k < live; k++)
+					deallocate(objects[k]);
+			}
+		}));
+	}
+
+	return measure([&]()
+	{
+		start.store(true);
+
+		for (NOU::sizeType i = 0; i < workers.size(); i++)
+			workers[i].join();
+	});
+}
+
+NOU_BENCHMARK(PoolAllocator)
+{
+	const NOU::sizeType total = 8000000;
+
+	for (NOU::sizeType threads : { 1, 2, 4, 8, 16, 32 })
+	{
+		char label[128];
+
+		{
+			NOU::NOU_MEM_MNGT::ConcurrentPoolAllocator<NOU::uint64> allocator;
+
+			double time = runAllocatorChurn(threads, total,
+				[&allocator](NOU::uint64 value) { return allocator.allocate(value); },
+				[&allocator](NOU::uint64 *object) { allocator.deallocate(object); });
+
+			std::snprintf(label, sizeof(label), "ConcurrentPoolAllocator, %zu threads", threads);
+			report(label, total / time, "allocs/s");
+		}
+
+		{
+			NOU::NOU_MEM_MNGT::PoolAllocator<NOU::uint64> allocator;
+			NOU::NOU_THREAD::Mutex mutex;
+
+			double time = runAllocatorChurn(threads, total,
+				[&allocator, &mutex](NOU::uint64 value)
+				{
+					NOU::NOU_THREAD::Lock lock(mutex);
+					return allocator.allocate(value);
+				},
+				[&allocator, &mutex](NOU::uint64 *object)
+				{
+					NOU::NOU_THREAD::Lock lock(mutex);
+					allocator.deallocate(object);
+				});
+
+			std::snprintf(label, sizeof(label), "PoolAllocator + Mutex, %zu threads", threads);
+			report(label, total / time, "allocs/s");
+		}
+	}
+}
+
+
+
+#ifdef NOU_EXISTS_FEATURE_COROUTINES
+static NOU::NOU_THREAD::Co<NOU::sizeType> coroutineIdentity(NOU::sizeType value)
+{
+	co_return value;
+}
+
+//moves to a worker thread a couple of times
+static NOU::NOU_THREAD::Co<> coroutineYield(std::atomic<NOU::sizeType> *counter, NOU::sizeType yields)
+{
+	for (NOU::sizeType i = 0; i < yields; i++)
+		co_await NOU::NOU_THREAD::schedule();
+
+	counter->fetch_add(1, std::memory_order_release);
+}
+
+static NOU::NOU_THREAD::Co<> coroutineSleep(std::atomic<NOU::sizeType> *counter, NOU::uint64 milliseconds)
+{
+	co_await NOU::NOU_THREAD::sleepFor(milliseconds);
+
+	counter->fetch_add(1, std::memory_order_release);
+}
+
+NOU_BENCHMARK(Coroutine)
+{
+	const NOU::sizeType count = 100000;
+	const NOU::sizeType yields = 10;
+	const NOU::uint64 sleep = 50;
+
+	volatile NOU::sizeType sink = 0;
+
+	//frame allocation, start and destruction of a coroutine that does not suspend
+	double create = measure([&]()
+	{
+		for (NOU::sizeType i = 0; i < count; i++)
+			sink = coroutineIdentity(i).getResult();
+	});
+
+	report("create, run and destroy a coroutine", create / count * 1e9, "ns/op");
+
+	std::atomic<NOU::sizeType> counter(0);
+
+	double resume = measure([&]()
+	{
+		for (NOU::sizeType i = 0; i < count; i++)
+			NOU::NOU_THREAD::spawn(coroutineYield(&counter, yields));
+
+		waitFor(counter, count);
+	});
+
+	report("100000 coroutines, 10 resumptions each", count * yields / resume, "resumptions/s");
+
+	counter.store(0);
+
+	//all coroutines are suspended at the same time, without occupying a thread
+	double sleeping = measure([&]()
+	{
+		for (NOU::sizeType i = 0; i < count; i++)
+			NOU::NOU_THREAD::spawn(coroutineSleep(&counter, sleep));
+
+		waitFor(counter, count);
+	});
+
+	report("100000 coroutines sleeping for 50ms, until all are done", sleeping * 1000, "ms");
+}
+#endif
+
+
+
+template<NOU::sizeType SIZE>
+struct ChurnObject
+{
+	NOU::byte m_data[SIZE];
+
+	explicit ChurnObject(NOU::byte value)
+	{
+		m_data[0] = value;
+	}
+};
+
+/**
+\brief Keeps \p live objects alive and replaces each of them \p rounds times. \p allocate must return a
+       reference to a new object, \p deallocate must free one.
+
+\return The time in seconds per replacement (one deallocation and one allocation).
+*/
+template<typename REF, typename ALLOCATE, typename DEALLOCATE>
+static double runObjectChurn(NOU::sizeType live, NOU::sizeType rounds, ALLOCATE allocate, DEALLOCATE deallocate)
+{
+	NOU::NOU_DAT_ALG::Vector<REF> objects(live);
+
+	for (NOU::sizeType i = 0; i < live; i++)
+		objects.pushBack(allocate(static_cast<NOU::byte>(i)));
+
+	double time = measure([&]()
+	{
+		for (NOU::sizeType round = 0; round < rounds; round++)
+		{
+			for (NOU::sizeType i = 0; i < live; i++)
+			{
+				deallocate(objects[i]);
+				objects[i] = allocate(static_cast<NOU::byte>(round + i));
+			}
+		}
+	});
+
+	for (NOU::sizeType i = 0; i < live; i++)
+		deallocate(objects[i]);
+
+	return time / (live * rounds);
+}
+
+template<NOU::sizeType SIZE>
+static void runObjectPoolChurn(const char *name)
+{
+	using Object = ChurnObject<SIZE>;
+	using Pool = NOU::NOU_DAT_ALG::ConcurrentObjectPool<Object>;
+
+	const NOU::sizeType live = 1000;
+	const NOU::sizeType rounds = 200;
+
+	char label[128];
+
+	double time = runObjectChurn<Object*>(live, rounds,
+		[](NOU::byte value) { return new Object(value); },
+		[](Object *object) { delete object; });
+
+	std::snprintf(label, sizeof(label), "new/delete, %s", name);
+	report(label, time * 1e9, "ns/op");
+
+	Pool pool;
+
+	time = runObjectChurn<typename Pool::Handle>(live, rounds,
+		[&pool](NOU::byte value) { return pool.emplaceObject(value); },
+		[&pool](const typename Pool::Handle &handle) { pool.giveBack(handle); });
+
+	std::snprintf(label, sizeof(label), "ConcurrentObjectPool, %s", name);
+	report(label, time * 1e9, "ns/op");
+}
+
+NOU_BENCHMARK(ObjectPool)
+{
+	runObjectPoolChurn<64>("64 B");
+	runObjectPoolChurn<1024>("1 KB");
+}
+
+
+
+//a xorshift generator, the replays must be the same for all allocators
+static NOU::uint64 nextRandom(NOU::uint64 &state)
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+
+	return state;
+}
+
+/**
+\brief Sorts the latencies and reports their 50th, 99th and 99.9th percentile.
+*/
+static void reportPercentiles(const char *name, NOU::NOU_DAT_ALG::Vector<NOU::int64> &latencies)
+{
+	char label[128];
+
+	//not NOU_DAT_ALG::qsort(), its recursion degenerates on the many equal latencies
+	std::sort(latencies.data(), latencies.data() + latencies.size());
+
+	for (NOU::float64 percentile : { 50.0, 99.0, 99.9 })
+	{
+		NOU::sizeType index = static_cast<NOU::sizeType>(latencies.size() * percentile / 100.0);
+		index = NOU::NOU_CORE::min(index, latencies.size() - 1);
+
+		std::snprintf(label, sizeof(label), "%s, p%g", name, percentile);
+		report(label, static_cast<NOU::float64>(latencies[index]), "ns");
+	}
+}
+
+NOU_BENCHMARK(GeneralPurposeAllocator)
+{
+	using Pointer = NOU::NOU_MEM_MNGT::GeneralPurposeAllocator::GeneralPurposeAllocatorPointer<NOU::byte>;
+
+	const NOU::sizeType poolSize = 64 * 1024 * 1024;
+	const NOU::sizeType operations = 400000;
+	const NOU::sizeType maxLive = 20000;
+
+	for (NOU::NOU_MEM_MNGT::GeneralPurposeAllocatorMode mode :
+		{ NOU::NOU_MEM_MNGT::GeneralPurposeAllocatorMode::FIRST_FIT,
+		NOU::NOU_MEM_MNGT::GeneralPurposeAllocatorMode::SEGREGATED_FIT })
+	{
+		const char *name = mode == NOU::NOU_MEM_MNGT::GeneralPurposeAllocatorMode::FIRST_FIT ?
+			"FIRST_FIT" : "SEGREGATED_FIT";
+
+		NOU::NOU_MEM_MNGT::GeneralPurposeAllocator allocator(poolSize, mode);
+
+		NOU::NOU_DAT_ALG::Vector<Pointer> live(maxLive);
+		NOU::NOU_DAT_ALG::Vector<NOU::int64> allocations(operations);
+		NOU::NOU_DAT_ALG::Vector<NOU::int64> deallocations(operations);
+
+		NOU::uint64 random = 0x2545F4914F6CDD1Dull;
+		NOU::sizeType failed = 0;
+
+		//fill the pool first, then free random blocks and allocate new ones of random sizes
+		for (NOU::sizeType i = 0; i < operations; i++)
+		{
+			NOU::boolean allocate = live.size() < maxLive / 2 ||
+				(live.size() < maxLive && nextRandom(random) % 2 == 0);
+
+			if (allocate)
+			{
+				NOU::sizeType size = 8 + nextRandom(random) % 513;
+
+				Clock::time_point start = Clock::now();
+				Pointer pointer = allocator.allocateObjects<NOU::byte>(size);
+				Clock::time_point end = Clock::now();
+
+				allocations.pushBack(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+				if (pointer == nullptr)
+					failed++;
+				else
+					live.pushBack(pointer);
+			}
+			else
+			{
+				NOU::sizeType index = nextRandom(random) % live.size();
+				Pointer pointer = live[index];
+
+				live[index] = live[live.size() - 1];
+				live.remove(live.size() - 1);
+
+				Clock::time_point start = Clock::now();
+				allocator.deallocateObjects(pointer);
+				Clock::time_point end = Clock::now();
+
+				deallocations.pushBack(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+			}
+		}
+
+		for (NOU::sizeType i = 0; i < live.size(); i++)
+			allocator.deallocateObjects(live[i]);
+
+		char label[128];
+
+		std::snprintf(label, sizeof(label), "%s allocate", name);
+		reportPercentiles(label, allocations);
+
+		std::snprintf(label, sizeof(label), "%s deallocate", name);
+		reportPercentiles(label, deallocations);
+
+		std::snprintf(label, sizeof(label), "%s, failed allocations", name);
+		report(label, static_cast<NOU::float64>(failed), "");
+	}
+
+	//the latencies above include this
+	NOU::NOU_DAT_ALG::Vector<NOU::int64> overhead(operations);
+
+	for (NOU::sizeType i = 0; i < operations; i++)
+	{
+		Clock::time_point start = Clock::now();
+		Clock::time_point end = Clock::now();
+
+		overhead.pushBack(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	reportPercentiles("timer overhead", overhead);
+}
+
+
+
+#ifdef __GLIBC__
+/*
+ * The pool that ThreadManager::submit() stores its tasks in allocates using alignedAlloc() and not an 
+ * allocation callback, therefore the allocations are counted by wrapping the allocation functions of glibc.
+ * Only the allocations of the threads that run while s_countAllocations is set are counted.
+ */
+#define NOU_BENCHMARK_COUNT_ALLOCATIONS
+
+extern "C"
+{
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t count, std::size_t size);
+	void* __libc_realloc(void *data, std::size_t size);
+	void* __libc_memalign(std::size_t alignment, std::size_t size);
+}
+
+static std::atomic<NOU::boolean> s_countAllocations(false);
+static std::atomic<NOU::uint64> s_allocations(0);
+
+static void countAllocation()
+{
+	if (s_countAllocations.load(std::memory_order_relaxed))
+		s_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+extern "C" void* malloc(std::size_t size)
+{
+	countAllocation();
+	return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size)
+{
+	countAllocation();
+	return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void *data, std::size_t size)
+{
+	countAllocation();
+	return __libc_realloc(data, size);
+}
+
+extern "C" void* aligned_alloc(std::size_t alignment, std::size_t size)
+{
+	countAllocation();
+	return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void **data, std::size_t alignment, std::size_t size)
+{
+	countAllocation();
+	*data = __libc_memalign(alignment, size);
+
+	return *data == nullptr ? ENOMEM : 0;
+}
+
+/**
+\return The amount of heap allocations (of all threads) that \p submit made to submit \p count tasks, 
+        including the allocations until the tasks have been executed.
+*/
+template<typename F>
+static NOU::float64 countAllocations(NOU::sizeType count, F submit)
+{
+	std::atomic<NOU::sizeType> counter(0);
+
+	s_allocations.store(0);
+	s_countAllocations.store(true);
+
+	for (NOU::sizeType i = 0; i < count; i++)
+		submit(counter);
+
+	waitFor(counter, count);
+
+	//give the workers the time to return the last tasks to the pool
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	s_countAllocations.store(false);
+
+	return static_cast<NOU::float64>(s_allocations.load());
+}
+
+NOU_BENCHMARK(SubmitAllocations)
+{
+	const NOU::sizeType count = 100000;
+
+	std::printf("  (%zu tasks each)\n", count);
+
+	for (NOU::NOU_THREAD::SchedulerMode mode : { NOU::NOU_THREAD::SchedulerMode::TASK_HEAP,
+		NOU::NOU_THREAD::SchedulerMode::WORK_STEALING })
+	{
+		NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+		configuration.schedulerMode = mode;
+
+		NOU::NOU_THREAD::ThreadManager manager(configuration);
+
+		auto small = [&manager](std::atomic<NOU::sizeType> &counter)
+		{
+			manager.submit([](std::atomic<NOU::sizeType> *c)
+			{
+				c->fetch_add(1, std::memory_order_release);
+			}, &counter);
+		};
+
+		//does not fit into the inline buffer of InlineTask
+		auto large = [&manager](std::atomic<NOU::sizeType> &counter)
+		{
+			NOU::byte payload[NOU::NOU_THREAD::InlineTask::INLINE_CAPACITY] = {};
+
+			manager.submit([payload](std::atomic<NOU::sizeType> *c)
+			{
+				c->fetch_add(1 + payload[0], std::memory_order_release);
+			}, &counter);
+		};
+
+		char label[128];
+
+		//the first round fills the pool of submitted tasks, the second one reuses it
+		for (const char *round : { "cold", "warm" })
+		{
+			std::snprintf(label, sizeof(label), "%s, %s, submit()", modeName(mode), round);
+			report(label, countAllocations(count, small), "allocations");
+
+			std::snprintf(label, sizeof(label), "%s, %s, submit() (%zu byte capture)", modeName(mode), round,
+				NOU::NOU_THREAD::InlineTask::INLINE_CAPACITY);
+			report(label, countAllocations(count, large), "allocations");
+		}
+	}
+
+	//for comparison; an AsyncTaskResult always runs on the default thread manager
+	auto async = [](std::atomic<NOU::sizeType> &counter)
+	{
+		NOU::NOU_THREAD::AsyncTaskResult<void, void(*)(std::atomic<NOU::sizeType>*),
+			std::atomic<NOU::sizeType>*> result([](std::atomic<NOU::sizeType> *c)
+		{
+			c->fetch_add(1, std::memory_order_release);
+		}, &counter);
+	};
+
+	for (const char *round : { "cold", "warm" })
+	{
+		char label[128];
+
+		std::snprintf(label, sizeof(label), "default thread manager, %s, AsyncTaskResult", round);
+		report(label, countAllocations(count, async), "allocations");
+	}
+}
+#endif
+
+
+
+/**
+\return The time in nanoseconds per lock()/unlock() pair if \p threads threads lock the same mutex
+        \p iterations times each. The critical section increments a counter.
+*/
+template<typename MUTEX>
+static NOU::float64 runMutex(NOU::sizeType threads, NOU::sizeType iterations)
+{
+	MUTEX mutex;
+	NOU::sizeType shared = 0;
+
+	//the uncontended case is run on the main thread
+	if (threads == 1)
+	{
+		NOU::float64 time = measure([&]()
+		{
+			for (NOU::sizeType i = 0; i < iterations; i++)
+			{
+				mutex.lock();
+				shared++;
+				mutex.unlock();
+			}
+		});
+
+		NOU_ASSERT(shared == iterations);
+
+		return time * 1e9 / iterations;
+	}
+
+	std::atomic<NOU::boolean> start(false);
+	NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> workers;
+
+	for (NOU::sizeType i = 0; i < threads; i++)
+	{
+		workers.pushBack(NOU::NOU_THREAD::ThreadWrapper([&]()
+		{
+			while (!start.load())
+				std::this_thread::yield();
+
+			for (NOU::sizeType j = 0; j < iterations; j++)
+			{
+				mutex.lock();
+				shared++;
+				mutex.unlock();
+			}
+		}));
+	}
+
+	NOU::float64 time = measure([&]()
+	{
+		start.store(true);
+
+		for (NOU::sizeType i = 0; i < workers.size(); i++)
+			workers[i].join();
+	});
+
+	NOU_ASSERT(shared == threads * iterations);
+
+	return time * 1e9 / (threads * iterations);
+}
+
+template<typename MUTEX>
+static void runMutexes(const char *name)
+{
+	const NOU::sizeType operations = 4000000;
+
+	char label[128];
+
+	for (NOU::sizeType threads : { 1, 2, 8, 32 })
+	{
+		if (threads == 1)
+			std::snprintf(label, sizeof(label), "%s, uncontended", name);
+		else
+			std::snprintf(label, sizeof(label), "%s, %zu threads", name, threads);
+
+		report(label, runMutex<MUTEX>(threads, operations / threads), "ns/lock");
+	}
+}
+
+NOU_BENCHMARK(Mutex)
+{
+	runMutexes<NOU::NOU_THREAD::Mutex>("Mutex");
+	runMutexes<NOU::NOU_THREAD::AdaptiveMutex>("AdaptiveMutex");
+	runMutexes<NOU::NOU_THREAD::ByteMutex>("ByteMutex");
+}
+
+
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define NOU_BENCHMARK_HAS_TSC
+
+/**
+\return The time stamp counter of the CPU.
+*/
+static NOU::uint64 readTimeStampCounter()
+{
+#if NOU_COMPILER == NOU_COMPILER_VISUAL_CPP
+	return __rdtsc();
+#else
+	return __builtin_ia32_rdtsc();
+#endif
+}
+#endif
+
+/**
+\brief Reports the throughput of hash64() for inputs of \p size bytes.
+*/
+static void runHash(const NOU::byte *data, NOU::sizeType size, const char *name)
+{
+	//hash roughly 1 GiB, but not more than 32M inputs
+	const NOU::sizeType iterations = NOU::NOU_CORE::min<NOU::sizeType>((NOU::sizeType(1) << 30) / size, 
+		NOU::sizeType(1) << 25);
+
+	volatile NOU::uint64 sink = 0;
+	NOU::uint64 hash = 0;
+
+#ifdef NOU_BENCHMARK_HAS_TSC
+	NOU::uint64 cycles = readTimeStampCounter();
+#endif
+
+	NOU::float64 time = measure([&]()
+	{
+		//the inputs are independent, this measures the throughput and not the latency
+		for (NOU::sizeType i = 0; i < iterations; i++)
+			hash += NOU::NOU_DAT_ALG::hash64(data + (i & 63), size, i);
+	});
+
+#ifdef NOU_BENCHMARK_HAS_TSC
+	cycles = readTimeStampCounter() - cycles;
+#endif
+
+	sink = hash;
+
+	char label[128];
+	NOU::float64 bytes = static_cast<NOU::float64>(size) * iterations;
+
+	std::snprintf(label, sizeof(label), "%s, time", name);
+	report(label, time * 1e9 / iterations, "ns/hash");
+
+	std::snprintf(label, sizeof(label), "%s, throughput", name);
+	report(label, bytes / time / 1e9, "GB/s");
+
+#ifdef NOU_BENCHMARK_HAS_TSC
+	std::snprintf(label, sizeof(label), "%s, TSC cycles", name);
+	report(label, cycles / bytes, "cycles/byte");
+#endif
+}
+
+NOU_BENCHMARK(Hash)
+{
+	const NOU::sizeType maxSize = 1024 * 1024;
+
+	//the offset of the input changes between 0 and 63
+	NOU::NOU_DAT_ALG::Vector<NOU::byte> data(maxSize + 64);
+
+	for (NOU::sizeType i = 0; i < maxSize + 64; i++)
+		data.pushBack(static_cast<NOU::byte>(i * 131 + 7));
+
+	char name[128];
+
+	//only inputs of at least 256 bytes can be hashed using AVX2
+	for (NOU::sizeType size : { 8, 64 })
+	{
+		std::snprintf(name, sizeof(name), "%zu B", size);
+		runHash(data.data(), size, name);
+	}
+
+	for (NOU::boolean avx2 : { false, true })
+	{
+		if (NOU::NOU_DAT_ALG::internal::setHashAvx2Enabled(avx2) != avx2)
+		{
+			std::printf("  AVX2 is not supported\n");
+			continue;
+		}
+
+		for (NOU::sizeType size : { NOU::sizeType(1024), maxSize })
+		{
+			if (size >= 1024 * 1024)
+				std::snprintf(name, sizeof(name), "%zu MiB, %s", size / (1024 * 1024), avx2 ? "AVX2" : "scalar");
+			else
+				std::snprintf(name, sizeof(name), "%zu KiB, %s", size / 1024, avx2 ? "AVX2" : "scalar");
+
+			runHash(data.data(), size, name);
+		}
+	}
+
+	NOU::NOU_DAT_ALG::internal::setHashAvx2Enabled(true);
+}
+
+
+
+/**
+\brief The value that the readers and writers of the SharedMutex benchmark access.
+*/
+struct SharedValue
+{
+	NOU::uint64 m_values[8];
+};
+
+/**
+\return The time in nanoseconds per operation if \p threads threads execute \p operations operations each,
+        of which \p writePercent percent are writes. The reads and writes are randomly interleaved.
+*/
+template<typename READ, typename WRITE>
+static NOU::float64 runReadWrite(NOU::sizeType threads, NOU::sizeType operations, NOU::uint64 writePercent,
+	READ read, WRITE write)
+{
+	std::atomic<NOU::boolean> start(false);
+	std::atomic<NOU::uint64> sink(0);
+
+	NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> workers;
+
+	for (NOU::sizeType i = 0; i < threads; i++)
+	{
+		workers.pushBack(NOU::NOU_THREAD::ThreadWrapper([&, i]()
+		{
+			NOU::uint64 random = 0x9E3779B97F4A7C15ull * (i + 1);
+			NOU::uint64 sum = 0;
+
+			while (!start.load())
+				std::this_thread::yield();
+
+			for (NOU::sizeType j = 0; j < operations; j++)
+			{
+				if (nextRandom(random) % 100 < writePercent)
+					write();
+				else
+					sum += read();
+			}
+
+			sink.fetch_add(sum, std::memory_order_relaxed);
+		}));
+	}
+
+	NOU::float64 time = measure([&]()
+	{
+		start.store(true);
+
+		for (NOU::sizeType i = 0; i < workers.size(); i++)
+			workers[i].join();
+	});
+
+	return time * 1e9 / (threads * operations);
+}
+
+/**
+\brief Reports the time per operation of a lock for all thread counts and read/write ratios.
+*/
+template<typename READ, typename WRITE>
+static void runReadWrites(const char *name, READ read, WRITE write)
+{
+	const NOU::sizeType operations = 500000;
+
+	char label[128];
+
+	for (NOU::uint64 writePercent : { 1, 10 })
+	{
+		for (NOU::sizeType threads : threadCounts(8))
+		{
+			std::snprintf(label, sizeof(label), "%s, %u/%u, %zu threads", name, 
+				static_cast<NOU::uint32>(100 - writePercent), static_cast<NOU::uint32>(writePercent), threads);
+
+			report(label, runReadWrite(threads, operations, writePercent, read, write), "ns/op");
+		}
+	}
+}
+
+NOU_BENCHMARK(SharedMutex)
+{
+	SharedValue value = {};
+
+	auto readValue = [&value]()
+	{
+		NOU::uint64 ret = 0;
+
+		for (NOU::uint64 v : value.m_values)
+			ret += v;
+
+		return ret;
+	};
+
+	auto writeValue = [&value]()
+	{
+		for (NOU::uint64 &v : value.m_values)
+			v++;
+	};
+
+	NOU::NOU_THREAD::Mutex mutex;
+
+	runReadWrites("Mutex", [&]()
+	{
+		NOU::NOU_THREAD::Lock lock(mutex);
+		return readValue();
+	}, [&]()
+	{
+		NOU::NOU_THREAD::Lock lock(mutex);
+		writeValue();
+	});
+
+	for (NOU::NOU_THREAD::SharedMutexPolicy policy : { NOU::NOU_THREAD::SharedMutexPolicy::READER_PREFERRING,
+		NOU::NOU_THREAD::SharedMutexPolicy::WRITER_PREFERRING })
+	{
+		NOU::NOU_THREAD::SharedMutex sharedMutex(policy);
+
+		runReadWrites(policy == NOU::NOU_THREAD::SharedMutexPolicy::READER_PREFERRING ?
+			"SharedMutex (reader preferring)" : "SharedMutex (writer preferring)", [&]()
+		{
+			sharedMutex.lockShared();
+			NOU::uint64 ret = readValue();
+			sharedMutex.unlockShared();
+
+			return ret;
+		}, [&]()
+		{
+			sharedMutex.lock();
+			writeValue();
+			sharedMutex.unlock();
+		});
+	}
+
+	NOU::NOU_THREAD::SeqLock<SharedValue> seqLock;
+
+	runReadWrites("SeqLock", [&]()
+	{
+		SharedValue copy = seqLock.load();
+		NOU::uint64 ret = 0;
+
+		for (NOU::uint64 v : copy.m_values)
+			ret += v;
+
+		return ret;
+	}, [&]()
+	{
+		seqLock.modify([](SharedValue &v)
+		{
+			for (NOU::uint64 &element : v.m_values)
+				element++;
+		});
+	});
+}
+
+
+
+NOU_BENCHMARK(DispatchLatency)
+{
+	const NOU::sizeType samples = 5000;
+
+	struct IdleConfiguration
+	{
+		const char *m_name;
+		NOU::uint32 m_spinCount;
+		NOU::uint32 m_yieldCount;
+	};
+
+	const IdleConfiguration idleConfigurations[] =
+	{
+		{ "sleep", 0, 0 },
+		{ "spin", 10000, 0 },
+		{ "yield", 0, 1000 }
+	};
+
+	for (NOU::NOU_THREAD::SchedulerMode mode : { NOU::NOU_THREAD::SchedulerMode::TASK_HEAP,
+		NOU::NOU_THREAD::SchedulerMode::WORK_STEALING })
+	{
+		for (const IdleConfiguration &idle : idleConfigurations)
+		{
+			NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+			configuration.schedulerMode = mode;
+			configuration.idleSpinCount = idle.m_spinCount;
+			configuration.idleYieldCount = idle.m_yieldCount;
+			configuration.prespawnThreads = true;
+
+			NOU::NOU_THREAD::ThreadManager manager(configuration);
+
+			NOU::NOU_DAT_ALG::Vector<NOU::int64> latencies(samples);
+			std::atomic<NOU::sizeType> counter(0);
+			Clock::time_point started;
+
+			//the first task waits for the prespawned threads
+			manager.submit([](std::atomic<NOU::sizeType> *c) 
+			{ 
+				c->fetch_add(1, std::memory_order_release); 
+			}, &counter);
+
+			waitFor(counter, 1);
+
+			for (NOU::sizeType i = 0; i < samples; i++)
+			{
+				//let the worker go idle (or to sleep) before the next task is pushed
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+
+				Clock::time_point pushed = Clock::now();
+
+				manager.submit([](Clock::time_point *s, std::atomic<NOU::sizeType> *c)
+				{
+					*s = Clock::now();
+					c->fetch_add(1, std::memory_order_release);
+				}, &started, &counter);
+
+				waitFor(counter, i + 2);
+
+				latencies.pushBack(std::chrono::duration_cast<std::chrono::nanoseconds>(started - pushed).count());
+			}
+
+			char label[128];
+			std::snprintf(label, sizeof(label), "%s, %s", modeName(mode), idle.m_name);
+
+			reportPercentiles(label, latencies);
+		}
+	}
+}
+
+
+
+/**
+\brief A task that only increments a counter.
+*/
+class TinyTask final : public NOU::NOU_THREAD::internal::AbstractTask
+{
+private:
+	std::atomic<NOU::sizeType> *m_counter;
+
+public:
+	explicit TinyTask(std::atomic<NOU::sizeType> *counter) :
+		m_counter(counter)
+	{}
+
+	virtual void execute() override
+	{
+		m_counter->fetch_add(1, std::memory_order_release);
+	}
+};
+
+NOU_BENCHMARK(TinyTasks)
+{
+	const NOU::sizeType count = 1000000;
+	const NOU::NOU_THREAD::ThreadManager::Priority priority = 5;
+
+	std::atomic<NOU::sizeType> counter(0);
+
+	NOU::NOU_DAT_ALG::Vector<TinyTask> tasks(count);
+	NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::internal::AbstractTask*> pointers(count);
+
+	for (NOU::sizeType i = 0; i < count; i++)
+		tasks.pushBack(TinyTask(&counter));
+
+	for (NOU::sizeType i = 0; i < count; i++)
+		pointers.pushBack(&tasks[i]);
+
+	for (NOU::NOU_THREAD::SchedulerMode mode : { NOU::NOU_THREAD::SchedulerMode::TASK_HEAP,
+		NOU::NOU_THREAD::SchedulerMode::WORK_STEALING })
+	{
+		NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+		configuration.schedulerMode = mode;
+
+		NOU::NOU_THREAD::ThreadManager manager(configuration);
+
+		for (NOU::boolean bulk : { false, true })
+		{
+			counter.store(0);
+
+			NOU::float64 submit = 0;
+
+			NOU::float64 total = measure([&]()
+			{
+				submit = measure([&]()
+				{
+					if (bulk)
+						manager.pushTasks(pointers.data(), count, priority);
+					else
+					{
+						for (NOU::sizeType i = 0; i < count; i++)
+							manager.pushTask(pointers[i], priority);
+					}
+				});
+
+				waitFor(counter, count);
+			});
+
+			char label[128];
+
+			std::snprintf(label, sizeof(label), "%s, %s, submit", modeName(mode), bulk ? "pushTasks()" : 
+				"pushTask() loop");
+			report(label, submit * 1e9 / count, "ns/task");
+
+			std::snprintf(label, sizeof(label), "%s, %s, until drained", modeName(mode), bulk ? "pushTasks()" : 
+				"pushTask() loop");
+			report(label, total * 1e9 / count, "ns/task");
+		}
+	}
+}
+
+
+
+static const char* pageTypeName(NOU::NOU_MEM_MNGT::PageType type)
+{
+	switch (type)
+	{
+	case NOU::NOU_MEM_MNGT::PageType::SMALL:
+		return "small";
+	case NOU::NOU_MEM_MNGT::PageType::TRANSPARENT_HUGE:
+		return "transparent huge";
+	case NOU::NOU_MEM_MNGT::PageType::HUGE:
+		return "huge";
+	default:
+		return "none";
+	}
+}
+
+NOU_BENCHMARK(PageAllocator)
+{
+	const NOU::sizeType size = 1024 * 1024 * 1024;
+	const NOU::sizeType accesses = 20000000;
+
+	struct Mode
+	{
+		const char *m_name;
+		NOU::NOU_MEM_MNGT::HugePageMode m_mode;
+	};
+
+	const Mode modes[] =
+	{
+		{ "NONE", NOU::NOU_MEM_MNGT::HugePageMode::NONE },
+		{ "TRANSPARENT", NOU::NOU_MEM_MNGT::HugePageMode::TRANSPARENT },
+		{ "EXPLICIT", NOU::NOU_MEM_MNGT::HugePageMode::EXPLICIT }
+	};
+
+	for (const Mode &mode : modes)
+	{
+		NOU::NOU_MEM_MNGT::PageRegion region;
+
+		//the time of the allocation includes faulting in all pages
+		NOU::float64 allocation = measure([&]()
+		{
+			region = NOU::NOU_MEM_MNGT::pageAlloc(size, NOU::NOU_MEM_MNGT::PageAllocationOptions(mode.m_mode, 
+				true));
+		});
+
+		if (region.data == nullptr)
+		{
+			std::printf("  %s: the allocation failed\n", mode.m_name);
+			continue;
+		}
+
+		NOU::uint64 *words = reinterpret_cast<NOU::uint64*>(region.data);
+		const NOU::sizeType wordCount = size / sizeof(NOU::uint64);
+
+		NOU::uint64 random = 0x2545F4914F6CDD1Dull;
+
+		NOU::float64 time = measure([&]()
+		{
+			for (NOU::sizeType i = 0; i < accesses; i++)
+				words[nextRandom(random) % wordCount]++;
+		});
+
+		char label[128];
+
+		std::printf("  %s: %s pages\n", mode.m_name, pageTypeName(region.type));
+
+		std::snprintf(label, sizeof(label), "%s, allocate and prefault 1 GiB", mode.m_name);
+		report(label, allocation * 1e3, "ms");
+
+		std::snprintf(label, sizeof(label), "%s, random read-modify-write", mode.m_name);
+		report(label, time * 1e9 / accesses, "ns/access");
+
+		NOU::NOU_MEM_MNGT::pageFree(region);
+	}
+}
+
+
+
+/**
+\brief The pointers to the nodes of the graph of the SharedPtr benchmark are std::shared_ptr.
+*/
+struct StdGraphPointers
+{
+	struct Base {};
+
+	template<typename T>
+	using Pointer = std::shared_ptr<T>;
+
+	template<typename T>
+	static Pointer<T> make()
+	{
+		return std::make_shared<T>();
+	}
+};
+
+/**
+\brief The pointers to the nodes of the graph of the SharedPtr benchmark are SharedPtr.
+*/
+template<typename COUNT>
+struct SharedGraphPointers
+{
+	struct Base {};
+
+	template<typename T>
+	using Pointer = NOU::NOU_MEM_MNGT::SharedPtr<T, COUNT>;
+
+	template<typename T>
+	static Pointer<T> make()
+	{
+		return NOU::NOU_MEM_MNGT::makeShared<T, COUNT>();
+	}
+};
+
+/**
+\brief The pointers to the nodes of the graph of the SharedPtr benchmark are IntrusivePtr.
+*/
+template<typename COUNT>
+struct IntrusiveGraphPointers
+{
+	using Base = NOU::NOU_MEM_MNGT::RefCounted<COUNT>;
+
+	template<typename T>
+	using Pointer = NOU::NOU_MEM_MNGT::IntrusivePtr<T>;
+
+	template<typename T>
+	static Pointer<T> make()
+	{
+		return Pointer<T>(new T());
+	}
+};
+
+template<typename POINTERS>
+struct GraphNode : POINTERS::Base
+{
+	typename POINTERS::template Pointer<GraphNode> m_edges[4];
+};
+
+/**
+\return The time in nanoseconds per step of a random walk through a graph of 2000 nodes with four edges 
+        each. Each step copies the pointer to the next node.
+*/
+template<typename POINTERS>
+static NOU::float64 runGraphWalk(NOU::sizeType steps)
+{
+	using Node = GraphNode<POINTERS>;
+	using Pointer = typename POINTERS::template Pointer<Node>;
+
+	const NOU::sizeType nodeCount = 2000;
+
+	NOU::NOU_DAT_ALG::Vector<Pointer> nodes(nodeCount);
+
+	for (NOU::sizeType i = 0; i < nodeCount; i++)
+		nodes.pushBack(POINTERS::template make<Node>());
+
+	NOU::uint64 random = 0x2545F4914F6CDD1Dull;
+
+	for (NOU::sizeType i = 0; i < nodeCount; i++)
+	{
+		for (Pointer &edge : nodes[i]->m_edges)
+			edge = nodes[nextRandom(random) % nodeCount];
+	}
+
+	Pointer current = nodes[0];
+
+	NOU::float64 time = measure([&]()
+	{
+		for (NOU::sizeType i = 0; i < steps; i++)
+			current = current->m_edges[nextRandom(random) % 4];
+	});
+
+	//the edges form cycles
+	for (NOU::sizeType i = 0; i < nodeCount; i++)
+	{
+		for (Pointer &edge : nodes[i]->m_edges)
+			edge = Pointer();
+	}
+
+	return time * 1e9 / steps;
+}
+
+NOU_BENCHMARK(SharedPtr)
+{
+	const NOU::sizeType steps = 10000000;
+
+	//libstdc++ uses non-atomic counts in std::shared_ptr until the process has started a thread
+	std::thread([]() {}).join();
+
+	report("std::shared_ptr", runGraphWalk<StdGraphPointers>(steps), "ns/step");
+	report("SharedPtr, AtomicRefCount", 
+		runGraphWalk<SharedGraphPointers<NOU::NOU_MEM_MNGT::AtomicRefCount>>(steps), "ns/step");
+	report("SharedPtr, PlainRefCount", 
+		runGraphWalk<SharedGraphPointers<NOU::NOU_MEM_MNGT::PlainRefCount>>(steps), "ns/step");
+	report("IntrusivePtr, AtomicRefCount", 
+		runGraphWalk<IntrusiveGraphPointers<NOU::NOU_MEM_MNGT::AtomicRefCount>>(steps), "ns/step");
+	report("IntrusivePtr, PlainRefCount", 
+		runGraphWalk<IntrusiveGraphPointers<NOU::NOU_MEM_MNGT::PlainRefCount>>(steps), "ns/step");
+}
+
+
+
+/**
+\return The time in seconds until \p threads threads have executed \p function.
+*/
+template<typename F>
+static NOU::float64 runOnThreads(NOU::sizeType threads, F function)
+{
+	std::atomic<NOU::boolean> start(false);
+
+	NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> workers;
+
+	for (NOU::sizeType i = 0; i < threads; i++)
+	{
+		workers.pushBack(NOU::NOU_THREAD::ThreadWrapper([&]()
+		{
+			while (!start.load())
+				std::this_thread::yield();
+
+			function();
+		}));
+	}
+
+	return measure([&]()
+	{
+		start.store(true);
+
+		for (NOU::sizeType i = 0; i < workers.size(); i++)
+			workers[i].join();
+	});
+}
+
+/**
+\brief The object that is retired in the reclamation benchmark.
+*/
+struct ReclaimedNode
+{
+	NOU::uint64 m_value;
+};
+
+NOU_BENCHMARK(Reclamation)
+{
+	const NOU::sizeType operations = 2000000;
+
+	using Allocator = NOU::NOU_MEM_MNGT::GenericAllocationCallback<ReclaimedNode>;
+
+	std::atomic<ReclaimedNode*> shared(Allocator().allocate(1));
+
+	for (NOU::sizeType threads : threadCounts(4))
+	{
+		char label[128];
+		const NOU::sizeType perThread = operations / threads;
+
+		//the baseline, an object that is freed immediately
+		NOU::float64 time = runOnThreads(threads, [&]()
+		{
+			for (NOU::sizeType i = 0; i < perThread; i++)
+			{
+				ReclaimedNode *node = Allocator().allocate(1);
+				node->m_value = i;
+				Allocator().deallocate(node);
+			}
+		});
+
+		std::snprintf(label, sizeof(label), "allocate and free, %zu threads", threads);
+		report(label, time * 1e9 / (perThread * threads), "ns/op");
+
+		NOU::NOU_MEM_MNGT::EpochReclaimer reclaimer;
+
+		time = runOnThreads(threads, [&]()
+		{
+			for (NOU::sizeType i = 0; i < perThread; i++)
+			{
+				NOU::NOU_MEM_MNGT::EpochReclaimer::Guard guard(reclaimer);
+				shared.load(std::memory_order_acquire)->m_value;
+			}
+		});
+
+		std::snprintf(label, sizeof(label), "EpochReclaimer, guard, %zu threads", threads);
+		report(label, time * 1e9 / (perThread * threads), "ns/op");
+
+		time = runOnThreads(threads, [&]()
+		{
+			for (NOU::sizeType i = 0; i < perThread; i++)
+			{
+				ReclaimedNode *node = Allocator().allocate(1);
+				node->m_value = i;
+
+				NOU::NOU_MEM_MNGT::EpochReclaimer::Guard guard(reclaimer);
+				reclaimer.retire(node);
+			}
+		});
+
+		time += measure([&]() { reclaimer.collect(); });
+
+		std::snprintf(label, sizeof(label), "EpochReclaimer, allocate and retire, %zu threads", threads);
+		report(label, time * 1e9 / (perThread * threads), "ns/op");
+
+		NOU::NOU_MEM_MNGT::HazardPointerDomain domain;
+
+		time = runOnThreads(threads, [&]()
+		{
+			for (NOU::sizeType i = 0; i < perThread; i++)
+			{
+				NOU::NOU_MEM_MNGT::HazardPointerDomain::HazardPointer hazard(domain);
+				hazard.protect(shared)->m_value;
+			}
+		});
+
+		std::snprintf(label, sizeof(label), "HazardPointerDomain, protect, %zu threads", threads);
+		report(label, time * 1e9 / (perThread * threads), "ns/op");
+
+		time = runOnThreads(threads, [&]()
+		{
+			for (NOU::sizeType i = 0; i < perThread; i++)
+			{
+				ReclaimedNode *node = Allocator().allocate(1);
+				node->m_value = i;
+
+				domain.retire(node);
+			}
+		});
+
+		time += measure([&]() { domain.collect(); });
+
+		std::snprintf(label, sizeof(label), "HazardPointerDomain, allocate and retire, %zu threads", threads);
+		report(label, time * 1e9 / (perThread * threads), "ns/op");
+	}
+
+	Allocator().deallocate(shared.load());
+}
+
+
+
+int main(int argc, char **argv)
+{
+	//the singleton must exist before other thread managers are constructed
+	NOU::NOU_THREAD::getThreadManager();
+
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+
+	for (Benchmark &benchmark : benchmarks())
+	{
+		NOU::boolean selected = argc < 2;
+
+		for (int i = 1; i < argc; i++)
+			selected = selected || std::strcmp(argv[i], benchmark.m_name) == 0;
+
+		if (!selected)
+			continue;
+
+		std::printf("%s\n", benchmark.m_name);
+		benchmark.m_function();
+	}
+
+	return 0;
+}
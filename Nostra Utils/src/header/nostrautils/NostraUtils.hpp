@@ -12,6 +12,7 @@
 */
 
 #include "nostrautils/core/Assertions.hpp"
+#include "nostrautils/core/Bits.hpp"
 #include "nostrautils/core/ErrorHandler.hpp"
 #include "nostrautils/core/Logging.hpp"
 #include "nostrautils/core/Meta.hpp"
@@ -24,7 +25,11 @@
 #include "nostrautils/dat_alg/BinaryHeap.hpp"
 #include "nostrautils/dat_alg/BinarySearch.hpp"
 #include "nostrautils/dat_alg/Comparator.hpp"
+#include "nostrautils/dat_alg/ConcurrentHashMap.hpp"
+#include "nostrautils/dat_alg/ConcurrentObjectPool.hpp"
+#include "nostrautils/dat_alg/ConcurrentQueue.hpp"
 #include "nostrautils/dat_alg/FastQueue.hpp"
+#include "nostrautils/dat_alg/FlatHashMap.hpp"
 #include "nostrautils/dat_alg/Hashing.hpp"
 #include "nostrautils/dat_alg/HashMap.hpp"
 #include "nostrautils/dat_alg/LazyEvaluationProperty.hpp"
@@ -48,9 +53,15 @@
 #include "nostrautils/math/Utils.hpp"
 
 #include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/mem_mngt/AllocationProfiler.hpp"
+#include "nostrautils/mem_mngt/ConcurrentPoolAllocator.hpp"
 #include "nostrautils/mem_mngt/GeneralPurposeAllocator.hpp"
+#include "nostrautils/mem_mngt/MonotonicArena.hpp"
+#include "nostrautils/mem_mngt/PageAllocator.hpp"
 #include "nostrautils/mem_mngt/Pointer.hpp"
 #include "nostrautils/mem_mngt/PoolAllocator.hpp"
+#include "nostrautils/mem_mngt/Reclamation.hpp"
+#include "nostrautils/mem_mngt/SharedPtr.hpp"
 #include "nostrautils/mem_mngt/Utils.hpp"
 
 #include "nostrautils/thread/Threads.hpp"
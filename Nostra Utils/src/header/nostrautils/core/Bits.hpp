@@ -0,0 +1,81 @@
+#ifndef NOU_CORE_BITS_HPP
+#define NOU_CORE_BITS_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+
+#if NOU_COMPILER == NOU_COMPILER_VISUAL_CPP
+#    include <intrin.h>
+#endif
+
+/**
+\file core/Bits.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains functions that operate on the bits of integers.
+*/
+
+namespace NOU::NOU_CORE
+{
+	/**
+	\param value The value to count the zeros of. Must not be 0.
+
+	\return The amount of trailing zero bits.
+
+	\brief Returns the amount of trailing zero bits in \p value.
+	*/
+	inline uint32 countTrailingZeros(uint64 value)
+	{
+#if NOU_COMPILER == NOU_COMPILER_VISUAL_CPP
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return static_cast<uint32>(index);
+#elif NOU_COMPILER == NOU_COMPILER_GCC || NOU_COMPILER == NOU_COMPILER_CLANG || \
+	NOU_COMPILER == NOU_COMPILER_MIN_GW
+		return static_cast<uint32>(__builtin_ctzll(value));
+#else
+		uint32 ret = 0;
+
+		while ((value & 1) == 0)
+		{
+			value >>= 1;
+			ret++;
+		}
+
+		return ret;
+#endif
+	}
+
+	/**
+	\param value The value to count the zeros of. Must not be 0.
+
+	\return The amount of leading zero bits.
+
+	\brief Returns the amount of leading zero bits in \p value.
+	*/
+	inline uint32 countLeadingZeros(uint64 value)
+	{
+#if NOU_COMPILER == NOU_COMPILER_VISUAL_CPP
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return 63 - static_cast<uint32>(index);
+#elif NOU_COMPILER == NOU_COMPILER_GCC || NOU_COMPILER == NOU_COMPILER_CLANG || \
+	NOU_COMPILER == NOU_COMPILER_MIN_GW
+		return static_cast<uint32>(__builtin_clzll(value));
+#else
+		uint32 ret = 0;
+
+		while ((value & (uint64(1) << 63)) == 0)
+		{
+			value <<= 1;
+			ret++;
+		}
+
+		return ret;
+#endif
+	}
+}
+
+#endif
@@ -700,6 +700,19 @@ Usually, this is defined by CMake.
 #define NOU_CPP14_COMPATIBILITY
 #endif
 
+/**
+\brief A macro that is only defined if the coroutine task type nostra::utils::thread::Co should be available.
+
+\details 
+A macro that is only defined if the coroutine task type nostra::utils::thread::Co should be available. This
+requires the library to be compiled with C++20.
+
+Usually, this is defined by CMake.
+*/
+#if NOU_COMPILER == NOU_COMPILER_DOXYGEN //Only present for Doxygen
+#define NOU_ENABLE_COROUTINES
+#endif
+
 
 namespace NOU::NOU_CORE
 {
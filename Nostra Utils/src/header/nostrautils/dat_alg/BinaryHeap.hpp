@@ -29,6 +29,9 @@ namespace NOU::NOU_DAT_ALG
 	\details This Binary-Heap can function as an Min or Max Heap with priority.
 	the priority is split in 2 parts ( PriorityTypePart(s) ). the first part (right to left) is the unique identifier of the priority,
 	we need that because of our search function. The second part is the "standard" id which will be used for sorting / maintaining the heap law.
+
+	The heap also stores a table that maps the id of each element to its current index. This way, checkIfPresent()
+	takes O(1) on average and deleteById() and changePriority() take O(log n).
 	*/
 	template<typename T, template<typename> class ALLOC> //!!Default parameter specified in dat_alg/FwdDcl.hpp
 	class BinaryHeap final
@@ -42,7 +45,43 @@ namespace NOU::NOU_DAT_ALG
 
 		static_assert(sizeof(PriorityType) == sizeof(PriorityTypePart) * 2);
 
+		/**
+		\brief The factor that the priority is multiplied with before the id is added to it.
+		*/
+		constexpr static PriorityType PRIORITY_FACTOR = 100000000;
+
+		/**
+		\brief The largest id that an element can have. After that id has been used, the ids start at 1 again.
+		*/
+		constexpr static PriorityTypePart MAX_PRIORITY_ID = PRIORITY_FACTOR - 1;
+
 	private:
+		/**
+		\brief An entry in the table that maps the id of an element to its index in the heap.
+		*/
+		struct IdSlot
+		{
+			/**
+			\brief The id of the element, or 0 if the entry is empty.
+			*/
+			PriorityTypePart m_id;
+
+			/**
+			\brief The index of the element in m_data.
+			*/
+			sizeType         m_slot;
+		};
+
+		/**
+		\brief The minimum capacity of the id table.
+		*/
+		constexpr static sizeType MIN_ID_TABLE_CAPACITY = 16;
+
+		/**
+		\brief The value that findIdSlot() returns if an id is not present.
+		*/
+		constexpr static sizeType INVALID_SLOT = -1;
+
 		/**
 		\brief A boolean that indicates whether this heap function as a MIN or a MAX heap.
 		*/
@@ -52,13 +91,18 @@ namespace NOU::NOU_DAT_ALG
 		*/
 		Vector<NOU::NOU_DAT_ALG::Pair<PriorityType, T>, ALLOC>	m_data;
 		/**
+		\brief An open addressing hash table (linear probing) that maps the id of each element to its index in 
+		       m_data. The capacity is always a power of two and at least twice the size of the heap.
+		*/
+		Vector<IdSlot, ALLOC>									m_idTable;
+		/**
 		\brief A counter that provides a unique identifier for every priority.
 		*/
 		PriorityTypePart										m_nextPriorityIdCounter;
 		/**
 		\return					The actual counter increased by 1.
 
-		\brief Returns the next counter.
+		\brief Returns the next counter. Ids that are still in use are skipped.
 		*/
 		PriorityTypePart nextPriorityIdCounter();
 		/**
@@ -66,27 +110,82 @@ namespace NOU::NOU_DAT_ALG
 		\param counter			The counter (default 0: means that the normal count will be increased).
 		\return					A full 64bit priority.
 
-		\brief Takes the raw priority and (just in case of BinaryHeap<T, ALLOC>::decreaseKey a counter).
+		\brief Takes the raw priority and (just in case of BinaryHeap<T, ALLOC>::changePriority a counter).
 		*/
 		PriorityType makePriority(PriorityTypePart rawPriority, PriorityTypePart counter = 0);
 		/**
 		\param priority			A Full priority.
-		\return					The priority part without the counter.
-
-		\brief	Takes the a full priority and returns the part without the counter.
-		*/
-		PriorityTypePart getPriority(PriorityType priority) const;
-		/**
-		\param priority			A Full priority.
 		\return					The counter without the priority part.
 
 		\brief Takes the a full priority and returns the part without the priority.
 		*/
 		PriorityTypePart getPriorityId(PriorityType priority) const;
 		/**
-		\brief Recreates the law of the heap.
+		\param a				An index.
+		\param b				Another index.
+		\return					True, if the element at \p a belongs closer to the root than the one at \p b.
+
+		\brief Compares the priorities of two elements with respect to the type of the heap (min or max).
+		*/
+		boolean isHigher(sizeType a, sizeType b) const;
+		/**
+		\param a				An index.
+		\param b				Another index.
+
+		\brief Swaps two elements of the heap and updates their entries in the id table.
+		*/
+		void swapElements(sizeType a, sizeType b);
+		/**
+		\param index			The index of the element.
+		\return					The new index of the element.
+
+		\brief Moves an element towards the root until the law of the heap is restored.
+		*/
+		sizeType siftUp(sizeType index);
+		/**
+		\param index			The index of the element.
+
+		\brief Moves an element towards the leaves until the law of the heap is restored.
+		*/
+		void siftDown(sizeType index);
+		/**
+		\param index			The index of an element whose priority has changed.
+
+		\brief Restores the law of the heap after the priority of the element at \p index has changed.
+		*/
+		void restore(sizeType index);
+		/**
+		\param index			The index of the element that will be removed.
+
+		\brief Removes the element at \p index by replacing it with the last element.
+		*/
+		void removeAt(sizeType index);
+		/**
+		\param id				An id.
+		\return					The index of the id in the id table, or INVALID_SLOT if it is not present.
+
+		\brief Searches the id table for an id.
+		*/
+		sizeType findIdSlot(PriorityTypePart id) const;
+		/**
+		\param id				An id.
+		\param slot				The index of the element in m_data.
+
+		\brief Inserts an id into the id table. The table will grow if required.
+		*/
+		void insertId(PriorityTypePart id, sizeType slot);
+		/**
+		\param tableIndex		The index of the entry in the id table.
+
+		\brief Removes an entry from the id table (using backward shift deletion, no tombstones are required).
+		*/
+		void eraseIdSlot(sizeType tableIndex);
+		/**
+		\param capacity			The new capacity. Must be a power of two.
+
+		\brief Rebuilds the id table with a new capacity.
 		*/
-		void checkForLaw();
+		void rehashIds(sizeType capacity);
 
 	public:
 		/**
@@ -137,7 +236,27 @@ namespace NOU::NOU_DAT_ALG
 		template<typename... ARGS>
 		PriorityTypePart emplace(PriorityTypePart priority, ARGS&&... args);
 		/**
+		\param priority		The priority that all inserted elements will have.
+		\param data			A pointer to the first element to insert.
+		\param count			The amount of elements to insert.
+		\param ids				If not <tt>nullptr</tt>, the ids of the inserted elements are stored in this 
+		                        array (which must be able to store \p count ids).
+
+		\brief Inserts multiple elements at once.
+
+		\details
+		Inserts multiple elements at once. If more elements are inserted than the heap already contains, the 
+		law of the heap is restored for the entire heap at once (bottom-up, which takes O(n)), otherwise each
+		element is sifted up on its own (which takes O(count * log n)). Either way, this is faster than calling
+		enqueue() for each element.
+		*/
+		void enqueueAll(PriorityTypePart priority, const T *data, sizeType count, PriorityTypePart *ids = nullptr);
+		/**
 		\brief Deletes the root of the heap.
+
+		\details
+		Deletes the root of the heap. The last element is moved to the root and sifted down, which takes
+		O(log n).
 		*/
 		void dequeue();
 
@@ -160,9 +279,20 @@ namespace NOU::NOU_DAT_ALG
 		\param newpriority		The new priority that will be replace the old one.
 
 		\brief This Function searches the heap for the given id and replace its old id of the element with the new one.
+
+		\see changePriority()
 		*/
 		void decreaseKey(PriorityTypePart id, PriorityTypePart newpriority);
 		/**
+		\param id				The id of the element.
+		\param newPriority		The new priority of the element.
+		\return					True, if an element with the passed id was present, false if not.
+
+		\brief Changes the priority of the element with the passed id in O(log n). The id of the element stays
+		       the same.
+		*/
+		boolean changePriority(PriorityTypePart id, PriorityTypePart newPriority);
+		/**
 		\brief Returns the size of the heap (not the height !).
 		*/
 		sizeType size() const;
@@ -185,17 +315,25 @@ namespace NOU::NOU_DAT_ALG
 		*/
 		typename BinaryHeap<T, ALLOC>::PriorityType priorityAt(sizeType index);
 		/**
+		\param priority			A Full priority.
+		\return					The priority part without the counter.
+
+		\brief	Takes the a full priority and returns the part without the counter.
+		*/
+		PriorityTypePart getPriority(PriorityType priority) const;
+		/**
 		\param id			An id.
 
-		\brief Checks if an pair the the given id exists.
+		\brief Checks if an pair the the given id exists. This takes O(1) on average.
 		*/
 		boolean checkIfPresent(PriorityTypePart id);
 		/**
 		\param id			An id.
+		\return				True, if an element with the passed id was present, false if not.
 
-		\brief deletes an pair with the specific id.
+		\brief deletes an pair with the specific id. This takes O(log n).
 		*/
-		void deleteById(PriorityTypePart id);
+		boolean deleteById(PriorityTypePart id);
 
 		/**
 		\param index			An index.
@@ -213,23 +351,42 @@ namespace NOU::NOU_DAT_ALG
 		const T& operator [] (sizeType index) const;
 	};
 
+	template<typename T, template<typename> class ALLOC>
+	constexpr typename BinaryHeap<T, ALLOC>::PriorityType BinaryHeap<T, ALLOC>::PRIORITY_FACTOR;
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr typename BinaryHeap<T, ALLOC>::PriorityTypePart BinaryHeap<T, ALLOC>::MAX_PRIORITY_ID;
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr sizeType BinaryHeap<T, ALLOC>::MIN_ID_TABLE_CAPACITY;
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr sizeType BinaryHeap<T, ALLOC>::INVALID_SLOT;
+
 	template<typename T, template<typename> class ALLOC>
 	typename BinaryHeap<T, ALLOC>::PriorityTypePart BinaryHeap<T, ALLOC>::nextPriorityIdCounter()
 	{
-		return ++m_nextPriorityIdCounter;
+		do
+		{
+			if (m_nextPriorityIdCounter >= MAX_PRIORITY_ID)
+			{
+				m_nextPriorityIdCounter = 0;
+			}
+
+			++m_nextPriorityIdCounter;
+		} 
+		while (findIdSlot(m_nextPriorityIdCounter) != INVALID_SLOT); //only after a wrap around
+
+		return m_nextPriorityIdCounter;
 	}
 
 	template<typename T, template<typename> class ALLOC>
 	typename BinaryHeap<T, ALLOC>::PriorityType BinaryHeap<T, ALLOC>::makePriority(PriorityTypePart rawPriority, PriorityTypePart counter)
 	{
-		PriorityType ret = (rawPriority * 100000000);
+		PriorityType ret = static_cast<PriorityType>(rawPriority) * PRIORITY_FACTOR;
 
 		if (counter == 0)
 		{
-			if (m_nextPriorityIdCounter >= 10000)
-			{
-				m_nextPriorityIdCounter = 0;
-			}
 			ret += nextPriorityIdCounter();
 		}
 		else 
@@ -242,60 +399,204 @@ namespace NOU::NOU_DAT_ALG
 	template<typename T, template<typename> class ALLOC>
 	typename BinaryHeap<T, ALLOC>::PriorityTypePart BinaryHeap<T, ALLOC>::getPriority(PriorityType priority) const
 	{
-		return static_cast<PriorityTypePart>(priority / 100000000);
+		return static_cast<PriorityTypePart>(priority / PRIORITY_FACTOR);
 	}
 
 	template<typename T, template<typename> class ALLOC>
 	typename BinaryHeap<T, ALLOC>::PriorityTypePart BinaryHeap<T, ALLOC>::getPriorityId(PriorityType priority) const
 	{
-		return static_cast<PriorityTypePart>(priority % 10000);
+		return static_cast<PriorityTypePart>(priority % PRIORITY_FACTOR);
 	}
 
 	template<typename T, template<typename> class ALLOC>
-	void BinaryHeap<T, ALLOC>::checkForLaw()
+	boolean BinaryHeap<T, ALLOC>::isHigher(sizeType a, sizeType b) const
 	{
-		sizeType i = m_data.size() - 1;
-
 		if (m_isMinHeap)
+			return getPriority(m_data[a].dataOne) < getPriority(m_data[b].dataOne);
+		else
+			return getPriority(m_data[a].dataOne) > getPriority(m_data[b].dataOne);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void BinaryHeap<T, ALLOC>::swapElements(sizeType a, sizeType b)
+	{
+		m_data.swap(a, b);
+
+		m_idTable[findIdSlot(getPriorityId(m_data[a].dataOne))].m_slot = a;
+		m_idTable[findIdSlot(getPriorityId(m_data[b].dataOne))].m_slot = b;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	sizeType BinaryHeap<T, ALLOC>::siftUp(sizeType index)
+	{
+		while (index > 0)
 		{
-			while (i > 0)
+			sizeType p = (index - 1) / 2;
+
+			if (isHigher(index, p))
+			{
+				swapElements(index, p);
+				index = p;
+			}
+			else
 			{
-				sizeType p = (i - 1) / 2;
-
-				if (getPriority(m_data[i].dataOne) < getPriority(m_data[p].dataOne))
-				{
-					m_data.swap(i, p);
-					i = p;
-				}
-				else
-				{
-					break;
-				}
+				break;
 			}
 		}
-		else
+
+		return index;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void BinaryHeap<T, ALLOC>::siftDown(sizeType index)
+	{
+		while (true)
+		{
+			sizeType l = 2 * index + 1;			//left child
+			sizeType r = 2 * index + 2;			//right child
+
+			if (l >= m_data.size())
+				break;
+
+			sizeType s = l;						//child that belongs closer to the root
+
+			if (r < m_data.size() && isHigher(r, l))
+				s = r;
+
+			if (isHigher(s, index))
+			{
+				swapElements(s, index);
+				index = s;
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void BinaryHeap<T, ALLOC>::restore(sizeType index)
+	{
+		//if the element did not move up, it may need to move down
+		if (siftUp(index) == index)
+			siftDown(index);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void BinaryHeap<T, ALLOC>::removeAt(sizeType index)
+	{
+		sizeType last = m_data.size() - 1;
+
+		eraseIdSlot(findIdSlot(getPriorityId(m_data[index].dataOne)));
+
+		if (index != last)
+		{
+			m_data.swap(index, last);
+			m_idTable[findIdSlot(getPriorityId(m_data[index].dataOne))].m_slot = index;
+		}
+
+		m_data.remove(last); //no shifting, since it is the last element
+
+		if (index != last)
+			restore(index);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	sizeType BinaryHeap<T, ALLOC>::findIdSlot(PriorityTypePart id) const
+	{
+		if (m_idTable.size() == 0)
+			return INVALID_SLOT;
+
+		sizeType mask = m_idTable.size() - 1;
+
+		//the ids are sequential, so they are already distributed evenly
+		for (sizeType i = id & mask; m_idTable[i].m_id != 0; i = (i + 1) & mask)
 		{
-			while (i > 0)
+			if (m_idTable[i].m_id == id)
+				return i;
+		}
+
+		return INVALID_SLOT;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void BinaryHeap<T, ALLOC>::insertId(PriorityTypePart id, sizeType slot)
+	{
+		//keep the load factor at or below 0.5
+		if ((m_data.size() + 1) * 2 > m_idTable.size())
+		{
+			sizeType capacity = m_idTable.size() < MIN_ID_TABLE_CAPACITY ? MIN_ID_TABLE_CAPACITY :
+				m_idTable.size();
+
+			while ((m_data.size() + 1) * 2 > capacity)
+				capacity *= 2;
+
+			rehashIds(capacity);
+		}
+
+		sizeType mask = m_idTable.size() - 1;
+		sizeType i = id & mask;
+
+		while (m_idTable[i].m_id != 0)
+			i = (i + 1) & mask;
+
+		m_idTable[i].m_id = id;
+		m_idTable[i].m_slot = slot;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void BinaryHeap<T, ALLOC>::eraseIdSlot(sizeType tableIndex)
+	{
+		sizeType mask = m_idTable.size() - 1;
+		sizeType hole = tableIndex;
+
+		//move entries back into the hole, as long as that does not place them before their home index
+		for (sizeType i = (hole + 1) & mask; m_idTable[i].m_id != 0; i = (i + 1) & mask)
+		{
+			sizeType home = m_idTable[i].m_id & mask;
+
+			//the distance from home to i is larger than the distance from home to the hole
+			if (((i - home) & mask) >= ((i - hole) & mask))
 			{
-				sizeType p = static_cast<sizeType>(i - 1) / 2;
-
-				if (getPriority(m_data[i].dataOne) > getPriority(m_data[p].dataOne))
-				{
-					m_data.swap(i, p);
-					i = p;
-				}
-				else
-				{
-					break;
-				}
+				m_idTable[hole] = m_idTable[i];
+				hole = i;
 			}
 		}
+
+		m_idTable[hole].m_id = 0;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void BinaryHeap<T, ALLOC>::rehashIds(sizeType capacity)
+	{
+		Vector<IdSlot, ALLOC> table(capacity);
+
+		for (sizeType i = 0; i < capacity; i++)
+			table.pushBack(IdSlot{ 0, 0 });
+
+		sizeType mask = capacity - 1;
+
+		for (sizeType i = 0; i < m_data.size(); i++)
+		{
+			PriorityTypePart id = getPriorityId(m_data[i].dataOne);
+			sizeType j = id & mask;
+
+			while (table[j].m_id != 0)
+				j = (j + 1) & mask;
+
+			table[j].m_id = id;
+			table[j].m_slot = i;
+		}
+
+		m_idTable = NOU_CORE::move(table);
 	}
 
 	template<typename T, template<typename> class ALLOC>
 	BinaryHeap<T, ALLOC>::BinaryHeap(boolean isMinHeap, sizeType size, Allocator &&allocator) :
 		m_isMinHeap(isMinHeap),
 		m_data(size, NOU_CORE::move(allocator)),
+		m_idTable(0),
 		m_nextPriorityIdCounter(0) //counter still starts at 0
 	{}
 
@@ -303,13 +604,15 @@ namespace NOU::NOU_DAT_ALG
 	BinaryHeap<T, ALLOC>::BinaryHeap(const BinaryHeap<T, ALLOC> &other) :
 		m_isMinHeap(other.m_isMinHeap),
 		m_data(other.m_data),
+		m_idTable(other.m_idTable),
 		m_nextPriorityIdCounter(other.m_nextPriorityIdCounter)
 	{}
 
 	template<typename T, template<typename> class ALLOC>
 	BinaryHeap<T, ALLOC>::BinaryHeap(BinaryHeap &&other) :
 		m_isMinHeap(other.m_isMinHeap),
-		m_data(other.m_data),
+		m_data(NOU_CORE::move(other.m_data)),
+		m_idTable(NOU_CORE::move(other.m_idTable)),
 		m_nextPriorityIdCounter(other.m_nextPriorityIdCounter)
 	{}
 
@@ -330,75 +633,59 @@ namespace NOU::NOU_DAT_ALG
 	typename BinaryHeap<T, ALLOC>::PriorityTypePart BinaryHeap<T, ALLOC>::emplace(PriorityTypePart priority, ARGS&&... args)
 	{
 		PriorityType pt = makePriority(priority);
+		PriorityTypePart id = getPriorityId(pt);
 
 		Pair<PriorityType, T> p(NOU_CORE::move(pt), T(NOU_CORE::forward<ARGS>(args)...));
 
+		insertId(id, m_data.size());
+
 		m_data.pushBack(NOU_CORE::move(p));
 
-		checkForLaw();
+		siftUp(m_data.size() - 1);
 
-		return getPriorityId(pt);
+		return id;
 	}
 
 	template<typename T, template<typename> class ALLOC>
-	void BinaryHeap<T, ALLOC>::dequeue()
+	void BinaryHeap<T, ALLOC>::enqueueAll(PriorityTypePart priority, const T *data, sizeType count, 
+		PriorityTypePart *ids)
 	{
-		m_data.remove(0);
+		sizeType oldSize = m_data.size();
 
-		if (m_data.size() <= 3)
+		for (sizeType i = 0; i < count; i++)
 		{
-			return;
-		}
+			PriorityType pt = makePriority(priority);
+			PriorityTypePart id = getPriorityId(pt);
 
-		sizeType b = 0;
-		if (m_isMinHeap)
-		{
-			while (b < (m_data.size() / 2) - 2)
-			{
-				sizeType l = 2 * b + 1;			//left child
-				sizeType r = 2 * b + 2;			//right child
-
-				sizeType s = l;					//smaller child
+			insertId(id, m_data.size());
 
-				if (getPriority(m_data[r].dataOne) < getPriority(m_data[l].dataOne))
-					s = r;
+			m_data.pushBack(Pair<PriorityType, T>(NOU_CORE::move(pt), T(data[i])));
 
-				if (getPriority(m_data[s].dataOne) < getPriority(m_data[b].dataOne))
-				{
-					m_data.swap(s, b);
-					b = s;
-				}
-				else
-				{
-					break;
-				}
+			if (ids != nullptr)
+				ids[i] = id;
+		}
 
-			}
+		if (count > oldSize)
+		{
+			//rebuild the entire heap, starting at the last element that has children
+			for (sizeType i = m_data.size() / 2; i > 0; i--)
+				siftDown(i - 1);
 		}
 		else
 		{
-			while (b < (m_data.size() / 2) - 2)
-			{
-				sizeType l = 2 * b + 1;			//left child
-				sizeType r = 2 * b + 2;			//right child
-
-				sizeType s = l;					//smaller child
-
-				if (getPriority(m_data[r].dataOne) > getPriority(m_data[l].dataOne))
-					s = r;
+			for (sizeType i = oldSize; i < m_data.size(); i++)
+				siftUp(i);
+		}
+	}
 
-				if (getPriority(m_data[s].dataOne) > getPriority(m_data[b].dataOne))
-				{
-					m_data.swap(s, b);
-					b = s;
-				}
-				else
-				{
-					break;
-				}
+	template<typename T, template<typename> class ALLOC>
+	void BinaryHeap<T, ALLOC>::dequeue()
+	{
+		NOU_COND_PUSH_ERROR((m_data.size() == 0),
+			NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_OBJECT, "The heap is empty.");
 
-			}
-		}
+		if (m_data.size() > 0)
+			removeAt(0);
 	}
 
 	template<typename T, template<typename> class ALLOC>
@@ -416,30 +703,24 @@ namespace NOU::NOU_DAT_ALG
 	template<typename T, template<typename> class ALLOC>
 	void BinaryHeap<T, ALLOC>::decreaseKey(PriorityTypePart id , PriorityTypePart newpriority)
 	{
-		for (sizeType i = 0; i < m_data.size(); i++)
-		{
-			if (getPriorityId(m_data[i].dataOne) == id)
-			{
-				PriorityType p = makePriority(newpriority, id);
-				m_data.at(i).dataOne = p;
-				sizeType c = i;
-				while (c > 0)
-				{
-					sizeType p = (i - 1) / 2;
-
-					if (getPriority(m_data[c].dataOne) < getPriority(m_data[p].dataOne))
-					{
-						m_data.swap(c, p);
-						c = p;
-					}
-					else
-					{
-						break;
-					}
-				}
-				return;
-			}
-		}
+		changePriority(id, newpriority);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean BinaryHeap<T, ALLOC>::changePriority(PriorityTypePart id, PriorityTypePart newPriority)
+	{
+		sizeType tableIndex = findIdSlot(id);
+
+		if (tableIndex == INVALID_SLOT)
+			return false;
+
+		sizeType index = m_idTable[tableIndex].m_slot;
+
+		m_data[index].dataOne = makePriority(newPriority, id);
+
+		restore(index);
+
+		return true;
 	}
 
 	template<typename T, template<typename> class ALLOC>
@@ -475,28 +756,23 @@ namespace NOU::NOU_DAT_ALG
 	template<typename T, template<typename> class ALLOC>
 	boolean BinaryHeap<T, ALLOC>::checkIfPresent(PriorityTypePart id)
 	{
-		for (sizeType i = 0; i < m_data.size(); i++)
-		{
-			if (getPriorityId(priorityAt(i)) == id)
-			{
-				return true;
-			}
-		}
-
-		return false;
+		return id != 0 && findIdSlot(id) != INVALID_SLOT;
 	}
 
 	template<typename T, template<typename> class ALLOC>
-	void BinaryHeap<T, ALLOC>::deleteById(PriorityTypePart id)
+	boolean BinaryHeap<T, ALLOC>::deleteById(PriorityTypePart id)
 	{
-		for (sizeType i = 0; i < m_data.size(); i++)
-		{
-			if (getPriorityId(priorityAt(i)) == id)
-			{
-				m_data.remove(i);
-				checkForLaw();
-			}
-		}
+		if (id == 0) //0 marks an empty entry in the id table
+			return false;
+
+		sizeType tableIndex = findIdSlot(id);
+
+		if (tableIndex == INVALID_SLOT)
+			return false;
+
+		removeAt(m_idTable[tableIndex].m_slot);
+
+		return true;
 	}
 
 	template<typename T, template<typename> class ALLOC>
@@ -0,0 +1,597 @@
+#ifndef NOU_DAT_ALG_CONCURRENT_HASH_MAP_HPP
+#define NOU_DAT_ALG_CONCURRENT_HASH_MAP_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Meta.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/core/ErrorHandler.hpp"
+#include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/mem_mngt/Utils.hpp"
+#include "nostrautils/dat_alg/Comparator.hpp"
+#include "nostrautils/dat_alg/FlatHashMap.hpp"
+#include "nostrautils/dat_alg/FwdDcl.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
+#include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/thread/Lock.hpp"
+
+#include <new>
+
+/**
+\file dat_alg/ConcurrentHashMap.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::dat_alg::ConcurrentHashMap class.
+*/
+
+namespace NOU::NOU_DAT_ALG
+{
+	/**
+	\tparam K     The type of the keys.
+	\tparam V     The type of the values.
+	\tparam ALLOC The type of the allocation callback.
+
+	\brief A hash map that can be accessed by multiple threads at the same time.
+
+	\details
+	A hash map that can be accessed by multiple threads at the same time. The map is split into multiple
+	shards, each of which is a FlatHashMap that is protected by its own mutex (lock striping). A key is
+	always stored in the same shard, which is chosen using the upper bits of the hash of the key. This way,
+	threads that access different keys rarely wait for each other.
+
+	The API is the same as the one of HashMap, with the following exceptions:
+	- Since another thread may remove an element at any time, no references to values are returned. Instead,
+	  get() returns a copy of the value.
+	- keySet() and entrySet() return copies of the keys and values.
+	- There is no operator [].
+	- computeIfAbsent() allows to look up a value and insert it if it does not exist in a single, atomic
+	  step.
+
+	\note
+	The methods that operate on the entire map (like size() or keySet()) lock one shard after another. Their
+	result is not a consistent snapshot if other threads modify the map at the same time.
+	*/
+	//!!Default parameter specified in dat_alg/FwdDcl.hpp
+	template<typename K, typename V, template<typename> class ALLOC>
+	class ConcurrentHashMap final
+	{
+	public:
+		/**
+		\brief The default amount of shards.
+		*/
+		constexpr static sizeType DEFAULT_SHARD_COUNT = 16;
+
+		/**
+		\brief The maximum amount of shards.
+		*/
+		constexpr static sizeType MAX_SHARD_COUNT = 256;
+
+		/**
+		\brief The default capacity of the entire map.
+		*/
+		constexpr static sizeType DEFAULT_CAPACITY = 16;
+
+	private:
+		/**
+		\brief A single shard of the map. Each shard occupies its own cache line(s), so that locking one shard
+		       does not slow down threads that access another one.
+		*/
+		struct alignas(NOU_MEM_MNGT::CACHE_LINE_SIZE) Shard
+		{
+			/**
+			\brief The mutex that protects \p m_map.
+			*/
+			NOU_THREAD::Mutex       m_mutex;
+
+			/**
+			\brief The elements of the shard.
+			*/
+			FlatHashMap<K, V, ALLOC> m_map;
+
+			/**
+			\param capacity The initial capacity of the shard.
+
+			\brief Constructs a new, empty shard.
+			*/
+			explicit Shard(sizeType capacity);
+		};
+
+		/**
+		\brief The allocator that is used to allocate the shards.
+		*/
+		ALLOC<Shard> m_allocator;
+
+		/**
+		\brief The shards.
+		*/
+		Shard       *m_shards;
+
+		/**
+		\brief The amount of shards minus one. Since the amount of shards is a power of two, this can be used
+		       to mask the shard index.
+		*/
+		sizeType     m_shardMask;
+
+		/**
+		\param key A key.
+
+		\return The shard that \p key belongs to.
+
+		\brief Returns the shard that a key belongs to.
+		*/
+		Shard& shardOf(const K &key) const;
+
+	public:
+		/**
+		\param capacity   The initial capacity of the entire map. This is split evenly between all shards.
+		\param shardCount The amount of shards. This will be rounded up to the next power of two and clamped to
+		                  MAX_SHARD_COUNT.
+
+		\brief Constructs a new, empty map.
+		*/
+		explicit ConcurrentHashMap(sizeType capacity = DEFAULT_CAPACITY,
+			sizeType shardCount = DEFAULT_SHARD_COUNT);
+
+		ConcurrentHashMap(const ConcurrentHashMap &other) = delete;
+
+		ConcurrentHashMap(ConcurrentHashMap &&other) = delete;
+
+		/**
+		\brief Destroys all elements.
+		*/
+		~ConcurrentHashMap();
+
+		ConcurrentHashMap& operator = (const ConcurrentHashMap &other) = delete;
+
+		ConcurrentHashMap& operator = (ConcurrentHashMap &&other) = delete;
+
+		/**
+		\param key   The key that the passed value will be mapped to.
+		\param value The value that will be mapped to the passed key.
+
+		\return	True, if the key-value-pair was successfully added to the map, false if not.
+
+		\brief Adds a new value and a new key that the values is mapped to.
+
+		\details
+		Adds a new value and a new key that the values is mapped to. If a key already exists in the map, the
+		value that is mapped to that key will be overridden.
+
+		\note
+		In reality, there are many more overloads for this method that are not documented here for the sake of
+		clarity. Those overloads take different combinations of L- and R-Values.
+		*/
+		boolean map(const K &key, const V &value);
+
+		///\cond
+
+		boolean map(K &&key, V &&value);
+
+		boolean map(const K &key, V &&value);
+
+		boolean map(K &&key, const V &value);
+
+		///\endcond
+
+		/**
+		\param key   The key that the passed value will be mapped to.
+		\param value The value that will be mapped to the passed key.
+		\param comp  The comparator that will used to compare keys.
+
+		\return	True, if the key-value-pair was successfully added to the map, false if not.
+
+		\brief Same as map(const K&, const V&), but uses the passed comparator for comparisons of keys.
+		*/
+		boolean map(const K &key, const V &value, Comparator<K> comp);
+
+		/**
+		\tparam FN The type of the function that creates the value.
+
+		\param key      The key of the value.
+		\param function A function that is called with \p key and returns the value that will be mapped to
+		                \p key, if there is no value yet.
+
+		\return A copy of the value that is mapped to \p key after the call.
+
+		\brief Returns the value that is mapped to \p key. If there is none, it is created using \p function
+		       first.
+
+		\details
+		Returns the value that is mapped to \p key. If there is none, it is created using \p function first.
+		The look up and the insertion happen atomically, i.e. \p function is called at most once for each key,
+		even if multiple threads call this method with the same key at the same time.
+
+		\warning
+		\p function is called while the shard of the key is locked. It must not access the same map.
+		*/
+		template<typename FN>
+		V computeIfAbsent(const K &key, FN &&function);
+
+		/**
+		\param key The key of the value that should be returned.
+
+		\return A copy of the value that is mapped to \p key.
+
+		\brief Returns a copy of the value that is mapped to \p key.
+
+		\details
+		Returns a copy of the value that is mapped to \p key. If there is none, an error is pushed to the error
+		handler and a default constructed value is returned.
+		*/
+		V get(const K &key) const;
+
+		/**
+		\param key  The key of the value that should be returned.
+		\param comp The comparator that will used to compare keys.
+
+		\return A copy of the value that is mapped to \p key.
+
+		\brief Same as get(), but uses the passed comparator for comparisons of keys.
+		*/
+		V get(const K &key, Comparator<K> comp) const;
+
+		/**
+		\param key The key of the value that should be returned.
+		\param out The object that the value will be copied to, if it exists.
+
+		\return True, if the key was found, false if not.
+
+		\brief Copies the value that is mapped to \p key to \p out. Unlike get(), this does not push an error
+		       if the key is not in the map.
+		*/
+		boolean tryGet(const K &key, V &out) const;
+
+		/**
+		\param key The key that will be checked.
+
+		\return \p true if the key is contained inside the map, \p false if not.
+
+		\brief Returns whether the key is contained in the map.
+		*/
+		boolean containsKey(const K &key) const;
+
+		/**
+		\param key  The key that will be checked.
+		\param comp The comparator that will used to compare keys.
+
+		\return \p true if the key is contained inside the map, \p false if not.
+
+		\brief Same as containsKey(), but uses the passed comparator for comparisons of keys.
+		*/
+		boolean containsKey(const K &key, Comparator<K> comp) const;
+
+		/**
+		\param key The key of the value that will be removed.
+		\param out An optional output parameter. If this is not \p nullptr, the object that was removed will be
+		           moved into it.
+
+		\return True, if the key was removed, false if it was not in the map.
+
+		\brief Removes the value with the passed key.
+		*/
+		boolean remove(const K &key, V *out = nullptr);
+
+		/**
+		\brief Removes all elements.
+		*/
+		void clear();
+
+		/**
+		\return \p true if empty, \p false if not.
+
+		\brief Returns whether the map is empty or not.
+		*/
+		boolean isEmpty() const;
+
+		/**
+		\return The amount of key-value-pairs that are currently in the map.
+
+		\brief Returns the amount of key-value-pairs that are currently in the map.
+		*/
+		sizeType size() const;
+
+		/**
+		\return The amount of shards.
+
+		\brief Returns the amount of shards.
+		*/
+		sizeType shardCount() const;
+
+		/**
+		\return A vector that contains copies of all keys that currently have a value mapped to them.
+
+		\brief Returns a vector that contains copies of all keys that currently have a value mapped to them.
+		*/
+		Vector<K> keySet() const;
+
+		/**
+		\return A vector that contains copies of all values that currently are mapped to a key.
+
+		\brief Returns a vector that contains copies of all values that currently are mapped to a key.
+		*/
+		Vector<V> entrySet() const;
+	};
+
+	///\cond
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentHashMap<K, V, ALLOC>::DEFAULT_SHARD_COUNT;
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentHashMap<K, V, ALLOC>::MAX_SHARD_COUNT;
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentHashMap<K, V, ALLOC>::DEFAULT_CAPACITY;
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	ConcurrentHashMap<K, V, ALLOC>::Shard::Shard(sizeType capacity) :
+		m_map(capacity)
+	{}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	typename ConcurrentHashMap<K, V, ALLOC>::Shard& ConcurrentHashMap<K, V, ALLOC>::shardOf(const K &key) const
+	{
+		//the shard maps use the lower bits of the same hash, so the upper ones are used to choose the shard
+		sizeType index = static_cast<sizeType>(Hasher<K>()(key) >> 56) & m_shardMask;
+
+		return m_shards[index];
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	ConcurrentHashMap<K, V, ALLOC>::ConcurrentHashMap(sizeType capacity, sizeType shardCount) :
+		m_shards(nullptr),
+		m_shardMask(0)
+	{
+		sizeType count = 1;
+
+		while (count < shardCount && count < MAX_SHARD_COUNT)
+			count *= 2;
+
+		m_shards = m_allocator.allocate(count);
+
+		if (m_shards == nullptr)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The allocation failed.");
+
+			return;
+		}
+
+		m_shardMask = count - 1;
+
+		for (sizeType i = 0; i < count; i++)
+			new (m_shards + i) Shard((capacity + count - 1) / count);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	ConcurrentHashMap<K, V, ALLOC>::~ConcurrentHashMap()
+	{
+		if (m_shards == nullptr)
+			return;
+
+		for (sizeType i = 0; i <= m_shardMask; i++)
+			m_shards[i].~Shard();
+
+		m_allocator.deallocate(m_shards);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::map(const K &key, const V &value)
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		return shard.m_map.map(key, value);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::map(K &&key, V &&value)
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		return shard.m_map.map(NOU_CORE::move(key), NOU_CORE::move(value));
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::map(const K &key, V &&value)
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		return shard.m_map.map(key, NOU_CORE::move(value));
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::map(K &&key, const V &value)
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		return shard.m_map.map(NOU_CORE::move(key), value);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::map(const K &key, const V &value, Comparator<K> comp)
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		return shard.m_map.map(key, value, comp);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	template<typename FN>
+	V ConcurrentHashMap<K, V, ALLOC>::computeIfAbsent(const K &key, FN &&function)
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		V *value = shard.m_map.find(key);
+
+		if (value != nullptr)
+			return *value;
+
+		shard.m_map.map(key, V(function(key)));
+
+		return shard.m_map.get(key);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	V ConcurrentHashMap<K, V, ALLOC>::get(const K &key) const
+	{
+		Shard &shard = shardOf(key);
+
+		{
+			NOU_THREAD::Lock lock(shard.m_mutex);
+
+			const V *value = shard.m_map.find(key);
+
+			if (value != nullptr)
+				return *value;
+		}
+
+		//push the error after unlocking, the error handler may be looked up in this very map
+		NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_OBJECT,
+			"No object was found.");
+
+		return V();
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	V ConcurrentHashMap<K, V, ALLOC>::get(const K &key, Comparator<K> comp) const
+	{
+		Shard &shard = shardOf(key);
+
+		{
+			NOU_THREAD::Lock lock(shard.m_mutex);
+
+			if (shard.m_map.containsKey(key, comp))
+				return shard.m_map.get(key, comp);
+		}
+
+		NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_OBJECT,
+			"No object was found.");
+
+		return V();
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::tryGet(const K &key, V &out) const
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		const V *value = shard.m_map.find(key);
+
+		if (value == nullptr)
+			return false;
+
+		out = *value;
+
+		return true;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::containsKey(const K &key) const
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		return shard.m_map.containsKey(key);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::containsKey(const K &key, Comparator<K> comp) const
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		return shard.m_map.containsKey(key, comp);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::remove(const K &key, V *out)
+	{
+		Shard &shard = shardOf(key);
+		NOU_THREAD::Lock lock(shard.m_mutex);
+
+		return shard.m_map.remove(key, out);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	void ConcurrentHashMap<K, V, ALLOC>::clear()
+	{
+		for (sizeType i = 0; i <= m_shardMask; i++)
+		{
+			NOU_THREAD::Lock lock(m_shards[i].m_mutex);
+
+			m_shards[i].m_map.clear();
+		}
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean ConcurrentHashMap<K, V, ALLOC>::isEmpty() const
+	{
+		return size() == 0;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	sizeType ConcurrentHashMap<K, V, ALLOC>::size() const
+	{
+		sizeType ret = 0;
+
+		for (sizeType i = 0; i <= m_shardMask; i++)
+		{
+			NOU_THREAD::Lock lock(m_shards[i].m_mutex);
+
+			ret += m_shards[i].m_map.size();
+		}
+
+		return ret;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	sizeType ConcurrentHashMap<K, V, ALLOC>::shardCount() const
+	{
+		return m_shardMask + 1;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	Vector<K> ConcurrentHashMap<K, V, ALLOC>::keySet() const
+	{
+		Vector<K> ret;
+
+		for (sizeType i = 0; i <= m_shardMask; i++)
+		{
+			NOU_THREAD::Lock lock(m_shards[i].m_mutex);
+
+			for (const K *key : m_shards[i].m_map.keySet())
+				ret.pushBack(*key);
+		}
+
+		return ret;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	Vector<V> ConcurrentHashMap<K, V, ALLOC>::entrySet() const
+	{
+		Vector<V> ret;
+
+		for (sizeType i = 0; i <= m_shardMask; i++)
+		{
+			NOU_THREAD::Lock lock(m_shards[i].m_mutex);
+
+			for (const V *value : m_shards[i].m_map.entrySet())
+				ret.pushBack(*value);
+		}
+
+		return ret;
+	}
+
+	///\endcond
+}
+
+#endif
@@ -0,0 +1,647 @@
+#ifndef NOU_DAT_ALG_CONCURRENT_OBJECT_POOL_HPP
+#define NOU_DAT_ALG_CONCURRENT_OBJECT_POOL_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/core/ErrorHandler.hpp"
+#include "nostrautils/mem_mngt/Utils.hpp"
+#include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/thread/Lock.hpp"
+
+#include <atomic>
+#include <new>
+
+/**
+\file dat_alg/ConcurrentObjectPool.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::dat_alg::ConcurrentObjectPool class.
+
+\see nostra::utils::dat_alg::ConcurrentObjectPool
+*/
+
+namespace NOU::NOU_DAT_ALG
+{
+	/**
+	\tparam T     The type of the stored objects.
+	\tparam ALLOC The type of the allocation callback.
+
+	\brief A pool of objects that grows on demand, can be used by multiple threads at the same time and refers
+	       to its objects using generation-checked handles.
+
+	\details
+	A pool of objects that grows on demand, can be used by multiple threads at the same time and refers to its
+	objects using generation-checked handles.
+
+	Unlike ObjectPool, this pool has no fixed capacity. If no slot is free, a new slab of slots is allocated.
+	Slabs are never moved or released before the pool is destroyed, hence the address of an object stays the
+	same for its entire lifetime. The free slots are stored in a lock-free stack whose head is tagged with a
+	counter to prevent the ABA problem; emplaceObject() and giveBack() only take a lock if a new slab has to be
+	allocated.
+
+	An object is not referred to by a pointer, but by a Handle, which consists of the index of the slot and the
+	generation of the slot at the time that the object was created. The generation of a slot is increased each
+	time an object is created in it or given back. This means, that a handle to an object that has already been
+	given back (a stale handle) is detected by a single comparison, even if the slot has been reused by then.
+
+	\note
+	The generation check does not make resolve() safe against an object being given back by another thread at
+	the same time, it only detects handles that were already stale when resolve() was called. Since the
+	generations are 32 bit values, a stale handle may be taken for a valid one after a slot has been reused
+	2^31 times.
+	*/
+	template<typename T, template<typename> class ALLOC = NOU_MEM_MNGT::GenericAllocationCallback>
+	class ConcurrentObjectPool final
+	{
+	public:
+		/**
+		\brief The default amount of slots per slab.
+		*/
+		constexpr static sizeType DEFAULT_SLAB_SIZE = 64;
+
+		/**
+		\brief The maximum amount of slabs. This limits the amount of objects to
+		       <tt>MAX_SLABS * slabSize</tt>.
+		*/
+		constexpr static sizeType MAX_SLABS = 4096;
+
+		/**
+		\brief The maximum amount of slots per slab. The slots are identified by 32 bit indices and the free 
+		       stack stores <tt>index + 1</tt>, hence <tt>MAX_SLABS * MAX_SLAB_SIZE</tt> must be smaller 
+		       than 2^32.
+		*/
+		constexpr static sizeType MAX_SLAB_SIZE = (sizeType(1) << 31) / MAX_SLABS;
+
+		/**
+		\brief A handle to an object in the pool.
+		*/
+		class Handle final
+		{
+			friend class ConcurrentObjectPool;
+
+		private:
+			/**
+			\brief The index of the slot.
+			*/
+			uint32 m_index;
+
+			/**
+			\brief The generation of the slot when the object was created. This is always odd for a handle that
+			       was returned by emplaceObject() and 0 for an invalid handle.
+			*/
+			uint32 m_generation;
+
+			/**
+			\param index      The index of the slot.
+			\param generation The generation of the slot.
+
+			\brief Constructs a new instance.
+			*/
+			Handle(uint32 index, uint32 generation);
+
+		public:
+			/**
+			\brief Constructs a handle that never refers to an object.
+			*/
+			Handle();
+
+			/**
+			\return The index of the slot.
+
+			\brief Returns the index of the slot that the object is stored in.
+			*/
+			uint32 getIndex() const;
+
+			/**
+			\return The generation.
+
+			\brief Returns the generation of the slot at the time that the object was created.
+			*/
+			uint32 getGeneration() const;
+
+			/**
+			\return True, if the handle was returned by emplaceObject(), false if it was default constructed.
+
+			\brief Returns whether the handle was returned by emplaceObject(). This does not check whether the
+			       object still exists, see ConcurrentObjectPool::isValid() for that.
+			*/
+			boolean isNull() const;
+
+			/**
+			\param other The handle to compare with.
+
+			\return True, if both handles are the same, false if not.
+			*/
+			boolean operator == (const Handle &other) const;
+
+			/**
+			\param other The handle to compare with.
+
+			\return True, if the handles are different, false if not.
+			*/
+			boolean operator != (const Handle &other) const;
+		};
+
+	private:
+		/**
+		\brief A single slot.
+		*/
+		struct Slot
+		{
+			/**
+			\brief The storage of the object.
+			*/
+			alignas(T) byte m_storage[sizeof(T)];
+
+			/**
+			\brief The generation of the slot. It is odd while the slot stores an object.
+			*/
+			std::atomic<uint32> m_generation;
+
+			/**
+			\brief The index (plus one) of the next free slot, 0 if there is none. Only meaningful while the
+			       slot is free.
+			*/
+			std::atomic<uint32> m_next;
+		};
+
+		/**
+		\brief The amount of slots per slab. This is always a power of two.
+		*/
+		sizeType m_slabSize;
+
+		/**
+		\brief The binary logarithm of \p m_slabSize.
+		*/
+		sizeType m_slabShift;
+
+		/**
+		\brief The allocator of the slabs.
+		*/
+		ALLOC<Slot> m_slotAllocator;
+
+		/**
+		\brief The slabs. The entries are only written while \p m_growthMutex is locked, but read without a
+		       lock.
+		*/
+		std::atomic<Slot*> *m_slabs;
+
+		/**
+		\brief The amount of slabs. Only modified while \p m_growthMutex is locked.
+		*/
+		std::atomic<sizeType> m_slabCount;
+
+		/**
+		\brief The amount of objects that are currently in the pool.
+		*/
+		std::atomic<sizeType> m_size;
+
+		/**
+		\brief The stack of free slots. The lower 32 bits are the index (plus one) of the top slot, the upper
+		       32 bits are a counter that prevents the ABA problem.
+		*/
+		alignas(NOU_MEM_MNGT::CACHE_LINE_SIZE) std::atomic<uint64> m_freeSlots;
+
+		/**
+		\brief The mutex that is locked while a new slab is allocated.
+		*/
+		NOU_THREAD::Mutex m_growthMutex;
+
+		/**
+		\param index The index of a slot. The slab of the slot must exist.
+
+		\return The slot with the passed index.
+		*/
+		Slot& slot(uint32 index) const;
+
+		/**
+		\param handle The handle.
+
+		\return The slot that the handle refers to, or <tt>nullptr</tt> if the index is out of bounds.
+		*/
+		Slot* slotOf(const Handle &handle) const;
+
+		/**
+		\param index The index of the popped slot.
+
+		\return True, if a slot was popped, false if the stack was empty.
+
+		\brief Pops a slot from \p m_freeSlots.
+		*/
+		boolean pop(uint32 &index);
+
+		/**
+		\param first The index of the first slot of the chain.
+		\param last  The index of the last slot of the chain. The slots from \p first to \p last must be linked
+		             using Slot::m_next.
+
+		\brief Pushes a chain of slots to \p m_freeSlots.
+		*/
+		void push(uint32 first, uint32 last);
+
+		/**
+		\param index The index of the slot that can be used by the caller.
+
+		\return True, if a slot was obtained, false if not.
+
+		\brief Allocates a new slab. One slot is returned to the caller, the others are pushed to
+		       \p m_freeSlots.
+		*/
+		boolean grow(uint32 &index);
+
+	public:
+		/**
+		\param slabSize The amount of slots that are allocated at once. This is rounded up to the next power of
+		                two and clamped to \p MAX_SLAB_SIZE.
+
+		\brief Constructs a new, empty pool. No memory for the slots is allocated yet.
+		*/
+		explicit ConcurrentObjectPool(sizeType slabSize = DEFAULT_SLAB_SIZE);
+
+		ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+		ConcurrentObjectPool(ConcurrentObjectPool&&) = delete;
+
+		/**
+		\brief Destructs all objects that are still in the pool and releases all memory.
+		*/
+		~ConcurrentObjectPool();
+
+		ConcurrentObjectPool& operator = (const ConcurrentObjectPool&) = delete;
+		ConcurrentObjectPool& operator = (ConcurrentObjectPool&&) = delete;
+
+		/**
+		\tparam ARGS The types of the arguments that the object will be constructed from.
+
+		\param args The arguments that the object will be constructed from.
+
+		\return A handle to the new object, or a null handle if no memory could be allocated.
+
+		\brief Constructs a new object in the pool.
+		*/
+		template<typename... ARGS>
+		Handle emplaceObject(ARGS&&... args);
+
+		/**
+		\param handle The handle of the object.
+
+		\return True, if the object was destructed, false if the handle is stale or null.
+
+		\brief Destructs an object and makes its slot available again. If the handle is stale or null, an error
+		       is pushed.
+		*/
+		boolean giveBack(const Handle &handle);
+
+		/**
+		\param handle The handle of the object.
+
+		\return The object, or <tt>nullptr</tt> if the handle is stale or null.
+
+		\brief Returns the object that a handle refers to.
+		*/
+		T* resolve(const Handle &handle);
+
+		/**
+		\param handle The handle of the object.
+
+		\return The object, or <tt>nullptr</tt> if the handle is stale or null.
+
+		\brief Returns the object that a handle refers to.
+		*/
+		const T* resolve(const Handle &handle) const;
+
+		/**
+		\param handle The handle to check.
+
+		\return True, if the handle refers to an object in the pool, false if it is stale or null.
+
+		\brief Returns whether a handle refers to an object in the pool.
+		*/
+		boolean isValid(const Handle &handle) const;
+
+		/**
+		\return The amount of objects in the pool.
+
+		\brief Returns the amount of objects that are currently in the pool.
+		*/
+		sizeType size() const;
+
+		/**
+		\return The amount of slots.
+
+		\brief Returns the amount of slots that have been allocated, this includes both used and free ones.
+		*/
+		sizeType capacity() const;
+	};
+
+	///\cond
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentObjectPool<T, ALLOC>::DEFAULT_SLAB_SIZE;
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentObjectPool<T, ALLOC>::MAX_SLABS;
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentObjectPool<T, ALLOC>::MAX_SLAB_SIZE;
+
+	template<typename T, template<typename> class ALLOC>
+	ConcurrentObjectPool<T, ALLOC>::Handle::Handle(uint32 index, uint32 generation) :
+		m_index(index),
+		m_generation(generation)
+	{}
+
+	template<typename T, template<typename> class ALLOC>
+	ConcurrentObjectPool<T, ALLOC>::Handle::Handle() :
+		m_index(0),
+		m_generation(0)
+	{}
+
+	template<typename T, template<typename> class ALLOC>
+	uint32 ConcurrentObjectPool<T, ALLOC>::Handle::getIndex() const
+	{
+		return m_index;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	uint32 ConcurrentObjectPool<T, ALLOC>::Handle::getGeneration() const
+	{
+		return m_generation;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentObjectPool<T, ALLOC>::Handle::isNull() const
+	{
+		return m_generation == 0;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentObjectPool<T, ALLOC>::Handle::operator == (const Handle &other) const
+	{
+		return m_index == other.m_index && m_generation == other.m_generation;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentObjectPool<T, ALLOC>::Handle::operator != (const Handle &other) const
+	{
+		return !(*this == other);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentObjectPool<T, ALLOC>::Slot& ConcurrentObjectPool<T, ALLOC>::slot(uint32 index) const
+	{
+		return m_slabs[index >> m_slabShift].load(std::memory_order_acquire)[index & (m_slabSize - 1)];
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentObjectPool<T, ALLOC>::Slot*
+		ConcurrentObjectPool<T, ALLOC>::slotOf(const Handle &handle) const
+	{
+		if ((handle.m_index >> m_slabShift) >= m_slabCount.load(std::memory_order_acquire))
+			return nullptr;
+
+		return &slot(handle.m_index);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentObjectPool<T, ALLOC>::pop(uint32 &index)
+	{
+		uint64 head = m_freeSlots.load(std::memory_order_acquire);
+
+		while (true)
+		{
+			uint32 top = static_cast<uint32>(head);
+
+			if (top == 0)
+				return false;
+
+			//slabs are never released, reading the slot is safe even if it has already been popped
+			uint32 next = slot(top - 1).m_next.load(std::memory_order_relaxed);
+			uint64 newHead = (((head >> 32) + 1) << 32) | next;
+
+			if (m_freeSlots.compare_exchange_weak(head, newHead, std::memory_order_acq_rel,
+				std::memory_order_acquire))
+			{
+				index = top - 1;
+				return true;
+			}
+		}
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void ConcurrentObjectPool<T, ALLOC>::push(uint32 first, uint32 last)
+	{
+		Slot &lastSlot = slot(last);
+		uint64 head = m_freeSlots.load(std::memory_order_relaxed);
+		uint64 newHead;
+
+		do
+		{
+			lastSlot.m_next.store(static_cast<uint32>(head), std::memory_order_relaxed);
+			newHead = (((head >> 32) + 1) << 32) | (first + 1);
+		} while (!m_freeSlots.compare_exchange_weak(head, newHead, std::memory_order_release,
+			std::memory_order_relaxed));
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentObjectPool<T, ALLOC>::grow(uint32 &index)
+	{
+		NOU_THREAD::Lock lock(m_growthMutex);
+
+		//another thread may have grown the pool in the meantime
+		if (pop(index))
+			return true;
+
+		sizeType slabCount = m_slabCount.load(std::memory_order_relaxed);
+
+		if (m_slabs == nullptr || slabCount == MAX_SLABS)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The maximum amount of slabs has been reached.");
+
+			return false;
+		}
+
+		Slot *slab = m_slotAllocator.allocate(m_slabSize);
+
+		if (slab == nullptr)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The allocation failed.");
+
+			return false;
+		}
+
+		uint32 first = static_cast<uint32>(slabCount * m_slabSize);
+
+		for (sizeType i = 0; i < m_slabSize; i++)
+		{
+			new (&slab[i].m_generation) std::atomic<uint32>(0);
+			new (&slab[i].m_next) std::atomic<uint32>(first + static_cast<uint32>(i) + 2);
+		}
+
+		m_slabs[slabCount].store(slab, std::memory_order_release);
+		m_slabCount.store(slabCount + 1, std::memory_order_release);
+
+		//the first slot goes directly to the caller, the others to the stack
+		index = first;
+
+		if (m_slabSize > 1)
+			push(first + 1, first + static_cast<uint32>(m_slabSize) - 1);
+
+		return true;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	ConcurrentObjectPool<T, ALLOC>::ConcurrentObjectPool(sizeType slabSize) :
+		m_slabSize(1),
+		m_slabShift(0),
+		m_slabs(nullptr),
+		m_slabCount(0),
+		m_size(0),
+		m_freeSlots(0)
+	{
+		static_assert(MAX_SLABS * MAX_SLAB_SIZE <= (uint64(1) << 32) - 1);
+
+		//larger slabs would overflow the indices of the slots
+		while (m_slabSize < slabSize && m_slabSize < MAX_SLAB_SIZE)
+		{
+			m_slabSize <<= 1;
+			m_slabShift++;
+		}
+
+		m_slabs = ALLOC<std::atomic<Slot*>>().allocate(MAX_SLABS);
+
+		if (m_slabs == nullptr)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The allocation failed.");
+			return;
+		}
+
+		for (sizeType i = 0; i < MAX_SLABS; i++)
+			new (m_slabs + i) std::atomic<Slot*>(nullptr);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	ConcurrentObjectPool<T, ALLOC>::~ConcurrentObjectPool()
+	{
+		sizeType slabCount = m_slabCount.load(std::memory_order_acquire);
+
+		for (sizeType i = 0; i < slabCount; i++)
+		{
+			Slot *slab = m_slabs[i].load(std::memory_order_relaxed);
+
+			for (sizeType j = 0; j < m_slabSize; j++)
+			{
+				//objects that have not been given back are destructed as well
+				if ((slab[j].m_generation.load(std::memory_order_relaxed) & 1) != 0)
+					reinterpret_cast<T*>(slab[j].m_storage)->~T();
+			}
+
+			m_slotAllocator.deallocate(slab);
+		}
+
+		if (m_slabs != nullptr)
+			ALLOC<std::atomic<Slot*>>().deallocate(m_slabs);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	template<typename... ARGS>
+	typename ConcurrentObjectPool<T, ALLOC>::Handle ConcurrentObjectPool<T, ALLOC>::emplaceObject(
+		ARGS&&... args)
+	{
+		uint32 index;
+
+		if (!pop(index) && !grow(index))
+			return Handle();
+
+		Slot &s = slot(index);
+
+		new (s.m_storage) T(NOU_CORE::forward<ARGS>(args)...);
+
+		//the slot is owned by this thread, no other thread writes the generation
+		uint32 generation = s.m_generation.load(std::memory_order_relaxed) + 1;
+
+		//skip 0 after a wrap around, that generation is reserved for null handles
+		if (generation == 0)
+			generation = 1;
+
+		s.m_generation.store(generation, std::memory_order_release);
+
+		m_size.fetch_add(1, std::memory_order_relaxed);
+
+		return Handle(index, generation);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentObjectPool<T, ALLOC>::giveBack(const Handle &handle)
+	{
+		Slot *s = handle.isNull() ? nullptr : slotOf(handle);
+
+		uint32 expected = handle.m_generation;
+
+		//only one of multiple threads that give back the same handle can succeed
+		if (s == nullptr || !s->m_generation.compare_exchange_strong(expected, handle.m_generation + 1,
+			std::memory_order_acq_rel, std::memory_order_relaxed))
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_OBJECT,
+				"The handle does not refer to an object in the pool.");
+
+			return false;
+		}
+
+		reinterpret_cast<T*>(s->m_storage)->~T();
+
+		m_size.fetch_sub(1, std::memory_order_relaxed);
+
+		push(handle.m_index, handle.m_index);
+
+		return true;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	T* ConcurrentObjectPool<T, ALLOC>::resolve(const Handle &handle)
+	{
+		return const_cast<T*>(static_cast<const ConcurrentObjectPool*>(this)->resolve(handle));
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	const T* ConcurrentObjectPool<T, ALLOC>::resolve(const Handle &handle) const
+	{
+		if (!isValid(handle))
+			return nullptr;
+
+		return reinterpret_cast<const T*>(slot(handle.m_index).m_storage);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentObjectPool<T, ALLOC>::isValid(const Handle &handle) const
+	{
+		if (handle.isNull())
+			return false;
+
+		Slot *s = slotOf(handle);
+
+		return s != nullptr && s->m_generation.load(std::memory_order_acquire) == handle.m_generation;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	sizeType ConcurrentObjectPool<T, ALLOC>::size() const
+	{
+		return m_size.load(std::memory_order_relaxed);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	sizeType ConcurrentObjectPool<T, ALLOC>::capacity() const
+	{
+		return m_slabCount.load(std::memory_order_acquire) * m_slabSize;
+	}
+
+	///\endcond
+}
+
+#endif
@@ -0,0 +1,1093 @@
+#ifndef NOU_DAT_ALG_CONCURRENT_QUEUE_HPP
+#define NOU_DAT_ALG_CONCURRENT_QUEUE_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/core/ErrorHandler.hpp"
+#include "nostrautils/dat_alg/Utils.hpp"
+#include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/mem_mngt/Utils.hpp"
+
+#include <atomic>
+#include <new>
+#include <thread>
+
+/**
+\file dat_alg/ConcurrentQueue.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::dat_alg::ConcurrentQueue class.
+*/
+
+namespace NOU::NOU_DAT_ALG
+{
+	/**
+	\brief An enumeration that stores the access patterns that a ConcurrentQueue can be optimized for.
+	*/
+	enum class ConcurrentQueueMode
+	{
+		/**
+		\brief An arbitrary amount of threads may push and pop at the same time.
+		*/
+		MPMC,
+
+		/**
+		\brief Exactly one thread pushes and exactly one (other) thread pops.
+		*/
+		SPSC
+	};
+
+	namespace internal
+	{
+		/**
+		\tparam T The type of the stored element.
+
+		\brief A single cell of a ConcurrentQueue in the mode ConcurrentQueueMode::MPMC.
+		*/
+		template<typename T>
+		struct ConcurrentQueueCell
+		{
+			/**
+			\brief The sequence number of the cell. It tells producers and consumers whether the cell is
+			       currently free or filled for a certain lap around the ring.
+			*/
+			std::atomic<sizeType> m_sequence;
+
+			/**
+			\brief The memory that the element is constructed in.
+			*/
+			alignas(T) byte m_data[sizeof(T)];
+
+			/**
+			\return A pointer to the element in the cell.
+
+			\brief Returns a pointer to the element in the cell.
+			*/
+			T* data();
+		};
+	}
+
+	/**
+	\tparam T     The type of the stored elements.
+	\tparam MODE  The access pattern that the queue is optimized for.
+	\tparam ALLOC The type of the allocation callback.
+
+	\brief A bounded, lock-free FIFO-Queue that can be accessed by multiple threads at the same time.
+
+	\details
+	A bounded, lock-free FIFO-Queue that can be accessed by multiple threads at the same time. Unlike
+	FastQueue, this queue does not need to be protected by a mutex.
+
+	The queue is a ring buffer with a fixed capacity (which is always a power of two). In the mode
+	ConcurrentQueueMode::MPMC, each cell stores a sequence number as described by Dmitry Vyukov. Producers and
+	consumers claim a position using a single compare-and-swap and then use the sequence number of the cell at
+	that position to hand the element over. The positions of the producers and consumers are placed on
+	separate cache lines to avoid false sharing.
+
+	The methods push() and pop() block (by spinning and yielding) if the queue is full or empty respectively,
+	tryPush() and tryPop() return immediately instead.
+
+	Since another consumer might pop an element at any time, this mode does not provide peek(). The
+	specialization for ConcurrentQueueMode::SPSC does.
+	*/
+	template<typename T, ConcurrentQueueMode MODE = ConcurrentQueueMode::MPMC,
+		template<typename> class ALLOC = NOU_MEM_MNGT::GenericAllocationCallback>
+	class ConcurrentQueue final
+	{
+	public:
+		/**
+		\brief Local class alias.
+		*/
+		using Type = T;
+
+		/**
+		\brief The type of a single cell of the queue.
+		*/
+		using Cell = internal::ConcurrentQueueCell<Type>;
+
+		/**
+		\brief The type of the allocator that is used to allocate the cells.
+		*/
+		using Allocator = ALLOC<Cell>;
+
+		/**
+		\brief The minimum capacity of a ConcurrentQueue.
+		*/
+		static constexpr sizeType MIN_CAPACITY = 2;
+
+	private:
+		/**
+		\brief The allocator that will be used to allocate and deallocate the cells.
+		*/
+		Allocator m_allocator;
+
+		/**
+		\brief The capacity of the queue. This is always a power of two.
+		*/
+		sizeType m_capacity;
+
+		/**
+		\brief The cells of the ring buffer.
+		*/
+		Cell *m_cells;
+
+		/**
+		\brief The position that the next element will be pushed to.
+		*/
+		alignas(NOU_MEM_MNGT::CACHE_LINE_SIZE) std::atomic<sizeType> m_enqueuePosition;
+
+		/**
+		\brief The position that the next element will be popped from.
+		*/
+		alignas(NOU_MEM_MNGT::CACHE_LINE_SIZE) std::atomic<sizeType> m_dequeuePosition;
+
+		/**
+		\return The claimed cell, or <tt>nullptr</tt> if the queue is full.
+
+		\brief Claims a cell to push an element to.
+		*/
+		Cell* claimPushCell();
+
+		/**
+		\param position The claimed position.
+
+		\return The claimed cell, or <tt>nullptr</tt> if the queue is empty.
+
+		\brief Claims a cell to pop an element from.
+		*/
+		Cell* claimPopCell(sizeType &position);
+
+	public:
+		/**
+		\param capacity  The capacity of the queue. This will be rounded up to the next power of two.
+		\param allocator The allocator that will be used to allocate data.
+
+		\brief Constructs a new ConcurrentQueue.
+		*/
+		explicit ConcurrentQueue(sizeType capacity, Allocator &&allocator = Allocator());
+
+		/**
+		\brief Not copy-able.
+		*/
+		ConcurrentQueue(const ConcurrentQueue&) = delete;
+
+		/**
+		\brief Not move-able.
+		*/
+		ConcurrentQueue(ConcurrentQueue&&) = delete;
+
+		/**
+		\brief Destructs all elements that are still in the queue and the queue itself.
+
+		\warning
+		No other thread may access the queue while it is destructed.
+		*/
+		~ConcurrentQueue();
+
+		/**
+		\param data The element to push.
+
+		\return True, if the element was pushed, false if the queue was full.
+
+		\brief Pushes an element to the end of the queue if the queue is not full.
+		*/
+		boolean tryPush(const Type &data);
+
+		/**
+		\param data The element to push.
+
+		\return True, if the element was pushed, false if the queue was full. In that case, \p data was not
+		        moved from.
+
+		\brief Pushes an element to the end of the queue if the queue is not full.
+		*/
+		boolean tryPush(Type &&data);
+
+		/**
+		\param out The object that the popped element will be moved to.
+
+		\return True, if an element was popped, false if the queue was empty.
+
+		\brief Pops the first element of the queue if the queue is not empty.
+		*/
+		boolean tryPop(Type &out);
+
+		/**
+		\param data The element to push.
+
+		\brief Pushes an element to the end of the queue. If the queue is full, the method waits until there
+		       is space.
+
+		\details
+		Pushes an element to the end of the queue. If the queue is full, the method waits until there is 
+		space. If the queue has no buffer (because the allocation failed), an error with the error code
+		ErrorCodes::INVALID_OBJECT is pushed and the element is not pushed.
+		*/
+		void pushBack(const Type &data);
+
+		/**
+		\param data The element to push.
+
+		\brief Pushes an element to the end of the queue. If the queue is full, the method waits until there
+		       is space.
+
+		\details
+		Pushes an element to the end of the queue. If the queue is full, the method waits until there is 
+		space. If the queue has no buffer (because the allocation failed), an error with the error code
+		ErrorCodes::INVALID_OBJECT is pushed and the element is not pushed.
+		*/
+		void pushBack(Type &&data);
+
+		/**
+		\param data The element to push.
+
+		\brief Same as pushBack().
+		*/
+		void push(const Type &data);
+
+		/**
+		\param data The element to push.
+
+		\brief Same as pushBack().
+		*/
+		void push(Type &&data);
+
+		/**
+		\return The first element of the queue.
+
+		\brief Pops the first element of the queue. If the queue is empty, the method waits until an element
+		       is pushed.
+
+		\details
+		Pops the first element of the queue. If the queue is empty, the method waits until an element is 
+		pushed. If the queue has no buffer (because the allocation failed), an error with the error code
+		ErrorCodes::INVALID_OBJECT is pushed and the returned object is invalid.
+		*/
+		Type popFront();
+
+		/**
+		\return The first element of the queue.
+
+		\brief Same as popFront().
+		*/
+		Type pop();
+
+		/**
+		\return The amount of elements in the queue.
+
+		\brief Returns the amount of elements in the queue.
+
+		\note
+		If other threads access the queue at the same time, the returned value is only a hint.
+		*/
+		sizeType size() const;
+
+		/**
+		\return True, if the queue is empty, false if not.
+
+		\brief Returns whether the queue is empty.
+
+		\note
+		If other threads access the queue at the same time, the returned value is only a hint.
+		*/
+		boolean empty() const;
+
+		/**
+		\return The capacity of the queue.
+
+		\brief Returns the maximum amount of elements that can be stored in the queue at the same time.
+		*/
+		sizeType capacity() const;
+
+		/**
+		\return The allocator of the queue.
+
+		\brief Returns the allocator of the queue.
+		*/
+		Allocator& getAllocator();
+	};
+
+	/**
+	\tparam T     The type of the stored elements.
+	\tparam ALLOC The type of the allocation callback.
+
+	\brief The specialization of ConcurrentQueue for a single producer and a single consumer.
+
+	\details
+	The specialization of ConcurrentQueue for a single producer and a single consumer. This specialization
+	does not need any read-modify-write operations at all. The producer and consumer each keep a cached copy of
+	the position of the other side and only reload it if the cached copy claims that the queue is full or
+	empty.
+
+	All methods that push may only be called by the producer and all methods that pop or peek may only be
+	called by the consumer.
+	*/
+	template<typename T, template<typename> class ALLOC>
+	class ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC> final
+	{
+	public:
+		/**
+		\brief Local class alias.
+		*/
+		using Type = T;
+
+		/**
+		\brief The type of the allocator that is used to allocate the elements.
+		*/
+		using Allocator = ALLOC<Type>;
+
+		/**
+		\brief The minimum capacity of a ConcurrentQueue.
+		*/
+		static constexpr sizeType MIN_CAPACITY = 2;
+
+	private:
+		/**
+		\brief The allocator that will be used to allocate and deallocate the elements.
+		*/
+		Allocator m_allocator;
+
+		/**
+		\brief The capacity of the queue. This is always a power of two.
+		*/
+		sizeType m_capacity;
+
+		/**
+		\brief The ring buffer.
+		*/
+		Type *m_data;
+
+		/**
+		\brief The position that the next element will be popped from. Only written by the consumer.
+		*/
+		alignas(NOU_MEM_MNGT::CACHE_LINE_SIZE) std::atomic<sizeType> m_head;
+
+		/**
+		\brief The last value of \p m_tail that the consumer has read.
+		*/
+		sizeType m_cachedTail;
+
+		/**
+		\brief The position that the next element will be pushed to. Only written by the producer.
+		*/
+		alignas(NOU_MEM_MNGT::CACHE_LINE_SIZE) std::atomic<sizeType> m_tail;
+
+		/**
+		\brief The last value of \p m_head that the producer has read.
+		*/
+		sizeType m_cachedHead;
+
+		/**
+		\return A pointer to the memory that the next element will be pushed to, or <tt>nullptr</tt> if the
+		        queue is full.
+
+		\brief Returns the memory that the next element will be pushed to.
+		*/
+		Type* pushSlot();
+
+		/**
+		\return A pointer to the first element, or <tt>nullptr</tt> if the queue is empty.
+
+		\brief Returns the first element.
+		*/
+		Type* frontSlot();
+
+	public:
+		/**
+		\param capacity  The capacity of the queue. This will be rounded up to the next power of two.
+		\param allocator The allocator that will be used to allocate data.
+
+		\brief Constructs a new ConcurrentQueue.
+		*/
+		explicit ConcurrentQueue(sizeType capacity, Allocator &&allocator = Allocator());
+
+		/**
+		\brief Not copy-able.
+		*/
+		ConcurrentQueue(const ConcurrentQueue&) = delete;
+
+		/**
+		\brief Not move-able.
+		*/
+		ConcurrentQueue(ConcurrentQueue&&) = delete;
+
+		/**
+		\brief Destructs all elements that are still in the queue and the queue itself.
+		*/
+		~ConcurrentQueue();
+
+		/**
+		\param data The element to push.
+
+		\return True, if the element was pushed, false if the queue was full.
+
+		\brief Pushes an element to the end of the queue if the queue is not full.
+		*/
+		boolean tryPush(const Type &data);
+
+		/**
+		\param data The element to push.
+
+		\return True, if the element was pushed, false if the queue was full. In that case, \p data was not
+		        moved from.
+
+		\brief Pushes an element to the end of the queue if the queue is not full.
+		*/
+		boolean tryPush(Type &&data);
+
+		/**
+		\param out The object that the popped element will be moved to.
+
+		\return True, if an element was popped, false if the queue was empty.
+
+		\brief Pops the first element of the queue if the queue is not empty.
+		*/
+		boolean tryPop(Type &out);
+
+		/**
+		\param data The element to push.
+
+		\brief Pushes an element to the end of the queue. If the queue is full, the method waits until there
+		       is space.
+
+		\details
+		Pushes an element to the end of the queue. If the queue is full, the method waits until there is 
+		space. If the queue has no buffer (because the allocation failed), an error with the error code
+		ErrorCodes::INVALID_OBJECT is pushed and the element is not pushed.
+		*/
+		void pushBack(const Type &data);
+
+		/**
+		\param data The element to push.
+
+		\brief Pushes an element to the end of the queue. If the queue is full, the method waits until there
+		       is space.
+
+		\details
+		Pushes an element to the end of the queue. If the queue is full, the method waits until there is 
+		space. If the queue has no buffer (because the allocation failed), an error with the error code
+		ErrorCodes::INVALID_OBJECT is pushed and the element is not pushed.
+		*/
+		void pushBack(Type &&data);
+
+		/**
+		\param data The element to push.
+
+		\brief Same as pushBack().
+		*/
+		void push(const Type &data);
+
+		/**
+		\param data The element to push.
+
+		\brief Same as pushBack().
+		*/
+		void push(Type &&data);
+
+		/**
+		\return The first element of the queue.
+
+		\brief Pops the first element of the queue. If the queue is empty, the method waits until an element
+		       is pushed.
+
+		\details
+		Pops the first element of the queue. If the queue is empty, the method waits until an element is 
+		pushed. If the queue has no buffer (because the allocation failed), an error with the error code
+		ErrorCodes::INVALID_OBJECT is pushed and the returned object is invalid.
+		*/
+		Type popFront();
+
+		/**
+		\return The first element of the queue.
+
+		\brief Same as popFront().
+		*/
+		Type pop();
+
+		/**
+		\return The first element of the queue.
+
+		\brief Returns the first element of the queue without removing it.
+
+		\details
+		Returns the first element of the queue without removing it. If the queue is empty, an error with the
+		error code ErrorCodes::INDEX_OUT_OF_BOUNDS will be pushed and the returned object is invalid.
+		*/
+		Type& peekFront();
+
+		/**
+		\return The first element of the queue.
+
+		\brief Same as peekFront().
+		*/
+		Type& peek();
+
+		/**
+		\return The amount of elements in the queue.
+
+		\brief Returns the amount of elements in the queue.
+
+		\note
+		If the other side accesses the queue at the same time, the returned value is only a hint.
+		*/
+		sizeType size() const;
+
+		/**
+		\return True, if the queue is empty, false if not.
+
+		\brief Returns whether the queue is empty.
+
+		\note
+		If the other side accesses the queue at the same time, the returned value is only a hint.
+		*/
+		boolean empty() const;
+
+		/**
+		\return The capacity of the queue.
+
+		\brief Returns the maximum amount of elements that can be stored in the queue at the same time.
+		*/
+		sizeType capacity() const;
+
+		/**
+		\return The allocator of the queue.
+
+		\brief Returns the allocator of the queue.
+		*/
+		Allocator& getAllocator();
+	};
+
+	namespace internal
+	{
+		/**
+		\param capacity The requested capacity.
+
+		\return The smallest power of two that is greater or equal to both \p capacity and \p minimum.
+
+		\brief Rounds the capacity of a ConcurrentQueue up to the next power of two.
+		*/
+		constexpr sizeType concurrentQueueCapacity(sizeType capacity, sizeType minimum)
+		{
+			sizeType ret = minimum;
+
+			while (ret < capacity)
+				ret *= 2;
+
+			return ret;
+		}
+
+		/**
+		\param spinCount The amount of times that the caller has already waited.
+
+		\brief Waits for a short amount of time. The first few calls only spin, later calls yield the thread.
+		*/
+		inline void concurrentQueueBackoff(sizeType &spinCount)
+		{
+			if (spinCount < 64)
+				spinCount++;
+			else
+				std::this_thread::yield();
+		}
+
+		/**
+		\param capacity The capacity of the queue.
+
+		\return True, if the queue has a buffer, false if not.
+
+		\brief Checks if the buffer of a queue could be allocated. If not, an error is pushed, since the
+		       blocking operations could never finish.
+		*/
+		inline boolean concurrentQueueCheckCapacity(sizeType capacity)
+		{
+			if (capacity == 0)
+			{
+				NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_OBJECT,
+					"The queue has no buffer.");
+
+				return false;
+			}
+
+			return true;
+		}
+
+		template<typename T>
+		T* ConcurrentQueueCell<T>::data()
+		{
+			return reinterpret_cast<T*>(m_data);
+		}
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentQueue<T, MODE, ALLOC>::MIN_CAPACITY;
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, MODE, ALLOC>::Cell* ConcurrentQueue<T, MODE, ALLOC>::claimPushCell()
+	{
+		if (m_capacity == 0)
+			return nullptr;
+
+		sizeType position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Cell *cell = m_cells + (position & (m_capacity - 1));
+			sizeType sequence = cell->m_sequence.load(std::memory_order_acquire);
+			int64 difference = static_cast<int64>(sequence) - static_cast<int64>(position);
+
+			if (difference == 0)
+			{
+				if (m_enqueuePosition.compare_exchange_weak(position, position + 1,
+					std::memory_order_relaxed))
+					return cell;
+			}
+			else if (difference < 0) //the cell still stores an element of the previous lap
+				return nullptr;
+			else
+				position = m_enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, MODE, ALLOC>::Cell* ConcurrentQueue<T, MODE, ALLOC>::claimPopCell(
+		sizeType &position)
+	{
+		if (m_capacity == 0)
+			return nullptr;
+
+		position = m_dequeuePosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Cell *cell = m_cells + (position & (m_capacity - 1));
+			sizeType sequence = cell->m_sequence.load(std::memory_order_acquire);
+			int64 difference = static_cast<int64>(sequence) - static_cast<int64>(position + 1);
+
+			if (difference == 0)
+			{
+				if (m_dequeuePosition.compare_exchange_weak(position, position + 1,
+					std::memory_order_relaxed))
+					return cell;
+			}
+			else if (difference < 0) //the cell has not been filled in this lap yet
+				return nullptr;
+			else
+				position = m_dequeuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	ConcurrentQueue<T, MODE, ALLOC>::ConcurrentQueue(sizeType capacity, Allocator &&allocator) :
+		m_allocator(NOU_CORE::move(allocator)),
+		m_capacity(internal::concurrentQueueCapacity(capacity, MIN_CAPACITY)),
+		m_cells(m_allocator.allocate(m_capacity)),
+		m_enqueuePosition(0),
+		m_dequeuePosition(0)
+	{
+		if (m_cells == nullptr)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The allocation failed.");
+
+			m_capacity = 0;
+			return;
+		}
+
+		for (sizeType i = 0; i < m_capacity; i++)
+			new (&m_cells[i].m_sequence) std::atomic<sizeType>(i);
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	ConcurrentQueue<T, MODE, ALLOC>::~ConcurrentQueue()
+	{
+		if (m_cells == nullptr)
+			return;
+
+		sizeType enqueuePosition = m_enqueuePosition.load(std::memory_order_acquire);
+
+		for (sizeType i = m_dequeuePosition.load(std::memory_order_acquire); i != enqueuePosition; i++)
+			m_cells[i & (m_capacity - 1)].data()->~Type();
+
+		m_allocator.deallocate(m_cells);
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	boolean ConcurrentQueue<T, MODE, ALLOC>::tryPush(const Type &data)
+	{
+		Cell *cell = claimPushCell();
+
+		if (cell == nullptr)
+			return false;
+
+		new (cell->data()) Type(data);
+
+		//+ 1 marks the cell as filled for the current lap
+		cell->m_sequence.store(cell->m_sequence.load(std::memory_order_relaxed) + 1,
+			std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	boolean ConcurrentQueue<T, MODE, ALLOC>::tryPush(Type &&data)
+	{
+		Cell *cell = claimPushCell();
+
+		if (cell == nullptr)
+			return false;
+
+		new (cell->data()) Type(NOU_CORE::move(data));
+
+		cell->m_sequence.store(cell->m_sequence.load(std::memory_order_relaxed) + 1,
+			std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	boolean ConcurrentQueue<T, MODE, ALLOC>::tryPop(Type &out)
+	{
+		sizeType position;
+		Cell *cell = claimPopCell(position);
+
+		if (cell == nullptr)
+			return false;
+
+		out = NOU_CORE::move(*cell->data());
+		cell->data()->~Type();
+
+		//mark the cell as free for the next lap
+		cell->m_sequence.store(position + m_capacity, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	void ConcurrentQueue<T, MODE, ALLOC>::pushBack(const Type &data)
+	{
+		if (!internal::concurrentQueueCheckCapacity(m_capacity))
+			return;
+
+		sizeType spinCount = 0;
+
+		while (!tryPush(data))
+			internal::concurrentQueueBackoff(spinCount);
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	void ConcurrentQueue<T, MODE, ALLOC>::pushBack(Type &&data)
+	{
+		if (!internal::concurrentQueueCheckCapacity(m_capacity))
+			return;
+
+		sizeType spinCount = 0;
+
+		while (!tryPush(NOU_CORE::move(data)))
+			internal::concurrentQueueBackoff(spinCount);
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	void ConcurrentQueue<T, MODE, ALLOC>::push(const Type &data)
+	{
+		pushBack(data);
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	void ConcurrentQueue<T, MODE, ALLOC>::push(Type &&data)
+	{
+		pushBack(NOU_CORE::move(data));
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, MODE, ALLOC>::Type ConcurrentQueue<T, MODE, ALLOC>::popFront()
+	{
+		if (!internal::concurrentQueueCheckCapacity(m_capacity))
+			return NOU_CORE::move(invalidObject<Type>());
+
+		sizeType spinCount = 0;
+		sizeType position;
+		Cell *cell;
+
+		while ((cell = claimPopCell(position)) == nullptr)
+			internal::concurrentQueueBackoff(spinCount);
+
+		Type ret = NOU_CORE::move(*cell->data());
+		cell->data()->~Type();
+
+		cell->m_sequence.store(position + m_capacity, std::memory_order_release);
+
+		return ret;
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, MODE, ALLOC>::Type ConcurrentQueue<T, MODE, ALLOC>::pop()
+	{
+		return popFront();
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	sizeType ConcurrentQueue<T, MODE, ALLOC>::size() const
+	{
+		sizeType enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+		sizeType dequeuePosition = m_dequeuePosition.load(std::memory_order_relaxed);
+
+		return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	boolean ConcurrentQueue<T, MODE, ALLOC>::empty() const
+	{
+		return size() == 0;
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	sizeType ConcurrentQueue<T, MODE, ALLOC>::capacity() const
+	{
+		return m_capacity;
+	}
+
+	template<typename T, ConcurrentQueueMode MODE, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, MODE, ALLOC>::Allocator& ConcurrentQueue<T, MODE, ALLOC>::getAllocator()
+	{
+		return m_allocator;
+	}
+
+
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::MIN_CAPACITY;
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::Type*
+		ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::pushSlot()
+	{
+		sizeType tail = m_tail.load(std::memory_order_relaxed);
+
+		if (tail - m_cachedHead == m_capacity)
+		{
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+
+			if (tail - m_cachedHead == m_capacity)
+				return nullptr;
+		}
+
+		return m_data + (tail & (m_capacity - 1));
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::Type*
+		ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::frontSlot()
+	{
+		sizeType head = m_head.load(std::memory_order_relaxed);
+
+		if (head == m_cachedTail)
+		{
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+			if (head == m_cachedTail)
+				return nullptr;
+		}
+
+		return m_data + (head & (m_capacity - 1));
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::ConcurrentQueue(sizeType capacity,
+		Allocator &&allocator) :
+		m_allocator(NOU_CORE::move(allocator)),
+		m_capacity(internal::concurrentQueueCapacity(capacity, MIN_CAPACITY)),
+		m_data(m_allocator.allocate(m_capacity)),
+		m_head(0),
+		m_cachedTail(0),
+		m_tail(0),
+		m_cachedHead(0)
+	{
+		if (m_data == nullptr)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The allocation failed.");
+
+			//a capacity of 0 makes every push fail
+			m_capacity = 0;
+		}
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::~ConcurrentQueue()
+	{
+		if (m_data == nullptr)
+			return;
+
+		Type *element;
+
+		while ((element = frontSlot()) != nullptr)
+		{
+			element->~Type();
+			m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		m_allocator.deallocate(m_data);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::tryPush(const Type &data)
+	{
+		Type *slot = pushSlot();
+
+		if (slot == nullptr)
+			return false;
+
+		new (slot) Type(data);
+		m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::tryPush(Type &&data)
+	{
+		Type *slot = pushSlot();
+
+		if (slot == nullptr)
+			return false;
+
+		new (slot) Type(NOU_CORE::move(data));
+		m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::tryPop(Type &out)
+	{
+		Type *slot = frontSlot();
+
+		if (slot == nullptr)
+			return false;
+
+		out = NOU_CORE::move(*slot);
+		slot->~Type();
+		m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::pushBack(const Type &data)
+	{
+		if (!internal::concurrentQueueCheckCapacity(m_capacity))
+			return;
+
+		sizeType spinCount = 0;
+
+		while (!tryPush(data))
+			internal::concurrentQueueBackoff(spinCount);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::pushBack(Type &&data)
+	{
+		if (!internal::concurrentQueueCheckCapacity(m_capacity))
+			return;
+
+		sizeType spinCount = 0;
+
+		while (!tryPush(NOU_CORE::move(data)))
+			internal::concurrentQueueBackoff(spinCount);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::push(const Type &data)
+	{
+		pushBack(data);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::push(Type &&data)
+	{
+		pushBack(NOU_CORE::move(data));
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::Type
+		ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::popFront()
+	{
+		if (!internal::concurrentQueueCheckCapacity(m_capacity))
+			return NOU_CORE::move(invalidObject<Type>());
+
+		sizeType spinCount = 0;
+		Type *slot;
+
+		while ((slot = frontSlot()) == nullptr)
+			internal::concurrentQueueBackoff(spinCount);
+
+		Type ret = NOU_CORE::move(*slot);
+		slot->~Type();
+		m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+		return ret;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::Type
+		ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::pop()
+	{
+		return popFront();
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::Type&
+		ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::peekFront()
+	{
+		Type *slot = frontSlot();
+
+		if (slot == nullptr)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INDEX_OUT_OF_BOUNDS,
+				"No elements in the queue");
+
+			return invalidObject<Type>();
+		}
+
+		return *slot;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::Type&
+		ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::peek()
+	{
+		return peekFront();
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	sizeType ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::size() const
+	{
+		sizeType tail = m_tail.load(std::memory_order_relaxed);
+		sizeType head = m_head.load(std::memory_order_relaxed);
+
+		return tail > head ? tail - head : 0;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::empty() const
+	{
+		return size() == 0;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	sizeType ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::capacity() const
+	{
+		return m_capacity;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::Allocator&
+		ConcurrentQueue<T, ConcurrentQueueMode::SPSC, ALLOC>::getAllocator()
+	{
+		return m_allocator;
+	}
+}
+
+#endif
@@ -0,0 +1,1403 @@
+#ifndef NOU_DAT_ALG_FLAT_HASH_MAP_HPP
+#define NOU_DAT_ALG_FLAT_HASH_MAP_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Bits.hpp"
+#include "nostrautils/core/Meta.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/core/ErrorHandler.hpp"
+#include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/dat_alg/Comparator.hpp"
+#include "nostrautils/dat_alg/Hashing.hpp"
+#include "nostrautils/dat_alg/String.hpp"
+#include "nostrautils/dat_alg/StringView.hpp"
+#include "nostrautils/dat_alg/Utils.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
+
+#include <new>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define NOU_FLAT_HASH_MAP_SSE2
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define NOU_FLAT_HASH_MAP_NEON
+#    include <arm_neon.h>
+#endif
+
+/**
+\file dat_alg/FlatHashMap.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::dat_alg::FlatHashMap class.
+*/
+
+namespace NOU::NOU_DAT_ALG
+{
+	namespace internal
+	{
+		/**
+		\brief The type of a single control byte of a FlatHashMap.
+
+		\details
+		The type of a single control byte of a FlatHashMap. A control byte is either FLAT_HASH_MAP_EMPTY,
+		FLAT_HASH_MAP_DELETED or, if the slot is in use, the lower seven bits of the hash of the key
+		(which is always positive).
+		*/
+		using FlatHashMapControl = int8;
+
+		/**
+		\brief The control byte of a slot that has never been in use.
+		*/
+		constexpr FlatHashMapControl FLAT_HASH_MAP_EMPTY = -128;
+
+		/**
+		\brief The control byte of a slot whose element was removed (a tombstone).
+		*/
+		constexpr FlatHashMapControl FLAT_HASH_MAP_DELETED = -2;
+
+		/**
+		\brief The amount of control bytes that are probed at once.
+		*/
+		constexpr sizeType FLAT_HASH_MAP_GROUP_WIDTH = 16;
+
+		/**
+		\brief The set of slots in a group that matched a condition.
+
+		\details
+		The set of slots in a group that matched a condition. Depending on the instruction set, a single slot
+		is represented by one bit (SSE2 and the scalar fallback) or by four bits (NEON).
+		*/
+		class FlatHashMapBitMask final
+		{
+		public:
+			/**
+			\brief The amount of bits that a single slot is shifted by, as a power of two.
+			*/
+#ifdef NOU_FLAT_HASH_MAP_NEON
+			constexpr static uint32 SHIFT = 2;
+#else
+			constexpr static uint32 SHIFT = 0;
+#endif
+
+		private:
+			/**
+			\brief The raw mask.
+			*/
+			uint64 m_mask;
+
+		public:
+			/**
+			\param mask The raw mask.
+
+			\brief Constructs a new bit mask.
+			*/
+			explicit FlatHashMapBitMask(uint64 mask) :
+				m_mask(mask)
+			{}
+
+			/**
+			\return True, if at least one slot is in the mask.
+			*/
+			explicit operator boolean () const
+			{
+				return m_mask != 0;
+			}
+
+			/**
+			\return The index (within the group) of the first slot in the mask.
+
+			\brief Returns the index of the first slot in the mask. The mask must not be empty.
+			*/
+			uint32 lowest() const
+			{
+				return NOU_CORE::countTrailingZeros(m_mask) >> SHIFT;
+			}
+
+			/**
+			\brief Removes the first slot from the mask.
+			*/
+			void removeLowest()
+			{
+				m_mask &= m_mask - 1;
+			}
+
+			/**
+			\return The amount of slots at the beginning of the group that are not in the mask.
+			*/
+			uint32 trailingZeros() const
+			{
+				return m_mask == 0 ? static_cast<uint32>(FLAT_HASH_MAP_GROUP_WIDTH) : lowest();
+			}
+
+			/**
+			\return The amount of slots at the end of the group that are not in the mask.
+			*/
+			uint32 leadingZeros() const
+			{
+				if (m_mask == 0)
+					return static_cast<uint32>(FLAT_HASH_MAP_GROUP_WIDTH);
+
+				constexpr uint32 unusedBits = 64 - static_cast<uint32>(FLAT_HASH_MAP_GROUP_WIDTH << SHIFT);
+
+				return (NOU_CORE::countLeadingZeros(m_mask) - unusedBits) >> SHIFT;
+			}
+		};
+
+		/**
+		\brief A group of FLAT_HASH_MAP_GROUP_WIDTH control bytes that are compared at once.
+
+		\details
+		A group of FLAT_HASH_MAP_GROUP_WIDTH control bytes that are compared at once. If available, SSE2 or
+		NEON are used for the comparisons, otherwise the bytes are compared one after another.
+		*/
+		class FlatHashMapGroup final
+		{
+		private:
+#if defined(NOU_FLAT_HASH_MAP_SSE2)
+			__m128i m_control;
+
+			static FlatHashMapBitMask toMask(__m128i comparison)
+			{
+				return FlatHashMapBitMask(static_cast<uint32>(_mm_movemask_epi8(comparison)));
+			}
+#elif defined(NOU_FLAT_HASH_MAP_NEON)
+			int8x16_t m_control;
+
+			static FlatHashMapBitMask toMask(uint8x16_t comparison)
+			{
+				//narrow each 16 bit lane to 8 bit, this leaves four bits per byte of the comparison
+				uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(comparison), 4);
+
+				return FlatHashMapBitMask(vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) &
+					0x8888888888888888ull);
+			}
+#else
+			const FlatHashMapControl *m_control;
+
+			template<typename PRED>
+			FlatHashMapBitMask toMask(PRED predicate) const
+			{
+				uint64 mask = 0;
+
+				for (sizeType i = 0; i < FLAT_HASH_MAP_GROUP_WIDTH; i++)
+				{
+					if (predicate(m_control[i]))
+						mask |= uint64(1) << i;
+				}
+
+				return FlatHashMapBitMask(mask);
+			}
+#endif
+
+		public:
+			/**
+			\param control A pointer to the first control byte of the group. The following
+			               FLAT_HASH_MAP_GROUP_WIDTH - 1 bytes must be readable as well.
+
+			\brief Loads a group of control bytes.
+			*/
+			explicit FlatHashMapGroup(const FlatHashMapControl *control)
+			{
+#if defined(NOU_FLAT_HASH_MAP_SSE2)
+				m_control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+#elif defined(NOU_FLAT_HASH_MAP_NEON)
+				m_control = vld1q_s8(control);
+#else
+				m_control = control;
+#endif
+			}
+
+			/**
+			\param hash The lower seven bits of a hash.
+
+			\return The slots whose control byte is equal to \p hash.
+			*/
+			FlatHashMapBitMask match(FlatHashMapControl hash) const
+			{
+#if defined(NOU_FLAT_HASH_MAP_SSE2)
+				return toMask(_mm_cmpeq_epi8(_mm_set1_epi8(hash), m_control));
+#elif defined(NOU_FLAT_HASH_MAP_NEON)
+				return toMask(vceqq_s8(vdupq_n_s8(hash), m_control));
+#else
+				return toMask([hash](FlatHashMapControl c) { return c == hash; });
+#endif
+			}
+
+			/**
+			\return The slots that are empty.
+			*/
+			FlatHashMapBitMask matchEmpty() const
+			{
+				return match(FLAT_HASH_MAP_EMPTY);
+			}
+
+			/**
+			\return The slots that are either empty or deleted.
+			*/
+			FlatHashMapBitMask matchEmptyOrDeleted() const
+			{
+				//both special values are smaller than -1, all hashes are positive
+#if defined(NOU_FLAT_HASH_MAP_SSE2)
+				return toMask(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_control));
+#elif defined(NOU_FLAT_HASH_MAP_NEON)
+				return toMask(vcltq_s8(m_control, vdupq_n_s8(-1)));
+#else
+				return toMask([](FlatHashMapControl c) { return c < -1; });
+#endif
+			}
+		};
+
+		/**
+		\tparam K The key type of a map.
+		\tparam Q The type that is used to look up a key.
+
+		\brief Checks whether a key of the type \p K can be looked up using an object of the type \p Q without
+		       converting it to \p K first.
+
+		\details
+		Checks whether a key of the type \p K can be looked up using an object of the type \p Q without
+		converting it to \p K first. This is the case if both types produce the same hash for equal values and
+		can be compared using <tt>operator ==</tt>. For example, a map with String keys can be searched using
+		a StringView.
+		*/
+		template<typename K, typename Q>
+		struct FlatHashMapIsTransparent : NOU_CORE::AreSame<K, Q> {};
+
+		///\cond
+		template<typename CHAR_TYPE>
+		struct FlatHashMapIsTransparent<String<CHAR_TYPE>, StringView<CHAR_TYPE>> : NOU_CORE::TrueType {};
+
+		template<typename CHAR_TYPE>
+		struct FlatHashMapIsTransparent<StringView<CHAR_TYPE>, String<CHAR_TYPE>> : NOU_CORE::TrueType {};
+		///\endcond
+	}
+
+	/**
+	\tparam K     The type of the keys.
+	\tparam V     The type of the values.
+	\tparam ALLOC The type of the allocation callback.
+
+	\brief A hash map that stores its elements in a single array (open addressing).
+
+	\details
+	A hash map that stores its elements in a single array (open addressing). Next to each slot of that array,
+	there is a control byte that stores seven bits of the hash of the key that is stored in that slot (or
+	whether the slot is empty or deleted). When a key is searched, the control bytes are compared in groups
+	of 16 (using SSE2 or NEON, if available) and only the slots whose control byte matches are compared with
+	the key. The keys are hashed using Hasher.
+
+	The map grows automatically as soon as the amount of elements (and deleted slots) exceeds the maximum
+	load factor.
+
+	The API is the same as the one of HashMap. Additionally, keys can be looked up using a different type as
+	long as nostra::utils::dat_alg::internal::FlatHashMapIsTransparent is true for that type (e.g. a map with
+	String keys can be searched using a StringView). Other types are converted to \p K before the lookup.
+
+	\note
+	Inserting or removing elements invalidates all pointers and references to elements of the map.
+	*/
+	template<typename K, typename V, template<typename> class ALLOC = NOU_MEM_MNGT::GenericAllocationCallback>
+	class FlatHashMap final
+	{
+	public:
+		/**
+		\brief The type of the pairs that are stored in the map.
+		*/
+		using Slot = Pair<K, V>;
+
+		/**
+		\brief The allocator that is used to allocate the slots.
+		*/
+		using Allocator = ALLOC<Slot>;
+
+		/**
+		\brief The minimum capacity of a map.
+		*/
+		constexpr static sizeType MIN_CAPACITY = internal::FLAT_HASH_MAP_GROUP_WIDTH;
+
+		/**
+		\brief The default maximum load factor.
+		*/
+		constexpr static float32 DEFAULT_MAX_LOAD_FACTOR = 0.875f;
+
+		/**
+		\brief The largest maximum load factor that can be set. This guarantees that there is always at least
+		       one empty slot, which is required to stop searching.
+		*/
+		constexpr static float32 MAX_MAX_LOAD_FACTOR = 0.9375f;
+
+	private:
+		/**
+		\brief The value that is returned by findIndex() if a key was not found.
+		*/
+		constexpr static sizeType INVALID_INDEX = -1;
+
+		/**
+		\tparam Q The type that a key is looked up with.
+
+		\brief The type that a key will be converted to before it is looked up.
+		*/
+		template<typename Q>
+		using LookupKey = NOU_CORE::TypeIf_t<internal::FlatHashMapIsTransparent<K, Q>::value, Q, K>;
+
+		/**
+		\brief The allocator of the slots.
+		*/
+		Allocator                          m_allocator;
+
+		/**
+		\brief The allocator of the control bytes.
+		*/
+		ALLOC<internal::FlatHashMapControl> m_controlAllocator;
+
+		/**
+		\brief The slots.
+		*/
+		Slot                              *m_slots;
+
+		/**
+		\brief The control bytes. There are <tt>m_capacity + FLAT_HASH_MAP_GROUP_WIDTH</tt> of them, the last
+		       ones are copies of the first ones, so that a group can always be loaded at once.
+		*/
+		internal::FlatHashMapControl      *m_control;
+
+		/**
+		\brief The amount of slots. This is either 0 or a power of two that is at least MIN_CAPACITY.
+		*/
+		sizeType                           m_capacity;
+
+		/**
+		\brief The amount of elements in the map.
+		*/
+		sizeType                           m_size;
+
+		/**
+		\brief The amount of deleted slots.
+		*/
+		sizeType                           m_tombstones;
+
+		/**
+		\brief The maximum load factor.
+		*/
+		float32                            m_maxLoadFactor;
+
+		/**
+		\param capacity A capacity.
+
+		\return The amount of slots (elements and tombstones) that may be in use at the passed capacity.
+		*/
+		sizeType maxElements(sizeType capacity) const;
+
+		/**
+		\param count An amount of elements.
+
+		\return The smallest capacity that can hold \p count elements.
+		*/
+		sizeType capacityFor(sizeType count) const;
+
+		/**
+		\param index   The index of the slot.
+		\param control The new control byte.
+
+		\brief Sets a control byte (and its copy, if there is one).
+		*/
+		void setControl(sizeType index, internal::FlatHashMapControl control);
+
+		/**
+		\tparam Q  The type of the key.
+		\tparam EQ The type of the comparison.
+
+		\param key   The key.
+		\param hash  The hash of the key.
+		\param equal A function that returns true if a key in the map is equal to \p key.
+
+		\return The index of the slot of the key, or INVALID_INDEX.
+
+		\brief Searches for a key.
+		*/
+		template<typename Q, typename EQ>
+		sizeType findIndex(const Q &key, uint64 hash, EQ equal) const;
+
+		/**
+		\param hash The hash of a key.
+
+		\return The first empty or deleted slot in the probe sequence of \p hash.
+		*/
+		sizeType findInsertIndex(uint64 hash) const;
+
+		/**
+		\param capacity The new capacity.
+
+		\return True, if the allocation succeeded, false if not.
+
+		\brief Moves all elements to a new array with the passed capacity. This also removes all tombstones.
+		*/
+		boolean rehash(sizeType capacity);
+
+		/**
+		\brief Destroys all elements and deallocates the arrays.
+		*/
+		void release();
+
+		/**
+		\tparam KEY   The type of the key.
+		\tparam VALUE The type of the value.
+		\tparam EQ    The type of the comparison.
+
+		\param key   The key.
+		\param value The value.
+		\param equal A function that returns true if a key in the map is equal to \p key.
+
+		\return True, if the pair was mapped, false if an allocation failed.
+
+		\brief The implementation of map().
+		*/
+		template<typename KEY, typename VALUE, typename EQ>
+		boolean mapImpl(KEY &&key, VALUE &&value, EQ equal);
+
+		/**
+		\param index The index of the slot.
+
+		\brief Destroys the element in a slot and marks the slot as empty or deleted.
+		*/
+		void eraseIndex(sizeType index);
+
+		/**
+		\return The value that is returned by get() if a key could not be found.
+
+		\brief Pushes an error and returns an invalid value (see invalidObject()). This does not access the
+		       slots, since a moved-from map or a map whose allocation failed has none.
+		*/
+		V& invalidValue() const;
+
+	public:
+		/**
+		\param capacity      The initial capacity. This will be rounded up to the next power of two.
+		\param maxLoadFactor The maximum load factor, see setMaxLoadFactor().
+		\param allocator     The allocator that will be used to allocate the slots.
+
+		\brief Constructs a new, empty map.
+		*/
+		explicit FlatHashMap(sizeType capacity = MIN_CAPACITY, float32 maxLoadFactor = DEFAULT_MAX_LOAD_FACTOR,
+			Allocator &&allocator = Allocator());
+
+		/**
+		\param other The map to copy.
+
+		\brief Copies a map.
+		*/
+		FlatHashMap(const FlatHashMap &other);
+
+		/**
+		\param other The map to move.
+
+		\brief Moves a map. \p other will be empty afterwards.
+		*/
+		FlatHashMap(FlatHashMap &&other);
+
+		/**
+		\brief Destroys all elements.
+		*/
+		~FlatHashMap();
+
+		/**
+		\param other The map to copy.
+
+		\return A reference to this map.
+
+		\brief Copies a map.
+		*/
+		FlatHashMap& operator = (const FlatHashMap &other);
+
+		/**
+		\param other The map to move.
+
+		\return A reference to this map.
+
+		\brief Moves a map. \p other will be empty afterwards.
+		*/
+		FlatHashMap& operator = (FlatHashMap &&other);
+
+		/**
+		\param key   The key that the passed value will be mapped to.
+		\param value The value that will be mapped to the passed key.
+
+		\return	True, if the key-value-pair was successfully added to the map, false if not (which only happens
+		        if an allocation failed).
+
+		\brief Adds a new value and a new key that the values is mapped to.
+
+		\details
+		Adds a new value and a new key that the values is mapped to. This method uses the operator == for
+		comparisons of keys.
+
+		\attention
+		If a key already exists in the map, the value that is mapped to that key will be overridden.
+
+		\note
+		In reality, there are many more overloads for this method that are not documented here for the sake of
+		clarity. Those overloads take different combinations of L- and R-Values.
+		*/
+		boolean map(const K &key, const V &value);
+
+		///\cond
+
+		boolean map(K &&key, V &&value);
+
+		boolean map(const K &key, V &&value);
+
+		boolean map(K &&key, const V &value);
+
+		///\endcond
+
+		/**
+		\param key   The key that the passed value will be mapped to.
+		\param value The value that will be mapped to the passed key.
+		\param comp  The comparator that will used to compare keys.
+
+		\return	True, if the key-value-pair was successfully added to the map, false if not.
+
+		\brief Same as map(const K&, const V&), but uses the passed comparator for comparisons of keys.
+
+		\warning
+		Keys that are equal according to \p comp must produce the same hash.
+		*/
+		boolean map(const K &key, const V &value, Comparator<K> comp);
+
+		///\cond
+
+		boolean map(K &&key, V &&value, Comparator<K> comp);
+
+		boolean map(const K &key, V &&value, Comparator<K> comp);
+
+		boolean map(K &&key, const V &value, Comparator<K> comp);
+
+		///\endcond
+
+		/**
+		\tparam Q The type of the key.
+
+		\param key The key of the value that should be returned.
+
+		\return A pointer to the value that is mapped to \p key, or <tt>nullptr</tt> if there is none.
+
+		\brief Returns a pointer to the value that is mapped to \p key. Unlike get(), this does not push an
+		       error if the key is not in the map.
+		*/
+		template<typename Q = K>
+		V* find(const Q &key);
+
+		/**
+		\tparam Q The type of the key.
+
+		\param key The key of the value that should be returned.
+
+		\return A pointer to the value that is mapped to \p key, or <tt>nullptr</tt> if there is none.
+
+		\brief Returns a pointer to the value that is mapped to \p key. Unlike get(), this does not push an
+		       error if the key is not in the map.
+		*/
+		template<typename Q = K>
+		const V* find(const Q &key) const;
+
+		/**
+		\tparam Q The type of the key.
+
+		\param key The key of the value that should be returned.
+
+		\return The value that is mapped to \p key.
+
+		\brief Returns the value that is mapped to \p key, or an invalid value if no value is mapped to the
+		       key.
+
+		\details
+		Returns the value that is mapped to \p key, or an invalid value if no value is mapped to the key. In
+		the latter case, an error is pushed to the error handler.
+
+		\warning
+		In the case of failure, the returned object is invalid and accessing it in any way might result in
+		undefined behavior.
+		*/
+		template<typename Q = K>
+		V& get(const Q &key);
+
+		/**
+		\tparam Q The type of the key.
+
+		\param key The key of the value that should be returned.
+
+		\return The value that is mapped to \p key.
+
+		\brief Same as the non-const version of get().
+		*/
+		template<typename Q = K>
+		const V& get(const Q &key) const;
+
+		/**
+		\param key  The key of the value that should be returned.
+		\param comp The comparator that will used to compare keys.
+
+		\return The value that is mapped to \p key.
+
+		\brief Same as get(), but uses the passed comparator for comparisons of keys.
+		*/
+		V& get(const K &key, Comparator<K> comp);
+
+		/**
+		\param key  The key of the value that should be returned.
+		\param comp The comparator that will used to compare keys.
+
+		\return The value that is mapped to \p key.
+
+		\brief Same as get(), but uses the passed comparator for comparisons of keys.
+		*/
+		const V& get(const K &key, Comparator<K> comp) const;
+
+		/**
+		\return \p true if empty, \p false if not.
+
+		\brief Returns whether the map is empty or not.
+		*/
+		boolean isEmpty() const;
+
+		/**
+		\return The amount of key-value-pairs that are currently in the map.
+
+		\brief Returns the amount of key-value-pairs that are currently in the map.
+		*/
+		sizeType size() const;
+
+		/**
+		\return The amount of slots.
+
+		\brief Returns the amount of slots. The map grows before this amount times the maximum load factor is
+		       exceeded.
+		*/
+		sizeType capacity() const;
+
+		/**
+		\tparam Q The type of the key.
+
+		\param key The key of the value that will be removed.
+		\param out An optional output parameter. If this is not \p nullptr, the object that was removed will be
+		           moved into it.
+
+		\return True, if the key was removed, false if it was not in the map.
+
+		\brief Removes the value with the passed key.
+		*/
+		template<typename Q = K>
+		boolean remove(const Q &key, V *out = nullptr);
+
+		/**
+		\brief Removes all elements. The capacity stays the same.
+		*/
+		void clear();
+
+		/**
+		\param count The amount of elements.
+
+		\brief Grows the map so that it can hold at least \p count elements without growing again.
+		*/
+		void reserve(sizeType count);
+
+		/**
+		\return A vector that contains all keys that currently have a value mapped to them.
+
+		\brief Returns a vector that contains all keys that currently have a value mapped to them.
+		*/
+		Vector<const K*> keySet() const;
+
+		/**
+		\return A vector that contains all values that currently are mapped to a key.
+
+		\brief Returns a vector that contains all values that currently are mapped to a key.
+		*/
+		Vector<const V*> entrySet() const;
+
+		/**
+		\tparam Q The type of the key.
+
+		\param key The key that will be checked.
+
+		\return \p true if the key is contained inside the map, \p false if not.
+
+		\brief Returns whether the key is contained in the map.
+		*/
+		template<typename Q = K>
+		boolean containsKey(const Q &key) const;
+
+		/**
+		\param key  The key that will be checked.
+		\param comp The comparator that will used to compare keys.
+
+		\return \p true if the key is contained inside the map, \p false if not.
+
+		\brief Same as containsKey(), but uses the passed comparator for comparisons of keys.
+		*/
+		boolean containsKey(const K &key, Comparator<K> comp) const;
+
+		/**
+		\return The maximum load factor.
+
+		\brief Returns the maximum load factor.
+		*/
+		float32 maxLoadFactor() const;
+
+		/**
+		\param maxLoadFactor The new maximum load factor.
+
+		\brief Sets the maximum load factor.
+
+		\details
+		Sets the maximum load factor. This is the ratio of used slots (elements and deleted slots) to the
+		capacity at which the map grows. Smaller values make lookups faster but need more memory.
+
+		If the value is not in the range (0, MAX_MAX_LOAD_FACTOR], an error is pushed to the error handler and
+		the load factor stays the same.
+		*/
+		void setMaxLoadFactor(float32 maxLoadFactor);
+
+		/**
+		\return The allocator of the slots.
+
+		\brief Returns the allocator of the slots.
+		*/
+		const Allocator& getAllocator() const;
+
+		/**
+		\param key The key of the value that should be returned.
+
+		\return Same as get(const K&).
+
+		\brief Same as get(const K&).
+		*/
+		V& operator [](const K &key);
+	};
+
+	///\cond
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	constexpr sizeType FlatHashMap<K, V, ALLOC>::MIN_CAPACITY;
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	constexpr float32 FlatHashMap<K, V, ALLOC>::DEFAULT_MAX_LOAD_FACTOR;
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	constexpr float32 FlatHashMap<K, V, ALLOC>::MAX_MAX_LOAD_FACTOR;
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	constexpr sizeType FlatHashMap<K, V, ALLOC>::INVALID_INDEX;
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	sizeType FlatHashMap<K, V, ALLOC>::maxElements(sizeType capacity) const
+	{
+		sizeType ret = static_cast<sizeType>(static_cast<float64>(capacity) * m_maxLoadFactor);
+
+		//there must always be at least one empty slot
+		return ret < capacity ? ret : capacity - 1;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	sizeType FlatHashMap<K, V, ALLOC>::capacityFor(sizeType count) const
+	{
+		sizeType capacity = MIN_CAPACITY;
+
+		while (maxElements(capacity) < count)
+			capacity *= 2;
+
+		return capacity;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	void FlatHashMap<K, V, ALLOC>::setControl(sizeType index, internal::FlatHashMapControl control)
+	{
+		m_control[index] = control;
+
+		if (index < internal::FLAT_HASH_MAP_GROUP_WIDTH)
+			m_control[m_capacity + index] = control;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	template<typename Q, typename EQ>
+	sizeType FlatHashMap<K, V, ALLOC>::findIndex(const Q &key, uint64 hash, EQ equal) const
+	{
+		if (m_capacity == 0)
+			return INVALID_INDEX;
+
+		sizeType mask = m_capacity - 1;
+		sizeType position = static_cast<sizeType>(hash >> 7) & mask;
+		internal::FlatHashMapControl hashBits = static_cast<internal::FlatHashMapControl>(hash & 0x7F);
+
+		//triangular probing over groups, this visits every group once
+		for (sizeType step = internal::FLAT_HASH_MAP_GROUP_WIDTH; ; step += internal::FLAT_HASH_MAP_GROUP_WIDTH)
+		{
+			internal::FlatHashMapGroup group(m_control + position);
+
+			for (internal::FlatHashMapBitMask match = group.match(hashBits); match; match.removeLowest())
+			{
+				sizeType index = (position + match.lowest()) & mask;
+
+				if (equal(m_slots[index].dataOne, key))
+					return index;
+			}
+
+			if (group.matchEmpty())
+				return INVALID_INDEX;
+
+			position = (position + step) & mask;
+		}
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	sizeType FlatHashMap<K, V, ALLOC>::findInsertIndex(uint64 hash) const
+	{
+		sizeType mask = m_capacity - 1;
+		sizeType position = static_cast<sizeType>(hash >> 7) & mask;
+
+		for (sizeType step = internal::FLAT_HASH_MAP_GROUP_WIDTH; ; step += internal::FLAT_HASH_MAP_GROUP_WIDTH)
+		{
+			internal::FlatHashMapBitMask match = internal::FlatHashMapGroup(m_control + position).
+				matchEmptyOrDeleted();
+
+			if (match)
+				return (position + match.lowest()) & mask;
+
+			position = (position + step) & mask;
+		}
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::rehash(sizeType capacity)
+	{
+		Slot *slots = m_allocator.allocate(capacity);
+		internal::FlatHashMapControl *control = m_controlAllocator.allocate(capacity +
+			internal::FLAT_HASH_MAP_GROUP_WIDTH);
+
+		if (slots == nullptr || control == nullptr)
+		{
+			if (slots != nullptr)
+				m_allocator.deallocate(slots);
+
+			if (control != nullptr)
+				m_controlAllocator.deallocate(control);
+
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The allocation failed.");
+
+			return false;
+		}
+
+		for (sizeType i = 0; i < capacity + internal::FLAT_HASH_MAP_GROUP_WIDTH; i++)
+			control[i] = internal::FLAT_HASH_MAP_EMPTY;
+
+		Slot *oldSlots = m_slots;
+		internal::FlatHashMapControl *oldControl = m_control;
+		sizeType oldCapacity = m_capacity;
+
+		m_slots = slots;
+		m_control = control;
+		m_capacity = capacity;
+		m_tombstones = 0;
+
+		for (sizeType i = 0; i < oldCapacity; i++)
+		{
+			if (oldControl[i] >= 0)
+			{
+				uint64 hash = Hasher<K>()(oldSlots[i].dataOne);
+				sizeType index = findInsertIndex(hash);
+
+				new (m_slots + index) Slot(NOU_CORE::move(oldSlots[i]));
+				setControl(index, static_cast<internal::FlatHashMapControl>(hash & 0x7F));
+
+				oldSlots[i].~Slot();
+			}
+		}
+
+		if (oldSlots != nullptr)
+		{
+			m_allocator.deallocate(oldSlots);
+			m_controlAllocator.deallocate(oldControl);
+		}
+
+		return true;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	void FlatHashMap<K, V, ALLOC>::release()
+	{
+		if (m_slots == nullptr)
+			return;
+
+		for (sizeType i = 0; i < m_capacity; i++)
+		{
+			if (m_control[i] >= 0)
+				m_slots[i].~Slot();
+		}
+
+		m_allocator.deallocate(m_slots);
+		m_controlAllocator.deallocate(m_control);
+
+		m_slots = nullptr;
+		m_control = nullptr;
+		m_capacity = 0;
+		m_size = 0;
+		m_tombstones = 0;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	template<typename KEY, typename VALUE, typename EQ>
+	boolean FlatHashMap<K, V, ALLOC>::mapImpl(KEY &&key, VALUE &&value, EQ equal)
+	{
+		uint64 hash = Hasher<K>()(key);
+		sizeType index = findIndex(key, hash, equal);
+
+		if (index != INVALID_INDEX)
+		{
+			if constexpr (std::is_move_assignable<V>::value)
+			{
+				m_slots[index].dataTwo = NOU_CORE::forward<VALUE>(value);
+			}
+			else
+			{
+				m_slots[index].dataTwo.~V();
+				new (&(m_slots[index].dataTwo)) V(NOU_CORE::forward<VALUE>(value));
+			}
+
+			return true;
+		}
+
+		if (m_capacity == 0 && !rehash(MIN_CAPACITY))
+			return false;
+
+		index = findInsertIndex(hash);
+
+		if (m_control[index] == internal::FLAT_HASH_MAP_EMPTY &&
+			m_size + m_tombstones >= maxElements(m_capacity))
+		{
+			//if at most half of the usable slots are in use, only the tombstones need to be removed
+			sizeType capacity = (m_size + 1) * 2 <= maxElements(m_capacity) ? m_capacity : m_capacity * 2;
+
+			if (!rehash(capacity))
+				return false;
+
+			index = findInsertIndex(hash);
+		}
+
+		if (m_control[index] == internal::FLAT_HASH_MAP_DELETED)
+			m_tombstones--;
+
+		new (m_slots + index) Slot(K(NOU_CORE::forward<KEY>(key)), V(NOU_CORE::forward<VALUE>(value)));
+		setControl(index, static_cast<internal::FlatHashMapControl>(hash & 0x7F));
+		m_size++;
+
+		return true;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	void FlatHashMap<K, V, ALLOC>::eraseIndex(sizeType index)
+	{
+		m_slots[index].~Slot();
+		m_size--;
+
+		sizeType mask = m_capacity - 1;
+
+		internal::FlatHashMapBitMask emptyBefore = internal::FlatHashMapGroup(m_control +
+			((index - internal::FLAT_HASH_MAP_GROUP_WIDTH) & mask)).matchEmpty();
+		internal::FlatHashMapBitMask emptyAfter = internal::FlatHashMapGroup(m_control + index).matchEmpty();
+
+		/*
+		 * If there is an empty slot within each window of FLAT_HASH_MAP_GROUP_WIDTH slots that contains this
+		 * slot, no search can have probed past this slot. In that case, it can be marked as empty instead of
+		 * leaving a tombstone.
+		 */
+		if (emptyBefore && emptyAfter &&
+			emptyAfter.trailingZeros() + emptyBefore.leadingZeros() < internal::FLAT_HASH_MAP_GROUP_WIDTH)
+		{
+			setControl(index, internal::FLAT_HASH_MAP_EMPTY);
+		}
+		else
+		{
+			setControl(index, internal::FLAT_HASH_MAP_DELETED);
+			m_tombstones++;
+		}
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	V& FlatHashMap<K, V, ALLOC>::invalidValue() const
+	{
+		NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_OBJECT,
+			"No object was found.");
+
+		return invalidObject<V>();
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	FlatHashMap<K, V, ALLOC>::FlatHashMap(sizeType capacity, float32 maxLoadFactor, Allocator &&allocator) :
+		m_allocator(NOU_CORE::move(allocator)),
+		m_controlAllocator(NOU_MEM_MNGT::rebindAllocationCallback<ALLOC<internal::FlatHashMapControl>>(
+			m_allocator)),
+		m_slots(nullptr),
+		m_control(nullptr),
+		m_capacity(0),
+		m_size(0),
+		m_tombstones(0),
+		m_maxLoadFactor(DEFAULT_MAX_LOAD_FACTOR)
+	{
+		setMaxLoadFactor(maxLoadFactor);
+
+		sizeType initialCapacity = MIN_CAPACITY;
+
+		while (initialCapacity < capacity)
+			initialCapacity *= 2;
+
+		rehash(initialCapacity);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	FlatHashMap<K, V, ALLOC>::FlatHashMap(const FlatHashMap &other) :
+		m_allocator(other.m_allocator),
+		m_controlAllocator(other.m_controlAllocator),
+		m_slots(nullptr),
+		m_control(nullptr),
+		m_capacity(0),
+		m_size(0),
+		m_tombstones(0),
+		m_maxLoadFactor(other.m_maxLoadFactor)
+	{
+		*this = other;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	FlatHashMap<K, V, ALLOC>::FlatHashMap(FlatHashMap &&other) :
+		m_allocator(NOU_CORE::move(other.m_allocator)),
+		m_controlAllocator(NOU_CORE::move(other.m_controlAllocator)),
+		m_slots(other.m_slots),
+		m_control(other.m_control),
+		m_capacity(other.m_capacity),
+		m_size(other.m_size),
+		m_tombstones(other.m_tombstones),
+		m_maxLoadFactor(other.m_maxLoadFactor)
+	{
+		other.m_slots = nullptr;
+		other.m_control = nullptr;
+		other.m_capacity = 0;
+		other.m_size = 0;
+		other.m_tombstones = 0;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	FlatHashMap<K, V, ALLOC>::~FlatHashMap()
+	{
+		release();
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	FlatHashMap<K, V, ALLOC>& FlatHashMap<K, V, ALLOC>::operator = (const FlatHashMap &other)
+	{
+		if (this == &other)
+			return *this;
+
+		release();
+
+		m_maxLoadFactor = other.m_maxLoadFactor;
+
+		if (other.m_capacity == 0 || !rehash(other.m_capacity))
+			return *this;
+
+		//the capacity is the same, so every element can be copied to the same slot
+		for (sizeType i = 0; i < m_capacity + internal::FLAT_HASH_MAP_GROUP_WIDTH; i++)
+			m_control[i] = other.m_control[i];
+
+		for (sizeType i = 0; i < m_capacity; i++)
+		{
+			if (m_control[i] >= 0)
+				new (m_slots + i) Slot(other.m_slots[i]);
+		}
+
+		m_size = other.m_size;
+		m_tombstones = other.m_tombstones;
+
+		return *this;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	FlatHashMap<K, V, ALLOC>& FlatHashMap<K, V, ALLOC>::operator = (FlatHashMap &&other)
+	{
+		if (this == &other)
+			return *this;
+
+		release();
+
+		m_allocator = NOU_CORE::move(other.m_allocator);
+		m_controlAllocator = NOU_CORE::move(other.m_controlAllocator);
+		m_slots = other.m_slots;
+		m_control = other.m_control;
+		m_capacity = other.m_capacity;
+		m_size = other.m_size;
+		m_tombstones = other.m_tombstones;
+		m_maxLoadFactor = other.m_maxLoadFactor;
+
+		other.m_slots = nullptr;
+		other.m_control = nullptr;
+		other.m_capacity = 0;
+		other.m_size = 0;
+		other.m_tombstones = 0;
+
+		return *this;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::map(const K &key, const V &value)
+	{
+		return mapImpl(key, value, [](const K &a, const K &b) { return a == b; });
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::map(K &&key, V &&value)
+	{
+		return mapImpl(NOU_CORE::move(key), NOU_CORE::move(value), [](const K &a, const K &b) { return a == b; });
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::map(const K &key, V &&value)
+	{
+		return mapImpl(key, NOU_CORE::move(value), [](const K &a, const K &b) { return a == b; });
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::map(K &&key, const V &value)
+	{
+		return mapImpl(NOU_CORE::move(key), value, [](const K &a, const K &b) { return a == b; });
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::map(const K &key, const V &value, Comparator<K> comp)
+	{
+		return mapImpl(key, value, [comp](const K &a, const K &b) { return comp(a, b) == 0; });
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::map(K &&key, V &&value, Comparator<K> comp)
+	{
+		return mapImpl(NOU_CORE::move(key), NOU_CORE::move(value),
+			[comp](const K &a, const K &b) { return comp(a, b) == 0; });
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::map(const K &key, V &&value, Comparator<K> comp)
+	{
+		return mapImpl(key, NOU_CORE::move(value), [comp](const K &a, const K &b) { return comp(a, b) == 0; });
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::map(K &&key, const V &value, Comparator<K> comp)
+	{
+		return mapImpl(NOU_CORE::move(key), value, [comp](const K &a, const K &b) { return comp(a, b) == 0; });
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	template<typename Q>
+	V* FlatHashMap<K, V, ALLOC>::find(const Q &key)
+	{
+		return const_cast<V*>(static_cast<const FlatHashMap*>(this)->find(key));
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	template<typename Q>
+	const V* FlatHashMap<K, V, ALLOC>::find(const Q &key) const
+	{
+		using LookupType = LookupKey<Q>;
+
+		const LookupType &lookup = key; //converts to K, if required
+
+		sizeType index = findIndex(lookup, Hasher<LookupType>()(lookup),
+			[](const K &a, const LookupType &b) { return a == b; });
+
+		return index == INVALID_INDEX ? nullptr : &m_slots[index].dataTwo;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	template<typename Q>
+	V& FlatHashMap<K, V, ALLOC>::get(const Q &key)
+	{
+		V *value = find(key);
+
+		return value == nullptr ? invalidValue() : *value;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	template<typename Q>
+	const V& FlatHashMap<K, V, ALLOC>::get(const Q &key) const
+	{
+		const V *value = find(key);
+
+		return value == nullptr ? invalidValue() : *value;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	V& FlatHashMap<K, V, ALLOC>::get(const K &key, Comparator<K> comp)
+	{
+		sizeType index = findIndex(key, Hasher<K>()(key),
+			[comp](const K &a, const K &b) { return comp(a, b) == 0; });
+
+		return index == INVALID_INDEX ? invalidValue() : m_slots[index].dataTwo;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	const V& FlatHashMap<K, V, ALLOC>::get(const K &key, Comparator<K> comp) const
+	{
+		return const_cast<FlatHashMap*>(this)->get(key, comp);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::isEmpty() const
+	{
+		return m_size == 0;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	sizeType FlatHashMap<K, V, ALLOC>::size() const
+	{
+		return m_size;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	sizeType FlatHashMap<K, V, ALLOC>::capacity() const
+	{
+		return m_capacity;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	template<typename Q>
+	boolean FlatHashMap<K, V, ALLOC>::remove(const Q &key, V *out)
+	{
+		using LookupType = LookupKey<Q>;
+
+		const LookupType &lookup = key;
+
+		sizeType index = findIndex(lookup, Hasher<LookupType>()(lookup),
+			[](const K &a, const LookupType &b) { return a == b; });
+
+		if (index == INVALID_INDEX)
+			return false;
+
+		if (out != nullptr)
+			*out = NOU_CORE::move(m_slots[index].dataTwo);
+
+		eraseIndex(index);
+
+		return true;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	void FlatHashMap<K, V, ALLOC>::clear()
+	{
+		for (sizeType i = 0; i < m_capacity; i++)
+		{
+			if (m_control[i] >= 0)
+				m_slots[i].~Slot();
+		}
+
+		for (sizeType i = 0; i < m_capacity + internal::FLAT_HASH_MAP_GROUP_WIDTH && m_control != nullptr; i++)
+			m_control[i] = internal::FLAT_HASH_MAP_EMPTY;
+
+		m_size = 0;
+		m_tombstones = 0;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	void FlatHashMap<K, V, ALLOC>::reserve(sizeType count)
+	{
+		sizeType capacity = capacityFor(count);
+
+		if (capacity > m_capacity)
+			rehash(capacity);
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	Vector<const K*> FlatHashMap<K, V, ALLOC>::keySet() const
+	{
+		Vector<const K*> ret(m_size);
+
+		for (sizeType i = 0; i < m_capacity; i++)
+		{
+			if (m_control[i] >= 0)
+				ret.emplaceBack(&m_slots[i].dataOne);
+		}
+
+		return ret;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	Vector<const V*> FlatHashMap<K, V, ALLOC>::entrySet() const
+	{
+		Vector<const V*> ret(m_size);
+
+		for (sizeType i = 0; i < m_capacity; i++)
+		{
+			if (m_control[i] >= 0)
+				ret.emplaceBack(&m_slots[i].dataTwo);
+		}
+
+		return ret;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	template<typename Q>
+	boolean FlatHashMap<K, V, ALLOC>::containsKey(const Q &key) const
+	{
+		return find(key) != nullptr;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	boolean FlatHashMap<K, V, ALLOC>::containsKey(const K &key, Comparator<K> comp) const
+	{
+		return findIndex(key, Hasher<K>()(key),
+			[comp](const K &a, const K &b) { return comp(a, b) == 0; }) != INVALID_INDEX;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	float32 FlatHashMap<K, V, ALLOC>::maxLoadFactor() const
+	{
+		return m_maxLoadFactor;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	void FlatHashMap<K, V, ALLOC>::setMaxLoadFactor(float32 maxLoadFactor)
+	{
+		if (!(maxLoadFactor > 0.0f && maxLoadFactor <= MAX_MAX_LOAD_FACTOR))
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_OBJECT,
+				"The maximum load factor must be in the range (0, MAX_MAX_LOAD_FACTOR].");
+
+			return;
+		}
+
+		m_maxLoadFactor = maxLoadFactor;
+
+		//grow immediately, otherwise the next insertion would always trigger a rehash
+		if (m_capacity != 0 && m_size + m_tombstones > maxElements(m_capacity))
+			rehash(capacityFor(m_size));
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	auto FlatHashMap<K, V, ALLOC>::getAllocator() const -> const Allocator&
+	{
+		return m_allocator;
+	}
+
+	template<typename K, typename V, template<typename> class ALLOC>
+	V& FlatHashMap<K, V, ALLOC>::operator [](const K &key)
+	{
+		return get(key);
+	}
+
+	///\endcond
+}
+
+#endif
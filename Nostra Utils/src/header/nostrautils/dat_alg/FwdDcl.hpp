@@ -20,6 +20,7 @@ This file contains forward declarations for:
 - nou::dat_alg::ObjectPool
 - nou::dat_alg::BinaryHeap
 - nou::dat_alg::HashMap
+- nou::dat_alg::ConcurrentHashMap
 - nou::dat_alg::FastQueue
 - nou::dat_alg::Vector
 
@@ -51,6 +52,10 @@ namespace NOU::NOU_DAT_ALG
 		NOU_MEM_MNGT::GenericAllocationCallback>
 	class HashMap;
 
+	template<typename K, typename V, template<typename> class ALLOC =
+		NOU_MEM_MNGT::GenericAllocationCallback>
+	class ConcurrentHashMap;
+
 	template<typename T, template<typename> class ALLOC = NOU_MEM_MNGT::GenericAllocationCallback>
 	class FastQueue;
 
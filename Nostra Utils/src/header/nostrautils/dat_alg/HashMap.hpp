@@ -41,7 +41,7 @@ namespace NOU::NOU_DAT_ALG
 		//can be changed to minimize collisions -> the bigger the more often O(1) occurs
 		constexpr static NOU::sizeType LOAD_SIZE = 20;
 
-		using Allocator = typename Vector<Vector<NOU::NOU_DAT_ALG::Pair<K, V>>, ALLOC>::Allocator;
+		using Allocator = typename Vector<Vector<NOU::NOU_DAT_ALG::Pair<K, V>, ALLOC>, ALLOC>::Allocator;
 
 	private:
 
@@ -128,7 +128,16 @@ namespace NOU::NOU_DAT_ALG
 		/**
 		\brief The buckets.
 		*/
-		Vector<Vector<NOU::NOU_DAT_ALG::Pair<K, V>>, ALLOC> m_data;
+		Vector<Vector<NOU::NOU_DAT_ALG::Pair<K, V>, ALLOC>, ALLOC> m_data;
+
+		/**
+		\param key The key.
+
+		\return The index of the bucket that \p key is stored in.
+
+		\brief Returns the index of the bucket that a key is stored in. The key is hashed using Hasher.
+		*/
+		sizeType bucketOf(const K &key) const;
 
 		/**
 		\param key The key to search.
@@ -449,10 +458,16 @@ namespace NOU::NOU_DAT_ALG
 	template<typename K, typename V, template<typename> class ALLOC>
 	constexpr NOU::sizeType HashMap<K, V, ALLOC>::LOAD_SIZE;
 
+	template<typename K, typename V, template<typename> class ALLOC>
+	sizeType HashMap<K, V, ALLOC>::bucketOf(const K &key) const
+	{
+		return hashValue(static_cast<sizeType>(Hasher<K>()(key)), m_data.size());
+	}
+
 	template<typename K, typename V, template<typename> class ALLOC>
 	NOU::NOU_DAT_ALG::Pair<K, V>* HashMap<K, V, ALLOC>::getPair(const K &key)
 	{
-		NOU::sizeType hash = hashObj(&key, 1, m_data.size());
+		NOU::sizeType hash = bucketOf(key);
 
 		NOU::sizeType size = m_data[hash].size();
 
@@ -471,7 +486,7 @@ namespace NOU::NOU_DAT_ALG
 	template<typename K, typename V, template<typename> class ALLOC>
 	NOU::NOU_DAT_ALG::Pair<K, V>* HashMap<K, V, ALLOC>::getPair(const K &key, Comparator<K> comp)
 	{
-		NOU::sizeType hash = hashObj(&key, 1, m_data.size());
+		NOU::sizeType hash = bucketOf(key);
 
 		NOU::sizeType size = m_data[hash].size();
 
@@ -494,7 +509,7 @@ namespace NOU::NOU_DAT_ALG
 
 		Pair<K, V> tmpPair(NOU_CORE::move(key.rval()), NOU_CORE::move(value.rval()));
 		
-		n = hashObj(&tmpPair.dataOne, 1, m_data.size());
+		n = bucketOf(tmpPair.dataOne);
 
 		if (m_data[n].size() == 0) 
 		{	//if Vector at this position is empty, fill it -> O(1)
@@ -536,7 +551,7 @@ namespace NOU::NOU_DAT_ALG
 
 		Pair<K, V> tmpPair(NOU_CORE::move(key.rval()), NOU_CORE::move(value.rval()));
 
-		n = hashObj(&tmpPair.dataOne, 1, m_data.size());
+		n = bucketOf(tmpPair.dataOne);
 
 		if (m_data[n].size() == 0)
 		{	//if Vector at this position is empty, fill it -> O(1)
@@ -578,7 +593,9 @@ namespace NOU::NOU_DAT_ALG
 	{
 		for (sizeType i = 0; i < size; i++)
 		{
-			m_data.emplaceBack(Vector<Pair<K, V>>());
+			//the buckets use the same allocation callback (e.g. the same arena) as the map itself
+			m_data.emplaceBack(1, 
+				NOU_MEM_MNGT::rebindAllocationCallback<ALLOC<Pair<K, V>>>(m_data.getAllocator()));
 		}
 	}
 	 
@@ -634,7 +651,7 @@ namespace NOU::NOU_DAT_ALG
 	V& HashMap<K, V, ALLOC>::get(const K &key)
 	{
 		sizeType n;
-		n = hashObj(&key, 1, m_data.size());
+		n = bucketOf(key);
 		NOU::NOU_DAT_ALG::Pair<K, V> *pair = getPair(key);
 
 		if (pair == nullptr)
@@ -654,7 +671,7 @@ namespace NOU::NOU_DAT_ALG
 	const V& HashMap<K, V, ALLOC>::get(const K &key) const
 	{
 		sizeType n;
-		n = hashObj(&key, 1, m_data.size());
+		n = bucketOf(key);
 		NOU::NOU_DAT_ALG::Pair<K, V> *pair = const_cast<HashMap<K, V>*>(this)->getPair(key);
 
 		if(pair == nullptr) 
@@ -723,7 +740,7 @@ namespace NOU::NOU_DAT_ALG
 	{
 		sizeType h;
 
-		h = hashObj(&key, 1, m_data.size());
+		h = bucketOf(key);
 
 		for (sizeType i = 0; i < m_data[h].size(); i++)
 		{
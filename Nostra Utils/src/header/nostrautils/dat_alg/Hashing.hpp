@@ -8,6 +8,7 @@
 #include "nostrautils/dat_alg/Vector.hpp"
 #include <limits>
 #include <array>
+#include <type_traits>
 
 
 /** \file Hashing.hpp
@@ -31,6 +32,115 @@ namespace NOU::NOU_DAT_ALG
 
 	NOU_FUNC NOU::sizeType hashValue(NOU::sizeType value, NOU::sizeType max);
 
+	/**
+	\brief The seed that is used by hash64() and Hasher if no other seed is passed.
+	*/
+	constexpr uint64 DEFAULT_HASH_SEED = 0;
+
+	/**
+	\param data The bytes that will be hashed.
+	\param size The amount of bytes.
+	\param seed The seed of the hash.
+
+	\return The 64 bit hash of the passed bytes.
+
+	\brief A fast, non-cryptographic 64 bit hash function.
+
+	\details
+	A fast, non-cryptographic 64 bit hash function. Short inputs are hashed eight bytes at a time using 128 bit
+	multiplications (similar to wyhash), inputs of 256 bytes or more are hashed in stripes of 64 bytes using 
+	eight independent accumulators (similar to XXH3). If the CPU supports AVX2, those stripes are processed 
+	using AVX2; the result is the same as without it.
+
+	Different seeds produce unrelated hashes. Using a seed that is not known to an attacker (e.g. a random one
+	that is chosen on startup) makes it hard to craft inputs that all have the same hash.
+
+	\note
+	The result depends on the byte order of the machine.
+	*/
+	NOU_FUNC uint64 hash64(const void *data, sizeType size, uint64 seed = DEFAULT_HASH_SEED);
+
+	/**
+	\param value The value that will be hashed.
+	\param seed  The seed of the hash.
+
+	\return The 64 bit hash of the passed value.
+
+	\brief Hashes a single 64 bit value. This is faster than hashing the same value using hash64().
+	*/
+	NOU_FUNC uint64 hashWord(uint64 value, uint64 seed = DEFAULT_HASH_SEED);
+
+	namespace internal
+	{
+		/**
+		\param enabled If false, hash64() processes long inputs without AVX2, even if the CPU supports it.
+
+		\return True, if hash64() uses AVX2 from now on.
+
+		\brief Chooses the code that hash64() uses for long inputs. This is used by the benchmarks to compare
+		       both versions; the hashes are the same either way.
+
+		\warning
+		This function must not be called while other threads are hashing.
+		*/
+		NOU_FUNC boolean setHashAvx2Enabled(boolean enabled);
+	}
+
+	/**
+	\tparam T The type of the objects that will be hashed.
+
+	\brief The hash function that is used by the hash maps of this library.
+
+	\details
+	The hash function that is used by the hash maps of this library (HashMap, FlatHashMap and 
+	ConcurrentHashMap). Integers, enumerations and pointers are hashed by their value using hashWord(), strings
+	are hashed by their characters and all other types are hashed by their bytes using hash64().
+
+	Hashing the bytes of an object is only correct if equal objects always have equal bytes. If that is not 
+	the case for a type (e.g. because it has padding or owns a pointer to its actual data), the hasher needs to
+	be specialized:
+
+	\code{.cpp}
+	template<>
+	struct nostra::utils::dat_alg::Hasher<MyType>
+	{
+		nostra::utils::uint64 operator () (const MyType &value, 
+			nostra::utils::uint64 seed = nostra::utils::dat_alg::DEFAULT_HASH_SEED) const
+		{
+			return nostra::utils::dat_alg::hashWord(value.getId(), seed);
+		}
+	};
+	\endcode
+
+	Objects that are equal according to <tt>operator ==</tt> (or the comparator that is used by the map) must
+	produce the same hash.
+	*/
+	template<typename T>
+	struct Hasher
+	{
+		/**
+		\param value The value that will be hashed.
+		\param seed  The seed of the hash.
+
+		\return The hash of \p value.
+		*/
+		uint64 operator () (const T &value, uint64 seed = DEFAULT_HASH_SEED) const;
+	};
+
+	///\cond
+	template<typename CHAR_TYPE>
+	struct Hasher<StringView<CHAR_TYPE>>
+	{
+		uint64 operator () (const StringView<CHAR_TYPE> &value, uint64 seed = DEFAULT_HASH_SEED) const
+		{
+			return hash64(value.rawStr(), value.size() * sizeof(CHAR_TYPE), seed);
+		}
+	};
+
+	template<typename CHAR_TYPE>
+	struct Hasher<String<CHAR_TYPE>> : Hasher<StringView<CHAR_TYPE>> {};
+	///\endcond
+
 	/**
 	\param inputObject the input that will be hashed.
 	\param max the maximum value the out hashvalue wii have (0 <= output < max)
@@ -43,17 +153,8 @@ namespace NOU::NOU_DAT_ALG
 	template <typename T>
 	constexpr sizeType hashObj(const T* inputObject, sizeType inputObjectCount = 1, sizeType max = static_cast<sizeType>(std::numeric_limits<sizeType>::max())) {
 		NOU_COND_PUSH_ERROR((max < 1), NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_OBJECT, "Value max cannot be below 1");
-		//T* p = &static_cast<T>(inputObject);
-		
-		const NOU::byte *bytes = reinterpret_cast<const byte*>(inputObject);
-		NOU::sizeType h = 0;
-
-		for (NOU::sizeType i = 0; i < inputObjectCount * sizeof(T); i++)
-		{
-			h += bytes[i];
-		}
 
-		return hashValue(h, max);
+		return hashValue(static_cast<sizeType>(hash64(inputObject, inputObjectCount * sizeof(T))), max);
 	};
 
 
@@ -63,27 +164,20 @@ namespace NOU::NOU_DAT_ALG
 	\param inputObjectCount The amount of objects that \p str points to. Unless \p str is an 
 	                       array, this is always 1.
 
-	\brief A Function that hashes a stringview for a HashTable
+	\brief A Function that hashes a stringview for a HashTable. The characters are hashed in place, the string
+	       is not copied.
 	*/
 
 	template<typename T>
 	constexpr sizeType hashObj(const NOU_DAT_ALG::StringView<T> *str, sizeType inputObjectCount = 1, sizeType max = static_cast<sizeType>(std::numeric_limits<sizeType>::max()))
 	{
-		NOU::NOU_DAT_ALG::Vector<T> b;
-		NOU::sizeType s = 0;
-		T tmp;
-		NOU_DAT_ALG::String<T> tmpStr;
+		uint64 h = DEFAULT_HASH_SEED;
+
+		//chain the hashes of the single strings by using the previous hash as seed
 		for(sizeType i = 0; i < inputObjectCount; i++)
-		{
-			s = str[i].size();
-			for(NOU::sizeType j = 0; j < s; j++)
-			{
-				tmpStr = str[i];
-				tmp = tmpStr.at(j);
-				b.pushBack(tmp);
-			}
-		}
-		return hashObj(reinterpret_cast<byte*>(b.data()), b.size(), max);
+			h = hash64(str[i].rawStr(), str[i].size() * sizeof(T), h);
+
+		return hashValue(static_cast<sizeType>(h), max);
 	}
 
 	/**
@@ -92,27 +186,19 @@ namespace NOU::NOU_DAT_ALG
 	\param inputObjectCount The amount of objects that \p str points to. Unless \p str is an 
 	                       array, this is always 1.
 
-	\brief A Function that hashes a string for a HashTable
+	\brief A Function that hashes a string for a HashTable. The characters are hashed in place, the string is
+	       not copied.
 	*/
 
 	template<typename T>
 	constexpr sizeType hashObj(const NOU_DAT_ALG::String<T> *str, sizeType inputObjectCount = 1, sizeType max = static_cast<sizeType>(std::numeric_limits<sizeType>::max()))
 	{
-		NOU::NOU_DAT_ALG::Vector<T> b;
-		NOU::sizeType s = 0;
-		T tmp;
-		NOU_DAT_ALG::String<T> tmpStr;
+		uint64 h = DEFAULT_HASH_SEED;
+
 		for(sizeType i = 0; i < inputObjectCount; i++)
-		{
-			s = str[i].size();
-			for(NOU::sizeType j = 0; j < s; j++)
-			{
-				tmpStr = str[i];
-				tmp = tmpStr.at(j);
-				b.pushBack(tmp);
-			}
-		}
-		return hashObj(reinterpret_cast<byte*>(b.data()), b.size(), max);
+			h = hash64(str[i].rawStr(), str[i].size() * sizeof(T), h);
+
+		return hashValue(static_cast<sizeType>(h), max);
 	}
 
 
@@ -123,5 +209,31 @@ namespace NOU::NOU_DAT_ALG
 	\return returns a rotated byte
 	*/
 	NOU_FUNC byte leftRotation(const byte input, int32 rotations);
+
+	///\cond
+	template<typename T>
+	uint64 Hasher<T>::operator () (const T &value, uint64 seed) const
+	{
+		if constexpr (std::is_integral<T>::value || std::is_enum<T>::value)
+		{
+			return hashWord(static_cast<uint64>(value), seed);
+		}
+		else if constexpr (std::is_pointer<T>::value)
+		{
+			return hashWord(reinterpret_cast<uint64>(value), seed);
+		}
+		else if constexpr (std::is_floating_point<T>::value)
+		{
+			//0.0 and -0.0 are equal, but have different bytes
+			T normalized = value == T(0) ? T(0) : value;
+
+			return hash64(&normalized, sizeof(T), seed);
+		}
+		else
+		{
+			return hash64(&value, sizeof(T), seed);
+		}
+	}
+	///\endcond
 }
 #endif
\ No newline at end of file
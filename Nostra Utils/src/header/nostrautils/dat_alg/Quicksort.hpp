@@ -72,12 +72,13 @@ namespace NOU::NOU_DAT_ALG
 	int64 partition(T *array, int64 leftrangelimit, int64 rightrangelimit, int64 pivot)
 	{
 		int64 pn = leftrangelimit;
-	    T & pv = array[pivot];
-
 
 		// pivot goes to end 
 		swap(array + pivot, array + rightrangelimit);
 
+		// only reference the pivot once it is at its final place during partitioning
+		T & pv = array[rightrangelimit];
+
 		// all values smaller as pivot goes to the right side 
 		for (int64 i = leftrangelimit; i < rightrangelimit; i++)
 		{
@@ -98,12 +99,13 @@ namespace NOU::NOU_DAT_ALG
 	int64 partition(T *array, int64 leftrangelimit, int64 rightrangelimit, int64 pivot , Comparator <T> comp)
 	{
 		int64 pn = leftrangelimit;
-		T & pv = array[pivot];
-
 
 		// pivot goes to end 
 		swap(array + pivot, array + rightrangelimit);
 
+		// only reference the pivot once it is at its final place during partitioning
+		T & pv = array[rightrangelimit];
+
 		// all values smaller as pivot goes to the right side 
 
 		for (int64 i = leftrangelimit; i < rightrangelimit; i++)
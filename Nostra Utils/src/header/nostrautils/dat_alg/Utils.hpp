@@ -86,6 +86,21 @@ namespace NOU::NOU_DAT_ALG
 	template<typename T>
 	constexpr T epsilonCompare(const T &t0, const T &t1, const T &epsilon);
 
+	/**
+	\tparam T The type of the object.
+
+	\return A reference to an object of the type \p T that has never been constructed.
+
+	\brief Returns an invalid object that containers can return if they have no valid object to return, e.g.
+	       because their memory could not be allocated.
+
+	\warning
+	The returned object is invalid and accessing it in any way might result in undefined behavior. Its memory
+	is zero-initialized and shared by all callers.
+	*/
+	template<typename T>
+	T& invalidObject();
+
 	template<typename T>
 	void swap(T *dataone, T *datatwo) 
 	{
@@ -120,6 +135,14 @@ namespace NOU::NOU_DAT_ALG
 		return !(abs <= epsilon) * (diff < T(0) ? T(-1): T(1));
 	}
 
+	template<typename T>
+	T& invalidObject()
+	{
+		alignas(T) static byte s_data[sizeof(T)] = {};
+
+		return *reinterpret_cast<T*>(s_data);
+	}
+
 
 }
 
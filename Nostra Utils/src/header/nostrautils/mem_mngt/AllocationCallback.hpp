@@ -3,6 +3,7 @@
 
 #include "nostrautils/core/StdIncludes.hpp"
 #include "nostrautils/mem_mngt/Utils.hpp"
+#include "nostrautils/mem_mngt/MonotonicArena.hpp"
 
 #include <iostream>
 
@@ -19,6 +20,15 @@
 
 namespace NOU::NOU_MEM_MNGT
 {
+	namespace internal
+	{
+		/**
+		\brief Pushes the error for an ArenaAllocationCallback without an arena. This is not done in the
+		       header, since the error handler itself includes this file.
+		*/
+		NOU_FUNC void pushMissingArenaError();
+	}
+
 	/**
 	\tparam T The type of objects to allocate.
 
@@ -98,6 +108,106 @@ namespace NOU::NOU_MEM_MNGT
 		int64 getCounter() const;
 	};
 
+	/**
+	\tparam T The type of objects to allocate.
+
+	\brief An allocation callback that allocates from a MonotonicArena.
+
+	\details
+	An allocation callback that allocates from a MonotonicArena. Deallocations do nothing, the memory is 
+	released when the arena is reset or rewound. 
+
+	A callback that was constructed using the default constructor uses the current arena of the thread that 
+	constructed it (see MonotonicArena::Scope). This allows containers that construct the callbacks of nested
+	containers themselves to allocate from the same arena. A callback for another type can be constructed from
+	an existing one, see rebindAllocationCallback().
+
+	\warning
+	The arena must outlive all containers that use it and it must not be reset while a container still uses
+	memory from it.
+	*/
+	template<typename T>
+	class ArenaAllocationCallback final
+	{
+	private:
+		/**
+		\brief The arena that the memory is allocated from.
+		*/
+		MonotonicArena *m_arena;
+
+	public:
+		/**
+		\brief Constructs a new callback that allocates from the current arena of the calling thread.
+
+		\note
+		If there is no current arena (see MonotonicArena::Scope), all allocations of the callback fail.
+		*/
+		ArenaAllocationCallback();
+
+		/**
+		\param arena The arena to allocate from.
+
+		\brief Constructs a new callback that allocates from \p arena.
+		*/
+		explicit ArenaAllocationCallback(MonotonicArena &arena);
+
+		/**
+		\tparam U The type of objects that \p other allocates.
+
+		\param other The callback that the arena will be taken from.
+
+		\brief Constructs a new callback that allocates from the same arena as \p other.
+		*/
+		template<typename U>
+		ArenaAllocationCallback(const ArenaAllocationCallback<U> &other);
+
+		/**
+		\param amount The amount of objects to allocate.
+
+		\return A pointer to the allocated block of memory, or <tt>nullptr</tt> if the callback has no arena.
+
+		\brief Allocates memory for \p amount objects from the arena.
+
+		\details
+		Allocates memory for \p amount objects from the arena. If the callback has no arena, an error with the
+		code nostra::utils::core::ErrorCodes::BAD_ALLOCATION is pushed to the error handler.
+		*/
+		T* allocate(sizeType amount = 1);
+
+		/**
+		\param data The memory to deallocate.
+
+		\brief Does nothing, the memory is released together with the rest of the arena.
+		*/
+		void deallocate(T *data);
+
+		/**
+		\return The arena that the memory is allocated from.
+
+		\brief Returns the arena that the memory is allocated from.
+		*/
+		MonotonicArena* getArena() const;
+	};
+
+	/**
+	\tparam TO   The type of the callback to construct.
+	\tparam FROM The type of \p from.
+
+	\param from An existing callback.
+
+	\return A callback of the type \p TO.
+
+	\brief Constructs a callback for a different type from an existing one.
+
+	\details
+	Constructs a callback for a different type from an existing one. Containers that allocate memory of
+	different types use this function to make all of their callbacks share the state of the one that was 
+	passed to them (e.g. the arena of an ArenaAllocationCallback). If \p TO can not be constructed from 
+	\p from, a default constructed callback is returned.
+	*/
+	template<typename TO, typename FROM>
+	TO rebindAllocationCallback(const FROM &from);
+
 	template<typename T>
 	T* GenericAllocationCallback<T>::allocate(sizeType amount)
 	{
@@ -134,6 +244,53 @@ namespace NOU::NOU_MEM_MNGT
 	{
 		return m_counter;
 	}
+
+	template<typename T>
+	ArenaAllocationCallback<T>::ArenaAllocationCallback() :
+		m_arena(MonotonicArena::getCurrent())
+	{}
+
+	template<typename T>
+	ArenaAllocationCallback<T>::ArenaAllocationCallback(MonotonicArena &arena) :
+		m_arena(&arena)
+	{}
+
+	template<typename T>
+	template<typename U>
+	ArenaAllocationCallback<T>::ArenaAllocationCallback(const ArenaAllocationCallback<U> &other) :
+		m_arena(other.getArena())
+	{}
+
+	template<typename T>
+	T* ArenaAllocationCallback<T>::allocate(sizeType amount)
+	{
+		if (m_arena == nullptr)
+		{
+			internal::pushMissingArenaError();
+			return nullptr;
+		}
+
+		return m_arena->allocateUninitialized<T>(amount);
+	}
+
+	template<typename T>
+	void ArenaAllocationCallback<T>::deallocate(T*)
+	{}
+
+	template<typename T>
+	MonotonicArena* ArenaAllocationCallback<T>::getArena() const
+	{
+		return m_arena;
+	}
+
+	template<typename TO, typename FROM>
+	TO rebindAllocationCallback(const FROM &from)
+	{
+		if constexpr (std::is_constructible<TO, const FROM&>::value)
+			return TO(from);
+		else
+			return TO();
+	}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,585 @@
+#ifndef NOU_MEM_MNGT_ALLOCATION_PROFILER_HPP
+#define NOU_MEM_MNGT_ALLOCATION_PROFILER_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/dat_alg/FlatHashMap.hpp"
+#include "nostrautils/dat_alg/String.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
+#include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/thread/SchedulerStatistics.hpp"
+
+#include <atomic>
+#include <typeinfo>
+
+/**
+\file mem_mngt/AllocationProfiler.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::mem_mngt::AllocationProfiler and
+       nostra::utils::mem_mngt::ProfilingAllocationCallback classes.
+
+\see nostra::utils::mem_mngt::AllocationProfiler
+\see nostra::utils::mem_mngt::ProfilingAllocationCallback
+*/
+
+/**
+\param label A string literal that names the site.
+
+\brief Attributes all allocations of an AllocationProfiler that are made by the calling thread until the end of
+       the current scope to the passed label, e.g. <tt>NOU_ALLOCATION_SITE("request parsing");</tt>.
+*/
+#define NOU_ALLOCATION_SITE(label) NOU::NOU_MEM_MNGT::AllocationProfiler::Scope \
+	NOU_ALLOCATION_SITE_NAME(__LINE__)(label)
+
+///\cond
+#define NOU_ALLOCATION_SITE_NAME_HELPER(line) nouAllocationSite##line
+#define NOU_ALLOCATION_SITE_NAME(line) NOU_ALLOCATION_SITE_NAME_HELPER(line)
+///\endcond
+
+namespace NOU::NOU_MEM_MNGT
+{
+	/**
+	\brief Information about a type that memory is allocated for.
+	*/
+	struct AllocationTypeInfo
+	{
+		/**
+		\brief The name of the type, as returned by <tt>std::type_info::name()</tt>.
+		*/
+		const char *name;
+
+		/**
+		\brief The size of a single object of the type.
+		*/
+		sizeType size;
+	};
+
+	/**
+	\tparam T The type.
+
+	\return The information about \p T. The same instance is returned for each call.
+
+	\brief Returns the information about a type.
+	*/
+	template<typename T>
+	const AllocationTypeInfo& allocationTypeInfo();
+
+	/**
+	\brief Records every allocation and deallocation that is made through it and aggregates them per call site
+	       and per type.
+
+	\details
+	Records every allocation and deallocation that is made through it and aggregates them per call site and
+	per type. Usually, a profiler is used through ProfilingAllocationCallback, which can be passed to any
+	container of this library (e.g. <tt>Vector<int32, ProfilingAllocationCallback></tt>).
+
+	For each allocation, the profiler records the size, the type, the time and the call site. The call site is
+	the stack of the caller (up to the stack depth that was passed to the constructor) and the label of the
+	innermost NOU_ALLOCATION_SITE() of the calling thread, if there is one. The size, the site, the type and the
+	time are stored in a small header in front of the allocation, so that a deallocation can be attributed to
+	the same site and the lifetime of the allocation is known.
+
+	The recording threads never take a lock. Each thread appends its events to its own buffer, which is only
+	read by getProfile() (or by the thread itself, if the buffer is full). Events of different threads are
+	merged by their time, hence the peak usage is exact up to the resolution of the clock.
+
+	A profile can be printed as a flat, human-readable report (Profile::flatReport()) or as a heap profile in
+	the legacy text format of gperftools, which can be read by pprof (Profile::heapProfile()).
+
+	\note
+	Capturing the stack is the most expensive part of an allocation. A stack depth of 0 only records the
+	labels, which is significantly cheaper.
+	*/
+	class AllocationProfiler final
+	{
+	public:
+		/**
+		\brief The maximum amount of stack frames that are recorded for each allocation.
+		*/
+		constexpr static sizeType MAX_STACK_DEPTH = 16;
+
+		/**
+		\brief The default amount of stack frames that are recorded for each allocation.
+		*/
+		constexpr static sizeType DEFAULT_STACK_DEPTH = 6;
+
+		/**
+		\brief The amount of events that fit into the buffer of a single thread.
+		*/
+		constexpr static sizeType BUFFER_SIZE = 512;
+
+		/**
+		\brief The statistics of a single call site.
+		*/
+		struct SiteStatistics
+		{
+			/**
+			\brief The return addresses of the stack of the site, the innermost frame first.
+			*/
+			void *stack[MAX_STACK_DEPTH];
+
+			/**
+			\brief The amount of valid entries in \p stack.
+			*/
+			sizeType stackDepth;
+
+			/**
+			\brief The label of the site (see NOU_ALLOCATION_SITE()), or \p nullptr if there is none.
+			*/
+			const char *label;
+
+			/**
+			\brief The amount of allocations.
+			*/
+			uint64 allocations;
+
+			/**
+			\brief The sum of the sizes of all allocations.
+			*/
+			uint64 allocatedBytes;
+
+			/**
+			\brief The amount of deallocations of memory that was allocated by the site.
+			*/
+			uint64 deallocations;
+
+			/**
+			\brief The amount of allocations that have not been deallocated yet.
+			*/
+			int64 liveAllocations;
+
+			/**
+			\brief The amount of bytes that have not been deallocated yet.
+			*/
+			int64 liveBytes;
+
+			/**
+			\brief The sum of the lifetimes of all deallocated allocations, in nanoseconds.
+			*/
+			uint64 totalLifetimeNanos;
+		};
+
+		/**
+		\brief The statistics of a single type.
+		*/
+		struct TypeStatistics
+		{
+			/**
+			\brief The type.
+			*/
+			const AllocationTypeInfo *type;
+
+			/**
+			\brief The amount of allocations.
+			*/
+			uint64 allocations;
+
+			/**
+			\brief The sum of the sizes of all allocations.
+			*/
+			uint64 allocatedBytes;
+
+			/**
+			\brief The amount of bytes that have not been deallocated yet.
+			*/
+			int64 liveBytes;
+
+			/**
+			\brief The largest value that \p liveBytes ever had.
+			*/
+			int64 peakLiveBytes;
+		};
+
+		/**
+		\brief A snapshot of the statistics of a profiler, as it is returned by AllocationProfiler::getProfile().
+		*/
+		struct Profile
+		{
+			/**
+			\brief The statistics of each call site.
+			*/
+			NOU_DAT_ALG::Vector<SiteStatistics> sites;
+
+			/**
+			\brief The statistics of each type.
+			*/
+			NOU_DAT_ALG::Vector<TypeStatistics> types;
+
+			/**
+			\brief The total amount of allocations.
+			*/
+			uint64 allocations;
+
+			/**
+			\brief The total amount of allocated bytes.
+			*/
+			uint64 allocatedBytes;
+
+			/**
+			\brief The total amount of deallocations.
+			*/
+			uint64 deallocations;
+
+			/**
+			\brief The amount of bytes that have not been deallocated yet.
+			*/
+			int64 liveBytes;
+
+			/**
+			\brief The largest value that \p liveBytes ever had.
+			*/
+			int64 peakLiveBytes;
+
+			/**
+			\brief The sizes of all allocations, in bytes.
+			*/
+			NOU_THREAD::LatencyHistogram sizes;
+
+			/**
+			\brief The lifetimes of all deallocated allocations, in nanoseconds.
+			*/
+			NOU_THREAD::LatencyHistogram lifetimes;
+
+			/**
+			\brief Constructs an empty profile.
+			*/
+			NOU_FUNC Profile();
+
+			/**
+			\return The report.
+
+			\brief Returns a human-readable report with the totals, the size and lifetime percentiles and the
+			       sites and types sorted by the amount of allocated bytes.
+			*/
+			NOU_FUNC NOU_DAT_ALG::String8 flatReport() const;
+
+			/**
+			\return The heap profile.
+
+			\brief Returns a heap profile in the legacy text format of gperftools, which can be read using
+			       <tt>pprof \<binary\> \<file\></tt>.
+
+			\details
+			Returns a heap profile in the legacy text format of gperftools, which can be read using
+			<tt>pprof \<binary\> \<file\></tt>. The profile contains both the live and the allocated objects
+			and bytes of each site. Sites without a stack (stack depth 0) are not part of the profile.
+			*/
+			NOU_FUNC NOU_DAT_ALG::String8 heapProfile() const;
+		};
+
+		/**
+		\brief Sets the label of the allocations of the calling thread for as long as an instance of this class
+		       exists.
+
+		\details
+		Sets the label of the allocations of the calling thread for as long as an instance of this class exists.
+		The previous label is restored when the scope is destroyed, so scopes can be nested. This is usually
+		used through NOU_ALLOCATION_SITE().
+		*/
+		class Scope final
+		{
+		private:
+			/**
+			\brief The label at the time the scope was created.
+			*/
+			const char *m_previous;
+
+		public:
+			/**
+			\param label The label. It is compared by its address, hence it should be a string literal.
+
+			\brief Makes \p label the label of the calling thread.
+			*/
+			NOU_FUNC explicit Scope(const char *label);
+
+			Scope(const Scope&) = delete;
+			Scope& operator = (const Scope&) = delete;
+
+			/**
+			\brief Restores the previous label.
+			*/
+			NOU_FUNC ~Scope();
+		};
+
+	private:
+		/**
+		\brief The header in front of each allocation.
+		*/
+		struct Header;
+
+		/**
+		\brief A single allocation or deallocation.
+		*/
+		struct Event;
+
+		/**
+		\brief The events of a single thread.
+		*/
+		struct ThreadBuffer;
+
+		/**
+		\brief A number that is unique for each profiler, even if a profiler is constructed at the address of
+		       a destroyed one.
+		*/
+		uint64 m_id;
+
+		/**
+		\brief The amount of stack frames that are recorded for each allocation.
+		*/
+		sizeType m_stackDepth;
+
+		/**
+		\brief The buffers of all threads that have used the profiler.
+		*/
+		std::atomic<ThreadBuffer*> m_buffers;
+
+		/**
+		\brief The mutex that is locked while the buffers are read and the statistics are updated.
+		*/
+		NOU_THREAD::Mutex m_mutex;
+
+		/**
+		\brief The statistics of the sites.
+		*/
+		NOU_DAT_ALG::Vector<SiteStatistics> m_sites;
+
+		/**
+		\brief The indices in \p m_sites, by the hash of the site.
+		*/
+		NOU_DAT_ALG::FlatHashMap<uint64, sizeType> m_siteIndices;
+
+		/**
+		\brief The statistics of the types.
+		*/
+		NOU_DAT_ALG::Vector<TypeStatistics> m_types;
+
+		/**
+		\brief The indices in \p m_types, by the address of the type information.
+		*/
+		NOU_DAT_ALG::FlatHashMap<uint64, sizeType> m_typeIndices;
+
+		/**
+		\brief The totals. The site and type statistics are not used.
+		*/
+		Profile m_totals;
+
+		/**
+		\return The buffer of the calling thread.
+
+		\brief Returns the buffer of the calling thread and creates it if it does not exist yet.
+		*/
+		ThreadBuffer& threadBuffer();
+
+		/**
+		\param buffer The buffer of the calling thread.
+
+		\return The slot of the next event in the buffer.
+
+		\brief Returns the slot that the next event of the calling thread is written to. If the buffer is full,
+		       it is drained first. The event is not visible until publish() is called.
+		*/
+		Event& nextEvent(ThreadBuffer &buffer);
+
+		/**
+		\param buffer The buffer of the calling thread.
+
+		\brief Makes the event that was written to the slot returned by nextEvent() visible to drain().
+		*/
+		void publish(ThreadBuffer &buffer);
+
+		/**
+		\brief Reads the events from the buffers of all threads and updates the statistics. \p m_mutex must be
+		       locked.
+		*/
+		void drain();
+
+		/**
+		\param event The event.
+
+		\brief Updates the statistics with a single event. \p m_mutex must be locked.
+		*/
+		void apply(const Event &event);
+
+		/**
+		\param event The event that the site is taken from.
+
+		\return The statistics of the site of the event.
+		*/
+		SiteStatistics& siteOf(const Event &event);
+
+		/**
+		\param type The type.
+
+		\return The statistics of the type.
+		*/
+		TypeStatistics& typeOf(const AllocationTypeInfo *type);
+
+	public:
+		/**
+		\param stackDepth The amount of stack frames that are recorded for each allocation. This is limited to
+		                  MAX_STACK_DEPTH. If it is 0, the sites are only identified by their labels.
+
+		\brief Constructs a new profiler.
+		*/
+		NOU_FUNC explicit AllocationProfiler(sizeType stackDepth = DEFAULT_STACK_DEPTH);
+
+		AllocationProfiler(const AllocationProfiler&) = delete;
+		AllocationProfiler& operator = (const AllocationProfiler&) = delete;
+
+		/**
+		\brief Destroys the profiler. All memory that was allocated through it must have been deallocated.
+		*/
+		NOU_FUNC ~AllocationProfiler();
+
+		/**
+		\param bytes     The amount of bytes to allocate.
+		\param alignment The alignment of the allocation.
+		\param type      The type of the objects that the memory is allocated for.
+
+		\return The allocated memory, or \p nullptr if the allocation failed.
+
+		\brief Allocates uninitialized memory and records the allocation.
+		*/
+		NOU_FUNC void* allocate(sizeType bytes, sizeType alignment, const AllocationTypeInfo &type);
+
+		/**
+		\param data The memory to deallocate. It must have been allocated using allocate() of the same
+		            profiler.
+
+		\brief Deallocates memory and records the deallocation.
+		*/
+		NOU_FUNC void deallocate(void *data);
+
+		/**
+		\return The profile.
+
+		\brief Returns a snapshot of the statistics of all allocations and deallocations so far.
+		*/
+		NOU_FUNC Profile getProfile();
+
+		/**
+		\return The amount of stack frames that are recorded for each allocation.
+		*/
+		NOU_FUNC sizeType getStackDepth() const;
+
+		/**
+		\return The default profiler.
+
+		\brief Returns the profiler that is used by default constructed instances of ProfilingAllocationCallback.
+		       It is never destroyed.
+		*/
+		NOU_FUNC static AllocationProfiler& getDefault();
+	};
+
+	/**
+	\tparam T The type of objects to allocate.
+
+	\brief An allocation callback that allocates through an AllocationProfiler.
+
+	\details
+	An allocation callback that allocates through an AllocationProfiler. A callback that was constructed using
+	the default constructor uses AllocationProfiler::getDefault(). Like ArenaAllocationCallback, a callback for
+	another type can be constructed from an existing one (see rebindAllocationCallback()), so that the nested
+	containers of a container use the same profiler.
+	*/
+	template<typename T>
+	class ProfilingAllocationCallback final
+	{
+	private:
+		/**
+		\brief The profiler that the memory is allocated through.
+		*/
+		AllocationProfiler *m_profiler;
+
+	public:
+		/**
+		\brief Constructs a new callback that allocates through AllocationProfiler::getDefault().
+		*/
+		ProfilingAllocationCallback();
+
+		/**
+		\param profiler The profiler.
+
+		\brief Constructs a new callback that allocates through \p profiler.
+		*/
+		explicit ProfilingAllocationCallback(AllocationProfiler &profiler);
+
+		/**
+		\tparam U The type of objects that \p other allocates.
+
+		\param other The callback that the profiler will be taken from.
+
+		\brief Constructs a new callback that allocates through the same profiler as \p other.
+		*/
+		template<typename U>
+		ProfilingAllocationCallback(const ProfilingAllocationCallback<U> &other);
+
+		/**
+		\param amount The amount of objects to allocate.
+
+		\return A pointer to the allocated block of memory.
+
+		\brief Allocates memory for \p amount objects and records the allocation.
+		*/
+		T* allocate(sizeType amount = 1);
+
+		/**
+		\param data The memory to deallocate.
+
+		\brief Deallocates memory and records the deallocation.
+		*/
+		void deallocate(T *data);
+
+		/**
+		\return The profiler that the memory is allocated through.
+		*/
+		AllocationProfiler* getProfiler() const;
+	};
+
+	template<typename T>
+	const AllocationTypeInfo& allocationTypeInfo()
+	{
+		static const AllocationTypeInfo info = { typeid(T).name(), sizeof(T) };
+		return info;
+	}
+
+	template<typename T>
+	ProfilingAllocationCallback<T>::ProfilingAllocationCallback() :
+		m_profiler(&AllocationProfiler::getDefault())
+	{}
+
+	template<typename T>
+	ProfilingAllocationCallback<T>::ProfilingAllocationCallback(AllocationProfiler &profiler) :
+		m_profiler(&profiler)
+	{}
+
+	template<typename T>
+	template<typename U>
+	ProfilingAllocationCallback<T>::ProfilingAllocationCallback(const ProfilingAllocationCallback<U> &other) :
+		m_profiler(other.getProfiler())
+	{}
+
+	template<typename T>
+	T* ProfilingAllocationCallback<T>::allocate(sizeType amount)
+	{
+		return reinterpret_cast<T*>(m_profiler->allocate(sizeof(T) * amount, alignof(T),
+			allocationTypeInfo<T>()));
+	}
+
+	template<typename T>
+	void ProfilingAllocationCallback<T>::deallocate(T *data)
+	{
+		m_profiler->deallocate(data);
+	}
+
+	template<typename T>
+	AllocationProfiler* ProfilingAllocationCallback<T>::getProfiler() const
+	{
+		return m_profiler;
+	}
+}
+
+#endif
@@ -0,0 +1,681 @@
+#ifndef NOU_MEM_MNGT_CONCURRENT_POOL_ALLOCATOR_HPP
+#define NOU_MEM_MNGT_CONCURRENT_POOL_ALLOCATOR_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/core/ErrorHandler.hpp"
+#include "nostrautils/mem_mngt/Utils.hpp"
+#include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/dat_alg/ConcurrentHashMap.hpp"
+#include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/thread/Lock.hpp"
+
+#include <atomic>
+#include <functional>
+#include <new>
+#include <thread>
+
+/**
+\file mem_mngt/ConcurrentPoolAllocator.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::mem_mngt::ConcurrentPoolAllocator class.
+*/
+
+namespace NOU::NOU_MEM_MNGT
+{
+	/**
+	\tparam T     The type of the stored elements.
+	\tparam ALLOC The type of the allocation callback.
+
+	\brief A pool allocator that can be used by multiple threads at the same time.
+
+	\details
+	A pool allocator that can be used by multiple threads at the same time. Unlike PoolAllocator, no external
+	mutex is required.
+
+	Each thread has its own magazine, a small free list that allocate() and deallocate() operate on. Those
+	operations do not use any atomic instructions as long as the magazine is neither empty nor overfull.
+	Only then, an entire batch of blocks is taken from or returned to a global, lock-free stack (the depot).
+	Memory is only ever requested from \p ALLOC (in slabs of multiple batches) if the depot is empty.
+
+	A block may be deallocated by a different thread than the one that allocated it.
+
+	\note
+	The blocks in the magazine of a thread stay there when the thread exits. They are not lost, but they can
+	only be reused by other threads after the thread called flushThreadCache(). All memory is released when
+	the allocator is destroyed.
+	*/
+	template<typename T, template<typename> class ALLOC = GenericAllocationCallback>
+	class ConcurrentPoolAllocator final
+	{
+	public:
+		/**
+		\brief The default amount of blocks that are moved between a magazine and the depot at once.
+		*/
+		constexpr static sizeType DEFAULT_BATCH_SIZE = 64;
+
+		/**
+		\brief The default amount of batches that are allocated at once.
+		*/
+		constexpr static sizeType DEFAULT_BATCHES_PER_SLAB = 16;
+
+		/**
+		\brief The maximum amount of slabs. This limits the amount of blocks to
+		       <tt>MAX_SLABS * batchSize * batchesPerSlab</tt>.
+		*/
+		constexpr static sizeType MAX_SLABS = 4096;
+
+	private:
+		/**
+		\brief A single block. While it is not in use, it is an element of a free list.
+		*/
+		union Block
+		{
+			T      m_value;
+			Block *m_next;
+
+			Block() {}
+			~Block() {}
+		};
+
+		/**
+		\brief Describes a batch of blocks in the depot.
+		*/
+		struct Descriptor
+		{
+			/**
+			\brief The first block of the batch. The blocks are linked using Block::m_next.
+			*/
+			Block                *m_blocks;
+
+			/**
+			\brief The index (plus one) of the next descriptor on the same stack, 0 if there is none.
+			*/
+			std::atomic<uint32>   m_next;
+		};
+
+		/**
+		\brief The free list of a single thread.
+		*/
+		struct Magazine
+		{
+			Block   *m_head = nullptr;
+			sizeType m_count = 0;
+		};
+
+		/**
+		\brief The entry of the thread local cache that stores the magazine of the last allocator that was
+		       used by a thread.
+		*/
+		struct ThreadCache
+		{
+			const ConcurrentPoolAllocator *m_owner = nullptr;
+			uint64                         m_ownerId = 0;
+			Magazine                      *m_magazine = nullptr;
+		};
+
+		/**
+		\brief The cache of the calling thread.
+		*/
+		static thread_local ThreadCache s_threadCache;
+
+		/**
+		\brief The source of the IDs of the allocators. The IDs are used to tell allocators apart that were
+		       constructed at the same address.
+		*/
+		static std::atomic<uint64> s_nextId;
+
+		/**
+		\brief The ID of this allocator.
+		*/
+		uint64 m_id;
+
+		sizeType m_batchSize;
+		sizeType m_batchesPerSlab;
+
+		ALLOC<Block>      m_blockAllocator;
+		ALLOC<Descriptor> m_descriptorAllocator;
+		ALLOC<Magazine>   m_magazineAllocator;
+
+		/**
+		\brief The slabs.
+		*/
+		Block **m_slabs;
+
+		/**
+		\brief The descriptors of each slab. Each slab comes with one descriptor per batch, which is enough to
+		       store all of its blocks in the depot.
+		*/
+		std::atomic<Descriptor*> *m_descriptors;
+
+		/**
+		\brief The amount of slabs. Only modified while \p m_growthMutex is locked.
+		*/
+		sizeType m_slabCount;
+
+		/**
+		\brief The stack of the descriptors of full batches. The lower 32 bits are the index (plus one) of the
+		       top descriptor, the upper 32 bits are a counter that prevents the ABA problem.
+		*/
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64> m_fullBatches;
+
+		/**
+		\brief The stack of descriptors that are currently not in use. Same layout as \p m_fullBatches.
+		*/
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64> m_freeDescriptors;
+
+		/**
+		\brief The mutex that is locked while a new slab is allocated.
+		*/
+		NOU_THREAD::Mutex m_growthMutex;
+
+		/**
+		\brief The magazines of all threads that have used this allocator.
+		*/
+		NOU_DAT_ALG::ConcurrentHashMap<std::thread::id, Magazine*> m_magazines;
+
+		/**
+		\param index The index of a descriptor.
+
+		\return The descriptor with the passed index.
+		*/
+		Descriptor& descriptor(uint32 index) const;
+
+		/**
+		\param stack The stack to pop from (\p m_fullBatches or \p m_freeDescriptors).
+		\param index The index of the popped descriptor.
+
+		\return True, if a descriptor was popped, false if the stack was empty.
+		*/
+		boolean pop(std::atomic<uint64> &stack, uint32 &index);
+
+		/**
+		\param stack The stack to push to (\p m_fullBatches or \p m_freeDescriptors).
+		\param index The index of the descriptor to push.
+		*/
+		void push(std::atomic<uint64> &stack, uint32 index);
+
+		/**
+		\return The magazine of the calling thread, or <tt>nullptr</tt> if it could not be created.
+		*/
+		Magazine* localMagazine();
+
+		/**
+		\return The magazine of the calling thread, or <tt>nullptr</tt> if it could not be created.
+
+		\brief The slow path of localMagazine(), which looks up the magazine in \p m_magazines.
+		*/
+		Magazine* lookupMagazine();
+
+		/**
+		\param magazine The magazine to refill.
+
+		\return True, if at least one block was added to the magazine.
+
+		\brief Moves one batch from the depot to a magazine. If the depot is empty, a new slab is allocated.
+		*/
+		boolean refill(Magazine &magazine);
+
+		/**
+		\param magazine The magazine to flush.
+
+		\brief Moves one batch from a magazine to the depot.
+		*/
+		void flush(Magazine &magazine);
+
+		/**
+		\param magazine The magazine that the first batch of the slab will be put into.
+
+		\return True, if the slab was allocated.
+
+		\brief Allocates a new slab.
+		*/
+		boolean grow(Magazine &magazine);
+
+	public:
+		/**
+		\param batchSize      The amount of blocks that are moved between a magazine and the depot at once.
+		                      Each thread caches up to twice that amount.
+		\param batchesPerSlab The amount of batches that are allocated at once.
+
+		\brief Constructs a new allocator. No memory for the blocks is allocated yet.
+		*/
+		explicit ConcurrentPoolAllocator(sizeType batchSize = DEFAULT_BATCH_SIZE,
+			sizeType batchesPerSlab = DEFAULT_BATCHES_PER_SLAB);
+
+		ConcurrentPoolAllocator(const ConcurrentPoolAllocator &other) = delete;
+
+		ConcurrentPoolAllocator(ConcurrentPoolAllocator &&other) = delete;
+
+		/**
+		\brief Releases all memory. Objects that have not been deallocated are not destructed.
+		*/
+		~ConcurrentPoolAllocator();
+
+		ConcurrentPoolAllocator& operator = (const ConcurrentPoolAllocator &other) = delete;
+
+		ConcurrentPoolAllocator& operator = (ConcurrentPoolAllocator &&other) = delete;
+
+		/**
+		\tparam ARGS The types of the arguments that the object will be constructed from.
+
+		\param args The arguments that the object will be constructed from.
+
+		\return A pointer to the new object, or <tt>nullptr</tt> if the allocation failed.
+
+		\brief Allocates a block and constructs an object in it.
+		*/
+		template<typename... ARGS>
+		T* allocate(ARGS&&... args);
+
+		/**
+		\param data The object to deallocate. This may be <tt>nullptr</tt>.
+
+		\brief Destructs an object and returns its block to the pool.
+		*/
+		void deallocate(T *data);
+
+		/**
+		\brief Moves all blocks in the magazine of the calling thread to the depot (except for less than one
+		       batch).
+
+		\details
+		Moves all blocks in the magazine of the calling thread to the depot (except for less than one batch).
+		A thread that stops using the allocator can call this method to make its cached blocks available to
+		other threads.
+		*/
+		void flushThreadCache();
+
+		/**
+		\return The amount of blocks that have been allocated from \p ALLOC.
+
+		\brief Returns the amount of blocks that have been allocated from \p ALLOC.
+		*/
+		sizeType capacity() const;
+
+		/**
+		\param data The address to test.
+
+		\return True, if \p data lies within a block of this allocator, false if not.
+
+		\brief Checks whether an address lies within a block of this allocator. The address is not 
+		       dereferenced, so it may also be the address of an object that was not allocated by this 
+		       allocator.
+
+		\note
+		This checks each slab, it is meant to be used rarely (e.g. while shutting down).
+		*/
+		boolean isPartOf(const void *data) const;
+	};
+
+	///\cond
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentPoolAllocator<T, ALLOC>::DEFAULT_BATCH_SIZE;
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentPoolAllocator<T, ALLOC>::DEFAULT_BATCHES_PER_SLAB;
+
+	template<typename T, template<typename> class ALLOC>
+	constexpr sizeType ConcurrentPoolAllocator<T, ALLOC>::MAX_SLABS;
+
+	template<typename T, template<typename> class ALLOC>
+	thread_local typename ConcurrentPoolAllocator<T, ALLOC>::ThreadCache
+		ConcurrentPoolAllocator<T, ALLOC>::s_threadCache;
+
+	template<typename T, template<typename> class ALLOC>
+	std::atomic<uint64> ConcurrentPoolAllocator<T, ALLOC>::s_nextId(1);
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentPoolAllocator<T, ALLOC>::Descriptor&
+		ConcurrentPoolAllocator<T, ALLOC>::descriptor(uint32 index) const
+	{
+		return m_descriptors[index / m_batchesPerSlab].load(std::memory_order_acquire)[index % m_batchesPerSlab];
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentPoolAllocator<T, ALLOC>::pop(std::atomic<uint64> &stack, uint32 &index)
+	{
+		uint64 head = stack.load(std::memory_order_acquire);
+
+		while (true)
+		{
+			uint32 top = static_cast<uint32>(head);
+
+			if (top == 0)
+				return false;
+
+			//the descriptor is never deallocated, reading it is safe even if it has already been popped
+			uint32 next = descriptor(top - 1).m_next.load(std::memory_order_relaxed);
+			uint64 newHead = (((head >> 32) + 1) << 32) | next;
+
+			if (stack.compare_exchange_weak(head, newHead, std::memory_order_acq_rel,
+				std::memory_order_acquire))
+			{
+				index = top - 1;
+				return true;
+			}
+		}
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void ConcurrentPoolAllocator<T, ALLOC>::push(std::atomic<uint64> &stack, uint32 index)
+	{
+		Descriptor &pushed = descriptor(index);
+		uint64 head = stack.load(std::memory_order_relaxed);
+		uint64 newHead;
+
+		do
+		{
+			pushed.m_next.store(static_cast<uint32>(head), std::memory_order_relaxed);
+			newHead = (((head >> 32) + 1) << 32) | (index + 1);
+		} while (!stack.compare_exchange_weak(head, newHead, std::memory_order_release,
+			std::memory_order_relaxed));
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentPoolAllocator<T, ALLOC>::Magazine* ConcurrentPoolAllocator<T, ALLOC>::localMagazine()
+	{
+		ThreadCache &cache = s_threadCache;
+
+		if (cache.m_owner == this && cache.m_ownerId == m_id)
+			return cache.m_magazine;
+
+		return lookupMagazine();
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	typename ConcurrentPoolAllocator<T, ALLOC>::Magazine* ConcurrentPoolAllocator<T, ALLOC>::lookupMagazine()
+	{
+		Magazine *magazine = m_magazines.computeIfAbsent(std::this_thread::get_id(),
+			[this](const std::thread::id&)
+		{
+			Magazine *ret = m_magazineAllocator.allocate(1);
+
+			if (ret != nullptr)
+				new (ret) Magazine();
+
+			return ret;
+		});
+
+		if (magazine == nullptr)
+		{
+			//make sure that the next call tries again
+			m_magazines.remove(std::this_thread::get_id());
+			return nullptr;
+		}
+
+		ThreadCache &cache = s_threadCache;
+		cache.m_owner = this;
+		cache.m_ownerId = m_id;
+		cache.m_magazine = magazine;
+
+		return magazine;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentPoolAllocator<T, ALLOC>::refill(Magazine &magazine)
+	{
+		uint32 index;
+
+		if (!pop(m_fullBatches, index))
+			return grow(magazine);
+
+		Descriptor &batch = descriptor(index);
+
+		magazine.m_head = batch.m_blocks;
+		magazine.m_count = m_batchSize;
+
+		push(m_freeDescriptors, index);
+
+		return true;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void ConcurrentPoolAllocator<T, ALLOC>::flush(Magazine &magazine)
+	{
+		uint32 index;
+
+		//there are as many descriptors as batches and the magazine holds at least one batch that is not in
+		//the depot, hence there is always a free descriptor
+		if (!pop(m_freeDescriptors, index))
+			return;
+
+		Block *first = magazine.m_head;
+		Block *last = first;
+
+		for (sizeType i = 1; i < m_batchSize; i++)
+			last = last->m_next;
+
+		magazine.m_head = last->m_next;
+		magazine.m_count -= m_batchSize;
+		last->m_next = nullptr;
+
+		descriptor(index).m_blocks = first;
+
+		push(m_fullBatches, index);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentPoolAllocator<T, ALLOC>::grow(Magazine &magazine)
+	{
+		NOU_THREAD::Lock lock(m_growthMutex);
+
+		//another thread may have grown the pool in the meantime
+		uint32 index;
+
+		if (pop(m_fullBatches, index))
+		{
+			magazine.m_head = descriptor(index).m_blocks;
+			magazine.m_count = m_batchSize;
+
+			push(m_freeDescriptors, index);
+
+			return true;
+		}
+
+		if (m_slabCount == MAX_SLABS)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The maximum amount of slabs has been reached.");
+
+			return false;
+		}
+
+		Block *slab = m_blockAllocator.allocate(m_batchSize * m_batchesPerSlab);
+		Descriptor *descriptors = m_descriptorAllocator.allocate(m_batchesPerSlab);
+
+		if (slab == nullptr || descriptors == nullptr)
+		{
+			if (slab != nullptr)
+				m_blockAllocator.deallocate(slab);
+
+			if (descriptors != nullptr)
+				m_descriptorAllocator.deallocate(descriptors);
+
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The allocation failed.");
+
+			return false;
+		}
+
+		for (sizeType i = 0; i < m_batchesPerSlab; i++)
+		{
+			Block *batch = slab + i * m_batchSize;
+
+			for (sizeType j = 0; j < m_batchSize - 1; j++)
+				batch[j].m_next = batch + j + 1;
+
+			batch[m_batchSize - 1].m_next = nullptr;
+
+			new (descriptors + i) Descriptor();
+			descriptors[i].m_blocks = batch;
+			descriptors[i].m_next.store(0, std::memory_order_relaxed);
+		}
+
+		sizeType slabIndex = m_slabCount;
+
+		m_slabs[slabIndex] = slab;
+		m_descriptors[slabIndex].store(descriptors, std::memory_order_release);
+		m_slabCount++;
+
+		uint32 firstIndex = static_cast<uint32>(slabIndex * m_batchesPerSlab);
+
+		//the first batch goes directly to the magazine, the others to the depot
+		magazine.m_head = descriptors[0].m_blocks;
+		magazine.m_count = m_batchSize;
+
+		push(m_freeDescriptors, firstIndex);
+
+		for (sizeType i = 1; i < m_batchesPerSlab; i++)
+			push(m_fullBatches, firstIndex + static_cast<uint32>(i));
+
+		return true;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	ConcurrentPoolAllocator<T, ALLOC>::ConcurrentPoolAllocator(sizeType batchSize, sizeType batchesPerSlab) :
+		m_id(s_nextId.fetch_add(1, std::memory_order_relaxed)),
+		m_batchSize(batchSize > 0 ? batchSize : 1),
+		m_batchesPerSlab(batchesPerSlab > 0 ? batchesPerSlab : 1),
+		m_slabs(nullptr),
+		m_descriptors(nullptr),
+		m_slabCount(0),
+		m_fullBatches(0),
+		m_freeDescriptors(0)
+	{
+		ALLOC<Block*> slabAllocator;
+		ALLOC<std::atomic<Descriptor*>> descriptorTableAllocator;
+
+		m_slabs = slabAllocator.allocate(MAX_SLABS);
+		m_descriptors = descriptorTableAllocator.allocate(MAX_SLABS);
+
+		if (m_slabs == nullptr || m_descriptors == nullptr)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The allocation failed.");
+			return;
+		}
+
+		for (sizeType i = 0; i < MAX_SLABS; i++)
+			new (m_descriptors + i) std::atomic<Descriptor*>(nullptr);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	ConcurrentPoolAllocator<T, ALLOC>::~ConcurrentPoolAllocator()
+	{
+		for (Magazine *magazine : m_magazines.entrySet())
+			m_magazineAllocator.deallocate(magazine);
+
+		for (sizeType i = 0; i < m_slabCount; i++)
+		{
+			m_blockAllocator.deallocate(m_slabs[i]);
+			m_descriptorAllocator.deallocate(m_descriptors[i].load(std::memory_order_relaxed));
+		}
+
+		if (m_slabs != nullptr)
+			ALLOC<Block*>().deallocate(m_slabs);
+
+		if (m_descriptors != nullptr)
+			ALLOC<std::atomic<Descriptor*>>().deallocate(m_descriptors);
+
+		//the cache of the destructing thread may still point to this allocator
+		if (s_threadCache.m_owner == this)
+			s_threadCache = ThreadCache();
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	template<typename... ARGS>
+	T* ConcurrentPoolAllocator<T, ALLOC>::allocate(ARGS&&... args)
+	{
+		Magazine *magazine = localMagazine();
+
+		if (magazine == nullptr)
+			return nullptr;
+
+		if (magazine->m_head == nullptr && !refill(*magazine))
+			return nullptr;
+
+		Block *block = magazine->m_head;
+		magazine->m_head = block->m_next;
+		magazine->m_count--;
+
+		return new (NOU_MEM_MNGT::addressof(block->m_value)) T(NOU_CORE::forward<ARGS>(args)...);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void ConcurrentPoolAllocator<T, ALLOC>::deallocate(T *data)
+	{
+		if (data == nullptr)
+			return;
+
+		data->~T();
+
+		Magazine *magazine = localMagazine();
+
+		if (magazine == nullptr)
+			return;
+
+		Block *block = reinterpret_cast<Block*>(data);
+		block->m_next = magazine->m_head;
+		magazine->m_head = block;
+		magazine->m_count++;
+
+		if (magazine->m_count > 2 * m_batchSize)
+			flush(*magazine);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void ConcurrentPoolAllocator<T, ALLOC>::flushThreadCache()
+	{
+		Magazine *magazine = localMagazine();
+
+		if (magazine == nullptr)
+			return;
+
+		while (magazine->m_count >= m_batchSize)
+		{
+			sizeType count = magazine->m_count;
+
+			flush(*magazine);
+
+			if (magazine->m_count == count) //no descriptor was available
+				break;
+		}
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	sizeType ConcurrentPoolAllocator<T, ALLOC>::capacity() const
+	{
+		NOU_THREAD::Lock lock(const_cast<NOU_THREAD::Mutex&>(m_growthMutex));
+
+		return m_slabCount * m_batchesPerSlab * m_batchSize;
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	boolean ConcurrentPoolAllocator<T, ALLOC>::isPartOf(const void *data) const
+	{
+		NOU_THREAD::Lock lock(const_cast<NOU_THREAD::Mutex&>(m_growthMutex));
+
+		std::less<const void*> less;
+
+		for (sizeType i = 0; i < m_slabCount; i++)
+		{
+			const Block *begin = m_slabs[i];
+			const Block *end = begin + m_batchSize * m_batchesPerSlab;
+
+			if (!less(data, begin) && less(data, end))
+				return true;
+		}
+
+		return false;
+	}
+
+	///\endcond
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "nostrautils/dat_alg/Vector.hpp"
 #include "nostrautils/dat_alg/BinarySearch.hpp"
 #include "nostrautils/mem_mngt/Utils.hpp"
+#include "nostrautils/mem_mngt/PageAllocator.hpp"
 #include "nostrautils/core/ErrorHandler.hpp"
 
 /**
@@ -143,8 +144,283 @@ namespace NOU::NOU_MEM_MNGT
 			template <typename T, typename... ARGS>
 			T* allocateObject(sizeType amountOfObjects, ARGS&&... args);
 		};
+
+		/**
+		\brief The engine that is used by a GeneralPurposeAllocator that was constructed with 
+		       GeneralPurposeAllocatorMode::SEGREGATED_FIT.
+
+		\details
+		The engine implements a two level segregated fit allocator (TLSF). The free blocks are sorted into 
+		size classes; the first level splits the sizes into powers of two and the second level splits each
+		power of two into four equally sized steps. Each size class has its own doubly linked free list and 
+		two bitmaps store which of the lists are not empty, which allows finding a fitting list using two bit 
+		scans. 
+
+		Each block starts with a header that stores the size of the block and a pointer to the physically 
+		previous block (boundary tags). This allows merging a freed block with its neighbors in constant time.
+		The memory region is terminated by a sentinel block with a size of 0 that is never free.
+		*/
+		class GeneralPurposeAllocatorSegregatedFit
+		{
+		public:
+
+			/**
+			\brief The alignment of the payload of each block. All block sizes are multiples of this value.
+			*/
+			static constexpr sizeType ALIGNMENT = 16;
+
+			/**
+			\brief The size of a block header. The payload of a block starts directly after the header.
+			*/
+			static constexpr sizeType HEADER_SIZE = ALIGNMENT;
+
+			/**
+			\brief The logarithm of the amount of second level size classes per first level size class.
+			*/
+			static constexpr sizeType SECOND_LEVEL_LOG2 = 2;
+
+			/**
+			\brief The amount of second level size classes per first level size class.
+			*/
+			static constexpr sizeType SECOND_LEVEL_COUNT = sizeType(1) << SECOND_LEVEL_LOG2;
+
+			/**
+			\brief The logarithm of the size of the smallest first level size class. All blocks that are 
+			       smaller than this size are stored in the first class of the first level.
+			*/
+			static constexpr sizeType FIRST_LEVEL_SHIFT = SECOND_LEVEL_LOG2 + 4;
+
+			/**
+			\brief The size of the blocks that are stored in the first class of the first level.
+			*/
+			static constexpr sizeType SMALL_BLOCK_SIZE = sizeType(1) << FIRST_LEVEL_SHIFT;
+
+			/**
+			\brief The amount of first level size classes.
+			*/
+			static constexpr sizeType FIRST_LEVEL_COUNT = sizeof(sizeType) * 8 - FIRST_LEVEL_SHIFT + 1;
+
+			/**
+			\brief The minimum size of the payload of a block. The payload of a free block stores the links 
+			       of the free list.
+			*/
+			static constexpr sizeType MIN_BLOCK_SIZE = ALIGNMENT;
+
+		private:
+
+			/**
+			\brief The header of a block.
+			*/
+			struct Block
+			{
+				/**
+				\brief The block that is physically located before this one, or \p nullptr if this is the 
+				       first block.
+				*/
+				Block *m_prevPhysical;
+
+				/**
+				\brief The size of the payload. The lowest bit is set if the block is free.
+				*/
+				sizeType m_size;
+			};
+
+			/**
+			\brief The links of the free list that a free block is stored in. They are stored in the payload.
+			*/
+			struct FreeLinks
+			{
+				/**
+				\brief The next block in the same free list.
+				*/
+				Block *m_next;
+
+				/**
+				\brief The previous block in the same free list.
+				*/
+				Block *m_prev;
+			};
+
+			static_assert(sizeof(Block) <= HEADER_SIZE);
+			static_assert(sizeof(FreeLinks) <= MIN_BLOCK_SIZE);
+
+			/**
+			\brief The bit in Block::m_size that is set if a block is free.
+			*/
+			static constexpr sizeType FREE_BIT = 1;
+
+			/**
+			\brief The first block in the memory region.
+			*/
+			byte *m_begin;
+
+			/**
+			\brief The sentinel block at the end of the memory region.
+			*/
+			byte *m_end;
+
+			/**
+			\brief Bit \p i is set if any second level list of the first level class \p i is not empty.
+			*/
+			uint64 m_firstLevelBitmap;
+
+			/**
+			\brief Bit \p j of entry \p i is set if the free list for the classes \p i and \p j is not empty.
+			*/
+			uint32 m_secondLevelBitmaps[FIRST_LEVEL_COUNT];
+
+			/**
+			\brief The heads of the free lists.
+			*/
+			Block *m_freeLists[FIRST_LEVEL_COUNT][SECOND_LEVEL_COUNT];
+
+			/**
+			\param block The block.
+
+			\return The size of the payload of \p block.
+
+			\brief Returns the size of the payload of a block.
+			*/
+			static sizeType blockSize(const Block *block);
+
+			/**
+			\param block The block.
+
+			\return True, if the block is free, false if not.
+
+			\brief Returns whether a block is free.
+			*/
+			static boolean isFree(const Block *block);
+
+			/**
+			\param block The block.
+
+			\return The free list links of \p block.
+
+			\brief Returns the free list links that are stored in the payload of a block.
+			*/
+			static FreeLinks* links(Block *block);
+
+			/**
+			\param block The block.
+
+			\return The block that is physically located after \p block.
+
+			\brief Returns the block that is physically located after a block.
+			*/
+			static Block* nextPhysical(Block *block);
+
+			/**
+			\param size		  The size to map.
+			\param firstLevel  Receives the first level class.
+			\param secondLevel Receives the second level class.
+
+			\brief Calculates the size class that a block of the passed size is stored in.
+			*/
+			static void mapInsert(sizeType size, sizeType &firstLevel, sizeType &secondLevel);
+
+			/**
+			\param size		  The size to map.
+			\param firstLevel  Receives the first level class.
+			\param secondLevel Receives the second level class.
+
+			\brief Calculates the smallest size class in which all blocks are at least as large as \p size.
+			*/
+			static void mapSearch(sizeType size, sizeType &firstLevel, sizeType &secondLevel);
+
+			/**
+			\param block The block to insert. It must be marked as free.
+
+			\brief Inserts a block into the free list of its size class.
+			*/
+			void insertFree(Block *block);
+
+			/**
+			\param block The block to remove.
+
+			\brief Removes a block from the free list of its size class.
+			*/
+			void removeFree(Block *block);
+
+			/**
+			\param size The minimum size of the payload.
+
+			\return A free block that is at least as large as \p size, or \p nullptr if there is none. The block 
+			        is not removed from its free list.
+
+			\brief Searches a free block using the bitmaps.
+			*/
+			Block* findFree(sizeType size) const;
+
+			/**
+			\param block The block to split. It must not be in a free list.
+			\param size  The size that \p block will have after the split.
+
+			\brief If \p block is large enough, the part after the first \p size bytes of the payload is split
+			       into a new free block.
+			*/
+			void split(Block *block, sizeType size);
+
+		public:
+
+			/**
+			\param memory The memory region that the engine manages.
+			\param size   The size of the memory region.
+
+			\brief Constructs a new engine that manages the passed memory region.
+			*/
+			NOU_FUNC GeneralPurposeAllocatorSegregatedFit(byte *memory, sizeType size);
+
+			/**
+			\param size	  The amount of bytes to allocate.
+			\param alignment The alignment of the allocated memory. Must be a power of two.
+
+			\return The allocated memory, or \p nullptr if there is no free block that is large enough.
+
+			\brief Allocates memory in constant time.
+			*/
+			NOU_FUNC void* allocate(sizeType size, sizeType alignment);
+
+			/**
+			\param ptr A pointer that was returned by allocate().
+
+			\brief Frees the passed memory in constant time and merges it with its free neighbors.
+			*/
+			NOU_FUNC void deallocate(void *ptr);
+
+			/**
+			\param ptr A pointer.
+
+			\return True, if \p ptr is inside of the memory region and points to the payload of a block that is 
+			        not free, false if not.
+
+			\brief Returns whether a pointer could have been returned by allocate(). This is only a heuristic
+			       that is used to detect invalid deallocations.
+			*/
+			NOU_FUNC boolean isAllocated(const void *ptr) const;
+		};
 	}
 
+	/**
+	\brief The strategies that a GeneralPurposeAllocator can use to manage its free memory.
+	*/
+	enum class GeneralPurposeAllocatorMode
+	{
+		/**
+		\brief The free chunks are stored in a vector. An allocation searches the first chunk that is large 
+		       enough and a deallocation merges the freed memory with the neighboring chunks. The cost of both
+		       grows with the amount of free chunks. This is the default.
+		*/
+		FIRST_FIT,
+
+		/**
+		\brief The free memory is stored in segregated free lists with power of two and quarter step size 
+		       classes (see internal::GeneralPurposeAllocatorSegregatedFit). Allocations and deallocations 
+		       take constant time, regardless of the fragmentation.
+		*/
+		SEGREGATED_FIT
+	};
+
 	/**
 	\brief		Defines the GeneralPurposeAllocator class, which is used to allocate and deallocate objects.
 
@@ -288,14 +564,49 @@ namespace NOU::NOU_MEM_MNGT
 		NOU_DAT_ALG::Vector<internal::GeneralPurposeAllocatorFreeChunk> m_freeChunks; 
 		///\todo sorting with insert function
 
+		/**
+		\brief The mode of the allocator.
+		*/
+		GeneralPurposeAllocatorMode m_mode;
+
+		/**
+		\brief The engine that is used by GeneralPurposeAllocatorMode::SEGREGATED_FIT, or \p nullptr if another
+		       mode is used.
+		*/
+		internal::GeneralPurposeAllocatorSegregatedFit *m_segregatedFit;
+
+		/**
+		\brief The region that \p m_data is part of, if the memory was allocated using pageAlloc(). Otherwise,
+		       PageRegion::data is \p nullptr.
+		*/
+		PageRegion m_pages;
+
+		/**
+		\brief Sets up the free memory management for \p m_data, depending on the mode.
+		*/
+		void initialize();
+
 	public:
 
 		/**
 		\param size	The size of the GPA. Can be set manually or the default size.
+		\param mode	The strategy that is used to manage the free memory.
 
 		\brief		Creates a new GPA with a passed size or the default size.
 		*/
-		NOU_FUNC explicit GeneralPurposeAllocator(sizeType size = GENERAL_PURPOSE_ALLOCATOR_DEFAULT_SIZE);
+		NOU_FUNC explicit GeneralPurposeAllocator(sizeType size = GENERAL_PURPOSE_ALLOCATOR_DEFAULT_SIZE,
+			GeneralPurposeAllocatorMode mode = GeneralPurposeAllocatorMode::FIRST_FIT);
+
+		/**
+		\param size        The size of the GPA. It is rounded up to a multiple of the page size.
+		\param mode        The strategy that is used to manage the free memory.
+		\param pageOptions The options that are passed to pageAlloc().
+
+		\brief		Creates a new GPA whose memory is allocated directly from the operating system using
+					pageAlloc(), e.g. to back it with huge pages.
+		*/
+		NOU_FUNC GeneralPurposeAllocator(sizeType size, GeneralPurposeAllocatorMode mode,
+			const PageAllocationOptions &pageOptions);
 
 		GeneralPurposeAllocator(const GeneralPurposeAllocator& other) = delete;
 		GeneralPurposeAllocator(GeneralPurposeAllocator&& other) = delete;
@@ -307,6 +618,13 @@ namespace NOU::NOU_MEM_MNGT
 		*/
 		NOU_FUNC ~GeneralPurposeAllocator();
 
+		/**
+		\return The mode of the GPA.
+
+		\brief Returns the strategy that is used to manage the free memory.
+		*/
+		NOU_FUNC GeneralPurposeAllocatorMode getMode() const;
+
 		/**
 		\tparam T				The type of the object which will be allocated.
 		\tparam ARGS			The passed data of the object.
@@ -467,6 +785,23 @@ namespace NOU::NOU_MEM_MNGT
 		GeneralPurposeAllocator::allocateObjects(sizeType amountOfObjects, ARGS&&... args)
 	{
 		static_assert(alignof(T) <= 128, "Max alignment of 128 was exceeded!");
+
+		if (m_mode == GeneralPurposeAllocatorMode::SEGREGATED_FIT)
+		{
+			T* data = reinterpret_cast<T*>(m_segregatedFit->allocate(amountOfObjects * sizeof(T), alignof(T)));
+
+			if (data == nullptr)
+			{
+				return GeneralPurposeAllocatorPointer<T>(nullptr, 0);
+			}
+
+			for (sizeType i = 0; i < amountOfObjects; i++)
+			{
+				new(addressof(data[i])) T(NOU_CORE::forward<ARGS>(args)...);
+			}
+
+			return GeneralPurposeAllocatorPointer<T>(data, amountOfObjects);
+		}
 	
 		for (sizeType i = 0; i < m_freeChunks.size(); i++)
 		{
@@ -495,6 +830,26 @@ namespace NOU::NOU_MEM_MNGT
 	template <typename T>
 	void GeneralPurposeAllocator::deallocateObjects(GeneralPurposeAllocatorPointer<T> pointer)
 	{
+		if (m_mode == GeneralPurposeAllocatorMode::SEGREGATED_FIT)
+		{
+#ifdef NOU_DEBUG
+			if (!m_segregatedFit->isAllocated(pointer.m_pdata))
+			{
+				NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_DEALLOCATION,
+					"Tried to deallocated an object that does not exist.");
+				return;
+			}
+#endif
+
+			for (sizeType i = 0; i < pointer.m_size; i++)
+			{
+				addressof(pointer.m_pdata[i])->~T();
+			}
+
+			m_segregatedFit->deallocate(pointer.m_pdata);
+			return;
+		}
+
 #ifdef NOU_DEBUG
 		//data chunk boundary checks
 		if (reinterpret_cast<byte*>(pointer.m_pdata) < m_data ||
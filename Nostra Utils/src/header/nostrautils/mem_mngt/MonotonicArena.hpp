@@ -0,0 +1,320 @@
+#ifndef NOU_MEM_MNGT_MONOTONIC_ARENA_HPP
+#define NOU_MEM_MNGT_MONOTONIC_ARENA_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/mem_mngt/Utils.hpp"
+#include "nostrautils/mem_mngt/PageAllocator.hpp"
+
+/**
+\file mem_mngt/MonotonicArena.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::mem_mngt::MonotonicArena class.
+
+\see nostra::utils::mem_mngt::ArenaAllocationCallback
+*/
+
+namespace NOU::NOU_MEM_MNGT
+{
+	/**
+	\brief An allocator that hands out memory by advancing a pointer through a chain of large blocks.
+
+	\details
+	An allocator that hands out memory by advancing a pointer through a chain of large blocks. Single
+	allocations can not be freed, instead, all of the memory is released at once using reset() or everything
+	that was allocated after a certain point can be released using mark() and rewind(). Both operations take
+	constant time. The blocks themselves are kept and will be reused by later allocations until the arena is
+	destroyed or release() is called.
+
+	If a block is full, a new one is allocated. The size of the blocks doubles with each new block, up to
+	MAX_BLOCK_SIZE (or the size of a single allocation, if that is larger).
+
+	Optionally, the blocks can be allocated directly from the operating system using pageAlloc(), e.g. to back
+	a large arena with huge pages. In that case, each block uses all of the memory of its pages.
+
+	Arenas are usually used together with ArenaAllocationCallback, which allows all containers to allocate
+	their memory from an arena. Typically, an arena is created for a short-lived task (e.g. handling a single
+	request) and reset at the end of it.
+
+	\warning
+	An arena is not thread-safe.
+	*/
+	class MonotonicArena final
+	{
+	public:
+		/**
+		\brief The default size of the first block.
+		*/
+		static constexpr sizeType DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+		/**
+		\brief The maximum size that the blocks will grow to. A block may only be larger if a single
+		       allocation is larger.
+		*/
+		static constexpr sizeType MAX_BLOCK_SIZE = 1024 * 1024;
+
+	private:
+		/**
+		\brief The header of a block. The usable memory of the block directly follows the header.
+		*/
+		struct Block
+		{
+			/**
+			\brief The next block in the chain, or \p nullptr if this is the last block.
+			*/
+			Block    *m_next;
+
+			/**
+			\brief The amount of usable bytes in the block (without the header).
+			*/
+			sizeType  m_size;
+
+			/**
+			\brief The region that the block was allocated in, if it was allocated using pageAlloc().
+			       Otherwise, PageRegion::data is \p nullptr.
+			*/
+			PageRegion m_region;
+		};
+
+		/**
+		\brief The size of a block header, rounded up so that the usable memory of the block is aligned for all
+		       fundamental types.
+		*/
+		static constexpr sizeType HEADER_SIZE = (sizeof(Block) + alignof(std::max_align_t) - 1) /
+			alignof(std::max_align_t) * alignof(std::max_align_t);
+
+		/**
+		\brief The first block in the chain, or \p nullptr if no block has been allocated yet.
+		*/
+		Block    *m_first;
+
+		/**
+		\brief The block that allocations are currently served from.
+		*/
+		Block    *m_current;
+
+		/**
+		\brief The next free byte in the current block.
+		*/
+		byte     *m_position;
+
+		/**
+		\brief The end of the current block.
+		*/
+		byte     *m_end;
+
+		/**
+		\brief The size of the next block that will be allocated.
+		*/
+		sizeType  m_nextBlockSize;
+
+		/**
+		\brief The sum of the sizes of all blocks.
+		*/
+		sizeType  m_capacity;
+
+		/**
+		\brief True, if the blocks are allocated using pageAlloc().
+		*/
+		boolean   m_usePages;
+
+		/**
+		\brief The options that are passed to pageAlloc(), if \p m_usePages is true.
+		*/
+		PageAllocationOptions m_pageOptions;
+
+		/**
+		\param size The amount of usable bytes.
+
+		\return The new block, or \p nullptr if the allocation failed.
+
+		\brief Allocates a new block and initializes its header. The block is not linked into the chain.
+		*/
+		Block* allocateBlock(sizeType size);
+
+		/**
+		\param block The block.
+
+		\return The first usable byte of \p block.
+
+		\brief Returns the first usable byte of a block.
+		*/
+		static byte* blockBegin(Block *block);
+
+		/**
+		\param bytes     The amount of bytes to allocate.
+		\param alignment The alignment of the allocation.
+
+		\return The allocated memory, or \p nullptr if a new block was required and could not be allocated.
+
+		\brief Serves an allocation that does not fit into the current block by moving on to the next block in
+		       the chain or by allocating a new one.
+		*/
+		void* allocateSlow(sizeType bytes, sizeType alignment);
+
+	public:
+		/**
+		\brief A position in an arena that the arena can be rewound to.
+
+		\see MonotonicArena::mark()
+		\see MonotonicArena::rewind()
+		*/
+		class Marker final
+		{
+			friend class MonotonicArena;
+
+		private:
+			/**
+			\brief The block that was the current block at the time the marker was created.
+			*/
+			Block *m_block;
+
+			/**
+			\brief The next free byte in \p m_block at the time the marker was created.
+			*/
+			byte  *m_position;
+
+			/**
+			\param block    The current block.
+			\param position The next free byte in \p block.
+
+			\brief Constructs a new marker.
+			*/
+			Marker(Block *block, byte *position);
+		};
+
+		/**
+		\brief Makes an arena the current arena of the calling thread for as long as an instance of this class
+		       exists.
+
+		\details
+		Makes an arena the current arena of the calling thread for as long as an instance of this class exists.
+		The previous current arena is restored when the scope is destroyed, so scopes can be nested.
+
+		\see MonotonicArena::getCurrent()
+		*/
+		class Scope final
+		{
+		private:
+			/**
+			\brief The current arena at the time the scope was created.
+			*/
+			MonotonicArena *m_previous;
+
+		public:
+			/**
+			\param arena The arena that will become the current arena.
+
+			\brief Makes \p arena the current arena of the calling thread.
+			*/
+			NOU_FUNC explicit Scope(MonotonicArena &arena);
+
+			Scope(const Scope&) = delete;
+			Scope& operator = (const Scope&) = delete;
+
+			/**
+			\brief Restores the previous current arena.
+			*/
+			NOU_FUNC ~Scope();
+		};
+
+		/**
+		\param blockSize The size of the first block. The block will not be allocated before the first
+		                 allocation.
+
+		\brief Constructs a new, empty arena.
+		*/
+		NOU_FUNC explicit MonotonicArena(sizeType blockSize = DEFAULT_BLOCK_SIZE);
+
+		/**
+		\param blockSize   The size of the first block. The block will not be allocated before the first
+		                   allocation.
+		\param pageOptions The options that are passed to pageAlloc().
+
+		\brief Constructs a new, empty arena whose blocks are allocated directly from the operating system
+		       using pageAlloc().
+		*/
+		NOU_FUNC MonotonicArena(sizeType blockSize, const PageAllocationOptions &pageOptions);
+
+		MonotonicArena(const MonotonicArena&) = delete;
+		MonotonicArena& operator = (const MonotonicArena&) = delete;
+
+		/**
+		\brief Frees all blocks.
+		*/
+		NOU_FUNC ~MonotonicArena();
+
+		/**
+		\param bytes     The amount of bytes to allocate.
+		\param alignment The alignment of the allocation. Must be a power of two.
+
+		\return The allocated memory, or \p nullptr if the allocation failed.
+
+		\brief Allocates a block of uninitialized memory.
+		*/
+		NOU_FUNC void* allocate(sizeType bytes, sizeType alignment = alignof(std::max_align_t));
+
+		/**
+		\tparam T The type of the objects.
+
+		\param amount The amount of objects.
+
+		\return The allocated memory, or \p nullptr if the allocation failed.
+
+		\brief Allocates uninitialized memory for \p amount objects of the type \p T.
+		*/
+		template<typename T>
+		T* allocateUninitialized(sizeType amount = 1);
+
+		/**
+		\return A marker for the current position.
+
+		\brief Returns a marker that can be used to free everything that is allocated after this call.
+		*/
+		NOU_FUNC Marker mark() const;
+
+		/**
+		\param marker A marker that was returned by mark() of the same arena. The arena must not have been
+		              reset or rewound to an earlier marker in the meantime.
+
+		\brief Frees everything that has been allocated since \p marker was created in constant time.
+		*/
+		NOU_FUNC void rewind(const Marker &marker);
+
+		/**
+		\brief Frees everything that has been allocated from the arena in constant time. The blocks are kept
+		       and will be reused.
+		*/
+		NOU_FUNC void reset();
+
+		/**
+		\brief Frees everything that has been allocated from the arena and returns all blocks to the system.
+		*/
+		NOU_FUNC void release();
+
+		/**
+		\return The sum of the sizes of all blocks.
+
+		\brief Returns the amount of bytes that the arena can hold without allocating a new block.
+		*/
+		NOU_FUNC sizeType capacity() const;
+
+		/**
+		\return The current arena, or \p nullptr if there is none.
+
+		\brief Returns the arena that was made the current arena of the calling thread using Scope.
+		*/
+		NOU_FUNC static MonotonicArena* getCurrent();
+	};
+
+	template<typename T>
+	T* MonotonicArena::allocateUninitialized(sizeType amount)
+	{
+		return reinterpret_cast<T*>(allocate(sizeof(T) * amount, alignof(T)));
+	}
+}
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef NOU_MEM_MNGT_PAGE_ALLOCATOR_HPP
+#define NOU_MEM_MNGT_PAGE_ALLOCATOR_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+
+/**
+\file mem_mngt/PageAllocator.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains functions that allocate memory directly from the operating system in whole pages,
+       optionally using huge pages.
+
+\see nostra::utils::mem_mngt::pageAlloc()
+\see nostra::utils::mem_mngt::pageFree()
+*/
+
+namespace NOU::NOU_MEM_MNGT
+{
+	/**
+	\brief The kind of huge pages that pageAlloc() attempts to use.
+	*/
+	enum class HugePageMode
+	{
+		/**
+		\brief Only regular pages are used.
+		*/
+		NONE,
+
+		/**
+		\brief The memory is aligned to the huge page size and the system is advised to back it with
+		       transparent huge pages (<tt>madvise(MADV_HUGEPAGE)</tt> on Linux). If the system ignores the
+		       advice, regular pages are used.
+		*/
+		TRANSPARENT,
+
+		/**
+		\brief Huge pages from the reserved pool of the system are used (<tt>MAP_HUGETLB</tt> on Linux,
+		       <tt>MEM_LARGE_PAGES</tt> on Windows). If that pool is empty (or the process lacks the
+		       privilege), the behavior of TRANSPARENT is used instead.
+		*/
+		EXPLICIT
+	};
+
+	/**
+	\brief The kind of pages that a region returned by pageAlloc() is backed by.
+	*/
+	enum class PageType
+	{
+		/**
+		\brief The allocation failed.
+		*/
+		NONE,
+
+		/**
+		\brief Regular pages.
+		*/
+		SMALL,
+
+		/**
+		\brief Transparent huge pages have been requested successfully. The system may still use regular pages
+		       for parts of the region (e.g. if no contiguous physical memory is available).
+		*/
+		TRANSPARENT_HUGE,
+
+		/**
+		\brief Huge pages from the reserved pool of the system.
+		*/
+		HUGE
+	};
+
+	/**
+	\brief The options of pageAlloc().
+	*/
+	struct PageAllocationOptions
+	{
+		/**
+		\brief The value of \p numaNode that does not bind the memory to any node.
+		*/
+		constexpr static sizeType ANY_NUMA_NODE = static_cast<sizeType>(-1);
+
+		/**
+		\brief The kind of huge pages to use.
+		*/
+		HugePageMode hugePages;
+
+		/**
+		\brief If true, all pages are faulted in by pageAlloc(), so that the first access to the memory does
+		       not cause page faults.
+		*/
+		boolean prefault;
+
+		/**
+		\brief The id of the NUMA node (as used by the operating system) that the memory is bound to, or
+		       ANY_NUMA_NODE. Binding is only supported on Linux and Windows and is done on a best effort
+		       basis; if it fails, the memory is allocated regardless.
+		*/
+		sizeType numaNode;
+
+		/**
+		\param hugePages The kind of huge pages to use.
+		\param prefault  Whether all pages should be faulted in by pageAlloc().
+		\param numaNode  The NUMA node that the memory is bound to.
+
+		\brief Constructs a new instance.
+		*/
+		NOU_FUNC PageAllocationOptions(HugePageMode hugePages = HugePageMode::TRANSPARENT,
+			boolean prefault = false, sizeType numaNode = ANY_NUMA_NODE);
+	};
+
+	/**
+	\brief A region of memory that was allocated using pageAlloc().
+	*/
+	struct PageRegion
+	{
+		/**
+		\brief The first byte of the region, or \p nullptr if the allocation failed.
+		*/
+		byte *data;
+
+		/**
+		\brief The size of the region in bytes. This is the requested size, rounded up to a multiple of the
+		       page size. All of it may be used.
+		*/
+		sizeType size;
+
+		/**
+		\brief The kind of pages that back the region.
+		*/
+		PageType type;
+
+		/**
+		\brief Constructs an empty region.
+		*/
+		NOU_FUNC PageRegion();
+	};
+
+	/**
+	\return The size of a regular page in bytes.
+
+	\brief Returns the size of a regular page of the system.
+	*/
+	NOU_FUNC sizeType pageSize();
+
+	/**
+	\return The size of a huge page in bytes, or 0 if the system does not support huge pages.
+
+	\brief Returns the (default) size of a huge page of the system.
+	*/
+	NOU_FUNC sizeType hugePageSize();
+
+	/**
+	\param bytes   The amount of bytes to allocate.
+	\param options The options of the allocation.
+
+	\return The allocated region. PageRegion::data is \p nullptr if the allocation failed.
+
+	\brief Allocates a region of memory directly from the operating system.
+
+	\details
+	Allocates a region of memory directly from the operating system. The region is always aligned to the size
+	of the pages that back it and it is initialized with zeros.
+
+	This is meant for large, long-lived allocations (e.g. the memory of a pool or an allocator). For large
+	data sets that are accessed randomly, huge pages reduce the amount of TLB misses significantly. If huge
+	pages can not be used, the function falls back to regular pages, the allocation only fails if no memory
+	at all is available.
+	*/
+	NOU_FUNC PageRegion pageAlloc(sizeType bytes, const PageAllocationOptions &options = PageAllocationOptions());
+
+	/**
+	\param region The region to free. It must have been returned by pageAlloc().
+
+	\brief Returns a region that was allocated using pageAlloc() to the operating system.
+
+	\note
+	Attempting to free a region whose data is <tt>nullptr</tt> will never fail.
+	*/
+	NOU_FUNC void pageFree(const PageRegion &region);
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "nostrautils/dat_alg/Vector.hpp"
 #include "nostrautils/mem_mngt/Utils.hpp"
 #include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/mem_mngt/PageAllocator.hpp"
 
 /**
 \file mem_mngt/PoolAllocator.hpp
@@ -85,6 +86,21 @@ namespace NOU::NOU_MEM_MNGT
 		*/
 		PoolBlock<T>* m_head = nullptr;
 
+		/**
+		\brief True, if the PoolBlocks are allocated using pageAlloc().
+		*/
+		boolean m_usePages = false;
+
+		/**
+		\brief The options that are passed to pageAlloc(), if m_usePages is true.
+		*/
+		PageAllocationOptions m_pageOptions;
+
+		/**
+		\brief The regions that store the PoolBlocks, if m_usePages is true.
+		*/
+		NOU_DAT_ALG::Vector<PageRegion> m_regions;
+
 	public:
 
 		/**
@@ -99,6 +115,21 @@ namespace NOU::NOU_MEM_MNGT
 		explicit PoolAllocator(sizeType size = POOL_ALLOCATOR_DEFAULT_SIZE, 
 			Allocator &&allocator = Allocator());
 
+		/**
+		\param size			The minimum size of the PoolAllocator. It is increased so that the PoolBlocks 
+							fill all of the memory of the allocated pages.
+
+		\param pageOptions	The options that are passed to pageAlloc().
+
+		\param allocator	Reference to an AllocationCallback that is used for initializing the m_blocks
+							vector.
+
+		\brief				Constructs a new PoolAllocator whose PoolBlocks are allocated directly from the 
+							operating system using pageAlloc(), e.g. to back them with huge pages.
+		*/
+		PoolAllocator(sizeType size, const PageAllocationOptions &pageOptions, 
+			Allocator &&allocator = Allocator());
+
 		/**
 		\brief Deleted copy constructor.
 		*/
@@ -165,12 +196,33 @@ namespace NOU::NOU_MEM_MNGT
 		newPool(size);
 	}
 
+	template <typename T, template<typename> class ALLOC>
+	PoolAllocator<T, ALLOC>::PoolAllocator(sizeType size, const PageAllocationOptions &pageOptions, 
+		Allocator &&allocator) :
+		m_size(size),
+		m_blocks(BLOCK_BUFFER_DEFAULT_SIZE, NOU_CORE::move(allocator)),
+		m_usePages(true),
+		m_pageOptions(pageOptions)
+	{
+		newPool(size);
+	}
+
 	template <typename T, template<typename> class ALLOC>
 	PoolAllocator<T, ALLOC>::~PoolAllocator()
 	{
-		for (PoolBlock<T>* block : m_blocks)
+		if (m_usePages)
 		{
-			delete[] block;
+			for (sizeType i = 0; i < m_regions.size(); i++)
+			{
+				pageFree(m_regions[i]);
+			}
+		}
+		else
+		{
+			for (PoolBlock<T>* block : m_blocks)
+			{
+				delete[] block;
+			}
 		}
 		
 		m_head = nullptr;
@@ -179,7 +231,38 @@ namespace NOU::NOU_MEM_MNGT
 	template <typename T, template<typename> class ALLOC>
 	void PoolAllocator<T, ALLOC>::newPool(sizeType size)
 	{
-		PoolBlock<T>* m_data = new PoolBlock<T>[size];
+		PoolBlock<T>* m_data;
+
+		if (m_usePages)
+		{
+			PageRegion region = pageAlloc(sizeof(PoolBlock<T>) * size, m_pageOptions);
+
+			if (region.data == nullptr)
+			{
+				NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+					"The allocation failed.");
+
+				return;
+			}
+
+			//the first pool determines the size of all pools, it uses the entire memory of its pages
+			if (m_regions.size() == 0)
+				m_size = region.size / sizeof(PoolBlock<T>);
+
+			m_data = reinterpret_cast<PoolBlock<T>*>(region.data);
+
+			for (sizeType i = 0; i < m_size; i++)
+			{
+				new (m_data + i) PoolBlock<T>();
+			}
+
+			m_regions.pushBack(region);
+		}
+		else
+		{
+			m_data = new PoolBlock<T>[size];
+		}
+
 		m_head = m_data;
 
 		for (sizeType i = 0; i < m_size - 1; i++)
@@ -197,8 +280,7 @@ namespace NOU::NOU_MEM_MNGT
 	{	
 		if (PoolAllocator<T, ALLOC>::m_usedSize == m_blocks.size() * m_size)
 		{
-			newPool();
-			m_head = m_blocks.at(m_blocks.size() - 1);
+			newPool(m_size);
 		}
 
 		if (m_head == nullptr)
@@ -227,7 +309,7 @@ namespace NOU::NOU_MEM_MNGT
 		for (sizeType i = 0; i < m_blocks.size() && !found; i++)
 		{
 			if (static_cast<void*>(data) >= static_cast<void*>(m_blocks[i]) && 
-				static_cast<void*>(data) <= static_cast<void*>(m_blocks[i] + POOL_ALLOCATOR_DEFAULT_SIZE))
+				static_cast<void*>(data) <= static_cast<void*>(m_blocks[i] + m_size))
 				found = true;
 		}
 
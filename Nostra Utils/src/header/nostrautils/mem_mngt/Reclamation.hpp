@@ -0,0 +1,590 @@
+#ifndef NOU_MEM_MNGT_RECLAMATION_HPP
+#define NOU_MEM_MNGT_RECLAMATION_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/mem_mngt/Utils.hpp"
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+
+/**
+\file mem_mngt/Reclamation.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the deferred memory reclamation schemes for lock-free data structures,
+       nostra::utils::mem_mngt::EpochReclaimer and nostra::utils::mem_mngt::HazardPointerDomain.
+
+\see nostra::utils::mem_mngt::EpochReclaimer
+\see nostra::utils::mem_mngt::HazardPointerDomain
+*/
+
+namespace NOU::NOU_MEM_MNGT
+{
+	/**
+	\brief An object that has been removed from a data structure and that will be destroyed and deallocated as
+	       soon as no thread can access it anymore.
+
+	\details
+	An object that has been removed from a data structure and that will be destroyed and deallocated as soon as
+	no thread can access it anymore. The object is deallocated using the allocation callback that it was
+	allocated with; a copy of the callback is stored in the retired object itself, hence the callback must be
+	trivially copyable and small (all callbacks of this library are).
+	*/
+	class RetiredObject final
+	{
+	public:
+		/**
+		\brief The maximum size of the allocation callback of a retired object.
+		*/
+		constexpr static sizeType CALLBACK_SIZE = 2 * sizeof(void*);
+
+		/**
+		\brief The type of the function that destroys and deallocates an object.
+		*/
+		using ReclaimFunction = void(*)(RetiredObject &retired);
+
+	private:
+		/**
+		\brief The object.
+		*/
+		void *m_object;
+
+		/**
+		\brief The function that destroys and deallocates the object.
+		*/
+		ReclaimFunction m_reclaim;
+
+		/**
+		\brief The epoch in which the object was retired, only used by EpochReclaimer.
+		*/
+		uint64 m_epoch;
+
+		/**
+		\brief The storage of the allocation callback.
+		*/
+		alignas(void*) byte m_callback[CALLBACK_SIZE];
+
+		/**
+		\tparam T     The type of the object.
+		\tparam ALLOC The allocation callback.
+
+		\param retired The retired object.
+
+		\brief Destroys and deallocates the object, the implementation of \p m_reclaim.
+		*/
+		template<typename T, template<typename> class ALLOC>
+		static void reclaimObject(RetiredObject &retired);
+
+	public:
+		/**
+		\brief Constructs an empty instance that does not refer to any object.
+		*/
+		RetiredObject() = default;
+
+		/**
+		\tparam T     The type of the object.
+		\tparam ALLOC The allocation callback.
+
+		\param object    The object.
+		\param allocator The callback that the object was allocated with.
+
+		\brief Constructs a new instance that will destroy \p object and deallocate it using \p allocator.
+		*/
+		template<typename T, template<typename> class ALLOC>
+		RetiredObject(T *object, const ALLOC<T> &allocator);
+
+		/**
+		\return The object.
+		*/
+		NOU_FUNC void* getObject() const;
+
+		/**
+		\return The epoch in which the object was retired.
+		*/
+		NOU_FUNC uint64 getEpoch() const;
+
+		/**
+		\param epoch The epoch.
+
+		\brief Sets the epoch in which the object was retired.
+		*/
+		NOU_FUNC void setEpoch(uint64 epoch);
+
+		/**
+		\brief Destroys and deallocates the object.
+		*/
+		NOU_FUNC void reclaim();
+	};
+
+	namespace internal
+	{
+		/**
+		\brief The common parent class of EpochReclaimer and HazardPointerDomain, that manages the records of
+		       the threads that use a reclaimer.
+
+		\details
+		The common parent class of EpochReclaimer and HazardPointerDomain, that manages the records of the
+		threads that use a reclaimer. A thread obtains a record when it uses a reclaimer for the first time
+		(e.g. when a task runs on a worker of the ThreadManager for the first time). When the thread exits, the
+		record (including the objects that the thread retired, but that could not be reclaimed yet) is released
+		and will be reused by the next thread that needs a record. Records are only freed when the reclaimer is
+		destroyed, which also reclaims all objects that are still retired.
+
+		\note
+		This class is not meant to be used directly by a user.
+		*/
+		class ReclamationDomain
+		{
+		public:
+			/**
+			\brief The amount of hazard pointers of each thread.
+			*/
+			constexpr static sizeType HAZARD_POINTER_COUNT = 8;
+
+			/**
+			\brief The default amount of retired objects of a single thread that triggers an attempt to reclaim
+			       them.
+			*/
+			constexpr static sizeType DEFAULT_BATCH_SIZE = 64;
+
+			/**
+			\brief The record of a single thread. The type is only defined in the source file.
+			*/
+			struct ThreadRecord;
+
+		protected:
+			/**
+			\brief A unique id of the reclaimer.
+			*/
+			uint64 m_id;
+
+			/**
+			\brief The amount of retired objects that triggers an attempt to reclaim them.
+			*/
+			sizeType m_batchSize;
+
+			/**
+			\brief The records of all threads, as a singly linked list. Records are never removed until the
+			       reclaimer is destroyed.
+			*/
+			std::atomic<ThreadRecord*> m_records;
+
+			/**
+			\param batchSize The amount of retired objects that triggers an attempt to reclaim them.
+
+			\brief Constructs a new reclaimer.
+			*/
+			NOU_FUNC explicit ReclamationDomain(sizeType batchSize);
+
+			/**
+			\brief Reclaims all retired objects and frees the records.
+			*/
+			NOU_FUNC ~ReclamationDomain();
+
+			/**
+			\return The record of the calling thread.
+
+			\brief Returns the record of the calling thread, it is obtained if the thread does not have one yet.
+			*/
+			ThreadRecord& threadRecord();
+
+			/**
+			\param retired The object.
+
+			\return The record of the calling thread.
+
+			\brief Appends an object to the retired objects of the calling thread.
+			*/
+			ThreadRecord& appendRetired(const RetiredObject &retired);
+
+		public:
+			ReclamationDomain(const ReclamationDomain&) = delete;
+			ReclamationDomain& operator = (const ReclamationDomain&) = delete;
+
+			/**
+			\return The amount of objects that have been retired, but not reclaimed yet.
+
+			\brief Returns the amount of objects that have been retired, but not reclaimed yet. If other threads
+			       retire or reclaim objects at the same time, the value may be outdated immediately.
+			*/
+			NOU_FUNC sizeType retiredCount() const;
+		};
+	}
+
+	/**
+	\brief A memory reclamation scheme that is based on global epochs.
+
+	\details
+	A memory reclamation scheme that is based on global epochs. Threads access a shared data structure only
+	inside a critical section (see Guard), which records the global epoch that the thread has observed. An
+	object that has been removed from the structure is retired (see retire()), it is reclaimed as soon as the
+	global epoch has advanced twice since then, because at that point no thread can still be in a critical
+	section that started before the object was removed.
+
+	Entering and leaving a critical section is very cheap (no read-modify-write operations are involved) and
+	objects are retired and reclaimed in batches. However, a thread that stays in a critical section for a
+	long time (or is preempted within one) prevents all objects from being reclaimed, hence the amount of
+	memory is unbounded. If that is a problem, HazardPointerDomain should be used instead.
+
+	Critical sections can be nested. Objects can be retired both inside and outside of critical sections.
+
+	\note
+	The loads and the operations that unlink objects from the data structure must use
+	<tt>std::memory_order_seq_cst</tt> (the default of <tt>std::atomic</tt>), otherwise the epoch that an object is
+	retired in may be too old.
+
+	Example:
+	\code{.cpp}
+	EpochReclaimer &reclaimer = EpochReclaimer::getDefault();
+
+	{
+		EpochReclaimer::Guard guard(reclaimer);
+
+		Node *node = head.load();
+		//... unlink the node using CAS
+
+		reclaimer.retire(node); //may not be deallocated yet, other threads may still read it
+	}
+	\endcode
+	*/
+	class EpochReclaimer final : public internal::ReclamationDomain
+	{
+	public:
+		/**
+		\brief Marks a critical section of the calling thread for as long as the guard exists.
+		*/
+		class Guard final
+		{
+		private:
+			/**
+			\brief The reclaimer.
+			*/
+			EpochReclaimer &m_reclaimer;
+
+		public:
+			/**
+			\param reclaimer The reclaimer.
+
+			\brief Enters a critical section.
+			*/
+			NOU_FUNC explicit Guard(EpochReclaimer &reclaimer);
+
+			Guard(const Guard&) = delete;
+			Guard& operator = (const Guard&) = delete;
+
+			/**
+			\brief Leaves the critical section.
+			*/
+			NOU_FUNC ~Guard();
+		};
+
+	private:
+		/**
+		\brief The global epoch.
+		*/
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64> m_epoch;
+
+		/**
+		\param retired The object.
+
+		\brief Retires an object in the current epoch.
+		*/
+		NOU_FUNC void retireObject(RetiredObject &retired);
+
+		/**
+		\param record The record of the calling thread.
+
+		\brief Attempts to advance the epoch and reclaims the objects of the calling thread that can be
+		       reclaimed.
+		*/
+		void collect(ThreadRecord &record);
+
+	public:
+		/**
+		\param batchSize The amount of retired objects of a single thread that triggers an attempt to reclaim
+		                 them.
+
+		\brief Constructs a new reclaimer.
+		*/
+		NOU_FUNC explicit EpochReclaimer(sizeType batchSize = DEFAULT_BATCH_SIZE);
+
+		/**
+		\brief Enters a critical section of the calling thread. Usually, a Guard should be used instead.
+		*/
+		NOU_FUNC void enter();
+
+		/**
+		\brief Leaves a critical section of the calling thread.
+		*/
+		NOU_FUNC void leave();
+
+		/**
+		\tparam T     The type of the object.
+		\tparam ALLOC The allocation callback that the object was allocated with.
+
+		\param object    The object. It must not be reachable from the data structure anymore.
+		\param allocator The callback that the object was allocated with.
+
+		\brief Destroys and deallocates an object as soon as no thread can access it anymore.
+		*/
+		template<typename T, template<typename> class ALLOC = GenericAllocationCallback>
+		void retire(T *object, const ALLOC<T> &allocator = ALLOC<T>());
+
+		/**
+		\return True, if the epoch was advanced, false if not.
+
+		\brief Advances the global epoch, if all threads that are in a critical section have observed the
+		       current one.
+		*/
+		NOU_FUNC boolean tryAdvance();
+
+		/**
+		\brief Attempts to advance the epoch and reclaims the objects that were retired by the calling thread
+		       and that can be reclaimed.
+
+		\details
+		Attempts to advance the epoch and reclaims the objects that were retired by the calling thread and that
+		can be reclaimed. This is done automatically by retire(), this function only needs to be called to
+		reclaim objects sooner.
+		*/
+		NOU_FUNC void collect();
+
+		/**
+		\return The global epoch.
+		*/
+		NOU_FUNC uint64 getEpoch() const;
+
+		/**
+		\return The default reclaimer. It is never destroyed.
+		*/
+		NOU_FUNC static EpochReclaimer& getDefault();
+	};
+
+	/**
+	\brief A memory reclamation scheme that is based on hazard pointers.
+
+	\details
+	A memory reclamation scheme that is based on hazard pointers. Before a thread accesses an object of a
+	shared data structure, it publishes the pointer to it in a hazard pointer (see HazardPointer::protect()).
+	A retired object is only reclaimed if no hazard pointer points to it.
+
+	Compared to EpochReclaimer, protecting a pointer is more expensive (it requires a full memory barrier),
+	but the amount of objects that are retired and not reclaimed yet is bounded: a thread never has more than
+	the batch size plus twice the total amount of hazard pointers of them, regardless of what other threads
+	do.
+
+	Example:
+	\code{.cpp}
+	HazardPointerDomain &domain = HazardPointerDomain::getDefault();
+
+	HazardPointerDomain::HazardPointer hazard(domain);
+
+	Node *node = hazard.protect(head); //node will not be reclaimed until hazard is reset or destroyed
+	\endcode
+	*/
+	class HazardPointerDomain final : public internal::ReclamationDomain
+	{
+	public:
+		/**
+		\brief A single hazard pointer of the calling thread.
+
+		\details
+		A single hazard pointer of the calling thread. Each thread has HAZARD_POINTER_COUNT hazard pointers per
+		domain, constructing more than that at the same time pushes an error with the code
+		nostra::utils::core::ErrorCodes::INVALID_STATE to the error handler and the hazard pointer will not
+		protect anything. A hazard pointer must only be used by the thread that constructed it.
+		*/
+		class HazardPointer final
+		{
+		private:
+			/**
+			\brief The record of the thread.
+			*/
+			ThreadRecord *m_record;
+
+			/**
+			\brief The slot of the pointer, or \p nullptr if no slot was available.
+			*/
+			std::atomic<void*> *m_slot;
+
+		public:
+			/**
+			\param domain The domain.
+
+			\brief Acquires a hazard pointer of the calling thread.
+			*/
+			NOU_FUNC explicit HazardPointer(HazardPointerDomain &domain);
+
+			HazardPointer(const HazardPointer&) = delete;
+			HazardPointer& operator = (const HazardPointer&) = delete;
+
+			/**
+			\brief Releases the hazard pointer.
+			*/
+			NOU_FUNC ~HazardPointer();
+
+			/**
+			\tparam T The type of the object.
+
+			\param source The location of the pointer.
+
+			\return The pointer that is protected, the value of \p source at some point during the call.
+
+			\brief Loads a pointer and protects it from being reclaimed.
+			*/
+			template<typename T>
+			T* protect(const std::atomic<T*> &source);
+
+			/**
+			\tparam T The type of the object.
+
+			\param object The pointer.
+
+			\brief Publishes a pointer without validating it. The caller must check that the object was not
+			       retired before the pointer was published.
+			*/
+			template<typename T>
+			void set(T *object);
+
+			/**
+			\brief Stops protecting the current pointer.
+			*/
+			NOU_FUNC void reset();
+		};
+
+	private:
+		/**
+		\param retired The object.
+
+		\brief Retires an object.
+		*/
+		NOU_FUNC void retireObject(RetiredObject &retired);
+
+		/**
+		\param record The record of the calling thread.
+
+		\brief Reclaims the objects of the calling thread that are not protected by any hazard pointer.
+		*/
+		void collect(ThreadRecord &record);
+
+	public:
+		/**
+		\param batchSize The minimal amount of retired objects of a single thread that triggers an attempt to
+		                 reclaim them.
+
+		\brief Constructs a new domain.
+		*/
+		NOU_FUNC explicit HazardPointerDomain(sizeType batchSize = DEFAULT_BATCH_SIZE);
+
+		/**
+		\tparam T     The type of the object.
+		\tparam ALLOC The allocation callback that the object was allocated with.
+
+		\param object    The object. It must not be reachable from the data structure anymore.
+		\param allocator The callback that the object was allocated with.
+
+		\brief Destroys and deallocates an object as soon as no hazard pointer points to it anymore.
+		*/
+		template<typename T, template<typename> class ALLOC = GenericAllocationCallback>
+		void retire(T *object, const ALLOC<T> &allocator = ALLOC<T>());
+
+		/**
+		\brief Reclaims the objects that were retired by the calling thread and that are not protected by any
+		       hazard pointer.
+
+		\details
+		Reclaims the objects that were retired by the calling thread and that are not protected by any hazard
+		pointer. This is done automatically by retire(), this function only needs to be called to reclaim
+		objects sooner.
+		*/
+		NOU_FUNC void collect();
+
+		/**
+		\return The default domain. It is never destroyed.
+		*/
+		NOU_FUNC static HazardPointerDomain& getDefault();
+	};
+
+	///\cond
+
+	template<typename T, template<typename> class ALLOC>
+	void RetiredObject::reclaimObject(RetiredObject &retired)
+	{
+		T *object = static_cast<T*>(retired.m_object);
+		ALLOC<T> allocator = *std::launder(reinterpret_cast<ALLOC<T>*>(retired.m_callback));
+
+		object->~T();
+		allocator.deallocate(object);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	RetiredObject::RetiredObject(T *object, const ALLOC<T> &allocator) :
+		m_object(object),
+		m_reclaim(&RetiredObject::reclaimObject<T, ALLOC>),
+		m_epoch(0)
+	{
+		static_assert(sizeof(ALLOC<T>) <= CALLBACK_SIZE && alignof(ALLOC<T>) <= alignof(void*),
+			"The allocation callback is too large to be stored in a retired object.");
+		static_assert(std::is_trivially_copyable<ALLOC<T>>::value,
+			"The allocation callback must be trivially copyable.");
+
+		new (m_callback) ALLOC<T>(allocator);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void EpochReclaimer::retire(T *object, const ALLOC<T> &allocator)
+	{
+		RetiredObject retired(object, allocator);
+		retireObject(retired);
+	}
+
+	template<typename T>
+	T* HazardPointerDomain::HazardPointer::protect(const std::atomic<T*> &source)
+	{
+		T *object = source.load(std::memory_order_relaxed);
+
+		if (m_slot == nullptr)
+			return source.load(std::memory_order_acquire);
+
+		while (true)
+		{
+			m_slot->store(object, std::memory_order_relaxed);
+
+			//the hazard pointer must be visible before the pointer is validated
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			T *validated = source.load(std::memory_order_acquire);
+
+			if (validated == object)
+				return object;
+
+			object = validated;
+		}
+	}
+
+	template<typename T>
+	void HazardPointerDomain::HazardPointer::set(T *object)
+	{
+		if (m_slot == nullptr)
+			return;
+
+		m_slot->store(object, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void HazardPointerDomain::retire(T *object, const ALLOC<T> &allocator)
+	{
+		RetiredObject retired(object, allocator);
+		retireObject(retired);
+	}
+
+	///\endcond
+}
+
+#endif
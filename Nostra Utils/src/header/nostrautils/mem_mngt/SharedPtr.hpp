@@ -0,0 +1,1331 @@
+#ifndef NOU_MEM_MNGT_SHARED_PTR_HPP
+#define NOU_MEM_MNGT_SHARED_PTR_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/core/ErrorHandler.hpp"
+#include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/mem_mngt/Pointer.hpp"
+
+#include <atomic>
+#include <new>
+
+/**
+\file mem_mngt/SharedPtr.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains reference counted smart pointers.
+
+\see nostra::utils::mem_mngt::SharedPtr
+\see nostra::utils::mem_mngt::WeakPtr
+\see nostra::utils::mem_mngt::IntrusivePtr
+*/
+
+namespace NOU::NOU_MEM_MNGT
+{
+	/**
+	\brief A reference count that can be modified by multiple threads at the same time.
+
+	\details
+	A reference count that can be modified by multiple threads at the same time. This is the policy that
+	should be used by default.
+
+	All reference count policies (see also PlainRefCount) have the same interface, a custom policy must provide
+	the same member functions.
+	*/
+	class AtomicRefCount final
+	{
+	private:
+		/**
+		\brief The count.
+		*/
+		std::atomic<uint32> m_count;
+
+	public:
+		/**
+		\param count The initial count.
+
+		\brief Constructs a new count.
+		*/
+		explicit AtomicRefCount(uint32 count);
+
+		/**
+		\brief Increments the count.
+		*/
+		void increment();
+
+		/**
+		\return True, if the count has become zero, false if not.
+
+		\brief Decrements the count.
+		*/
+		boolean decrement();
+
+		/**
+		\return True, if the count was incremented, false if it was zero.
+
+		\brief Increments the count, but only if it is not zero.
+		*/
+		boolean incrementIfNotZero();
+
+		/**
+		\return The count.
+
+		\brief Returns the count. If other threads modify the count, the value may be outdated immediately.
+		*/
+		uint32 get() const;
+	};
+
+	/**
+	\brief A reference count that uses plain integer arithmetic.
+
+	\details
+	A reference count that uses plain integer arithmetic. This is significantly cheaper than AtomicRefCount,
+	but pointers that share the same count must only be used (copied, destroyed, ...) by a single thread at a
+	time, e.g. for object graphs that are owned by a single thread.
+	*/
+	class PlainRefCount final
+	{
+	private:
+		/**
+		\brief The count.
+		*/
+		uint32 m_count;
+
+	public:
+		/**
+		\param count The initial count.
+
+		\brief Constructs a new count.
+		*/
+		explicit PlainRefCount(uint32 count);
+
+		/**
+		\brief Increments the count.
+		*/
+		void increment();
+
+		/**
+		\return True, if the count has become zero, false if not.
+
+		\brief Decrements the count.
+		*/
+		boolean decrement();
+
+		/**
+		\return True, if the count was incremented, false if it was zero.
+
+		\brief Increments the count, but only if it is not zero.
+		*/
+		boolean incrementIfNotZero();
+
+		/**
+		\return The count.
+
+		\brief Returns the count.
+		*/
+		uint32 get() const;
+	};
+
+	namespace internal
+	{
+		/**
+		\tparam COUNT The reference count policy.
+
+		\brief The part of the control block of a SharedPtr that does not depend on the type of the object.
+
+		\details
+		The part of the control block of a SharedPtr that does not depend on the type of the object. The block
+		is followed by the object itself (see SharedObjectBlock), both are allocated at once.
+
+		The weak count is the amount of WeakPtr instances plus one for all of the SharedPtr instances together.
+		The object is destroyed when the strong count becomes zero, the block is freed when the weak count does.
+		*/
+		template<typename COUNT>
+		class SharedControlBlock
+		{
+		public:
+			/**
+			\brief The type of a function that destroys the object or frees the block.
+			*/
+			using Function = void(*)(SharedControlBlock*);
+
+			/**
+			\brief The amount of SharedPtr instances.
+			*/
+			COUNT m_strong;
+
+			/**
+			\brief The amount of WeakPtr instances, plus one if there are SharedPtr instances.
+			*/
+			COUNT m_weak;
+
+			/**
+			\brief Destroys the object, but does not free the block.
+			*/
+			Function m_destroy;
+
+			/**
+			\brief Frees the block.
+			*/
+			Function m_free;
+
+			/**
+			\param destroy The function that destroys the object.
+			\param free    The function that frees the block.
+
+			\brief Constructs a new block with a strong and a weak count of one.
+			*/
+			SharedControlBlock(Function destroy, Function free);
+
+			/**
+			\brief Removes a strong reference and destroys the object (and frees the block) if it was the last
+			       one.
+			*/
+			void releaseStrong();
+
+			/**
+			\brief Removes a weak reference and frees the block if it was the last one.
+			*/
+			void releaseWeak();
+		};
+
+		/**
+		\tparam T     The type of the object.
+		\tparam COUNT The reference count policy.
+		\tparam ALLOC The allocation callback that the block was allocated with.
+
+		\brief A control block that contains the object and the allocation callback that it was allocated with.
+		*/
+		template<typename T, typename COUNT, template<typename> class ALLOC>
+		class SharedObjectBlock final : public SharedControlBlock<COUNT>
+		{
+		public:
+			/**
+			\brief The callback that the block was allocated with.
+			*/
+			ALLOC<SharedObjectBlock> m_allocator;
+
+			/**
+			\brief The storage of the object.
+			*/
+			alignas(T) byte m_object[sizeof(T)];
+
+			/**
+			\param allocator The callback that the block was allocated with.
+
+			\brief Constructs a new block. The object is not constructed.
+			*/
+			explicit SharedObjectBlock(const ALLOC<SharedObjectBlock> &allocator);
+
+			/**
+			\return A pointer to the object.
+			*/
+			T* object();
+
+			/**
+			\param block The block.
+
+			\brief Calls the destructor of the object, the implementation of SharedControlBlock::m_destroy.
+			*/
+			static void destroy(SharedControlBlock<COUNT> *block);
+
+			/**
+			\param block The block.
+
+			\brief Deallocates the block, the implementation of SharedControlBlock::m_free.
+			*/
+			static void free(SharedControlBlock<COUNT> *block);
+		};
+	}
+
+	template<typename T, typename COUNT>
+	class SharedPtr;
+
+	template<typename T, typename COUNT>
+	class WeakPtr;
+
+	/**
+	\tparam T     The type of the object.
+	\tparam COUNT The reference count policy.
+	\tparam ALLOC The allocation callback (this is usually deduced).
+	\tparam ARGS  The types of the arguments of the constructor of the object.
+
+	\param allocator The callback to allocate the memory with. The memory is allocated by a callback for a
+	                 different type that is constructed using rebindAllocationCallback().
+	\param args      The arguments of the constructor of the object.
+
+	\return A pointer to the new object, or a null pointer if the allocation failed.
+
+	\brief Constructs an object that is owned by a SharedPtr.
+
+	\details
+	Constructs an object that is owned by a SharedPtr. The object and the reference counts are allocated in
+	a single block of memory.
+
+	If the allocation fails, an error with the code nostra::utils::core::ErrorCodes::BAD_ALLOCATION is pushed
+	to the error handler.
+	*/
+	template<typename T, typename COUNT = AtomicRefCount, template<typename> class ALLOC, typename... ARGS>
+	SharedPtr<T, COUNT> allocateShared(const ALLOC<T> &allocator, ARGS&&... args);
+
+	/**
+	\tparam T     The type of the object.
+	\tparam COUNT The reference count policy.
+	\tparam ALLOC The allocation callback.
+	\tparam ARGS  The types of the arguments of the constructor of the object.
+
+	\param args The arguments of the constructor of the object.
+
+	\return A pointer to the new object, or a null pointer if the allocation failed.
+
+	\brief Constructs an object that is owned by a SharedPtr, the same as allocateShared() with a default
+	       constructed callback.
+	*/
+	template<typename T, typename COUNT = AtomicRefCount,
+		template<typename> class ALLOC = GenericAllocationCallback, typename... ARGS>
+	SharedPtr<T, COUNT> makeShared(ARGS&&... args);
+
+	/**
+	\tparam T     The type of the object that the pointer points to.
+	\tparam COUNT The reference count policy, AtomicRefCount or PlainRefCount.
+
+	\brief A smart pointer that shares the ownership of an object with other instances.
+
+	\details
+	A smart pointer that shares the ownership of an object with other instances. The object is destroyed when
+	the last SharedPtr that points to it is destroyed. Objects are constructed using makeShared() or
+	allocateShared(), which allocate the object together with the reference counts.
+
+	A pointer can be converted to a pointer to a base class of \p T, both pointers share the same reference
+	count.
+
+	Unlike UniquePtr, this class is not a child class of SmartPtrTempl. A SharedPtr consists of only two
+	pointers and can be copied without any virtual function calls.
+
+	\note
+	With PlainRefCount, all pointers that point to the same object must only be used by a single thread at a
+	time.
+	*/
+	template<typename T, typename COUNT = AtomicRefCount>
+	class SharedPtr final
+	{
+		template<typename U, typename C>
+		friend class SharedPtr;
+
+		template<typename U, typename C>
+		friend class WeakPtr;
+
+		template<typename U, typename C, template<typename> class A, typename... ARGS>
+		friend SharedPtr<U, C> allocateShared(const A<U> &allocator, ARGS&&... args);
+
+	public:
+		/**
+		\brief The type of the object that the pointer points to.
+		*/
+		using Type = T;
+
+		/**
+		\brief The reference count policy.
+		*/
+		using Count = COUNT;
+
+	private:
+		/**
+		\brief The object.
+		*/
+		Type *m_ptr;
+
+		/**
+		\brief The control block, or \p nullptr if the pointer is null.
+		*/
+		internal::SharedControlBlock<COUNT> *m_block;
+
+		/**
+		\param ptr   The object.
+		\param block The control block. This pointer takes ownership of one strong reference.
+
+		\brief Constructs a new pointer without modifying the reference counts.
+		*/
+		SharedPtr(Type *ptr, internal::SharedControlBlock<COUNT> *block);
+
+	public:
+		/**
+		\brief Constructs a null pointer.
+		*/
+		SharedPtr();
+
+		/**
+		\brief Constructs a null pointer.
+		*/
+		SharedPtr(std::nullptr_t);
+
+		/**
+		\param other The pointer to copy.
+
+		\brief Constructs a new pointer that shares the ownership with \p other.
+		*/
+		SharedPtr(const SharedPtr &other);
+
+		/**
+		\param other The pointer to move.
+
+		\brief Takes over the ownership from \p other, which will be a null pointer afterwards.
+		*/
+		SharedPtr(SharedPtr &&other);
+
+		/**
+		\tparam U The type of the object of \p other, <tt>U*</tt> must be convertible to <tt>T*</tt>.
+
+		\param other The pointer to copy.
+
+		\brief Constructs a new pointer that shares the ownership with \p other.
+		*/
+		template<typename U>
+		SharedPtr(const SharedPtr<U, COUNT> &other);
+
+		/**
+		\tparam U The type of the object of \p other, <tt>U*</tt> must be convertible to <tt>T*</tt>.
+
+		\param other The pointer to move.
+
+		\brief Takes over the ownership from \p other, which will be a null pointer afterwards.
+		*/
+		template<typename U>
+		SharedPtr(SharedPtr<U, COUNT> &&other);
+
+		/**
+		\brief Releases the ownership and destroys the object if this was the last SharedPtr that pointed to
+		       it.
+		*/
+		~SharedPtr();
+
+		/**
+		\param other The pointer to copy.
+
+		\return A reference to the instance itself.
+
+		\brief Releases the current object and shares the ownership with \p other.
+		*/
+		SharedPtr& operator = (const SharedPtr &other);
+
+		/**
+		\param other The pointer to move.
+
+		\return A reference to the instance itself.
+
+		\brief Releases the current object and takes over the ownership from \p other.
+		*/
+		SharedPtr& operator = (SharedPtr &&other);
+
+		/**
+		\brief Releases the current object, the pointer will be a null pointer afterwards.
+		*/
+		void reset();
+
+		/**
+		\return The raw pointer.
+
+		\brief Returns the pointer to the object.
+		*/
+		Type* rawPtr() const;
+
+		/**
+		\return The amount of SharedPtr instances that share the ownership of the object, or 0 if the pointer
+		        is null.
+		*/
+		uint32 useCount() const;
+
+		/**
+		\return rawPtr()
+		*/
+		Type* operator -> () const;
+
+		/**
+		\return *(rawPtr())
+		*/
+		Type& operator * () const;
+
+		/**
+		\return True, if the pointer is not null, false if it is.
+		*/
+		operator boolean () const;
+
+		/**
+		\return rawPtr() == other.rawPtr()
+		*/
+		template<typename U>
+		boolean operator == (const SharedPtr<U, COUNT> &other) const;
+
+		/**
+		\return rawPtr() != other.rawPtr()
+		*/
+		template<typename U>
+		boolean operator != (const SharedPtr<U, COUNT> &other) const;
+	};
+
+	/**
+	\tparam T     The type of the object that the pointer points to.
+	\tparam COUNT The reference count policy, this must be the same as the one of the SharedPtr instances.
+
+	\brief A pointer to an object that is owned by SharedPtr instances, that does not keep the object alive.
+
+	\details
+	A pointer to an object that is owned by SharedPtr instances, that does not keep the object alive. The
+	object can only be accessed by obtaining a SharedPtr using lock(). WeakPtr instances can be used to break
+	reference cycles.
+
+	The memory of the object (which is allocated together with the reference counts) is released when the
+	last SharedPtr and the last WeakPtr have been destroyed.
+	*/
+	template<typename T, typename COUNT = AtomicRefCount>
+	class WeakPtr final
+	{
+		template<typename U, typename C>
+		friend class WeakPtr;
+
+	public:
+		/**
+		\brief The type of the object that the pointer points to.
+		*/
+		using Type = T;
+
+	private:
+		/**
+		\brief The object. Only valid as long as the strong count is not zero.
+		*/
+		Type *m_ptr;
+
+		/**
+		\brief The control block, or \p nullptr if the pointer is null.
+		*/
+		internal::SharedControlBlock<COUNT> *m_block;
+
+	public:
+		/**
+		\brief Constructs a null pointer.
+		*/
+		WeakPtr();
+
+		/**
+		\tparam U The type of the object of \p other, <tt>U*</tt> must be convertible to <tt>T*</tt>.
+
+		\param shared The pointer to the object.
+
+		\brief Constructs a new weak pointer to the object of \p shared.
+		*/
+		template<typename U>
+		WeakPtr(const SharedPtr<U, COUNT> &shared);
+
+		/**
+		\param other The pointer to copy.
+
+		\brief Constructs a new weak pointer to the same object as \p other.
+		*/
+		WeakPtr(const WeakPtr &other);
+
+		/**
+		\param other The pointer to move.
+
+		\brief Takes over the reference of \p other, which will be a null pointer afterwards.
+		*/
+		WeakPtr(WeakPtr &&other);
+
+		/**
+		\brief Releases the reference to the control block.
+		*/
+		~WeakPtr();
+
+		/**
+		\param other The pointer to copy.
+
+		\return A reference to the instance itself.
+
+		\brief Releases the current reference and refers to the same object as \p other.
+		*/
+		WeakPtr& operator = (const WeakPtr &other);
+
+		/**
+		\param other The pointer to move.
+
+		\return A reference to the instance itself.
+
+		\brief Releases the current reference and takes over the reference of \p other.
+		*/
+		WeakPtr& operator = (WeakPtr &&other);
+
+		/**
+		\brief Releases the current reference, the pointer will be a null pointer afterwards.
+		*/
+		void reset();
+
+		/**
+		\return A pointer that shares the ownership of the object, or a null pointer if the object has already
+		        been destroyed.
+
+		\brief Obtains a SharedPtr to the object.
+		*/
+		SharedPtr<T, COUNT> lock() const;
+
+		/**
+		\return True, if the object has been destroyed (or the pointer is null), false if not.
+		*/
+		boolean expired() const;
+
+		/**
+		\return The amount of SharedPtr instances that share the ownership of the object.
+		*/
+		uint32 useCount() const;
+	};
+
+	/**
+	\tparam COUNT The reference count policy, AtomicRefCount or PlainRefCount.
+
+	\brief A base class for types whose reference count is stored in the objects themselves, to be used with
+	       IntrusivePtr.
+
+	\details
+	A base class for types whose reference count is stored in the objects themselves, to be used with
+	IntrusivePtr. Copying an object does not copy its count.
+
+	Types do not need to inherit from this class, IntrusivePtr only requires the member functions
+	addReference(), releaseReference() and referenceCount().
+	*/
+	template<typename COUNT = AtomicRefCount>
+	class RefCounted
+	{
+	private:
+		/**
+		\brief The count.
+		*/
+		mutable COUNT m_references;
+
+	protected:
+		/**
+		\brief Constructs a new instance with a count of zero.
+		*/
+		RefCounted();
+
+		/**
+		\brief Constructs a new instance with a count of zero, the count of the other instance is not copied.
+		*/
+		RefCounted(const RefCounted&);
+
+		/**
+		\return A reference to the instance itself.
+
+		\brief Does nothing, the count of the other instance is not copied.
+		*/
+		RefCounted& operator = (const RefCounted&);
+
+		~RefCounted() = default;
+
+	public:
+		/**
+		\brief Increments the count.
+		*/
+		void addReference() const;
+
+		/**
+		\return True, if this was the last reference, false if not.
+
+		\brief Decrements the count.
+		*/
+		boolean releaseReference() const;
+
+		/**
+		\return The count.
+		*/
+		uint32 referenceCount() const;
+	};
+
+	/**
+	\tparam T       The type of the object, see RefCounted for the requirements.
+	\tparam DELETER The type of the deleter that is called when the last reference is released. See
+	                nostra::utils::mem_mngt::ManagedPtrTemplate for the requirements that such a deleter must
+	                obey.
+
+	\brief A smart pointer to an object that stores its own reference count.
+
+	\details
+	A smart pointer to an object that stores its own reference count. Compared to SharedPtr, no control block
+	is needed, an IntrusivePtr can be constructed from a raw pointer at any time (e.g. from \p this) and it
+	consists of the object pointer and the deleter only. There is no weak pointer for intrusive counts.
+	*/
+	template<typename T, typename DELETER = DeleterFunc<T>>
+	class IntrusivePtr final
+	{
+	public:
+		/**
+		\brief The type of the object that the pointer points to.
+		*/
+		using Type = T;
+
+	private:
+		/**
+		\brief The object.
+		*/
+		Type *m_ptr;
+
+		/**
+		\brief The deleter.
+		*/
+		DELETER m_deleter;
+
+	public:
+		/**
+		\param ptr     The object, or \p nullptr.
+		\param deleter The deleter that is called when the last reference is released.
+
+		\brief Constructs a new pointer and adds a reference to the object.
+		*/
+		explicit IntrusivePtr(Type *ptr = nullptr, DELETER deleter = defaultDeleter<T>);
+
+		/**
+		\param other The pointer to copy.
+
+		\brief Constructs a new pointer to the same object as \p other and adds a reference to it.
+		*/
+		IntrusivePtr(const IntrusivePtr &other);
+
+		/**
+		\param other The pointer to move.
+
+		\brief Takes over the reference of \p other, which will be a null pointer afterwards.
+		*/
+		IntrusivePtr(IntrusivePtr &&other);
+
+		/**
+		\brief Releases the reference and calls the deleter if it was the last one.
+		*/
+		~IntrusivePtr();
+
+		/**
+		\param other The pointer to copy.
+
+		\return A reference to the instance itself.
+
+		\brief Releases the current reference and adds one to the object of \p other.
+		*/
+		IntrusivePtr& operator = (const IntrusivePtr &other);
+
+		/**
+		\param other The pointer to move.
+
+		\return A reference to the instance itself.
+
+		\brief Releases the current reference and takes over the reference of \p other.
+		*/
+		IntrusivePtr& operator = (IntrusivePtr &&other);
+
+		/**
+		\brief Releases the current reference, the pointer will be a null pointer afterwards.
+		*/
+		void reset();
+
+		/**
+		\return The raw pointer.
+
+		\brief Returns the pointer to the object.
+		*/
+		Type* rawPtr() const;
+
+		/**
+		\return The deleter.
+
+		\brief Returns the deleter.
+		*/
+		DELETER deleter() const;
+
+		/**
+		\return rawPtr()
+		*/
+		Type* operator -> () const;
+
+		/**
+		\return *(rawPtr())
+		*/
+		Type& operator * () const;
+
+		/**
+		\return True, if the pointer is not null, false if it is.
+		*/
+		operator boolean () const;
+
+		/**
+		\return rawPtr() == other.rawPtr()
+		*/
+		boolean operator == (const IntrusivePtr &other) const;
+
+		/**
+		\return rawPtr() != other.rawPtr()
+		*/
+		boolean operator != (const IntrusivePtr &other) const;
+	};
+
+	///\cond
+
+	inline AtomicRefCount::AtomicRefCount(uint32 count) :
+		m_count(count)
+	{}
+
+	inline void AtomicRefCount::increment()
+	{
+		//a new reference can only be created from an existing one, no ordering is required
+		m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	inline boolean AtomicRefCount::decrement()
+	{
+		//all accesses to the object must happen before it is destroyed by the thread that sees zero
+		return m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+	}
+
+	inline boolean AtomicRefCount::incrementIfNotZero()
+	{
+		uint32 count = m_count.load(std::memory_order_relaxed);
+
+		do
+		{
+			if (count == 0)
+				return false;
+		}
+		while (!m_count.compare_exchange_weak(count, count + 1, std::memory_order_acquire,
+			std::memory_order_relaxed));
+
+		return true;
+	}
+
+	inline uint32 AtomicRefCount::get() const
+	{
+		return m_count.load(std::memory_order_relaxed);
+	}
+
+	inline PlainRefCount::PlainRefCount(uint32 count) :
+		m_count(count)
+	{}
+
+	inline void PlainRefCount::increment()
+	{
+		m_count++;
+	}
+
+	inline boolean PlainRefCount::decrement()
+	{
+		return --m_count == 0;
+	}
+
+	inline boolean PlainRefCount::incrementIfNotZero()
+	{
+		if (m_count == 0)
+			return false;
+
+		m_count++;
+		return true;
+	}
+
+	inline uint32 PlainRefCount::get() const
+	{
+		return m_count;
+	}
+
+	template<typename COUNT>
+	internal::SharedControlBlock<COUNT>::SharedControlBlock(Function destroy, Function free) :
+		m_strong(1),
+		m_weak(1),
+		m_destroy(destroy),
+		m_free(free)
+	{}
+
+	template<typename COUNT>
+	void internal::SharedControlBlock<COUNT>::releaseStrong()
+	{
+		if (m_strong.decrement())
+		{
+			m_destroy(this);
+
+			//the reference that all SharedPtr instances held together
+			releaseWeak();
+		}
+	}
+
+	template<typename COUNT>
+	void internal::SharedControlBlock<COUNT>::releaseWeak()
+	{
+		if (m_weak.decrement())
+			m_free(this);
+	}
+
+	template<typename T, typename COUNT, template<typename> class ALLOC>
+	internal::SharedObjectBlock<T, COUNT, ALLOC>::SharedObjectBlock(const ALLOC<SharedObjectBlock> &allocator) :
+		SharedControlBlock<COUNT>(&SharedObjectBlock::destroy, &SharedObjectBlock::free),
+		m_allocator(allocator)
+	{}
+
+	template<typename T, typename COUNT, template<typename> class ALLOC>
+	T* internal::SharedObjectBlock<T, COUNT, ALLOC>::object()
+	{
+		return std::launder(reinterpret_cast<T*>(m_object));
+	}
+
+	template<typename T, typename COUNT, template<typename> class ALLOC>
+	void internal::SharedObjectBlock<T, COUNT, ALLOC>::destroy(SharedControlBlock<COUNT> *block)
+	{
+		static_cast<SharedObjectBlock*>(block)->object()->~T();
+	}
+
+	template<typename T, typename COUNT, template<typename> class ALLOC>
+	void internal::SharedObjectBlock<T, COUNT, ALLOC>::free(SharedControlBlock<COUNT> *block)
+	{
+		SharedObjectBlock *objectBlock = static_cast<SharedObjectBlock*>(block);
+
+		//the callback must outlive the block that it is stored in
+		ALLOC<SharedObjectBlock> allocator = NOU_CORE::move(objectBlock->m_allocator);
+
+		objectBlock->~SharedObjectBlock();
+		allocator.deallocate(objectBlock);
+	}
+
+	template<typename T, typename COUNT, template<typename> class ALLOC, typename... ARGS>
+	SharedPtr<T, COUNT> allocateShared(const ALLOC<T> &allocator, ARGS&&... args)
+	{
+		using Block = internal::SharedObjectBlock<T, COUNT, ALLOC>;
+
+		ALLOC<Block> blockAllocator = rebindAllocationCallback<ALLOC<Block>>(allocator);
+
+		Block *block = blockAllocator.allocate(1);
+
+		if (block == nullptr)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The allocation failed.");
+
+			return SharedPtr<T, COUNT>();
+		}
+
+		new (block) Block(blockAllocator);
+		new (block->m_object) T(NOU_CORE::forward<ARGS>(args)...);
+
+		return SharedPtr<T, COUNT>(block->object(), block);
+	}
+
+	template<typename T, typename COUNT, template<typename> class ALLOC, typename... ARGS>
+	SharedPtr<T, COUNT> makeShared(ARGS&&... args)
+	{
+		return allocateShared<T, COUNT>(ALLOC<T>(), NOU_CORE::forward<ARGS>(args)...);
+	}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT>::SharedPtr(Type *ptr, internal::SharedControlBlock<COUNT> *block) :
+		m_ptr(ptr),
+		m_block(block)
+	{}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT>::SharedPtr() :
+		m_ptr(nullptr),
+		m_block(nullptr)
+	{}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT>::SharedPtr(std::nullptr_t) :
+		SharedPtr()
+	{}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT>::SharedPtr(const SharedPtr &other) :
+		m_ptr(other.m_ptr),
+		m_block(other.m_block)
+	{
+		if (m_block != nullptr)
+			m_block->m_strong.increment();
+	}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT>::SharedPtr(SharedPtr &&other) :
+		m_ptr(other.m_ptr),
+		m_block(other.m_block)
+	{
+		other.m_ptr = nullptr;
+		other.m_block = nullptr;
+	}
+
+	template<typename T, typename COUNT>
+	template<typename U>
+	SharedPtr<T, COUNT>::SharedPtr(const SharedPtr<U, COUNT> &other) :
+		m_ptr(other.m_ptr),
+		m_block(other.m_block)
+	{
+		if (m_block != nullptr)
+			m_block->m_strong.increment();
+	}
+
+	template<typename T, typename COUNT>
+	template<typename U>
+	SharedPtr<T, COUNT>::SharedPtr(SharedPtr<U, COUNT> &&other) :
+		m_ptr(other.m_ptr),
+		m_block(other.m_block)
+	{
+		other.m_ptr = nullptr;
+		other.m_block = nullptr;
+	}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT>::~SharedPtr()
+	{
+		if (m_block != nullptr)
+			m_block->releaseStrong();
+	}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT>& SharedPtr<T, COUNT>::operator = (const SharedPtr &other)
+	{
+		//increment first, this handles self assignment
+		if (other.m_block != nullptr)
+			other.m_block->m_strong.increment();
+
+		if (m_block != nullptr)
+			m_block->releaseStrong();
+
+		m_ptr = other.m_ptr;
+		m_block = other.m_block;
+
+		return *this;
+	}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT>& SharedPtr<T, COUNT>::operator = (SharedPtr &&other)
+	{
+		if (this != &other)
+		{
+			if (m_block != nullptr)
+				m_block->releaseStrong();
+
+			m_ptr = other.m_ptr;
+			m_block = other.m_block;
+
+			other.m_ptr = nullptr;
+			other.m_block = nullptr;
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename COUNT>
+	void SharedPtr<T, COUNT>::reset()
+	{
+		if (m_block != nullptr)
+			m_block->releaseStrong();
+
+		m_ptr = nullptr;
+		m_block = nullptr;
+	}
+
+	template<typename T, typename COUNT>
+	typename SharedPtr<T, COUNT>::Type* SharedPtr<T, COUNT>::rawPtr() const
+	{
+		return m_ptr;
+	}
+
+	template<typename T, typename COUNT>
+	uint32 SharedPtr<T, COUNT>::useCount() const
+	{
+		return m_block == nullptr ? 0 : m_block->m_strong.get();
+	}
+
+	template<typename T, typename COUNT>
+	typename SharedPtr<T, COUNT>::Type* SharedPtr<T, COUNT>::operator -> () const
+	{
+		return m_ptr;
+	}
+
+	template<typename T, typename COUNT>
+	typename SharedPtr<T, COUNT>::Type& SharedPtr<T, COUNT>::operator * () const
+	{
+		return *m_ptr;
+	}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT>::operator boolean () const
+	{
+		return m_ptr != nullptr;
+	}
+
+	template<typename T, typename COUNT>
+	template<typename U>
+	boolean SharedPtr<T, COUNT>::operator == (const SharedPtr<U, COUNT> &other) const
+	{
+		return m_ptr == other.rawPtr();
+	}
+
+	template<typename T, typename COUNT>
+	template<typename U>
+	boolean SharedPtr<T, COUNT>::operator != (const SharedPtr<U, COUNT> &other) const
+	{
+		return m_ptr != other.rawPtr();
+	}
+
+	template<typename T, typename COUNT>
+	WeakPtr<T, COUNT>::WeakPtr() :
+		m_ptr(nullptr),
+		m_block(nullptr)
+	{}
+
+	template<typename T, typename COUNT>
+	template<typename U>
+	WeakPtr<T, COUNT>::WeakPtr(const SharedPtr<U, COUNT> &shared) :
+		m_ptr(shared.m_ptr),
+		m_block(shared.m_block)
+	{
+		if (m_block != nullptr)
+			m_block->m_weak.increment();
+	}
+
+	template<typename T, typename COUNT>
+	WeakPtr<T, COUNT>::WeakPtr(const WeakPtr &other) :
+		m_ptr(other.m_ptr),
+		m_block(other.m_block)
+	{
+		if (m_block != nullptr)
+			m_block->m_weak.increment();
+	}
+
+	template<typename T, typename COUNT>
+	WeakPtr<T, COUNT>::WeakPtr(WeakPtr &&other) :
+		m_ptr(other.m_ptr),
+		m_block(other.m_block)
+	{
+		other.m_ptr = nullptr;
+		other.m_block = nullptr;
+	}
+
+	template<typename T, typename COUNT>
+	WeakPtr<T, COUNT>::~WeakPtr()
+	{
+		if (m_block != nullptr)
+			m_block->releaseWeak();
+	}
+
+	template<typename T, typename COUNT>
+	WeakPtr<T, COUNT>& WeakPtr<T, COUNT>::operator = (const WeakPtr &other)
+	{
+		if (other.m_block != nullptr)
+			other.m_block->m_weak.increment();
+
+		if (m_block != nullptr)
+			m_block->releaseWeak();
+
+		m_ptr = other.m_ptr;
+		m_block = other.m_block;
+
+		return *this;
+	}
+
+	template<typename T, typename COUNT>
+	WeakPtr<T, COUNT>& WeakPtr<T, COUNT>::operator = (WeakPtr &&other)
+	{
+		if (this != &other)
+		{
+			if (m_block != nullptr)
+				m_block->releaseWeak();
+
+			m_ptr = other.m_ptr;
+			m_block = other.m_block;
+
+			other.m_ptr = nullptr;
+			other.m_block = nullptr;
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename COUNT>
+	void WeakPtr<T, COUNT>::reset()
+	{
+		if (m_block != nullptr)
+			m_block->releaseWeak();
+
+		m_ptr = nullptr;
+		m_block = nullptr;
+	}
+
+	template<typename T, typename COUNT>
+	SharedPtr<T, COUNT> WeakPtr<T, COUNT>::lock() const
+	{
+		if (m_block == nullptr || !m_block->m_strong.incrementIfNotZero())
+			return SharedPtr<T, COUNT>();
+
+		return SharedPtr<T, COUNT>(m_ptr, m_block);
+	}
+
+	template<typename T, typename COUNT>
+	boolean WeakPtr<T, COUNT>::expired() const
+	{
+		return useCount() == 0;
+	}
+
+	template<typename T, typename COUNT>
+	uint32 WeakPtr<T, COUNT>::useCount() const
+	{
+		return m_block == nullptr ? 0 : m_block->m_strong.get();
+	}
+
+	template<typename COUNT>
+	RefCounted<COUNT>::RefCounted() :
+		m_references(0)
+	{}
+
+	template<typename COUNT>
+	RefCounted<COUNT>::RefCounted(const RefCounted&) :
+		m_references(0)
+	{}
+
+	template<typename COUNT>
+	RefCounted<COUNT>& RefCounted<COUNT>::operator = (const RefCounted&)
+	{
+		return *this;
+	}
+
+	template<typename COUNT>
+	void RefCounted<COUNT>::addReference() const
+	{
+		m_references.increment();
+	}
+
+	template<typename COUNT>
+	boolean RefCounted<COUNT>::releaseReference() const
+	{
+		return m_references.decrement();
+	}
+
+	template<typename COUNT>
+	uint32 RefCounted<COUNT>::referenceCount() const
+	{
+		return m_references.get();
+	}
+
+	template<typename T, typename DELETER>
+	IntrusivePtr<T, DELETER>::IntrusivePtr(Type *ptr, DELETER deleter) :
+		m_ptr(ptr),
+		m_deleter(deleter)
+	{
+		if (m_ptr != nullptr)
+			m_ptr->addReference();
+	}
+
+	template<typename T, typename DELETER>
+	IntrusivePtr<T, DELETER>::IntrusivePtr(const IntrusivePtr &other) :
+		m_ptr(other.m_ptr),
+		m_deleter(other.m_deleter)
+	{
+		if (m_ptr != nullptr)
+			m_ptr->addReference();
+	}
+
+	template<typename T, typename DELETER>
+	IntrusivePtr<T, DELETER>::IntrusivePtr(IntrusivePtr &&other) :
+		m_ptr(other.m_ptr),
+		m_deleter(other.m_deleter)
+	{
+		other.m_ptr = nullptr;
+	}
+
+	template<typename T, typename DELETER>
+	IntrusivePtr<T, DELETER>::~IntrusivePtr()
+	{
+		if (m_ptr != nullptr && m_ptr->releaseReference())
+			m_deleter(m_ptr);
+	}
+
+	template<typename T, typename DELETER>
+	IntrusivePtr<T, DELETER>& IntrusivePtr<T, DELETER>::operator = (const IntrusivePtr &other)
+	{
+		//increment first and copy before resetting, this handles self assignment
+		Type *ptr = other.m_ptr;
+		DELETER deleter = other.m_deleter;
+
+		if (ptr != nullptr)
+			ptr->addReference();
+
+		reset();
+
+		m_ptr = ptr;
+		m_deleter = deleter;
+
+		return *this;
+	}
+
+	template<typename T, typename DELETER>
+	IntrusivePtr<T, DELETER>& IntrusivePtr<T, DELETER>::operator = (IntrusivePtr &&other)
+	{
+		if (this != &other)
+		{
+			reset();
+
+			m_ptr = other.m_ptr;
+			m_deleter = other.m_deleter;
+
+			other.m_ptr = nullptr;
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename DELETER>
+	void IntrusivePtr<T, DELETER>::reset()
+	{
+		if (m_ptr != nullptr && m_ptr->releaseReference())
+			m_deleter(m_ptr);
+
+		m_ptr = nullptr;
+	}
+
+	template<typename T, typename DELETER>
+	typename IntrusivePtr<T, DELETER>::Type* IntrusivePtr<T, DELETER>::rawPtr() const
+	{
+		return m_ptr;
+	}
+
+	template<typename T, typename DELETER>
+	DELETER IntrusivePtr<T, DELETER>::deleter() const
+	{
+		return m_deleter;
+	}
+
+	template<typename T, typename DELETER>
+	typename IntrusivePtr<T, DELETER>::Type* IntrusivePtr<T, DELETER>::operator -> () const
+	{
+		return m_ptr;
+	}
+
+	template<typename T, typename DELETER>
+	typename IntrusivePtr<T, DELETER>::Type& IntrusivePtr<T, DELETER>::operator * () const
+	{
+		return *m_ptr;
+	}
+
+	template<typename T, typename DELETER>
+	IntrusivePtr<T, DELETER>::operator boolean () const
+	{
+		return m_ptr != nullptr;
+	}
+
+	template<typename T, typename DELETER>
+	boolean IntrusivePtr<T, DELETER>::operator == (const IntrusivePtr &other) const
+	{
+		return m_ptr == other.m_ptr;
+	}
+
+	template<typename T, typename DELETER>
+	boolean IntrusivePtr<T, DELETER>::operator != (const IntrusivePtr &other) const
+	{
+		return m_ptr != other.m_ptr;
+	}
+
+	///\endcond
+}
+
+#endif
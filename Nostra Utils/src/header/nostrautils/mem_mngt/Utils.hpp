@@ -9,7 +9,7 @@
 \file mem_mngt/Utils.hpp
 
 \author  Lukas Reichmann
-\version 1.0.0
+\version 1.0.1
 \since   1.0.0
 
 \brief A file that contains utility functions that revolve around memory allocation.
@@ -17,6 +17,15 @@
 
 namespace NOU::NOU_MEM_MNGT
 {
+	/**
+	\brief The assumed size of a cache line in bytes.
+
+	\details
+	The assumed size of a cache line in bytes. Data that is frequently written by different threads should be
+	aligned to (or padded to a multiple of) this value to avoid false sharing.
+	*/
+	constexpr sizeType CACHE_LINE_SIZE = 64;
+
 	/**
 	\param bytes     The amount of bytes to allocate.
 	\param alignment The alignment that the allocated memory block should have.
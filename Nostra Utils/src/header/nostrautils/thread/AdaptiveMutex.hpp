@@ -0,0 +1,255 @@
+#ifndef NOU_THREAD_ADAPTIVE_MUTEX_HPP
+#define NOU_THREAD_ADAPTIVE_MUTEX_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/thread/ParkingLot.hpp"
+
+#include <atomic>
+
+/**
+\file thread/AdaptiveMutex.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the mutexes nostra::utils::thread::AdaptiveMutex and
+       nostra::utils::thread::ByteMutex.
+
+\see nostra::utils::thread::AdaptiveMutex
+\see nostra::utils::thread::ByteMutex
+*/
+
+namespace NOU::NOU_THREAD
+{
+	/**
+	\brief A word-sized mutex that spins for a short time before it puts the thread to sleep.
+
+	\details
+	A word-sized mutex that spins for a short time before it puts the thread to sleep. Locking and unlocking a
+	mutex that is not contended only takes a single atomic operation. If the mutex is locked, the thread spins
+	up to SPIN_COUNT times (which is usually enough if the mutex is only held for a very short time) and is
+	then put to sleep using futexWait() (the futex system call on Linux, the ParkingLot on other systems).
+
+	In contrast to Mutex, this mutex can not be used with ConditionVariable, ParkingConditionVariable needs to
+	be used instead.
+	*/
+	class AdaptiveMutex final
+	{
+	public:
+		/**
+		\brief The amount of times that a thread spins before it goes to sleep.
+		*/
+		constexpr static uint32 SPIN_COUNT = 100;
+
+	private:
+		/**
+		\brief The mutex is not locked.
+		*/
+		constexpr static uint32 UNLOCKED = 0;
+
+		/**
+		\brief The mutex is locked and no thread is sleeping.
+		*/
+		constexpr static uint32 LOCKED = 1;
+
+		/**
+		\brief The mutex is locked and there may be threads that are sleeping.
+		*/
+		constexpr static uint32 CONTENDED = 2;
+
+		/**
+		\brief The state of the mutex, one of UNLOCKED, LOCKED and CONTENDED.
+		*/
+		std::atomic<uint32> m_state;
+
+		/**
+		\brief Spins and then sleeps until the mutex has been locked.
+		*/
+		NOU_FUNC void lockSlow();
+
+	public:
+		/**
+		\brief Constructs a new, unlocked mutex.
+		*/
+		constexpr AdaptiveMutex();
+
+		/**
+		\brief Not copy construct-able.
+		*/
+		AdaptiveMutex(const AdaptiveMutex&) = delete;
+
+		/**
+		\brief Not copy assign-able.
+		*/
+		AdaptiveMutex& operator = (const AdaptiveMutex&) = delete;
+
+		/**
+		\brief Locks the mutex.
+		*/
+		void lock();
+
+		/**
+		\brief Unlocks the mutex.
+		*/
+		void unlock();
+
+		/**
+		\return True, if the mutex was locked, false if not (it was already locked in that case).
+
+		\brief If the mutex is unlocked, it will be locked. Otherwise nothing will happen.
+		*/
+		boolean tryLock();
+	};
+
+	/**
+	\brief A mutex that only takes up a single byte.
+
+	\details
+	A mutex that only takes up a single byte, which makes it possible to embed it into data structures where
+	the size matters (e.g. one mutex per bucket or per element). Like AdaptiveMutex, it spins up to SPIN_COUNT
+	times before the thread is put to sleep. The sleeping threads are stored in the ParkingLot.
+
+	This mutex can be used with ParkingConditionVariable.
+	*/
+	class ByteMutex final
+	{
+	public:
+		/**
+		\brief The amount of times that a thread spins before it goes to sleep.
+		*/
+		constexpr static uint32 SPIN_COUNT = 100;
+
+	private:
+		/**
+		\brief The bit that is set if the mutex is locked.
+		*/
+		constexpr static uint8 LOCKED_BIT = 1;
+
+		/**
+		\brief The bit that is set if there may be threads that are parked on the mutex.
+		*/
+		constexpr static uint8 PARKED_BIT = 2;
+
+		/**
+		\brief The state of the mutex, a combination of LOCKED_BIT and PARKED_BIT.
+		*/
+		std::atomic<uint8> m_state;
+
+		/**
+		\brief Spins and then parks until the mutex has been locked.
+		*/
+		NOU_FUNC void lockSlow();
+
+		/**
+		\brief Unlocks the mutex and unparks a thread.
+		*/
+		NOU_FUNC void unlockSlow();
+
+	public:
+		/**
+		\brief Constructs a new, unlocked mutex.
+		*/
+		constexpr ByteMutex();
+
+		/**
+		\brief Not copy construct-able.
+		*/
+		ByteMutex(const ByteMutex&) = delete;
+
+		/**
+		\brief Not copy assign-able.
+		*/
+		ByteMutex& operator = (const ByteMutex&) = delete;
+
+		/**
+		\brief Locks the mutex.
+		*/
+		void lock();
+
+		/**
+		\brief Unlocks the mutex.
+		*/
+		void unlock();
+
+		/**
+		\return True, if the mutex was locked, false if not (it was already locked in that case).
+
+		\brief If the mutex is unlocked, it will be locked. Otherwise nothing will happen.
+		*/
+		boolean tryLock();
+	};
+
+	constexpr AdaptiveMutex::AdaptiveMutex() :
+		m_state(UNLOCKED)
+	{}
+
+	inline void AdaptiveMutex::lock()
+	{
+		uint32 expected = UNLOCKED;
+
+		if (!m_state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire,
+			std::memory_order_relaxed))
+		{
+			lockSlow();
+		}
+	}
+
+	inline void AdaptiveMutex::unlock()
+	{
+		if (m_state.exchange(UNLOCKED, std::memory_order_release) == CONTENDED)
+			futexWake(m_state);
+	}
+
+	inline boolean AdaptiveMutex::tryLock()
+	{
+		uint32 expected = UNLOCKED;
+
+		return m_state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire,
+			std::memory_order_relaxed);
+	}
+
+	constexpr ByteMutex::ByteMutex() :
+		m_state(0)
+	{}
+
+	inline void ByteMutex::lock()
+	{
+		uint8 expected = 0;
+
+		if (!m_state.compare_exchange_strong(expected, LOCKED_BIT, std::memory_order_acquire,
+			std::memory_order_relaxed))
+		{
+			lockSlow();
+		}
+	}
+
+	inline void ByteMutex::unlock()
+	{
+		uint8 expected = LOCKED_BIT;
+
+		if (!m_state.compare_exchange_strong(expected, 0, std::memory_order_release,
+			std::memory_order_relaxed))
+		{
+			unlockSlow();
+		}
+	}
+
+	inline boolean ByteMutex::tryLock()
+	{
+		uint8 state = m_state.load(std::memory_order_relaxed);
+
+		while ((state & LOCKED_BIT) == 0)
+		{
+			if (m_state.compare_exchange_weak(state, state | LOCKED_BIT, std::memory_order_acquire,
+				std::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+#endif
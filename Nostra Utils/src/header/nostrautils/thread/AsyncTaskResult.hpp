@@ -5,6 +5,10 @@
 #include "nostrautils/thread/Task.hpp"
 #include "nostrautils/thread/ThreadManager.hpp"
 #include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/dat_alg/Utils.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
+
+#include <atomic>
 
 /** \file thread\AsyncTaskResult.hpp
 \author	 Lukas Reichmann
@@ -23,7 +27,8 @@ namespace NOU::NOU_THREAD
 	enum class AsyncTaskResultState
 	{
 		/**
-		\brief The task has not been started yet.
+		\brief The task has not been started yet. This includes tasks that are still waiting for other tasks
+		       to finish (see AsyncTaskResult::then(), whenAll() and whenAny()).
 		*/
 		NOT_STARTED,
 
@@ -46,6 +51,57 @@ namespace NOU::NOU_THREAD
 
 	namespace internal
 	{
+		class AbstractAsyncTaskResult;
+
+		/**
+		\brief A function that is called once a task result has finished.
+
+		\see AbstractAsyncTaskResult::addNotification()
+		*/
+		struct AsyncTaskNotification
+		{
+			/**
+			\brief The function to call. The parameters are \p m_context and \p m_index.
+			*/
+			void (*m_function)(void*, sizeType);
+
+			/**
+			\brief The first parameter of \p m_function.
+			*/
+			void *m_context;
+
+			/**
+			\brief The second parameter of \p m_function.
+			*/
+			sizeType m_index;
+		};
+
+		/**
+		\brief The tasks that a task result depends on.
+
+		\details
+		The tasks that a task result depends on. A task result that was constructed with dependencies will 
+		only be pushed to the thread manager once its dependencies have finished execution.
+		*/
+		struct AsyncTaskDependencies
+		{
+			/**
+			\brief The task results that are depended on.
+			*/
+			AbstractAsyncTaskResult *const *m_results;
+
+			/**
+			\brief The amount of elements in \p m_results.
+			*/
+			sizeType m_count;
+
+			/**
+			\brief If true, the task will be pushed once any of the dependencies has finished, if false it will
+			       be pushed once all of them have finished.
+			*/
+			boolean m_any;
+		};
+
 		/**
 		\brief A helper class that implements the functionality of AsyncTaskResult that interfaces with the 
 		       thread manager.
@@ -139,6 +195,51 @@ namespace NOU::NOU_THREAD
 			*/
 			TaskInfo       m_taskInformation;
 
+			/**
+			\brief The functions that will be called once the task has finished (e.g. to notify the task 
+			       results that depend on this one). Protected by \p m_stateMutex.
+			*/
+			NOU_DAT_ALG::Vector<AsyncTaskNotification> m_notifications;
+
+			/**
+			\brief The task results that this one depends on.
+			*/
+			NOU_DAT_ALG::Vector<AbstractAsyncTaskResult*> m_dependencies;
+
+			/**
+			\brief The amount of dependencies that still need to finish before the task is pushed, plus one 
+			       for the construction of the instance itself.
+			*/
+			std::atomic<int64> m_pendingDependencies;
+
+			/**
+			\brief If true, the task is pushed as soon as any dependency has finished.
+			*/
+			boolean m_waitForAny;
+
+			/**
+			\brief The index of the dependency that finished first, or INVALID_INDEX.
+			*/
+			std::atomic<sizeType> m_firstFinishedDependency;
+
+			/**
+			\brief True, once the task has been pushed to the thread manager.
+			*/
+			std::atomic<boolean> m_pushed;
+
+			/**
+			\brief True, if the thread manager does not reference \p m_executionTask (anymore). This is the 
+			       case if the task has not been pushed yet, if it has been removed from the thread manager or
+			       if executeTask() has returned.
+			*/
+			std::atomic<boolean> m_released;
+
+			/**
+			\brief The amount of dependencies that have finished calling notifyDependent() for this instance 
+			       (or that had already finished when this instance was constructed).
+			*/
+			std::atomic<sizeType> m_finishedNotifications;
+
 			/**
 			\param state The new state.
 			
@@ -146,6 +247,40 @@ namespace NOU::NOU_THREAD
 			*/
 			NOU_FUNC void setState(State state);
 
+			/**
+			\brief Sets the state to State::DONE and notifies all dependents.
+			*/
+			NOU_FUNC void complete();
+
+			/**
+			\param dependent The task result that depends on the one that has finished.
+			\param index     The index of the finished task result in the dependencies of \p dependent.
+
+			\brief The function of the notifications that are used for dependent task results. Calls 
+			       dependencyDone() on \p dependent.
+
+			\details
+			The function of the notifications that are used for dependent task results. Calls dependencyDone() 
+			on \p dependent. After dependencyDone() has returned, \p m_finishedNotifications of \p dependent is
+			incremented, this is the last access to \p dependent.
+			*/
+			NOU_FUNC static void notifyDependent(void *dependent, sizeType index);
+
+			/**
+			\param index The index of the dependency that has finished.
+
+			\brief Called when a dependency has finished. Pushes the task once the last required dependency
+			       has finished.
+			*/
+			NOU_FUNC void dependencyDone(sizeType index);
+
+		public:
+			/**
+			\brief The value that is returned by getFirstFinishedDependency() if no dependency has finished
+			       yet.
+			*/
+			constexpr static sizeType INVALID_INDEX = -1;
+
 		protected:
 			/**
 			\param task The task to execute.
@@ -154,6 +289,15 @@ namespace NOU::NOU_THREAD
 			*/
 			NOU_FUNC AbstractAsyncTaskResult(AbstractTask *task);
 
+			/**
+			\param task         The task to execute.
+			\param dependencies The task results that need to finish before the task is pushed.
+
+			\brief Constructs a new instance with the passed task that will be pushed to the thread manager
+			       once its dependencies have finished.
+			*/
+			NOU_FUNC AbstractAsyncTaskResult(AbstractTask *task, const AsyncTaskDependencies &dependencies);
+
 			/**
 			\brief Pushes the task to the thread manager.
 
@@ -164,6 +308,31 @@ namespace NOU::NOU_THREAD
 			*/
 			NOU_FUNC void push();
 
+			/**
+			\brief Pushes the task to the thread manager as soon as its dependencies have finished.
+
+			\details
+			Pushes the task to the thread manager as soon as its dependencies have finished. This is the 
+			counterpart of push() for instances that were constructed with dependencies and it also must be 
+			manually executed by any inheriting classes.
+			*/
+			NOU_FUNC void pushAfterDependencies();
+
+			/**
+			\brief Waits until the thread manager does not reference the task anymore. If the task has not been
+			       started yet, it is removed from the thread manager.
+
+			\details
+			Waits until the thread manager does not reference the task anymore. If the task has not been
+			started yet, it is removed from the thread manager. This method must be called by the destructor 
+			of inheriting classes, before their members are destroyed.
+
+			If not all dependencies have notified this instance yet, the notifications are removed from the 
+			dependencies that have not finished yet and the method waits for the notifications that are 
+			currently being called. Afterwards, the task can not be pushed by a dependency anymore.
+			*/
+			NOU_FUNC void waitForRelease();
+
 		public:
 			/**
 			\return The state of the task.
@@ -183,6 +352,42 @@ namespace NOU::NOU_THREAD
 			*/
 			NOU_FUNC void makeResult();
 
+			/**
+			\return The index of the dependency that finished first, or INVALID_INDEX.
+
+			\brief Returns the index of the dependency that finished first. This is mostly useful for the 
+			       results of whenAny(). If the instance was constructed without dependencies, INVALID_INDEX 
+			       is returned.
+			*/
+			NOU_FUNC sizeType getFirstFinishedDependency() const;
+
+			/**
+			\param notification The notification.
+
+			\return True, if the notification will be called once the task has finished, false if the task 
+			        has already finished (in that case, the notification will not be called).
+
+			\brief Registers a function that will be called by the thread that finishes the task.
+
+			\warning
+			This method is supposed to be used a sort of a "back end" for functionality (like then() or 
+			coroutines that wait for a task). The function is called before the execution of the task has fully
+			finished, it must not call makeResult() (or getResult()) of this task result.
+			*/
+			NOU_FUNC boolean addNotification(const AsyncTaskNotification &notification);
+
+			/**
+			\param notification The notification to remove. It is compared to the registered ones by all of its
+			                    members.
+
+			\return True, if the notification was removed, false if it was not registered or if the task has 
+			        already finished (in that case, the notification has already been called or is being called 
+			        right now).
+
+			\brief Removes a notification that was registered using addNotification() before it is called.
+			*/
+			NOU_FUNC boolean removeNotification(const AsyncTaskNotification &notification);
+
 			/**
 			\brief Not copy construct-able.
 			*/
@@ -204,8 +409,12 @@ namespace NOU::NOU_THREAD
 	\brief A class that allows to push single tasks to the thread manager.
 
 	\details
-	A class that allows to push single tasks to the thread manager. This class only allows to push single
-	tasks, different instances of AsyncTaskResult are not connected.
+	A class that allows to push single tasks to the thread manager. 
+
+	Instances can be connected using then(), whenAll() and whenAny(). The resulting task results will be 
+	pushed to the thread manager once the results that they depend on have finished, no thread is blocked 
+	while waiting for them. A task result that others depend on must not be destroyed before the dependent 
+	results have finished.
 
 	Each instance of AsyncTaskResult will get its own error handler provided by the thread manager.
 	*/
@@ -252,6 +461,45 @@ namespace NOU::NOU_THREAD
 		*/
 		explicit AsyncTaskResult(I &&invocable, ARGS&&... args);
 
+		/**
+		\brief Waits until the task is not being executed by another thread anymore. If the task has not been
+		       started yet, it will not be executed anymore.
+		*/
+		~AsyncTaskResult();
+
+		/**
+		\param task         The task to execute.
+		\param dependencies The task results that need to finish before the task is pushed.
+
+		\brief Constructs a new instance with the passed task that will be pushed to the thread manager once 
+		       its dependencies have finished. This constructor is used by then(), whenAll() and whenAny().
+		*/
+		AsyncTaskResult(TaskType &&task, const internal::AsyncTaskDependencies &dependencies);
+
+		/**
+		\tparam F The type of the continuation.
+
+		\param continuation The continuation. It will be called with the result of this task (as a const 
+		                    reference).
+
+		\return The task result of the continuation.
+
+		\brief Schedules a continuation that will be pushed to the thread manager once this task has 
+		       finished.
+
+		\details
+		Schedules a continuation that will be pushed to the thread manager once this task has finished. No 
+		thread is blocked while the continuation waits for this task. Calling getResult() on the returned 
+		task result is also possible, in that case the calling thread will execute this task (if it has not 
+		been started yet) and the continuation.
+
+		This task result must not be destroyed before the continuation has finished. The continuation on the 
+		other hand may be destroyed at any time, if this task has not finished by then, the continuation will 
+		not be executed.
+		*/
+		template<typename F>
+		[[nodiscard]] auto then(F &&continuation);
+
 		/**
 		\return The value that was produced by the task.
 
@@ -300,6 +548,11 @@ namespace NOU::NOU_THREAD
 		explicit AsyncTaskResult(const TaskType &task);
 		explicit AsyncTaskResult(TaskType &&task);
 		explicit AsyncTaskResult(I &&invocable, ARGS&&... args);
+		AsyncTaskResult(TaskType &&task, const internal::AsyncTaskDependencies &dependencies);
+		~AsyncTaskResult();
+
+		template<typename F>
+		[[nodiscard]] auto then(F &&continuation);
 
 		void getResult();
 
@@ -308,6 +561,79 @@ namespace NOU::NOU_THREAD
 	};
 	///\endcond
 
+	/**
+	\brief The type of the task results that are returned by whenAll() and whenAny(). Their task does nothing,
+	       it only finishes once the dependencies have finished.
+	*/
+	using AsyncTaskGroupResult = AsyncTaskResult<void, void(*)()>;
+
+	/**
+	\param results The task results to wait for.
+
+	\return A task result that finishes once all of \p results have finished.
+
+	\brief Returns a task result that finishes once all of the passed task results have finished.
+
+	\details
+	Returns a task result that finishes once all of the passed task results have finished. No thread is 
+	blocked while waiting. Continuations can be added to the returned task result using then().
+
+	The passed task results must not be destroyed before the returned one has finished.
+	*/
+	[[nodiscard]] NOU_FUNC AsyncTaskGroupResult whenAll(
+		const NOU_DAT_ALG::Vector<internal::AbstractAsyncTaskResult*> &results);
+
+	/**
+	\param results The task results to wait for.
+
+	\return A task result that finishes once any of \p results has finished.
+
+	\brief Returns a task result that finishes once any of the passed task results has finished.
+
+	\details
+	Returns a task result that finishes once any of the passed task results has finished. The index of the 
+	task result that finished first can be queried using 
+	internal::AbstractAsyncTaskResult::getFirstFinishedDependency() on the returned task result. No thread is 
+	blocked while waiting. Continuations can be added to the returned task result using then().
+
+	The passed task results must not be destroyed before all of them have finished.
+	*/
+	[[nodiscard]] NOU_FUNC AsyncTaskGroupResult whenAny(
+		const NOU_DAT_ALG::Vector<internal::AbstractAsyncTaskResult*> &results);
+
+	/**
+	\tparam RESULTS The types of the task results.
+
+	\param results The task results to wait for.
+
+	\return A task result that finishes once all of \p results have finished.
+
+	\brief A convenience overload of whenAll() that accepts the task results directly.
+	*/
+	template<typename... RESULTS, typename = std::enable_if_t<(sizeof...(RESULTS) > 0) &&
+		(std::is_base_of<internal::AbstractAsyncTaskResult, RESULTS>::value && ...)>>
+	[[nodiscard]] AsyncTaskGroupResult whenAll(RESULTS&... results);
+
+	/**
+	\tparam RESULTS The types of the task results.
+
+	\param results The task results to wait for.
+
+	\return A task result that finishes once any of \p results has finished.
+
+	\brief A convenience overload of whenAny() that accepts the task results directly.
+	*/
+	template<typename... RESULTS, typename = std::enable_if_t<(sizeof...(RESULTS) > 0) &&
+		(std::is_base_of<internal::AbstractAsyncTaskResult, RESULTS>::value && ...)>>
+	[[nodiscard]] AsyncTaskGroupResult whenAny(RESULTS&... results);
+
+	namespace internal
+	{
+		/**
+		\brief The task of the task results that are returned by whenAll() and whenAny().
+		*/
+		NOU_FUNC void finishTaskGroup();
+	}
 
 	template<typename R, typename I, typename... ARGS>
 	AsyncTaskResult<R, I, ARGS...>::AsyncTaskResult(const TaskType &task) :
@@ -330,6 +656,38 @@ namespace NOU::NOU_THREAD
 		AsyncTaskResult(makeTask(NOU_CORE::forward<I>(invocable), NOU_CORE::forward<ARGS>(args)...))
 	{}
 
+	template<typename R, typename I, typename... ARGS>
+	AsyncTaskResult<R, I, ARGS...>::AsyncTaskResult(TaskType &&task, 
+		const internal::AsyncTaskDependencies &dependencies) :
+		AbstractAsyncTaskResult(&m_task, dependencies),
+		m_task(NOU_CORE::move(task))
+	{
+		pushAfterDependencies();
+	}
+
+	template<typename R, typename I, typename... ARGS>
+	AsyncTaskResult<R, I, ARGS...>::~AsyncTaskResult()
+	{
+		waitForRelease();
+	}
+
+	template<typename R, typename I, typename... ARGS>
+	template<typename F>
+	auto AsyncTaskResult<R, I, ARGS...>::then(F &&continuation)
+	{
+		auto invocable = [this, continuation = NOU_CORE::forward<F>(continuation)]() mutable
+		{
+			const R &result = m_task.getResult();
+
+			return continuation(result);
+		};
+
+		internal::AbstractAsyncTaskResult *dependency = this;
+
+		return AsyncTaskResult<NOU_CORE::InvokeResult_t<decltype(invocable)>, decltype(invocable)>(
+			makeTask(NOU_CORE::move(invocable)), internal::AsyncTaskDependencies{ &dependency, 1, false });
+	}
+
 	template<typename R, typename I, typename... ARGS>
 	const R& AsyncTaskResult<R, I, ARGS...>::getResult()
 	{
@@ -361,11 +719,59 @@ namespace NOU::NOU_THREAD
 		AsyncTaskResult(makeTask(NOU_CORE::forward<I>(invocable), NOU_CORE::forward<ARGS>(args)...))
 	{}
 
+	template<typename I, typename... ARGS>
+	AsyncTaskResult<void, I, ARGS...>::AsyncTaskResult(TaskType &&task, 
+		const internal::AsyncTaskDependencies &dependencies) :
+		AbstractAsyncTaskResult(&m_task, dependencies),
+		m_task(NOU_CORE::move(task))
+	{
+		pushAfterDependencies();
+	}
+
+	template<typename I, typename... ARGS>
+	AsyncTaskResult<void, I, ARGS...>::~AsyncTaskResult()
+	{
+		waitForRelease();
+	}
+
+	template<typename I, typename... ARGS>
+	template<typename F>
+	auto AsyncTaskResult<void, I, ARGS...>::then(F &&continuation)
+	{
+		auto invocable = [continuation = NOU_CORE::forward<F>(continuation)]() mutable
+		{
+			return continuation();
+		};
+
+		internal::AbstractAsyncTaskResult *dependency = this;
+
+		return AsyncTaskResult<NOU_CORE::InvokeResult_t<decltype(invocable)>, decltype(invocable)>(
+			makeTask(NOU_CORE::move(invocable)), internal::AsyncTaskDependencies{ &dependency, 1, false });
+	}
+
 	template<typename I, typename... ARGS>
 	void AsyncTaskResult<void, I, ARGS...>::getResult()
 	{
 		makeResult();
 	}
+
+	template<typename... RESULTS, typename>
+	AsyncTaskGroupResult whenAll(RESULTS&... results)
+	{
+		internal::AbstractAsyncTaskResult *dependencies[] = { &results... };
+
+		return AsyncTaskGroupResult(makeTask(&internal::finishTaskGroup),
+			internal::AsyncTaskDependencies{ dependencies, sizeof...(RESULTS), false });
+	}
+
+	template<typename... RESULTS, typename>
+	AsyncTaskGroupResult whenAny(RESULTS&... results)
+	{
+		internal::AbstractAsyncTaskResult *dependencies[] = { &results... };
+
+		return AsyncTaskGroupResult(makeTask(&internal::finishTaskGroup),
+			internal::AsyncTaskDependencies{ dependencies, sizeof...(RESULTS), true });
+	}
 }
 
 #endif
\ No newline at end of file
@@ -59,6 +59,16 @@ namespace NOU::NOU_THREAD
 		*/
 		NOU_FUNC void wait(UniqueLock &lock);
 
+		/**
+		\param lock        The lock that will be used to lock the waiting thread.
+		\param nanoseconds The maximum amount of nanoseconds to wait.
+
+		\return False, if the wait timed out, true if not.
+
+		\brief Waits until the variable is notified or until \p nanoseconds have passed.
+		*/
+		NOU_FUNC boolean waitFor(UniqueLock &lock, uint64 nanoseconds);
+
 		/**
 		\tparam PRED The type of the predicate.
 
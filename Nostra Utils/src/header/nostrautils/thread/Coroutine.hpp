@@ -0,0 +1,896 @@
+#ifndef NOU_THREAD_COROUTINE_HPP
+#define NOU_THREAD_COROUTINE_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Assertions.hpp"
+#include "nostrautils/dat_alg/Uninitialized.hpp"
+#include "nostrautils/thread/Task.hpp"
+#include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/thread/ConditionVariable.hpp"
+#include "nostrautils/thread/AsyncTaskResult.hpp"
+
+/** \file thread\Coroutine.hpp
+\author	 Lukas Reichmann
+\since   1.0.1
+\version 1.0.1
+\brief   This file provides the coroutine task type Co.
+
+\see nostra::utils::thread::Co
+*/
+
+/**
+\brief This macro is defined if coroutines are available.
+
+\details
+This macro is defined if coroutines are available. Coroutines require C++20, which is why they need to be
+enabled explicitly using the CMake option NOU_ENABLE_COROUTINES (which defines the macro of the same name and
+raises the language level to C++20).
+*/
+#if (defined(NOU_ENABLE_COROUTINES) && defined(__cpp_impl_coroutine)) || NOU_COMPILER == NOU_COMPILER_DOXYGEN
+#define NOU_EXISTS_FEATURE_COROUTINES
+#endif
+
+#ifdef NOU_EXISTS_FEATURE_COROUTINES
+
+#include <coroutine>
+
+namespace NOU::NOU_THREAD
+{
+	template<typename T = void>
+	class Co;
+
+	namespace internal
+	{
+		/**
+		\param size The size of the frame.
+
+		\return The frame, or \p nullptr if the allocation failed.
+
+		\brief Allocates the frame of a coroutine. Small frames are taken from a pool of equally sized blocks.
+		*/
+		NOU_FUNC void* allocateCoroutineFrame(sizeType size);
+
+		/**
+		\param frame The frame.
+		\param size  The size of the frame, this must be the same size that was passed to
+		             allocateCoroutineFrame().
+
+		\brief Deallocates a frame that was allocated by allocateCoroutineFrame().
+		*/
+		NOU_FUNC void deallocateCoroutineFrame(void *frame, sizeType size);
+
+		/**
+		\brief A task that resumes a suspended coroutine.
+
+		\details
+		A task that resumes a suspended coroutine. This is the task that is pushed to the thread manager if a
+		coroutine should continue on a worker thread.
+
+		Since a coroutine can only be suspended at a single point at the same time, the task is usually a
+		member of the object that is awaited.
+		*/
+		class CoroutineResumeTask final : public AbstractTask
+		{
+		private:
+			/**
+			\brief The coroutine to resume.
+			*/
+			std::coroutine_handle<> m_handle;
+
+		public:
+			/**
+			\param handle The coroutine to resume.
+
+			\brief Sets the coroutine that will be resumed by execute().
+			*/
+			NOU_FUNC void setHandle(std::coroutine_handle<> handle);
+
+			/**
+			\brief Resumes the coroutine.
+
+			\note
+			The task may be destroyed by the coroutine, which is why it will not be accessed after the coroutine
+			has been resumed.
+			*/
+			NOU_FUNC virtual void execute() override;
+		};
+
+		/**
+		\param task The task.
+
+		\brief Pushes a task that resumes a coroutine to the thread manager.
+		*/
+		NOU_FUNC void pushCoroutine(CoroutineResumeTask *task);
+
+		/**
+		\param task         The task.
+		\param milliseconds The amount of milliseconds to wait before the task will be pushed.
+
+		\brief Pushes a task that resumes a coroutine to the thread manager after a delay.
+
+		\details
+		Pushes a task that resumes a coroutine to the thread manager after a delay. The delays of all
+		coroutines are handled by a single timer thread that is started by the first call to this function.
+		*/
+		NOU_FUNC void pushCoroutineDelayed(CoroutineResumeTask *task, uint64 milliseconds);
+
+		/**
+		\param task  The task, as a pointer to CoroutineResumeTask.
+		\param index Ignored.
+
+		\brief A notification function for AbstractAsyncTaskResult::addNotification() that pushes the passed
+		       task using pushCoroutine().
+		*/
+		NOU_FUNC void pushCoroutineNotification(void *task, sizeType index);
+
+		/**
+		\brief Blocks a thread that waits for a coroutine until the coroutine has finished.
+
+		\details
+		Blocks a thread that waits for a coroutine until the coroutine has finished. The waiter lives on the
+		stack of the waiting thread, which allows the waiting thread to destroy the coroutine as soon as
+		wait() returns.
+		*/
+		class CoroutineWaiter final
+		{
+		private:
+			/**
+			\brief The mutex that protects \p m_done.
+			*/
+			Mutex m_mutex;
+
+			/**
+			\brief The variable that the waiting thread waits on.
+			*/
+			ConditionVariable m_variable;
+
+			/**
+			\brief True, if the coroutine has finished.
+			*/
+			boolean m_done;
+
+		public:
+			/**
+			\brief Constructs a new waiter.
+			*/
+			NOU_FUNC CoroutineWaiter();
+
+			/**
+			\brief Wakes up the waiting thread.
+			*/
+			NOU_FUNC void notify();
+
+			/**
+			\brief Blocks until notify() has been called.
+			*/
+			NOU_FUNC void wait();
+		};
+
+		/**
+		\brief The part of the promise type of Co that does not depend on the result type.
+		*/
+		class CoroutinePromiseBase
+		{
+		private:
+			/**
+			\brief The coroutine that awaits this one, or a null handle if there is none.
+			*/
+			std::coroutine_handle<> m_continuation;
+
+			/**
+			\brief The thread that waits for this coroutine in Co::getResult(), or \p nullptr if there is
+			       none.
+			*/
+			CoroutineWaiter *m_waiter;
+
+			/**
+			\brief True, if the coroutine has been passed to spawn() and destroys itself once it has finished.
+			*/
+			boolean m_detached;
+
+			/**
+			\brief The task that is used to start the coroutine on a worker thread.
+			*/
+			CoroutineResumeTask m_resumeTask;
+
+		public:
+			/**
+			\brief The awaiter that is returned by final_suspend().
+			*/
+			class FinalAwaiter final
+			{
+			public:
+				/**
+				\return False.
+				*/
+				boolean await_ready() const noexcept;
+
+				/**
+				\param handle The finished coroutine.
+
+				\return The coroutine that will be resumed next.
+
+				\brief Calls CoroutinePromiseBase::finish().
+				*/
+				template<typename P>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) const noexcept;
+
+				/**
+				\brief Does nothing, the coroutine is never resumed from its final suspension point.
+				*/
+				void await_resume() const noexcept;
+			};
+
+			/**
+			\brief Constructs a new promise.
+			*/
+			NOU_FUNC CoroutinePromiseBase();
+
+			/**
+			\param size The size of the frame.
+
+			\return The frame, or \p nullptr if the allocation failed.
+
+			\brief Allocates coroutine frames using allocateCoroutineFrame().
+			*/
+			NOU_FUNC static void* operator new (std::size_t size) noexcept;
+
+			/**
+			\param frame The frame.
+			\param size  The size of the frame.
+
+			\brief Deallocates coroutine frames using deallocateCoroutineFrame().
+			*/
+			NOU_FUNC static void operator delete (void *frame, std::size_t size);
+
+			/**
+			\return An awaiter that always suspends.
+
+			\brief Makes coroutines lazy, they do not start before they are awaited, passed to spawn() or
+			       Co::getResult() is called.
+			*/
+			std::suspend_always initial_suspend() const noexcept;
+
+			/**
+			\return The awaiter for the final suspension point.
+			*/
+			FinalAwaiter final_suspend() const noexcept;
+
+			/**
+			\brief Terminates the program. NOU does not use exceptions and coroutines can not report them.
+			*/
+			NOU_FUNC void unhandled_exception();
+
+			/**
+			\param handle The finished coroutine.
+
+			\return The coroutine that will be resumed next (the awaiting coroutine or a no-op coroutine).
+
+			\brief Passes control to whatever is waiting for the coroutine. If the coroutine is detached, it is
+			       destroyed.
+			*/
+			NOU_FUNC std::coroutine_handle<> finish(std::coroutine_handle<> handle) noexcept;
+
+			/**
+			\param continuation The coroutine that awaits this one.
+
+			\brief Sets the coroutine that will be resumed once this one has finished.
+			*/
+			NOU_FUNC void setContinuation(std::coroutine_handle<> continuation);
+
+			/**
+			\param waiter The waiter.
+
+			\brief Sets the waiter that will be notified once the coroutine has finished.
+			*/
+			NOU_FUNC void setWaiter(CoroutineWaiter *waiter);
+
+			/**
+			\param handle The coroutine that this promise belongs to.
+
+			\brief Starts the coroutine on a worker thread. The coroutine will destroy itself once it has
+			       finished.
+			*/
+			NOU_FUNC void detach(std::coroutine_handle<> handle);
+		};
+
+		/**
+		\tparam T The result type of the coroutine.
+
+		\brief The promise type of Co.
+		*/
+		template<typename T>
+		class CoroutinePromise final : public CoroutinePromiseBase
+		{
+		private:
+			/**
+			\brief The result of the coroutine.
+			*/
+			NOU_DAT_ALG::Uninitialized<T> m_result;
+
+		public:
+			/**
+			\return The coroutine object.
+			*/
+			Co<T> get_return_object();
+
+			/**
+			\return An invalid coroutine object.
+
+			\brief Called if the frame could not be allocated.
+			*/
+			static Co<T> get_return_object_on_allocation_failure();
+
+			/**
+			\param value The result.
+
+			\brief Stores the result of the coroutine.
+			*/
+			template<typename U>
+			void return_value(U &&value);
+
+			/**
+			\return The result.
+
+			\brief Returns the result of the coroutine.
+			*/
+			T& getResult();
+		};
+
+		/**
+		\brief The promise type of Co<void>.
+		*/
+		template<>
+		class CoroutinePromise<void> final : public CoroutinePromiseBase
+		{
+		public:
+			/**
+			\return The coroutine object.
+			*/
+			Co<void> get_return_object();
+
+			/**
+			\return An invalid coroutine object.
+
+			\brief Called if the frame could not be allocated.
+			*/
+			static Co<void> get_return_object_on_allocation_failure();
+
+			/**
+			\brief Does nothing.
+			*/
+			void return_void() const;
+
+			/**
+			\brief Does nothing.
+			*/
+			void getResult() const;
+		};
+
+		/**
+		\brief The awaiter that is returned by schedule().
+		*/
+		class ScheduleAwaiter final
+		{
+		private:
+			/**
+			\brief The task that resumes the coroutine.
+			*/
+			CoroutineResumeTask m_task;
+
+			/**
+			\brief The delay in milliseconds.
+			*/
+			uint64 m_milliseconds;
+
+		public:
+			/**
+			\param milliseconds The delay in milliseconds.
+
+			\brief Constructs a new awaiter.
+			*/
+			NOU_FUNC explicit ScheduleAwaiter(uint64 milliseconds);
+
+			/**
+			\return False.
+			*/
+			NOU_FUNC boolean await_ready() const noexcept;
+
+			/**
+			\param handle The suspended coroutine.
+
+			\brief Pushes the coroutine to the thread manager (after the delay has passed).
+			*/
+			NOU_FUNC void await_suspend(std::coroutine_handle<> handle);
+
+			/**
+			\brief Does nothing.
+			*/
+			NOU_FUNC void await_resume() const noexcept;
+		};
+
+		/**
+		\tparam RESULT The type of the task result.
+
+		\brief The awaiter for AsyncTaskResult.
+		*/
+		template<typename RESULT>
+		class AsyncTaskResultAwaiter final
+		{
+		private:
+			/**
+			\brief The awaited task result.
+			*/
+			RESULT *m_result;
+
+			/**
+			\brief The task that resumes the coroutine.
+			*/
+			CoroutineResumeTask m_task;
+
+		public:
+			/**
+			\param result The awaited task result.
+
+			\brief Constructs a new awaiter.
+			*/
+			explicit AsyncTaskResultAwaiter(RESULT &result);
+
+			/**
+			\return True, if the task has already finished.
+			*/
+			boolean await_ready() const;
+
+			/**
+			\param handle The suspended coroutine.
+
+			\return True, if the coroutine was suspended, false if the task has finished in the meantime.
+
+			\brief Registers the coroutine to be pushed to the thread manager once the task has finished.
+			*/
+			boolean await_suspend(std::coroutine_handle<> handle);
+
+			/**
+			\return The result of the task.
+			*/
+			decltype(auto) await_resume();
+		};
+	}
+
+	/**
+	\tparam T The result type of the coroutine.
+
+	\brief A coroutine that runs on the thread manager.
+
+	\details
+	A coroutine that runs on the thread manager. Any function that returns Co<T> and uses <tt>co_await</tt> or
+	<tt>co_return</tt> is such a coroutine. Coroutines are lazy, they do not start before one of the following
+	happens:
+	- The coroutine is awaited by another coroutine using <tt>co_await</tt>. The awaiting coroutine continues
+	  on the same thread once the awaited one has finished, without going through the thread manager.
+	- The coroutine is passed to spawn(). It will then run on a worker thread and destroy itself once it has
+	  finished.
+	- getResult() is called. The coroutine will then be started in the calling thread and getResult() blocks
+	  until it has finished.
+
+	Inside a coroutine, the following can be awaited:
+	- Another Co.
+	- An AsyncTaskResult. The coroutine continues on a worker thread once the task has finished, without
+	  blocking a thread while it is waiting.
+	- schedule(), which moves the coroutine to a worker thread.
+	- sleepFor(), which continues the coroutine on a worker thread after a delay.
+
+	The frames of coroutines are allocated from pools of equally sized blocks (if they are not too large), so
+	starting a coroutine usually does not need a call to the system allocator.
+
+	\note
+	If the frame of a coroutine could not be allocated, an invalid object is returned (see isValid()) and
+	the error BAD_ALLOCATION is pushed.
+	*/
+	template<typename T>
+	class Co final
+	{
+	public:
+		/**
+		\brief The promise type of the coroutine.
+		*/
+		using promise_type = internal::CoroutinePromise<T>;
+
+		/**
+		\brief The type of the handle of the coroutine.
+		*/
+		using Handle = std::coroutine_handle<promise_type>;
+
+	private:
+		/**
+		\brief The coroutine, or a null handle if this object is invalid.
+		*/
+		Handle  m_handle;
+
+		/**
+		\brief True, if the coroutine has finished and getResult() can return the result immediately.
+		*/
+		boolean m_done;
+
+	public:
+		/**
+		\brief The awaiter that is used if a coroutine is awaited.
+		*/
+		class Awaiter final
+		{
+		private:
+			/**
+			\brief The awaited coroutine.
+			*/
+			Handle m_handle;
+
+		public:
+			/**
+			\param handle The awaited coroutine.
+
+			\brief Constructs a new awaiter.
+			*/
+			explicit Awaiter(Handle handle);
+
+			/**
+			\return False.
+			*/
+			boolean await_ready() const noexcept;
+
+			/**
+			\param handle The awaiting coroutine.
+
+			\return The awaited coroutine, which will be started right away.
+			*/
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> handle);
+
+			/**
+			\return The result of the awaited coroutine.
+			*/
+			T await_resume();
+		};
+
+		/**
+		\brief Constructs an invalid object.
+		*/
+		Co();
+
+		/**
+		\param handle The coroutine.
+
+		\brief Constructs a new object that owns \p handle.
+		*/
+		explicit Co(Handle handle);
+
+		/**
+		\param other The object to move from.
+
+		\brief Move constructor.
+		*/
+		Co(Co &&other);
+
+		/**
+		\brief Not copy construct-able.
+		*/
+		Co(const Co&) = delete;
+
+		/**
+		\brief Destroys the coroutine, if it is still owned by this object.
+		*/
+		~Co();
+
+		/**
+		\param other The object to move from.
+
+		\return <tt>*this</tt>
+
+		\brief Move assignment.
+		*/
+		Co& operator = (Co &&other);
+
+		/**
+		\brief Not copy assign-able.
+		*/
+		Co& operator = (const Co&) = delete;
+
+		/**
+		\return True, if the object owns a coroutine, false if not.
+
+		\brief Returns whether the object owns a coroutine.
+		*/
+		boolean isValid() const;
+
+		/**
+		\return The result of the coroutine.
+
+		\brief Starts the coroutine in the calling thread, if it was not started yet, and blocks until it has
+		       finished.
+		*/
+		std::add_lvalue_reference_t<T> getResult();
+
+		/**
+		\return The coroutine. This object will be invalid afterwards.
+
+		\brief Releases the ownership of the coroutine.
+		*/
+		Handle release();
+
+		/**
+		\return An awaiter that starts the coroutine and resumes the awaiting coroutine once it has finished.
+		*/
+		Awaiter operator co_await () &&;
+	};
+
+	/**
+	\param coroutine The coroutine.
+
+	\brief Starts a coroutine on a worker thread. The coroutine will destroy itself once it has finished, its
+	       result is discarded.
+	*/
+	template<typename T>
+	void spawn(Co<T> &&coroutine);
+
+	/**
+	\return An awaiter that moves the awaiting coroutine to a worker thread.
+
+	\brief Moves a coroutine to a worker thread, e.g. to make sure that a coroutine that was started by
+	       Co::getResult() does not occupy the calling thread any further.
+	*/
+	NOU_FUNC internal::ScheduleAwaiter schedule();
+
+	/**
+	\param milliseconds The amount of milliseconds to wait.
+
+	\return An awaiter that resumes the awaiting coroutine on a worker thread after \p milliseconds have
+	        passed.
+
+	\brief Suspends a coroutine for a certain amount of time without blocking a thread.
+	*/
+	NOU_FUNC internal::ScheduleAwaiter sleepFor(uint64 milliseconds);
+
+	/**
+	\param result The task result.
+
+	\return An awaiter that resumes the awaiting coroutine once the task has finished.
+
+	\brief Allows a coroutine to await an AsyncTaskResult.
+	*/
+	template<typename R, typename I, typename... ARGS>
+	internal::AsyncTaskResultAwaiter<AsyncTaskResult<R, I, ARGS...>>
+		operator co_await (AsyncTaskResult<R, I, ARGS...> &result);
+
+	inline boolean internal::CoroutinePromiseBase::FinalAwaiter::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	template<typename P>
+	std::coroutine_handle<> internal::CoroutinePromiseBase::FinalAwaiter::await_suspend(
+		std::coroutine_handle<P> handle) const noexcept
+	{
+		return handle.promise().finish(handle);
+	}
+
+	inline void internal::CoroutinePromiseBase::FinalAwaiter::await_resume() const noexcept
+	{}
+
+	inline std::suspend_always internal::CoroutinePromiseBase::initial_suspend() const noexcept
+	{
+		return {};
+	}
+
+	inline internal::CoroutinePromiseBase::FinalAwaiter internal::CoroutinePromiseBase::final_suspend() const
+		noexcept
+	{
+		return {};
+	}
+
+	template<typename T>
+	Co<T> internal::CoroutinePromise<T>::get_return_object()
+	{
+		return Co<T>(Co<T>::Handle::from_promise(*this));
+	}
+
+	template<typename T>
+	Co<T> internal::CoroutinePromise<T>::get_return_object_on_allocation_failure()
+	{
+		NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+			"The frame of a coroutine could not be allocated.");
+
+		return Co<T>();
+	}
+
+	template<typename T>
+	template<typename U>
+	void internal::CoroutinePromise<T>::return_value(U &&value)
+	{
+		m_result.set(NOU_CORE::forward<U>(value));
+	}
+
+	template<typename T>
+	T& internal::CoroutinePromise<T>::getResult()
+	{
+		return *m_result;
+	}
+
+	inline Co<void> internal::CoroutinePromise<void>::get_return_object()
+	{
+		return Co<void>(Co<void>::Handle::from_promise(*this));
+	}
+
+	inline Co<void> internal::CoroutinePromise<void>::get_return_object_on_allocation_failure()
+	{
+		NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+			"The frame of a coroutine could not be allocated.");
+
+		return Co<void>();
+	}
+
+	inline void internal::CoroutinePromise<void>::return_void() const
+	{}
+
+	inline void internal::CoroutinePromise<void>::getResult() const
+	{}
+
+	template<typename RESULT>
+	internal::AsyncTaskResultAwaiter<RESULT>::AsyncTaskResultAwaiter(RESULT &result) :
+		m_result(&result)
+	{}
+
+	template<typename RESULT>
+	boolean internal::AsyncTaskResultAwaiter<RESULT>::await_ready() const
+	{
+		return m_result->getState() == AsyncTaskResultState::DONE;
+	}
+
+	template<typename RESULT>
+	boolean internal::AsyncTaskResultAwaiter<RESULT>::await_suspend(std::coroutine_handle<> handle)
+	{
+		m_task.setHandle(handle);
+
+		//if this succeeds, the coroutine may already be running in another thread once this returns
+		return m_result->addNotification(AsyncTaskNotification{ &pushCoroutineNotification, &m_task, 0 });
+	}
+
+	template<typename RESULT>
+	decltype(auto) internal::AsyncTaskResultAwaiter<RESULT>::await_resume()
+	{
+		return m_result->getResult();
+	}
+
+	template<typename T>
+	Co<T>::Awaiter::Awaiter(Handle handle) :
+		m_handle(handle)
+	{}
+
+	template<typename T>
+	boolean Co<T>::Awaiter::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	template<typename T>
+	std::coroutine_handle<> Co<T>::Awaiter::await_suspend(std::coroutine_handle<> handle)
+	{
+		m_handle.promise().setContinuation(handle);
+
+		return m_handle;
+	}
+
+	template<typename T>
+	T Co<T>::Awaiter::await_resume()
+	{
+		if constexpr (NOU_CORE::AreSame<T, void>::value)
+			m_handle.promise().getResult();
+		else
+			return NOU_CORE::move(m_handle.promise().getResult());
+	}
+
+	template<typename T>
+	Co<T>::Co() :
+		m_handle(nullptr),
+		m_done(false)
+	{}
+
+	template<typename T>
+	Co<T>::Co(Handle handle) :
+		m_handle(handle),
+		m_done(false)
+	{}
+
+	template<typename T>
+	Co<T>::Co(Co &&other) :
+		m_handle(other.m_handle),
+		m_done(other.m_done)
+	{
+		other.m_handle = nullptr;
+	}
+
+	template<typename T>
+	Co<T>::~Co()
+	{
+		if (m_handle)
+			m_handle.destroy();
+	}
+
+	template<typename T>
+	Co<T>& Co<T>::operator = (Co &&other)
+	{
+		if (this != &other)
+		{
+			if (m_handle)
+				m_handle.destroy();
+
+			m_handle = other.m_handle;
+			m_done = other.m_done;
+
+			other.m_handle = nullptr;
+		}
+
+		return *this;
+	}
+
+	template<typename T>
+	boolean Co<T>::isValid() const
+	{
+		return static_cast<boolean>(m_handle);
+	}
+
+	template<typename T>
+	std::add_lvalue_reference_t<T> Co<T>::getResult()
+	{
+		NOU_ASSERT(isValid());
+
+		if (!m_done)
+		{
+			internal::CoroutineWaiter waiter;
+
+			m_handle.promise().setWaiter(&waiter);
+			m_handle.resume();
+
+			waiter.wait();
+
+			m_done = true;
+		}
+
+		return m_handle.promise().getResult();
+	}
+
+	template<typename T>
+	typename Co<T>::Handle Co<T>::release()
+	{
+		Handle ret = m_handle;
+		m_handle = nullptr;
+
+		return ret;
+	}
+
+	template<typename T>
+	typename Co<T>::Awaiter Co<T>::operator co_await () &&
+	{
+		NOU_ASSERT(isValid());
+
+		return Awaiter(m_handle);
+	}
+
+	template<typename T>
+	void spawn(Co<T> &&coroutine)
+	{
+		NOU_ASSERT(coroutine.isValid());
+
+		typename Co<T>::Handle handle = coroutine.release();
+
+		handle.promise().detach(handle);
+	}
+
+	template<typename R, typename I, typename... ARGS>
+	internal::AsyncTaskResultAwaiter<AsyncTaskResult<R, I, ARGS...>>
+		operator co_await (AsyncTaskResult<R, I, ARGS...> &result)
+	{
+		return internal::AsyncTaskResultAwaiter<AsyncTaskResult<R, I, ARGS...>>(result);
+	}
+}
+
+#endif
+
+#endif
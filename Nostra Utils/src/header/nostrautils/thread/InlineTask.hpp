@@ -0,0 +1,299 @@
+#ifndef	NOU_THREAD_INLINE_TASK_HPP
+#define	NOU_THREAD_INLINE_TASK_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/core/ErrorHandler.hpp"
+#include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/thread/Task.hpp"
+
+#include <new>
+#include <tuple>
+#include <type_traits>
+
+/**
+\file thread/InlineTask.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief This file contains the InlineTask class.
+
+\see nostra::utils::thread::InlineTask
+*/
+
+namespace NOU::NOU_THREAD
+{
+	namespace internal
+	{
+		/**
+		\tparam I    The type of the invocable.
+		\tparam ARGS The types of the arguments.
+
+		\brief An invocable together with the arguments that it will be called with.
+		*/
+		template<typename I, typename... ARGS>
+		class BoundInvocable final
+		{
+		private:
+			/**
+			\brief The invocable.
+			*/
+			I m_invocable;
+
+			/**
+			\brief The arguments.
+			*/
+			std::tuple<ARGS...> m_args;
+
+		public:
+			/**
+			\param invocable The invocable.
+			\param args      The arguments.
+
+			\brief Constructs a new instance.
+			*/
+			template<typename F, typename... A>
+			explicit BoundInvocable(F &&invocable, A&&... args);
+
+			/**
+			\brief Calls the invocable with the arguments. The result is discarded.
+			*/
+			void operator () ();
+		};
+
+		/**
+		\brief The functions that InlineTask uses to access the stored invocable without knowing its type.
+		*/
+		struct InlineTaskOperations
+		{
+			/**
+			\brief Calls the invocable that is stored in the passed buffer.
+			*/
+			void (*m_execute)(void*);
+
+			/**
+			\brief Destroys the invocable that is stored in the passed buffer.
+			*/
+			void (*m_destroy)(void*);
+
+			/**
+			\brief Moves the invocable from the first buffer to the second one and destroys the source.
+			*/
+			void (*m_move)(void*, void*);
+		};
+	}
+
+	/**
+	\brief A move-only task that stores any invocable (together with its arguments) without allocating, as long
+	       as the invocable is small enough.
+
+	\details
+	A move-only task that stores any invocable (together with its arguments) without allocating, as long as the
+	invocable is small enough. An invocable and its arguments that take up no more than INLINE_CAPACITY bytes
+	(and that do not need a larger alignment than <tt>std::max_align_t</tt> and can be moved without throwing)
+	are stored directly inside the task. Larger ones are stored in memory from GenericAllocationCallback.
+
+	In contrast to Task, the result of the invocable is discarded and the type of an InlineTask does not depend
+	on the invocable. This makes the class useful for fire-and-forget submission of work, see
+	ThreadManager::submit().
+	*/
+	class InlineTask final : public internal::AbstractTask
+	{
+	public:
+		/**
+		\brief The amount of bytes that an invocable (together with its arguments) may take up to be stored
+		       inside the task.
+		*/
+		constexpr static sizeType INLINE_CAPACITY = 64;
+
+	private:
+		/**
+		\tparam T The type of the stored invocable.
+
+		\brief True, if an invocable of the type \p T will be stored in \p m_buffer.
+		*/
+		template<typename T>
+		constexpr static boolean IS_INLINE = sizeof(T) <= INLINE_CAPACITY &&
+			alignof(T) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<T>;
+
+		/**
+		\tparam T The type of the stored invocable.
+
+		\brief The operations for invocables that are stored in \p m_buffer.
+		*/
+		template<typename T>
+		static const internal::InlineTaskOperations INLINE_OPERATIONS;
+
+		/**
+		\tparam T The type of the stored invocable.
+
+		\brief The operations for invocables that are stored in allocated memory (in this case, \p m_buffer
+		       stores a pointer to that memory).
+		*/
+		template<typename T>
+		static const internal::InlineTaskOperations ALLOCATED_OPERATIONS;
+
+		/**
+		\brief The storage of the invocable, or of a pointer to it.
+		*/
+		alignas(std::max_align_t) byte m_buffer[INLINE_CAPACITY];
+
+		/**
+		\brief The operations for the stored invocable, or \p nullptr if there is no invocable.
+		*/
+		const internal::InlineTaskOperations *m_operations;
+
+		/**
+		\brief True, if the invocable is stored in \p m_buffer.
+		*/
+		boolean m_isInline;
+
+	public:
+		/**
+		\brief Constructs a task without an invocable.
+		*/
+		NOU_FUNC InlineTask();
+
+		/**
+		\tparam F    The type of the invocable.
+		\tparam ARGS The types of the arguments.
+
+		\param invocable The invocable.
+		\param args      The arguments that will be passed to the invocable.
+
+		\brief Constructs a task that calls \p invocable with \p args. Both are copied or moved into the task.
+		*/
+		template<typename F, typename... ARGS, typename = std::enable_if_t<
+			!std::is_same_v<std::decay_t<F>, InlineTask>>>
+		explicit InlineTask(F &&invocable, ARGS&&... args);
+
+		/**
+		\param other The task to move from. It will not have an invocable afterwards.
+
+		\brief Move constructor.
+		*/
+		NOU_FUNC InlineTask(InlineTask &&other);
+
+		/**
+		\brief Not copy construct-able.
+		*/
+		InlineTask(const InlineTask&) = delete;
+
+		/**
+		\brief Destroys the invocable.
+		*/
+		NOU_FUNC virtual ~InlineTask();
+
+		/**
+		\param other The task to move from. It will not have an invocable afterwards.
+
+		\return <tt>*this</tt>
+
+		\brief Move assignment.
+		*/
+		NOU_FUNC InlineTask& operator = (InlineTask &&other);
+
+		/**
+		\brief Not copy assign-able.
+		*/
+		InlineTask& operator = (const InlineTask&) = delete;
+
+		/**
+		\brief Calls the stored invocable.
+
+		\pre isValid() returns true.
+		*/
+		NOU_FUNC virtual void execute() override;
+
+		/**
+		\return True, if the task stores an invocable, false if not.
+
+		\brief Returns whether the task stores an invocable.
+		*/
+		NOU_FUNC boolean isValid() const;
+
+		/**
+		\return True, if the invocable is stored inside the task, false if it is stored in allocated memory or
+		        if there is no invocable.
+
+		\brief Returns whether the invocable is stored inside the task.
+		*/
+		NOU_FUNC boolean isInline() const;
+	};
+
+	template<typename I, typename... ARGS>
+	template<typename F, typename... A>
+	internal::BoundInvocable<I, ARGS...>::BoundInvocable(F &&invocable, A&&... args) :
+		m_invocable(NOU_CORE::forward<F>(invocable)),
+		m_args(NOU_CORE::forward<A>(args)...)
+	{}
+
+	template<typename I, typename... ARGS>
+	void internal::BoundInvocable<I, ARGS...>::operator () ()
+	{
+		NOU_CORE::apply(m_invocable, m_args);
+	}
+
+	template<typename T>
+	const internal::InlineTaskOperations InlineTask::INLINE_OPERATIONS =
+	{
+		[](void *buffer) { (*reinterpret_cast<T*>(buffer))(); },
+		[](void *buffer) { reinterpret_cast<T*>(buffer)->~T(); },
+		[](void *from, void *to)
+		{
+			new (to) T(NOU_CORE::move(*reinterpret_cast<T*>(from)));
+			reinterpret_cast<T*>(from)->~T();
+		}
+	};
+
+	template<typename T>
+	const internal::InlineTaskOperations InlineTask::ALLOCATED_OPERATIONS =
+	{
+		[](void *buffer) { (**reinterpret_cast<T**>(buffer))(); },
+		[](void *buffer)
+		{
+			T *invocable = *reinterpret_cast<T**>(buffer);
+
+			invocable->~T();
+			NOU_MEM_MNGT::GenericAllocationCallback<T>().deallocate(invocable);
+		},
+		[](void *from, void *to) { *reinterpret_cast<T**>(to) = *reinterpret_cast<T**>(from); }
+	};
+
+	template<typename F, typename... ARGS, typename>
+	InlineTask::InlineTask(F &&invocable, ARGS&&... args) :
+		m_operations(nullptr),
+		m_isInline(false)
+	{
+		using Bound = internal::BoundInvocable<std::decay_t<F>, std::decay_t<ARGS>...>;
+
+		if constexpr (IS_INLINE<Bound>)
+		{
+			new (m_buffer) Bound(NOU_CORE::forward<F>(invocable), NOU_CORE::forward<ARGS>(args)...);
+
+			m_operations = &INLINE_OPERATIONS<Bound>;
+			m_isInline = true;
+		}
+		else
+		{
+			Bound *bound = NOU_MEM_MNGT::GenericAllocationCallback<Bound>().allocate(1);
+
+			if (bound == nullptr)
+			{
+				NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+					"The invocable of an InlineTask could not be allocated.");
+
+				return;
+			}
+
+			new (bound) Bound(NOU_CORE::forward<F>(invocable), NOU_CORE::forward<ARGS>(args)...);
+
+			*reinterpret_cast<Bound**>(m_buffer) = bound;
+			m_operations = &ALLOCATED_OPERATIONS<Bound>;
+		}
+	}
+}
+
+#endif
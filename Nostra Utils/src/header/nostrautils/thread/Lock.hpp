@@ -3,6 +3,7 @@
 
 #include "nostrautils/core/StdIncludes.hpp"
 #include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/thread/SharedMutex.hpp"
 
 #include <mutex>
 
@@ -113,6 +114,39 @@ namespace NOU::NOU_THREAD
 		*/
 		NOU_FUNC const UnderlyingType& getUnderlying() const;
 	};
+
+	/**
+	\brief A class that stores a reference to a SharedMutex. Upon construction, the mutex will be locked for
+	       reading and upon destruction it will be unlocked again.
+	*/
+	class SharedLock final
+	{
+	private:
+		/**
+		\brief The managed mutex.
+		*/
+		SharedMutex *m_mutex;
+
+	public:
+		/**
+		\param mutex The mutex to lock.
+		\param lock  Defines whether the mutex should be locked or not. If not, the mutex must already have been
+		             locked for reading by the calling thread.
+
+		\brief If not already locked, this will lock the mutex for reading.
+		*/
+		NOU_FUNC SharedLock(SharedMutex &mutex, boolean lock = true);
+
+		/**
+		\brief Not copy construct-able.
+		*/
+		SharedLock(const SharedLock&) = delete;
+
+		/**
+		\brief This will unlock the mutex.
+		*/
+		NOU_FUNC ~SharedLock();
+	};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,490 @@
+#ifndef NOU_THREAD_PARALLEL_HPP
+#define NOU_THREAD_PARALLEL_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Meta.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/dat_alg/Comparator.hpp"
+#include "nostrautils/dat_alg/Quicksort.hpp"
+#include "nostrautils/dat_alg/Uninitialized.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
+#include "nostrautils/thread/TaskQueue.hpp"
+
+/**
+\file thread/Parallel.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains parallel algorithms that are executed using the thread manager.
+
+\details
+A file that contains parallel algorithms that are executed using the thread manager. All algorithms split the
+work into chunks of a certain size (the grain). The calling thread always takes part in the execution of the
+chunks and the algorithms only return once all chunks have been executed. Because of that, the algorithms
+may also be called from within a task that is executed by the thread manager (e.g. to nest them).
+*/
+
+namespace NOU::NOU_THREAD
+{
+	namespace internal
+	{
+		/**
+		\brief The type of a function that executes a single chunk of a parallel algorithm.
+
+		\details
+		The type of a function that executes a single chunk of a parallel algorithm. The parameters are (in
+		that order): the context that was passed to runParallel(), the first index of the chunk, the index
+		after the last index of the chunk and the index of the chunk itself.
+		*/
+		using ChunkFunction = void(*)(void*, sizeType, sizeType, sizeType);
+
+		/**
+		\param count The amount of indices.
+
+		\return The grain size.
+
+		\brief Chooses a grain size for \p count indices based on the amount of threads that the thread
+		       manager can use.
+		*/
+		NOU_FUNC sizeType automaticGrain(sizeType count);
+
+		/**
+		\param begin    The first index.
+		\param end      The index after the last index.
+		\param grain    The amount of indices per chunk. If this is 0, automaticGrain() will be used.
+		\param function The function that executes a single chunk.
+		\param context  The context that will be passed to \p function.
+
+		\return The amount of chunks that were executed.
+
+		\brief Splits the range [\p begin, \p end) into chunks and executes them using the thread manager and
+		       the calling thread.
+
+		\details
+		Splits the range [\p begin, \p end) into chunks and executes them using the thread manager and the
+		calling thread. This function returns once all chunks have been executed.
+		*/
+		NOU_FUNC sizeType runParallel(sizeType begin, sizeType end, sizeType grain, ChunkFunction function,
+			void *context);
+
+		/**
+		\param count The amount of indices.
+		\param grain The grain, or 0 for automaticGrain().
+
+		\return The amount of chunks that runParallel() will use.
+
+		\brief Returns the amount of chunks that runParallel() will use.
+		*/
+		NOU_FUNC sizeType chunkCount(sizeType count, sizeType grain);
+
+		/**
+		\brief The minimum size of a range that parallelQuicksort() will split into two parallel tasks.
+		*/
+		constexpr int64 PARALLEL_SORT_THRESHOLD = 8192;
+
+		/**
+		\brief The size of a range below which the sequential part of parallelQuicksort() uses insertion
+		       sort.
+		*/
+		constexpr int64 INSERTION_SORT_THRESHOLD = 16;
+
+		/**
+		\tparam T       The type of the elements.
+		\tparam LESS_EQ The type of the comparison.
+
+		\param array     The array.
+		\param left      The first index of the range.
+		\param right     The last index of the range.
+		\param lessEqual A comparison that returns true if the first argument is less than or equal to the
+		                 second one.
+
+		\return True, if all elements in the range are equal to the last one, false if not.
+
+		\brief Checks whether all elements in a range are equal.
+
+		\details
+		Checks whether all elements in a range are equal. Since NOU_DAT_ALG::partition() puts all elements
+		that are equal to the pivot into the lower partition, this is used to stop sorting ranges that only
+		consist of equal elements, which would otherwise take quadratic time.
+		*/
+		template<typename T, typename LESS_EQ>
+		boolean isUniform(T *array, int64 left, int64 right, LESS_EQ &lessEqual);
+
+		/**
+		\tparam T       The type of the elements.
+		\tparam LESS_EQ The type of the comparison.
+
+		\param array     The array.
+		\param left      The first index of the range.
+		\param right     The last index of the range.
+		\param lessEqual A comparison that returns true if the first argument is less than or equal to the
+		                 second one.
+
+		\return The index of the median of the first, middle and last element of the range.
+
+		\brief Chooses a pivot for quicksort.
+		*/
+		template<typename T, typename LESS_EQ>
+		int64 medianOfThree(T *array, int64 left, int64 right, LESS_EQ &lessEqual);
+
+		/**
+		\tparam T         The type of the elements.
+		\tparam PARTITION The type of the partitioning function.
+		\tparam LESS_EQ   The type of the comparison.
+
+		\param array     The array.
+		\param left      The first index of the range.
+		\param right     The last index of the range.
+		\param partition A function that calls NOU_DAT_ALG::partition().
+		\param lessEqual A comparison that returns true if the first argument is less than or equal to the
+		                 second one.
+
+		\brief Sorts a range sequentially.
+
+		\details
+		Sorts a range sequentially. Unlike NOU_DAT_ALG::qsort(), this function uses a median-of-three pivot,
+		only recurses into the smaller partition and sorts small ranges using insertion sort. This keeps the
+		depth of the recursion logarithmic.
+		*/
+		template<typename T, typename PARTITION, typename LESS_EQ>
+		void sequentialQuicksort(T *array, int64 left, int64 right, PARTITION &partition,
+			LESS_EQ &lessEqual);
+
+		/**
+		\tparam T         The type of the elements.
+		\tparam PARTITION The type of the partitioning function.
+		\tparam LESS_EQ   The type of the comparison.
+
+		\param array     The array.
+		\param left      The first index of the range.
+		\param right     The last index of the range.
+		\param partition A function that calls NOU_DAT_ALG::partition().
+		\param lessEqual A comparison that returns true if the first argument is less than or equal to the
+		                 second one.
+
+		\brief Sorts a range by partitioning it and sorting both partitions in parallel.
+		*/
+		template<typename T, typename PARTITION, typename LESS_EQ>
+		void parallelQuicksortRange(T *array, int64 left, int64 right, PARTITION &partition,
+			LESS_EQ &lessEqual);
+	}
+
+	/**
+	\tparam FN The type of the invocable.
+
+	\param begin    The first index.
+	\param end      The index after the last index.
+	\param grain    The amount of indices that are processed by a single task. If this is 0, the grain will be
+	                chosen automatically.
+	\param function The invocable that will be called once for each index. It needs to be callable as
+	                <tt>function(sizeType)</tt>.
+
+	\brief Calls \p function for each index in [\p begin, \p end). The calls are distributed across the threads
+	       of the thread manager.
+
+	\details
+	Calls \p function for each index in [\p begin, \p end). The calls are distributed across the threads of the
+	thread manager. The calls within a single chunk are done in ascending order, but the chunks may be executed
+	in any order and at the same time.
+
+	This function returns once all calls are done.
+	*/
+	template<typename FN>
+	void parallelFor(sizeType begin, sizeType end, sizeType grain, FN &&function);
+
+	/**
+	\tparam FN The type of the invocable.
+
+	\param begin    The first index.
+	\param end      The index after the last index.
+	\param function The invocable that will be called once for each index.
+
+	\brief Same as <tt>parallelFor(begin, end, 0, function)</tt>.
+	*/
+	template<typename FN>
+	void parallelFor(sizeType begin, sizeType end, FN &&function);
+
+	/**
+	\tparam FN    The type of the invocable.
+	\tparam R     The type of the result.
+	\tparam ACCUM The type of the accumulator.
+
+	\param begin       The first index.
+	\param end         The index after the last index.
+	\param grain       The amount of indices that are processed by a single task. If this is 0, the grain will
+	                   be chosen automatically.
+	\param function    The invocable that will be called once for each index. It needs to be callable as
+	                   <tt>function(sizeType)</tt>.
+	\param accumulator The accumulator that combines two results. The accumulators from
+	                   TaskQueueAccumulators can be used. By default, TaskQueueAccumulators::addition() is
+	                   used.
+
+	\return The accumulated result, or a default constructed result if the range is empty.
+
+	\brief Calls \p function for each index in [\p begin, \p end) and accumulates the results.
+
+	\details
+	Calls \p function for each index in [\p begin, \p end) and accumulates the results. Each chunk accumulates
+	its results on its own (in ascending order) and afterwards, the results of the chunks are accumulated in
+	ascending order of the chunks. Hence, the accumulator needs to be associative, but not commutative.
+	*/
+	template<typename FN, typename R = NOU_CORE::InvokeResult_t<FN, sizeType>,
+		typename ACCUM = TaskQueueAccumulators::FunctionPtr<R>>
+	R parallelReduce(sizeType begin, sizeType end, sizeType grain, FN &&function,
+		ACCUM accumulator = TaskQueueAccumulators::addition<R>);
+
+	/**
+	\tparam T The type of the elements.
+
+	\param array The array to sort.
+	\param size  The amount of elements in \p array.
+
+	\brief Sorts an array in ascending order (using <tt>operator <=</tt>). The sorting is done in parallel.
+
+	\details
+	Sorts an array in ascending order (using <tt>operator <=</tt>). The array is partitioned using
+	NOU_DAT_ALG::partition() and both partitions are sorted in parallel until the partitions are small enough
+	to be sorted sequentially.
+	*/
+	template<typename T>
+	void parallelQuicksort(T *array, sizeType size);
+
+	/**
+	\tparam T The type of the elements.
+
+	\param array      The array to sort.
+	\param size       The amount of elements in \p array.
+	\param comparator The comparator that is used to compare the elements.
+
+	\brief Sorts an array in ascending order (using \p comparator). The sorting is done in parallel.
+	*/
+	template<typename T>
+	void parallelQuicksort(T *array, sizeType size, NOU_DAT_ALG::Comparator<T> comparator);
+
+	/**
+	\tparam T     The type of the elements.
+	\tparam ALLOC The allocator of the vector.
+
+	\param vector The vector to sort.
+
+	\brief Sorts a vector in ascending order (using <tt>operator <=</tt>). The sorting is done in parallel.
+	*/
+	template<typename T, template<typename> class ALLOC>
+	void parallelQuicksort(NOU_DAT_ALG::Vector<T, ALLOC> &vector);
+
+	/**
+	\tparam T     The type of the elements.
+	\tparam ALLOC The allocator of the vector.
+
+	\param vector     The vector to sort.
+	\param comparator The comparator that is used to compare the elements.
+
+	\brief Sorts a vector in ascending order (using \p comparator). The sorting is done in parallel.
+	*/
+	template<typename T, template<typename> class ALLOC>
+	void parallelQuicksort(NOU_DAT_ALG::Vector<T, ALLOC> &vector, NOU_DAT_ALG::Comparator<T> comparator);
+
+
+
+	template<typename T, typename LESS_EQ>
+	int64 internal::medianOfThree(T *array, int64 left, int64 right, LESS_EQ &lessEqual)
+	{
+		int64 middle = left + (right - left) / 2;
+
+		if (lessEqual(array[left], array[middle]))
+		{
+			if (lessEqual(array[middle], array[right]))
+				return middle;
+
+			return lessEqual(array[left], array[right]) ? right : left;
+		}
+
+		if (lessEqual(array[left], array[right]))
+			return left;
+
+		return lessEqual(array[middle], array[right]) ? right : middle;
+	}
+
+	template<typename T, typename LESS_EQ>
+	boolean internal::isUniform(T *array, int64 left, int64 right, LESS_EQ &lessEqual)
+	{
+		for (int64 i = left; i < right; i++)
+		{
+			if (!lessEqual(array[right], array[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	template<typename T, typename PARTITION, typename LESS_EQ>
+	void internal::sequentialQuicksort(T *array, int64 left, int64 right, PARTITION &partition,
+		LESS_EQ &lessEqual)
+	{
+		while (right - left > INSERTION_SORT_THRESHOLD)
+		{
+			int64 pivot = partition(array, left, right, medianOfThree(array, left, right, lessEqual));
+
+			if (pivot == right && isUniform(array, left, right, lessEqual))
+				return;
+
+			//recurse into the smaller partition, loop over the larger one
+			if (pivot - left < right - pivot)
+			{
+				sequentialQuicksort(array, left, pivot - 1, partition, lessEqual);
+				left = pivot + 1;
+			}
+			else
+			{
+				sequentialQuicksort(array, pivot + 1, right, partition, lessEqual);
+				right = pivot - 1;
+			}
+		}
+
+		for (int64 i = left + 1; i <= right; i++)
+		{
+			for (int64 j = i; j > left && !lessEqual(array[j - 1], array[j]); j--)
+				NOU_DAT_ALG::swap(array + j - 1, array + j);
+		}
+	}
+
+	template<typename T, typename PARTITION, typename LESS_EQ>
+	void internal::parallelQuicksortRange(T *array, int64 left, int64 right, PARTITION &partition,
+		LESS_EQ &lessEqual)
+	{
+		if (right - left < PARALLEL_SORT_THRESHOLD)
+		{
+			sequentialQuicksort(array, left, right, partition, lessEqual);
+			return;
+		}
+
+		int64 pivot = partition(array, left, right, medianOfThree(array, left, right, lessEqual));
+
+		if (pivot == right && isUniform(array, left, right, lessEqual))
+			return;
+
+		parallelFor(0, 2, 1, [array, left, right, pivot, &partition, &lessEqual](sizeType i)
+		{
+			if (i == 0)
+				parallelQuicksortRange(array, left, pivot - 1, partition, lessEqual);
+			else
+				parallelQuicksortRange(array, pivot + 1, right, partition, lessEqual);
+		});
+	}
+
+	template<typename FN>
+	void parallelFor(sizeType begin, sizeType end, sizeType grain, FN &&function)
+	{
+		using FunctionType = NOU_CORE::RemoveReference_t<FN>;
+
+		internal::runParallel(begin, end, grain,
+			[](void *context, sizeType chunkBegin, sizeType chunkEnd, sizeType)
+			{
+				FunctionType &function = *static_cast<FunctionType*>(context);
+
+				for (sizeType i = chunkBegin; i < chunkEnd; i++)
+					function(i);
+			},
+			const_cast<void*>(static_cast<const void*>(NOU_MEM_MNGT::addressof(function))));
+	}
+
+	template<typename FN>
+	void parallelFor(sizeType begin, sizeType end, FN &&function)
+	{
+		parallelFor(begin, end, 0, NOU_CORE::forward<FN>(function));
+	}
+
+	template<typename FN, typename R, typename ACCUM>
+	R parallelReduce(sizeType begin, sizeType end, sizeType grain, FN &&function, ACCUM accumulator)
+	{
+		using FunctionType = NOU_CORE::RemoveReference_t<FN>;
+
+		if (begin >= end)
+			return R();
+
+		sizeType chunks = internal::chunkCount(end - begin, grain);
+
+		//one partial result per chunk
+		NOU_DAT_ALG::Vector<NOU_DAT_ALG::Uninitialized<R>> partials(chunks);
+
+		for (sizeType i = 0; i < chunks; i++)
+			partials.emplaceBack();
+
+		struct Context
+		{
+			FunctionType *m_function;
+			ACCUM *m_accumulator;
+			NOU_DAT_ALG::Uninitialized<R> *m_partials;
+		} context = { NOU_MEM_MNGT::addressof(function), &accumulator, partials.data() };
+
+		internal::runParallel(begin, end, grain,
+			[](void *contextPtr, sizeType chunkBegin, sizeType chunkEnd, sizeType chunkIndex)
+			{
+				Context &context = *static_cast<Context*>(contextPtr);
+
+				R partial = (*context.m_function)(chunkBegin);
+
+				for (sizeType i = chunkBegin + 1; i < chunkEnd; i++)
+					partial = (*context.m_accumulator)(NOU_CORE::move(partial), (*context.m_function)(i));
+
+				context.m_partials[chunkIndex].set(NOU_CORE::move(partial));
+			}, &context);
+
+		R ret = NOU_CORE::move(*partials[0]);
+
+		for (sizeType i = 1; i < chunks; i++)
+			ret = accumulator(NOU_CORE::move(ret), NOU_CORE::move(*partials[i]));
+
+		return ret;
+	}
+
+	template<typename T>
+	void parallelQuicksort(T *array, sizeType size)
+	{
+		auto partition = [](T *a, int64 left, int64 right, int64 pivot)
+		{
+			return NOU_DAT_ALG::partition(a, left, right, pivot);
+		};
+
+		auto lessEqual = [](const T &a, const T &b)
+		{
+			return a <= b;
+		};
+
+		if (size > 1)
+			internal::parallelQuicksortRange(array, 0, static_cast<int64>(size) - 1, partition, lessEqual);
+	}
+
+	template<typename T>
+	void parallelQuicksort(T *array, sizeType size, NOU_DAT_ALG::Comparator<T> comparator)
+	{
+		auto partition = [comparator](T *a, int64 left, int64 right, int64 pivot)
+		{
+			return NOU_DAT_ALG::partition(a, left, right, pivot, comparator);
+		};
+
+		auto lessEqual = [comparator](const T &a, const T &b)
+		{
+			return comparator(a, b) <= 0;
+		};
+
+		if (size > 1)
+			internal::parallelQuicksortRange(array, 0, static_cast<int64>(size) - 1, partition, lessEqual);
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void parallelQuicksort(NOU_DAT_ALG::Vector<T, ALLOC> &vector)
+	{
+		parallelQuicksort(vector.data(), vector.size());
+	}
+
+	template<typename T, template<typename> class ALLOC>
+	void parallelQuicksort(NOU_DAT_ALG::Vector<T, ALLOC> &vector, NOU_DAT_ALG::Comparator<T> comparator)
+	{
+		parallelQuicksort(vector.data(), vector.size(), comparator);
+	}
+}
+
+#endif
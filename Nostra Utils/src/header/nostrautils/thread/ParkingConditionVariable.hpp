@@ -0,0 +1,115 @@
+#ifndef NOU_THREAD_PARKING_CONDITION_VARIABLE_HPP
+#define NOU_THREAD_PARKING_CONDITION_VARIABLE_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/thread/ParkingLot.hpp"
+
+#include <atomic>
+
+/**
+\file thread/ParkingConditionVariable.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::thread::ParkingConditionVariable class.
+
+\see nostra::utils::thread::ParkingConditionVariable
+*/
+
+namespace NOU::NOU_THREAD
+{
+	/**
+	\brief A condition variable that only takes up a single byte and works with any mutex.
+
+	\details
+	A condition variable that only takes up a single byte and works with any mutex that provides the methods
+	<tt>lock()</tt> and <tt>unlock()</tt> (e.g. AdaptiveMutex, ByteMutex or Mutex). The waiting threads are
+	stored in the ParkingLot, the variable itself only stores whether there may be waiting threads. This makes
+	notifying a variable that nobody waits for very cheap.
+
+	As with ConditionVariable, the mutex needs to be locked when wait() is called and the waiting thread may
+	wake up spuriously, so the overload that takes a predicate should be preferred.
+	*/
+	class ParkingConditionVariable final
+	{
+	private:
+		/**
+		\brief True, if there may be threads that wait for this variable.
+		*/
+		std::atomic<boolean> m_hasWaiters;
+
+	public:
+		/**
+		\brief Constructs a new variable.
+		*/
+		constexpr ParkingConditionVariable();
+
+		/**
+		\brief Not copy construct-able.
+		*/
+		ParkingConditionVariable(const ParkingConditionVariable&) = delete;
+
+		/**
+		\brief Not copy assign-able.
+		*/
+		ParkingConditionVariable& operator = (const ParkingConditionVariable&) = delete;
+
+		/**
+		\brief Wakes up one thread that is waiting.
+		*/
+		NOU_FUNC void notifyOne();
+
+		/**
+		\brief Wakes up all threads that are waiting.
+		*/
+		NOU_FUNC void notifyAll();
+
+		/**
+		\tparam MUTEX The type of the mutex.
+
+		\param mutex The mutex. It must be locked by the calling thread.
+
+		\brief Unlocks \p mutex, waits until the variable is notified and locks \p mutex again.
+		*/
+		template<typename MUTEX>
+		void wait(MUTEX &mutex);
+
+		/**
+		\tparam MUTEX The type of the mutex.
+		\tparam PRED  The type of the predicate.
+
+		\param mutex     The mutex. It must be locked by the calling thread.
+		\param predicate The predicate, it must have the signature <tt>boolean predicate()</tt>.
+
+		\brief Waits until the variable is notified and \p predicate returns true.
+		*/
+		template<typename MUTEX, typename PRED>
+		void wait(MUTEX &mutex, PRED predicate);
+	};
+
+	constexpr ParkingConditionVariable::ParkingConditionVariable() :
+		m_hasWaiters(false)
+	{}
+
+	template<typename MUTEX>
+	void ParkingConditionVariable::wait(MUTEX &mutex)
+	{
+		m_hasWaiters.store(true, std::memory_order_relaxed);
+
+		//the mutex is unlocked after the thread has been enqueued, so no notification can get lost
+		ParkingLot::park(this, []() { return true; }, [&mutex]() { mutex.unlock(); });
+
+		mutex.lock();
+	}
+
+	template<typename MUTEX, typename PRED>
+	void ParkingConditionVariable::wait(MUTEX &mutex, PRED predicate)
+	{
+		while (!predicate())
+			wait(mutex);
+	}
+}
+
+#endif
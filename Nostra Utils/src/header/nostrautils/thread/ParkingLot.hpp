@@ -0,0 +1,221 @@
+#ifndef NOU_THREAD_PARKING_LOT_HPP
+#define NOU_THREAD_PARKING_LOT_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Meta.hpp"
+
+#include <atomic>
+#include <thread>
+
+#if NOU_COMPILER == NOU_COMPILER_VISUAL_CPP && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+/**
+\file thread/ParkingLot.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::thread::ParkingLot class and the functions that put threads to
+       sleep on a memory address.
+
+\see nostra::utils::thread::ParkingLot
+*/
+
+namespace NOU::NOU_THREAD
+{
+	/**
+	\brief Tells the CPU that the calling thread is spinning (e.g. using the <tt>pause</tt> instruction on x86).
+	       This should be called in each iteration of a spin loop.
+	*/
+	inline void cpuRelax()
+	{
+#if NOU_COMPILER == NOU_COMPILER_VISUAL_CPP && (defined(_M_X64) || defined(_M_IX86))
+		_mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+		__builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+		asm volatile("yield" ::: "memory");
+#else
+		std::this_thread::yield();
+#endif
+	}
+
+	/**
+	\brief The result of ParkingLot::unparkOne().
+	*/
+	struct UnparkResult
+	{
+		/**
+		\brief True, if a thread was unparked.
+		*/
+		boolean m_unparked;
+
+		/**
+		\brief True, if there may still be threads that are parked on the same address.
+		*/
+		boolean m_mayHaveMoreThreads;
+	};
+
+	/**
+	\brief A global table of queues of sleeping threads that is indexed by memory addresses.
+
+	\details
+	A global table of queues of sleeping threads that is indexed by memory addresses. This allows the
+	construction of synchronization primitives that only need a few bits of state (e.g. ByteMutex and
+	ParkingConditionVariable): the threads that wait for such a primitive are stored in the parking lot, not
+	in the primitive itself.
+
+	A thread is "parked" on an address using park() and woken up again by another thread using unparkOne() or
+	unparkAll() with the same address. The parking lot consists of a fixed amount of buckets, each of which is
+	protected by its own mutex. Each thread can only be parked on a single address at a time.
+
+	The parking lot is based on the one that is used by WebKit.
+	*/
+	class ParkingLot final
+	{
+	public:
+		/**
+		\brief The amount of buckets of the parking lot.
+		*/
+		constexpr static sizeType BUCKET_COUNT = 256;
+
+	private:
+		/**
+		\param address       The address.
+		\param validate      Called while the bucket is locked, the thread will only be parked if this returns
+		                     true.
+		\param beforeSleep   Called after the thread has been enqueued, but before it sleeps. The bucket is not
+		                     locked anymore.
+		\param context       The parameter of \p validate and \p beforeSleep.
+
+		\return True, if the thread was parked and then unparked, false if \p validate returned false.
+
+		\brief The implementation of park().
+		*/
+		NOU_FUNC static boolean parkImpl(const void *address, boolean(*validate)(void*),
+			void(*beforeSleep)(void*), void *context);
+
+		/**
+		\param address  The address.
+		\param callback Called while the bucket is locked, after a thread has (or has not) been dequeued.
+		\param context  The first parameter of \p callback.
+
+		\return The result.
+
+		\brief The implementation of unparkOne().
+		*/
+		NOU_FUNC static UnparkResult unparkOneImpl(const void *address,
+			void(*callback)(void*, const UnparkResult&), void *context);
+
+	public:
+		/**
+		\tparam VALIDATE     The type of \p validate.
+		\tparam BEFORE_SLEEP The type of \p beforeSleep.
+
+		\param address     The address to park on.
+		\param validate    An invocable with the signature <tt>boolean validate()</tt>. It is called while the
+		                   bucket of \p address is locked and the thread will only be parked if it returns
+		                   true. This is where a thread should check whether it still needs to wait.
+		\param beforeSleep An invocable with the signature <tt>void beforeSleep()</tt>. It is called after the
+		                   thread has been enqueued, but before it goes to sleep (e.g. to unlock a mutex).
+
+		\return True, if the thread was parked and then unparked, false if \p validate returned false.
+
+		\brief Puts the calling thread to sleep until another thread calls unparkOne() or unparkAll() with the
+		       same address.
+		*/
+		template<typename VALIDATE, typename BEFORE_SLEEP>
+		static boolean park(const void *address, VALIDATE &&validate, BEFORE_SLEEP &&beforeSleep);
+
+		/**
+		\param address The address.
+
+		\return The result.
+
+		\brief Wakes up the thread that has been parked on \p address for the longest time (if there is one).
+		*/
+		NOU_FUNC static UnparkResult unparkOne(const void *address);
+
+		/**
+		\tparam CALLBACK The type of \p callback.
+
+		\param address  The address.
+		\param callback An invocable with the signature <tt>void callback(const UnparkResult&)</tt>. It is
+		                called while the bucket of \p address is still locked, so no thread can be parked on
+		                \p address during the call. This can be used to update the state of a primitive
+		                before any other thread can observe it.
+
+		\return The result.
+
+		\brief Wakes up the thread that has been parked on \p address for the longest time (if there is one).
+		*/
+		template<typename CALLBACK>
+		static UnparkResult unparkOne(const void *address, CALLBACK &&callback);
+
+		/**
+		\param address The address.
+
+		\return The amount of threads that were woken up.
+
+		\brief Wakes up all threads that are parked on \p address.
+		*/
+		NOU_FUNC static sizeType unparkAll(const void *address);
+	};
+
+	/**
+	\param word     The word to wait on.
+	\param expected The value that \p word is expected to have.
+
+	\brief Puts the calling thread to sleep if \p word has the value \p expected, until futexWake() is called on
+	       \p word.
+
+	\details
+	Puts the calling thread to sleep if \p word has the value \p expected, until futexWake() is called on
+	\p word. The check and the sleep happen atomically. Like with a condition variable, the thread may also
+	wake up spuriously, so the value of \p word needs to be checked again after this function has returned.
+
+	On Linux, this uses the futex system call directly. On other systems, the thread is parked in the
+	ParkingLot.
+	*/
+	NOU_FUNC void futexWait(std::atomic<uint32> &word, uint32 expected);
+
+	/**
+	\param word The word.
+	\param all  If true, all threads will be woken up, otherwise only one.
+
+	\brief Wakes up one or all threads that are waiting on \p word using futexWait().
+	*/
+	NOU_FUNC void futexWake(std::atomic<uint32> &word, boolean all = false);
+
+	template<typename VALIDATE, typename BEFORE_SLEEP>
+	boolean ParkingLot::park(const void *address, VALIDATE &&validate, BEFORE_SLEEP &&beforeSleep)
+	{
+		struct Context
+		{
+			NOU_CORE::RemoveReference_t<VALIDATE>     *m_validate;
+			NOU_CORE::RemoveReference_t<BEFORE_SLEEP> *m_beforeSleep;
+		};
+
+		Context context{ &validate, &beforeSleep };
+
+		return parkImpl(address,
+			[](void *c) -> boolean { return (*static_cast<Context*>(c)->m_validate)(); },
+			[](void *c) { (*static_cast<Context*>(c)->m_beforeSleep)(); },
+			&context);
+	}
+
+	template<typename CALLBACK>
+	UnparkResult ParkingLot::unparkOne(const void *address, CALLBACK &&callback)
+	{
+		using CallbackType = NOU_CORE::RemoveReference_t<CALLBACK>;
+
+		return unparkOneImpl(address,
+			[](void *c, const UnparkResult &result) { (*static_cast<CallbackType*>(c))(result); },
+			const_cast<void*>(static_cast<const void*>(&callback)));
+	}
+}
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef NOU_THREAD_SCHEDULER_STATISTICS_HPP
+#define NOU_THREAD_SCHEDULER_STATISTICS_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
+
+/**
+\file thread/SchedulerStatistics.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the classes that store the statistics of the thread manager.
+
+\see nostra::utils::thread::LatencyHistogram
+\see nostra::utils::thread::WorkerStatistics
+\see nostra::utils::thread::SchedulerStatistics
+*/
+
+namespace NOU::NOU_THREAD
+{
+	/**
+	\brief A histogram of durations (in nanoseconds) with logarithmic buckets.
+
+	\details
+	A histogram of durations (in nanoseconds) with logarithmic buckets. Like in an HDR histogram, each power of
+	two is split into SUB_BUCKET_COUNT linear sub-buckets. Because of that, the relative error of a value that
+	is read from the histogram (e.g. using percentile()) is at most <tt>1 / SUB_BUCKET_COUNT</tt>, regardless of
+	the magnitude of the value, while the histogram has a fixed size.
+	*/
+	class LatencyHistogram final
+	{
+	public:
+		/**
+		\brief The binary logarithm of SUB_BUCKET_COUNT.
+		*/
+		constexpr static sizeType SUB_BUCKET_BITS = 3;
+
+		/**
+		\brief The amount of buckets that each power of two is split into.
+		*/
+		constexpr static sizeType SUB_BUCKET_COUNT = sizeType(1) << SUB_BUCKET_BITS;
+
+		/**
+		\brief The total amount of buckets. This is enough to store any 64 bit value.
+		*/
+		constexpr static sizeType BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+	private:
+		/**
+		\brief The amount of values in each bucket.
+		*/
+		uint64 m_counts[BUCKET_COUNT];
+
+	public:
+		/**
+		\param value The value.
+
+		\return The index of the bucket that \p value belongs to.
+
+		\brief Returns the index of the bucket that a value belongs to.
+		*/
+		NOU_FUNC static sizeType bucketOf(uint64 value);
+
+		/**
+		\param bucket The index of the bucket.
+
+		\return The smallest value that belongs to the bucket.
+
+		\brief Returns the smallest value that belongs to a bucket.
+		*/
+		NOU_FUNC static uint64 bucketLowerBound(sizeType bucket);
+
+		/**
+		\brief Constructs an empty histogram.
+		*/
+		NOU_FUNC LatencyHistogram();
+
+		/**
+		\param value The value to record.
+
+		\brief Adds a value to the histogram.
+		*/
+		NOU_FUNC void record(uint64 value);
+
+		/**
+		\param bucket The index of the bucket.
+		\param count  The amount of values to add to the bucket.
+
+		\brief Adds an amount of values to a bucket directly.
+		*/
+		NOU_FUNC void recordBucket(sizeType bucket, uint64 count);
+
+		/**
+		\param other The histogram to add.
+
+		\brief Adds all values of another histogram to this one.
+		*/
+		NOU_FUNC void merge(const LatencyHistogram &other);
+
+		/**
+		\param bucket The index of the bucket.
+
+		\return The amount of values in the bucket.
+
+		\brief Returns the amount of values in a bucket.
+		*/
+		NOU_FUNC uint64 countAt(sizeType bucket) const;
+
+		/**
+		\return The total amount of values in the histogram.
+
+		\brief Returns the total amount of values in the histogram.
+		*/
+		NOU_FUNC uint64 totalCount() const;
+
+		/**
+		\param percentile The percentile, in the range [0, 100].
+
+		\return The lower bound of the bucket that contains the value at the passed percentile, or 0 if the
+		        histogram is empty.
+
+		\brief Returns the value at a percentile (e.g. 99 for the p99 latency).
+		*/
+		NOU_FUNC uint64 percentile(float64 percentile) const;
+	};
+
+	/**
+	\brief The statistics of a single thread of the thread manager.
+	*/
+	struct WorkerStatistics
+	{
+		/**
+		\brief The amount of tasks that the thread has executed.
+		*/
+		uint64 tasksExecuted;
+
+		/**
+		\brief The time that the thread has spent executing tasks, in nanoseconds.
+		*/
+		uint64 busyNanos;
+
+		/**
+		\brief The time that the thread has spent between tasks (spinning, sleeping or looking for a task),
+		       in nanoseconds. This is only updated when the thread starts a task.
+		*/
+		uint64 idleNanos;
+
+		/**
+		\brief The amount of tasks that the thread has stolen from other threads. This is always 0 if the
+		       scheduler mode is SchedulerMode::TASK_HEAP.
+		*/
+		uint64 steals;
+
+		/**
+		\brief The time between pushing a task and the thread starting its execution, in nanoseconds.
+		*/
+		LatencyHistogram queueLatency;
+
+		/**
+		\brief The time between the thread starting and finishing the execution of a task, in nanoseconds.
+		*/
+		LatencyHistogram executionLatency;
+
+		/**
+		\brief Constructs an instance with all values set to 0.
+		*/
+		NOU_FUNC WorkerStatistics();
+	};
+
+	/**
+	\brief A snapshot of the statistics of the thread manager, as it is returned by
+	       ThreadManager::getStatistics().
+
+	\details
+	A snapshot of the statistics of the thread manager, as it is returned by ThreadManager::getStatistics().
+
+	The statistics are only collected if the library was built with NOU_ENABLE_THREAD_INSTRUMENTATION (the
+	CMake option of the same name). Otherwise, the code that collects them is not compiled at all and the
+	snapshot is always empty.
+
+	Since the snapshot is taken while the threads keep running, the values of different threads (and the
+	counters and histograms of a single thread) may be slightly out of sync with each other.
+	*/
+	struct SchedulerStatistics
+	{
+		/**
+		\brief True, if the statistics are collected, false if not.
+		*/
+		boolean enabled;
+
+		/**
+		\brief The statistics of each thread. In SchedulerMode::TASK_HEAP, threads that have not been created
+		       yet are included as well.
+		*/
+		NOU_DAT_ALG::Vector<WorkerStatistics> workers;
+
+		/**
+		\brief The largest amount of tasks that have been stored in the task heap at the same time. This is
+		       always 0 if the scheduler mode is SchedulerMode::WORK_STEALING.
+		*/
+		sizeType heapHighWaterMark;
+
+		/**
+		\brief Constructs an empty snapshot.
+		*/
+		NOU_FUNC SchedulerStatistics();
+
+		/**
+		\return The sum of WorkerStatistics::tasksExecuted of all threads.
+
+		\brief Returns the total amount of executed tasks.
+		*/
+		NOU_FUNC uint64 totalTasksExecuted() const;
+
+		/**
+		\return The histograms WorkerStatistics::queueLatency of all threads, merged into one.
+
+		\brief Returns the queueing latency of all threads.
+		*/
+		NOU_FUNC LatencyHistogram totalQueueLatency() const;
+
+		/**
+		\return The histograms WorkerStatistics::executionLatency of all threads, merged into one.
+
+		\brief Returns the execution latency of all threads.
+		*/
+		NOU_FUNC LatencyHistogram totalExecutionLatency() const;
+	};
+}
+
+#endif
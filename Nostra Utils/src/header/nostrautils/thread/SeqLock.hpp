@@ -0,0 +1,212 @@
+#ifndef NOU_THREAD_SEQ_LOCK_HPP
+#define NOU_THREAD_SEQ_LOCK_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/thread/ParkingLot.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+/**
+\file thread/SeqLock.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::thread::SeqLock class.
+
+\see nostra::utils::thread::SeqLock
+*/
+
+namespace NOU::NOU_THREAD
+{
+	/**
+	\tparam T The type of the stored value. It needs to be trivially copyable.
+
+	\brief A value that can be read by any amount of threads without locking while other threads write it.
+
+	\details
+	A value that can be read by any amount of threads without locking while other threads write it. A sequence
+	counter is incremented before and after each write. A reader copies the value and retries if the counter
+	was odd (a write was in progress) or changed during the copy. This means that readers never write to shared
+	memory and never block writers, which makes the class a good fit for small values that are read very often
+	and only written every now and then (e.g. a transformation matrix or a set of counters).
+
+	Writers are serialized using the counter itself. Since a reader may have to retry the copy, the stored type
+	should be small.
+	*/
+	template<typename T>
+	class SeqLock final
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "The type stored in a SeqLock must be trivially copyable.");
+
+	private:
+		/**
+		\brief The sequence counter. It is odd while a write is in progress.
+		*/
+		std::atomic<uint32> m_sequence;
+
+		/**
+		\brief The stored value.
+		*/
+		T m_value;
+
+		/**
+		\return The value of the counter after it has been made odd.
+
+		\brief Waits until no other write is in progress and then makes the counter odd.
+		*/
+		uint32 beginWrite();
+
+		/**
+		\param sequence The value that was returned by beginWrite().
+
+		\brief Makes the counter even again.
+		*/
+		void endWrite(uint32 sequence);
+
+	public:
+		/**
+		\brief Constructs a new instance with a value-initialized value.
+		*/
+		SeqLock();
+
+		/**
+		\param value The initial value.
+
+		\brief Constructs a new instance with the passed value.
+		*/
+		explicit SeqLock(const T &value);
+
+		/**
+		\brief Not copy construct-able.
+		*/
+		SeqLock(const SeqLock&) = delete;
+
+		/**
+		\brief Not copy assign-able.
+		*/
+		SeqLock& operator = (const SeqLock&) = delete;
+
+		/**
+		\return A consistent copy of the value.
+
+		\brief Returns a copy of the value. If a write is in progress, this waits until it has finished.
+		*/
+		T load() const;
+
+		/**
+		\param value The new value.
+
+		\brief Replaces the value.
+		*/
+		void store(const T &value);
+
+		/**
+		\tparam F The type of \p modifier.
+
+		\param modifier An invocable with the signature <tt>void modifier(T&)</tt>. It is called with a
+		                reference to the stored value while no other thread can write.
+
+		\brief Modifies the value in place.
+		*/
+		template<typename F>
+		void modify(F &&modifier);
+	};
+
+	template<typename T>
+	uint32 SeqLock<T>::beginWrite()
+	{
+		uint32 sequence = m_sequence.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			if ((sequence & 1) == 0 && m_sequence.compare_exchange_weak(sequence, sequence + 1,
+				std::memory_order_relaxed, std::memory_order_relaxed))
+			{
+				break;
+			}
+
+			cpuRelax();
+			sequence = m_sequence.load(std::memory_order_relaxed);
+		}
+
+		//makes sure that no write to the value becomes visible before the counter is odd
+		std::atomic_thread_fence(std::memory_order_release);
+
+		return sequence + 1;
+	}
+
+	template<typename T>
+	void SeqLock<T>::endWrite(uint32 sequence)
+	{
+		m_sequence.store(sequence + 1, std::memory_order_release);
+	}
+
+	template<typename T>
+	SeqLock<T>::SeqLock() :
+		m_sequence(0),
+		m_value()
+	{}
+
+	template<typename T>
+	SeqLock<T>::SeqLock(const T &value) :
+		m_sequence(0),
+		m_value(value)
+	{}
+
+	template<typename T>
+	T SeqLock<T>::load() const
+	{
+		alignas(T) byte buffer[sizeof(T)];
+
+		while (true)
+		{
+			uint32 before = m_sequence.load(std::memory_order_acquire);
+
+			if ((before & 1) != 0)
+			{
+				cpuRelax();
+				continue;
+			}
+
+			//the copy may be torn, it is only used if the counter did not change
+			std::memcpy(buffer, &m_value, sizeof(T));
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (m_sequence.load(std::memory_order_relaxed) == before)
+				break;
+		}
+
+		T ret;
+		std::memcpy(&ret, buffer, sizeof(T));
+
+		return ret;
+	}
+
+	template<typename T>
+	void SeqLock<T>::store(const T &value)
+	{
+		uint32 sequence = beginWrite();
+
+		std::memcpy(&m_value, &value, sizeof(T));
+
+		endWrite(sequence);
+	}
+
+	template<typename T>
+	template<typename F>
+	void SeqLock<T>::modify(F &&modifier)
+	{
+		uint32 sequence = beginWrite();
+
+		modifier(m_value);
+
+		endWrite(sequence);
+	}
+}
+
+#endif
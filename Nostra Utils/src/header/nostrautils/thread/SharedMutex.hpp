@@ -0,0 +1,265 @@
+#ifndef NOU_THREAD_SHARED_MUTEX_HPP
+#define NOU_THREAD_SHARED_MUTEX_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/thread/ParkingLot.hpp"
+
+#include <atomic>
+
+/**
+\file thread/SharedMutex.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::thread::SharedMutex class.
+
+\see nostra::utils::thread::SharedMutex
+*/
+
+namespace NOU::NOU_THREAD
+{
+	/**
+	\brief An enumeration that stores the policies that decide whether readers or writers of a SharedMutex are
+	       preferred.
+	*/
+	enum class SharedMutexPolicy
+	{
+		/**
+		\brief A reader may always lock the mutex, unless a writer currently holds it. This gives the best
+		       throughput for readers, but writers may starve if there is always at least one reader.
+		*/
+		READER_PREFERRING,
+
+		/**
+		\brief As soon as a writer waits for the mutex, no new readers will be let in. Writers can not starve,
+		       but readers may have to wait even though the mutex is only locked by other readers. This is the
+		       default.
+		*/
+		WRITER_PREFERRING
+	};
+
+	/**
+	\brief A mutex that can either be locked by a single writer or by any amount of readers at the same time.
+
+	\details
+	A mutex that can either be locked exclusively by a single writer (using lock()) or shared by any amount of
+	readers at the same time (using lockShared()). This is useful for data that is read a lot more often than
+	it is written, e.g. configurations or lookup tables.
+
+	Like AdaptiveMutex, a thread spins up to SPIN_COUNT times if it can not lock the mutex immediately before it
+	goes to sleep using futexWait(). Locking and unlocking a mutex that is not contended only takes a single
+	atomic operation.
+
+	Whether readers or writers are preferred if both wait for the mutex is decided by the SharedMutexPolicy that
+	is passed to the constructor. The class SharedLock can be used to lock the mutex for reading in an RAII
+	fashion.
+	*/
+	class SharedMutex final
+	{
+	public:
+		/**
+		\brief The amount of times that a thread spins before it goes to sleep.
+		*/
+		constexpr static uint32 SPIN_COUNT = 100;
+
+	private:
+		/**
+		\brief The bit of \p m_state that is set if a writer holds the mutex. The other bits of the state store
+		       the amount of readers that hold the mutex.
+		*/
+		constexpr static uint32 WRITER_BIT = uint32(1) << 31;
+
+		/**
+		\brief The policy of the mutex.
+		*/
+		SharedMutexPolicy m_policy;
+
+		/**
+		\brief Either WRITER_BIT or the amount of readers that currently hold the mutex.
+		*/
+		std::atomic<uint32> m_state;
+
+		/**
+		\brief The amount of writers that are waiting for the mutex.
+		*/
+		std::atomic<uint32> m_waitingWriters;
+
+		/**
+		\brief The amount of threads that are sleeping (or about to sleep) on \p m_epoch.
+		*/
+		std::atomic<uint32> m_sleepers;
+
+		/**
+		\brief The word that sleeping threads wait on. It is incremented each time they are woken up.
+		*/
+		std::atomic<uint32> m_epoch;
+
+		/**
+		\return True, if the mutex was locked for reading, false if not.
+
+		\brief Tries to lock the mutex for reading while respecting the policy.
+		*/
+		boolean tryLockSharedImpl();
+
+		/**
+		\brief Spins and then sleeps until the mutex has been locked for writing.
+		*/
+		NOU_FUNC void lockSlow();
+
+		/**
+		\brief Spins and then sleeps until the mutex has been locked for reading.
+		*/
+		NOU_FUNC void lockSharedSlow();
+
+		/**
+		\brief Wakes up all sleeping threads.
+		*/
+		NOU_FUNC void wakeAll();
+
+	public:
+		/**
+		\param policy The policy of the mutex.
+
+		\brief Constructs a new, unlocked mutex.
+		*/
+		constexpr explicit SharedMutex(SharedMutexPolicy policy = SharedMutexPolicy::WRITER_PREFERRING);
+
+		/**
+		\brief Not copy construct-able.
+		*/
+		SharedMutex(const SharedMutex&) = delete;
+
+		/**
+		\brief Not copy assign-able.
+		*/
+		SharedMutex& operator = (const SharedMutex&) = delete;
+
+		/**
+		\brief Locks the mutex for writing.
+		*/
+		void lock();
+
+		/**
+		\brief Unlocks the mutex after it has been locked using lock() or tryLock().
+		*/
+		void unlock();
+
+		/**
+		\return True, if the mutex was locked, false if not.
+
+		\brief If neither a writer nor a reader holds the mutex, it will be locked for writing. Otherwise
+		       nothing will happen.
+		*/
+		boolean tryLock();
+
+		/**
+		\brief Locks the mutex for reading.
+		*/
+		void lockShared();
+
+		/**
+		\brief Unlocks the mutex after it has been locked using lockShared() or tryLockShared().
+		*/
+		void unlockShared();
+
+		/**
+		\return True, if the mutex was locked, false if not.
+
+		\brief If the mutex can be locked for reading without waiting, it will be locked. Otherwise nothing will
+		       happen.
+		*/
+		boolean tryLockShared();
+
+		/**
+		\return The policy of the mutex.
+
+		\brief Returns the policy of the mutex.
+		*/
+		SharedMutexPolicy getPolicy() const;
+	};
+
+	constexpr SharedMutex::SharedMutex(SharedMutexPolicy policy) :
+		m_policy(policy),
+		m_state(0),
+		m_waitingWriters(0),
+		m_sleepers(0),
+		m_epoch(0)
+	{}
+
+	inline boolean SharedMutex::tryLockSharedImpl()
+	{
+		uint32 state = m_state.load(std::memory_order_relaxed);
+
+		while ((state & WRITER_BIT) == 0)
+		{
+			if (m_policy == SharedMutexPolicy::WRITER_PREFERRING &&
+				m_waitingWriters.load(std::memory_order_relaxed) != 0)
+			{
+				return false;
+			}
+
+			if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire,
+				std::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline void SharedMutex::lock()
+	{
+		uint32 expected = 0;
+
+		if (!m_state.compare_exchange_strong(expected, WRITER_BIT, std::memory_order_acquire,
+			std::memory_order_relaxed))
+		{
+			lockSlow();
+		}
+	}
+
+	inline void SharedMutex::unlock()
+	{
+		//sequentially consistent, so that either this thread sees the sleeper or the sleeper sees the new state
+		m_state.store(0);
+
+		if (m_sleepers.load() != 0)
+			wakeAll();
+	}
+
+	inline boolean SharedMutex::tryLock()
+	{
+		uint32 expected = 0;
+
+		return m_state.compare_exchange_strong(expected, WRITER_BIT, std::memory_order_acquire,
+			std::memory_order_relaxed);
+	}
+
+	inline void SharedMutex::lockShared()
+	{
+		if (!tryLockSharedImpl())
+			lockSharedSlow();
+	}
+
+	inline void SharedMutex::unlockShared()
+	{
+		//only writers wait for the readers, and they only need to be woken up by the last one
+		if (m_state.fetch_sub(1) == 1 && m_sleepers.load() != 0)
+			wakeAll();
+	}
+
+	inline boolean SharedMutex::tryLockShared()
+	{
+		return tryLockSharedImpl();
+	}
+
+	inline SharedMutexPolicy SharedMutex::getPolicy() const
+	{
+		return m_policy;
+	}
+}
+
+#endif
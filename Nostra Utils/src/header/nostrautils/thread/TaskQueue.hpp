@@ -9,6 +9,7 @@
 #include "nostrautils/thread/Task.hpp"
 #include "nostrautils/dat_alg/Uninitialized.hpp"
 #include "nostrautils/dat_alg/FastQueue.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
 #include "nostrautils/thread/ConditionVariable.hpp"
 #include <type_traits>
 
@@ -228,6 +229,32 @@ namespace NOU::NOU_THREAD
 		R memberFunctionInverted(R &&previous, R &&current);
 	};
 
+	/**
+	\brief An enumeration that stores the ways in which a TaskQueue can execute its tasks.
+	*/
+	enum class TaskQueueMode
+	{
+		/**
+		\brief The tasks are executed one after another in the order in which they were pushed and the results 
+		       are accumulated in the same order. This works with any accumulator. This is the default.
+		*/
+		ORDERED,
+
+		/**
+		\brief Up to a configurable amount of tasks are executed at the same time, in no particular order. 
+
+		\details
+		Up to a configurable amount of tasks are executed at the same time, in no particular order. Each thread 
+		accumulates the results of the tasks that it executed and those partial results are combined using a 
+		tree reduction. This requires an accumulator that is associative and commutative (e.g. 
+		TaskQueueAccumulators::addition or TaskQueueAccumulators::multiply).
+
+		In this mode, the tasks do not share the error handler of the queue, since multiple tasks may run at 
+		the same time. Each task uses a handler that is provided by the thread manager instead.
+		*/
+		UNORDERED_PARALLEL
+	};
+
 	/**
 	\tparam R     The result type of the tasks that can be pushed to the queue.
 	\tparam I     The type of invocable that can be executed by the tasks that can be pushed to the queue. 
@@ -256,6 +283,10 @@ namespace NOU::NOU_THREAD
 	latest result (the result of the task that just finished execution). It is not possible to have no 
 	accumulator at all.
 
+	By default, the tasks are executed in order (see TaskQueueMode::ORDERED). If the accumulator is 
+	associative and commutative, TaskQueueMode::UNORDERED_PARALLEL can be passed to the constructor to execute 
+	multiple tasks at the same time.
+
 	\note 
 	This documentation is only those tasks that have a return type other than void. For a documentation of the
 	specialization that is used when the result type is void, see TaskQueue<void, I, ACCUM, ARGS>. 
@@ -333,11 +364,6 @@ namespace NOU::NOU_THREAD
 		*/
 		Mutex                              m_getResultMutex;
 
-		/**
-		\brief A state that is used to synchronize the method getResult() with the execution task.
-		*/
-		boolean                              m_isExecuting;
-
 		/**
 		\brief A condition variable that is used to synchronize the method getResult() with the execution 
 		       task.
@@ -399,6 +425,60 @@ namespace NOU::NOU_THREAD
 		*/
 		ExecutionTask                        m_executionTask;
 
+		/**
+		\brief The mode of the queue.
+		*/
+		TaskQueueMode                        m_mode;
+
+		/**
+		\brief The maximum amount of tasks that are executed at the same time if the mode is 
+		       TaskQueueMode::UNORDERED_PARALLEL.
+		*/
+		sizeType                             m_maxConcurrency;
+
+		/**
+		\brief The amount of instances of executeParallel() that are currently running (or about to run). 
+		       Protected by m_taskQueueMutex.
+		*/
+		sizeType                             m_activeRunners;
+
+		/**
+		\brief The condition variable that is notified (together with m_taskQueueMutex) when 
+		       \p m_activeRunners reaches 0.
+		*/
+		ConditionVariable                    m_runnersDoneVariable;
+
+		/**
+		\brief The partial results of the instances of executeParallel() that have finished. Protected by 
+		       m_resultMutex.
+		*/
+		NOU_DAT_ALG::Vector<Result>           m_partials;
+
+		/**
+		\brief The task that is pushed to the thread manager to start an instance of executeParallel(). 
+
+		\details
+		The task that is pushed to the thread manager to start an instance of executeParallel(). The task has 
+		no state of its own, hence the same instance may be pushed multiple times at once.
+		*/
+		ExecutionTask                        m_parallelTask;
+
+		/**
+		\param taskQueue The queue.
+
+		\brief Pops and executes tasks until the queue is empty and then adds the accumulated result to 
+		       \p m_partials. This is used if the mode is TaskQueueMode::UNORDERED_PARALLEL.
+		*/
+		static void executeParallel(TaskQueue *taskQueue);
+
+		/**
+		\pre Lock m_resultMutex.
+
+		\brief Combines the results in \p m_partials using a tree reduction and accumulates them into the 
+		       result.
+		*/
+		void reducePartials();
+
 		/**
 		\pre Lock m_currentTaskMutex and m_taskQueueMutex.
 
@@ -422,10 +502,15 @@ namespace NOU::NOU_THREAD
 		/**
 		\param accumulator     The accumulator that will be used by the task queue.
 		\param initialCapacity The capacity that the internal queue that stores the tasks will have.
+		\param mode            The mode of the queue.
+		\param maxConcurrency  The maximum amount of tasks that are executed at the same time if \p mode is
+		                       TaskQueueMode::UNORDERED_PARALLEL. If this is 0, 
+		                       ThreadManager::maximumAvailableThreads() is used.
 
 		\brief Constructs a new instance with the passed parameters.
 		*/
-		TaskQueue(Accumulator &&accumulator, sizeType initialCapacity = DEFAULT_INITIAL_CAPACITY);
+		TaskQueue(Accumulator &&accumulator, sizeType initialCapacity = DEFAULT_INITIAL_CAPACITY, 
+			TaskQueueMode mode = TaskQueueMode::ORDERED, sizeType maxConcurrency = 0);
 
 		/**
 		\param task The task to push.
@@ -442,7 +527,8 @@ namespace NOU::NOU_THREAD
 		\details
 		Returns the currently stored, temporary result. Unlike getResult(), this method does not force the
 		execution of all tasks that are currently in the queue, but returns the result that was produced by 
-		the last accumulation.
+		the last accumulation. If the mode is TaskQueueMode::UNORDERED_PARALLEL, only the results of those 
+		threads that have already run out of tasks are part of the result.
 
 		\note
 		This function may be expensive, as the result will be copied instead of moved or returned by
@@ -585,11 +671,6 @@ namespace NOU::NOU_THREAD
 		*/
 		Mutex                              m_getResultMutex;
 
-		/**
-		\brief A state that is used to synchronize the method getResult() with the execution task.
-		*/
-		boolean                              m_isExecuting;
-
 		/**
 		\brief A condition variable that is used to synchronize the method getResult() with the execution 
 		       task.
@@ -641,6 +722,43 @@ namespace NOU::NOU_THREAD
 		*/
 		ExecutionTask                        m_executionTask;
 
+		/**
+		\brief The mode of the queue.
+		*/
+		TaskQueueMode                        m_mode;
+
+		/**
+		\brief The maximum amount of tasks that are executed at the same time if the mode is
+		       TaskQueueMode::UNORDERED_PARALLEL.
+		*/
+		sizeType                             m_maxConcurrency;
+
+		/**
+		\brief The amount of instances of executeParallel() that are currently running (or about to run).
+		       Protected by m_taskQueueMutex.
+		*/
+		sizeType                             m_activeRunners;
+
+		/**
+		\brief The condition variable that is notified (together with m_taskQueueMutex) when
+		       \p m_activeRunners reaches 0.
+		*/
+		ConditionVariable                    m_runnersDoneVariable;
+
+		/**
+		\brief The task that is pushed to the thread manager to start an instance of executeParallel(). It has
+		       no state of its own, hence the same instance may be pushed multiple times at once.
+		*/
+		ExecutionTask                        m_parallelTask;
+
+		/**
+		\param taskQueue The queue.
+
+		\brief Pops and executes tasks until the queue is empty. This is used if the mode is
+		       TaskQueueMode::UNORDERED_PARALLEL.
+		*/
+		static void executeParallel(TaskQueue *taskQueue);
+
 		/**
 		\pre Lock m_currentTaskMutex and m_taskQueueMutex.
 
@@ -658,17 +776,27 @@ namespace NOU::NOU_THREAD
 		\param accumulator     A dummy parameter without any effect. This is just here for compatibility with 
 		                       the class that uses any non-void type as result type.
 		\param initialCapacity The capacity that the internal queue that stores the tasks will have.
+		\param mode            The mode of the queue.
+		\param maxConcurrency  The maximum amount of tasks that are executed at the same time if \p mode is
+		                       TaskQueueMode::UNORDERED_PARALLEL. If this is 0,
+		                       ThreadManager::maximumAvailableThreads() is used.
 
 		\brief Constructs a new instance with the passed parameters.
 		*/
-		TaskQueue(Accumulator &&accumulator, sizeType initialCapacity = DEFAULT_INITIAL_CAPACITY);
+		TaskQueue(Accumulator &&accumulator, sizeType initialCapacity = DEFAULT_INITIAL_CAPACITY,
+			TaskQueueMode mode = TaskQueueMode::ORDERED, sizeType maxConcurrency = 0);
 
 		/**
 		\param initialCapacity The capacity that the internal queue that stores the tasks will have.
+		\param mode            The mode of the queue.
+		\param maxConcurrency  The maximum amount of tasks that are executed at the same time if \p mode is
+		                       TaskQueueMode::UNORDERED_PARALLEL. If this is 0,
+		                       ThreadManager::maximumAvailableThreads() is used.
 
 		\brief Constructs a new instance with the passed initial capacity.
 		*/
-		TaskQueue(sizeType initialCapacity = DEFAULT_INITIAL_CAPACITY);
+		TaskQueue(sizeType initialCapacity = DEFAULT_INITIAL_CAPACITY, 
+			TaskQueueMode mode = TaskQueueMode::ORDERED, sizeType maxConcurrency = 0);
 
 		TaskQueue& pushTask(TaskType &&task);
 
@@ -785,8 +913,6 @@ namespace NOU::NOU_THREAD
 	template<typename R, typename I, typename ACCUM, typename... ARGS>
 	void TaskQueue<R, I, ACCUM, ARGS...>::executeTask(TaskQueue<R, I, ACCUM, ARGS...> *taskQueue)
 	{
-		taskQueue->m_isExecuting = true;
-
 		NOU_DAT_ALG::Uninitialized<TaskType> tempTask;
 
 		{
@@ -812,37 +938,101 @@ namespace NOU::NOU_THREAD
 			taskQueue->accumulate(NOU_CORE::move(result));
 		}
 
-		boolean stopParalleExecution;
+		Lock taskQueueLock(taskQueue->m_taskQueueMutex);
+		Lock currentTaskLock(taskQueue->m_currentTaskMutex);
+
+		//the task only counts as done once it has been destroyed, getResult() waits for that
+		taskQueue->m_currentTask.destroy();
+
+		boolean stopParallelExecution;
 
 		{
 			Lock lock(taskQueue->m_getResultMutex);
-			stopParalleExecution = taskQueue->m_stopParallelExecution;
+			stopParallelExecution = taskQueue->m_stopParallelExecution;
 		}
 
-		if (!stopParalleExecution)
+		if (!stopParallelExecution)
+			taskQueue->updateExecutingTask();
+		else
+			taskQueue->m_getResultVariable.notifyAll();
+	}
+
+	template<typename R, typename I, typename ACCUM, typename... ARGS>
+	void TaskQueue<R, I, ACCUM, ARGS...>::executeParallel(TaskQueue<R, I, ACCUM, ARGS...> *taskQueue)
+	{
+		NOU_DAT_ALG::Uninitialized<Result> partial;
+
+		while (true)
 		{
-			Lock taskQueueLock(taskQueue->m_taskQueueMutex);
-			Lock currentTaskLock(taskQueue->m_currentTaskMutex);
+			NOU_DAT_ALG::Uninitialized<TaskType> task;
 
-			taskQueue->m_currentTask.destroy();
+			{
+				Lock lock(taskQueue->m_taskQueueMutex);
 
-			taskQueue->updateExecutingTask();
+				if (taskQueue->m_taskQueue.size() == 0)
+				{
+					//publish the partial result before the runner counts as done
+					if (partial.isValid())
+					{
+						Lock resultLock(taskQueue->m_resultMutex);
+						taskQueue->m_partials.pushBack(NOU_CORE::move(*partial));
+					}
+
+					taskQueue->m_activeRunners--;
+
+					if (taskQueue->m_activeRunners == 0)
+						taskQueue->m_runnersDoneVariable.notifyAll();
+
+					return;
+				}
+
+				task = taskQueue->m_taskQueue.popFront();
+			}
+
+			task->execute();
+
+			if (partial.isValid())
+				partial = taskQueue->m_accumulator(NOU_CORE::move(*partial), task->moveResult());
+			else
+				partial = task->moveResult();
 		}
-		else
+	}
+
+	template<typename R, typename I, typename ACCUM, typename... ARGS>
+	void TaskQueue<R, I, ACCUM, ARGS...>::reducePartials()
+	{
+		sizeType count = m_partials.size();
+
+		if (count == 0)
+			return;
+
+		//combine neighbors, then neighbors of neighbors, ...
+		for (sizeType step = 1; step < count; step *= 2)
 		{
-			taskQueue->m_getResultVariable.notifyAll();
+			for (sizeType i = 0; i + step < count; i += 2 * step)
+			{
+				m_partials[i] = m_accumulator(NOU_CORE::move(m_partials[i]), 
+					NOU_CORE::move(m_partials[i + step]));
+			}
 		}
 
-		taskQueue->m_isExecuting = false;
+		accumulate(NOU_CORE::move(m_partials[0]));
+
+		m_partials.clear();
 	}
 
 	template<typename R, typename I, typename ACCUM, typename... ARGS>
-	TaskQueue<R, I, ACCUM, ARGS...>::TaskQueue(Accumulator &&accumulator, sizeType initialCapacity) :
+	TaskQueue<R, I, ACCUM, ARGS...>::TaskQueue(Accumulator &&accumulator, sizeType initialCapacity, 
+		TaskQueueMode mode, sizeType maxConcurrency) :
 		m_accumulator(NOU_CORE::move(accumulator)),
 		m_taskQueue(initialCapacity),
 		m_closed(false),
 		m_stopParallelExecution(false),
-		m_executionTask(&executeTask, this)
+		m_executionTask(&executeTask, this),
+		m_mode(mode),
+		m_maxConcurrency(maxConcurrency == 0 ? getThreadManager().maximumAvailableThreads() : maxConcurrency),
+		m_activeRunners(0),
+		m_parallelTask(&executeParallel, this)
 	{}
 
 	template<typename R, typename I, typename ACCUM, typename... ARGS>
@@ -881,6 +1071,19 @@ namespace NOU::NOU_THREAD
 			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_STATE, 
 				"The queue has been closed.");
 		}
+		else if (m_mode == TaskQueueMode::UNORDERED_PARALLEL)
+		{
+			Lock taskQueueMutex(m_taskQueueMutex);
+
+			m_taskQueue.push(NOU_CORE::move(task));
+
+			//if the limit has been reached, the running instances will pick up the task
+			if (m_activeRunners < m_maxConcurrency)
+			{
+				m_activeRunners++;
+				getThreadManager().pushTask(&m_parallelTask, 0);
+			}
+		}
 		else
 		{
 			Lock taskQueueMutex(m_taskQueueMutex);
@@ -901,6 +1104,8 @@ namespace NOU::NOU_THREAD
 	{
 		Lock lock(m_resultMutex);
 
+		reducePartials();
+
 		Result ret = *m_result;
 
 		return ret;
@@ -910,15 +1115,36 @@ namespace NOU::NOU_THREAD
 	const typename TaskQueue<R, I, ACCUM, ARGS...>::Result& 
 		TaskQueue<R, I, ACCUM, ARGS...>::getResult()
 	{
+		if (m_mode == TaskQueueMode::UNORDERED_PARALLEL)
+		{
+			//the calling thread helps executing the remaining tasks
+			{
+				Lock lock(m_taskQueueMutex);
+				m_activeRunners++;
+			}
+
+			executeParallel(this);
+
+			{
+				UniqueLock lock(m_taskQueueMutex);
+				m_runnersDoneVariable.wait(lock, [this]() { return m_activeRunners == 0; });
+			}
+
+			Lock lock(m_resultMutex);
+
+			reducePartials();
+
+			return *m_result;
+		}
+
 		{
 			Lock lock(m_getResultMutex);
 			m_stopParallelExecution = true;
 		}
 
 		{
-			Mutex mutex;
-			UniqueLock lock(mutex);
-			m_getResultVariable.wait(lock, [this]() { return !(this->m_isExecuting); });
+			UniqueLock lock(m_currentTaskMutex);
+			m_getResultVariable.wait(lock, [this]() { return !(this->m_currentTask.isValid()); });
 		}
 
 		{
@@ -938,6 +1164,13 @@ namespace NOU::NOU_THREAD
 			m_stopParallelExecution = false;
 		}
 
+		{
+			//a task that finished while the flag was set did not schedule its successor
+			Lock taskQueueLock(m_taskQueueMutex);
+			Lock currentTaskLock(m_currentTaskMutex);
+			updateExecutingTask();
+		}
+
 		return *m_result;
 	}
 
@@ -955,8 +1188,6 @@ namespace NOU::NOU_THREAD
 	template<typename I, typename ACCUM, typename... ARGS>
 	void TaskQueue<void, I, ACCUM, ARGS...>::executeTask(TaskQueue<void, I, ACCUM, ARGS...> *taskQueue)
 	{
-		taskQueue->m_isExecuting = true;
-
 		NOU_DAT_ALG::Uninitialized<TaskType> tempTask;
 
 		{
@@ -975,6 +1206,12 @@ namespace NOU::NOU_THREAD
 
 		tempTask->execute();
 
+		Lock taskQueueLock(taskQueue->m_taskQueueMutex);
+		Lock currentTaskLock(taskQueue->m_currentTaskMutex);
+
+		//the task only counts as done once it has been destroyed, getResult() waits for that
+		taskQueue->m_currentTask.destroy();
+
 		boolean stopParallelExecution;
 
 		{
@@ -983,33 +1220,55 @@ namespace NOU::NOU_THREAD
 		}
 
 		if (!stopParallelExecution)
-		{
-			Lock taskQueueLock(taskQueue->m_taskQueueMutex);
-			Lock currentTaskLock(taskQueue->m_currentTaskMutex);
-
-			taskQueue->m_currentTask.destroy();
-
 			taskQueue->updateExecutingTask();
-		}
 		else
-		{
 			taskQueue->m_getResultVariable.notifyAll();
-		}
+	}
+
+	template<typename I, typename ACCUM, typename... ARGS>
+	void TaskQueue<void, I, ACCUM, ARGS...>::executeParallel(TaskQueue<void, I, ACCUM, ARGS...> *taskQueue)
+	{
+		while (true)
+		{
+			NOU_DAT_ALG::Uninitialized<TaskType> task;
+
+			{
+				Lock lock(taskQueue->m_taskQueueMutex);
+
+				if (taskQueue->m_taskQueue.size() == 0)
+				{
+					taskQueue->m_activeRunners--;
+
+					if (taskQueue->m_activeRunners == 0)
+						taskQueue->m_runnersDoneVariable.notifyAll();
+
+					return;
+				}
+
+				task = taskQueue->m_taskQueue.popFront();
+			}
 
-		taskQueue->m_isExecuting = false;
+			task->execute();
+		}
 	}
 
 	template<typename I, typename ACCUM, typename... ARGS>
-	TaskQueue<void, I, ACCUM, ARGS...>::TaskQueue(Accumulator &&accumulator, sizeType initialCapacity) :
-		TaskQueue(initialCapacity)
+	TaskQueue<void, I, ACCUM, ARGS...>::TaskQueue(Accumulator &&accumulator, sizeType initialCapacity,
+		TaskQueueMode mode, sizeType maxConcurrency) :
+		TaskQueue(initialCapacity, mode, maxConcurrency)
 	{}
 
 	template<typename I, typename ACCUM, typename... ARGS>
-	TaskQueue<void, I, ACCUM, ARGS...>::TaskQueue(sizeType initialCapacity) :
+	TaskQueue<void, I, ACCUM, ARGS...>::TaskQueue(sizeType initialCapacity, TaskQueueMode mode, 
+		sizeType maxConcurrency) :
 		m_taskQueue(initialCapacity),
 		m_closed(false),
 		m_stopParallelExecution(false),
-		m_executionTask(&executeTask, this)
+		m_executionTask(&executeTask, this),
+		m_mode(mode),
+		m_maxConcurrency(maxConcurrency == 0 ? getThreadManager().maximumAvailableThreads() : maxConcurrency),
+		m_activeRunners(0),
+		m_parallelTask(&executeParallel, this)
 	{}
 
 	template<typename I, typename ACCUM, typename... ARGS>
@@ -1030,6 +1289,19 @@ namespace NOU::NOU_THREAD
 			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_STATE,
 				"The queue has been closed.");
 		}
+		else if (m_mode == TaskQueueMode::UNORDERED_PARALLEL)
+		{
+			Lock taskQueueMutex(m_taskQueueMutex);
+
+			m_taskQueue.push(NOU_CORE::move(task));
+
+			//start another instance unless the limit has been reached
+			if (m_activeRunners < m_maxConcurrency)
+			{
+				m_activeRunners++;
+				getThreadManager().pushTask(&m_parallelTask, 0);
+			}
+		}
 		else
 		{
 			Lock taskQueueMutex(m_taskQueueMutex);
@@ -1052,15 +1324,30 @@ namespace NOU::NOU_THREAD
 	template<typename I, typename ACCUM, typename... ARGS>
 	void TaskQueue<void, I, ACCUM, ARGS...>::getResult()
 	{
+		if (m_mode == TaskQueueMode::UNORDERED_PARALLEL)
+		{
+			//the calling thread helps executing the remaining tasks
+			{
+				Lock lock(m_taskQueueMutex);
+				m_activeRunners++;
+			}
+
+			executeParallel(this);
+
+			UniqueLock lock(m_taskQueueMutex);
+			m_runnersDoneVariable.wait(lock, [this]() { return m_activeRunners == 0; });
+
+			return;
+		}
+
 		{
 			Lock lock(m_getResultMutex);
 			m_stopParallelExecution = true;
 		}
 
 		{
-			Mutex mutex;
-			UniqueLock lock(mutex);
-			m_getResultVariable.wait(lock, [this]() { return !(this->m_isExecuting); });
+			UniqueLock lock(m_currentTaskMutex);
+			m_getResultVariable.wait(lock, [this]() { return !(this->m_currentTask.isValid()); });
 		}
 
 		{
@@ -1077,6 +1364,13 @@ namespace NOU::NOU_THREAD
 			Lock lock(m_getResultMutex);
 			m_stopParallelExecution = false;
 		}
+
+		{
+			//a task that finished while the flag was set did not schedule its successor
+			Lock taskQueueLock(m_taskQueueMutex);
+			Lock currentTaskLock(m_currentTaskMutex);
+			updateExecutingTask();
+		}
 	}
 
 	template<typename I, typename ACCUM, typename... ARGS>
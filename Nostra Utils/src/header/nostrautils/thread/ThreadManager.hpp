@@ -7,10 +7,15 @@
 #include "nostrautils/dat_alg/Utils.hpp"
 #include "nostrautils/thread/ThreadWrapper.hpp"
 #include "nostrautils/thread/Task.hpp"
+#include "nostrautils/thread/InlineTask.hpp"
 #include "nostrautils/thread/Mutex.hpp"
 #include "nostrautils/thread/ConditionVariable.hpp"
+#include "nostrautils/thread/Topology.hpp"
+#include "nostrautils/thread/SchedulerStatistics.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
 #include  "nostrautils/dat_alg/FwdDcl.hpp"
 
+#include <atomic>
 #include <iostream>
 
 /**
@@ -38,13 +43,137 @@ namespace NOU::NOU_THREAD
 	*/
 	NOU_FUNC ThreadManager& getThreadManager();
 
+	/**
+	\brief An enumeration that stores the scheduling strategies that the thread manager supports.
+	*/
+	enum class SchedulerMode
+	{
+		/**
+		\brief All tasks that can not be executed immediately are stored in a single priority heap that is 
+		       protected by a mutex. Threads are created lazily when a task is pushed. This is the default.
+		*/
+		TASK_HEAP,
+
+		/**
+		\brief Each thread owns a set of lock-free deques (one per priority band). A thread pushes tasks that 
+		       it creates itself into its own deques and idle threads steal tasks from the deques of other 
+		       threads. All threads are created when the thread manager is constructed.
+		*/
+		WORK_STEALING
+	};
+
+	/**
+	\brief An enumeration that stores the ways in which the threads of the thread manager can be bound to CPUs.
+	*/
+	enum class ThreadAffinity
+	{
+		/**
+		\brief The threads are not bound to any CPU, the operating system is free to move them around. This is
+		       the default.
+		*/
+		NONE,
+
+		/**
+		\brief Each thread is bound to a single CPU. The CPUs are assigned node by node (see
+		       Topology::cpuAt()), so that threads with neighboring indices share a NUMA node.
+		*/
+		CPU,
+
+		/**
+		\brief Each thread is bound to all CPUs of a single NUMA node. The nodes are assigned in the same way as
+		       with ThreadAffinity::CPU, but the operating system may still move a thread within its node.
+		*/
+		NUMA_NODE
+	};
+
+	/**
+	\brief A struct with variables that control how the thread manager is constructed.
+
+	\details
+	A struct with variables that control how the thread manager is constructed. An instance of this struct
+	can be passed to ThreadManager::configure() before the thread manager is obtained for the first time.
+	*/
+	struct ThreadManagerConfiguration
+	{
+		/**
+		\brief The scheduling strategy that the thread manager will use. By default, this is 
+		       SchedulerMode::TASK_HEAP.
+		*/
+		SchedulerMode schedulerMode;
+
+		/**
+		\brief The amount of threads that the thread manager will use. If this is 0 (the default), the amount
+		       is derived from ThreadWrapper::maxThreads().
+		*/
+		sizeType threadCount;
+
+		/**
+		\brief How the threads are bound to CPUs if \p affinityMasks is empty. By default, this is
+		       ThreadAffinity::NONE.
+		*/
+		ThreadAffinity threadAffinity;
+
+		/**
+		\brief Explicit CPU masks for the threads. If this is not empty, the thread with the index \p i is bound
+		       to the mask with the index <tt>i % affinityMasks.size()</tt> and \p threadAffinity is ignored.
+		       By default, this is empty.
+		*/
+		NOU_DAT_ALG::Vector<CpuSet> affinityMasks;
+
+		/**
+		\brief The prefix of the names of the threads, the index of the thread is appended to it (e.g.
+		       "nou-worker-3"). If this is <tt>nullptr</tt>, the threads are not named. The string must stay
+		       valid as long as the thread manager creates new threads. By default, this is "nou-worker".
+		*/
+		const char *threadNamePrefix;
+
+		/**
+		\brief If true, a worker of SchedulerMode::WORK_STEALING tries to steal from workers on its own NUMA
+		       node before it steals from workers on other nodes. This only has an effect if the threads are
+		       bound to CPUs and the system has more than one node. By default, this is true.
+		*/
+		boolean preferLocalStealing;
+
+		/**
+		\brief The amount of times that an idle thread checks for a new task (using cpuRelax() in between)
+		       before it starts yielding. By default, this is 0.
+
+		\details
+		The amount of times that an idle thread checks for a new task (using cpuRelax() in between) before it
+		starts yielding. A task that is pushed while a thread spins or yields is picked up without the need to
+		wake the thread up, which lowers the latency of the dispatch at the cost of CPU time.
+		*/
+		uint32 idleSpinCount;
+
+		/**
+		\brief The amount of times that an idle thread checks for a new task (yielding its time slice in 
+		       between) after it has spun and before it goes to sleep. By default, this is 0.
+		*/
+		uint32 idleYieldCount;
+
+		/**
+		\brief If true, all threads of SchedulerMode::TASK_HEAP are created by a background thread as soon as
+		       the thread manager has been constructed, instead of being created when they are first needed.
+		       By default, this is false.
+		*/
+		boolean prespawnThreads;
+
+		/**
+		\brief Constructs a new instance with the default values.
+		*/
+		NOU_FUNC ThreadManagerConfiguration();
+	};
+
 	/**
 	\brief The thread management system that is used by Nostra.
 
 	\details
-	The thread management system that is used by Nostra. This class is designed as a singleton and no new 
-	thread managers can be constructed by a user. To obtain a reference to an already pre-constructed thread
-	manager, getThreadManager() should be used.
+	The thread management system that is used by Nostra. This class is designed as a singleton, to obtain a 
+	reference to an already pre-constructed thread manager, getThreadManager() should be used.
+
+	Additional thread managers that are independent of the singleton can be constructed using 
+	ThreadManager(const ThreadManagerConfiguration&). Tasks can be pushed to those directly, but AsyncTaskResult,
+	TaskQueue and the other utilities always use the singleton.
 
 	To execute functionality in a different thread, the thread manager uses the Task class.
 
@@ -60,7 +189,7 @@ namespace NOU::NOU_THREAD
 	//	static ThreadManager s_instance;
 
 		/**
-		\brief The default constructor.
+		\brief Constructs the singleton with the configuration that was passed to configure().
 
 		\warning
 		This constructor must always be called from the main thread.
@@ -78,6 +207,25 @@ namespace NOU::NOU_THREAD
 		ThreadManager(ThreadManager&&) = delete;
 
 	public:
+		/**
+		\param configuration The configuration to construct the thread manager with.
+
+		\brief Constructs a thread manager that is independent of the singleton.
+
+		\details
+		Constructs a thread manager that is independent of the singleton. It has its own threads (or workers)
+		and the passed configuration is used as-is. This is mostly useful to run tasks with a different 
+		configuration than the one of the singleton, e.g. in tests.
+
+		The threads of this thread manager use its error handlers, NOU_CORE::getErrorHandler() works as usual
+		when it is called by them.
+
+		\warning
+		The singleton must have been obtained at least once before this constructor is called and the instance
+		must be destroyed before the singleton.
+		*/
+		NOU_FUNC explicit ThreadManager(const ThreadManagerConfiguration &configuration);
+
 		/**
 		\brief Another way to obtain the thread manager instance.
 
@@ -91,6 +239,20 @@ namespace NOU::NOU_THREAD
 		The first time that this method is called must be done from the main thread.
 		*/
 		NOU_FUNC static ThreadManager& get();
+
+		/**
+		\param configuration The configuration to construct the thread manager with.
+
+		\return True, if the configuration was applied, false if the thread manager has already been 
+		        constructed.
+
+		\brief Sets the configuration that the thread manager will be constructed with.
+
+		\warning
+		This method must be called from the main thread before the thread manager is obtained for the first
+		time. Once the thread manager has been constructed, its configuration can not be changed anymore.
+		*/
+		NOU_FUNC static boolean configure(const ThreadManagerConfiguration &configuration);
 	//End of singleton parts
 
 		/**
@@ -159,6 +321,22 @@ namespace NOU::NOU_THREAD
 		*/
 		constexpr static sizeType DEFAULT_TASK_CAPACITY = 50;
 
+		/**
+		\brief The amount of priority bands that are used by SchedulerMode::WORK_STEALING.
+
+		\details
+		The amount of priority bands that are used by SchedulerMode::WORK_STEALING. A task with the priority
+		\p p is placed in the band <tt>min(p, PRIORITY_BAND_COUNT - 1)</tt>. Tasks in a band with a lower 
+		index are always preferred over tasks in a band with a higher index, but the order of the tasks within
+		a single band is not strictly specified.
+		*/
+		constexpr static sizeType PRIORITY_BAND_COUNT = 4;
+
+		/**
+		\brief The priority that is used by submit().
+		*/
+		constexpr static Priority DEFAULT_PRIORITY = 0;
+
 	private:
 		/**
 		\tparam The type of elements that is stored in the object pool.
@@ -169,13 +347,38 @@ namespace NOU::NOU_THREAD
 		using ObjectPoolPtr = NOU_MEM_MNGT::UniquePtr<NOU_DAT_ALG::ObjectPool<T, 
 			NOU_MEM_MNGT::GenericAllocationCallback>>;
 
-		NOU_DEFINE_PAIR(TaskErrorHandlerPairTempl, task, handler)
-
 		/**
-		\brief A pair of an AbstractTask* and NOU_CORE::ErrorHandler*.
+		\brief A pair of an AbstractTask* and NOU_CORE::ErrorHandler*. If NOU_ENABLE_THREAD_INSTRUMENTATION is 
+		       defined, the time at which the pair was created (which is the time at which the task was pushed) 
+		       is stored as well.
 		*/
-		using TaskErrorHandlerPair = TaskErrorHandlerPairTempl<internal::AbstractTask*, 
-			NOU_CORE::ErrorHandler*>;
+		struct TaskErrorHandlerPair
+		{
+			/**
+			\brief The task.
+			*/
+			internal::AbstractTask *task;
+
+			/**
+			\brief The handler of the task.
+			*/
+			NOU_CORE::ErrorHandler *handler;
+
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+			/**
+			\brief The time at which the pair was created, in nanoseconds.
+			*/
+			uint64 enqueueTime;
+#endif
+
+			/**
+			\param task    The task.
+			\param handler The handler of the task.
+
+			\brief Constructs a new instance.
+			*/
+			TaskErrorHandlerPair(internal::AbstractTask *task, NOU_CORE::ErrorHandler *handler);
+		};
 
 		/**
 		\brief The data that is always bundled together with a thread.
@@ -209,7 +412,7 @@ namespace NOU::NOU_THREAD
 			\brief The mutex that is used (together with \p m_mutex and \p m_variable) to make the thread
 			wait for a new task when no task is available.
 			*/
-			boolean              m_taskReady;
+			std::atomic<boolean> m_taskReady;
 
 			/**
 			\param thread The thread that is stored by this bundle.
@@ -228,6 +431,8 @@ namespace NOU::NOU_THREAD
 
 		/**
 		\param threadManager   The thread manager (both phases)
+		\param index           The index of the thread, used to apply the affinity and the name (startup 
+		                       phase)
 		\param threadData	   The thread data bundle (loop phase)
 		\param startupMutex	   The startup mutex to synchronize the startup with the function that starts the 
 		                       thread. (startup phase)
@@ -258,14 +463,84 @@ namespace NOU::NOU_THREAD
 			</li>
 		</ul> 
 		*/
-		NOU_FUNC static void threadLoop(ThreadManager *threadManager, ThreadDataBundle **threadData,
-			Mutex *startupMutex, ConditionVariable *startupVariable, boolean *startupDone);
+		NOU_FUNC static void threadLoop(ThreadManager *threadManager, sizeType index, 
+			ThreadDataBundle **threadData, Mutex *startupMutex, ConditionVariable *startupVariable, 
+			boolean *startupDone);
+
+		/**
+		\param index The index of the thread.
+
+		\return The CPUs that the thread with the passed index will be bound to. If the thread will not be
+		        bound, the set is empty.
+
+		\brief Returns the CPUs that a thread will be bound to according to the configuration.
+		*/
+		CpuSet affinityOf(sizeType index) const;
+
+		/**
+		\param index The index of the thread.
+
+		\brief Applies the affinity and the name from the configuration to the calling thread. This is called
+		       by each thread of the manager when it starts.
+		*/
+		void setupThread(sizeType index) const;
+
+		/**
+		\brief The data of a single thread that is used by SchedulerMode::WORK_STEALING. Defined in 
+		       ThreadManager.cpp.
+		*/
+		struct WorkStealingWorker;
+
+		/**
+		\brief The worker that the calling thread belongs to, or <tt>nullptr</tt> if the calling thread is not
+		       a worker of SchedulerMode::WORK_STEALING.
+		*/
+		static thread_local WorkStealingWorker *s_currentWorker;
+
+		/**
+		\brief The thread manager that the calling thread belongs to, or <tt>nullptr</tt> if the calling 
+		       thread was not created by a thread manager.
+		*/
+		static thread_local ThreadManager *s_currentThreadManager;
+
+		/**
+		\return The worker of this thread manager that the calling thread belongs to, or <tt>nullptr</tt>.
+
+		\brief Returns \p s_currentWorker, if the calling thread is a worker of this thread manager.
+		*/
+		WorkStealingWorker* currentWorker() const;
+
+		/**
+		\param threadManager The thread manager.
+		\param worker        The worker that the thread belongs to.
+
+		\brief The method that will be executed by the single threads if the thread manager uses 
+		       SchedulerMode::WORK_STEALING.
+
+		\details
+		The method that will be executed by the single threads if the thread manager uses 
+		SchedulerMode::WORK_STEALING. The method waits until all workers have been created and then loops 
+		until the thread manager shuts down. During this loop, the method will
+		<ul>
+			<li>Search for a task in the own deques and inbox, starting with the most urgent priority 
+			    band</li>
+			<li>If there is none, try to steal a task of the same band from other, randomly chosen, 
+			    workers</li>
+			<li>Execute the task, or park the thread if no task could be found at all</li>
+		</ul>
+		*/
+		static void workStealingLoop(ThreadManager *threadManager, WorkStealingWorker *worker);
+
+		/**
+		\brief The configuration that the thread manager was constructed with.
+		*/
+		ThreadManagerConfiguration m_configuration;
 
 		/**
 		\brief True, if the thread manager is in the shutdown process. If this value is set to true, the 
 		       running threads will stop execution as soon as possible.
 		*/
-		boolean m_shouldShutdown;
+		std::atomic<boolean> m_shouldShutdown;
 
 		/**
 		\brief The pool that is used to store the threads. This pool can store no more than 
@@ -288,7 +563,7 @@ namespace NOU::NOU_THREAD
 		\brief A map that stores the ID of the different threads with the error handler that is currently
 		associated with that thread.
 		*/
-		NOU_MEM_MNGT::UniquePtr<NOU_DAT_ALG::HashMap<typename ThreadWrapper::ID, 
+		NOU_MEM_MNGT::UniquePtr<NOU_DAT_ALG::ConcurrentHashMap<typename ThreadWrapper::ID, 
 			NOU_CORE::ErrorHandler*>> m_handlersMap;
 
 		/**
@@ -309,9 +584,53 @@ namespace NOU::NOU_THREAD
 		/**
 		\brief Creates the value for \p m_handlersMap.
 		*/
-		NOU_MEM_MNGT::UniquePtr<NOU_DAT_ALG::HashMap<typename ThreadWrapper::ID, 
+		NOU_MEM_MNGT::UniquePtr<NOU_DAT_ALG::ConcurrentHashMap<typename ThreadWrapper::ID, 
 			NOU_CORE::ErrorHandler*>> makeHandlersMap();
 
+		/**
+		\brief The workers that are used by SchedulerMode::WORK_STEALING. If another mode is used, this is
+		       <tt>nullptr</tt>.
+		*/
+		WorkStealingWorker **m_workers;
+
+		/**
+		\brief The amount of elements in \p m_workers.
+		*/
+		sizeType m_workerCount;
+
+		/**
+		\brief True, if the workers prefer to steal from workers on the same NUMA node.
+		*/
+		boolean m_preferLocalStealing;
+
+		/**
+		\brief The amount of workers that are currently parked (or about to park).
+		*/
+		std::atomic<sizeType> m_idleWorkers;
+
+		/**
+		\brief A counter that is used to distribute tasks that are pushed by threads which are not workers 
+		       across the inboxes of the workers.
+		*/
+		std::atomic<sizeType> m_nextInboxIndex;
+
+		/**
+		\brief The mutex that is used (together with \p m_workersStartedVariable and \p m_workersStarted) to 
+		       make the workers wait until all of them have been created.
+		*/
+		Mutex m_workersStartedMutex;
+
+		/**
+		\brief The condition variable that is used (together with \p m_workersStartedMutex and 
+		       \p m_workersStarted) to make the workers wait until all of them have been created.
+		*/
+		ConditionVariable m_workersStartedVariable;
+
+		/**
+		\brief True, if all workers have been created.
+		*/
+		boolean m_workersStarted;
+
 		/**
 		\brief The mutex that is used to control the access to \p m_threads.
 		*/
@@ -371,6 +690,169 @@ namespace NOU::NOU_THREAD
 		\brief Returns the passed handler to the handler pool.
 		*/
 		NOU_FUNC void giveBackHandler(NOU_CORE::ErrorHandler &handler);
+
+		/**
+		\brief Creates and starts the workers that are used by SchedulerMode::WORK_STEALING.
+		*/
+		void makeWorkStealingWorkers();
+
+		/**
+		\param task     The task to push.
+		\param priority The priority of the task.
+
+		\brief Pushes a task to the deque of the calling worker or, if the calling thread is not a worker, to
+		       the inbox of a worker.
+
+		\pre The thread manager uses SchedulerMode::WORK_STEALING.
+		*/
+		void pushWorkStealingTask(const TaskErrorHandlerPair &task, Priority priority);
+
+		/**
+		\param tasks    The tasks.
+		\param count    The amount of tasks.
+		\param priority The priority of the tasks.
+		\param handler  The handler of the tasks.
+
+		\brief The implementation of pushTasks() for SchedulerMode::WORK_STEALING.
+
+		\pre The thread manager uses SchedulerMode::WORK_STEALING.
+		*/
+		void pushWorkStealingTasks(internal::AbstractTask *const *tasks, sizeType count, Priority priority,
+			NOU_CORE::ErrorHandler *handler);
+
+		/**
+		\param worker The worker that searches for a task.
+		\param out    The object that the found task will be stored in.
+
+		\return True, if a task was found, false if not.
+
+		\brief Searches for a task in the deques and inboxes of all workers, starting with the most urgent 
+		       priority band and the deques and inbox of \p worker.
+		*/
+		boolean findWorkStealingTask(WorkStealingWorker &worker, TaskErrorHandlerPair &out);
+
+		/**
+		\brief Wakes up a single parked worker (if there is one).
+		*/
+		void wakeWorkStealingWorker();
+
+		/**
+		\param worker The worker that searches for a task.
+		\param out    The object that the found task will be stored in.
+
+		\return True, if a task was found, false if not.
+
+		\brief Repeatedly searches for a task as configured by ThreadManagerConfiguration::idleSpinCount and
+		       ThreadManagerConfiguration::idleYieldCount.
+		*/
+		boolean spinForWorkStealingTask(WorkStealingWorker &worker, TaskErrorHandlerPair &out);
+
+		/**
+		\param threadData The data of the thread that waits for a task.
+
+		\return True, if a task is ready or the thread manager shuts down, false if the thread needs to sleep.
+
+		\brief Spins and yields as configured by ThreadManagerConfiguration::idleSpinCount and 
+		       ThreadManagerConfiguration::idleYieldCount until a task is ready for the passed thread.
+		*/
+		boolean spinForTask(ThreadDataBundle &threadData);
+
+		/**
+		\param threadManager The thread manager.
+
+		\brief The method that is executed by \p m_prespawnThread. It creates one thread after another until
+		       the pool is full.
+		*/
+		static void prespawnLoop(ThreadManager *threadManager);
+
+		/**
+		\brief The thread that creates the threads of the pool if ThreadManagerConfiguration::prespawnThreads
+		       is true, or <tt>nullptr</tt>.
+		*/
+		ThreadWrapper *m_prespawnThread;
+
+		/**
+		\brief A task that was submitted using submitTask(). Defined in ThreadManager.cpp.
+		*/
+		class SubmittedTask;
+
+		/**
+		\brief The pool that the tasks that are submitted using submitTask() are stored in. Defined in 
+		       ThreadManager.cpp.
+		*/
+		struct SubmittedTaskPool;
+
+		/**
+		\brief The pool that the tasks that are submitted using submitTask() are stored in.
+		*/
+		SubmittedTaskPool *m_submittedTasks;
+
+		/**
+		\param task A task that will never be executed.
+
+		\brief Destroys the passed task, if it was submitted using submitTask(). Other tasks are not owned by
+		       the thread manager and are not accessed at all.
+
+		\pre All threads of the thread manager have been joined.
+		*/
+		void discardTask(internal::AbstractTask *task);
+
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		/**
+		\brief The counters that are written by the threads of the thread manager. Defined in 
+		       ThreadManager.cpp.
+		*/
+		struct InstrumentationData;
+
+		/**
+		\brief The counters that are written by the threads of the thread manager.
+		*/
+		InstrumentationData *m_instrumentation;
+#endif
+
+		/**
+		\param index The index of the thread.
+
+		\brief Records that a thread has started. 
+		
+		\details
+		Records that a thread has started. This and the other methods that start with "instrument" do nothing 
+		if NOU_ENABLE_THREAD_INSTRUMENTATION is not defined.
+		*/
+		void instrumentThreadStart(sizeType index);
+
+		/**
+		\param index The index of the thread.
+		\param task  The task that is about to be executed.
+
+		\return The time at which the execution started.
+
+		\brief Records that a thread is about to execute a task.
+		*/
+		uint64 instrumentTaskStart(sizeType index, const TaskErrorHandlerPair &task);
+
+		/**
+		\param index The index of the thread.
+		\param start The value that was returned by instrumentTaskStart().
+
+		\brief Records that a thread has finished executing a task.
+		*/
+		void instrumentTaskFinish(sizeType index, uint64 start);
+
+		/**
+		\param index The index of the thread that stole a task.
+
+		\brief Records that a task was stolen.
+		*/
+		void instrumentSteal(sizeType index);
+
+		/**
+		\pre Lock m_taskHeapAccessMutex.
+
+		\brief Records the current size of the task heap.
+		*/
+		void instrumentHeapSize();
+
 	public:
 		/**
 		\brief Destructs the thread manager and shuts down all the threads that are currently running.
@@ -399,6 +881,28 @@ namespace NOU::NOU_THREAD
 		NOU_FUNC TaskInformation pushTask(internal::AbstractTask *task, Priority priority,
 			NOU_CORE::ErrorHandler *handler = nullptr); 
 
+		/**
+		\param tasks    A pointer to the first task to push.
+		\param count    The amount of tasks to push.
+		\param priority The priority of all tasks.
+		\param handler  The handler that is used by the tasks during execution. See pushTask().
+
+		\brief Pushes multiple tasks with the same priority to the thread manager at once.
+
+		\details
+		Pushes multiple tasks with the same priority to the thread manager at once. This behaves like calling 
+		pushTask() for each task, but the locks of the thread manager are only taken once, the tasks that can
+		not be executed immediately are inserted into the task heap at once and only as many idle threads as
+		there are tasks are woken up. If SchedulerMode::WORK_STEALING is used, each inbox is only locked once.
+
+		In contrast to pushTask(), no TaskInformation is returned, hence the tasks can not be removed again.
+
+		\warning 
+		This method is supposed to be used a sort of a "back end" for functionality (like AsyncTaskResult).
+		*/
+		NOU_FUNC void pushTasks(internal::AbstractTask *const *tasks, sizeType count, Priority priority,
+			NOU_CORE::ErrorHandler *handler = nullptr);
+
 		/**
 		\param taskInfo The task information that was returned by pushTask().
 
@@ -409,6 +913,47 @@ namespace NOU::NOU_THREAD
 		*/
 		NOU_FUNC boolean removeTask(const TaskInformation &taskInfo);
 
+		/**
+		\param task     The task to submit.
+		\param priority The priority of the task.
+
+		\return True, if the task was submitted, false if not (in that case, an error is pushed).
+
+		\brief Moves a task into the thread manager and executes it on another thread.
+
+		\details
+		Moves a task into the thread manager and executes it on another thread. In contrast to pushTask(), the
+		task is owned by the thread manager (it is stored in a pool that is reused by later submissions), so
+		submitting a task whose invocable is stored inline (see InlineTask::isInline()) does not allocate any
+		memory once the pool and the task heap (or deques) have grown large enough.
+
+		A submitted task can not be removed from the thread manager. Tasks that have not been executed when
+		the thread manager is destroyed are discarded without being executed (their invocables and arguments
+		are destroyed).
+		*/
+		NOU_FUNC boolean submitTask(InlineTask &&task, Priority priority = DEFAULT_PRIORITY);
+
+		/**
+		\tparam F    The type of the invocable.
+		\tparam ARGS The types of the arguments.
+
+		\param invocable The invocable.
+		\param args      The arguments that will be passed to the invocable.
+
+		\return True, if the task was submitted, false if not.
+
+		\brief Executes an invocable on another thread, the result is discarded.
+
+		\details
+		Executes an invocable on another thread, the result is discarded. This is a shortcut for
+		\code{.cpp}
+		submitTask(InlineTask(invocable, args...), DEFAULT_PRIORITY);
+		\endcode
+		See submitTask() for details.
+		*/
+		template<typename F, typename... ARGS>
+		boolean submit(F &&invocable, ARGS&&... args);
+
 		/**
 		\return The maximum amount of threads that is available if no threads are idling.
 
@@ -462,7 +1007,34 @@ namespace NOU::NOU_THREAD
 		possible to prepare the required threads before the time critical execution starts.
 		*/
 		NOU_FUNC sizeType prepareThread(sizeType count = 1);
+
+		/**
+		\return The configuration that the thread manager was constructed with.
+
+		\brief Returns the configuration that the thread manager was constructed with.
+		*/
+		NOU_FUNC const ThreadManagerConfiguration& getConfiguration() const;
+
+		/**
+		\return A snapshot of the statistics.
+
+		\brief Returns a snapshot of the statistics of the threads and the task heap.
+
+		\details
+		Returns a snapshot of the statistics of the threads and the task heap. The threads keep running while
+		the snapshot is taken.
+
+		The statistics are only collected if NOU_ENABLE_THREAD_INSTRUMENTATION is defined (using the CMake 
+		option of the same name). Otherwise, SchedulerStatistics::enabled is false and the snapshot is empty.
+		*/
+		NOU_FUNC SchedulerStatistics getStatistics() const;
 	};
+
+	template<typename F, typename... ARGS>
+	boolean ThreadManager::submit(F &&invocable, ARGS&&... args)
+	{
+		return submitTask(InlineTask(NOU_CORE::forward<F>(invocable), NOU_CORE::forward<ARGS>(args)...));
+	}
 }
 
 #endif
\ No newline at end of file
@@ -2,14 +2,24 @@
 #define NOU_THREAD_THREADS_HPP
 
 #include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/thread/ParkingLot.hpp"
+#include "nostrautils/thread/AdaptiveMutex.hpp"
+#include "nostrautils/thread/ParkingConditionVariable.hpp"
+#include "nostrautils/thread/SharedMutex.hpp"
+#include "nostrautils/thread/SeqLock.hpp"
+#include "nostrautils/thread/Topology.hpp"
 #include "nostrautils/thread/Lock.hpp"
 #include "nostrautils/thread/ThreadWrapper.hpp"
 #include "nostrautils/thread/Task.hpp"
+#include "nostrautils/thread/InlineTask.hpp"
+#include "nostrautils/thread/WorkStealingDeque.hpp"
 
 #include "nostrautils/thread/ThreadManager.hpp"
 
 #include "nostrautils/thread/TaskQueue.hpp"
 #include "nostrautils/thread/AsyncTaskResult.hpp"
+#include "nostrautils/thread/Parallel.hpp"
+#include "nostrautils/thread/Coroutine.hpp"
 
 /**
 \file thread\Threads.hpp
@@ -0,0 +1,164 @@
+#ifndef NOU_THREAD_TOPOLOGY_HPP
+#define NOU_THREAD_TOPOLOGY_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+
+/**
+\file thread/Topology.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains the nostra::utils::thread::CpuSet class and functions that query the CPU and NUMA
+       topology of the system and control where a thread runs.
+
+\see nostra::utils::thread::CpuSet
+\see nostra::utils::thread::Topology
+*/
+
+namespace NOU::NOU_THREAD
+{
+	/**
+	\brief A set of logical CPUs, e.g. the CPUs that a thread is allowed to run on.
+	*/
+	class CpuSet final
+	{
+	public:
+		/**
+		\brief The largest amount of CPUs that can be stored in a set. CPUs with an index that is equal to or
+		       larger than this are ignored.
+		*/
+		constexpr static sizeType MAX_CPU_COUNT = 1024;
+
+	private:
+		/**
+		\brief The amount of bits in a single element of \p m_bits.
+		*/
+		constexpr static sizeType BITS_PER_WORD = 64;
+
+		/**
+		\brief A bit for each CPU, the bit is set if the CPU is part of the set.
+		*/
+		uint64 m_bits[MAX_CPU_COUNT / BITS_PER_WORD];
+
+	public:
+		/**
+		\brief Constructs an empty set.
+		*/
+		NOU_FUNC CpuSet();
+
+		/**
+		\param cpu The index of the CPU.
+
+		\brief Adds a CPU to the set.
+		*/
+		NOU_FUNC void set(sizeType cpu);
+
+		/**
+		\param cpu The index of the CPU.
+
+		\brief Removes a CPU from the set.
+		*/
+		NOU_FUNC void clear(sizeType cpu);
+
+		/**
+		\param cpu The index of the CPU.
+
+		\return True, if the CPU is part of the set, false if not.
+
+		\brief Returns whether a CPU is part of the set.
+		*/
+		NOU_FUNC boolean isSet(sizeType cpu) const;
+
+		/**
+		\return The amount of CPUs in the set.
+
+		\brief Returns the amount of CPUs in the set.
+		*/
+		NOU_FUNC sizeType count() const;
+
+		/**
+		\return The smallest index of a CPU in the set, or MAX_CPU_COUNT if the set is empty.
+
+		\brief Returns the smallest index of a CPU in the set.
+		*/
+		NOU_FUNC sizeType first() const;
+	};
+
+	/**
+	\brief Functions that query the CPU and NUMA topology of the system and control where a thread runs.
+
+	\details
+	Functions that query the CPU and NUMA topology of the system and control where a thread runs. The topology
+	is read once, when it is first needed. Only the CPUs that the process is allowed to run on are taken into
+	account.
+
+	On Linux, the NUMA nodes are read from <tt>/sys/devices/system/node</tt>. On other systems (or if that
+	information is not available), all CPUs are considered to be part of a single node.
+	*/
+	namespace Topology
+	{
+		/**
+		\return The amount of CPUs that the process may run on.
+
+		\brief Returns the amount of CPUs that the process may run on.
+		*/
+		NOU_FUNC sizeType cpuCount();
+
+		/**
+		\param index The index, in the range [0, cpuCount()).
+
+		\return The index of the CPU (as used by CpuSet).
+
+		\brief Returns the CPU at the passed position. The CPUs are ordered by their NUMA node, so that
+		       consecutive indices are as close to each other as possible.
+		*/
+		NOU_FUNC sizeType cpuAt(sizeType index);
+
+		/**
+		\return The amount of NUMA nodes that have at least one CPU that the process may run on.
+
+		\brief Returns the amount of NUMA nodes.
+		*/
+		NOU_FUNC sizeType numaNodeCount();
+
+		/**
+		\param node The index of the node, in the range [0, numaNodeCount()).
+
+		\return The CPUs of the node that the process may run on.
+
+		\brief Returns the CPUs of a NUMA node.
+		*/
+		NOU_FUNC const CpuSet& numaNodeCpus(sizeType node);
+
+		/**
+		\param cpu The index of the CPU.
+
+		\return The index of the NUMA node of the CPU, or 0 if the process may not run on the CPU.
+
+		\brief Returns the NUMA node of a CPU.
+		*/
+		NOU_FUNC sizeType numaNodeOf(sizeType cpu);
+
+		/**
+		\param cpus The CPUs that the calling thread may run on.
+
+		\return True, if the affinity was set, false if not (e.g. if the system does not support it).
+
+		\brief Restricts the calling thread to the passed CPUs.
+		*/
+		NOU_FUNC boolean setCurrentThreadAffinity(const CpuSet &cpus);
+
+		/**
+		\param name The name. On Linux, only the first 15 characters are used.
+
+		\return True, if the name was set, false if not (e.g. if the system does not support it).
+
+		\brief Sets the name of the calling thread, as it is shown by debuggers and tools like <tt>top</tt>.
+		*/
+		NOU_FUNC boolean setCurrentThreadName(const char *name);
+	}
+}
+
+#endif
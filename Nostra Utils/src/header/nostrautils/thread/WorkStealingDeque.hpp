@@ -0,0 +1,420 @@
+#ifndef NOU_THREAD_WORK_STEALING_DEQUE_HPP
+#define NOU_THREAD_WORK_STEALING_DEQUE_HPP
+
+#include "nostrautils/core/StdIncludes.hpp"
+#include "nostrautils/core/Meta.hpp"
+#include "nostrautils/mem_mngt/Utils.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+/**
+\file thread/WorkStealingDeque.hpp
+
+\author  Lukas Reichmann
+\version 1.0.1
+\since   1.0.1
+
+\brief A file that contains a lock-free work-stealing deque.
+*/
+
+namespace NOU::NOU_THREAD
+{
+	/**
+	\tparam T The type of the stored elements. This type must be trivially copyable.
+
+	\brief A lock-free, growable double ended queue as described by Chase and Lev.
+
+	\details
+	A lock-free, growable double ended queue as described by Chase and Lev. The deque has a single owner
+	thread that pushes and pops elements at the bottom (LIFO), while an arbitrary amount of other threads can
+	steal elements from the top (FIFO).
+
+	The elements are stored as a sequence of atomic words. This way, elements that are larger than the
+	largest lock-free atomic type (e.g. a pair of two pointers) can be stored without a lock and without
+	an additional allocation per element.
+
+	When the deque runs out of capacity, the owner allocates a buffer with twice the capacity. The old buffers
+	are kept alive until the deque is destroyed, since a thief might still read from them.
+	*/
+	template<typename T>
+	class WorkStealingDeque final
+	{
+		static_assert(std::is_trivially_copyable<T>::value,
+			"The elements of a WorkStealingDeque must be trivially copyable.");
+
+	public:
+		/**
+		\brief Local class alias.
+		*/
+		using Type = T;
+
+		/**
+		\brief The minimum capacity of a deque.
+		*/
+		static constexpr sizeType MIN_CAPACITY = 16;
+
+	private:
+		/**
+		\brief The type of a single word that an element is stored in.
+		*/
+		using Word = std::uintptr_t;
+
+		/**
+		\brief The amount of words that are required to store a single element.
+		*/
+		static constexpr sizeType WORDS_PER_ELEMENT = (sizeof(Type) + sizeof(Word) - 1) / sizeof(Word);
+
+		/**
+		\brief A ring buffer that stores the elements of the deque.
+		*/
+		struct Buffer
+		{
+			/**
+			\brief The capacity of the buffer. This is always a power of two.
+			*/
+			int64              m_capacity;
+
+			/**
+			\brief The words that store the elements.
+			*/
+			std::atomic<Word> *m_words;
+
+			/**
+			\brief The buffer that was used before this one, or <tt>nullptr</tt> if there is none.
+			*/
+			Buffer            *m_previous;
+
+			/**
+			\param capacity The capacity of the buffer.
+			\param previous The buffer that was used before.
+
+			\brief Constructs a new buffer.
+			*/
+			Buffer(int64 capacity, Buffer *previous);
+
+			/**
+			\brief Destructs the buffer.
+			*/
+			~Buffer();
+
+			/**
+			\param index The index of the element.
+			\param data  The element to store.
+
+			\brief Stores an element at the passed index.
+			*/
+			void put(int64 index, const Type &data);
+
+			/**
+			\param index The index of the element.
+			\param words The array that the words of the element will be copied to. This array must have
+			             a size of at least WORDS_PER_ELEMENT.
+
+			\brief Copies the words of the element at the passed index.
+			*/
+			void get(int64 index, Word *words) const;
+		};
+
+		/**
+		\brief The index of the top element. This is the index that thieves steal from.
+		*/
+		alignas(NOU_MEM_MNGT::CACHE_LINE_SIZE) std::atomic<int64> m_top;
+
+		/**
+		\brief The index after the bottom element. This is only written by the owner.
+		*/
+		alignas(NOU_MEM_MNGT::CACHE_LINE_SIZE) std::atomic<int64> m_bottom;
+
+		/**
+		\brief The buffer that is currently in use.
+		*/
+		std::atomic<Buffer*> m_buffer;
+
+		/**
+		\param buffer The current buffer.
+		\param bottom The current bottom index.
+		\param top    The current top index.
+
+		\return The new buffer.
+
+		\brief Replaces the current buffer with one that has twice the capacity.
+		*/
+		Buffer* grow(Buffer *buffer, int64 bottom, int64 top);
+
+	public:
+		/**
+		\param initialCapacity The initial capacity. This will be rounded up to the next power of two.
+
+		\brief Constructs a new, empty deque.
+		*/
+		explicit WorkStealingDeque(sizeType initialCapacity = MIN_CAPACITY);
+
+		/**
+		\brief Not copy-able.
+		*/
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+		/**
+		\brief Not move-able.
+		*/
+		WorkStealingDeque(WorkStealingDeque&&) = delete;
+
+		/**
+		\brief Destructs the deque and all of the buffers that it has ever used.
+		*/
+		~WorkStealingDeque();
+
+		/**
+		\param data The element to push.
+
+		\brief Pushes an element to the bottom of the deque.
+
+		\warning
+		This method may only be called by the owner of the deque.
+		*/
+		void pushBack(const Type &data);
+
+		/**
+		\param out The object that the popped element will be stored in.
+
+		\return True, if an element was popped, false if the deque was empty.
+
+		\brief Pops the element at the bottom of the deque (which is the most recently pushed element).
+
+		\warning
+		This method may only be called by the owner of the deque.
+		*/
+		boolean popBack(Type &out);
+
+		/**
+		\param out The object that the stolen element will be stored in.
+
+		\return True, if an element was stolen, false if not.
+
+		\brief Steals the element at the top of the deque (which is the least recently pushed element).
+
+		\details
+		Steals the element at the top of the deque (which is the least recently pushed element). This method
+		may be called by any thread. It also fails if another thread has taken the top element at the same
+		time.
+		*/
+		boolean steal(Type &out);
+
+		/**
+		\return The amount of elements in the deque.
+
+		\brief Returns the amount of elements in the deque.
+
+		\note
+		If this method is called by any thread other than the owner, the returned value is only a hint.
+		*/
+		sizeType size() const;
+
+		/**
+		\return True, if the deque is empty, false if not.
+
+		\brief Returns whether the deque is empty.
+
+		\note
+		If this method is called by any thread other than the owner, the returned value is only a hint.
+		*/
+		boolean empty() const;
+
+		/**
+		\return The capacity of the current buffer.
+
+		\brief Returns the amount of elements that can be stored before the deque needs to grow.
+		*/
+		sizeType capacity() const;
+	};
+
+	template<typename T>
+	constexpr sizeType WorkStealingDeque<T>::MIN_CAPACITY;
+
+	template<typename T>
+	constexpr sizeType WorkStealingDeque<T>::WORDS_PER_ELEMENT;
+
+	template<typename T>
+	WorkStealingDeque<T>::Buffer::Buffer(int64 capacity, Buffer *previous) :
+		m_capacity(capacity),
+		m_words(new std::atomic<Word>[static_cast<sizeType>(capacity) * WORDS_PER_ELEMENT]),
+		m_previous(previous)
+	{}
+
+	template<typename T>
+	WorkStealingDeque<T>::Buffer::~Buffer()
+	{
+		delete[] m_words;
+	}
+
+	template<typename T>
+	void WorkStealingDeque<T>::Buffer::put(int64 index, const Type &data)
+	{
+		Word words[WORDS_PER_ELEMENT] = {};
+		std::memcpy(words, &data, sizeof(Type));
+
+		std::atomic<Word> *slot = m_words + (index & (m_capacity - 1)) * WORDS_PER_ELEMENT;
+
+		for (sizeType i = 0; i < WORDS_PER_ELEMENT; i++)
+			slot[i].store(words[i], std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	void WorkStealingDeque<T>::Buffer::get(int64 index, Word *words) const
+	{
+		const std::atomic<Word> *slot = m_words + (index & (m_capacity - 1)) * WORDS_PER_ELEMENT;
+
+		for (sizeType i = 0; i < WORDS_PER_ELEMENT; i++)
+			words[i] = slot[i].load(std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	typename WorkStealingDeque<T>::Buffer* WorkStealingDeque<T>::grow(Buffer *buffer, int64 bottom,
+		int64 top)
+	{
+		Buffer *newBuffer = new Buffer(buffer->m_capacity * 2, buffer);
+
+		Word words[WORDS_PER_ELEMENT];
+
+		for (int64 i = top; i < bottom; i++)
+		{
+			buffer->get(i, words);
+
+			std::atomic<Word> *slot = newBuffer->m_words + (i & (newBuffer->m_capacity - 1)) *
+				WORDS_PER_ELEMENT;
+
+			for (sizeType j = 0; j < WORDS_PER_ELEMENT; j++)
+				slot[j].store(words[j], std::memory_order_relaxed);
+		}
+
+		m_buffer.store(newBuffer, std::memory_order_release);
+
+		return newBuffer;
+	}
+
+	template<typename T>
+	WorkStealingDeque<T>::WorkStealingDeque(sizeType initialCapacity) :
+		m_top(0),
+		m_bottom(0),
+		m_buffer(nullptr)
+	{
+		int64 capacity = MIN_CAPACITY;
+
+		while (static_cast<sizeType>(capacity) < initialCapacity)
+			capacity *= 2;
+
+		m_buffer.store(new Buffer(capacity, nullptr), std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	WorkStealingDeque<T>::~WorkStealingDeque()
+	{
+		Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+
+		while (buffer != nullptr)
+		{
+			Buffer *previous = buffer->m_previous;
+			delete buffer;
+			buffer = previous;
+		}
+	}
+
+	template<typename T>
+	void WorkStealingDeque<T>::pushBack(const Type &data)
+	{
+		int64 bottom = m_bottom.load(std::memory_order_relaxed);
+		int64 top = m_top.load(std::memory_order_acquire);
+		Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+
+		if (bottom - top > buffer->m_capacity - 1)
+			buffer = grow(buffer, bottom, top);
+
+		buffer->put(bottom, data);
+
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	boolean WorkStealingDeque<T>::popBack(Type &out)
+	{
+		int64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+		m_bottom.store(bottom, std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		int64 top = m_top.load(std::memory_order_relaxed);
+
+		if (top > bottom) //empty
+		{
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		Word words[WORDS_PER_ELEMENT];
+		buffer->get(bottom, words);
+
+		if (top == bottom) //last element, race against thieves
+		{
+			boolean won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+				std::memory_order_relaxed);
+
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			if (!won)
+				return false;
+		}
+
+		std::memcpy(&out, words, sizeof(Type));
+		return true;
+	}
+
+	template<typename T>
+	boolean WorkStealingDeque<T>::steal(Type &out)
+	{
+		int64 top = m_top.load(std::memory_order_acquire);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		int64 bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return false;
+
+		Word words[WORDS_PER_ELEMENT];
+		m_buffer.load(std::memory_order_acquire)->get(top, words);
+
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+			std::memory_order_relaxed))
+			return false;
+
+		std::memcpy(&out, words, sizeof(Type));
+		return true;
+	}
+
+	template<typename T>
+	sizeType WorkStealingDeque<T>::size() const
+	{
+		int64 bottom = m_bottom.load(std::memory_order_relaxed);
+		int64 top = m_top.load(std::memory_order_relaxed);
+
+		return bottom > top ? static_cast<sizeType>(bottom - top) : 0;
+	}
+
+	template<typename T>
+	boolean WorkStealingDeque<T>::empty() const
+	{
+		return size() == 0;
+	}
+
+	template<typename T>
+	sizeType WorkStealingDeque<T>::capacity() const
+	{
+		return static_cast<sizeType>(m_buffer.load(std::memory_order_relaxed)->m_capacity);
+	}
+}
+
+#endif
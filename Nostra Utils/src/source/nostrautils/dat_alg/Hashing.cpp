@@ -1,7 +1,430 @@
 #include "nostrautils/dat_alg/Hashing.hpp"
 
+#include <atomic>
+#include <cstring>
+
+#if (NOU_COMPILER == NOU_COMPILER_GCC || NOU_COMPILER == NOU_COMPILER_CLANG || \
+	NOU_COMPILER == NOU_COMPILER_MIN_GW) && (defined(__x86_64__) || defined(__i386__))
+#    define NOU_HASH_AVX2
+#    define NOU_HASH_TARGET_AVX2 __attribute__((target("avx2")))
+#    include <immintrin.h>
+#elif NOU_COMPILER == NOU_COMPILER_VISUAL_CPP && (defined(_M_X64) || defined(_M_IX86))
+#    define NOU_HASH_AVX2
+#    define NOU_HASH_TARGET_AVX2
+#    include <immintrin.h>
+#    include <intrin.h>
+#endif
+
 namespace NOU::NOU_DAT_ALG
 {
+	namespace
+	{
+		/**
+		\brief The primes that are used by the short input path (the same ones as wyhash uses).
+		*/
+		constexpr uint64 PRIME_0 = 0xa0761d6478bd642full;
+		constexpr uint64 PRIME_1 = 0xe7037ed1a0b428dbull;
+		constexpr uint64 PRIME_2 = 0x8ebc6af09c88c6e3ull;
+		constexpr uint64 PRIME_3 = 0x589965cc75374cc3ull;
+
+		/**
+		\brief The 32 bit prime that the accumulators are scrambled with.
+		*/
+		constexpr uint64 SCRAMBLE_PRIME = 0x9e3779b1ull;
+
+		/**
+		\brief Inputs of at least this size are hashed in stripes.
+		*/
+		constexpr sizeType LONG_INPUT_SIZE = 256;
+
+		/**
+		\brief The size of a single stripe.
+		*/
+		constexpr sizeType STRIPE_SIZE = 64;
+
+		/**
+		\brief The amount of stripes after which the accumulators are scrambled.
+		*/
+		constexpr sizeType STRIPES_PER_BLOCK = 8;
+
+		/**
+		\brief The amount of accumulators, each one processes eight bytes of a stripe.
+		*/
+		constexpr sizeType ACCUMULATOR_COUNT = 8;
+
+		/**
+		\brief The keys that the stripes are combined with. Stripe \p n of a block uses the keys 
+		       <tt>n, n + 1, ..., n + 7</tt>.
+		*/
+		constexpr uint64 STRIPE_KEYS[STRIPES_PER_BLOCK + ACCUMULATOR_COUNT] =
+		{
+			0xc0e16b163a85a4dcull, 0x890acd8dd443c47cull, 0xb3889d8a6dc47761ull, 0x6a0398e528f0ae6aull,
+			0x048344ece48a855eull, 0xf175cfea21871330ull, 0x391ceef02702c2fdull, 0x4baf8cac4784cb12ull,
+			0x3547744583a3f88eull, 0xd9cf2b15c6b6c90eull, 0x961facc76d5fe21cull, 0x0094ab49d50f11f9ull,
+			0xe3211e37bdbeb6dcull, 0x62fe6c274ff3511aull, 0x5ac30b329fdf0574ull, 0x1450582c6b65b406ull
+		};
+
+		/**
+		\brief The keys that the accumulators are scrambled with.
+		*/
+		constexpr uint64 SCRAMBLE_KEYS[ACCUMULATOR_COUNT] =
+		{
+			0x7a30fcc7888eb791ull, 0x5540f5ba6a15576eull, 0x16cef0559096d3e9ull, 0x2cf8f14b06874899ull,
+			0xc9c9263b6e2ce103ull, 0xd6ff920b0a9faa6dull, 0x53192697db998dc1ull, 0x73ea9b9bc7cd18d7ull
+		};
+
+		/**
+		\brief The function that processes a number of stripes.
+		*/
+		using AccumulateFunction = void(*)(uint64 *accumulators, const byte *data, sizeType stripes, 
+			const uint64 *keys);
+
+		/**
+		\brief The function that scrambles the accumulators after each block.
+		*/
+		using ScrambleFunction = void(*)(uint64 *accumulators, const uint64 *keys);
+
+		/**
+		\return The low and high half of the 128 bit product of \p a and \p b, combined using xor.
+		*/
+		inline uint64 multiplyMix(uint64 a, uint64 b)
+		{
+#if defined(__SIZEOF_INT128__)
+			__uint128_t product = static_cast<__uint128_t>(a) * b;
+
+			return static_cast<uint64>(product) ^ static_cast<uint64>(product >> 64);
+#elif NOU_COMPILER == NOU_COMPILER_VISUAL_CPP && defined(_M_X64)
+			uint64 high;
+			uint64 low = _umul128(a, b, &high);
+
+			return low ^ high;
+#else
+			uint64 aHigh = a >> 32;
+			uint64 aLow = a & 0xffffffffull;
+			uint64 bHigh = b >> 32;
+			uint64 bLow = b & 0xffffffffull;
+
+			uint64 highHigh = aHigh * bHigh;
+			uint64 highLow = aHigh * bLow;
+			uint64 lowHigh = aLow * bHigh;
+			uint64 lowLow = aLow * bLow;
+
+			uint64 carry = ((lowLow >> 32) + (highLow & 0xffffffffull) + (lowHigh & 0xffffffffull)) >> 32;
+
+			uint64 high = highHigh + (highLow >> 32) + (lowHigh >> 32) + carry;
+			uint64 low = a * b;
+
+			return low ^ high;
+#endif
+		}
+
+		inline uint64 read64(const byte *data)
+		{
+			uint64 ret;
+			std::memcpy(&ret, data, sizeof(ret));
+			return ret;
+		}
+
+		inline uint64 read32(const byte *data)
+		{
+			uint32 ret;
+			std::memcpy(&ret, data, sizeof(ret));
+			return ret;
+		}
+
+		/**
+		\brief Reads one to three bytes.
+		*/
+		inline uint64 readSmall(const byte *data, sizeType size)
+		{
+			return (static_cast<uint64>(data[0]) << 16) | (static_cast<uint64>(data[size >> 1]) << 8) | 
+				data[size - 1];
+		}
+
+		void accumulateScalar(uint64 *accumulators, const byte *data, sizeType stripes, const uint64 *keys)
+		{
+			for (sizeType stripe = 0; stripe < stripes; stripe++)
+			{
+				const byte *stripeData = data + stripe * STRIPE_SIZE;
+
+				for (sizeType i = 0; i < ACCUMULATOR_COUNT; i++)
+				{
+					uint64 value = read64(stripeData + i * sizeof(uint64));
+					uint64 keyed = value ^ keys[stripe + i];
+
+					accumulators[i ^ 1] += value;
+					accumulators[i] += (keyed & 0xffffffffull) * (keyed >> 32);
+				}
+			}
+		}
+
+		void scrambleScalar(uint64 *accumulators, const uint64 *keys)
+		{
+			for (sizeType i = 0; i < ACCUMULATOR_COUNT; i++)
+				accumulators[i] = (accumulators[i] ^ (accumulators[i] >> 47) ^ keys[i]) * SCRAMBLE_PRIME;
+		}
+
+#ifdef NOU_HASH_AVX2
+		/**
+		\brief Same as accumulateScalar(), but processes four accumulators at once.
+		*/
+		NOU_HASH_TARGET_AVX2
+		void accumulateAvx2(uint64 *accumulators, const byte *data, sizeType stripes, const uint64 *keys)
+		{
+			__m256i accumulator0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulators));
+			__m256i accumulator1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulators + 4));
+
+			for (sizeType stripe = 0; stripe < stripes; stripe++)
+			{
+				const byte *stripeData = data + stripe * STRIPE_SIZE;
+
+				__m256i value0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stripeData));
+				__m256i value1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stripeData + 32));
+
+				__m256i keyed0 = _mm256_xor_si256(value0, 
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + stripe)));
+				__m256i keyed1 = _mm256_xor_si256(value1, 
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + stripe + 4)));
+
+				//low 32 bits times high 32 bits of each lane
+				__m256i product0 = _mm256_mul_epu32(keyed0, _mm256_srli_epi64(keyed0, 32));
+				__m256i product1 = _mm256_mul_epu32(keyed1, _mm256_srli_epi64(keyed1, 32));
+
+				//swap neighboring lanes, so that lane i is added to accumulator i ^ 1
+				__m256i swapped0 = _mm256_shuffle_epi32(value0, _MM_SHUFFLE(1, 0, 3, 2));
+				__m256i swapped1 = _mm256_shuffle_epi32(value1, _MM_SHUFFLE(1, 0, 3, 2));
+
+				accumulator0 = _mm256_add_epi64(accumulator0, _mm256_add_epi64(swapped0, product0));
+				accumulator1 = _mm256_add_epi64(accumulator1, _mm256_add_epi64(swapped1, product1));
+			}
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators), accumulator0);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators + 4), accumulator1);
+		}
+
+		/**
+		\brief Same as scrambleScalar(), but processes four accumulators at once.
+		*/
+		NOU_HASH_TARGET_AVX2
+		void scrambleAvx2(uint64 *accumulators, const uint64 *keys)
+		{
+			const __m256i prime = _mm256_set1_epi64x(static_cast<int64>(SCRAMBLE_PRIME));
+
+			for (sizeType i = 0; i < ACCUMULATOR_COUNT; i += 4)
+			{
+				__m256i accumulator = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulators + i));
+				__m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+
+				accumulator = _mm256_xor_si256(_mm256_xor_si256(accumulator, 
+					_mm256_srli_epi64(accumulator, 47)), key);
+
+				//there is no 64 bit multiplication, but the prime only has 32 bits
+				__m256i low = _mm256_mul_epu32(accumulator, prime);
+				__m256i high = _mm256_mul_epu32(_mm256_srli_epi64(accumulator, 32), prime);
+
+				accumulator = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators + i), accumulator);
+			}
+		}
+
+		/**
+		\return True, if the CPU and the operating system support AVX2.
+		*/
+		boolean isAvx2Supported()
+		{
+#if NOU_COMPILER == NOU_COMPILER_VISUAL_CPP
+			int info[4];
+
+			__cpuid(info, 1);
+
+			//the OS must save the YMM registers (OSXSAVE and XCR0)
+			if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6)
+				return false;
+
+			__cpuidex(info, 7, 0);
+
+			return (info[1] & (1 << 5)) != 0;
+#else
+			__builtin_cpu_init();
+
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+#endif
+
+		/**
+		\brief The functions that are used for long inputs.
+		*/
+		struct StripeFunctions
+		{
+			AccumulateFunction accumulate;
+			ScrambleFunction scramble;
+		};
+
+		const StripeFunctions SCALAR_STRIPE_FUNCTIONS = { accumulateScalar, scrambleScalar };
+
+#ifdef NOU_HASH_AVX2
+		const StripeFunctions AVX2_STRIPE_FUNCTIONS = { accumulateAvx2, scrambleAvx2 };
+#endif
+
+		/**
+		\return The functions that are used for long inputs. By default, they are chosen once, depending on 
+		        the CPU.
+		*/
+		std::atomic<const StripeFunctions*>& stripeFunctions()
+		{
+#ifdef NOU_HASH_AVX2
+			static std::atomic<const StripeFunctions*> ret(isAvx2Supported() ? 
+				&AVX2_STRIPE_FUNCTIONS : &SCALAR_STRIPE_FUNCTIONS);
+#else
+			static std::atomic<const StripeFunctions*> ret(&SCALAR_STRIPE_FUNCTIONS);
+#endif
+
+			return ret;
+		}
+
+		/**
+		\brief Hashes inputs of at least LONG_INPUT_SIZE bytes.
+		*/
+		uint64 hashLong(const byte *data, sizeType size, uint64 seed)
+		{
+			const StripeFunctions &functions = *stripeFunctions().load(std::memory_order_relaxed);
+
+			uint64 keys[STRIPES_PER_BLOCK + ACCUMULATOR_COUNT];
+			uint64 scrambleKeys[ACCUMULATOR_COUNT];
+
+			for (sizeType i = 0; i < STRIPES_PER_BLOCK + ACCUMULATOR_COUNT; i++)
+				keys[i] = (i & 1) == 0 ? STRIPE_KEYS[i] + seed : STRIPE_KEYS[i] - seed;
+
+			for (sizeType i = 0; i < ACCUMULATOR_COUNT; i++)
+				scrambleKeys[i] = SCRAMBLE_KEYS[i] ^ seed;
+
+			uint64 accumulators[ACCUMULATOR_COUNT] = 
+			{ 
+				PRIME_0, PRIME_1, PRIME_2, PRIME_3, ~PRIME_0, ~PRIME_1, ~PRIME_2, ~PRIME_3 
+			};
+
+			constexpr sizeType BLOCK_SIZE = STRIPE_SIZE * STRIPES_PER_BLOCK;
+
+			//at least one byte is always left for the last (partial) block
+			sizeType blocks = (size - 1) / BLOCK_SIZE;
+
+			for (sizeType i = 0; i < blocks; i++)
+			{
+				functions.accumulate(accumulators, data + i * BLOCK_SIZE, STRIPES_PER_BLOCK, keys);
+				functions.scramble(accumulators, scrambleKeys);
+			}
+
+			sizeType remaining = size - blocks * BLOCK_SIZE;
+
+			functions.accumulate(accumulators, data + blocks * BLOCK_SIZE, (remaining - 1) / STRIPE_SIZE, keys);
+
+			//the last stripe always ends at the end of the input, it may overlap with the previous one
+			functions.accumulate(accumulators, data + size - STRIPE_SIZE, 1, keys + STRIPES_PER_BLOCK - 1);
+
+			uint64 ret = size * PRIME_0;
+
+			for (sizeType i = 0; i < ACCUMULATOR_COUNT; i += 2)
+				ret += multiplyMix(accumulators[i] ^ keys[i + 1], accumulators[i + 1] ^ keys[i + 2]);
+
+			ret ^= ret >> 37;
+			ret *= 0x165667919e3779f9ull;
+			ret ^= ret >> 32;
+
+			return ret;
+		}
+	}
+
+	uint64 hash64(const void *data, sizeType size, uint64 seed)
+	{
+		const byte *bytes = static_cast<const byte*>(data);
+
+		if (size >= LONG_INPUT_SIZE)
+			return hashLong(bytes, size, seed);
+
+		seed ^= multiplyMix(seed ^ PRIME_0, PRIME_1);
+
+		uint64 a;
+		uint64 b;
+
+		if (size <= 16)
+		{
+			if (size >= 4)
+			{
+				//two (possibly overlapping) reads from each end cover all bytes
+				sizeType offset = (size >> 3) << 2;
+
+				a = (read32(bytes) << 32) | read32(bytes + offset);
+				b = (read32(bytes + size - 4) << 32) | read32(bytes + size - 4 - offset);
+			}
+			else if (size > 0)
+			{
+				a = readSmall(bytes, size);
+				b = 0;
+			}
+			else
+			{
+				a = 0;
+				b = 0;
+			}
+		}
+		else
+		{
+			sizeType remaining = size;
+
+			if (remaining > 48)
+			{
+				uint64 seed1 = seed;
+				uint64 seed2 = seed;
+
+				do
+				{
+					seed = multiplyMix(read64(bytes) ^ PRIME_1, read64(bytes + 8) ^ seed);
+					seed1 = multiplyMix(read64(bytes + 16) ^ PRIME_2, read64(bytes + 24) ^ seed1);
+					seed2 = multiplyMix(read64(bytes + 32) ^ PRIME_3, read64(bytes + 40) ^ seed2);
+
+					bytes += 48;
+					remaining -= 48;
+				} while (remaining > 48);
+
+				seed ^= seed1 ^ seed2;
+			}
+
+			while (remaining > 16)
+			{
+				seed = multiplyMix(read64(bytes) ^ PRIME_1, read64(bytes + 8) ^ seed);
+
+				bytes += 16;
+				remaining -= 16;
+			}
+
+			a = read64(bytes + remaining - 16);
+			b = read64(bytes + remaining - 8);
+		}
+
+		return multiplyMix(PRIME_1 ^ size, multiplyMix(a ^ PRIME_1, b ^ seed));
+	}
+
+	boolean internal::setHashAvx2Enabled(boolean enabled)
+	{
+#ifdef NOU_HASH_AVX2
+		if (enabled && isAvx2Supported())
+		{
+			stripeFunctions().store(&AVX2_STRIPE_FUNCTIONS, std::memory_order_relaxed);
+			return true;
+		}
+#endif
+
+		stripeFunctions().store(&SCALAR_STRIPE_FUNCTIONS, std::memory_order_relaxed);
+		return false;
+	}
+
+	uint64 hashWord(uint64 value, uint64 seed)
+	{
+		return multiplyMix(value ^ seed ^ PRIME_0, multiplyMix(value ^ PRIME_1, seed ^ PRIME_2));
+	}
+
 
 	NOU_FUNC NOU::sizeType hashValue(NOU::sizeType value, NOU::sizeType max)
 	{
@@ -0,0 +1,14 @@
+#include "nostrautils/mem_mngt/AllocationCallback.hpp"
+#include "nostrautils/core/ErrorHandler.hpp"
+
+namespace NOU::NOU_MEM_MNGT
+{
+	namespace internal
+	{
+		void pushMissingArenaError()
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"There is no arena to allocate from.");
+		}
+	}
+}
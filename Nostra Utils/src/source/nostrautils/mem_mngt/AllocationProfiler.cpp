@@ -0,0 +1,748 @@
+#include "nostrautils/mem_mngt/AllocationProfiler.hpp"
+#include "nostrautils/mem_mngt/Utils.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/dat_alg/Hashing.hpp"
+#include "nostrautils/thread/Lock.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#if NOU_OS_LIBRARY == NOU_OS_LIBRARY_WIN_H
+#include <Windows.h>
+#elif NOU_OS_LIBRARY == NOU_OS_LIBRARY_POSIX
+#include <dlfcn.h>
+#include <execinfo.h>
+#endif
+
+#if NOU_COMPILER == NOU_COMPILER_GCC || NOU_COMPILER == NOU_COMPILER_CLANG
+#include <cxxabi.h>
+#endif
+
+namespace NOU::NOU_MEM_MNGT
+{
+	constexpr sizeType AllocationProfiler::MAX_STACK_DEPTH;
+	constexpr sizeType AllocationProfiler::DEFAULT_STACK_DEPTH;
+	constexpr sizeType AllocationProfiler::BUFFER_SIZE;
+
+	struct AllocationProfiler::Header
+	{
+		/**
+		\brief The hash of the site of the allocation.
+		*/
+		uint64 m_site;
+
+		/**
+		\brief The time of the allocation.
+		*/
+		uint64 m_time;
+
+		/**
+		\brief The type of the allocation.
+		*/
+		const AllocationTypeInfo *m_type;
+
+		/**
+		\brief The size of the allocation.
+		*/
+		sizeType m_bytes;
+
+		/**
+		\brief The distance between the start of the allocated block and the start of the user's memory.
+		*/
+		sizeType m_offset;
+	};
+
+	struct AllocationProfiler::Event
+	{
+		/**
+		\brief The time of the event.
+		*/
+		uint64 m_time;
+
+		/**
+		\brief The hash of the site of the allocation.
+		*/
+		uint64 m_site;
+
+		/**
+		\brief The type of the allocation.
+		*/
+		const AllocationTypeInfo *m_type;
+
+		/**
+		\brief The size of the allocation.
+		*/
+		sizeType m_bytes;
+
+		/**
+		\brief The lifetime of the allocation in nanoseconds, only used by deallocations.
+		*/
+		uint64 m_lifetime;
+
+		/**
+		\brief True, if the event is an allocation, false if it is a deallocation.
+		*/
+		boolean m_isAllocation;
+
+		/**
+		\brief The label of the site, only used by allocations.
+		*/
+		const char *m_label;
+
+		/**
+		\brief The amount of valid entries in \p m_stack, only used by allocations.
+		*/
+		sizeType m_stackDepth;
+
+		/**
+		\brief The stack of the site, only used by allocations.
+		*/
+		void *m_stack[MAX_STACK_DEPTH];
+	};
+
+	struct AllocationProfiler::ThreadBuffer
+	{
+		/**
+		\brief The index of the next event that will be read. Only written while the mutex of the profiler is
+		       locked.
+		*/
+		alignas(CACHE_LINE_SIZE) std::atomic<sizeType> m_head;
+
+		/**
+		\brief The index of the next event that will be written. Only written by the owning thread.
+		*/
+		alignas(CACHE_LINE_SIZE) std::atomic<sizeType> m_tail;
+
+		/**
+		\brief The thread that owns the buffer.
+		*/
+		std::thread::id m_thread;
+
+		/**
+		\brief The next buffer of the same profiler.
+		*/
+		ThreadBuffer *m_next;
+
+		/**
+		\brief The events, used as a ring buffer.
+		*/
+		Event m_events[BUFFER_SIZE];
+	};
+
+	namespace
+	{
+		/**
+		\brief The current label of each thread.
+		*/
+		thread_local const char *s_currentLabel = nullptr;
+
+		/**
+		\brief The id of the profiler that \p s_cachedBuffer belongs to.
+		*/
+		thread_local uint64 s_cachedProfiler = 0;
+
+		/**
+		\brief The buffer of the calling thread of the profiler that was used last.
+		*/
+		thread_local void *s_cachedBuffer = nullptr;
+
+		/**
+		\brief The id of the next profiler.
+		*/
+		std::atomic<uint64> s_nextProfilerId(1);
+
+		/**
+		\return The current time in nanoseconds, from a monotonic clock.
+		*/
+		uint64 profilerTime()
+		{
+			return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		/**
+		\param value    The value to round.
+		\param multiple The multiple, a power of two.
+
+		\return \p value, rounded up to the next multiple of \p multiple.
+		*/
+		sizeType roundUp(sizeType value, sizeType multiple)
+		{
+			return (value + multiple - 1) & ~(multiple - 1);
+		}
+
+		/**
+		\param out    The string to append to.
+		\param format The format, as used by std::snprintf().
+		\param args   The arguments.
+
+		\brief Appends a formatted string.
+		*/
+		template<typename... ARGS>
+		void appendFormatted(NOU_DAT_ALG::String8 &out, const char *format, ARGS... args)
+		{
+			char buffer[256];
+			std::snprintf(buffer, sizeof(buffer), format, args...);
+			out.append(buffer);
+		}
+
+		/**
+		\param out     The string to append to.
+		\param address The address.
+
+		\brief Appends the (demangled, if possible) name of the function that contains an address.
+		*/
+		void appendSymbol(NOU_DAT_ALG::String8 &out, void *address)
+		{
+#if NOU_OS_LIBRARY == NOU_OS_LIBRARY_POSIX
+			Dl_info info;
+
+			if (dladdr(address, &info) != 0 && info.dli_sname != nullptr)
+			{
+				const char *name = info.dli_sname;
+				char *demangled = nullptr;
+
+#if NOU_COMPILER == NOU_COMPILER_GCC || NOU_COMPILER == NOU_COMPILER_CLANG
+				int status;
+				demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+				if (demangled != nullptr)
+					name = demangled;
+#endif
+
+				out.append(name);
+				appendFormatted(out, "+0x%zx", static_cast<size_t>(reinterpret_cast<byte*>(address) -
+					reinterpret_cast<byte*>(info.dli_saddr)));
+
+				std::free(demangled);
+				return;
+			}
+#endif
+
+			appendFormatted(out, "%p", address);
+		}
+
+		/**
+		\param out  The string to append to.
+		\param name The (possibly mangled) name of a type.
+
+		\brief Appends the demangled name of a type.
+		*/
+		void appendTypeName(NOU_DAT_ALG::String8 &out, const char *name)
+		{
+#if NOU_COMPILER == NOU_COMPILER_GCC || NOU_COMPILER == NOU_COMPILER_CLANG
+			int status;
+			char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+			if (demangled != nullptr)
+			{
+				out.append(demangled);
+				std::free(demangled);
+				return;
+			}
+#endif
+
+			out.append(name);
+		}
+
+		/**
+		\param out       The string to append to.
+		\param histogram The histogram.
+
+		\brief Appends the percentiles of a histogram.
+		*/
+		void appendPercentiles(NOU_DAT_ALG::String8 &out, const NOU_THREAD::LatencyHistogram &histogram)
+		{
+			appendFormatted(out, "p50 %llu, p90 %llu, p99 %llu, max %llu\n",
+				static_cast<unsigned long long>(histogram.percentile(50)),
+				static_cast<unsigned long long>(histogram.percentile(90)),
+				static_cast<unsigned long long>(histogram.percentile(99)),
+				static_cast<unsigned long long>(histogram.percentile(100)));
+		}
+
+		/**
+		\return A comparison of the allocated bytes, that sorts the site with the most bytes first.
+		*/
+		NOU_DAT_ALG::CompareResult compareSites(const AllocationProfiler::SiteStatistics &a,
+			const AllocationProfiler::SiteStatistics &b)
+		{
+			return a.allocatedBytes > b.allocatedBytes ? -1 : (a.allocatedBytes < b.allocatedBytes ? 1 : 0);
+		}
+
+		/**
+		\return A comparison of the allocated bytes, that sorts the type with the most bytes first.
+		*/
+		NOU_DAT_ALG::CompareResult compareTypes(const AllocationProfiler::TypeStatistics &a,
+			const AllocationProfiler::TypeStatistics &b)
+		{
+			return a.allocatedBytes > b.allocatedBytes ? -1 : (a.allocatedBytes < b.allocatedBytes ? 1 : 0);
+		}
+	}
+
+	AllocationProfiler::Profile::Profile() :
+		allocations(0),
+		allocatedBytes(0),
+		deallocations(0),
+		liveBytes(0),
+		peakLiveBytes(0)
+	{}
+
+	NOU_DAT_ALG::String8 AllocationProfiler::Profile::flatReport() const
+	{
+		NOU_DAT_ALG::String8 ret;
+
+		appendFormatted(ret, "allocations: %llu (%llu bytes), deallocations: %llu\n",
+			static_cast<unsigned long long>(allocations), static_cast<unsigned long long>(allocatedBytes),
+			static_cast<unsigned long long>(deallocations));
+		appendFormatted(ret, "live: %lld bytes, peak: %lld bytes\n", static_cast<long long>(liveBytes),
+			static_cast<long long>(peakLiveBytes));
+
+		ret.append("allocation size (bytes): ");
+		appendPercentiles(ret, sizes);
+		ret.append("lifetime (ns): ");
+		appendPercentiles(ret, lifetimes);
+
+		NOU_DAT_ALG::Vector<SiteStatistics> sortedSites = sites;
+
+		if (sortedSites.size() > 1)
+			sortedSites.sortComp(compareSites);
+
+		ret.append("\nsites (by allocated bytes):\n");
+		appendFormatted(ret, "%12s %14s %14s %14s  %s\n", "allocations", "bytes", "live bytes",
+			"avg life (ns)", "site");
+
+		for (sizeType i = 0; i < sortedSites.size(); i++)
+		{
+			const SiteStatistics &site = sortedSites[i];
+
+			uint64 averageLifetime = site.deallocations == 0 ? 0 : site.totalLifetimeNanos / site.deallocations;
+
+			appendFormatted(ret, "%12llu %14llu %14lld %14llu  ", static_cast<unsigned long long>(site.allocations),
+				static_cast<unsigned long long>(site.allocatedBytes), static_cast<long long>(site.liveBytes),
+				static_cast<unsigned long long>(averageLifetime));
+
+			if (site.label != nullptr)
+				appendFormatted(ret, "[%s]", site.label);
+
+			for (sizeType j = 0; j < site.stackDepth; j++)
+			{
+				ret.append(j == 0 ? (site.label != nullptr ? " " : "") : "\n" "                                    "
+					"                        <- ");
+				appendSymbol(ret, site.stack[j]);
+			}
+
+			if (site.label == nullptr && site.stackDepth == 0)
+				ret.append("<unknown>");
+
+			ret.append('\n');
+		}
+
+		NOU_DAT_ALG::Vector<TypeStatistics> sortedTypes = types;
+
+		if (sortedTypes.size() > 1)
+			sortedTypes.sortComp(compareTypes);
+
+		ret.append("\ntypes (by allocated bytes):\n");
+		appendFormatted(ret, "%12s %14s %14s %14s  %s\n", "allocations", "bytes", "live bytes", "peak bytes",
+			"type");
+
+		for (sizeType i = 0; i < sortedTypes.size(); i++)
+		{
+			const TypeStatistics &type = sortedTypes[i];
+
+			appendFormatted(ret, "%12llu %14llu %14lld %14lld  ", static_cast<unsigned long long>(type.allocations),
+				static_cast<unsigned long long>(type.allocatedBytes), static_cast<long long>(type.liveBytes),
+				static_cast<long long>(type.peakLiveBytes));
+
+			appendTypeName(ret, type.type->name);
+			ret.append('\n');
+		}
+
+		return ret;
+	}
+
+	NOU_DAT_ALG::String8 AllocationProfiler::Profile::heapProfile() const
+	{
+		NOU_DAT_ALG::String8 ret;
+
+		uint64 liveObjects = 0;
+		uint64 liveTotal = 0;
+
+		for (sizeType i = 0; i < sites.size(); i++)
+		{
+			if (sites[i].stackDepth == 0)
+				continue;
+
+			liveObjects += sites[i].liveAllocations > 0 ? static_cast<uint64>(sites[i].liveAllocations) : 0;
+			liveTotal += sites[i].liveBytes > 0 ? static_cast<uint64>(sites[i].liveBytes) : 0;
+		}
+
+		appendFormatted(ret, "heap profile: %llu: %llu [%llu: %llu] @ heapprofile\n",
+			static_cast<unsigned long long>(liveObjects), static_cast<unsigned long long>(liveTotal),
+			static_cast<unsigned long long>(allocations), static_cast<unsigned long long>(allocatedBytes));
+
+		for (sizeType i = 0; i < sites.size(); i++)
+		{
+			const SiteStatistics &site = sites[i];
+
+			if (site.stackDepth == 0)
+				continue;
+
+			appendFormatted(ret, "%llu: %llu [%llu: %llu] @",
+				static_cast<unsigned long long>(site.liveAllocations > 0 ? site.liveAllocations : 0),
+				static_cast<unsigned long long>(site.liveBytes > 0 ? site.liveBytes : 0),
+				static_cast<unsigned long long>(site.allocations),
+				static_cast<unsigned long long>(site.allocatedBytes));
+
+			for (sizeType j = 0; j < site.stackDepth; j++)
+				appendFormatted(ret, " %p", site.stack[j]);
+
+			ret.append('\n');
+		}
+
+		//pprof needs the mappings to symbolize the addresses
+		ret.append("\nMAPPED_LIBRARIES:\n");
+
+#if NOU_OS == NOU_OS_LINUX
+		FILE *maps = std::fopen("/proc/self/maps", "r");
+
+		if (maps != nullptr)
+		{
+			char line[512];
+
+			while (std::fgets(line, sizeof(line), maps) != nullptr)
+				ret.append(line);
+
+			std::fclose(maps);
+		}
+#endif
+
+		return ret;
+	}
+
+	AllocationProfiler::Scope::Scope(const char *label) :
+		m_previous(s_currentLabel)
+	{
+		s_currentLabel = label;
+	}
+
+	AllocationProfiler::Scope::~Scope()
+	{
+		s_currentLabel = m_previous;
+	}
+
+	AllocationProfiler::ThreadBuffer& AllocationProfiler::threadBuffer()
+	{
+		if (s_cachedProfiler == m_id)
+			return *reinterpret_cast<ThreadBuffer*>(s_cachedBuffer);
+
+		std::thread::id self = std::this_thread::get_id();
+
+		ThreadBuffer *buffer = m_buffers.load(std::memory_order_acquire);
+
+		//a thread that uses multiple profilers alternately already has a buffer
+		while (buffer != nullptr && buffer->m_thread != self)
+			buffer = buffer->m_next;
+
+		if (buffer == nullptr)
+		{
+			buffer = new ThreadBuffer();
+			buffer->m_head.store(0, std::memory_order_relaxed);
+			buffer->m_tail.store(0, std::memory_order_relaxed);
+			buffer->m_thread = self;
+			buffer->m_next = m_buffers.load(std::memory_order_relaxed);
+
+			while (!m_buffers.compare_exchange_weak(buffer->m_next, buffer, std::memory_order_release,
+				std::memory_order_relaxed));
+		}
+
+		s_cachedProfiler = m_id;
+		s_cachedBuffer = buffer;
+
+		return *buffer;
+	}
+
+	AllocationProfiler::Event& AllocationProfiler::nextEvent(ThreadBuffer &buffer)
+	{
+		sizeType tail = buffer.m_tail.load(std::memory_order_relaxed);
+
+		//only if the buffer is full, the thread has to take the lock and read the buffers itself
+		if (tail - buffer.m_head.load(std::memory_order_acquire) == BUFFER_SIZE)
+		{
+			NOU_THREAD::Lock lock(m_mutex);
+			drain();
+		}
+
+		return buffer.m_events[tail % BUFFER_SIZE];
+	}
+
+	void AllocationProfiler::publish(ThreadBuffer &buffer)
+	{
+		buffer.m_tail.store(buffer.m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	void AllocationProfiler::drain()
+	{
+		//the events of each buffer are ordered by time, merge them into a single ordered sequence
+		NOU_DAT_ALG::Vector<ThreadBuffer*> buffers;
+		NOU_DAT_ALG::Vector<sizeType> ends;
+
+		for (ThreadBuffer *buffer = m_buffers.load(std::memory_order_acquire); buffer != nullptr;
+			buffer = buffer->m_next)
+		{
+			buffers.pushBack(buffer);
+			ends.pushBack(buffer->m_tail.load(std::memory_order_acquire));
+		}
+
+		while (true)
+		{
+			ThreadBuffer *next = nullptr;
+			uint64 nextTime = 0;
+
+			for (sizeType i = 0; i < buffers.size(); i++)
+			{
+				sizeType head = buffers[i]->m_head.load(std::memory_order_relaxed);
+
+				if (head == ends[i])
+					continue;
+
+				uint64 time = buffers[i]->m_events[head % BUFFER_SIZE].m_time;
+
+				if (next == nullptr || time < nextTime)
+				{
+					next = buffers[i];
+					nextTime = time;
+				}
+			}
+
+			if (next == nullptr)
+				break;
+
+			sizeType head = next->m_head.load(std::memory_order_relaxed);
+
+			apply(next->m_events[head % BUFFER_SIZE]);
+
+			next->m_head.store(head + 1, std::memory_order_release);
+		}
+	}
+
+	AllocationProfiler::SiteStatistics& AllocationProfiler::siteOf(const Event &event)
+	{
+		sizeType *index = m_siteIndices.find(event.m_site);
+
+		if (index != nullptr)
+		{
+			SiteStatistics &site = m_sites[*index];
+
+			//the deallocation of a site may be read before its first allocation, if another thread has not
+			//published the allocation yet
+			if (event.m_isAllocation && site.stackDepth == 0 && site.label == nullptr)
+			{
+				site.label = event.m_label;
+				site.stackDepth = event.m_stackDepth;
+
+				for (sizeType i = 0; i < event.m_stackDepth; i++)
+					site.stack[i] = event.m_stack[i];
+			}
+
+			return site;
+		}
+
+		SiteStatistics site = {};
+
+		if (event.m_isAllocation)
+		{
+			site.label = event.m_label;
+			site.stackDepth = event.m_stackDepth;
+
+			for (sizeType i = 0; i < event.m_stackDepth; i++)
+				site.stack[i] = event.m_stack[i];
+		}
+
+		m_siteIndices.map(event.m_site, m_sites.size());
+		m_sites.pushBack(site);
+
+		return m_sites[m_sites.size() - 1];
+	}
+
+	AllocationProfiler::TypeStatistics& AllocationProfiler::typeOf(const AllocationTypeInfo *type)
+	{
+		uint64 key = static_cast<uint64>(reinterpret_cast<sizeType>(type));
+		sizeType *index = m_typeIndices.find(key);
+
+		if (index != nullptr)
+			return m_types[*index];
+
+		TypeStatistics statistics = {};
+		statistics.type = type;
+
+		m_typeIndices.map(key, m_types.size());
+		m_types.pushBack(statistics);
+
+		return m_types[m_types.size() - 1];
+	}
+
+	void AllocationProfiler::apply(const Event &event)
+	{
+		SiteStatistics &site = siteOf(event);
+		TypeStatistics &type = typeOf(event.m_type);
+
+		int64 bytes = static_cast<int64>(event.m_bytes);
+
+		if (event.m_isAllocation)
+		{
+			site.allocations++;
+			site.allocatedBytes += event.m_bytes;
+			site.liveAllocations++;
+			site.liveBytes += bytes;
+
+			type.allocations++;
+			type.allocatedBytes += event.m_bytes;
+			type.liveBytes += bytes;
+			type.peakLiveBytes = NOU_CORE::max(type.peakLiveBytes, type.liveBytes);
+
+			m_totals.allocations++;
+			m_totals.allocatedBytes += event.m_bytes;
+			m_totals.liveBytes += bytes;
+			m_totals.peakLiveBytes = NOU_CORE::max(m_totals.peakLiveBytes, m_totals.liveBytes);
+			m_totals.sizes.record(event.m_bytes);
+		}
+		else
+		{
+			site.deallocations++;
+			site.liveAllocations--;
+			site.liveBytes -= bytes;
+			site.totalLifetimeNanos += event.m_lifetime;
+
+			type.liveBytes -= bytes;
+
+			m_totals.deallocations++;
+			m_totals.liveBytes -= bytes;
+			m_totals.lifetimes.record(event.m_lifetime);
+		}
+	}
+
+	AllocationProfiler::AllocationProfiler(sizeType stackDepth) :
+		m_id(s_nextProfilerId.fetch_add(1, std::memory_order_relaxed)),
+		m_stackDepth(NOU_CORE::min(stackDepth, MAX_STACK_DEPTH)),
+		m_buffers(nullptr)
+	{}
+
+	AllocationProfiler::~AllocationProfiler()
+	{
+		ThreadBuffer *buffer = m_buffers.load(std::memory_order_acquire);
+
+		while (buffer != nullptr)
+		{
+			ThreadBuffer *next = buffer->m_next;
+			delete buffer;
+			buffer = next;
+		}
+	}
+
+	void* AllocationProfiler::allocate(sizeType bytes, sizeType alignment, const AllocationTypeInfo &type)
+	{
+		//the header directly precedes the memory of the user, the alignment of both must be preserved
+		alignment = NOU_CORE::max(alignment, alignof(Header));
+		sizeType offset = roundUp(sizeof(Header), alignment);
+
+		byte *block = alignedAlloc(offset + bytes, alignment);
+
+		if (block == nullptr)
+			return nullptr;
+
+		ThreadBuffer &buffer = threadBuffer();
+
+		//the event is written directly to the buffer, the stack makes it too large to be copied cheaply
+		Event &event = nextEvent(buffer);
+
+		event.m_stackDepth = 0;
+
+		if (m_stackDepth > 0)
+		{
+#if NOU_OS_LIBRARY == NOU_OS_LIBRARY_WIN_H
+			event.m_stackDepth = CaptureStackBackTrace(1, static_cast<DWORD>(m_stackDepth), event.m_stack,
+				nullptr);
+#elif NOU_OS_LIBRARY == NOU_OS_LIBRARY_POSIX
+			//the first frame is this function itself
+			void *frames[MAX_STACK_DEPTH + 1];
+			int depth = backtrace(frames, static_cast<int>(m_stackDepth + 1));
+
+			for (int i = 1; i < depth; i++)
+				event.m_stack[event.m_stackDepth++] = frames[i];
+#endif
+		}
+
+		event.m_label = s_currentLabel;
+		event.m_site = NOU_DAT_ALG::hash64(event.m_stack, event.m_stackDepth * sizeof(void*),
+			static_cast<uint64>(reinterpret_cast<sizeType>(event.m_label)));
+		event.m_time = profilerTime();
+		event.m_type = &type;
+		event.m_bytes = bytes;
+		event.m_lifetime = 0;
+		event.m_isAllocation = true;
+
+		Header *header = new (block + offset - sizeof(Header)) Header();
+		header->m_site = event.m_site;
+		header->m_time = event.m_time;
+		header->m_type = &type;
+		header->m_bytes = bytes;
+		header->m_offset = offset;
+
+		publish(buffer);
+
+		return block + offset;
+	}
+
+	void AllocationProfiler::deallocate(void *data)
+	{
+		if (data == nullptr)
+			return;
+
+		Header *header = reinterpret_cast<Header*>(reinterpret_cast<byte*>(data) - sizeof(Header));
+
+		ThreadBuffer &buffer = threadBuffer();
+		Event &event = nextEvent(buffer);
+
+		event.m_time = profilerTime();
+		event.m_site = header->m_site;
+		event.m_type = header->m_type;
+		event.m_bytes = header->m_bytes;
+		event.m_lifetime = event.m_time - header->m_time;
+		event.m_isAllocation = false;
+		event.m_label = nullptr;
+		event.m_stackDepth = 0;
+
+		alignedFree(reinterpret_cast<byte*>(data) - header->m_offset);
+
+		publish(buffer);
+	}
+
+	AllocationProfiler::Profile AllocationProfiler::getProfile()
+	{
+		NOU_THREAD::Lock lock(m_mutex);
+
+		drain();
+
+		Profile ret = m_totals;
+		ret.sites = m_sites;
+		ret.types = m_types;
+
+		return ret;
+	}
+
+	sizeType AllocationProfiler::getStackDepth() const
+	{
+		return m_stackDepth;
+	}
+
+	AllocationProfiler& AllocationProfiler::getDefault()
+	{
+		//never destroyed, containers with static storage duration may still deallocate during shutdown
+		static AllocationProfiler *profiler = new AllocationProfiler();
+		return *profiler;
+	}
+}
@@ -1,4 +1,5 @@
 #include "nostrautils/mem_mngt/GeneralPurposeAllocator.hpp"
+#include "nostrautils/core/Bits.hpp"
 
 namespace NOU::NOU_MEM_MNGT
 {
@@ -55,19 +56,371 @@ namespace NOU::NOU_MEM_MNGT
 		return m_addr == other.m_addr;
 	}
 
-	GeneralPurposeAllocator::GeneralPurposeAllocator(sizeType size) :
-		m_size(size)
+	sizeType internal::GeneralPurposeAllocatorSegregatedFit::blockSize(const Block *block)
+	{
+		return block->m_size & ~FREE_BIT;
+	}
+
+	boolean internal::GeneralPurposeAllocatorSegregatedFit::isFree(const Block *block)
+	{
+		return (block->m_size & FREE_BIT) != 0;
+	}
+
+	internal::GeneralPurposeAllocatorSegregatedFit::FreeLinks* 
+		internal::GeneralPurposeAllocatorSegregatedFit::links(Block *block)
+	{
+		return reinterpret_cast<FreeLinks*>(reinterpret_cast<byte*>(block) + HEADER_SIZE);
+	}
+
+	internal::GeneralPurposeAllocatorSegregatedFit::Block* 
+		internal::GeneralPurposeAllocatorSegregatedFit::nextPhysical(Block *block)
+	{
+		return reinterpret_cast<Block*>(reinterpret_cast<byte*>(block) + HEADER_SIZE + blockSize(block));
+	}
+
+	void internal::GeneralPurposeAllocatorSegregatedFit::mapInsert(sizeType size, sizeType &firstLevel, 
+		sizeType &secondLevel)
+	{
+		if (size < SMALL_BLOCK_SIZE)
+		{
+			firstLevel = 0;
+			secondLevel = size / (SMALL_BLOCK_SIZE / SECOND_LEVEL_COUNT);
+		}
+		else
+		{
+			sizeType mostSignificantBit = 63 - NOU_CORE::countLeadingZeros(size);
+
+			secondLevel = (size >> (mostSignificantBit - SECOND_LEVEL_LOG2)) ^ SECOND_LEVEL_COUNT;
+			firstLevel = mostSignificantBit - FIRST_LEVEL_SHIFT + 1;
+		}
+	}
+
+	void internal::GeneralPurposeAllocatorSegregatedFit::mapSearch(sizeType size, sizeType &firstLevel, 
+		sizeType &secondLevel)
+	{
+		if (size >= SMALL_BLOCK_SIZE)
+		{
+			//round up to the next second level step, so that every block in the class is large enough
+			sizeType mostSignificantBit = 63 - NOU_CORE::countLeadingZeros(size);
+			size += (sizeType(1) << (mostSignificantBit - SECOND_LEVEL_LOG2)) - 1;
+		}
+
+		mapInsert(size, firstLevel, secondLevel);
+	}
+
+	void internal::GeneralPurposeAllocatorSegregatedFit::insertFree(Block *block)
+	{
+		sizeType firstLevel;
+		sizeType secondLevel;
+		mapInsert(blockSize(block), firstLevel, secondLevel);
+
+		Block *head = m_freeLists[firstLevel][secondLevel];
+
+		links(block)->m_next = head;
+		links(block)->m_prev = nullptr;
+
+		if (head != nullptr)
+		{
+			links(head)->m_prev = block;
+		}
+
+		m_freeLists[firstLevel][secondLevel] = block;
+		m_firstLevelBitmap |= uint64(1) << firstLevel;
+		m_secondLevelBitmaps[firstLevel] |= uint32(1) << secondLevel;
+	}
+
+	void internal::GeneralPurposeAllocatorSegregatedFit::removeFree(Block *block)
+	{
+		sizeType firstLevel;
+		sizeType secondLevel;
+		mapInsert(blockSize(block), firstLevel, secondLevel);
+
+		Block *next = links(block)->m_next;
+		Block *prev = links(block)->m_prev;
+
+		if (next != nullptr)
+		{
+			links(next)->m_prev = prev;
+		}
+
+		if (prev != nullptr)
+		{
+			links(prev)->m_next = next;
+		}
+		else
+		{
+			m_freeLists[firstLevel][secondLevel] = next;
+
+			if (next == nullptr)
+			{
+				m_secondLevelBitmaps[firstLevel] &= ~(uint32(1) << secondLevel);
+
+				if (m_secondLevelBitmaps[firstLevel] == 0)
+				{
+					m_firstLevelBitmap &= ~(uint64(1) << firstLevel);
+				}
+			}
+		}
+	}
+
+	internal::GeneralPurposeAllocatorSegregatedFit::Block* 
+		internal::GeneralPurposeAllocatorSegregatedFit::findFree(sizeType size) const
+	{
+		sizeType firstLevel;
+		sizeType secondLevel;
+		mapSearch(size, firstLevel, secondLevel);
+
+		if (firstLevel >= FIRST_LEVEL_COUNT)
+		{
+			return nullptr;
+		}
+
+		uint32 secondLevelMap = m_secondLevelBitmaps[firstLevel] & (~uint32(0) << secondLevel);
+
+		if (secondLevelMap == 0)
+		{
+			//no fitting block in this first level class, use the smallest block of a larger one
+			uint64 firstLevelMap = firstLevel + 1 < 64 ? m_firstLevelBitmap & (~uint64(0) << (firstLevel + 1)) 
+				: 0;
+
+			if (firstLevelMap == 0)
+			{
+				return nullptr;
+			}
+
+			firstLevel = NOU_CORE::countTrailingZeros(firstLevelMap);
+			secondLevelMap = m_secondLevelBitmaps[firstLevel];
+		}
+
+		secondLevel = NOU_CORE::countTrailingZeros(secondLevelMap);
+
+		return m_freeLists[firstLevel][secondLevel];
+	}
+
+	void internal::GeneralPurposeAllocatorSegregatedFit::split(Block *block, sizeType size)
+	{
+		sizeType oldSize = blockSize(block);
+
+		if (oldSize < size + HEADER_SIZE + MIN_BLOCK_SIZE)
+		{
+			return;
+		}
+
+		Block *remaining = reinterpret_cast<Block*>(reinterpret_cast<byte*>(block) + HEADER_SIZE + size);
+		remaining->m_prevPhysical = block;
+		remaining->m_size = (oldSize - size - HEADER_SIZE) | FREE_BIT;
+		nextPhysical(remaining)->m_prevPhysical = remaining;
+
+		block->m_size = size | (block->m_size & FREE_BIT);
+
+		insertFree(remaining);
+	}
+
+	internal::GeneralPurposeAllocatorSegregatedFit::GeneralPurposeAllocatorSegregatedFit(byte *memory, 
+		sizeType size) :
+		m_firstLevelBitmap(0)
+	{
+		for (sizeType i = 0; i < FIRST_LEVEL_COUNT; i++)
+		{
+			m_secondLevelBitmaps[i] = 0;
+
+			for (sizeType j = 0; j < SECOND_LEVEL_COUNT; j++)
+			{
+				m_freeLists[i][j] = nullptr;
+			}
+		}
+
+		//the first payload and the sentinel need to be aligned
+		m_begin = reinterpret_cast<byte*>(nextMultiple(ALIGNMENT, reinterpret_cast<sizeType>(memory)));
+		m_end = reinterpret_cast<byte*>((reinterpret_cast<sizeType>(memory + size) / ALIGNMENT) * ALIGNMENT);
+
+		if (m_end < m_begin + 2 * HEADER_SIZE + MIN_BLOCK_SIZE)
+		{
+			//the region is too small to hold a single block
+			m_begin = m_end;
+			m_end = nullptr;
+			return;
+		}
+
+		m_end -= HEADER_SIZE;
+
+		Block *sentinel = reinterpret_cast<Block*>(m_end);
+		Block *first = reinterpret_cast<Block*>(m_begin);
+
+		first->m_prevPhysical = nullptr;
+		first->m_size = (m_end - m_begin - HEADER_SIZE) | FREE_BIT;
+
+		sentinel->m_prevPhysical = first;
+		sentinel->m_size = 0;
+
+		insertFree(first);
+	}
+
+	void* internal::GeneralPurposeAllocatorSegregatedFit::allocate(sizeType size, sizeType alignment)
+	{
+		if (m_end == nullptr || size > static_cast<sizeType>(m_end - m_begin))
+		{
+			return nullptr;
+		}
+
+		size = size < MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : nextMultiple(ALIGNMENT, size);
+
+		//if the alignment is larger than the one of the payloads, a gap is needed in front of the object; 
+		//if the gap is not empty, it has to be large enough to be a free block of its own
+		sizeType searchSize = alignment <= ALIGNMENT ? size : size + alignment + HEADER_SIZE + MIN_BLOCK_SIZE;
+
+		Block *block = findFree(searchSize);
+
+		if (block == nullptr)
+		{
+			return nullptr;
+		}
+
+		removeFree(block);
+
+		if (alignment > ALIGNMENT)
+		{
+			sizeType payload = reinterpret_cast<sizeType>(block) + HEADER_SIZE;
+			sizeType aligned = nextMultiple(alignment, payload);
+
+			if (aligned != payload && aligned - payload < HEADER_SIZE + MIN_BLOCK_SIZE)
+			{
+				aligned = nextMultiple(alignment, payload + HEADER_SIZE + MIN_BLOCK_SIZE);
+			}
+
+			if (aligned != payload)
+			{
+				sizeType gap = aligned - payload;
+
+				//the previous block is never free, so the gap does not need to be merged
+				Block *alignedBlock = reinterpret_cast<Block*>(aligned - HEADER_SIZE);
+				alignedBlock->m_prevPhysical = block;
+				alignedBlock->m_size = blockSize(block) - gap;
+				nextPhysical(alignedBlock)->m_prevPhysical = alignedBlock;
+
+				block->m_size = (gap - HEADER_SIZE) | FREE_BIT;
+				insertFree(block);
+
+				block = alignedBlock;
+			}
+		}
+
+		block->m_size &= ~FREE_BIT;
+		split(block, size);
+
+		return reinterpret_cast<byte*>(block) + HEADER_SIZE;
+	}
+
+	void internal::GeneralPurposeAllocatorSegregatedFit::deallocate(void *ptr)
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		Block *block = reinterpret_cast<Block*>(reinterpret_cast<byte*>(ptr) - HEADER_SIZE);
+		Block *prev = block->m_prevPhysical;
+		Block *next = nextPhysical(block);
+
+		if (prev != nullptr && isFree(prev))
+		{
+			removeFree(prev);
+			prev->m_size = (blockSize(prev) + HEADER_SIZE + blockSize(block)) | FREE_BIT;
+			next->m_prevPhysical = prev;
+			block = prev;
+		}
+		else
+		{
+			block->m_size |= FREE_BIT;
+		}
+
+		//the sentinel is never free, therefore this never reads past the region
+		if (isFree(next))
+		{
+			removeFree(next);
+			block->m_size = (blockSize(block) + HEADER_SIZE + blockSize(next)) | FREE_BIT;
+			nextPhysical(block)->m_prevPhysical = block;
+		}
+
+		insertFree(block);
+	}
+
+	boolean internal::GeneralPurposeAllocatorSegregatedFit::isAllocated(const void *ptr) const
+	{
+		const byte *bytePtr = reinterpret_cast<const byte*>(ptr);
+
+		if (m_end == nullptr || bytePtr < m_begin + HEADER_SIZE || bytePtr >= m_end ||
+			reinterpret_cast<sizeType>(bytePtr) % ALIGNMENT != 0)
+		{
+			return false;
+		}
+
+		const Block *block = reinterpret_cast<const Block*>(bytePtr - HEADER_SIZE);
+
+		return !isFree(block);
+	}
+
+	void GeneralPurposeAllocator::initialize()
+	{
+		if (m_mode == GeneralPurposeAllocatorMode::SEGREGATED_FIT)
+		{
+			m_segregatedFit = new internal::GeneralPurposeAllocatorSegregatedFit(m_data, m_size);
+		}
+		else
+		{
+			m_freeChunks.pushBack(internal::GeneralPurposeAllocatorFreeChunk(m_data, m_size));
+		}
+	}
+
+	GeneralPurposeAllocator::GeneralPurposeAllocator(sizeType size, GeneralPurposeAllocatorMode mode) :
+		m_size(size),
+		m_mode(mode),
+		m_segregatedFit(nullptr)
 	{
 		m_data = new byte[m_size];
-		m_freeChunks.pushBack(internal::GeneralPurposeAllocatorFreeChunk(m_data, m_size));
+
+		initialize();
+	}
+
+	GeneralPurposeAllocator::GeneralPurposeAllocator(sizeType size, GeneralPurposeAllocatorMode mode,
+		const PageAllocationOptions &pageOptions) :
+		m_size(size),
+		m_mode(mode),
+		m_segregatedFit(nullptr),
+		m_pages(pageAlloc(size, pageOptions))
+	{
+		if (m_pages.data != nullptr)
+		{
+			//the rest of the last page would be wasted otherwise
+			m_data = m_pages.data;
+			m_size = m_pages.size;
+		}
+		else
+		{
+			m_data = new byte[m_size];
+		}
+
+		initialize();
 	}
 
 	GeneralPurposeAllocator::~GeneralPurposeAllocator()
 	{
-		if (m_data != nullptr)
+		delete m_segregatedFit;
+
+		if (m_pages.data != nullptr)
+		{
+			pageFree(m_pages);
+			m_data = nullptr;
+		}
+		else if (m_data != nullptr)
 		{
 			delete[] m_data;
 			m_data = nullptr;
 		}
 	}
+
+	GeneralPurposeAllocatorMode GeneralPurposeAllocator::getMode() const
+	{
+		return m_mode;
+	}
 }
\ No newline at end of file
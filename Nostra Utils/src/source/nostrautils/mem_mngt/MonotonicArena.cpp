@@ -0,0 +1,201 @@
+#include "nostrautils/mem_mngt/MonotonicArena.hpp"
+
+namespace NOU::NOU_MEM_MNGT
+{
+	/**
+	\brief The current arena of each thread.
+	*/
+	static thread_local MonotonicArena *s_currentArena = nullptr;
+
+	constexpr sizeType MonotonicArena::DEFAULT_BLOCK_SIZE;
+	constexpr sizeType MonotonicArena::MAX_BLOCK_SIZE;
+	constexpr sizeType MonotonicArena::HEADER_SIZE;
+
+	byte* MonotonicArena::blockBegin(Block *block)
+	{
+		return reinterpret_cast<byte*>(block) + HEADER_SIZE;
+	}
+
+	MonotonicArena::Block* MonotonicArena::allocateBlock(sizeType size)
+	{
+		Block *ret;
+
+		if (m_usePages)
+		{
+			PageRegion region = pageAlloc(HEADER_SIZE + size, m_pageOptions);
+
+			if (region.data == nullptr)
+				return nullptr;
+
+			ret = reinterpret_cast<Block*>(region.data);
+			ret->m_size = region.size - HEADER_SIZE;
+			ret->m_region = region;
+		}
+		else
+		{
+			ret = reinterpret_cast<Block*>(alignedAlloc(HEADER_SIZE + size, alignof(std::max_align_t)));
+
+			if (ret == nullptr)
+				return nullptr;
+
+			ret->m_size = size;
+			ret->m_region = PageRegion();
+		}
+
+		return ret;
+	}
+
+	void* MonotonicArena::allocateSlow(sizeType bytes, sizeType alignment)
+	{
+		//enough for the allocation, even if the start of the block needs to be padded
+		sizeType required = bytes + alignment;
+
+		Block *block = m_current == nullptr ? m_first : m_current->m_next;
+
+		//reuse the next block in the chain if it is large enough, otherwise insert a new one in front of it
+		if (block == nullptr || block->m_size < required)
+		{
+			sizeType size = m_nextBlockSize < required ? required : m_nextBlockSize;
+
+			Block *newBlock = allocateBlock(size);
+
+			if (newBlock == nullptr)
+				return nullptr;
+
+			newBlock->m_next = block;
+
+			if (m_current == nullptr)
+				m_first = newBlock;
+			else
+				m_current->m_next = newBlock;
+
+			m_capacity += newBlock->m_size;
+
+			if (m_nextBlockSize < MAX_BLOCK_SIZE)
+				m_nextBlockSize = m_nextBlockSize * 2 < MAX_BLOCK_SIZE ? m_nextBlockSize * 2 : MAX_BLOCK_SIZE;
+
+			block = newBlock;
+		}
+
+		m_current = block;
+		m_position = blockBegin(block);
+		m_end = m_position + block->m_size;
+
+		return allocate(bytes, alignment);
+	}
+
+	MonotonicArena::Marker::Marker(Block *block, byte *position) :
+		m_block(block),
+		m_position(position)
+	{}
+
+	MonotonicArena::Scope::Scope(MonotonicArena &arena) :
+		m_previous(s_currentArena)
+	{
+		s_currentArena = &arena;
+	}
+
+	MonotonicArena::Scope::~Scope()
+	{
+		s_currentArena = m_previous;
+	}
+
+	MonotonicArena::MonotonicArena(sizeType blockSize) :
+		m_first(nullptr),
+		m_current(nullptr),
+		m_position(nullptr),
+		m_end(nullptr),
+		m_nextBlockSize(blockSize == 0 ? DEFAULT_BLOCK_SIZE : blockSize),
+		m_capacity(0),
+		m_usePages(false)
+	{}
+
+	MonotonicArena::MonotonicArena(sizeType blockSize, const PageAllocationOptions &pageOptions) :
+		m_first(nullptr),
+		m_current(nullptr),
+		m_position(nullptr),
+		m_end(nullptr),
+		m_nextBlockSize(blockSize == 0 ? DEFAULT_BLOCK_SIZE : blockSize),
+		m_capacity(0),
+		m_usePages(true),
+		m_pageOptions(pageOptions)
+	{}
+
+	MonotonicArena::~MonotonicArena()
+	{
+		release();
+	}
+
+	void* MonotonicArena::allocate(sizeType bytes, sizeType alignment)
+	{
+		sizeType position = reinterpret_cast<sizeType>(m_position);
+		sizeType aligned = (position + alignment - 1) & ~(alignment - 1);
+
+		if (m_position == nullptr || bytes > static_cast<sizeType>(m_end - m_position) ||
+			aligned - position > static_cast<sizeType>(m_end - m_position) - bytes)
+		{
+			return allocateSlow(bytes, alignment);
+		}
+
+		m_position = reinterpret_cast<byte*>(aligned + bytes);
+
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	MonotonicArena::Marker MonotonicArena::mark() const
+	{
+		return Marker(m_current, m_position);
+	}
+
+	void MonotonicArena::rewind(const Marker &marker)
+	{
+		if (marker.m_block == nullptr)
+		{
+			reset();
+			return;
+		}
+
+		m_current = marker.m_block;
+		m_position = marker.m_position;
+		m_end = blockBegin(m_current) + m_current->m_size;
+	}
+
+	void MonotonicArena::reset()
+	{
+		m_current = nullptr;
+		m_position = nullptr;
+		m_end = nullptr;
+	}
+
+	void MonotonicArena::release()
+	{
+		Block *block = m_first;
+
+		while (block != nullptr)
+		{
+			Block *next = block->m_next;
+
+			if (block->m_region.data != nullptr)
+				pageFree(block->m_region);
+			else
+				alignedFree(block);
+
+			block = next;
+		}
+
+		m_first = nullptr;
+		m_capacity = 0;
+
+		reset();
+	}
+
+	sizeType MonotonicArena::capacity() const
+	{
+		return m_capacity;
+	}
+
+	MonotonicArena* MonotonicArena::getCurrent()
+	{
+		return s_currentArena;
+	}
+}
@@ -0,0 +1,304 @@
+#include "nostrautils/mem_mngt/PageAllocator.hpp"
+
+#if NOU_OS_LIBRARY == NOU_OS_LIBRARY_WIN_H
+#include <Windows.h>
+#elif NOU_OS_LIBRARY == NOU_OS_LIBRARY_POSIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if NOU_OS == NOU_OS_LINUX
+#include <sys/syscall.h>
+#include <cstdio>
+#endif
+
+namespace NOU::NOU_MEM_MNGT
+{
+	constexpr sizeType PageAllocationOptions::ANY_NUMA_NODE;
+
+	PageAllocationOptions::PageAllocationOptions(HugePageMode hugePages, boolean prefault, sizeType numaNode) :
+		hugePages(hugePages),
+		prefault(prefault),
+		numaNode(numaNode)
+	{}
+
+	PageRegion::PageRegion() :
+		data(nullptr),
+		size(0),
+		type(PageType::NONE)
+	{}
+
+	namespace
+	{
+		/**
+		\param value    The value to round.
+		\param multiple The multiple.
+
+		\return \p value, rounded up to the next multiple of \p multiple.
+		*/
+		sizeType roundUp(sizeType value, sizeType multiple)
+		{
+			return (value + multiple - 1) / multiple * multiple;
+		}
+
+		/**
+		\param region The region.
+		\param stride The distance between two writes, this should be the size of the pages of the region.
+
+		\brief Writes to each page of a region, so that all pages are faulted in.
+		*/
+		void touchPages(const PageRegion &region, sizeType stride)
+		{
+			//the memory is already zeroed, but only a write makes the system back it with memory
+			for (sizeType i = 0; i < region.size; i += stride)
+				reinterpret_cast<volatile byte*>(region.data)[i] = 0;
+		}
+
+#if NOU_OS_LIBRARY == NOU_OS_LIBRARY_POSIX
+		/**
+		\param bytes The size of the mapping.
+		\param flags Additional flags that are passed to mmap().
+
+		\return The mapping, or \p nullptr if mmap() failed.
+		*/
+		byte* mapAnonymous(sizeType bytes, int flags)
+		{
+			void *ret = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+
+			return ret == MAP_FAILED ? nullptr : reinterpret_cast<byte*>(ret);
+		}
+#endif
+
+#if NOU_OS == NOU_OS_LINUX
+		/**
+		\param bytes     The size of the mapping.
+		\param alignment The alignment of the mapping.
+
+		\return The mapping, or \p nullptr if mmap() failed.
+
+		\brief Maps memory that is aligned to \p alignment, which must be a multiple of the regular page size.
+		*/
+		byte* mapAligned(sizeType bytes, sizeType alignment)
+		{
+			//map more than needed and cut off the unaligned parts at the beginning and the end
+			byte *raw = mapAnonymous(bytes + alignment, 0);
+
+			if (raw == nullptr)
+				return nullptr;
+
+			byte *aligned = reinterpret_cast<byte*>(roundUp(reinterpret_cast<sizeType>(raw), alignment));
+
+			if (aligned != raw)
+				munmap(raw, aligned - raw);
+
+			sizeType tail = static_cast<sizeType>((raw + bytes + alignment) - (aligned + bytes));
+
+			if (tail != 0)
+				munmap(aligned + bytes, tail);
+
+			return aligned;
+		}
+
+		/**
+		\param region The region.
+		\param node   The NUMA node.
+
+		\return True, if the region was bound to the node, false if not.
+
+		\brief Binds a region to a NUMA node. This must happen before the pages are faulted in.
+		*/
+		boolean bindToNode(const PageRegion &region, sizeType node)
+		{
+			//the same limit as the one of the node sets in Topology
+			constexpr sizeType MAX_NODE_COUNT = 1024;
+			constexpr sizeType BITS_PER_WORD = sizeof(unsigned long) * 8;
+
+			//the value of MPOL_BIND in <numaif.h>, which is part of libnuma and may not be available
+			constexpr int MPOL_BIND_POLICY = 2;
+
+			if (node >= MAX_NODE_COUNT)
+				return false;
+
+			unsigned long mask[MAX_NODE_COUNT / BITS_PER_WORD] = {};
+			mask[node / BITS_PER_WORD] |= 1ul << (node % BITS_PER_WORD);
+
+			//the kernel ignores the last bit of the mask, hence the + 1
+			return syscall(SYS_mbind, region.data, region.size, MPOL_BIND_POLICY, mask, MAX_NODE_COUNT + 1, 0)
+				== 0;
+		}
+
+		/**
+		\return The default size of a huge page, as it is stated in /proc/meminfo, or 0 if it is not stated.
+		*/
+		sizeType readHugePageSize()
+		{
+			FILE *file = std::fopen("/proc/meminfo", "r");
+
+			if (file == nullptr)
+				return 0;
+
+			char line[256];
+			sizeType ret = 0;
+
+			while (std::fgets(line, sizeof(line), file) != nullptr)
+			{
+				unsigned long kiloBytes;
+
+				if (std::sscanf(line, "Hugepagesize: %lu kB", &kiloBytes) == 1)
+				{
+					ret = static_cast<sizeType>(kiloBytes) * 1024;
+					break;
+				}
+			}
+
+			std::fclose(file);
+
+			return ret;
+		}
+#endif
+	}
+
+	sizeType pageSize()
+	{
+#if NOU_OS_LIBRARY == NOU_OS_LIBRARY_WIN_H
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+
+		return static_cast<sizeType>(info.dwPageSize);
+#elif NOU_OS_LIBRARY == NOU_OS_LIBRARY_POSIX
+		static sizeType size = static_cast<sizeType>(sysconf(_SC_PAGESIZE));
+
+		return size;
+#else
+		return 4096;
+#endif
+	}
+
+	sizeType hugePageSize()
+	{
+#if NOU_OS_LIBRARY == NOU_OS_LIBRARY_WIN_H
+		return static_cast<sizeType>(GetLargePageMinimum());
+#elif NOU_OS == NOU_OS_LINUX
+		static sizeType size = readHugePageSize();
+
+		return size;
+#else
+		return 0;
+#endif
+	}
+
+	PageRegion pageAlloc(sizeType bytes, const PageAllocationOptions &options)
+	{
+		PageRegion ret;
+
+		if (bytes == 0)
+			return ret;
+
+		sizeType hugeSize = hugePageSize();
+
+#if NOU_OS_LIBRARY == NOU_OS_LIBRARY_WIN_H
+		boolean bind = options.numaNode != PageAllocationOptions::ANY_NUMA_NODE;
+
+		//Windows has no transparent huge pages, only EXPLICIT makes a difference
+		if (options.hugePages == HugePageMode::EXPLICIT && hugeSize != 0)
+		{
+			ret.size = roundUp(bytes, hugeSize);
+
+			DWORD flags = MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES;
+
+			ret.data = reinterpret_cast<byte*>(bind ?
+				VirtualAllocExNuma(GetCurrentProcess(), nullptr, ret.size, flags, PAGE_READWRITE,
+					static_cast<DWORD>(options.numaNode)) :
+				VirtualAlloc(nullptr, ret.size, flags, PAGE_READWRITE));
+
+			ret.type = PageType::HUGE;
+		}
+
+		if (ret.data == nullptr)
+		{
+			ret.size = roundUp(bytes, pageSize());
+
+			DWORD flags = MEM_RESERVE | MEM_COMMIT;
+
+			ret.data = reinterpret_cast<byte*>(bind ?
+				VirtualAllocExNuma(GetCurrentProcess(), nullptr, ret.size, flags, PAGE_READWRITE,
+					static_cast<DWORD>(options.numaNode)) :
+				VirtualAlloc(nullptr, ret.size, flags, PAGE_READWRITE));
+
+			ret.type = PageType::SMALL;
+		}
+
+		if (ret.data == nullptr)
+			return PageRegion();
+
+		if (options.prefault)
+			touchPages(ret, ret.type == PageType::HUGE ? hugeSize : pageSize());
+#elif NOU_OS_LIBRARY == NOU_OS_LIBRARY_POSIX
+		boolean populated = false;
+
+#if NOU_OS == NOU_OS_LINUX
+		boolean bind = options.numaNode != PageAllocationOptions::ANY_NUMA_NODE;
+
+		//if the memory is bound to a node, the pages must not be faulted in by mmap()
+		int populate = options.prefault && !bind ? MAP_POPULATE : 0;
+
+		if (options.hugePages == HugePageMode::EXPLICIT && hugeSize != 0)
+		{
+			ret.size = roundUp(bytes, hugeSize);
+			ret.data = mapAnonymous(ret.size, MAP_HUGETLB | populate);
+			ret.type = PageType::HUGE;
+			populated = ret.data != nullptr && populate != 0;
+		}
+
+		if (ret.data == nullptr && options.hugePages != HugePageMode::NONE && hugeSize != 0)
+		{
+			ret.size = roundUp(bytes, hugeSize);
+			ret.data = mapAligned(ret.size, hugeSize);
+
+			//MADV_HUGEPAGE fails if transparent huge pages are disabled, the region is still usable
+			if (ret.data != nullptr)
+				ret.type = madvise(ret.data, ret.size, MADV_HUGEPAGE) == 0 ? PageType::TRANSPARENT_HUGE :
+					PageType::SMALL;
+		}
+
+		if (ret.data == nullptr)
+		{
+			ret.size = roundUp(bytes, pageSize());
+			ret.data = mapAnonymous(ret.size, populate);
+			ret.type = PageType::SMALL;
+			populated = populate != 0;
+		}
+#else
+		ret.size = roundUp(bytes, pageSize());
+		ret.data = mapAnonymous(ret.size, 0);
+		ret.type = PageType::SMALL;
+#endif
+
+		if (ret.data == nullptr)
+			return PageRegion();
+
+#if NOU_OS == NOU_OS_LINUX
+		//binding is best effort, e.g. the node may not exist
+		if (bind)
+			bindToNode(ret, options.numaNode);
+#endif
+
+		if (options.prefault && !populated)
+			touchPages(ret, ret.type == PageType::HUGE ? hugeSize : pageSize());
+#endif
+
+		return ret;
+	}
+
+	void pageFree(const PageRegion &region)
+	{
+		if (region.data == nullptr)
+			return;
+
+#if NOU_OS_LIBRARY == NOU_OS_LIBRARY_WIN_H
+		VirtualFree(region.data, 0, MEM_RELEASE);
+#elif NOU_OS_LIBRARY == NOU_OS_LIBRARY_POSIX
+		munmap(region.data, region.size);
+#endif
+	}
+}
@@ -0,0 +1,623 @@
+#include "nostrautils/mem_mngt/Reclamation.hpp"
+#include "nostrautils/core/ErrorHandler.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
+#include "nostrautils/thread/Lock.hpp"
+#include "nostrautils/thread/Mutex.hpp"
+
+namespace NOU::NOU_MEM_MNGT
+{
+	constexpr sizeType RetiredObject::CALLBACK_SIZE;
+	constexpr sizeType internal::ReclamationDomain::HAZARD_POINTER_COUNT;
+	constexpr sizeType internal::ReclamationDomain::DEFAULT_BATCH_SIZE;
+
+	struct internal::ReclamationDomain::ThreadRecord
+	{
+		/**
+		\brief The state of the thread in an EpochReclaimer: the observed epoch shifted by one bit, with the
+		       lowest bit set while the thread is in a critical section, or 0 if it is not.
+		*/
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64> m_state;
+
+		/**
+		\brief The hazard pointers of the thread in a HazardPointerDomain.
+		*/
+		std::atomic<void*> m_hazards[HAZARD_POINTER_COUNT];
+
+		/**
+		\brief True, if a thread owns the record.
+		*/
+		alignas(CACHE_LINE_SIZE) std::atomic<boolean> m_owned;
+
+		/**
+		\brief The amount of nested critical sections of the owning thread.
+		*/
+		sizeType m_nesting;
+
+		/**
+		\brief A bit mask of the hazard pointers that are in use by the owning thread.
+		*/
+		uint32 m_usedHazards;
+
+		/**
+		\brief True, while the owning thread reclaims objects. Destructors of reclaimed objects may retire other
+		       objects, but that must not start another reclamation.
+		*/
+		boolean m_collecting;
+
+		/**
+		\brief The amount of retired objects that triggers the next attempt to reclaim them.
+		*/
+		sizeType m_nextCollect;
+
+		/**
+		\brief The size of \p m_retired, for retiredCount().
+		*/
+		std::atomic<sizeType> m_retiredCount;
+
+		/**
+		\brief The objects that were retired by the owning thread and that have not been reclaimed yet.
+		*/
+		NOU_DAT_ALG::Vector<RetiredObject> m_retired;
+
+		/**
+		\brief The hazard pointers that are collected when the objects are reclaimed by a HazardPointerDomain,
+		       stored here to avoid allocating memory each time.
+		*/
+		NOU_DAT_ALG::Vector<void*> m_scratch;
+
+		/**
+		\brief The next record of the same reclaimer.
+		*/
+		ThreadRecord *m_next;
+
+		/**
+		\param batchSize The batch size of the reclaimer.
+
+		\brief Constructs a new record that is owned by the calling thread.
+		*/
+		explicit ThreadRecord(sizeType batchSize);
+
+		/**
+		\brief Reclaims all objects in \p m_retired, without checking if that is safe.
+		*/
+		void reclaimAll();
+
+		/**
+		\brief Releases the ownership of the record, the retired objects stay in the record.
+		*/
+		void release();
+	};
+
+	namespace
+	{
+		/**
+		\brief A record that is owned by a thread.
+		*/
+		struct OwnedRecord
+		{
+			/**
+			\brief The id of the reclaimer.
+			*/
+			uint64 m_domain;
+
+			/**
+			\brief The record.
+			*/
+			internal::ReclamationDomain::ThreadRecord *m_record;
+		};
+
+		/**
+		\brief The records of a single thread, they are released when the thread exits.
+		*/
+		struct ThreadRecords final
+		{
+			/**
+			\brief The records.
+			*/
+			NOU_DAT_ALG::Vector<OwnedRecord> m_records;
+
+			/**
+			\brief Releases the records of all reclaimers that still exist.
+			*/
+			~ThreadRecords();
+		};
+
+		/**
+		\brief The id of the next reclaimer.
+		*/
+		std::atomic<uint64> s_nextDomainId(1);
+
+		/**
+		\brief The id of the reclaimer that \p s_cachedRecord belongs to.
+		*/
+		thread_local uint64 s_cachedDomain = 0;
+
+		/**
+		\brief The record of the calling thread of the reclaimer that was used last.
+		*/
+		thread_local internal::ReclamationDomain::ThreadRecord *s_cachedRecord = nullptr;
+
+		/**
+		\brief The records of the calling thread.
+		*/
+		thread_local ThreadRecords s_threadRecords;
+
+		/**
+		\return The mutex that protects liveDomains().
+
+		\brief Returns the mutex that protects liveDomains(). It is never destroyed, threads may exit after the
+		       static objects were destroyed.
+		*/
+		NOU_THREAD::Mutex& domainMutex()
+		{
+			static NOU_THREAD::Mutex *mutex = new NOU_THREAD::Mutex();
+			return *mutex;
+		}
+
+		/**
+		\return The ids of all reclaimers that have not been destroyed yet.
+		*/
+		NOU_DAT_ALG::Vector<uint64>& liveDomains()
+		{
+			static NOU_DAT_ALG::Vector<uint64> *domains = new NOU_DAT_ALG::Vector<uint64>();
+			return *domains;
+		}
+
+		/**
+		\param domain The id of a reclaimer.
+
+		\return The index of the id in liveDomains(), or the size of liveDomains() if it does not exist.
+		*/
+		sizeType findDomain(uint64 domain)
+		{
+			NOU_DAT_ALG::Vector<uint64> &domains = liveDomains();
+
+			for (sizeType i = 0; i < domains.size(); i++)
+			{
+				if (domains[i] == domain)
+					return i;
+			}
+
+			return domains.size();
+		}
+
+		ThreadRecords::~ThreadRecords()
+		{
+			NOU_THREAD::Lock lock(domainMutex());
+
+			//the records of destroyed reclaimers have already been freed
+			for (sizeType i = 0; i < m_records.size(); i++)
+			{
+				if (findDomain(m_records[i].m_domain) != liveDomains().size())
+					m_records[i].m_record->release();
+			}
+		}
+
+		/**
+		\return A comparison of two pointers, for sorting.
+		*/
+		NOU_DAT_ALG::CompareResult comparePointers(void * const &a, void * const &b)
+		{
+			return a < b ? -1 : (a > b ? 1 : 0);
+		}
+
+		/**
+		\param pointers The sorted pointers.
+		\param pointer  The pointer to search.
+
+		\return True, if \p pointer is in \p pointers, false if not.
+		*/
+		boolean containsSorted(NOU_DAT_ALG::Vector<void*> &pointers, void *pointer)
+		{
+			sizeType begin = 0;
+			sizeType end = pointers.size();
+
+			while (begin < end)
+			{
+				sizeType middle = begin + (end - begin) / 2;
+
+				if (pointers[middle] < pointer)
+					begin = middle + 1;
+				else
+					end = middle;
+			}
+
+			return begin < pointers.size() && pointers[begin] == pointer;
+		}
+	}
+
+	void* RetiredObject::getObject() const
+	{
+		return m_object;
+	}
+
+	uint64 RetiredObject::getEpoch() const
+	{
+		return m_epoch;
+	}
+
+	void RetiredObject::setEpoch(uint64 epoch)
+	{
+		m_epoch = epoch;
+	}
+
+	void RetiredObject::reclaim()
+	{
+		m_reclaim(*this);
+	}
+
+	internal::ReclamationDomain::ThreadRecord::ThreadRecord(sizeType batchSize) :
+		m_state(0),
+		m_owned(true),
+		m_nesting(0),
+		m_usedHazards(0),
+		m_collecting(false),
+		m_nextCollect(batchSize),
+		m_retiredCount(0),
+		m_retired(batchSize),
+		m_next(nullptr)
+	{
+		for (sizeType i = 0; i < HAZARD_POINTER_COUNT; i++)
+			m_hazards[i].store(nullptr, std::memory_order_relaxed);
+	}
+
+	void internal::ReclamationDomain::ThreadRecord::reclaimAll()
+	{
+		//reclaiming an object may retire others, which are appended and reclaimed as well
+		for (sizeType i = 0; i < m_retired.size(); i++)
+			m_retired[i].reclaim();
+
+		m_retired.setSize(0);
+		m_retiredCount.store(0, std::memory_order_relaxed);
+	}
+
+	void internal::ReclamationDomain::ThreadRecord::release()
+	{
+		m_nesting = 0;
+		m_usedHazards = 0;
+
+		for (sizeType i = 0; i < HAZARD_POINTER_COUNT; i++)
+			m_hazards[i].store(nullptr, std::memory_order_release);
+
+		m_state.store(0, std::memory_order_release);
+		m_owned.store(false, std::memory_order_release);
+	}
+
+	internal::ReclamationDomain::ReclamationDomain(sizeType batchSize) :
+		m_id(s_nextDomainId.fetch_add(1, std::memory_order_relaxed)),
+		m_batchSize(NOU_CORE::max(batchSize, sizeType(1))),
+		m_records(nullptr)
+	{
+		NOU_THREAD::Lock lock(domainMutex());
+		liveDomains().pushBack(m_id);
+	}
+
+	internal::ReclamationDomain::~ReclamationDomain()
+	{
+		{
+			NOU_THREAD::Lock lock(domainMutex());
+
+			//from now on, exiting threads will not access the records anymore
+			NOU_DAT_ALG::Vector<uint64> &domains = liveDomains();
+			sizeType index = findDomain(m_id);
+
+			domains.swap(index, domains.size() - 1);
+			domains.pop();
+		}
+
+		ThreadRecord *record = m_records.load(std::memory_order_acquire);
+
+		while (record != nullptr)
+		{
+			ThreadRecord *next = record->m_next;
+
+			record->reclaimAll();
+			delete record;
+
+			record = next;
+		}
+	}
+
+	internal::ReclamationDomain::ThreadRecord& internal::ReclamationDomain::threadRecord()
+	{
+		if (s_cachedDomain == m_id)
+			return *s_cachedRecord;
+
+		ThreadRecords &owned = s_threadRecords;
+		ThreadRecord *record = nullptr;
+
+		//a thread that uses multiple reclaimers alternately already has a record
+		for (sizeType i = 0; i < owned.m_records.size() && record == nullptr; i++)
+		{
+			if (owned.m_records[i].m_domain == m_id)
+				record = owned.m_records[i].m_record;
+		}
+
+		if (record == nullptr)
+		{
+			//reuse the record of a thread that has exited
+			for (ThreadRecord *current = m_records.load(std::memory_order_acquire); current != nullptr;
+				current = current->m_next)
+			{
+				boolean expected = false;
+
+				if (!current->m_owned.load(std::memory_order_relaxed) &&
+					current->m_owned.compare_exchange_strong(expected, true, std::memory_order_acquire,
+						std::memory_order_relaxed))
+				{
+					record = current;
+					break;
+				}
+			}
+
+			if (record == nullptr)
+			{
+				record = new ThreadRecord(m_batchSize);
+				record->m_next = m_records.load(std::memory_order_relaxed);
+
+				while (!m_records.compare_exchange_weak(record->m_next, record, std::memory_order_release,
+					std::memory_order_relaxed));
+			}
+
+			owned.m_records.pushBack(OwnedRecord{ m_id, record });
+		}
+
+		s_cachedDomain = m_id;
+		s_cachedRecord = record;
+
+		return *record;
+	}
+
+	internal::ReclamationDomain::ThreadRecord& internal::ReclamationDomain::appendRetired(
+		const RetiredObject &retired)
+	{
+		ThreadRecord &record = threadRecord();
+
+		record.m_retired.pushBack(retired);
+		record.m_retiredCount.store(record.m_retired.size(), std::memory_order_relaxed);
+
+		return record;
+	}
+
+	sizeType internal::ReclamationDomain::retiredCount() const
+	{
+		sizeType ret = 0;
+
+		for (ThreadRecord *record = m_records.load(std::memory_order_acquire); record != nullptr;
+			record = record->m_next)
+		{
+			ret += record->m_retiredCount.load(std::memory_order_relaxed);
+		}
+
+		return ret;
+	}
+
+	EpochReclaimer::Guard::Guard(EpochReclaimer &reclaimer) :
+		m_reclaimer(reclaimer)
+	{
+		m_reclaimer.enter();
+	}
+
+	EpochReclaimer::Guard::~Guard()
+	{
+		m_reclaimer.leave();
+	}
+
+	EpochReclaimer::EpochReclaimer(sizeType batchSize) :
+		ReclamationDomain(batchSize),
+		m_epoch(0)
+	{}
+
+	void EpochReclaimer::enter()
+	{
+		ThreadRecord &record = threadRecord();
+
+		if (record.m_nesting++ == 0)
+		{
+			uint64 epoch = m_epoch.load(std::memory_order_seq_cst);
+
+			//the state must be visible before the thread reads any objects of the data structure
+			record.m_state.store((epoch << 1) | 1, std::memory_order_seq_cst);
+		}
+	}
+
+	void EpochReclaimer::leave()
+	{
+		ThreadRecord &record = threadRecord();
+
+		//all reads of the critical section must happen before an object is reclaimed
+		if (--record.m_nesting == 0)
+			record.m_state.store(0, std::memory_order_release);
+	}
+
+	void EpochReclaimer::retireObject(RetiredObject &retired)
+	{
+		//the object has been unlinked before, the epoch must not be older than that
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		retired.setEpoch(m_epoch.load(std::memory_order_seq_cst));
+
+		ThreadRecord &record = appendRetired(retired);
+
+		if (record.m_retired.size() >= record.m_nextCollect && !record.m_collecting)
+			collect(record);
+	}
+
+	void EpochReclaimer::collect(ThreadRecord &record)
+	{
+		record.m_collecting = true;
+
+		tryAdvance();
+
+		uint64 epoch = m_epoch.load(std::memory_order_acquire);
+		sizeType kept = 0;
+
+		//the objects of the last two epochs may still be read by other threads
+		for (sizeType i = 0; i < record.m_retired.size(); i++)
+		{
+			if (record.m_retired[i].getEpoch() + 2 <= epoch)
+				record.m_retired[i].reclaim();
+			else
+				record.m_retired[kept++] = record.m_retired[i];
+		}
+
+		record.m_retired.setSize(kept);
+		record.m_retiredCount.store(kept, std::memory_order_relaxed);
+
+		//if the epoch could not be advanced, do not try again for each retired object
+		record.m_nextCollect = kept + m_batchSize;
+		record.m_collecting = false;
+	}
+
+	boolean EpochReclaimer::tryAdvance()
+	{
+		uint64 epoch = m_epoch.load(std::memory_order_seq_cst);
+
+		for (ThreadRecord *record = m_records.load(std::memory_order_acquire); record != nullptr;
+			record = record->m_next)
+		{
+			uint64 state = record->m_state.load(std::memory_order_seq_cst);
+
+			if ((state & 1) != 0 && (state >> 1) != epoch)
+				return false;
+		}
+
+		return m_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+	}
+
+	void EpochReclaimer::collect()
+	{
+		ThreadRecord &record = threadRecord();
+
+		if (!record.m_collecting)
+			collect(record);
+	}
+
+	uint64 EpochReclaimer::getEpoch() const
+	{
+		return m_epoch.load(std::memory_order_relaxed);
+	}
+
+	EpochReclaimer& EpochReclaimer::getDefault()
+	{
+		//never destroyed, threads may retire objects during shutdown
+		static EpochReclaimer *reclaimer = new EpochReclaimer();
+		return *reclaimer;
+	}
+
+	HazardPointerDomain::HazardPointer::HazardPointer(HazardPointerDomain &domain) :
+		m_record(&domain.threadRecord()),
+		m_slot(nullptr)
+	{
+		for (sizeType i = 0; i < HAZARD_POINTER_COUNT; i++)
+		{
+			if ((m_record->m_usedHazards & (uint32(1) << i)) == 0)
+			{
+				m_record->m_usedHazards |= uint32(1) << i;
+				m_slot = &m_record->m_hazards[i];
+
+				return;
+			}
+		}
+
+		NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_STATE,
+			"All hazard pointers of the thread are in use.");
+	}
+
+	HazardPointerDomain::HazardPointer::~HazardPointer()
+	{
+		if (m_slot == nullptr)
+			return;
+
+		m_slot->store(nullptr, std::memory_order_release);
+		m_record->m_usedHazards &= ~(uint32(1) << (m_slot - m_record->m_hazards));
+	}
+
+	void HazardPointerDomain::HazardPointer::reset()
+	{
+		//all reads of the object must happen before it is reclaimed
+		if (m_slot != nullptr)
+			m_slot->store(nullptr, std::memory_order_release);
+	}
+
+	HazardPointerDomain::HazardPointerDomain(sizeType batchSize) :
+		ReclamationDomain(batchSize)
+	{}
+
+	void HazardPointerDomain::retireObject(RetiredObject &retired)
+	{
+		ThreadRecord &record = appendRetired(retired);
+
+		if (record.m_retired.size() >= record.m_nextCollect && !record.m_collecting)
+			collect(record);
+	}
+
+	void HazardPointerDomain::collect(ThreadRecord &record)
+	{
+		record.m_collecting = true;
+
+		//the objects have been unlinked before, a thread that protects one of them afterwards will fail to
+		//validate its pointer
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		NOU_DAT_ALG::Vector<void*> &hazards = record.m_scratch;
+		hazards.setSize(0);
+
+		sizeType recordCount = 0;
+
+		for (ThreadRecord *current = m_records.load(std::memory_order_acquire); current != nullptr;
+			current = current->m_next)
+		{
+			recordCount++;
+
+			for (sizeType i = 0; i < HAZARD_POINTER_COUNT; i++)
+			{
+				void *hazard = current->m_hazards[i].load(std::memory_order_acquire);
+
+				if (hazard != nullptr)
+					hazards.pushBack(hazard);
+			}
+		}
+
+		if (hazards.size() > 1)
+			hazards.sortComp(comparePointers);
+
+		sizeType kept = 0;
+		sizeType count = record.m_retired.size();
+
+		for (sizeType i = 0; i < count; i++)
+		{
+			if (containsSorted(hazards, record.m_retired[i].getObject()))
+				record.m_retired[kept++] = record.m_retired[i];
+			else
+				record.m_retired[i].reclaim();
+		}
+
+		//objects that were retired by the destructors of reclaimed objects were unlinked after the hazard
+		//pointers were read, they must be kept until the next attempt
+		for (sizeType i = count; i < record.m_retired.size(); i++)
+			record.m_retired[kept++] = record.m_retired[i];
+
+		record.m_retired.setSize(kept);
+		record.m_retiredCount.store(kept, std::memory_order_relaxed);
+
+		//at most one object per hazard pointer is kept, this bounds the amount of unreclaimed objects
+		record.m_nextCollect = NOU_CORE::max(kept + m_batchSize, 2 * recordCount * HAZARD_POINTER_COUNT);
+		record.m_collecting = false;
+	}
+
+	void HazardPointerDomain::collect()
+	{
+		ThreadRecord &record = threadRecord();
+
+		if (!record.m_collecting)
+			collect(record);
+	}
+
+	HazardPointerDomain& HazardPointerDomain::getDefault()
+	{
+		//never destroyed, threads may retire objects during shutdown
+		static HazardPointerDomain *domain = new HazardPointerDomain();
+		return *domain;
+	}
+}
@@ -0,0 +1,86 @@
+#include "nostrautils/thread/AdaptiveMutex.hpp"
+
+namespace NOU::NOU_THREAD
+{
+	constexpr uint32 AdaptiveMutex::SPIN_COUNT;
+	constexpr uint32 AdaptiveMutex::UNLOCKED;
+	constexpr uint32 AdaptiveMutex::LOCKED;
+	constexpr uint32 AdaptiveMutex::CONTENDED;
+
+	void AdaptiveMutex::lockSlow()
+	{
+		for (uint32 i = 0; i < SPIN_COUNT; i++)
+		{
+			uint32 state = m_state.load(std::memory_order_relaxed);
+
+			if (state == UNLOCKED && m_state.compare_exchange_weak(state, LOCKED, std::memory_order_acquire,
+				std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			//other threads are already sleeping, spinning will most likely not help
+			if (state == CONTENDED)
+				break;
+
+			cpuRelax();
+		}
+
+		//from now on, the state is CONTENDED, since this thread might go to sleep
+		while (m_state.exchange(CONTENDED, std::memory_order_acquire) != UNLOCKED)
+			futexWait(m_state, CONTENDED);
+	}
+
+	constexpr uint32 ByteMutex::SPIN_COUNT;
+	constexpr uint8 ByteMutex::LOCKED_BIT;
+	constexpr uint8 ByteMutex::PARKED_BIT;
+
+	void ByteMutex::lockSlow()
+	{
+		uint32 spinCount = 0;
+
+		while (true)
+		{
+			uint8 state = m_state.load(std::memory_order_relaxed);
+
+			if ((state & LOCKED_BIT) == 0)
+			{
+				if (m_state.compare_exchange_weak(state, state | LOCKED_BIT, std::memory_order_acquire,
+					std::memory_order_relaxed))
+				{
+					return;
+				}
+
+				continue;
+			}
+
+			//only spin if no thread is parked yet
+			if ((state & PARKED_BIT) == 0 && spinCount < SPIN_COUNT)
+			{
+				spinCount++;
+				cpuRelax();
+				continue;
+			}
+
+			if ((state & PARKED_BIT) == 0 && !m_state.compare_exchange_weak(state, state | PARKED_BIT,
+				std::memory_order_relaxed, std::memory_order_relaxed))
+			{
+				continue;
+			}
+
+			ParkingLot::park(&m_state, [this]()
+			{
+				return m_state.load(std::memory_order_relaxed) == (LOCKED_BIT | PARKED_BIT);
+			}, []() {});
+		}
+	}
+
+	void ByteMutex::unlockSlow()
+	{
+		//the state is updated while the bucket is locked, so no thread can park in between
+		ParkingLot::unparkOne(&m_state, [this](const UnparkResult &result)
+		{
+			m_state.store(result.m_mayHaveMoreThreads ? PARKED_BIT : 0, std::memory_order_release);
+		});
+	}
+}
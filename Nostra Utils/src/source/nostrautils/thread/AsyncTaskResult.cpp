@@ -3,17 +3,29 @@
 namespace NOU::NOU_THREAD
 {
 	constexpr int32 internal::AbstractAsyncTaskResult::DEFAULT_PRIORITY;
+	constexpr sizeType internal::AbstractAsyncTaskResult::INVALID_INDEX;
 
 	void internal::AbstractAsyncTaskResult::executeTask(AbstractTask *task, 
 		AbstractAsyncTaskResult *taskResult, Mutex *mutex)
 	{
-		Lock lock(*mutex);
+		{
+			Lock lock(*mutex);
+
+			//the task has already been executed synchronously by makeResult(), this happens if the task could 
+			//not be removed from the thread manager (e.g. b/c the thread manager does not support removing 
+			//tasks)
+			if (taskResult->getState() == State::NOT_STARTED)
+			{
+				taskResult->setState(State::EXECUTING_ASYNC);
 
-		taskResult->setState(State::EXECUTING_ASYNC);
+				task->execute();
 
-		task->execute();
+				taskResult->complete();
+			}
+		}
 
-		taskResult->setState(State::DONE);
+		//this must be the last access to the task result, it may be destroyed right after this
+		taskResult->m_released.store(true, std::memory_order_release);
 	}
 
 	void internal::AbstractAsyncTaskResult::setState(State state)
@@ -23,15 +35,154 @@ namespace NOU::NOU_THREAD
 		m_state = state;
 	}
 
+	void internal::AbstractAsyncTaskResult::complete()
+	{
+		NOU_DAT_ALG::Vector<AsyncTaskNotification> notifications;
+
+		{
+			Lock lock(m_stateMutex);
+
+			m_state = State::DONE;
+
+			//after the state is DONE, no more notifications will be added
+			notifications = NOU_CORE::move(m_notifications);
+		}
+
+		//this may push other tasks, so it is done without holding the lock
+		for (AsyncTaskNotification &notification : notifications)
+			notification.m_function(notification.m_context, notification.m_index);
+	}
+
+	boolean internal::AbstractAsyncTaskResult::addNotification(const AsyncTaskNotification &notification)
+	{
+		Lock lock(m_stateMutex);
+
+		if (m_state == State::DONE)
+			return false;
+
+		m_notifications.pushBack(notification);
+
+		return true;
+	}
+
+	boolean internal::AbstractAsyncTaskResult::removeNotification(const AsyncTaskNotification &notification)
+	{
+		Lock lock(m_stateMutex);
+
+		//the notifications have already been moved out by complete()
+		if (m_state == State::DONE)
+			return false;
+
+		for (sizeType i = 0; i < m_notifications.size(); i++)
+		{
+			const AsyncTaskNotification &current = m_notifications[i];
+
+			if (current.m_function == notification.m_function && current.m_context == notification.m_context
+				&& current.m_index == notification.m_index)
+			{
+				m_notifications.remove(i);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void internal::AbstractAsyncTaskResult::notifyDependent(void *dependent, sizeType index)
+	{
+		AbstractAsyncTaskResult *result = static_cast<AbstractAsyncTaskResult*>(dependent);
+
+		result->dependencyDone(index);
+
+		//this must be the last access to the dependent, it may be destroyed right after this
+		result->m_finishedNotifications.fetch_add(1, std::memory_order_release);
+	}
+
+	void internal::AbstractAsyncTaskResult::dependencyDone(sizeType index)
+	{
+		if (m_waitForAny)
+		{
+			sizeType expected = INVALID_INDEX;
+
+			//only the first dependency counts
+			if (!m_firstFinishedDependency.compare_exchange_strong(expected, index, 
+				std::memory_order_acq_rel))
+				return;
+		}
+		else
+		{
+			sizeType expected = INVALID_INDEX;
+			m_firstFinishedDependency.compare_exchange_strong(expected, index, std::memory_order_acq_rel);
+		}
+
+		if (m_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			push();
+	}
+
 	internal::AbstractAsyncTaskResult::AbstractAsyncTaskResult(AbstractTask *task) :
 		m_task(task),
 		m_state(State::NOT_STARTED),
-		m_executionTask(makeTask(&executeTask, m_task, this, &m_executionMutex))
+		m_executionTask(makeTask(&executeTask, m_task, this, &m_executionMutex)),
+		m_notifications(0),
+		m_dependencies(0),
+		m_pendingDependencies(0),
+		m_waitForAny(false),
+		m_firstFinishedDependency(INVALID_INDEX),
+		m_pushed(false),
+		m_released(true),
+		m_finishedNotifications(0)
 	{}
 
+	internal::AbstractAsyncTaskResult::AbstractAsyncTaskResult(AbstractTask *task, 
+		const AsyncTaskDependencies &dependencies) :
+		m_task(task),
+		m_state(State::NOT_STARTED),
+		m_executionTask(makeTask(&executeTask, m_task, this, &m_executionMutex)),
+		m_notifications(0),
+		m_dependencies(dependencies.m_count),
+		m_waitForAny(dependencies.m_any),
+		m_firstFinishedDependency(INVALID_INDEX),
+		m_pushed(false),
+		m_released(true),
+		m_finishedNotifications(0)
+	{
+		//one additional dependency that is released by pushAfterDependencies(), so the task can not be pushed
+		//before the inheriting class is fully constructed
+		if (m_waitForAny && dependencies.m_count > 0)
+			m_pendingDependencies = 2;
+		else if (m_waitForAny)
+			m_pendingDependencies = 1;
+		else
+			m_pendingDependencies = static_cast<int64>(dependencies.m_count) + 1;
+
+		for (sizeType i = 0; i < dependencies.m_count; i++)
+		{
+			m_dependencies.pushBack(dependencies.m_results[i]);
+
+			if (!dependencies.m_results[i]->addNotification(AsyncTaskNotification{ &notifyDependent, this, i }))
+			{
+				dependencyDone(i);
+				m_finishedNotifications.fetch_add(1, std::memory_order_release);
+			}
+		}
+	}
+
 	void internal::AbstractAsyncTaskResult::push()
 	{
-		getThreadManager().pushTask(&m_executionTask, 0);
+		//executeTask() can not start before this method has finished writing to the members
+		Lock lock(m_executionMutex);
+
+		m_released.store(false, std::memory_order_relaxed);
+
+		m_taskInformation = getThreadManager().pushTask(&m_executionTask, 0);
+
+		m_pushed.store(true, std::memory_order_release);
+	}
+
+	void internal::AbstractAsyncTaskResult::pushAfterDependencies()
+	{
+		if (m_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			push();
 	}
 
 	typename internal::AbstractAsyncTaskResult::State internal::AbstractAsyncTaskResult::getState() const
@@ -41,8 +192,28 @@ namespace NOU::NOU_THREAD
 
 	void internal::AbstractAsyncTaskResult::makeResult()
 	{
+		if (!m_pushed.load(std::memory_order_acquire))
+		{
+			//the task is still waiting for its dependencies, execute them in this thread
+			if (m_waitForAny)
+			{
+				if (m_firstFinishedDependency.load(std::memory_order_acquire) == INVALID_INDEX)
+					m_dependencies[0]->makeResult();
+			}
+			else
+			{
+				for (AbstractAsyncTaskResult *dependency : m_dependencies)
+					dependency->makeResult();
+			}
+
+			//the last dependency has finished, but the thread that finished it might still be pushing the task
+			while (!m_pushed.load(std::memory_order_acquire))
+				std::this_thread::yield();
+		}
+
 		//Remove task here to avoid race conditions (removeTask() will lock the task heap).
-		getThreadManager().removeTask(m_taskInformation);
+		if (getThreadManager().removeTask(m_taskInformation))
+			m_released.store(true, std::memory_order_release);
 		
 		/* 
 		 * Lock mutex to wait until the task has finished execution (since the task was already removed, it 
@@ -67,7 +238,60 @@ namespace NOU::NOU_THREAD
 
 			m_task->execute();
 
-			setState(State::DONE);
+			complete();
 		}
 	}
+
+	void internal::AbstractAsyncTaskResult::waitForRelease()
+	{
+		/*
+		 * If not all dependencies have notified this instance yet, none of them may have been destroyed (see
+		 * the documentation of then(), whenAll() and whenAny()). Deregister from the ones that have not 
+		 * finished yet, the others have either already notified this instance or are doing so right now.
+		 */
+		if (m_finishedNotifications.load(std::memory_order_acquire) < m_dependencies.size())
+		{
+			sizeType removed = 0;
+
+			for (sizeType i = 0; i < m_dependencies.size(); i++)
+			{
+				if (m_dependencies[i]->removeNotification(AsyncTaskNotification{ &notifyDependent, this, i }))
+					removed++;
+			}
+
+			//dependencyDone() may still be pushing the task
+			while (m_finishedNotifications.load(std::memory_order_acquire) + removed < m_dependencies.size())
+				std::this_thread::yield();
+		}
+
+		if (!m_released.load(std::memory_order_acquire) && m_pushed.load(std::memory_order_acquire))
+		{
+			if (getThreadManager().removeTask(m_taskInformation))
+				m_released.store(true, std::memory_order_release);
+		}
+
+		//the task is being executed by another thread
+		while (!m_released.load(std::memory_order_acquire))
+			std::this_thread::yield();
+	}
+
+	sizeType internal::AbstractAsyncTaskResult::getFirstFinishedDependency() const
+	{
+		return m_firstFinishedDependency.load(std::memory_order_acquire);
+	}
+
+	void internal::finishTaskGroup()
+	{}
+
+	AsyncTaskGroupResult whenAll(const NOU_DAT_ALG::Vector<internal::AbstractAsyncTaskResult*> &results)
+	{
+		return AsyncTaskGroupResult(makeTask(&internal::finishTaskGroup),
+			internal::AsyncTaskDependencies{ results.data(), results.size(), false });
+	}
+
+	AsyncTaskGroupResult whenAny(const NOU_DAT_ALG::Vector<internal::AbstractAsyncTaskResult*> &results)
+	{
+		return AsyncTaskGroupResult(makeTask(&internal::finishTaskGroup),
+			internal::AsyncTaskDependencies{ results.data(), results.size(), true });
+	}
 }
\ No newline at end of file
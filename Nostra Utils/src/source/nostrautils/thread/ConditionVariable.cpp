@@ -16,4 +16,10 @@ namespace NOU::NOU_THREAD
 	{
 		m_variable.wait(lock.getUnderlying());
 	}
+
+	boolean ConditionVariable::waitFor(UniqueLock &lock, uint64 nanoseconds)
+	{
+		return m_variable.wait_for(lock.getUnderlying(), std::chrono::nanoseconds(nanoseconds)) == 
+			std::cv_status::no_timeout;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,480 @@
+#include "nostrautils/thread/Coroutine.hpp"
+
+#ifdef NOU_EXISTS_FEATURE_COROUTINES
+
+#include "nostrautils/thread/ThreadManager.hpp"
+#include "nostrautils/thread/ThreadWrapper.hpp"
+#include "nostrautils/mem_mngt/ConcurrentPoolAllocator.hpp"
+#include "nostrautils/mem_mngt/Utils.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace NOU::NOU_THREAD
+{
+	namespace internal
+	{
+		/**
+		\brief The difference in size between two frame size classes.
+		*/
+		constexpr static sizeType FRAME_SIZE_STEP = 64;
+
+		/**
+		\brief The amount of frame size classes. Frames that are larger than the largest class are allocated
+		       using alignedAlloc().
+		*/
+		constexpr static sizeType FRAME_SIZE_CLASSES = 16;
+
+		/**
+		\brief The priority of the tasks that resume coroutines.
+		*/
+		constexpr static ThreadManager::Priority COROUTINE_PRIORITY = 0;
+
+		/**
+		\tparam N The index of the size class.
+
+		\brief A block of the frame pool of a single size class.
+		*/
+		template<sizeType N>
+		struct FrameBlock
+		{
+			alignas(std::max_align_t) byte m_data[(N + 1) * FRAME_SIZE_STEP];
+		};
+
+		/**
+		\tparam N The index of the size class.
+
+		\return The pool of the size class.
+
+		\brief Returns the pool of a size class. The pools are never destroyed, since detached coroutines may
+		       still finish while static objects are being destroyed.
+		*/
+		template<sizeType N>
+		static NOU_MEM_MNGT::ConcurrentPoolAllocator<FrameBlock<N>>& framePool()
+		{
+			static NOU_MEM_MNGT::ConcurrentPoolAllocator<FrameBlock<N>> *pool =
+				new NOU_MEM_MNGT::ConcurrentPoolAllocator<FrameBlock<N>>();
+
+			return *pool;
+		}
+
+		template<sizeType N>
+		static void* allocateFrameBlock()
+		{
+			return framePool<N>().allocate();
+		}
+
+		template<sizeType N>
+		static void deallocateFrameBlock(void *frame)
+		{
+			framePool<N>().deallocate(static_cast<FrameBlock<N>*>(frame));
+		}
+
+		/**
+		\brief The type of the functions that allocate a frame from the pool of a size class.
+		*/
+		using FrameAllocateFunction = void*(*)();
+
+		/**
+		\brief The type of the functions that return a frame to the pool of a size class.
+		*/
+		using FrameDeallocateFunction = void(*)(void*);
+
+		template<sizeType... N>
+		constexpr static FrameAllocateFunction s_frameAllocateFunctions[] = { &allocateFrameBlock<N>... };
+
+		template<sizeType... N>
+		constexpr static FrameDeallocateFunction s_frameDeallocateFunctions[] =
+			{ &deallocateFrameBlock<N>... };
+
+		template<sizeType... N>
+		constexpr static const FrameAllocateFunction* frameAllocateFunctions(std::index_sequence<N...>)
+		{
+			return s_frameAllocateFunctions<N...>;
+		}
+
+		template<sizeType... N>
+		constexpr static const FrameDeallocateFunction* frameDeallocateFunctions(std::index_sequence<N...>)
+		{
+			return s_frameDeallocateFunctions<N...>;
+		}
+
+		/**
+		\brief Pushes tasks that resume coroutines to the thread manager once their delay has passed.
+
+		\details
+		Pushes tasks that resume coroutines to the thread manager once their delay has passed. The pending
+		tasks are stored in a binary min-heap that is ordered by the point in time when the task is due.
+		*/
+		class CoroutineTimer final
+		{
+		private:
+			/**
+			\brief A pending task.
+			*/
+			struct Entry
+			{
+				/**
+				\brief The point in time (in nanoseconds, see now()) when the task will be pushed.
+				*/
+				uint64               m_deadline;
+
+				/**
+				\brief The task.
+				*/
+				CoroutineResumeTask *m_task;
+			};
+
+			/**
+			\brief The mutex that protects all other members.
+			*/
+			Mutex                      m_mutex;
+
+			/**
+			\brief The variable that the timer thread waits on.
+			*/
+			ConditionVariable          m_variable;
+
+			/**
+			\brief The pending tasks.
+			*/
+			NOU_DAT_ALG::Vector<Entry> m_entries;
+
+			/**
+			\brief True, if the timer thread should stop.
+			*/
+			boolean                    m_shouldShutdown;
+
+			/**
+			\brief The timer thread.
+			*/
+			ThreadWrapper              m_thread;
+
+			/**
+			\return The current point in time in nanoseconds.
+			*/
+			static uint64 now();
+
+			/**
+			\param index The index of the entry.
+
+			\brief Moves an entry up in the heap until the heap is valid again.
+			*/
+			void siftUp(sizeType index);
+
+			/**
+			\param index The index of the entry.
+
+			\brief Moves an entry down in the heap until the heap is valid again.
+			*/
+			void siftDown(sizeType index);
+
+			/**
+			\brief The function that is executed by the timer thread.
+			*/
+			void run();
+
+		public:
+			/**
+			\brief Starts the timer thread.
+			*/
+			CoroutineTimer();
+
+			/**
+			\brief Stops the timer thread. Tasks that are still pending will not be pushed anymore.
+			*/
+			~CoroutineTimer();
+
+			/**
+			\param task         The task.
+			\param milliseconds The delay.
+
+			\brief Pushes \p task to the thread manager after \p milliseconds have passed.
+			*/
+			void push(CoroutineResumeTask *task, uint64 milliseconds);
+
+			/**
+			\return The timer.
+
+			\brief Returns the timer, it is constructed by the first call to this function.
+			*/
+			static CoroutineTimer& get();
+		};
+
+		uint64 CoroutineTimer::now()
+		{
+			return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		void CoroutineTimer::siftUp(sizeType index)
+		{
+			while (index > 0)
+			{
+				sizeType parent = (index - 1) / 2;
+
+				if (m_entries[parent].m_deadline <= m_entries[index].m_deadline)
+					break;
+
+				m_entries.swap(parent, index);
+				index = parent;
+			}
+		}
+
+		void CoroutineTimer::siftDown(sizeType index)
+		{
+			while (true)
+			{
+				sizeType smallest = index;
+				sizeType left = index * 2 + 1;
+				sizeType right = left + 1;
+
+				if (left < m_entries.size() && m_entries[left].m_deadline < m_entries[smallest].m_deadline)
+					smallest = left;
+
+				if (right < m_entries.size() && m_entries[right].m_deadline < m_entries[smallest].m_deadline)
+					smallest = right;
+
+				if (smallest == index)
+					break;
+
+				m_entries.swap(smallest, index);
+				index = smallest;
+			}
+		}
+
+		void CoroutineTimer::run()
+		{
+			UniqueLock lock(m_mutex);
+
+			while (!m_shouldShutdown)
+			{
+				if (m_entries.size() == 0)
+				{
+					m_variable.wait(lock);
+					continue;
+				}
+
+				uint64 time = now();
+				uint64 deadline = m_entries[0].m_deadline;
+
+				if (deadline > time)
+				{
+					m_variable.waitFor(lock, deadline - time);
+					continue;
+				}
+
+				CoroutineResumeTask *task = m_entries[0].m_task;
+
+				m_entries.swap(0, m_entries.size() - 1);
+				m_entries.remove(m_entries.size() - 1);
+				siftDown(0);
+
+				pushCoroutine(task);
+			}
+		}
+
+		CoroutineTimer::CoroutineTimer() :
+			m_entries(0),
+			m_shouldShutdown(false),
+			m_thread([this]() { run(); })
+		{}
+
+		CoroutineTimer::~CoroutineTimer()
+		{
+			{
+				Lock lock(m_mutex);
+
+				m_shouldShutdown = true;
+			}
+
+			m_variable.notifyAll();
+			m_thread.join();
+		}
+
+		void CoroutineTimer::push(CoroutineResumeTask *task, uint64 milliseconds)
+		{
+			{
+				Lock lock(m_mutex);
+
+				m_entries.pushBack(Entry{ now() + milliseconds * 1000000, task });
+				siftUp(m_entries.size() - 1);
+			}
+
+			m_variable.notifyAll();
+		}
+
+		CoroutineTimer& CoroutineTimer::get()
+		{
+			//the thread manager needs to outlive the timer, since the timer pushes tasks to it
+			getThreadManager();
+
+			static CoroutineTimer timer;
+
+			return timer;
+		}
+
+		void* allocateCoroutineFrame(sizeType size)
+		{
+			static const FrameAllocateFunction *functions =
+				frameAllocateFunctions(std::make_index_sequence<FRAME_SIZE_CLASSES>());
+
+			if (size > FRAME_SIZE_CLASSES * FRAME_SIZE_STEP)
+				return NOU_MEM_MNGT::alignedAlloc(size, alignof(std::max_align_t));
+
+			return functions[(size + FRAME_SIZE_STEP - 1) / FRAME_SIZE_STEP - 1]();
+		}
+
+		void deallocateCoroutineFrame(void *frame, sizeType size)
+		{
+			static const FrameDeallocateFunction *functions =
+				frameDeallocateFunctions(std::make_index_sequence<FRAME_SIZE_CLASSES>());
+
+			if (size > FRAME_SIZE_CLASSES * FRAME_SIZE_STEP)
+				NOU_MEM_MNGT::alignedFree(frame);
+			else
+				functions[(size + FRAME_SIZE_STEP - 1) / FRAME_SIZE_STEP - 1](frame);
+		}
+
+		void CoroutineResumeTask::setHandle(std::coroutine_handle<> handle)
+		{
+			m_handle = handle;
+		}
+
+		void CoroutineResumeTask::execute()
+		{
+			//copy the handle, the coroutine may destroy this task
+			std::coroutine_handle<> handle = m_handle;
+
+			handle.resume();
+		}
+
+		void pushCoroutine(CoroutineResumeTask *task)
+		{
+			getThreadManager().pushTask(task, COROUTINE_PRIORITY);
+		}
+
+		void pushCoroutineDelayed(CoroutineResumeTask *task, uint64 milliseconds)
+		{
+			CoroutineTimer::get().push(task, milliseconds);
+		}
+
+		void pushCoroutineNotification(void *task, sizeType)
+		{
+			pushCoroutine(static_cast<CoroutineResumeTask*>(task));
+		}
+
+		CoroutineWaiter::CoroutineWaiter() :
+			m_done(false)
+		{}
+
+		void CoroutineWaiter::notify()
+		{
+			//notify while the mutex is locked, the waiter may be destroyed as soon as the mutex is unlocked
+			Lock lock(m_mutex);
+
+			m_done = true;
+			m_variable.notifyAll();
+		}
+
+		void CoroutineWaiter::wait()
+		{
+			UniqueLock lock(m_mutex);
+
+			m_variable.wait(lock, [this]() { return m_done; });
+		}
+
+		CoroutinePromiseBase::CoroutinePromiseBase() :
+			m_continuation(nullptr),
+			m_waiter(nullptr),
+			m_detached(false)
+		{}
+
+		void* CoroutinePromiseBase::operator new (std::size_t size) noexcept
+		{
+			return allocateCoroutineFrame(size);
+		}
+
+		void CoroutinePromiseBase::operator delete (void *frame, std::size_t size)
+		{
+			deallocateCoroutineFrame(frame, size);
+		}
+
+		void CoroutinePromiseBase::unhandled_exception()
+		{
+			std::terminate();
+		}
+
+		std::coroutine_handle<> CoroutinePromiseBase::finish(std::coroutine_handle<> handle) noexcept
+		{
+			//after the waiter has been notified, the frame may be destroyed at any time
+			std::coroutine_handle<> continuation = m_continuation;
+			CoroutineWaiter *waiter = m_waiter;
+			boolean detached = m_detached;
+
+			if (continuation)
+				return continuation;
+
+			if (waiter != nullptr)
+				waiter->notify();
+			else if (detached)
+				handle.destroy();
+
+			return std::noop_coroutine();
+		}
+
+		void CoroutinePromiseBase::setContinuation(std::coroutine_handle<> continuation)
+		{
+			m_continuation = continuation;
+		}
+
+		void CoroutinePromiseBase::setWaiter(CoroutineWaiter *waiter)
+		{
+			m_waiter = waiter;
+		}
+
+		void CoroutinePromiseBase::detach(std::coroutine_handle<> handle)
+		{
+			m_detached = true;
+
+			m_resumeTask.setHandle(handle);
+			pushCoroutine(&m_resumeTask);
+		}
+
+		ScheduleAwaiter::ScheduleAwaiter(uint64 milliseconds) :
+			m_milliseconds(milliseconds)
+		{}
+
+		boolean ScheduleAwaiter::await_ready() const noexcept
+		{
+			return false;
+		}
+
+		void ScheduleAwaiter::await_suspend(std::coroutine_handle<> handle)
+		{
+			m_task.setHandle(handle);
+
+			if (m_milliseconds == 0)
+				pushCoroutine(&m_task);
+			else
+				pushCoroutineDelayed(&m_task, m_milliseconds);
+		}
+
+		void ScheduleAwaiter::await_resume() const noexcept
+		{}
+	}
+
+	internal::ScheduleAwaiter schedule()
+	{
+		return internal::ScheduleAwaiter(0);
+	}
+
+	internal::ScheduleAwaiter sleepFor(uint64 milliseconds)
+	{
+		return internal::ScheduleAwaiter(milliseconds);
+	}
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "nostrautils/thread/InlineTask.hpp"
+
+namespace NOU::NOU_THREAD
+{
+	constexpr sizeType InlineTask::INLINE_CAPACITY;
+
+	InlineTask::InlineTask() :
+		m_operations(nullptr),
+		m_isInline(false)
+	{}
+
+	InlineTask::InlineTask(InlineTask &&other) :
+		m_operations(other.m_operations),
+		m_isInline(other.m_isInline)
+	{
+		if (m_operations != nullptr)
+			m_operations->m_move(other.m_buffer, m_buffer);
+
+		other.m_operations = nullptr;
+		other.m_isInline = false;
+	}
+
+	InlineTask::~InlineTask()
+	{
+		if (m_operations != nullptr)
+			m_operations->m_destroy(m_buffer);
+	}
+
+	InlineTask& InlineTask::operator = (InlineTask &&other)
+	{
+		if (this != &other)
+		{
+			if (m_operations != nullptr)
+				m_operations->m_destroy(m_buffer);
+
+			m_operations = other.m_operations;
+			m_isInline = other.m_isInline;
+
+			if (m_operations != nullptr)
+				m_operations->m_move(other.m_buffer, m_buffer);
+
+			other.m_operations = nullptr;
+			other.m_isInline = false;
+		}
+
+		return *this;
+	}
+
+	void InlineTask::execute()
+	{
+		m_operations->m_execute(m_buffer);
+	}
+
+	boolean InlineTask::isValid() const
+	{
+		return m_operations != nullptr;
+	}
+
+	boolean InlineTask::isInline() const
+	{
+		return m_isInline;
+	}
+}
@@ -28,4 +28,16 @@ namespace NOU::NOU_THREAD
 	{
 		return m_lock;
 	}
+
+	SharedLock::SharedLock(SharedMutex &mutex, boolean lock) :
+		m_mutex(&mutex)
+	{
+		if (lock)
+			m_mutex->lockShared();
+	}
+
+	SharedLock::~SharedLock()
+	{
+		m_mutex->unlockShared();
+	}
 }
\ No newline at end of file
@@ -0,0 +1,228 @@
+#include "nostrautils/thread/Parallel.hpp"
+#include "nostrautils/thread/ThreadManager.hpp"
+#include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/thread/Lock.hpp"
+#include "nostrautils/thread/ConditionVariable.hpp"
+
+#include <atomic>
+
+namespace NOU::NOU_THREAD
+{
+	namespace
+	{
+		/**
+		\brief The amount of chunks that each thread should process if the grain is chosen automatically.
+		*/
+		constexpr sizeType CHUNKS_PER_THREAD = 8;
+
+		/**
+		\brief The priority that the helper tasks are pushed with.
+		*/
+		constexpr ThreadManager::Priority HELPER_PRIORITY = 0;
+
+		class ParallelJob;
+
+		/**
+		\brief A task that executes chunks of a ParallelJob until there are none left.
+		*/
+		class ParallelHelper final : public internal::AbstractTask
+		{
+		public:
+			/**
+			\brief The job that this helper belongs to.
+			*/
+			ParallelJob *m_job = nullptr;
+
+			virtual void execute() override;
+		};
+
+		/**
+		\brief The shared state of a single call to runParallel().
+
+		\details
+		The shared state of a single call to runParallel(). The job is reference counted, the calling thread
+		and each helper task hold one reference. The last one to release its reference deletes the job. This
+		is required, since helper tasks may still be queued in the thread manager after the calling thread has
+		returned.
+		*/
+		class ParallelJob final
+		{
+		private:
+			internal::ChunkFunction m_function;
+			void                   *m_context;
+			sizeType                m_begin;
+			sizeType                m_end;
+			sizeType                m_grain;
+			sizeType                m_chunkCount;
+
+			/**
+			\brief The index of the next chunk that has not been claimed yet.
+			*/
+			std::atomic<sizeType>   m_nextChunk;
+
+			/**
+			\brief The amount of chunks that have been executed.
+			*/
+			std::atomic<sizeType>   m_completedChunks;
+
+			/**
+			\brief The amount of references to this job.
+			*/
+			std::atomic<sizeType>   m_references;
+
+			Mutex                   m_mutex;
+			ConditionVariable       m_variable;
+
+		public:
+			/**
+			\brief The helper tasks. This is an array of <tt>m_references - 1</tt> elements.
+			*/
+			ParallelHelper         *m_helpers;
+
+			ParallelJob(internal::ChunkFunction function, void *context, sizeType begin, sizeType end,
+				sizeType grain, sizeType chunkCount, sizeType helperCount);
+
+			~ParallelJob();
+
+			/**
+			\brief Claims and executes chunks until all chunks have been claimed.
+			*/
+			void work();
+
+			/**
+			\brief Blocks until all chunks have been executed.
+			*/
+			void wait();
+
+			/**
+			\brief Releases a reference and deletes the job if it was the last one.
+			*/
+			void release();
+		};
+
+		ParallelJob::ParallelJob(internal::ChunkFunction function, void *context, sizeType begin, sizeType end,
+			sizeType grain, sizeType chunkCount, sizeType helperCount) :
+			m_function(function),
+			m_context(context),
+			m_begin(begin),
+			m_end(end),
+			m_grain(grain),
+			m_chunkCount(chunkCount),
+			m_nextChunk(0),
+			m_completedChunks(0),
+			m_references(helperCount + 1),
+			m_helpers(new ParallelHelper[helperCount])
+		{
+			for (sizeType i = 0; i < helperCount; i++)
+				m_helpers[i].m_job = this;
+		}
+
+		ParallelJob::~ParallelJob()
+		{
+			delete[] m_helpers;
+		}
+
+		void ParallelJob::work()
+		{
+			sizeType executed = 0;
+
+			for (sizeType chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < m_chunkCount;
+				chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed))
+			{
+				sizeType chunkBegin = m_begin + chunk * m_grain;
+				sizeType chunkEnd = m_end - chunkBegin > m_grain ? chunkBegin + m_grain : m_end;
+
+				m_function(m_context, chunkBegin, chunkEnd, chunk);
+
+				executed++;
+			}
+
+			if (executed > 0 &&
+				m_completedChunks.fetch_add(executed, std::memory_order_acq_rel) + executed == m_chunkCount)
+			{
+				Lock lock(m_mutex);
+				m_variable.notifyAll();
+			}
+		}
+
+		void ParallelJob::wait()
+		{
+			UniqueLock lock(m_mutex);
+
+			m_variable.wait(lock, [this]()
+			{
+				return m_completedChunks.load(std::memory_order_acquire) == m_chunkCount;
+			});
+		}
+
+		void ParallelJob::release()
+		{
+			if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				delete this;
+		}
+
+		void ParallelHelper::execute()
+		{
+			//the job (and therefore this helper) may be deleted by release()
+			ParallelJob *job = m_job;
+
+			job->work();
+			job->release();
+		}
+	}
+
+	sizeType internal::automaticGrain(sizeType count)
+	{
+		sizeType grain = count / ((getThreadManager().maximumAvailableThreads() + 1) * CHUNKS_PER_THREAD);
+
+		return grain > 0 ? grain : 1;
+	}
+
+	sizeType internal::chunkCount(sizeType count, sizeType grain)
+	{
+		if (grain == 0)
+			grain = automaticGrain(count);
+
+		return (count + grain - 1) / grain;
+	}
+
+	sizeType internal::runParallel(sizeType begin, sizeType end, sizeType grain, ChunkFunction function,
+		void *context)
+	{
+		if (begin >= end)
+			return 0;
+
+		sizeType count = end - begin;
+
+		if (grain == 0)
+			grain = automaticGrain(count);
+
+		sizeType chunks = chunkCount(count, grain);
+
+		//no need to involve the thread manager for a single chunk
+		if (chunks == 1)
+		{
+			function(context, begin, end, 0);
+			return 1;
+		}
+
+		ThreadManager &manager = getThreadManager();
+
+		sizeType helperCount = chunks - 1;
+
+		if (helperCount > manager.maximumAvailableThreads())
+			helperCount = manager.maximumAvailableThreads();
+
+		ParallelJob *job = new ParallelJob(function, context, begin, end, grain, chunks, helperCount);
+
+		for (sizeType i = 0; i < helperCount; i++)
+			manager.pushTask(job->m_helpers + i, HELPER_PRIORITY);
+
+		//the calling thread takes part as well; this also guarantees progress if all threads are busy
+		job->work();
+		job->wait();
+		job->release();
+
+		return chunks;
+	}
+}
@@ -0,0 +1,26 @@
+#include "nostrautils/thread/ParkingConditionVariable.hpp"
+
+namespace NOU::NOU_THREAD
+{
+	void ParkingConditionVariable::notifyOne()
+	{
+		if (!m_hasWaiters.load(std::memory_order_relaxed))
+			return;
+
+		ParkingLot::unparkOne(this, [this](const UnparkResult &result)
+		{
+			if (!result.m_mayHaveMoreThreads)
+				m_hasWaiters.store(false, std::memory_order_relaxed);
+		});
+	}
+
+	void ParkingConditionVariable::notifyAll()
+	{
+		if (!m_hasWaiters.load(std::memory_order_relaxed))
+			return;
+
+		m_hasWaiters.store(false, std::memory_order_relaxed);
+
+		ParkingLot::unparkAll(this);
+	}
+}
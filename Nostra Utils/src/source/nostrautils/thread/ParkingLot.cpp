@@ -0,0 +1,330 @@
+#include "nostrautils/thread/ParkingLot.hpp"
+#include "nostrautils/thread/Mutex.hpp"
+#include "nostrautils/thread/Lock.hpp"
+#include "nostrautils/thread/ConditionVariable.hpp"
+
+#if NOU_OS == NOU_OS_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
+namespace NOU::NOU_THREAD
+{
+	namespace
+	{
+		/**
+		\brief The state of a thread that can be parked. Each thread has its own instance.
+		*/
+		struct ParkedThread
+		{
+			/**
+			\brief The next thread in the queue of the bucket.
+			*/
+			ParkedThread *m_next = nullptr;
+
+			/**
+			\brief The address that the thread is parked on.
+			*/
+			const void *m_address = nullptr;
+
+#if NOU_OS == NOU_OS_LINUX
+			/**
+			\brief 1, if the thread is parked, 0 if not. This is the futex word that the thread sleeps on.
+			*/
+			std::atomic<uint32> m_parked{ 0 };
+#else
+			/**
+			\brief The mutex that protects \p m_parked.
+			*/
+			Mutex m_mutex;
+
+			/**
+			\brief The variable that the thread sleeps on.
+			*/
+			ConditionVariable m_variable;
+
+			/**
+			\brief True, if the thread is parked.
+			*/
+			boolean m_parked = false;
+#endif
+
+			/**
+			\brief Marks the thread as parked. Called while the bucket is locked.
+			*/
+			void prepare();
+
+			/**
+			\brief Puts the thread to sleep until wake() has been called.
+			*/
+			void sleep();
+
+			/**
+			\brief Wakes up the thread. After this call, the thread may continue at any time and this instance
+			       must not be accessed anymore.
+			*/
+			void wake();
+		};
+
+		/**
+		\brief A bucket of the parking lot.
+		*/
+		struct alignas(64) Bucket
+		{
+			/**
+			\brief The mutex that protects the queue.
+			*/
+			Mutex m_mutex;
+
+			/**
+			\brief The first thread in the queue.
+			*/
+			ParkedThread *m_head = nullptr;
+
+			/**
+			\brief The last thread in the queue.
+			*/
+			ParkedThread *m_tail = nullptr;
+		};
+
+		static_assert(ParkingLot::BUCKET_COUNT == 256, "bucketFor() uses the upper 8 bits of the hash.");
+
+		/**
+		\param address The address.
+
+		\return The bucket of the address.
+		*/
+		Bucket& bucketFor(const void *address)
+		{
+			static Bucket buckets[ParkingLot::BUCKET_COUNT];
+
+			uint64 hash = static_cast<uint64>(reinterpret_cast<sizeType>(address)) * 0x9E3779B97F4A7C15ull;
+
+			return buckets[hash >> 56];
+		}
+
+		/**
+		\return The state of the calling thread.
+		*/
+		ParkedThread& currentThread()
+		{
+			static thread_local ParkedThread thread;
+
+			return thread;
+		}
+
+#if NOU_OS == NOU_OS_LINUX
+		void ParkedThread::prepare()
+		{
+			m_parked.store(1, std::memory_order_relaxed);
+		}
+
+		void ParkedThread::sleep()
+		{
+			while (m_parked.load(std::memory_order_acquire) == 1)
+				futexWait(m_parked, 1);
+		}
+
+		void ParkedThread::wake()
+		{
+			m_parked.store(0, std::memory_order_release);
+
+			//if the thread has already observed the store and exited, this is a spurious wake up at most
+			futexWake(m_parked);
+		}
+#else
+		void ParkedThread::prepare()
+		{
+			Lock lock(m_mutex);
+
+			m_parked = true;
+		}
+
+		void ParkedThread::sleep()
+		{
+			UniqueLock lock(m_mutex);
+
+			m_variable.wait(lock, [this]() { return !m_parked; });
+		}
+
+		void ParkedThread::wake()
+		{
+			//notify while the mutex is locked, the thread can not continue before it is unlocked
+			Lock lock(m_mutex);
+
+			m_parked = false;
+			m_variable.notifyOne();
+		}
+#endif
+	}
+
+	constexpr sizeType ParkingLot::BUCKET_COUNT;
+
+	boolean ParkingLot::parkImpl(const void *address, boolean(*validate)(void*), void(*beforeSleep)(void*),
+		void *context)
+	{
+		ParkedThread &self = currentThread();
+		Bucket &bucket = bucketFor(address);
+
+		{
+			Lock lock(bucket.m_mutex);
+
+			if (!validate(context))
+				return false;
+
+			self.m_address = address;
+			self.m_next = nullptr;
+			self.prepare();
+
+			if (bucket.m_tail == nullptr)
+				bucket.m_head = &self;
+			else
+				bucket.m_tail->m_next = &self;
+
+			bucket.m_tail = &self;
+		}
+
+		beforeSleep(context);
+
+		self.sleep();
+
+		return true;
+	}
+
+	UnparkResult ParkingLot::unparkOneImpl(const void *address, void(*callback)(void*, const UnparkResult&),
+		void *context)
+	{
+		Bucket &bucket = bucketFor(address);
+		ParkedThread *unparked = nullptr;
+		UnparkResult result{ false, false };
+
+		{
+			Lock lock(bucket.m_mutex);
+
+			ParkedThread **link = &bucket.m_head;
+			ParkedThread *previous = nullptr;
+
+			while (*link != nullptr)
+			{
+				ParkedThread *current = *link;
+
+				if (current->m_address == address)
+				{
+					if (unparked != nullptr)
+					{
+						result.m_mayHaveMoreThreads = true;
+						break;
+					}
+
+					//unlink, link now points to the next thread
+					*link = current->m_next;
+
+					if (bucket.m_tail == current)
+						bucket.m_tail = previous;
+
+					unparked = current;
+					continue;
+				}
+
+				previous = current;
+				link = &current->m_next;
+			}
+
+			result.m_unparked = unparked != nullptr;
+
+			if (callback != nullptr)
+				callback(context, result);
+		}
+
+		if (unparked != nullptr)
+			unparked->wake();
+
+		return result;
+	}
+
+	UnparkResult ParkingLot::unparkOne(const void *address)
+	{
+		return unparkOneImpl(address, nullptr, nullptr);
+	}
+
+	sizeType ParkingLot::unparkAll(const void *address)
+	{
+		Bucket &bucket = bucketFor(address);
+		ParkedThread *unparked = nullptr;
+		sizeType count = 0;
+
+		{
+			Lock lock(bucket.m_mutex);
+
+			ParkedThread **link = &bucket.m_head;
+			ParkedThread *previous = nullptr;
+
+			while (*link != nullptr)
+			{
+				ParkedThread *current = *link;
+
+				if (current->m_address == address)
+				{
+					*link = current->m_next;
+
+					if (bucket.m_tail == current)
+						bucket.m_tail = previous;
+
+					//build a separate list of the unparked threads
+					current->m_next = unparked;
+					unparked = current;
+					count++;
+
+					continue;
+				}
+
+				previous = current;
+				link = &current->m_next;
+			}
+		}
+
+		while (unparked != nullptr)
+		{
+			//read the next thread first, the thread may continue as soon as it is woken up
+			ParkedThread *next = unparked->m_next;
+
+			unparked->wake();
+			unparked = next;
+		}
+
+		return count;
+	}
+
+#if NOU_OS == NOU_OS_LINUX
+	static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32));
+
+	void futexWait(std::atomic<uint32> &word, uint32 expected)
+	{
+		syscall(SYS_futex, reinterpret_cast<uint32*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+	}
+
+	void futexWake(std::atomic<uint32> &word, boolean all)
+	{
+		syscall(SYS_futex, reinterpret_cast<uint32*>(&word), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, nullptr,
+			nullptr, 0);
+	}
+#else
+	void futexWait(std::atomic<uint32> &word, uint32 expected)
+	{
+		ParkingLot::park(&word, [&word, expected]()
+		{
+			return word.load(std::memory_order_relaxed) == expected;
+		}, []() {});
+	}
+
+	void futexWake(std::atomic<uint32> &word, boolean all)
+	{
+		if (all)
+			ParkingLot::unparkAll(&word);
+		else
+			ParkingLot::unparkOne(&word);
+	}
+#endif
+}
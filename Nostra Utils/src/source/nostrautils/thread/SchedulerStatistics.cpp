@@ -0,0 +1,138 @@
+#include "nostrautils/thread/SchedulerStatistics.hpp"
+#include "nostrautils/core/Utils.hpp"
+
+namespace NOU::NOU_THREAD
+{
+	constexpr sizeType LatencyHistogram::SUB_BUCKET_BITS;
+	constexpr sizeType LatencyHistogram::SUB_BUCKET_COUNT;
+	constexpr sizeType LatencyHistogram::BUCKET_COUNT;
+
+	sizeType LatencyHistogram::bucketOf(uint64 value)
+	{
+		//small values are stored linearly
+		if (value < SUB_BUCKET_COUNT)
+			return static_cast<sizeType>(value);
+
+		sizeType magnitude = 63;
+
+		while ((value & (uint64(1) << magnitude)) == 0)
+			magnitude--;
+
+		sizeType subBucket = static_cast<sizeType>(value >> (magnitude - SUB_BUCKET_BITS)) &
+			(SUB_BUCKET_COUNT - 1);
+
+		return (magnitude - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket;
+	}
+
+	uint64 LatencyHistogram::bucketLowerBound(sizeType bucket)
+	{
+		if (bucket < SUB_BUCKET_COUNT)
+			return bucket;
+
+		sizeType magnitude = bucket / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+		sizeType subBucket = bucket % SUB_BUCKET_COUNT;
+
+		return uint64(SUB_BUCKET_COUNT + subBucket) << (magnitude - SUB_BUCKET_BITS);
+	}
+
+	LatencyHistogram::LatencyHistogram() :
+		m_counts{}
+	{}
+
+	void LatencyHistogram::record(uint64 value)
+	{
+		m_counts[bucketOf(value)]++;
+	}
+
+	void LatencyHistogram::recordBucket(sizeType bucket, uint64 count)
+	{
+		m_counts[bucket] += count;
+	}
+
+	void LatencyHistogram::merge(const LatencyHistogram &other)
+	{
+		for (sizeType i = 0; i < BUCKET_COUNT; i++)
+			m_counts[i] += other.m_counts[i];
+	}
+
+	uint64 LatencyHistogram::countAt(sizeType bucket) const
+	{
+		return m_counts[bucket];
+	}
+
+	uint64 LatencyHistogram::totalCount() const
+	{
+		uint64 ret = 0;
+
+		for (sizeType i = 0; i < BUCKET_COUNT; i++)
+			ret += m_counts[i];
+
+		return ret;
+	}
+
+	uint64 LatencyHistogram::percentile(float64 percentile) const
+	{
+		uint64 total = totalCount();
+
+		if (total == 0)
+			return 0;
+
+		//the rank of the value, rounded up, so that the 100th percentile is the largest value
+		uint64 rank = static_cast<uint64>(percentile / 100.0 * static_cast<float64>(total) + 0.999999);
+		rank = NOU_CORE::clamp<uint64>(rank, 1, total);
+
+		uint64 seen = 0;
+
+		for (sizeType i = 0; i < BUCKET_COUNT; i++)
+		{
+			seen += m_counts[i];
+
+			if (seen >= rank)
+				return bucketLowerBound(i);
+		}
+
+		return bucketLowerBound(BUCKET_COUNT - 1);
+	}
+
+	WorkerStatistics::WorkerStatistics() :
+		tasksExecuted(0),
+		busyNanos(0),
+		idleNanos(0),
+		steals(0)
+	{}
+
+	SchedulerStatistics::SchedulerStatistics() :
+		enabled(false),
+		heapHighWaterMark(0)
+	{}
+
+	uint64 SchedulerStatistics::totalTasksExecuted() const
+	{
+		uint64 ret = 0;
+
+		for (sizeType i = 0; i < workers.size(); i++)
+			ret += workers[i].tasksExecuted;
+
+		return ret;
+	}
+
+	LatencyHistogram SchedulerStatistics::totalQueueLatency() const
+	{
+		LatencyHistogram ret;
+
+		for (sizeType i = 0; i < workers.size(); i++)
+			ret.merge(workers[i].queueLatency);
+
+		return ret;
+	}
+
+	LatencyHistogram SchedulerStatistics::totalExecutionLatency() const
+	{
+		LatencyHistogram ret;
+
+		for (sizeType i = 0; i < workers.size(); i++)
+			ret.merge(workers[i].executionLatency);
+
+		return ret;
+	}
+}
@@ -0,0 +1,75 @@
+#include "nostrautils/thread/SharedMutex.hpp"
+
+namespace NOU::NOU_THREAD
+{
+	constexpr uint32 SharedMutex::SPIN_COUNT;
+	constexpr uint32 SharedMutex::WRITER_BIT;
+
+	void SharedMutex::lockSlow()
+	{
+		m_waitingWriters.fetch_add(1);
+
+		while (true)
+		{
+			for (uint32 i = 0; i < SPIN_COUNT; i++)
+			{
+				if (m_state.load(std::memory_order_relaxed) == 0 && tryLock())
+				{
+					m_waitingWriters.fetch_sub(1);
+					return;
+				}
+
+				cpuRelax();
+			}
+
+			//the epoch is read before the state is checked, so no wake up can get lost in between
+			m_sleepers.fetch_add(1);
+			uint32 epoch = m_epoch.load();
+
+			if (m_state.load() != 0)
+				futexWait(m_epoch, epoch);
+
+			m_sleepers.fetch_sub(1);
+
+			if (tryLock())
+			{
+				m_waitingWriters.fetch_sub(1);
+				return;
+			}
+		}
+	}
+
+	void SharedMutex::lockSharedSlow()
+	{
+		while (true)
+		{
+			for (uint32 i = 0; i < SPIN_COUNT; i++)
+			{
+				if (tryLockSharedImpl())
+					return;
+
+				cpuRelax();
+			}
+
+			m_sleepers.fetch_add(1);
+			uint32 epoch = m_epoch.load();
+
+			if ((m_state.load() & WRITER_BIT) != 0 || (m_policy == SharedMutexPolicy::WRITER_PREFERRING &&
+				m_waitingWriters.load() != 0))
+			{
+				futexWait(m_epoch, epoch);
+			}
+
+			m_sleepers.fetch_sub(1);
+
+			if (tryLockSharedImpl())
+				return;
+		}
+	}
+
+	void SharedMutex::wakeAll()
+	{
+		m_epoch.fetch_add(1);
+		futexWake(m_epoch, true);
+	}
+}
@@ -3,18 +3,389 @@
 #include "nostrautils/dat_alg/BinaryHeap.hpp"
 #include "nostrautils/dat_alg/ObjectPool.hpp"
 #include "nostrautils/core/Assertions.hpp"
-#include "nostrautils/dat_alg/HashMap.hpp"
-
+#include "nostrautils/dat_alg/ConcurrentHashMap.hpp"
+#include "nostrautils/dat_alg/FastQueue.hpp"
+#include "nostrautils/thread/WorkStealingDeque.hpp"
+#include "nostrautils/thread/ParkingLot.hpp"
+#include "nostrautils/mem_mngt/ConcurrentPoolAllocator.hpp"
+
+#include <chrono>
+#include <cstdio>
 #include <iostream>
 
 namespace NOU::NOU_THREAD
 {
+	namespace
+	{
+		/**
+		\return The configuration that the thread manager will be constructed with.
+		*/
+		ThreadManagerConfiguration& pendingConfiguration()
+		{
+			static ThreadManagerConfiguration configuration;
+			return configuration;
+		}
+
+		/**
+		\return A reference to a boolean that is true, if the thread manager has already been constructed.
+		*/
+		boolean& isThreadManagerConstructed()
+		{
+			static boolean constructed = false;
+			return constructed;
+		}
+
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		/**
+		\return The current time in nanoseconds, from a monotonic clock.
+		*/
+		uint64 instrumentationTime()
+		{
+			return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		/**
+		\param counter The counter.
+		\param value   The value to add.
+
+		\brief Adds a value to a counter that is only written by a single thread. Unlike fetch_add(), this does
+		       not require a locked instruction.
+		*/
+		void addRelaxed(std::atomic<uint64> &counter, uint64 value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+#endif
+	}
+
 	constexpr typename ThreadManager::Priority ThreadManager::TaskInformation::INVALID_ID;
 
 	constexpr uint32 ThreadManager::DEFAULT_THREAD_COUNT;
 
 	constexpr sizeType ThreadManager::DEFAULT_TASK_CAPACITY;
 
+	constexpr sizeType ThreadManager::PRIORITY_BAND_COUNT;
+
+	constexpr typename ThreadManager::Priority ThreadManager::DEFAULT_PRIORITY;
+
+	ThreadManagerConfiguration::ThreadManagerConfiguration() :
+		schedulerMode(SchedulerMode::TASK_HEAP),
+		threadCount(0),
+		threadAffinity(ThreadAffinity::NONE),
+		threadNamePrefix("nou-worker"),
+		preferLocalStealing(true),
+		idleSpinCount(0),
+		idleYieldCount(0),
+		prespawnThreads(false)
+	{}
+
+	ThreadManager::TaskErrorHandlerPair::TaskErrorHandlerPair(internal::AbstractTask *task, 
+		NOU_CORE::ErrorHandler *handler) :
+		task(task),
+		handler(handler)
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		, enqueueTime(instrumentationTime())
+#endif
+	{}
+
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+	struct ThreadManager::InstrumentationData
+	{
+		/**
+		\brief The counters of a single thread. They are only written by that thread, but may be read by any
+		       thread. The alignment keeps the counters of different threads on different cache lines.
+		*/
+		struct alignas(64) Worker
+		{
+			/**
+			\brief The amount of executed tasks.
+			*/
+			std::atomic<uint64> m_tasksExecuted;
+
+			/**
+			\brief The time spent executing tasks.
+			*/
+			std::atomic<uint64> m_busyNanos;
+
+			/**
+			\brief The time spent between tasks.
+			*/
+			std::atomic<uint64> m_idleNanos;
+
+			/**
+			\brief The amount of stolen tasks.
+			*/
+			std::atomic<uint64> m_steals;
+
+			/**
+			\brief The time at which the last task was finished (or the thread was started). This is only
+			       accessed by the thread itself.
+			*/
+			uint64 m_lastFinish;
+
+			/**
+			\brief The buckets of WorkerStatistics::queueLatency.
+			*/
+			std::atomic<uint64> m_queueLatency[LatencyHistogram::BUCKET_COUNT];
+
+			/**
+			\brief The buckets of WorkerStatistics::executionLatency.
+			*/
+			std::atomic<uint64> m_executionLatency[LatencyHistogram::BUCKET_COUNT];
+
+			/**
+			\brief Constructs an instance with all counters set to 0.
+			*/
+			Worker();
+		};
+
+		/**
+		\brief The counters of each thread.
+		*/
+		Worker *m_workers;
+
+		/**
+		\brief The amount of elements in \p m_workers.
+		*/
+		sizeType m_workerCount;
+
+		/**
+		\brief The largest size of the task heap so far. Only written while m_taskHeapAccessMutex is locked.
+		*/
+		std::atomic<sizeType> m_heapHighWaterMark;
+
+		/**
+		\param workerCount The amount of threads.
+
+		\brief Constructs a new instance.
+		*/
+		explicit InstrumentationData(sizeType workerCount);
+
+		/**
+		\brief Destructs the instance.
+		*/
+		~InstrumentationData();
+	};
+
+	ThreadManager::InstrumentationData::Worker::Worker() :
+		m_tasksExecuted(0),
+		m_busyNanos(0),
+		m_idleNanos(0),
+		m_steals(0),
+		m_lastFinish(instrumentationTime())
+	{
+		for (sizeType i = 0; i < LatencyHistogram::BUCKET_COUNT; i++)
+		{
+			m_queueLatency[i].store(0, std::memory_order_relaxed);
+			m_executionLatency[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	ThreadManager::InstrumentationData::InstrumentationData(sizeType workerCount) :
+		m_workers(new Worker[workerCount]),
+		m_workerCount(workerCount),
+		m_heapHighWaterMark(0)
+	{}
+
+	ThreadManager::InstrumentationData::~InstrumentationData()
+	{
+		delete[] m_workers;
+	}
+#endif
+
+	struct ThreadManager::WorkStealingWorker
+	{
+		/**
+		\brief The deques that the tasks which are pushed by this worker are stored in (one per priority 
+		       band).
+		*/
+		WorkStealingDeque<TaskErrorHandlerPair> m_deques[PRIORITY_BAND_COUNT];
+
+		/**
+		\brief The mutex that controls the access to \p m_inbox.
+		*/
+		Mutex m_inboxMutex;
+
+		/**
+		\brief The queues that the tasks which are pushed by threads that are not workers are stored in (one 
+		       per priority band).
+		*/
+		NOU_DAT_ALG::FastQueue<TaskErrorHandlerPair> m_inbox[PRIORITY_BAND_COUNT];
+
+		/**
+		\brief The total amount of tasks in \p m_inbox. This is used to avoid locking \p m_inboxMutex if
+		       the inbox is empty anyway.
+		*/
+		std::atomic<sizeType> m_inboxSize;
+
+		/**
+		\brief The mutex that is used (together with \p m_parkVariable) to park the worker.
+		*/
+		Mutex m_parkMutex;
+
+		/**
+		\brief The condition variable that is used (together with \p m_parkMutex) to park the worker.
+		*/
+		ConditionVariable m_parkVariable;
+
+		/**
+		\brief True, if the worker is parked or about to park.
+		*/
+		boolean m_parked;
+
+		/**
+		\brief True, if the worker has been told to stop parking.
+		*/
+		boolean m_wakeRequested;
+
+		/**
+		\brief The error handler that is used by tasks that were pushed without an own handler.
+		*/
+		NOU_CORE::ErrorHandler m_handler;
+
+		/**
+		\brief The handler of the task that the worker is currently executing. This is only accessed by the
+		       thread of the worker itself.
+		*/
+		NOU_CORE::ErrorHandler *m_currentHandler;
+
+		/**
+		\brief The state of the random number generator that is used to choose the victims to steal from.
+		*/
+		uint32 m_randomState;
+
+		/**
+		\brief The index of the worker.
+		*/
+		sizeType m_index;
+
+		/**
+		\brief The NUMA node that the worker is bound to, or 0 if it is not bound to a node.
+		*/
+		sizeType m_node;
+
+		/**
+		\brief The thread of the worker. This member must be the last one, since the thread is started as 
+		       soon as it is constructed.
+		*/
+		ThreadWrapper m_thread;
+
+		/**
+		\param threadManager The thread manager that the worker belongs to.
+		\param index         The index of the worker.
+
+		\brief Constructs a new worker and starts its thread.
+		*/
+		WorkStealingWorker(ThreadManager *threadManager, sizeType index);
+
+		/**
+		\param band The priority band to pop from.
+		\param out  The object that the popped task will be stored in.
+
+		\return True, if a task was popped, false if not.
+
+		\brief Pops a task from the inbox of the worker. This method may be called by any thread.
+		*/
+		boolean popInbox(sizeType band, TaskErrorHandlerPair &out);
+
+		/**
+		\return A pseudo random number.
+
+		\brief Returns the next pseudo random number (xorshift) of this worker.
+		*/
+		uint32 nextRandom();
+	};
+
+	thread_local ThreadManager::WorkStealingWorker *ThreadManager::s_currentWorker = nullptr;
+
+	thread_local ThreadManager *ThreadManager::s_currentThreadManager = nullptr;
+
+	ThreadManager::WorkStealingWorker::WorkStealingWorker(ThreadManager *threadManager, sizeType index) :
+		m_inboxSize(0),
+		m_parked(false),
+		m_wakeRequested(false),
+		m_currentHandler(&m_handler),
+		m_randomState(static_cast<uint32>(index) * 2654435761u + 1),
+		m_index(index),
+		m_node(Topology::numaNodeOf(threadManager->affinityOf(index).first())),
+		m_thread(workStealingLoop, threadManager, this)
+	{}
+
+	boolean ThreadManager::WorkStealingWorker::popInbox(sizeType band, TaskErrorHandlerPair &out)
+	{
+		if (m_inboxSize.load(std::memory_order_relaxed) == 0)
+			return false;
+
+		Lock lock(m_inboxMutex);
+
+		if (m_inbox[band].size() == 0)
+			return false;
+
+		out = m_inbox[band].popFront();
+		m_inboxSize.fetch_sub(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	uint32 ThreadManager::WorkStealingWorker::nextRandom()
+	{
+		m_randomState ^= m_randomState << 13;
+		m_randomState ^= m_randomState >> 17;
+		m_randomState ^= m_randomState << 5;
+
+		return m_randomState;
+	}
+
+	class ThreadManager::SubmittedTask final : public internal::AbstractTask
+	{
+	private:
+		/**
+		\brief The task that was submitted.
+		*/
+		InlineTask         m_task;
+
+		/**
+		\brief The pool that this task is stored in.
+		*/
+		SubmittedTaskPool *m_pool;
+
+	public:
+		/**
+		\param task The task that was submitted.
+		\param pool The pool that this task is stored in.
+
+		\brief Constructs a new instance.
+		*/
+		SubmittedTask(InlineTask &&task, SubmittedTaskPool *pool);
+
+		/**
+		\brief Executes the submitted task and returns this instance to the pool.
+		*/
+		virtual void execute() override;
+	};
+
+	struct ThreadManager::SubmittedTaskPool
+	{
+		/**
+		\brief The allocator that the submitted tasks are stored in.
+		*/
+		NOU_MEM_MNGT::ConcurrentPoolAllocator<SubmittedTask> m_allocator;
+	};
+
+	ThreadManager::SubmittedTask::SubmittedTask(InlineTask &&task, SubmittedTaskPool *pool) :
+		m_task(NOU_CORE::move(task)),
+		m_pool(pool)
+	{}
+
+	void ThreadManager::SubmittedTask::execute()
+	{
+		m_task.execute();
+
+		//the thread manager does not access a task after it has been executed
+		m_pool->m_allocator.deallocate(this);
+	}
+
 	ThreadManager::TaskInformation::TaskInformation(Priority id) :
 		m_id(id)
 	{}
@@ -23,39 +394,50 @@ namespace NOU::NOU_THREAD
 		m_id(INVALID_ID)
 	{}
 
-	void ThreadManager::threadLoop(ThreadManager *threadManager, ThreadDataBundle **threadDataPtr, 
-		Mutex *startupMutex, ConditionVariable *startupVariable, boolean *startupDone)
+	void ThreadManager::threadLoop(ThreadManager *threadManager, sizeType index, 
+		ThreadDataBundle **threadDataPtr, Mutex *startupMutex, ConditionVariable *startupVariable, 
+		boolean *startupDone)
 	{
 		ThreadDataBundle *threadData;
 
+		s_currentThreadManager = threadManager;
+		threadManager->setupThread(index);
+		threadManager->instrumentThreadStart(index);
+
 		{
 			Lock lock(*startupMutex);
 
 			threadData = *threadDataPtr;
-		}
 
-		*startupDone = true;
-		startupVariable->notifyAll();
+			*startupDone = true;
+			startupVariable->notifyAll();
+		}
 
 		while (!(threadManager->m_shouldShutdown))
 		{
-			UniqueLock lock(threadData->m_mutex);
-			threadData->m_variable.wait(lock, [threadData, threadManager]() 
-			{ 
-				//wait for new task or thread manager shutdown
-				return threadData->m_taskReady || threadManager->m_shouldShutdown; 
-			});
+			//a task that arrives while the thread spins does not need to wake it up
+			if (!threadManager->spinForTask(*threadData))
+			{
+				UniqueLock lock(threadData->m_mutex);
+				threadData->m_variable.wait(lock, [threadData, threadManager]() 
+				{ 
+					//wait for new task or thread manager shutdown
+					return threadData->m_taskReady || threadManager->m_shouldShutdown; 
+				});
+			}
 
 			//if the manager should shutdown, the method will be stopped from looping.
 			if (threadManager->m_shouldShutdown)
 				return;
 
-			internal::AbstractTask *t = threadData->m_taskHandlerPair.task;
+			uint64 start = threadManager->instrumentTaskStart(index, threadData->m_taskHandlerPair);
 
 			threadData->m_taskHandlerPair.task->execute();
 
+			threadManager->instrumentTaskFinish(index, start);
+
 			//Set to false for the next iteration, must be set to true by the thread manager
-			threadData->m_taskReady = false;
+			threadData->m_taskReady.store(false, std::memory_order_relaxed);
 
 			threadManager->giveBackThread(*threadData);
 		}
@@ -63,6 +445,89 @@ namespace NOU::NOU_THREAD
 
 
 
+	void ThreadManager::workStealingLoop(ThreadManager *threadManager, WorkStealingWorker *worker)
+	{
+		s_currentThreadManager = threadManager;
+		threadManager->setupThread(worker->m_index);
+
+		{
+			//wait until all workers have been created and their handlers have been mapped
+			UniqueLock lock(threadManager->m_workersStartedMutex);
+			threadManager->m_workersStartedVariable.wait(lock, [threadManager]() 
+			{ 
+				return threadManager->m_workersStarted; 
+			});
+		}
+
+		s_currentWorker = worker;
+		threadManager->instrumentThreadStart(worker->m_index);
+
+		TaskErrorHandlerPair task(nullptr, nullptr);
+
+		while (!(threadManager->m_shouldShutdown))
+		{
+			boolean found = threadManager->findWorkStealingTask(*worker, task);
+
+			if (!found)
+				found = threadManager->spinForWorkStealingTask(*worker, task);
+
+			if (!found)
+			{
+				{
+					Lock lock(worker->m_parkMutex);
+					worker->m_parked = true;
+				}
+
+				threadManager->m_idleWorkers.fetch_add(1);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				//check again, a task might have been pushed before m_idleWorkers was increased
+				found = threadManager->findWorkStealingTask(*worker, task);
+
+				{
+					UniqueLock lock(worker->m_parkMutex);
+
+					if (!found)
+					{
+						worker->m_parkVariable.wait(lock, [worker, threadManager]()
+						{
+							return worker->m_wakeRequested || threadManager->m_shouldShutdown;
+						});
+					}
+
+					worker->m_parked = false;
+					worker->m_wakeRequested = false;
+				}
+
+				threadManager->m_idleWorkers.fetch_sub(1);
+			}
+
+			if (found)
+			{
+				NOU_CORE::ErrorHandler *handler = task.handler == nullptr ? &worker->m_handler : task.handler;
+
+				//only update the map if the handler changes, this is the common case for tasks without a handler
+				if (handler != worker->m_currentHandler)
+				{
+					worker->m_currentHandler = handler;
+					threadManager->m_handlersMap->map(worker->m_thread.getID(), handler);
+				}
+
+				uint64 start = threadManager->instrumentTaskStart(worker->m_index, task);
+
+				task.task->execute();
+
+				threadManager->instrumentTaskFinish(worker->m_index, start);
+
+				if (handler == &worker->m_handler)
+				{
+					while (handler->getErrorCount() > 0) //clear handler from all errors
+						handler->popError();
+				}
+			}
+		}
+	}
+
 	ThreadManager::ThreadDataBundle::ThreadDataBundle(ThreadWrapper &&thread) :
 		m_thread(NOU_CORE::move(thread)),
 		m_taskHandlerPair(nullptr, nullptr), //m_taskHandlerPair will be initialized later
@@ -72,7 +537,7 @@ namespace NOU::NOU_THREAD
 	ThreadManager::ThreadDataBundle::ThreadDataBundle(ThreadDataBundle&& tdb) :
 		m_thread(NOU_CORE::move(tdb.m_thread)),
 		m_taskHandlerPair(NOU_CORE::move(tdb.m_taskHandlerPair)),
-		m_taskReady(tdb.m_taskReady)
+		m_taskReady(tdb.m_taskReady.load())
 	{}
 
 	NOU_FUNC ThreadManager& getThreadManager()
@@ -86,9 +551,65 @@ namespace NOU::NOU_THREAD
 		return instance;
 	}
 
+	boolean ThreadManager::configure(const ThreadManagerConfiguration &configuration)
+	{
+		if (isThreadManagerConstructed())
+			return false;
+
+		pendingConfiguration() = configuration;
+
+		return true;
+	}
+
+	CpuSet ThreadManager::affinityOf(sizeType index) const
+	{
+		if (m_configuration.affinityMasks.size() > 0)
+			return m_configuration.affinityMasks[index % m_configuration.affinityMasks.size()];
+
+		CpuSet ret;
+
+		if (m_configuration.threadAffinity == ThreadAffinity::NONE)
+			return ret;
+
+		sizeType cpu = Topology::cpuAt(index % Topology::cpuCount());
+
+		if (m_configuration.threadAffinity == ThreadAffinity::CPU)
+			ret.set(cpu);
+		else
+			ret = Topology::numaNodeCpus(Topology::numaNodeOf(cpu));
+
+		return ret;
+	}
+
+	void ThreadManager::setupThread(sizeType index) const
+	{
+		CpuSet cpus = affinityOf(index);
+
+		if (cpus.count() > 0)
+			Topology::setCurrentThreadAffinity(cpus);
+
+		if (m_configuration.threadNamePrefix != nullptr)
+		{
+			char name[64];
+			std::snprintf(name, sizeof(name), "%s-%zu", m_configuration.threadNamePrefix, 
+				static_cast<size_t>(index));
+
+			Topology::setCurrentThreadName(name);
+		}
+	}
+
 	typename ThreadManager::ObjectPoolPtr<typename ThreadManager::ThreadDataBundle> 
 		ThreadManager::makeThreadPool()
 	{
+		//an explicit thread count is used as-is
+		if (m_configuration.threadCount != 0)
+		{
+			return ObjectPoolPtr<ThreadDataBundle>(new NOU_DAT_ALG::ObjectPool<ThreadDataBundle>
+				(m_configuration.threadCount, NOU_MEM_MNGT::GenericAllocationCallback<
+					NOU_DAT_ALG::ObjectPool<ThreadDataBundle>::Chunk>()),
+				NOU_MEM_MNGT::defaultDeleter);
+		}
+
 		// -1, b/c that is the main execution thread
 		sizeType threadPoolCapacity = ThreadWrapper::maxThreads() == 0 ? DEFAULT_THREAD_COUNT - 1 : 
 			ThreadWrapper::maxThreads() - 1;
@@ -118,14 +639,12 @@ namespace NOU::NOU_THREAD
 	}
 
 
-	NOU_MEM_MNGT::UniquePtr<NOU_DAT_ALG::HashMap<typename ThreadWrapper::ID,
+	NOU_MEM_MNGT::UniquePtr<NOU_DAT_ALG::ConcurrentHashMap<typename ThreadWrapper::ID,
 		NOU_CORE::ErrorHandler*>> ThreadManager::makeHandlersMap()
 	{
-		using MapPtr = decltype(m_handlersMap);
-
 		//+ 1 b/c this map also stores the handler of the main thread
-		auto ret = NOU_MEM_MNGT::UniquePtr<NOU_DAT_ALG::HashMap<typename ThreadWrapper::ID,
-			NOU_CORE::ErrorHandler*>>(new NOU_DAT_ALG::HashMap<typename ThreadWrapper::ID, 
+		auto ret = NOU_MEM_MNGT::UniquePtr<NOU_DAT_ALG::ConcurrentHashMap<typename ThreadWrapper::ID,
+			NOU_CORE::ErrorHandler*>>(new NOU_DAT_ALG::ConcurrentHashMap<typename ThreadWrapper::ID, 
 				NOU_CORE::ErrorHandler*>(m_threads->capacity() + 1), NOU_MEM_MNGT::defaultDeleter);
 
 		ret->map(std::this_thread::get_id(), &NOU_CORE::ErrorHandler::getMainThreadHandler());
@@ -144,29 +663,36 @@ namespace NOU::NOU_THREAD
 
 		//store task and handler as-is, do not appoint a handler from the pool to a task that comes with an 
 		//nullptr as error handler
-		return TaskInformation(m_tasks->enqueue(priority, TaskErrorHandlerPair(task, handler)));
+		TaskInformation ret(m_tasks->enqueue(priority, TaskErrorHandlerPair(task, handler)));
+
+		instrumentHeapSize();
+
+		return ret;
 	}
 
 	boolean ThreadManager::addThread()
 	{
 		if (m_threads->size() != m_threads->capacity())
 		{
-			Mutex startupVariableMutex;
 			ConditionVariable startupVariable;
 			Mutex startupMutex;
 			boolean startupDone = false;
 
+			//must outlive the startup of the thread, since the thread reads it
+			ThreadDataBundle *threadDataPtr = nullptr;
+
+			sizeType index = m_threads->size();
+
 			{
 				Lock startupLock(startupMutex);
 
-				ThreadDataBundle *threadDataPtr;
 				ThreadDataBundle &threadData = m_threads->emplaceObject(NOU_CORE::move(
-					ThreadWrapper(threadLoop, this, &threadDataPtr, &startupMutex, &startupVariable, 
+					ThreadWrapper(threadLoop, this, index, &threadDataPtr, &startupMutex, &startupVariable, 
 						&startupDone)));
 				threadDataPtr = &threadData;
 			}
 
-			UniqueLock startupVariableLock(startupVariableMutex);
+			UniqueLock startupVariableLock(startupMutex);
 			startupVariable.wait(startupVariableLock, [&startupDone]() { return startupDone; });
 
 			m_handlers->pushObject(NOU_CORE::ErrorHandler());
@@ -191,29 +717,380 @@ namespace NOU::NOU_THREAD
 		m_handlersMap->map(threadData.m_thread.getID(), task.handler);
 
 		threadData.m_taskHandlerPair = task;
-		threadData.m_taskReady = true;
+
+		{
+			//the thread may be between checking the predicate and waiting, the mutex prevents a lost wake up
+			Lock lock(threadData.m_mutex);
+			threadData.m_taskReady.store(true, std::memory_order_release);
+		}
+
 		threadData.m_variable.notifyAll();
 	}
 
 	ThreadManager::ThreadManager() : 
+		ThreadManager(pendingConfiguration())
+	{
+		isThreadManagerConstructed() = true;
+	}
+
+	ThreadManager::ThreadManager(const ThreadManagerConfiguration &configuration) : 
+		m_configuration(configuration),
 		m_shouldShutdown(false),
 		m_threads(makeThreadPool()),
 		m_handlers(makeHandlerPool()),
 		m_tasks(makeTaskHeap()),
-		m_handlersMap(makeHandlersMap())
+		m_handlersMap(makeHandlersMap()),
+		m_workers(nullptr),
+		m_workerCount(0),
+		m_preferLocalStealing(false),
+		m_idleWorkers(0),
+		m_nextInboxIndex(0),
+		m_workersStarted(false),
+		m_prespawnThread(nullptr),
+		m_submittedTasks(new SubmittedTaskPool())
 	{
 		static_assert(NOU_CORE::AreSame<typename 
 			NOU_DAT_ALG::BinaryHeap<TaskErrorHandlerPair>::PriorityTypePart, Priority>::value);
+
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		//must exist before the first thread starts
+		m_instrumentation = new InstrumentationData(m_threads->capacity());
+#endif
+
+		if (m_configuration.schedulerMode == SchedulerMode::WORK_STEALING)
+			makeWorkStealingWorkers();
+		else if (m_configuration.prespawnThreads)
+			m_prespawnThread = new ThreadWrapper(prespawnLoop, this);
+	}
+
+	void ThreadManager::prespawnLoop(ThreadManager *threadManager)
+	{
+		//one thread at a time, so that pushTask() does not have to wait until all of them have been created
+		while (!(threadManager->m_shouldShutdown) && threadManager->prepareThread(1) == 1);
+	}
+
+	void ThreadManager::instrumentThreadStart(sizeType index)
+	{
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		m_instrumentation->m_workers[index].m_lastFinish = instrumentationTime();
+#else
+		(void) index;
+#endif
+	}
+
+	uint64 ThreadManager::instrumentTaskStart(sizeType index, const TaskErrorHandlerPair &task)
+	{
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		InstrumentationData::Worker &worker = m_instrumentation->m_workers[index];
+		uint64 now = instrumentationTime();
+
+		addRelaxed(worker.m_idleNanos, now - worker.m_lastFinish);
+
+		addRelaxed(worker.m_queueLatency[LatencyHistogram::bucketOf(now - task.enqueueTime)], 1);
+
+		return now;
+#else
+		(void) index;
+		(void) task;
+
+		return 0;
+#endif
+	}
+
+	void ThreadManager::instrumentTaskFinish(sizeType index, uint64 start)
+	{
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		InstrumentationData::Worker &worker = m_instrumentation->m_workers[index];
+		uint64 now = instrumentationTime();
+
+		addRelaxed(worker.m_tasksExecuted, 1);
+		addRelaxed(worker.m_busyNanos, now - start);
+		addRelaxed(worker.m_executionLatency[LatencyHistogram::bucketOf(now - start)], 1);
+
+		worker.m_lastFinish = now;
+#else
+		(void) index;
+		(void) start;
+#endif
+	}
+
+	void ThreadManager::instrumentSteal(sizeType index)
+	{
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		addRelaxed(m_instrumentation->m_workers[index].m_steals, 1);
+#else
+		(void) index;
+#endif
+	}
+
+	void ThreadManager::instrumentHeapSize()
+	{
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		if (m_tasks->size() > m_instrumentation->m_heapHighWaterMark.load(std::memory_order_relaxed))
+			m_instrumentation->m_heapHighWaterMark.store(m_tasks->size(), std::memory_order_relaxed);
+#endif
+	}
+
+	boolean ThreadManager::spinForTask(ThreadDataBundle &threadData)
+	{
+		for (uint32 i = 0; i < m_configuration.idleSpinCount; i++)
+		{
+			if (threadData.m_taskReady.load(std::memory_order_acquire) || m_shouldShutdown)
+				return true;
+
+			cpuRelax();
+		}
+
+		for (uint32 i = 0; i < m_configuration.idleYieldCount; i++)
+		{
+			if (threadData.m_taskReady.load(std::memory_order_acquire) || m_shouldShutdown)
+				return true;
+
+			std::this_thread::yield();
+		}
+
+		return threadData.m_taskReady.load(std::memory_order_acquire);
+	}
+
+	typename ThreadManager::WorkStealingWorker* ThreadManager::currentWorker() const
+	{
+		//a worker of another thread manager must not push to its own deques
+		return s_currentThreadManager == this ? s_currentWorker : nullptr;
+	}
+
+	void ThreadManager::makeWorkStealingWorkers()
+	{
+		//the workers replace the thread pool, hence the same amount of threads is used
+		m_workerCount = m_threads->capacity();
+		m_workers = new WorkStealingWorker*[m_workerCount];
+
+		//without bound threads, the node of a worker is meaningless
+		m_preferLocalStealing = m_configuration.preferLocalStealing && Topology::numaNodeCount() > 1 &&
+			(m_configuration.affinityMasks.size() > 0 || 
+				m_configuration.threadAffinity != ThreadAffinity::NONE);
+
+		for (sizeType i = 0; i < m_workerCount; i++)
+			m_workers[i] = new WorkStealingWorker(this, i);
+
+		for (sizeType i = 0; i < m_workerCount; i++)
+			m_handlersMap->map(m_workers[i]->m_thread.getID(), &m_workers[i]->m_handler);
+
+		{
+			Lock lock(m_workersStartedMutex);
+			m_workersStarted = true;
+		}
+
+		m_workersStartedVariable.notifyAll();
+	}
+
+	void ThreadManager::pushWorkStealingTask(const TaskErrorHandlerPair &task, Priority priority)
+	{
+		sizeType band = NOU_CORE::min<sizeType>(priority, PRIORITY_BAND_COUNT - 1);
+		WorkStealingWorker *current = currentWorker();
+
+		if (current != nullptr)
+		{
+			//lock-free path, the calling thread is a worker itself
+			current->m_deques[band].pushBack(task);
+		}
+		else
+		{
+			WorkStealingWorker &worker = *m_workers[m_nextInboxIndex.fetch_add(1, 
+				std::memory_order_relaxed) % m_workerCount];
+
+			Lock lock(worker.m_inboxMutex);
+			worker.m_inbox[band].pushBack(task);
+			worker.m_inboxSize.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (m_idleWorkers.load() > 0)
+			wakeWorkStealingWorker();
+	}
+
+	void ThreadManager::pushWorkStealingTasks(internal::AbstractTask *const *tasks, sizeType count, 
+		Priority priority, NOU_CORE::ErrorHandler *handler)
+	{
+		sizeType band = NOU_CORE::min<sizeType>(priority, PRIORITY_BAND_COUNT - 1);
+		WorkStealingWorker *current = currentWorker();
+
+		if (current != nullptr)
+		{
+			for (sizeType i = 0; i < count; i++)
+				current->m_deques[band].pushBack(TaskErrorHandlerPair(tasks[i], handler));
+		}
+		else
+		{
+			//spread the tasks evenly across the inboxes, each inbox is only locked once
+			sizeType first = m_nextInboxIndex.fetch_add(count, std::memory_order_relaxed);
+			sizeType perWorker = count / m_workerCount;
+			sizeType remainder = count % m_workerCount;
+			sizeType next = 0;
+
+			for (sizeType i = 0; i < m_workerCount && next < count; i++)
+			{
+				sizeType amount = perWorker + (i < remainder ? 1 : 0);
+
+				if (amount == 0)
+					continue;
+
+				WorkStealingWorker &worker = *m_workers[(first + i) % m_workerCount];
+
+				Lock lock(worker.m_inboxMutex);
+
+				for (sizeType j = 0; j < amount; j++)
+					worker.m_inbox[band].pushBack(TaskErrorHandlerPair(tasks[next++], handler));
+
+				worker.m_inboxSize.fetch_add(amount, std::memory_order_relaxed);
+			}
+		}
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		//there is no need to wake up more workers than there are tasks
+		sizeType wakeCount = NOU_CORE::min<sizeType>(m_idleWorkers.load(), count);
+
+		for (sizeType i = 0; i < wakeCount; i++)
+			wakeWorkStealingWorker();
+	}
+
+	boolean ThreadManager::findWorkStealingTask(WorkStealingWorker &worker, TaskErrorHandlerPair &out)
+	{
+		for (sizeType band = 0; band < PRIORITY_BAND_COUNT; band++)
+		{
+			if (worker.m_deques[band].popBack(out) || worker.popInbox(band, out))
+				return true;
+
+			//start at a random victim to spread the stealing across all workers
+			sizeType start = worker.nextRandom() % m_workerCount;
+
+			//if preferred, the first pass only visits the workers on the own node and the second one the rest
+			sizeType passes = m_preferLocalStealing ? 2 : 1;
+
+			for (sizeType pass = 0; pass < passes; pass++)
+			{
+				for (sizeType i = 0; i < m_workerCount; i++)
+				{
+					WorkStealingWorker &victim = *m_workers[(start + i) % m_workerCount];
+
+					if (&victim == &worker)
+						continue;
+
+					if (m_preferLocalStealing && (victim.m_node == worker.m_node) != (pass == 0))
+						continue;
+
+					if (victim.m_deques[band].steal(out) || victim.popInbox(band, out))
+					{
+						instrumentSteal(worker.m_index);
+						return true;
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+
+	boolean ThreadManager::spinForWorkStealingTask(WorkStealingWorker &worker, TaskErrorHandlerPair &out)
+	{
+		for (uint32 i = 0; i < m_configuration.idleSpinCount && !m_shouldShutdown; i++)
+		{
+			cpuRelax();
+
+			if (findWorkStealingTask(worker, out))
+				return true;
+		}
+
+		for (uint32 i = 0; i < m_configuration.idleYieldCount && !m_shouldShutdown; i++)
+		{
+			std::this_thread::yield();
+
+			if (findWorkStealingTask(worker, out))
+				return true;
+		}
+
+		return false;
+	}
+
+	void ThreadManager::wakeWorkStealingWorker()
+	{
+		sizeType start = m_nextInboxIndex.load(std::memory_order_relaxed);
+
+		for (sizeType i = 0; i < m_workerCount; i++)
+		{
+			WorkStealingWorker &worker = *m_workers[(start + i) % m_workerCount];
+
+			Lock lock(worker.m_parkMutex);
+
+			if (worker.m_parked && !worker.m_wakeRequested)
+			{
+				worker.m_wakeRequested = true;
+				worker.m_parkVariable.notifyOne();
+				return;
+			}
+		}
 	}
 
 	ThreadManager::~ThreadManager()
 	{
 		m_shouldShutdown = true;
 
-		Lock threadLock(m_threadPoolAccessMutex);
+		//the pool must not change anymore while the threads are joined
+		if (m_prespawnThread != nullptr)
+		{
+			m_prespawnThread->join();
+			delete m_prespawnThread;
+		}
+
+		if (m_workers != nullptr)
+		{
+			for (sizeType i = 0; i < m_workerCount; i++)
+			{
+				{
+					Lock lock(m_workers[i]->m_parkMutex);
+					m_workers[i]->m_wakeRequested = true;
+				}
+
+				m_workers[i]->m_parkVariable.notifyAll();
+			}
+
+			for (sizeType i = 0; i < m_workerCount; i++)
+			{
+				if (m_workers[i]->m_thread.joinable())
+					m_workers[i]->m_thread.join();
+			}
+
+			//the tasks that are left in the deques and inboxes will never be executed
+			for (sizeType i = 0; i < m_workerCount; i++)
+			{
+				TaskErrorHandlerPair task(nullptr, nullptr);
+
+				for (sizeType band = 0; band < PRIORITY_BAND_COUNT; band++)
+				{
+					while (m_workers[i]->m_deques[band].popBack(task) || m_workers[i]->popInbox(band, task))
+						discardTask(task.task);
+				}
+			}
+
+			//workers that are still running steal from the deques of the others, so no worker can be deleted
+			//before all of them have been joined
+			for (sizeType i = 0; i < m_workerCount; i++)
+				delete m_workers[i];
 
+			delete[] m_workers;
+		}
+
+		//m_threadPoolAccessMutex must not be locked while joining, a thread that is still executing a task
+		//locks it in giveBackThread() before it can observe m_shouldShutdown
 		m_threads->foreach([](ThreadDataBundle& tdb) 
 		{ 
+			//lock the mutex to make sure that the thread is either waiting or has not yet checked the
+			//predicate, otherwise the notification could get lost
+			{
+				Lock lock(tdb.m_mutex);
+			}
+
 			//if the thread method is currently waiting for a new task, this will make it stop waiting and
 			//return instead 
 			tdb.m_variable.notifyAll(); 
@@ -223,6 +1100,32 @@ namespace NOU::NOU_THREAD
 				tdb.m_thread.join(); 
 			} 
 		});
+
+		//a thread that observed the shutdown before it started its task has not reset m_taskReady
+		m_threads->foreach([this](ThreadDataBundle &tdb)
+		{
+			if (tdb.m_taskReady.load(std::memory_order_acquire))
+				discardTask(tdb.m_taskHandlerPair.task);
+		});
+
+		while (m_tasks->size() > 0)
+		{
+			discardTask(m_tasks->get().task);
+			m_tasks->dequeue();
+		}
+
+		delete m_submittedTasks;
+
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		delete m_instrumentation;
+#endif
+	}
+
+	void ThreadManager::discardTask(internal::AbstractTask *task)
+	{
+		//only the address is compared, the task may be a task of a user that has already been destroyed
+		if (m_submittedTasks->m_allocator.isPartOf(task))
+			m_submittedTasks->m_allocator.deallocate(static_cast<SubmittedTask*>(task));
 	}
 
 	void ThreadManager::giveBackThread(ThreadDataBundle &thread)
@@ -236,7 +1139,7 @@ namespace NOU::NOU_THREAD
 				//will get a new one from the pool.
 				giveBackHandler(*thread.m_taskHandlerPair.handler);
 
-				TaskErrorHandlerPair &task = m_tasks->get();
+				TaskErrorHandlerPair task = m_tasks->get(); //copy, dequeue() overwrites the root
 				m_tasks->dequeue();
 
 				executeTaskWithThread(task, thread);
@@ -271,11 +1174,17 @@ namespace NOU::NOU_THREAD
 		* execute it immediately if a thread is available.
 		*/
 
+		if (m_workers != nullptr)
+		{
+			pushWorkStealingTask(TaskErrorHandlerPair(task, handler), priority);
+			return TaskInformation(TaskInformation::INVALID_ID);
+		}
+
 		Lock taskLock(m_taskHeapAccessMutex);
 
 		//if the priority is smaller than the first one in the heap or there is no task in the heap (aka. 
 		//this would be the first task to execute anyway)
-		if (m_tasks->size() == 0 || priority <= m_tasks->priorityAt(0))
+		if (m_tasks->size() == 0 || priority <= m_tasks->getPriority(m_tasks->priorityAt(0)))
 		{
 			Lock threadLock(m_threadPoolAccessMutex);
 
@@ -292,18 +1201,81 @@ namespace NOU::NOU_THREAD
 		return enqueueTask(task, priority, handler);
 	}
 
+	void ThreadManager::pushTasks(internal::AbstractTask *const *tasks, sizeType count, Priority priority,
+		NOU_CORE::ErrorHandler *handler)
+	{
+		if (count == 0)
+			return;
+
+		if (m_workers != nullptr)
+		{
+			pushWorkStealingTasks(tasks, count, priority, handler);
+			return;
+		}
+
+		Lock taskLock(m_taskHeapAccessMutex);
+
+		sizeType executed = 0;
+
+		//the same rule as in pushTask(), the tasks may only bypass the heap if they would be first anyway
+		if (m_tasks->size() == 0 || priority <= m_tasks->getPriority(m_tasks->priorityAt(0)))
+		{
+			Lock threadLock(m_threadPoolAccessMutex);
+
+			//one thread per task, no more threads are woken up (or created) than there are tasks
+			while (executed < count && (m_threads->remainingObjects() > 0 || addThread()))
+			{
+				executeTaskWithThread(TaskErrorHandlerPair(tasks[executed], handler), m_threads->get());
+				executed++;
+			}
+		}
+
+		if (executed < count)
+		{
+			NOU_DAT_ALG::Vector<TaskErrorHandlerPair> pairs(count - executed);
+
+			for (sizeType i = executed; i < count; i++)
+				pairs.pushBack(TaskErrorHandlerPair(tasks[i], handler));
+
+			m_tasks->enqueueAll(priority, pairs.data(), pairs.size());
+
+			instrumentHeapSize();
+		}
+	}
+
+	boolean ThreadManager::submitTask(InlineTask &&task, Priority priority)
+	{
+		if (!task.isValid())
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::INVALID_OBJECT,
+				"A task without an invocable can not be submitted.");
+
+			return false;
+		}
+
+		SubmittedTask *submitted = m_submittedTasks->m_allocator.allocate(NOU_CORE::move(task), 
+			m_submittedTasks);
+
+		if (submitted == nullptr)
+		{
+			NOU_PUSH_ERROR(NOU_CORE::getErrorHandler(), NOU_CORE::ErrorCodes::BAD_ALLOCATION,
+				"The task could not be submitted.");
+
+			return false;
+		}
+
+		pushTask(submitted, priority);
+
+		return true;
+	}
+
 	boolean ThreadManager::removeTask(const TaskInformation &taskInfo)
 	{
 		if (taskInfo.m_id != TaskInformation::INVALID_ID)
 		{
 			Lock taskLock(m_taskHeapAccessMutex);
 			
-			if (m_tasks->checkIfPresent(taskInfo.m_id))
-			{
-				m_tasks->deleteById(taskInfo.m_id);
-
-				return true;
-			}
+			return m_tasks->deleteById(taskInfo.m_id);
 		}
 
 		return false;
@@ -317,6 +1289,10 @@ namespace NOU::NOU_THREAD
 
 	sizeType ThreadManager::currentlyAvailableThreads()
 	{
+		//all workers are always created, only the parked ones are available
+		if (m_workers != nullptr)
+			return m_idleWorkers.load();
+
 		Lock lock(m_threadPoolAccessMutex);
 
 		/*
@@ -329,11 +1305,25 @@ namespace NOU::NOU_THREAD
 
 	NOU_CORE::ErrorHandler& ThreadManager::getErrorHandlerByThreadId(ThreadWrapper::ID id)
 	{
+		if (id == std::this_thread::get_id())
+		{
+			//a worker that looks up its own handler does not need to access the map at all
+			if (s_currentWorker != nullptr)
+				return *(s_currentWorker->m_currentHandler);
+
+			//only the thread manager that created the calling thread has mapped its handler
+			if (s_currentThreadManager != nullptr && s_currentThreadManager != this)
+				return s_currentThreadManager->getErrorHandlerByThreadId(id);
+		}
+
 		return *(m_handlersMap->get(id));
 	}
 
 	sizeType ThreadManager::currentlyPreparedThreads()
 	{
+		if (m_workers != nullptr)
+			return m_idleWorkers.load();
+
 		Lock lock(m_threadPoolAccessMutex);
 
 		return m_threads->remainingObjects();
@@ -341,6 +1331,10 @@ namespace NOU::NOU_THREAD
 
 	sizeType ThreadManager::prepareThread(sizeType count)
 	{
+		//all workers are created by the constructor, there is nothing left to prepare
+		if (m_workers != nullptr)
+			return 0;
+
 		Lock lock(m_threadPoolAccessMutex);
 
 		sizeType ret = 0; //use ret as a counter of how many threads have been created
@@ -354,4 +1348,42 @@ namespace NOU::NOU_THREAD
 
 		return ret;
 	}
-}
\ No newline at end of file
+
+	const ThreadManagerConfiguration& ThreadManager::getConfiguration() const
+	{
+		return m_configuration;
+	}
+
+	SchedulerStatistics ThreadManager::getStatistics() const
+	{
+		SchedulerStatistics ret;
+
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+		ret.enabled = true;
+		ret.heapHighWaterMark = m_instrumentation->m_heapHighWaterMark.load(std::memory_order_relaxed);
+
+		for (sizeType i = 0; i < m_instrumentation->m_workerCount; i++)
+		{
+			const InstrumentationData::Worker &worker = m_instrumentation->m_workers[i];
+			WorkerStatistics statistics;
+
+			statistics.tasksExecuted = worker.m_tasksExecuted.load(std::memory_order_relaxed);
+			statistics.busyNanos = worker.m_busyNanos.load(std::memory_order_relaxed);
+			statistics.idleNanos = worker.m_idleNanos.load(std::memory_order_relaxed);
+			statistics.steals = worker.m_steals.load(std::memory_order_relaxed);
+
+			for (sizeType j = 0; j < LatencyHistogram::BUCKET_COUNT; j++)
+			{
+				statistics.queueLatency.recordBucket(j, 
+					worker.m_queueLatency[j].load(std::memory_order_relaxed));
+				statistics.executionLatency.recordBucket(j, 
+					worker.m_executionLatency[j].load(std::memory_order_relaxed));
+			}
+
+			ret.workers.pushBack(statistics);
+		}
+#endif
+
+		return ret;
+	}
+}
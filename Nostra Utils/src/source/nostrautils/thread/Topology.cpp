@@ -0,0 +1,317 @@
+#include "nostrautils/thread/Topology.hpp"
+#include "nostrautils/core/Utils.hpp"
+#include "nostrautils/dat_alg/Vector.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if NOU_OS == NOU_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#elif NOU_OS == NOU_OS_MAC
+#include <pthread.h>
+#elif NOU_OS == NOU_OS_WINDOWS
+#include <Windows.h>
+#endif
+
+namespace NOU::NOU_THREAD
+{
+	constexpr sizeType CpuSet::MAX_CPU_COUNT;
+	constexpr sizeType CpuSet::BITS_PER_WORD;
+
+	CpuSet::CpuSet() :
+		m_bits{}
+	{}
+
+	void CpuSet::set(sizeType cpu)
+	{
+		if (cpu < MAX_CPU_COUNT)
+			m_bits[cpu / BITS_PER_WORD] |= uint64(1) << (cpu % BITS_PER_WORD);
+	}
+
+	void CpuSet::clear(sizeType cpu)
+	{
+		if (cpu < MAX_CPU_COUNT)
+			m_bits[cpu / BITS_PER_WORD] &= ~(uint64(1) << (cpu % BITS_PER_WORD));
+	}
+
+	boolean CpuSet::isSet(sizeType cpu) const
+	{
+		if (cpu >= MAX_CPU_COUNT)
+			return false;
+
+		return (m_bits[cpu / BITS_PER_WORD] & (uint64(1) << (cpu % BITS_PER_WORD))) != 0;
+	}
+
+	sizeType CpuSet::count() const
+	{
+		sizeType ret = 0;
+
+		for (sizeType i = 0; i < MAX_CPU_COUNT; i++)
+		{
+			if (isSet(i))
+				ret++;
+		}
+
+		return ret;
+	}
+
+	sizeType CpuSet::first() const
+	{
+		for (sizeType i = 0; i < MAX_CPU_COUNT; i++)
+		{
+			if (isSet(i))
+				return i;
+		}
+
+		return MAX_CPU_COUNT;
+	}
+
+	namespace Topology
+	{
+		namespace
+		{
+			/**
+			\brief The topology of the system, as it is read by readTopology().
+			*/
+			struct SystemTopology
+			{
+				/**
+				\brief The CPUs, ordered by their node.
+				*/
+				NOU_DAT_ALG::Vector<sizeType> m_cpus;
+
+				/**
+				\brief The CPUs of each node.
+				*/
+				NOU_DAT_ALG::Vector<CpuSet> m_nodes;
+			};
+
+#if NOU_OS == NOU_OS_LINUX
+			/**
+			\param path The path of the file.
+			\param out  The set that the CPUs (or nodes) will be added to.
+
+			\return True, if the file could be read, false if not.
+
+			\brief Reads a list in the format that is used by the files in /sys (e.g. "0-3,8,10-11").
+			*/
+			boolean readList(const char *path, CpuSet &out)
+			{
+				FILE *file = std::fopen(path, "r");
+
+				if (file == nullptr)
+					return false;
+
+				char buffer[4096];
+				boolean success = std::fgets(buffer, sizeof(buffer), file) != nullptr;
+
+				std::fclose(file);
+
+				if (!success)
+					return false;
+
+				const char *current = buffer;
+
+				while (*current >= '0' && *current <= '9')
+				{
+					char *end;
+					sizeType first = std::strtoul(current, &end, 10);
+					sizeType last = first;
+
+					if (*end == '-')
+						last = std::strtoul(end + 1, &end, 10);
+
+					for (sizeType i = first; i <= last && i < CpuSet::MAX_CPU_COUNT; i++)
+						out.set(i);
+
+					current = *end == ',' ? end + 1 : end;
+				}
+
+				return true;
+			}
+#endif
+
+			/**
+			\return The CPUs that the process may run on.
+			*/
+			CpuSet allowedCpus()
+			{
+				CpuSet ret;
+
+#if NOU_OS == NOU_OS_LINUX
+				cpu_set_t set;
+
+				if (sched_getaffinity(0, sizeof(set), &set) == 0)
+				{
+					for (sizeType i = 0; i < CpuSet::MAX_CPU_COUNT && i < CPU_SETSIZE; i++)
+					{
+						if (CPU_ISSET(i, &set))
+							ret.set(i);
+					}
+
+					return ret;
+				}
+#endif
+
+				sizeType count = std::thread::hardware_concurrency();
+
+				for (sizeType i = 0; i < NOU_CORE::max<sizeType>(count, 1); i++)
+					ret.set(i);
+
+				return ret;
+			}
+
+			/**
+			\return The topology of the system.
+			*/
+			SystemTopology readTopology()
+			{
+				SystemTopology ret;
+				CpuSet allowed = allowedCpus();
+
+#if NOU_OS == NOU_OS_LINUX
+				CpuSet onlineNodes;
+
+				if (readList("/sys/devices/system/node/online", onlineNodes))
+				{
+					for (sizeType node = 0; node < CpuSet::MAX_CPU_COUNT; node++)
+					{
+						if (!onlineNodes.isSet(node))
+							continue;
+
+						char path[64];
+						std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%zu/cpulist",
+							static_cast<size_t>(node));
+
+						CpuSet cpus;
+
+						if (!readList(path, cpus))
+							continue;
+
+						CpuSet usable;
+
+						for (sizeType i = 0; i < CpuSet::MAX_CPU_COUNT; i++)
+						{
+							if (cpus.isSet(i) && allowed.isSet(i))
+							{
+								usable.set(i);
+								ret.m_cpus.pushBack(i);
+							}
+						}
+
+						//nodes without usable CPUs (e.g. memory-only nodes) are skipped
+						if (usable.count() > 0)
+							ret.m_nodes.pushBack(usable);
+					}
+				}
+#endif
+
+				//no (usable) NUMA information, treat the system as a single node
+				if (ret.m_nodes.size() == 0)
+				{
+					ret.m_cpus.clear();
+
+					for (sizeType i = 0; i < CpuSet::MAX_CPU_COUNT; i++)
+					{
+						if (allowed.isSet(i))
+							ret.m_cpus.pushBack(i);
+					}
+
+					ret.m_nodes.pushBack(allowed);
+				}
+
+				return ret;
+			}
+
+			/**
+			\return The topology of the system. It is only read once.
+			*/
+			const SystemTopology& systemTopology()
+			{
+				static SystemTopology topology = readTopology();
+				return topology;
+			}
+		}
+
+		sizeType cpuCount()
+		{
+			return systemTopology().m_cpus.size();
+		}
+
+		sizeType cpuAt(sizeType index)
+		{
+			return systemTopology().m_cpus[index];
+		}
+
+		sizeType numaNodeCount()
+		{
+			return systemTopology().m_nodes.size();
+		}
+
+		const CpuSet& numaNodeCpus(sizeType node)
+		{
+			return systemTopology().m_nodes[node];
+		}
+
+		sizeType numaNodeOf(sizeType cpu)
+		{
+			const SystemTopology &topology = systemTopology();
+
+			for (sizeType i = 0; i < topology.m_nodes.size(); i++)
+			{
+				if (topology.m_nodes[i].isSet(cpu))
+					return i;
+			}
+
+			return 0;
+		}
+
+		boolean setCurrentThreadAffinity(const CpuSet &cpus)
+		{
+#if NOU_OS == NOU_OS_LINUX
+			cpu_set_t set;
+			CPU_ZERO(&set);
+
+			for (sizeType i = 0; i < CpuSet::MAX_CPU_COUNT && i < CPU_SETSIZE; i++)
+			{
+				if (cpus.isSet(i))
+					CPU_SET(i, &set);
+			}
+
+			return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif NOU_OS == NOU_OS_WINDOWS
+			//only the first processor group is supported
+			DWORD_PTR mask = 0;
+
+			for (sizeType i = 0; i < sizeof(DWORD_PTR) * 8; i++)
+			{
+				if (cpus.isSet(i))
+					mask |= DWORD_PTR(1) << i;
+			}
+
+			return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+			return false;
+#endif
+		}
+
+		boolean setCurrentThreadName(const char *name)
+		{
+#if NOU_OS == NOU_OS_LINUX
+			//the kernel rejects names that are longer than 15 characters
+			char truncated[16];
+			std::strncpy(truncated, name, sizeof(truncated) - 1);
+			truncated[sizeof(truncated) - 1] = '\0';
+
+			return pthread_setname_np(pthread_self(), truncated) == 0;
+#elif NOU_OS == NOU_OS_MAC
+			return pthread_setname_np(name) == 0;
+#else
+			return false;
+#endif
+		}
+	}
+}
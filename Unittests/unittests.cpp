@@ -574,6 +574,162 @@ TEST_METHOD(UniquePtr)
 	NOU_CHECK_ERROR_HANDLER;
 }
 
+struct SharedPtrTestDerived : public NOU::DebugClass
+{
+	NOU::int32 m_extra;
+
+	explicit SharedPtrTestDerived(NOU::int32 value, NOU::int32 extra) :
+		DebugClass(value),
+		m_extra(extra)
+	{}
+};
+
+NOU::sizeType intrusiveDestroyed = 0;
+
+struct IntrusivePtrTestClass : public NOU::NOU_MEM_MNGT::RefCounted<NOU::NOU_MEM_MNGT::PlainRefCount>
+{
+	NOU::int32 m_value;
+
+	explicit IntrusivePtrTestClass(NOU::int32 value) :
+		m_value(value)
+	{}
+
+	~IntrusivePtrTestClass()
+	{
+		intrusiveDestroyed++;
+	}
+};
+
+TEST_METHOD(SharedPtr)
+{
+	NOU::NOU_MEM_MNGT::AllocationProfiler profiler;
+	NOU::NOU_MEM_MNGT::ProfilingAllocationCallback<NOU::DebugClass> callback(profiler);
+
+	{
+		NOU::NOU_MEM_MNGT::SharedPtr<NOU::DebugClass> ptr = 
+			NOU::NOU_MEM_MNGT::allocateShared<NOU::DebugClass>(callback, 5);
+
+		IsTrue(ptr);
+		IsTrue(ptr->get() == 5);
+		IsTrue((*ptr).get() == 5);
+		IsTrue(ptr.useCount() == 1);
+		IsTrue(NOU::DebugClass::getCounter() == 1);
+
+		//the object and the counts are allocated at once
+		IsTrue(profiler.getProfile().allocations == 1);
+
+		NOU::NOU_MEM_MNGT::SharedPtr<NOU::DebugClass> copy = ptr;
+
+		IsTrue(copy == ptr);
+		IsTrue(ptr.useCount() == 2);
+
+		NOU::NOU_MEM_MNGT::SharedPtr<NOU::DebugClass> moved = std::move(copy);
+
+		IsTrue(!copy);
+		IsTrue(moved.rawPtr() == ptr.rawPtr());
+		IsTrue(ptr.useCount() == 2);
+
+		moved = moved;
+
+		IsTrue(ptr.useCount() == 2);
+
+		NOU::NOU_MEM_MNGT::WeakPtr<NOU::DebugClass> weak = ptr;
+
+		IsTrue(!weak.expired());
+		IsTrue(weak.lock() == ptr);
+		IsTrue(weak.useCount() == 2);
+
+		moved.reset();
+		ptr = nullptr;
+
+		//the object has been destroyed, but the weak pointer keeps the memory alive
+		IsTrue(NOU::DebugClass::getCounter() == 0);
+		IsTrue(weak.expired());
+		IsTrue(!weak.lock());
+		IsTrue(profiler.getProfile().liveBytes > 0);
+	}
+
+	NOU::NOU_MEM_MNGT::AllocationProfiler::Profile profile = profiler.getProfile();
+
+	IsTrue(profile.deallocations == profile.allocations);
+	IsTrue(profile.liveBytes == 0);
+
+	//conversion to a base class, the object is still destroyed as the derived class
+	{
+		NOU::NOU_MEM_MNGT::SharedPtr<SharedPtrTestDerived, NOU::NOU_MEM_MNGT::PlainRefCount> derived =
+			NOU::NOU_MEM_MNGT::makeShared<SharedPtrTestDerived, NOU::NOU_MEM_MNGT::PlainRefCount>(1, 2);
+
+		NOU::NOU_MEM_MNGT::SharedPtr<NOU::DebugClass, NOU::NOU_MEM_MNGT::PlainRefCount> base = derived;
+
+		IsTrue(base.rawPtr() == derived.rawPtr());
+		IsTrue(base.useCount() == 2);
+
+		derived.reset();
+
+		IsTrue(base->get() == 1);
+		IsTrue(NOU::DebugClass::getCounter() == 1);
+	}
+
+	IsTrue(NOU::DebugClass::getCounter() == 0);
+
+	//multiple threads copy and destroy pointers to the same object
+	{
+		NOU::NOU_MEM_MNGT::SharedPtr<NOU::DebugClass> shared = NOU::NOU_MEM_MNGT::makeShared<NOU::DebugClass>(3);
+		NOU::NOU_MEM_MNGT::WeakPtr<NOU::DebugClass> weak = shared;
+
+		std::atomic<NOU::sizeType> sum(0);
+
+		NOU::NOU_THREAD::parallelFor(0, 10000, 64, [&shared, &weak, &sum](NOU::sizeType)
+		{
+			NOU::NOU_MEM_MNGT::SharedPtr<NOU::DebugClass> copy = shared;
+			NOU::NOU_MEM_MNGT::SharedPtr<NOU::DebugClass> locked = weak.lock();
+
+			sum.fetch_add(static_cast<NOU::sizeType>(copy->get() + locked->get()), std::memory_order_relaxed);
+		});
+
+		IsTrue(sum.load() == 60000);
+		IsTrue(shared.useCount() == 1);
+	}
+
+	IsTrue(NOU::DebugClass::getCounter() == 0);
+
+	//intrusive counts
+	{
+		IntrusivePtrTestClass *raw = new IntrusivePtrTestClass(7);
+
+		NOU::NOU_MEM_MNGT::IntrusivePtr<IntrusivePtrTestClass> ptr(raw);
+
+		IsTrue(raw->referenceCount() == 1);
+
+		{
+			NOU::NOU_MEM_MNGT::IntrusivePtr<IntrusivePtrTestClass> copy = ptr;
+			NOU::NOU_MEM_MNGT::IntrusivePtr<IntrusivePtrTestClass> fromRaw(raw);
+
+			IsTrue(copy == ptr);
+			IsTrue(fromRaw->m_value == 7);
+			IsTrue(raw->referenceCount() == 3);
+		}
+
+		IsTrue(raw->referenceCount() == 1);
+
+		//copying the object does not copy the count
+		IntrusivePtrTestClass copiedObject = *raw;
+
+		IsTrue(copiedObject.referenceCount() == 0);
+
+		ptr = ptr;
+
+		IsTrue(intrusiveDestroyed == 0);
+
+		ptr.reset();
+
+		IsTrue(intrusiveDestroyed == 1);
+		IsTrue(!ptr);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
 TEST_METHOD(FastQueue)
 {
 	while (NOU::NOU_CORE::getErrorHandler().getErrorCount() != 0)
@@ -641,6 +797,171 @@ TEST_METHOD(FastQueue)
 	NOU_CHECK_ERROR_HANDLER;
 }
 
+TEST_METHOD(ConcurrentQueue)
+{
+	{
+		NOU::NOU_DAT_ALG::ConcurrentQueue<NOU::DebugClass, NOU::NOU_DAT_ALG::ConcurrentQueueMode::MPMC,
+			NOU::NOU_MEM_MNGT::DebugAllocationCallback> mpmc(5);
+
+		IsTrue(mpmc.capacity() == 8);
+		IsTrue(mpmc.empty());
+
+		for (NOU::int32 i = 0; i < 8; i++)
+			IsTrue(mpmc.tryPush(NOU::DebugClass(i)));
+
+		IsTrue(!mpmc.tryPush(NOU::DebugClass(8)));
+		IsTrue(mpmc.size() == 8);
+
+		for (NOU::int32 i = 0; i < 4; i++)
+			IsTrue(mpmc.pop().get() == i);
+
+		mpmc.push(NOU::DebugClass(8));
+
+		NOU::DebugClass out;
+		IsTrue(mpmc.tryPop(out));
+		IsTrue(mpmc.size() == 4);
+
+		IsTrue(mpmc.getAllocator().getCounter() == 1);
+
+		//4 elements remain in the queue, the destructor has to destruct them
+	}
+
+	IsTrue(NOU::DebugClass::getCounter() == 0);
+
+	{
+		NOU::NOU_DAT_ALG::ConcurrentQueue<NOU::DebugClass, NOU::NOU_DAT_ALG::ConcurrentQueueMode::SPSC> 
+			spsc(4);
+
+		IsTrue(spsc.capacity() == 4);
+
+		for (NOU::int32 i = 0; i < 4; i++)
+			IsTrue(spsc.tryPush(NOU::DebugClass(i)));
+
+		IsTrue(!spsc.tryPush(NOU::DebugClass(4)));
+		IsTrue(spsc.peek().get() == 0);
+		IsTrue(spsc.pop().get() == 0);
+		IsTrue(spsc.peekFront().get() == 1);
+		IsTrue(spsc.size() == 3);
+	}
+
+	IsTrue(NOU::DebugClass::getCounter() == 0);
+
+	//4 producers and 4 consumers, every element must be popped exactly once
+	{
+		const NOU::int64 elementsPerProducer = 5000;
+		const NOU::sizeType threadCount = 4;
+
+		NOU::NOU_DAT_ALG::ConcurrentQueue<NOU::int64> queue(64);
+		std::atomic<NOU::int64> sum(0);
+		std::atomic<NOU::int64> popped(0);
+
+		NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> threads;
+
+		for (NOU::sizeType i = 0; i < threadCount; i++)
+		{
+			threads.pushBack(NOU::NOU_THREAD::ThreadWrapper([&queue, elementsPerProducer]()
+			{
+				for (NOU::int64 j = 1; j <= elementsPerProducer; j++)
+					queue.push(j);
+			}));
+
+			threads.pushBack(NOU::NOU_THREAD::ThreadWrapper([&queue, &sum, &popped, elementsPerProducer]()
+			{
+				for (NOU::int64 j = 0; j < elementsPerProducer; j++)
+				{
+					sum += queue.pop();
+					popped++;
+				}
+			}));
+		}
+
+		for (NOU::sizeType i = 0; i < threads.size(); i++)
+			threads[i].join();
+
+		IsTrue(popped == elementsPerProducer * threadCount);
+		IsTrue(sum == threadCount * elementsPerProducer * (elementsPerProducer + 1) / 2);
+		IsTrue(queue.empty());
+	}
+
+	//SPSC must preserve the order
+	{
+		const NOU::int64 elementCount = 20000;
+
+		NOU::NOU_DAT_ALG::ConcurrentQueue<NOU::int64, NOU::NOU_DAT_ALG::ConcurrentQueueMode::SPSC> queue(16);
+		NOU::boolean inOrder = true;
+
+		NOU::NOU_THREAD::ThreadWrapper consumer([&queue, &inOrder, elementCount]()
+		{
+			for (NOU::int64 i = 0; i < elementCount; i++)
+			{
+				if (queue.pop() != i)
+					inOrder = false;
+			}
+		});
+
+		for (NOU::int64 i = 0; i < elementCount; i++)
+			queue.push(i);
+
+		consumer.join();
+
+		IsTrue(inOrder);
+		IsTrue(queue.empty());
+	}
+
+	{
+		//the buffers can not be allocated without a current arena
+		NOU::NOU_CORE::ErrorHandler &handler = NOU::NOU_CORE::getErrorHandler();
+
+		auto popErrors = [&handler](NOU::sizeType count, NOU::NOU_CORE::ErrorHandler::ErrorType id)
+		{
+			NOU::boolean correct = handler.getErrorCount() == count;
+
+			while (handler.getErrorCount() > 0)
+				correct = handler.popError().getID() == id && correct;
+
+			return correct;
+		};
+
+		NOU::NOU_DAT_ALG::ConcurrentQueue<NOU::int64, NOU::NOU_DAT_ALG::ConcurrentQueueMode::MPMC,
+			NOU::NOU_MEM_MNGT::ArenaAllocationCallback> mpmc(8);
+
+		IsTrue(popErrors(2, NOU::NOU_CORE::ErrorCodes::BAD_ALLOCATION));
+		IsTrue(mpmc.capacity() == 0);
+
+		NOU::int64 value;
+
+		IsTrue(!mpmc.tryPush(1));
+		IsTrue(!mpmc.tryPop(value));
+
+		//the blocking operations must not wait forever
+		mpmc.push(1);
+		IsTrue(popErrors(1, NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT));
+
+		mpmc.pop();
+		IsTrue(popErrors(1, NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT));
+
+		NOU::NOU_DAT_ALG::ConcurrentQueue<NOU::int64, NOU::NOU_DAT_ALG::ConcurrentQueueMode::SPSC,
+			NOU::NOU_MEM_MNGT::ArenaAllocationCallback> spsc(8);
+
+		IsTrue(popErrors(2, NOU::NOU_CORE::ErrorCodes::BAD_ALLOCATION));
+		IsTrue(spsc.capacity() == 0);
+
+		IsTrue(!spsc.tryPush(1));
+		IsTrue(!spsc.tryPop(value));
+
+		spsc.push(1);
+		IsTrue(popErrors(1, NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT));
+
+		spsc.pop();
+		IsTrue(popErrors(1, NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT));
+
+		spsc.peekFront();
+		IsTrue(popErrors(1, NOU::NOU_CORE::ErrorCodes::INDEX_OUT_OF_BOUNDS));
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
 TEST_METHOD(AreSame)
 {
 	IsTrue(NOU::NOU_CORE::AreSame<int, int>::value);
@@ -657,6 +978,19 @@ TEST_METHOD(AreSame)
 	NOU_CHECK_ERROR_HANDLER;
 }
 
+TEST_METHOD(Bits)
+{
+	IsTrue(NOU::NOU_CORE::countTrailingZeros(1) == 0);
+	IsTrue(NOU::NOU_CORE::countTrailingZeros(0x50) == 4);
+	IsTrue(NOU::NOU_CORE::countTrailingZeros(NOU::uint64(1) << 63) == 63);
+
+	IsTrue(NOU::NOU_CORE::countLeadingZeros(1) == 63);
+	IsTrue(NOU::NOU_CORE::countLeadingZeros(0x50) == 57);
+	IsTrue(NOU::NOU_CORE::countLeadingZeros(NOU::uint64(1) << 63) == 0);
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
 #ifdef NOU_EXISTS_FEATURE_IS_INVOCABLE_R
 TEST_METHOD(IsInvocable)
 {
@@ -702,139 +1036,479 @@ TEST_METHOD(AllocationCallbackDeleter)
 	NOU_CHECK_ERROR_HANDLER;
 }
 
-TEST_METHOD(StringView)
+TEST_METHOD(AllocationProfiler)
 {
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isCharacter('A'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isCharacter('Z'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isCharacter('a'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isCharacter('z'));
+	NOU::NOU_MEM_MNGT::AllocationProfiler profiler;
 
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isCharacter(' '));
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isCharacter('3'));
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isCharacter('%'));
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isCharacter('-'));
+	{
+		NOU_ALLOCATION_SITE("test vector");
 
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('1'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('2'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('3'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('4'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('5'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('6'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('7'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('8'));
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('9'));
+		NOU::NOU_DAT_ALG::Vector<NOU::int64, NOU::NOU_MEM_MNGT::ProfilingAllocationCallback> vec(1,
+			NOU::NOU_MEM_MNGT::ProfilingAllocationCallback<NOU::int64>(profiler));
 
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isDigit(' '));
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isDigit('A'));
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isDigit('%'));
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isDigit('-'));
+		for (NOU::int64 i = 0; i < 1000; i++)
+			vec.pushBack(i);
 
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::stringToBoolean("true"));
+		NOU::boolean correct = true;
 
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::stringToBoolean("false"));
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::stringToBoolean("abcde"));
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::stringToBoolean("12345"));
-	IsTrue(!NOU::NOU_DAT_ALG::StringView8::stringToBoolean("!?$%&"));
+		for (NOU::sizeType i = 0; i < vec.size(); i++)
+			correct = correct && vec[i] == static_cast<NOU::int64>(i);
 
-	NOU::NOU_DAT_ALG::StringView8 sv = "Hello World!";
+		IsTrue(correct);
+	}
 
-	IsTrue(sv[0] == 'H');
-	IsTrue(sv[1] == 'e');
-	IsTrue(sv[2] == 'l');
-	IsTrue(sv[3] == 'l');
-	IsTrue(sv[4] == 'o');
-	IsTrue(sv[5] == ' ');
-	IsTrue(sv[6] == 'W');
-	IsTrue(sv[7] == 'o');
-	IsTrue(sv[8] == 'r');
-	IsTrue(sv[9] == 'l');
-	IsTrue(sv[10] == 'd');
-	IsTrue(sv[11] == '!');
+	NOU::NOU_MEM_MNGT::AllocationProfiler::Profile profile = profiler.getProfile();
 
-	IsTrue(sv.size() == 12);
+	//the vector grew multiple times, all of its memory has been freed
+	IsTrue(profile.allocations > 1);
+	IsTrue(profile.deallocations == profile.allocations);
+	IsTrue(profile.liveBytes == 0);
+	IsTrue(profile.peakLiveBytes >= 1000 * static_cast<NOU::int64>(sizeof(NOU::int64)));
+	IsTrue(profile.sizes.totalCount() == profile.allocations);
+	IsTrue(profile.lifetimes.totalCount() == profile.deallocations);
 
-	IsTrue(*sv.indexIterator(0) == 'H');
-	IsTrue(*sv.indexIterator(1) == 'e');
-	IsTrue(*sv.indexIterator(2) == 'l');
-	IsTrue(*sv.indexIterator(3) == 'l');
-	IsTrue(*sv.indexIterator(4) == 'o');
-	IsTrue(*sv.indexIterator(5) == ' ');
-	IsTrue(*sv.indexIterator(6) == 'W');
-	IsTrue(*sv.indexIterator(7) == 'o');
-	IsTrue(*sv.indexIterator(8) == 'r');
-	IsTrue(*sv.indexIterator(9) == 'l');
-	IsTrue(*sv.indexIterator(10) == 'd');
-	IsTrue(*sv.indexIterator(11) == '!');
+	IsTrue(profile.types.size() == 1);
+	IsTrue(profile.types[0].type == &NOU::NOU_MEM_MNGT::allocationTypeInfo<NOU::int64>());
+	IsTrue(profile.types[0].allocations == profile.allocations);
+	IsTrue(profile.types[0].liveBytes == 0);
+	IsTrue(profile.types[0].peakLiveBytes == profile.peakLiveBytes);
 
-	IsTrue(sv == "Hello World!");
+	NOU::boolean labeled = profile.sites.size() > 0;
 
-	IsTrue(sv.find('e') == 1);
-	IsTrue(sv.find('e', 1) == 1);
+	for (NOU::sizeType i = 0; i < profile.sites.size(); i++)
+	{
+		labeled = labeled && profile.sites[i].label != nullptr && 
+			NOU::NOU_DAT_ALG::StringView8(profile.sites[i].label) == "test vector";
+		labeled = labeled && profile.sites[i].stackDepth > 0;
+	}
 
-	IsTrue(sv.find('o') == 4);
-	IsTrue(sv.find('o', 5) == 7);
-	IsTrue(sv.find('z') == NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+	IsTrue(labeled);
 
-	IsTrue(sv.find("ello") == 1);
-	IsTrue(sv.find("o") == 4);
-	IsTrue(sv.find("o", 5) == 7);
-	IsTrue(sv.find("test") == NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+	//the alignment of the type is preserved, even though there is a header in front of the memory
+	{
+		struct alignas(64) Aligned
+		{
+			NOU::byte data[64];
+		};
 
-	IsTrue(sv.firstIndexOf('H') == 0);
-	IsTrue(sv.firstIndexOf('o') == 4);
-	IsTrue(sv.firstIndexOf('z') == NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+		NOU::NOU_MEM_MNGT::ProfilingAllocationCallback<Aligned> callback(profiler);
 
-	IsTrue(sv.lastIndexOf('H') == 0);
-	IsTrue(sv.lastIndexOf('o') == 7);
-	IsTrue(sv.lastIndexOf('z') == NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+		Aligned *aligned = callback.allocate(3);
 
-	IsTrue(sv.firstIndexOfNot('H') == 1);
-	IsTrue(sv.firstIndexOfNot('o') == 0);
-	IsTrue(sv.firstIndexOfNot('z') == 0);
+		IsTrue(reinterpret_cast<NOU::sizeType>(aligned) % 64 == 0);
+		IsTrue(profiler.getProfile().liveBytes == 3 * 64);
 
-	IsTrue(sv.lastIndexOfNot('H') == 11);
-	IsTrue(sv.lastIndexOfNot('o') == 11);
-	IsTrue(sv.lastIndexOfNot('z') == 11);
+		callback.deallocate(aligned);
 
-	IsTrue(sv.startsWith('H'));
-	IsTrue(!sv.startsWith('g'));
+		IsTrue(profiler.getProfile().liveBytes == 0);
+	}
 
-	IsTrue(sv.startsWith("Hell"));
-	IsTrue(!sv.startsWith("World"));
+	//multiple threads, more events than fit into the buffer of a single thread
+	{
+		const NOU::sizeType COUNT = 20000;
 
-	IsTrue(sv.endsWith("rld!") == true);
-	IsTrue(!sv.endsWith("World") == true);
+		NOU::uint64 before = profiler.getProfile().allocations;
 
-	IsTrue((sv.compareTo("Abc") > 0));
-	IsTrue((sv.compareTo("Hello World!") == 0));
-	IsTrue((sv.compareTo("Xyz") < 0));
+		NOU::NOU_THREAD::parallelFor(0, COUNT, 256, [&profiler](NOU::sizeType i)
+		{
+			NOU::NOU_MEM_MNGT::ProfilingAllocationCallback<NOU::int32> callback(profiler);
 
-	NOU::NOU_DAT_ALG::StringView8 subStr = sv.logicalSubstring(6);
+			NOU::int32 *value = callback.allocate();
+			*value = static_cast<NOU::int32>(i);
+			callback.deallocate(value);
+		});
 
-	IsTrue(subStr.size() == 6);
+		profile = profiler.getProfile();
 
-	IsTrue(subStr[0] == 'W');
-	IsTrue(subStr[1] == 'o');
-	IsTrue(subStr[2] == 'r');
-	IsTrue(subStr[3] == 'l');
-	IsTrue(subStr[4] == 'd');
-	IsTrue(subStr[5] == '!');
+		IsTrue(profile.allocations == before + COUNT);
+		IsTrue(profile.deallocations == profile.allocations);
+		IsTrue(profile.liveBytes == 0);
+	}
 
-	IsTrue(sv == "Hello World!");
-	IsTrue(sv != "Hello z World!");
-	IsTrue(sv < "xyz");
-	IsTrue((sv > "abc"));
+	NOU::NOU_DAT_ALG::String8 report = profile.flatReport();
 
-	NOU::NOU_DAT_ALG::StringView8 sv1 = "Hello World!";
-	NOU::NOU_DAT_ALG::StringView8 sv2 = "Bye World!";
+	IsTrue(report.find("test vector") != NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
 
-	sv1 = sv2;
+	NOU::NOU_DAT_ALG::String8 heapProfile = profile.heapProfile();
 
-	IsTrue(sv1 == sv2);
+	IsTrue(heapProfile.startsWith("heap profile: "));
+	IsTrue(heapProfile.find("] @ 0x") != NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+	IsTrue(heapProfile.find("MAPPED_LIBRARIES:") != NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
 
+	//without a stack, the sites are only identified by their labels
+	{
+		NOU::NOU_MEM_MNGT::AllocationProfiler labelsOnly(0);
+		NOU::NOU_MEM_MNGT::ProfilingAllocationCallback<NOU::int32> callback(labelsOnly);
 
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::stringToUint32("123") == 123);
-	IsTrue(NOU::NOU_DAT_ALG::StringView8::stringToUint32("9999999") == 9999999);
+		callback.deallocate(callback.allocate(4));
+		callback.deallocate(callback.allocate(8));
+
+		NOU::NOU_MEM_MNGT::AllocationProfiler::Profile labelProfile = labelsOnly.getProfile();
+
+		IsTrue(labelProfile.sites.size() == 1);
+		IsTrue(labelProfile.sites[0].stackDepth == 0);
+		IsTrue(labelProfile.sites[0].label == nullptr);
+		IsTrue(labelProfile.sites[0].allocatedBytes == 12 * sizeof(NOU::int32));
+		IsTrue(labelProfile.heapProfile().find("] @ 0x") == NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+std::atomic<NOU::int64> reclamationLiveNodes(0);
+
+struct ReclamationTestNode
+{
+	constexpr static NOU::uint64 ALIVE = 0x0123456789ABCDEF;
+
+	std::atomic<NOU::uint64> m_magic;
+	ReclamationTestNode *m_next;
+	NOU::sizeType m_value;
+
+	explicit ReclamationTestNode(NOU::sizeType value) :
+		m_magic(ALIVE),
+		m_next(nullptr),
+		m_value(value)
+	{
+		reclamationLiveNodes++;
+	}
+
+	~ReclamationTestNode()
+	{
+		m_magic.store(0);
+		reclamationLiveNodes--;
+	}
+};
+
+TEST_METHOD(Reclamation)
+{
+	using Node = ReclamationTestNode;
+
+	NOU::NOU_MEM_MNGT::GenericAllocationCallback<Node> callback;
+
+	//objects are reclaimed two epochs after they were retired, not while the thread is in a critical section
+	{
+		NOU::NOU_MEM_MNGT::EpochReclaimer reclaimer(1000);
+
+		for (NOU::sizeType i = 0; i < 10; i++)
+			reclaimer.retire(new (callback.allocate()) Node(i));
+
+		IsTrue(reclaimer.retiredCount() == 10);
+
+		reclaimer.collect();
+
+		IsTrue(reclaimer.getEpoch() == 1);
+		IsTrue(reclaimer.retiredCount() == 10);
+
+		reclaimer.collect();
+
+		IsTrue(reclaimer.getEpoch() == 2);
+		IsTrue(reclaimer.retiredCount() == 0);
+		IsTrue(reclamationLiveNodes == 0);
+
+		{
+			NOU::NOU_MEM_MNGT::EpochReclaimer::Guard guard(reclaimer);
+			NOU::NOU_MEM_MNGT::EpochReclaimer::Guard nested(reclaimer);
+
+			reclaimer.retire(new (callback.allocate()) Node(0));
+
+			for (NOU::sizeType i = 0; i < 5; i++)
+				reclaimer.collect();
+
+			//the epoch can only advance once while this thread is in the critical section
+			IsTrue(reclaimer.getEpoch() == 3);
+			IsTrue(reclaimer.retiredCount() == 1);
+		}
+
+		reclaimer.collect();
+		reclaimer.collect();
+
+		IsTrue(reclaimer.retiredCount() == 0);
+		IsTrue(reclamationLiveNodes == 0);
+
+		//the callback that is stored with the object is used for the deallocation
+		NOU::NOU_MEM_MNGT::AllocationProfiler profiler;
+		NOU::NOU_MEM_MNGT::ProfilingAllocationCallback<Node> profilingCallback(profiler);
+
+		reclaimer.retire(new (profilingCallback.allocate()) Node(0), profilingCallback);
+
+		IsTrue(profiler.getProfile().liveBytes == sizeof(Node));
+
+		reclaimer.collect();
+		reclaimer.collect();
+
+		IsTrue(profiler.getProfile().liveBytes == 0);
+
+		//destroying the reclaimer reclaims everything
+		reclaimer.retire(new (callback.allocate()) Node(0));
+	}
+
+	IsTrue(reclamationLiveNodes == 0);
+
+	//protected objects are not reclaimed
+	{
+		NOU::NOU_MEM_MNGT::HazardPointerDomain domain(1000);
+
+		std::atomic<Node*> source(new (callback.allocate()) Node(1));
+
+		{
+			NOU::NOU_MEM_MNGT::HazardPointerDomain::HazardPointer hazard(domain);
+
+			Node *node = hazard.protect(source);
+
+			IsTrue(node->m_value == 1);
+
+			source.store(nullptr);
+			domain.retire(node);
+			domain.collect();
+
+			IsTrue(domain.retiredCount() == 1);
+			IsTrue(node->m_magic.load() == Node::ALIVE);
+
+			hazard.reset();
+			domain.collect();
+
+			IsTrue(domain.retiredCount() == 0);
+			IsTrue(reclamationLiveNodes == 0);
+		}
+
+		NOU::NOU_DAT_ALG::Vector<NOU::NOU_MEM_MNGT::HazardPointerDomain::HazardPointer*> hazards;
+
+		for (NOU::sizeType i = 0; i < NOU::NOU_MEM_MNGT::HazardPointerDomain::HAZARD_POINTER_COUNT; i++)
+			hazards.pushBack(new NOU::NOU_MEM_MNGT::HazardPointerDomain::HazardPointer(domain));
+
+		NOU::NOU_MEM_MNGT::HazardPointerDomain::HazardPointer exhausted(domain);
+
+		IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() == NOU::NOU_CORE::ErrorCodes::INVALID_STATE);
+
+		for (NOU::sizeType i = 0; i < hazards.size(); i++)
+			delete hazards[i];
+	}
+
+	//Treiber stacks that are used by the workers of the ThreadManager
+	{
+		const NOU::sizeType COUNT = 20000;
+
+		std::atomic<Node*> head(nullptr);
+		std::atomic<NOU::sizeType> errors(0);
+		std::atomic<NOU::sizeType> popped(0);
+
+		{
+			NOU::NOU_MEM_MNGT::EpochReclaimer reclaimer(16);
+
+			NOU::NOU_THREAD::parallelFor(0, COUNT, 64, [&](NOU::sizeType i)
+			{
+				NOU::NOU_MEM_MNGT::EpochReclaimer::Guard guard(reclaimer);
+
+				Node *node = new (callback.allocate()) Node(i);
+				node->m_next = head.load();
+
+				while (!head.compare_exchange_weak(node->m_next, node));
+
+				Node *top = head.load();
+
+				while (top != nullptr && !head.compare_exchange_weak(top, top->m_next));
+
+				if (top != nullptr)
+				{
+					if (top->m_magic.load() != Node::ALIVE)
+						errors++;
+
+					popped++;
+					reclaimer.retire(top);
+				}
+			});
+
+			IsTrue(errors == 0);
+			IsTrue(popped == COUNT);
+			IsTrue(head.load() == nullptr);
+		}
+
+		IsTrue(reclamationLiveNodes == 0);
+
+		popped = 0;
+
+		{
+			NOU::NOU_MEM_MNGT::HazardPointerDomain domain(16);
+
+			NOU::NOU_THREAD::parallelFor(0, COUNT, 64, [&](NOU::sizeType i)
+			{
+				Node *node = new (callback.allocate()) Node(i);
+				node->m_next = head.load();
+
+				while (!head.compare_exchange_weak(node->m_next, node));
+
+				NOU::NOU_MEM_MNGT::HazardPointerDomain::HazardPointer hazard(domain);
+
+				while (true)
+				{
+					Node *top = hazard.protect(head);
+
+					if (top == nullptr)
+						break;
+
+					if (top->m_magic.load() != Node::ALIVE)
+						errors++;
+
+					if (head.compare_exchange_weak(top, top->m_next))
+					{
+						popped++;
+
+						hazard.reset();
+						domain.retire(top);
+
+						break;
+					}
+				}
+			});
+
+			IsTrue(errors == 0);
+			IsTrue(popped == COUNT);
+			IsTrue(head.load() == nullptr);
+
+			//the amount of unreclaimed objects is bounded
+			IsTrue(domain.retiredCount() <= 1024);
+		}
+
+		IsTrue(reclamationLiveNodes == 0);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(StringView)
+{
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isCharacter('A'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isCharacter('Z'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isCharacter('a'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isCharacter('z'));
+
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isCharacter(' '));
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isCharacter('3'));
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isCharacter('%'));
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isCharacter('-'));
+
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('1'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('2'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('3'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('4'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('5'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('6'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('7'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('8'));
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::isDigit('9'));
+
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isDigit(' '));
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isDigit('A'));
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isDigit('%'));
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::isDigit('-'));
+
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::stringToBoolean("true"));
+
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::stringToBoolean("false"));
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::stringToBoolean("abcde"));
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::stringToBoolean("12345"));
+	IsTrue(!NOU::NOU_DAT_ALG::StringView8::stringToBoolean("!?$%&"));
+
+	NOU::NOU_DAT_ALG::StringView8 sv = "Hello World!";
+
+	IsTrue(sv[0] == 'H');
+	IsTrue(sv[1] == 'e');
+	IsTrue(sv[2] == 'l');
+	IsTrue(sv[3] == 'l');
+	IsTrue(sv[4] == 'o');
+	IsTrue(sv[5] == ' ');
+	IsTrue(sv[6] == 'W');
+	IsTrue(sv[7] == 'o');
+	IsTrue(sv[8] == 'r');
+	IsTrue(sv[9] == 'l');
+	IsTrue(sv[10] == 'd');
+	IsTrue(sv[11] == '!');
+
+	IsTrue(sv.size() == 12);
+
+	IsTrue(*sv.indexIterator(0) == 'H');
+	IsTrue(*sv.indexIterator(1) == 'e');
+	IsTrue(*sv.indexIterator(2) == 'l');
+	IsTrue(*sv.indexIterator(3) == 'l');
+	IsTrue(*sv.indexIterator(4) == 'o');
+	IsTrue(*sv.indexIterator(5) == ' ');
+	IsTrue(*sv.indexIterator(6) == 'W');
+	IsTrue(*sv.indexIterator(7) == 'o');
+	IsTrue(*sv.indexIterator(8) == 'r');
+	IsTrue(*sv.indexIterator(9) == 'l');
+	IsTrue(*sv.indexIterator(10) == 'd');
+	IsTrue(*sv.indexIterator(11) == '!');
+
+	IsTrue(sv == "Hello World!");
+
+	IsTrue(sv.find('e') == 1);
+	IsTrue(sv.find('e', 1) == 1);
+
+	IsTrue(sv.find('o') == 4);
+	IsTrue(sv.find('o', 5) == 7);
+	IsTrue(sv.find('z') == NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+
+	IsTrue(sv.find("ello") == 1);
+	IsTrue(sv.find("o") == 4);
+	IsTrue(sv.find("o", 5) == 7);
+	IsTrue(sv.find("test") == NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+
+	IsTrue(sv.firstIndexOf('H') == 0);
+	IsTrue(sv.firstIndexOf('o') == 4);
+	IsTrue(sv.firstIndexOf('z') == NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+
+	IsTrue(sv.lastIndexOf('H') == 0);
+	IsTrue(sv.lastIndexOf('o') == 7);
+	IsTrue(sv.lastIndexOf('z') == NOU::NOU_DAT_ALG::StringView8::NULL_INDEX);
+
+	IsTrue(sv.firstIndexOfNot('H') == 1);
+	IsTrue(sv.firstIndexOfNot('o') == 0);
+	IsTrue(sv.firstIndexOfNot('z') == 0);
+
+	IsTrue(sv.lastIndexOfNot('H') == 11);
+	IsTrue(sv.lastIndexOfNot('o') == 11);
+	IsTrue(sv.lastIndexOfNot('z') == 11);
+
+	IsTrue(sv.startsWith('H'));
+	IsTrue(!sv.startsWith('g'));
+
+	IsTrue(sv.startsWith("Hell"));
+	IsTrue(!sv.startsWith("World"));
+
+	IsTrue(sv.endsWith("rld!") == true);
+	IsTrue(!sv.endsWith("World") == true);
+
+	IsTrue((sv.compareTo("Abc") > 0));
+	IsTrue((sv.compareTo("Hello World!") == 0));
+	IsTrue((sv.compareTo("Xyz") < 0));
+
+	NOU::NOU_DAT_ALG::StringView8 subStr = sv.logicalSubstring(6);
+
+	IsTrue(subStr.size() == 6);
+
+	IsTrue(subStr[0] == 'W');
+	IsTrue(subStr[1] == 'o');
+	IsTrue(subStr[2] == 'r');
+	IsTrue(subStr[3] == 'l');
+	IsTrue(subStr[4] == 'd');
+	IsTrue(subStr[5] == '!');
+
+	IsTrue(sv == "Hello World!");
+	IsTrue(sv != "Hello z World!");
+	IsTrue(sv < "xyz");
+	IsTrue((sv > "abc"));
+
+	NOU::NOU_DAT_ALG::StringView8 sv1 = "Hello World!";
+	NOU::NOU_DAT_ALG::StringView8 sv2 = "Bye World!";
+
+	sv1 = sv2;
+
+	IsTrue(sv1 == sv2);
+
+
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::stringToUint32("123") == 123);
+	IsTrue(NOU::NOU_DAT_ALG::StringView8::stringToUint32("9999999") == 9999999);
 	IsTrue(NOU::NOU_DAT_ALG::StringView8::stringToUint32("0") == 0);
 
 	IsTrue(NOU::NOU_DAT_ALG::StringView8::stringToInt32("123") == 123);
@@ -1187,38 +1861,183 @@ TEST_METHOD(Random)
 	}
 }
 
-TEST_METHOD(PoolAllocator)
+TEST_METHOD(PageAllocator)
 {
-	NOU::NOU_MEM_MNGT::PoolAllocator<NOU::DebugClass> pa;
+	NOU::sizeType pageSize = NOU::NOU_MEM_MNGT::pageSize();
+	NOU::sizeType hugePageSize = NOU::NOU_MEM_MNGT::hugePageSize();
 
-	NOU::NOU_DAT_ALG::Vector<NOU::DebugClass*> dbgCls;
+	IsTrue(pageSize > 0);
+	IsTrue((pageSize & (pageSize - 1)) == 0);
 
-	NOU::sizeType testValue = 1234;
+	NOU::NOU_MEM_MNGT::HugePageMode modes[] = 
+	{
+		NOU::NOU_MEM_MNGT::HugePageMode::NONE,
+		NOU::NOU_MEM_MNGT::HugePageMode::TRANSPARENT,
+		NOU::NOU_MEM_MNGT::HugePageMode::EXPLICIT
+	};
 
-	const NOU::sizeType ALLOC_SIZE = 4321;
+	//huge pages may not be available, but the allocation must succeed regardless
+	for (NOU::NOU_MEM_MNGT::HugePageMode mode : modes)
+	{
+		for (NOU::boolean prefault : { false, true })
+		{
+			const NOU::sizeType BYTES = 100000;
 
-	IsTrue(NOU::DebugClass::getCounter() == 0);
+			NOU::NOU_MEM_MNGT::PageRegion region = NOU::NOU_MEM_MNGT::pageAlloc(BYTES, 
+				NOU::NOU_MEM_MNGT::PageAllocationOptions(mode, prefault));
 
-	for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
-	{
-		dbgCls.push(pa.allocate(testValue));
-	}
+			IsTrue(region.data != nullptr);
+			IsTrue(region.type != NOU::NOU_MEM_MNGT::PageType::NONE);
+			IsTrue(region.size >= BYTES);
+			IsTrue(region.size % pageSize == 0);
+			IsTrue(reinterpret_cast<NOU::sizeType>(region.data) % pageSize == 0);
 
-	for (NOU::DebugClass* value : dbgCls)
-	{
-		IsTrue(value->get() == testValue);
-	}
+			if (region.type != NOU::NOU_MEM_MNGT::PageType::SMALL)
+			{
+				IsTrue(hugePageSize > 0);
+				IsTrue(reinterpret_cast<NOU::sizeType>(region.data) % hugePageSize == 0);
+			}
 
-	IsTrue(NOU::DebugClass::getCounter() == ALLOC_SIZE);
+			if (mode == NOU::NOU_MEM_MNGT::HugePageMode::NONE)
+				IsTrue(region.type == NOU::NOU_MEM_MNGT::PageType::SMALL);
 
-	for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
-	{
-		pa.deallocate(dbgCls.pop());
-	}
+			IsTrue(region.data[0] == 0);
+			IsTrue(region.data[region.size - 1] == 0);
 
-	IsTrue(NOU::DebugClass::getCounter() == 0);
+			region.data[0] = 1;
+			region.data[region.size - 1] = 2;
 
-	IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 0);
+			IsTrue(region.data[0] == 1);
+			IsTrue(region.data[region.size - 1] == 2);
+
+			NOU::NOU_MEM_MNGT::pageFree(region);
+		}
+	}
+
+	//binding is best effort, node 0 always exists on NUMA systems
+	NOU::NOU_MEM_MNGT::PageRegion bound = NOU::NOU_MEM_MNGT::pageAlloc(pageSize * 4,
+		NOU::NOU_MEM_MNGT::PageAllocationOptions(NOU::NOU_MEM_MNGT::HugePageMode::NONE, true, 0));
+
+	IsTrue(bound.data != nullptr);
+
+	NOU::NOU_MEM_MNGT::pageFree(bound);
+
+	NOU::NOU_MEM_MNGT::PageRegion empty = NOU::NOU_MEM_MNGT::pageAlloc(0);
+
+	IsTrue(empty.data == nullptr);
+	IsTrue(empty.type == NOU::NOU_MEM_MNGT::PageType::NONE);
+
+	NOU::NOU_MEM_MNGT::pageFree(empty);
+
+	//the allocators that can be backed by pages
+	NOU::NOU_MEM_MNGT::PageAllocationOptions smallPages(NOU::NOU_MEM_MNGT::HugePageMode::NONE);
+
+	{
+		NOU::NOU_MEM_MNGT::PoolAllocator<NOU::DebugClass> pa(16, smallPages);
+
+		NOU::NOU_DAT_ALG::Vector<NOU::DebugClass*> objects;
+
+		//more objects than fit into a single page
+		const NOU::sizeType COUNT = pageSize;
+
+		for (NOU::sizeType i = 0; i < COUNT; i++)
+			objects.pushBack(pa.allocate(static_cast<NOU::int32>(i)));
+
+		NOU::boolean correct = true;
+
+		for (NOU::sizeType i = 0; i < COUNT; i++)
+			correct = correct && objects[i]->get() == static_cast<NOU::int32>(i);
+
+		IsTrue(correct);
+		IsTrue(NOU::DebugClass::getCounter() == COUNT);
+
+		for (NOU::sizeType i = 0; i < COUNT; i++)
+			pa.deallocate(objects[i]);
+
+		IsTrue(NOU::DebugClass::getCounter() == 0);
+	}
+
+	{
+		using HandleType = NOU::NOU_MEM_MNGT::GeneralPurposeAllocator::
+			GeneralPurposeAllocatorPointer<NOU::DebugClass>;
+
+		NOU::NOU_MEM_MNGT::GeneralPurposeAllocator gpa(1000, 
+			NOU::NOU_MEM_MNGT::GeneralPurposeAllocatorMode::SEGREGATED_FIT, smallPages);
+
+		NOU::NOU_DAT_ALG::Vector<HandleType> objects;
+
+		//the size is rounded up to a whole page, all of it can be used
+		for (NOU::int32 i = 0; i < 100; i++)
+			objects.pushBack(gpa.allocateObject<NOU::DebugClass>(i));
+
+		NOU::boolean correct = true;
+
+		for (NOU::sizeType i = 0; i < objects.size(); i++)
+			correct = correct && objects[i] != nullptr && objects[i]->get() == static_cast<NOU::int32>(i);
+
+		IsTrue(correct);
+
+		for (NOU::sizeType i = 0; i < objects.size(); i++)
+			gpa.deallocateObjects(objects[i]);
+
+		IsTrue(NOU::DebugClass::getCounter() == 0);
+	}
+
+	{
+		NOU::NOU_MEM_MNGT::MonotonicArena arena(256, smallPages);
+
+		NOU::int64 *first = arena.allocateUninitialized<NOU::int64>(4);
+
+		IsTrue(first != nullptr);
+
+		//the first block uses an entire page, not only the requested 256 bytes
+		IsTrue(arena.capacity() >= pageSize / 2);
+
+		for (NOU::sizeType i = 0; i < 1000; i++)
+			IsTrue(arena.allocate(100) != nullptr);
+
+		IsTrue(arena.capacity() >= 100000);
+
+		arena.reset();
+
+		IsTrue(arena.allocateUninitialized<NOU::int64>(4) == first);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(PoolAllocator)
+{
+	NOU::NOU_MEM_MNGT::PoolAllocator<NOU::DebugClass> pa;
+
+	NOU::NOU_DAT_ALG::Vector<NOU::DebugClass*> dbgCls;
+
+	NOU::sizeType testValue = 1234;
+
+	const NOU::sizeType ALLOC_SIZE = 4321;
+
+	IsTrue(NOU::DebugClass::getCounter() == 0);
+
+	for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
+	{
+		dbgCls.push(pa.allocate(testValue));
+	}
+
+	for (NOU::DebugClass* value : dbgCls)
+	{
+		IsTrue(value->get() == testValue);
+	}
+
+	IsTrue(NOU::DebugClass::getCounter() == ALLOC_SIZE);
+
+	for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
+	{
+		pa.deallocate(dbgCls.pop());
+	}
+
+	IsTrue(NOU::DebugClass::getCounter() == 0);
+
+	IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 0);
 
 	{
 		NOU::NOU_DAT_ALG::Uninitialized<NOU::DebugClass> uninit;
@@ -1239,6 +2058,233 @@ TEST_METHOD(PoolAllocator)
 	NOU_CHECK_ERROR_HANDLER;
 }
 
+TEST_METHOD(MonotonicArena)
+{
+	{
+		NOU::NOU_MEM_MNGT::MonotonicArena arena(256);
+
+		IsTrue(arena.capacity() == 0);
+		IsTrue(NOU::NOU_MEM_MNGT::MonotonicArena::getCurrent() == nullptr);
+
+		void *first = arena.allocate(10, 1);
+		IsTrue(first != nullptr);
+		IsTrue(arena.capacity() >= 256);
+
+		//alignment
+		void *aligned = arena.allocate(8, 64);
+		IsTrue(reinterpret_cast<NOU::sizeType>(aligned) % 64 == 0);
+
+		NOU::int64 *ints = arena.allocateUninitialized<NOU::int64>(4);
+		IsTrue(reinterpret_cast<NOU::sizeType>(ints) % alignof(NOU::int64) == 0);
+
+		//rewinding frees everything after the marker
+		NOU::NOU_MEM_MNGT::MonotonicArena::Marker marker = arena.mark();
+		void *afterMarker = arena.allocate(16);
+
+		for (NOU::sizeType i = 0; i < 100; i++)
+			arena.allocate(100);
+
+		arena.rewind(marker);
+		IsTrue(arena.allocate(16) == afterMarker);
+
+		//larger than a block
+		NOU::byte *large = arena.allocateUninitialized<NOU::byte>(100 * 1024);
+		IsTrue(large != nullptr);
+		large[100 * 1024 - 1] = 1;
+
+		//reset reuses the blocks
+		NOU::sizeType capacity = arena.capacity();
+
+		arena.reset();
+		IsTrue(arena.allocate(10, 1) == first);
+
+		for (NOU::sizeType i = 0; i < 100; i++)
+			arena.allocate(100);
+
+		IsTrue(arena.capacity() == capacity);
+
+		arena.release();
+		IsTrue(arena.capacity() == 0);
+	}
+
+	{
+		NOU::NOU_MEM_MNGT::MonotonicArena arena;
+
+		//a container with an explicit arena
+		NOU::NOU_DAT_ALG::Vector<NOU::int32, NOU::NOU_MEM_MNGT::ArenaAllocationCallback> vec(1,
+			NOU::NOU_MEM_MNGT::ArenaAllocationCallback<NOU::int32>(arena));
+
+		for (NOU::int32 i = 0; i < 1000; i++)
+			vec.pushBack(i);
+
+		NOU::boolean correct = true;
+
+		for (NOU::int32 i = 0; i < 1000; i++)
+			correct = correct && vec[i] == i;
+
+		IsTrue(correct);
+		IsTrue(vec.getAllocator().getArena() == &arena);
+	}
+
+	{
+		NOU::NOU_MEM_MNGT::MonotonicArena arena;
+		NOU::NOU_MEM_MNGT::MonotonicArena::Marker marker = arena.mark();
+
+		{
+			//containers that create nested containers use the current arena
+			NOU::NOU_MEM_MNGT::MonotonicArena::Scope scope(arena);
+
+			IsTrue(NOU::NOU_MEM_MNGT::MonotonicArena::getCurrent() == &arena);
+
+			NOU::NOU_DAT_ALG::HashMap<NOU::int32, NOU::int32, NOU::NOU_MEM_MNGT::ArenaAllocationCallback> 
+				map(50);
+			NOU::NOU_DAT_ALG::FlatHashMap<NOU::int32, NOU::int32, NOU::NOU_MEM_MNGT::ArenaAllocationCallback>
+				flatMap;
+
+			for (NOU::int32 i = 0; i < 500; i++)
+			{
+				map.map(i, i * 2);
+				flatMap.map(i, i * 3);
+			}
+
+			NOU::boolean correct = true;
+
+			for (NOU::int32 i = 0; i < 500; i++)
+			{
+				correct = correct && map.get(i) == i * 2;
+				correct = correct && flatMap.get(i) == i * 3;
+			}
+
+			IsTrue(correct);
+		}
+
+		IsTrue(NOU::NOU_MEM_MNGT::MonotonicArena::getCurrent() == nullptr);
+		IsTrue(arena.capacity() > 0);
+
+		//release everything at once
+		arena.rewind(marker);
+	}
+
+	{
+		//without a current arena, allocations fail instead of crashing
+		IsTrue(NOU::NOU_MEM_MNGT::MonotonicArena::getCurrent() == nullptr);
+
+		NOU::NOU_MEM_MNGT::ArenaAllocationCallback<NOU::int32> callback;
+
+		IsTrue(callback.getArena() == nullptr);
+		IsTrue(callback.allocate(4) == nullptr);
+
+		IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 1);
+		IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() == NOU::NOU_CORE::ErrorCodes::BAD_ALLOCATION);
+
+		{
+			NOU::NOU_DAT_ALG::Vector<NOU::int32, NOU::NOU_MEM_MNGT::ArenaAllocationCallback> vec;
+
+			IsTrue(vec.data() == nullptr);
+		}
+
+		IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 1);
+		IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() == NOU::NOU_CORE::ErrorCodes::BAD_ALLOCATION);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(ConcurrentPoolAllocator)
+{
+	{
+		NOU::NOU_MEM_MNGT::ConcurrentPoolAllocator<NOU::DebugClass> pa(8, 4);
+
+		IsTrue(pa.capacity() == 0);
+
+		NOU::NOU_DAT_ALG::Vector<NOU::DebugClass*> dbgCls;
+
+		NOU::int64 counter = NOU::DebugClass::getCounter();
+
+		const NOU::sizeType ALLOC_SIZE = 1000;
+
+		for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
+			dbgCls.push(pa.allocate(i));
+
+		IsTrue(pa.capacity() >= ALLOC_SIZE);
+		IsTrue(NOU::DebugClass::getCounter() == counter + static_cast<NOU::int64>(ALLOC_SIZE));
+
+		NOU::boolean correct = true;
+
+		for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
+			correct = correct && dbgCls[i]->get() == i;
+
+		IsTrue(correct);
+
+		NOU::int64 outside = 0;
+
+		IsTrue(pa.isPartOf(dbgCls[0]));
+		IsTrue(pa.isPartOf(dbgCls[ALLOC_SIZE - 1]));
+		IsTrue(!pa.isPartOf(&outside));
+
+		NOU::sizeType capacity = pa.capacity();
+
+		for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
+			pa.deallocate(dbgCls.pop());
+
+		IsTrue(NOU::DebugClass::getCounter() == counter);
+
+		//the blocks are reused
+		pa.flushThreadCache();
+
+		for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
+			dbgCls.push(pa.allocate(i));
+
+		IsTrue(pa.capacity() == capacity);
+
+		for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
+			pa.deallocate(dbgCls.pop());
+	}
+
+	{
+		//multiple threads allocate and deallocate at the same time, also blocks of other threads
+		NOU::NOU_MEM_MNGT::ConcurrentPoolAllocator<NOU::int64> pa(16, 4);
+
+		const NOU::sizeType COUNT = 20000;
+
+		NOU::NOU_DAT_ALG::Vector<NOU::int64*> pointers(COUNT);
+
+		for (NOU::sizeType i = 0; i < COUNT; i++)
+			pointers.pushBack(pa.allocate(static_cast<NOU::int64>(i)));
+
+		std::atomic<NOU::sizeType> errors(0);
+
+		NOU::NOU_THREAD::parallelFor(0, COUNT, 256, [&pa, &pointers, &errors](NOU::sizeType i)
+		{
+			if (*pointers[i] != static_cast<NOU::int64>(i))
+				errors++;
+
+			pa.deallocate(pointers[i]);
+
+			NOU::int64 *local = pa.allocate(static_cast<NOU::int64>(i) * 2);
+
+			if (*local != static_cast<NOU::int64>(i) * 2)
+				errors++;
+
+			pointers[i] = local;
+		});
+
+		IsTrue(errors == 0);
+
+		NOU::boolean correct = true;
+
+		for (NOU::sizeType i = 0; i < COUNT; i++)
+			correct = correct && *pointers[i] == static_cast<NOU::int64>(i) * 2;
+
+		IsTrue(correct);
+
+		for (NOU::sizeType i = 0; i < COUNT; i++)
+			pa.deallocate(pointers[i]);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
 TEST_METHOD(GeneralPurposeAllocator)
 {
 	using HandleType = NOU::NOU_MEM_MNGT::GeneralPurposeAllocator::
@@ -1289,6 +2335,118 @@ TEST_METHOD(GeneralPurposeAllocator)
 	NOU_CHECK_ERROR_HANDLER;
 }
 
+TEST_METHOD(GeneralPurposeAllocatorSegregatedFit)
+{
+	using HandleType = NOU::NOU_MEM_MNGT::GeneralPurposeAllocator::
+		GeneralPurposeAllocatorPointer<NOU::DebugClass>;
+
+	const NOU::sizeType GPA_SIZE = 64 * 1024;
+
+	NOU::NOU_MEM_MNGT::GeneralPurposeAllocator gpa(GPA_SIZE, 
+		NOU::NOU_MEM_MNGT::GeneralPurposeAllocatorMode::SEGREGATED_FIT);
+	NOU::NOU_DAT_ALG::Vector<HandleType> dbgVec;
+	const NOU::sizeType ALLOC_SIZE = 200;
+
+	IsTrue(gpa.getMode() == NOU::NOU_MEM_MNGT::GeneralPurposeAllocatorMode::SEGREGATED_FIT);
+
+	NOU::int64 counter = NOU::DebugClass::getCounter();
+
+	NOU::int64 objectCount = 0;
+
+	//allocations of different sizes
+	for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
+	{
+		dbgVec.push(gpa.allocateObjects<NOU::DebugClass>(i % 7 + 1, i));
+		objectCount += static_cast<NOU::int64>(i % 7 + 1);
+	}
+
+	IsTrue(NOU::DebugClass::getCounter() == counter + objectCount);
+
+	NOU::boolean correct = true;
+
+	for (NOU::sizeType i = 0; i < ALLOC_SIZE; i++)
+	{
+		correct = correct && dbgVec[i] != nullptr;
+
+		for (NOU::sizeType j = 0; j < i % 7 + 1; j++)
+			correct = correct && dbgVec[i][static_cast<int>(j)].get() == i;
+	}
+
+	IsTrue(correct);
+
+	//free every second allocation first to fragment the memory, then the rest
+	for (NOU::sizeType i = 0; i < ALLOC_SIZE; i += 2)
+	{
+		gpa.deallocateObjects(dbgVec[i]);
+	}
+
+	for (NOU::sizeType i = 1; i < ALLOC_SIZE; i += 2)
+	{
+		gpa.deallocateObjects(dbgVec[i]);
+	}
+
+	IsTrue(NOU::DebugClass::getCounter() == counter);
+
+	//all blocks have been merged again, a single large allocation must succeed
+	auto large = gpa.allocateObjects<NOU::byte>(GPA_SIZE / 2);
+	IsTrue(large != nullptr);
+	gpa.deallocateObjects(large);
+
+	//alignments that are larger than the default one
+	struct alignas(64) Aligned
+	{
+		NOU::int64 m_value;
+
+		Aligned(NOU::int64 value) :
+			m_value(value)
+		{}
+	};
+
+	NOU::NOU_DAT_ALG::Vector<NOU::NOU_MEM_MNGT::GeneralPurposeAllocator::
+		GeneralPurposeAllocatorPointer<Aligned>> alignedVec;
+
+	for (NOU::sizeType i = 0; i < 50; i++)
+	{
+		//unaligned allocation in between to offset the next one
+		auto small = gpa.allocateObject<NOU::byte>(NOU::byte(1));
+		alignedVec.push(gpa.allocateObject<Aligned>(static_cast<NOU::int64>(i)));
+		gpa.deallocateObjects(small);
+	}
+
+	correct = true;
+
+	for (NOU::sizeType i = 0; i < alignedVec.size(); i++)
+	{
+		correct = correct && reinterpret_cast<NOU::sizeType>(alignedVec[i].getRaw()) % 64 == 0;
+		correct = correct && alignedVec[i]->m_value == static_cast<NOU::int64>(i);
+	}
+
+	IsTrue(correct);
+
+	for (NOU::sizeType i = 0; i < alignedVec.size(); i++)
+	{
+		gpa.deallocateObjects(alignedVec[i]);
+	}
+
+	//a request that does not fit
+	IsTrue(gpa.allocateObjects<NOU::byte>(GPA_SIZE) == nullptr);
+
+	large = gpa.allocateObjects<NOU::byte>(GPA_SIZE / 2);
+	IsTrue(large != nullptr);
+
+#ifdef NOU_DEBUG
+	gpa.deallocateObjects(large);
+	gpa.deallocateObjects(large);
+
+	IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 1);
+	IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() == NOU::NOU_CORE::ErrorCodes::BAD_DEALLOCATION);
+#else
+	gpa.deallocateObjects(large);
+#endif
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
 TEST_METHOD(String)
 {
 	NOU::NOU_DAT_ALG::String8 str1;
@@ -1458,19 +2616,20 @@ TEST_METHOD(BinaryHeap)
 
 	b.dequeue();
 
+	//the last element is moved to the root and sifted down
 	IsTrue(b.at(0) == 2);
-	IsTrue(b.at(1) == 3);
-	IsTrue(b.at(2) == 4);
-	IsTrue(b.at(3) == 1);
-	IsTrue(b.at(4) == 4);
+	IsTrue(b.at(1) == 4);
+	IsTrue(b.at(2) == 3);
+	IsTrue(b.at(3) == 4);
+	IsTrue(b.at(4) == 1);
 
 	b.decreaseKey(2, 2);
 
 	IsTrue(b.at(0) == 2);
-	IsTrue(b.at(1) == 3);
-	IsTrue(b.at(2) == 4);
-	IsTrue(b.at(3) == 1);
-	IsTrue(b.at(4) == 4);
+	IsTrue(b.at(1) == 4);
+	IsTrue(b.at(2) == 3);
+	IsTrue(b.at(3) == 4);
+	IsTrue(b.at(4) == 1);
 
 	NOU::NOU_DAT_ALG::BinaryHeap<NOU::int32> c(true, 5);
 
@@ -1489,27 +2648,197 @@ TEST_METHOD(BinaryHeap)
 	IsTrue(c.at(2) == 17);
 	IsTrue(c.at(3) == 188);
 
-	NOU_CHECK_ERROR_HANDLER;
-}
+	IsTrue(!c.checkIfPresent(4));
+	IsTrue(!c.deleteById(4));
+	IsTrue(!c.changePriority(4, 1));
 
+	//move the element with the id 5 (priority 5) to the root
+	IsTrue(c.changePriority(5, 0));
+	IsTrue(c.get() == 188);
+	IsTrue(c.checkIfPresent(5));
 
-TEST_METHOD(Hashfunction)
-{
-	NOU::int64 i1 = 243536768574;
-	NOU::int64 i2 = 243536768574;
+	//and back to the bottom
+	IsTrue(c.changePriority(5, 10));
+	IsTrue(c.get() == 11);
 
-	NOU::sizeType h = NOU::NOU_DAT_ALG::hashObj(&i1, 1, 20);
-	//AreEqual(h, NOU::NOU_DAT_ALG::hashObj(&i2, sizeof(NOU::int64), 20));
-	IsTrue(h == NOU::NOU_DAT_ALG::hashObj(&i2, 1, 20));
+	{
+		//cancel many elements and check that the remaining ones are still dequeued in order
+		NOU::NOU_DAT_ALG::BinaryHeap<NOU::uint32> heap;
+		NOU::NOU_DAT_ALG::Vector<NOU::NOU_DAT_ALG::BinaryHeap<NOU::uint32>::PriorityTypePart> ids;
 
-	NOU::NOU_DAT_ALG::String<NOU::char8> str1 = "The quick onyx goblin jumps over the lazy dwarf";
-	NOU::NOU_DAT_ALG::String<NOU::char8> str2 = "The quick onyx goblin jumps over the lazy dwarf";
+		NOU::uint32 state = 42;
 
-	h = NOU::NOU_DAT_ALG::hashObj(&str1, 1, 20);
-	//AreEqual(h, NOU::NOU_DAT_ALG::hashObj(&str2, str2.size(), 20));
-	IsTrue(h == NOU::NOU_DAT_ALG::hashObj(&str2, 1, 20));
+		for (NOU::uint32 i = 0; i < 5000; i++)
+		{
+			state = state * 1103515245 + 12345;
+			NOU::uint32 priority = (state >> 8) % 1000;
 
-	NOU_CHECK_ERROR_HANDLER;
+			ids.pushBack(heap.enqueue(priority, priority));
+		}
+
+		IsTrue(heap.size() == 5000);
+
+		for (NOU::sizeType i = 0; i < ids.size(); i += 2)
+			IsTrue(heap.deleteById(ids[i]));
+
+		IsTrue(heap.size() == 2500);
+
+		for (NOU::sizeType i = 0; i < ids.size(); i++)
+			IsTrue(heap.checkIfPresent(ids[i]) == (i % 2 == 1));
+
+		NOU::uint32 previous = 0;
+		NOU::boolean ordered = true;
+
+		while (heap.size() > 0)
+		{
+			ordered = ordered && previous <= heap.get();
+			previous = heap.get();
+			heap.dequeue();
+		}
+
+		IsTrue(ordered);
+	}
+
+	{
+		//priorities that do not fit into 32 bit after being multiplied with the priority factor
+		NOU::NOU_DAT_ALG::BinaryHeap<NOU::int32> heap(false);
+
+		heap.enqueue(1000, 1);
+		heap.enqueue(3000000, 2);
+		heap.enqueue(50, 3);
+
+		IsTrue(heap.get() == 2);
+		heap.dequeue();
+		IsTrue(heap.get() == 1);
+		heap.dequeue();
+		IsTrue(heap.get() == 3);
+	}
+
+	{
+		NOU::NOU_DAT_ALG::BinaryHeap<NOU::int32> heap;
+
+		NOU::int32 data[100];
+		NOU::NOU_DAT_ALG::BinaryHeap<NOU::int32>::PriorityTypePart ids[100];
+
+		for (NOU::int32 i = 0; i < 100; i++)
+			data[i] = i;
+
+		heap.enqueue(5, -1);
+
+		//more elements than the heap contains, the heap is rebuilt entirely
+		heap.enqueueAll(10, data, 50, ids);
+
+		IsTrue(heap.size() == 51);
+
+		for (NOU::sizeType i = 0; i < 50; i++)
+			IsTrue(heap.checkIfPresent(ids[i]));
+
+		//fewer elements than the heap contains, each element is sifted up
+		heap.enqueueAll(1, data + 50, 10);
+		heap.enqueueAll(20, data + 60, 40);
+
+		IsTrue(heap.size() == 101);
+
+		NOU::sizeType previousPriority = 0;
+		NOU::boolean ordered = true;
+
+		while (heap.size() > 0)
+		{
+			NOU::int32 value = heap.get();
+			NOU::sizeType priority = value == -1 ? 5 : (value < 50 ? 10 : (value < 60 ? 1 : 20));
+
+			ordered = ordered && previousPriority <= priority;
+			previousPriority = priority;
+
+			heap.dequeue();
+		}
+
+		IsTrue(ordered);
+
+		//the ids are still valid after the heap has been rebuilt
+		heap.enqueueAll(3, data, 20, ids);
+		heap.enqueue(2, 1000);
+
+		IsTrue(heap.deleteById(ids[7]));
+		IsTrue(heap.get() == 1000);
+		IsTrue(heap.size() == 20);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+
+TEST_METHOD(Hashfunction)
+{
+	NOU::int64 i1 = 243536768574;
+	NOU::int64 i2 = 243536768574;
+
+	NOU::sizeType h = NOU::NOU_DAT_ALG::hashObj(&i1, 1, 20);
+	//AreEqual(h, NOU::NOU_DAT_ALG::hashObj(&i2, sizeof(NOU::int64), 20));
+	IsTrue(h == NOU::NOU_DAT_ALG::hashObj(&i2, 1, 20));
+
+	NOU::NOU_DAT_ALG::String<NOU::char8> str1 = "The quick onyx goblin jumps over the lazy dwarf";
+	NOU::NOU_DAT_ALG::String<NOU::char8> str2 = "The quick onyx goblin jumps over the lazy dwarf";
+
+	h = NOU::NOU_DAT_ALG::hashObj(&str1, 1, 20);
+	//AreEqual(h, NOU::NOU_DAT_ALG::hashObj(&str2, str2.size(), 20));
+	IsTrue(h == NOU::NOU_DAT_ALG::hashObj(&str2, 1, 20));
+
+	NOU::NOU_DAT_ALG::StringView8 view1 = str1;
+
+	IsTrue(h == NOU::NOU_DAT_ALG::hashObj(&view1, 1, 20));
+
+	//hash64
+	NOU::byte bytes[1024];
+
+	for (NOU::sizeType i = 0; i < sizeof(bytes); i++)
+		bytes[i] = static_cast<NOU::byte>(i * 131 + 7);
+
+	IsTrue(NOU::NOU_DAT_ALG::hash64(bytes, 100) == NOU::NOU_DAT_ALG::hash64(bytes, 100));
+	IsTrue(NOU::NOU_DAT_ALG::hash64(bytes, 100) != NOU::NOU_DAT_ALG::hash64(bytes, 100, 1));
+	IsTrue(NOU::NOU_DAT_ALG::hash64(bytes, 600) != NOU::NOU_DAT_ALG::hash64(bytes, 600, 1));
+
+	//every length (covering the short and the long inputs) produces a different hash
+	NOU::NOU_DAT_ALG::Vector<NOU::uint64> hashes;
+
+	for (NOU::sizeType i = 0; i <= sizeof(bytes); i++)
+		hashes.pushBack(NOU::NOU_DAT_ALG::hash64(bytes, i));
+
+	NOU::NOU_DAT_ALG::qsort(hashes.data(), 0, hashes.size() - 1);
+
+	NOU::boolean unique = true;
+
+	for (NOU::sizeType i = 1; i < hashes.size(); i++)
+		unique = unique && hashes[i - 1] != hashes[i];
+
+	IsTrue(unique);
+
+	//changing a single byte changes the hash, also in the middle of a long input
+	NOU::uint64 longHash = NOU::NOU_DAT_ALG::hash64(bytes, sizeof(bytes));
+
+	bytes[500]++;
+
+	IsTrue(longHash != NOU::NOU_DAT_ALG::hash64(bytes, sizeof(bytes)));
+
+	//the scalar code produces the same hashes as the AVX2 code (if the CPU supports it)
+	longHash = NOU::NOU_DAT_ALG::hash64(bytes, sizeof(bytes), 3);
+
+	IsTrue(!NOU::NOU_DAT_ALG::internal::setHashAvx2Enabled(false));
+	IsTrue(longHash == NOU::NOU_DAT_ALG::hash64(bytes, sizeof(bytes), 3));
+	NOU::NOU_DAT_ALG::internal::setHashAvx2Enabled(true);
+
+	IsTrue(longHash == NOU::NOU_DAT_ALG::hash64(bytes, sizeof(bytes), 3));
+
+	//Hasher
+	IsTrue(NOU::NOU_DAT_ALG::Hasher<NOU::NOU_DAT_ALG::String8>()(str1) ==
+		NOU::NOU_DAT_ALG::Hasher<NOU::NOU_DAT_ALG::StringView8>()(view1));
+	IsTrue(NOU::NOU_DAT_ALG::Hasher<NOU::NOU_DAT_ALG::String8>()(str1) ==
+		NOU::NOU_DAT_ALG::hash64(str1.rawStr(), str1.size()));
+	IsTrue(NOU::NOU_DAT_ALG::Hasher<NOU::int64>()(i1) == NOU::NOU_DAT_ALG::Hasher<NOU::int64>()(i2));
+	IsTrue(NOU::NOU_DAT_ALG::Hasher<NOU::int64>()(i1) != NOU::NOU_DAT_ALG::Hasher<NOU::int64>()(i1, 5));
+	IsTrue(NOU::NOU_DAT_ALG::Hasher<NOU::float64>()(0.0) == NOU::NOU_DAT_ALG::Hasher<NOU::float64>()(-0.0));
+
+	NOU_CHECK_ERROR_HANDLER;
 }
 
 TEST_METHOD(HashMap)
@@ -1664,6 +2993,298 @@ TEST_METHOD(HashMap)
 
 }
 
+TEST_METHOD(FlatHashMap)
+{
+	{
+		//construction
+		NOU::NOU_DAT_ALG::FlatHashMap<NOU::int32, NOU::int32> map;
+
+		IsTrue(map.capacity() == NOU::NOU_DAT_ALG::FlatHashMap<NOU::int32, NOU::int32>::MIN_CAPACITY);
+		IsTrue(map.size() == 0);
+		IsTrue(map.isEmpty());
+		IsTrue(!map.containsKey(0));
+		IsTrue(map.find(0) == nullptr);
+
+		//push values
+		map.map(0, 5);
+		map.map(1, 900);
+		map.map(2, 1337);
+
+		IsTrue(map.containsKey(0));
+		IsTrue(map.containsKey(1));
+		IsTrue(map.containsKey(2));
+
+		IsTrue(map.size() == 3);
+		IsTrue(!map.isEmpty());
+
+		IsTrue(map.get(0) == 5);
+		IsTrue(map.get(1) == 900);
+		IsTrue(map.get(2) == 1337);
+
+		//assign new value to key
+		map.map(2, 42);
+
+		IsTrue(map.get(2) == 42);
+		IsTrue(map.size() == 3);
+
+		//array subscript
+		IsTrue(map.get(0) == map[0]);
+
+		IsTrue(map.keySet().size() == 3);
+		IsTrue(map.entrySet().size() == 3);
+
+		//remove
+		NOU::int32 out = 0;
+
+		IsTrue(map.remove(1, &out));
+		IsTrue(out == 900);
+		IsTrue(!map.remove(1));
+		IsTrue(!map.containsKey(1));
+		IsTrue(map.size() == 2);
+
+		//copy and move
+		NOU::NOU_DAT_ALG::FlatHashMap<NOU::int32, NOU::int32> mapCopy = map;
+
+		IsTrue(mapCopy.size() == 2);
+		IsTrue(mapCopy.get(2) == 42);
+
+		NOU::NOU_DAT_ALG::FlatHashMap<NOU::int32, NOU::int32> mapMove = NOU::NOU_CORE::move(map);
+
+		IsTrue(mapMove.size() == 2);
+		IsTrue(mapMove.get(0) == 5);
+		IsTrue(map.size() == 0);
+
+		//lookups in a moved-from map fail without accessing the slots
+		IsTrue(map.find(2) == nullptr);
+		IsTrue(!map.containsKey(2));
+
+		map.get(2);
+
+		IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 1);
+		IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() == NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT);
+
+		static_cast<const NOU::NOU_DAT_ALG::FlatHashMap<NOU::int32, NOU::int32>&>(map).get(2);
+
+		IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 1);
+		IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() == NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT);
+
+		//a moved-from map can be used again
+		map.map(3, 4);
+
+		IsTrue(map.get(3) == 4);
+
+		map.clear();
+
+		IsTrue(map.isEmpty());
+		IsTrue(!map.containsKey(3));
+	}
+
+	{
+		//growth, removal and reinsertion with many keys
+		NOU::NOU_DAT_ALG::FlatHashMap<NOU::int64, NOU::int64> map;
+
+		const NOU::int64 count = 100000;
+
+		for (NOU::int64 i = 0; i < count; i++)
+			map.map(i * 7, i);
+
+		IsTrue(map.size() == static_cast<NOU::sizeType>(count));
+		IsTrue(map.size() <= map.capacity() * map.maxLoadFactor());
+
+		NOU::boolean allFound = true;
+
+		for (NOU::int64 i = 0; i < count; i++)
+			allFound = allFound && map.get(i * 7) == i;
+
+		IsTrue(allFound);
+		IsTrue(!map.containsKey(1));
+
+		for (NOU::int64 i = 0; i < count; i += 2)
+			map.remove(i * 7);
+
+		IsTrue(map.size() == static_cast<NOU::sizeType>(count / 2));
+
+		NOU::boolean correct = true;
+
+		for (NOU::int64 i = 0; i < count; i++)
+			correct = correct && map.containsKey(i * 7) == (i % 2 == 1);
+
+		IsTrue(correct);
+
+		//reinsert over the tombstones
+		NOU::sizeType capacity = map.capacity();
+
+		for (NOU::int64 i = 0; i < count; i += 2)
+			map.map(i * 7, -i);
+
+		IsTrue(map.size() == static_cast<NOU::sizeType>(count));
+		IsTrue(map.capacity() == capacity);
+		IsTrue(map.get(14) == -2);
+		IsTrue(map.get(21) == 3);
+	}
+
+	{
+		//keys without a copy constructor and custom comparators
+		NOU::NOU_DAT_ALG::FlatHashMap<NoCopyClass, NoCopyClass> map(50);
+
+		IsTrue(map.capacity() == 64);
+
+		map.map(NoCopyClass(0), NoCopyClass(5), noCopyClassComparator);
+		map.map(NoCopyClass(1), NoCopyClass(900), noCopyClassComparator);
+		map.map(NoCopyClass(1), NoCopyClass(901), noCopyClassComparator);
+
+		IsTrue(map.size() == 2);
+		IsTrue(map.containsKey(NoCopyClass(1), noCopyClassComparator));
+		IsTrue(!map.containsKey(NoCopyClass(2), noCopyClassComparator));
+		IsTrue(map.get(NoCopyClass(1), noCopyClassComparator).get() == 901);
+	}
+
+	{
+		//heterogeneous lookup
+		NOU::NOU_DAT_ALG::FlatHashMap<NOU::NOU_DAT_ALG::String8, NOU::int32> map;
+
+		map.map("test", 1);
+		map.map("another test", 2);
+
+		NOU::NOU_DAT_ALG::StringView8 view = "another test";
+
+		IsTrue(map.containsKey(view));
+		IsTrue(map.get(view) == 2);
+		IsTrue(map.get("test") == 1);
+		IsTrue(!map.containsKey(NOU::NOU_DAT_ALG::StringView8("tes")));
+
+		IsTrue(map.remove(view));
+		IsTrue(!map.containsKey("another test"));
+
+		//unknown keys push an error
+		NOU::sizeType errorCount = NOU::NOU_CORE::getErrorHandler().getErrorCount();
+
+		map.get("unknown");
+
+		IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == errorCount + 1);
+		IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() ==
+			NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT);
+	}
+
+	{
+		//load factor
+		NOU::NOU_DAT_ALG::FlatHashMap<NOU::int32, NOU::int32> map(16, 0.5f);
+
+		IsTrue(map.maxLoadFactor() == 0.5f);
+
+		for (NOU::int32 i = 0; i < 9; i++)
+			map.map(i, i);
+
+		IsTrue(map.capacity() == 32);
+
+		map.setMaxLoadFactor(1.0f);
+
+		IsTrue(map.maxLoadFactor() == 0.5f);
+		IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() ==
+			NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT);
+
+		map.reserve(1000);
+
+		IsTrue(map.capacity() >= 2000);
+		IsTrue(map.size() == 9);
+		IsTrue(map.get(8) == 8);
+	}
+
+	{
+		//no leaks
+		NOU::int64 counter = NOU::DebugClass::getCounter();
+
+		{
+			NOU::NOU_DAT_ALG::FlatHashMap<NOU::int32, NOU::DebugClass> map;
+
+			for (NOU::int32 i = 0; i < 100; i++)
+				map.map(i, NOU::DebugClass());
+
+			for (NOU::int32 i = 0; i < 50; i++)
+				map.remove(i);
+
+			IsTrue(NOU::DebugClass::getCounter() == counter + 50);
+		}
+
+		IsTrue(NOU::DebugClass::getCounter() == counter);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(ConcurrentHashMap)
+{
+	{
+		NOU::NOU_DAT_ALG::ConcurrentHashMap<NOU::int32, NOU::int32> map(16, 5);
+
+		IsTrue(map.shardCount() == 8);
+		IsTrue(map.isEmpty());
+		IsTrue(!map.containsKey(0));
+
+		map.map(0, 5);
+		map.map(1, 900);
+		map.map(2, 1337);
+		map.map(2, 42);
+
+		IsTrue(map.size() == 3);
+		IsTrue(map.get(0) == 5);
+		IsTrue(map.get(2) == 42);
+
+		NOU::int32 out = 0;
+
+		IsTrue(map.tryGet(1, out));
+		IsTrue(out == 900);
+		IsTrue(!map.tryGet(3, out));
+
+		IsTrue(map.computeIfAbsent(1, [](NOU::int32) { return 0; }) == 900);
+		IsTrue(map.computeIfAbsent(3, [](NOU::int32 key) { return key * 2; }) == 6);
+		IsTrue(map.get(3) == 6);
+
+		IsTrue(map.keySet().size() == 4);
+		IsTrue(map.entrySet().size() == 4);
+
+		IsTrue(map.remove(1, &out));
+		IsTrue(out == 900);
+		IsTrue(!map.containsKey(1));
+
+		map.clear();
+
+		IsTrue(map.isEmpty());
+	}
+
+	{
+		//concurrent insertions and lookups
+		NOU::NOU_DAT_ALG::ConcurrentHashMap<NOU::int64, NOU::int64> map;
+		std::atomic<NOU::int64> computations(0);
+
+		const NOU::sizeType count = 20000;
+
+		NOU::NOU_THREAD::parallelFor(0, count, 64, [&map, &computations](NOU::sizeType i)
+		{
+			map.map(static_cast<NOU::int64>(i), static_cast<NOU::int64>(i) * 3);
+
+			//many threads compute the same keys, each key must only be computed once
+			map.computeIfAbsent(-static_cast<NOU::int64>(i % 100) - 1, [&computations](NOU::int64 key)
+			{
+				computations++;
+				return key;
+			});
+		});
+
+		IsTrue(map.size() == count + 100);
+		IsTrue(computations == 100);
+
+		NOU::boolean correct = true;
+
+		for (NOU::sizeType i = 0; i < count; i++)
+			correct = correct && map.get(static_cast<NOU::int64>(i)) == static_cast<NOU::int64>(i) * 3;
+
+		IsTrue(correct);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
 TEST_METHOD(BinarySearch)
 {
 	NOU::NOU_DAT_ALG::Vector<NOU::int64> vec;
@@ -1884,55 +3505,189 @@ TEST_METHOD(ObjectPool)
 
 }
 
-static void taskTestFunction1(NOU::int32 i, NOU::int32 *out)
+TEST_METHOD(ConcurrentObjectPool)
 {
-	*out = i;
-}
+	{
+		NOU::NOU_DAT_ALG::ConcurrentObjectPool<NOU::DebugClass> pool(4);
 
-static NOU::int32 taskTestFunction2(NOU::int32 i)
-{
-	return i;
-}
+		IsTrue(pool.size() == 0);
+		IsTrue(pool.capacity() == 0);
 
-class DummyClass
-{
-	//empty class
-};
+		using Handle = NOU::NOU_DAT_ALG::ConcurrentObjectPool<NOU::DebugClass>::Handle;
 
-static NOU::int32 taskTestFunction3(const DummyClass dc)
-{
-	return 1;
-}
+		Handle null;
 
-static void taskTestFunction4(const DummyClass dc)
-{
+		IsTrue(null.isNull());
+		IsTrue(!pool.isValid(null));
+		IsTrue(pool.resolve(null) == nullptr);
 
-}
+		Handle h0 = pool.emplaceObject(0);
+		Handle h1 = pool.emplaceObject(1);
 
-TEST_METHOD(Task)
-{
-	NOU::int32 i1 = 5;
-	NOU::int32 out;
+		IsTrue(!h0.isNull());
+		IsTrue(h0 != h1);
+		IsTrue(pool.size() == 2);
+		IsTrue(pool.capacity() == 4);
+		IsTrue(pool.isValid(h0));
+		IsTrue(pool.resolve(h0)->get() == 0);
+		IsTrue(pool.resolve(h1)->get() == 1);
 
-	auto task1 = NOU::NOU_THREAD::makeTask(&taskTestFunction1, i1, &out);
+		NOU::DebugClass *address0 = pool.resolve(h0);
 
-	task1.execute();
+		//growing must not move existing objects
+		NOU::NOU_DAT_ALG::Vector<Handle> handles;
 
-	IsTrue(out == i1);
+		for (NOU::int32 i = 2; i < 10; i++)
+			handles.pushBack(pool.emplaceObject(i));
 
+		IsTrue(pool.size() == 10);
+		IsTrue(pool.capacity() == 12);
+		IsTrue(pool.resolve(h0) == address0);
 
+		for (NOU::sizeType i = 0; i < handles.size(); i++)
+			IsTrue(pool.resolve(handles[i])->get() == static_cast<NOU::int32>(i) + 2);
 
-	//just to make sure that INVALID_OBJECT is the first error in the handler later
-	IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 0);
+		//a stale handle is detected, even if the slot is reused
+		IsTrue(pool.giveBack(h0));
+		IsTrue(pool.size() == 9);
+		IsTrue(!pool.isValid(h0));
+		IsTrue(pool.resolve(h0) == nullptr);
 
-	NOU::int32 i2 = 5;
+		Handle reused = pool.emplaceObject(42);
 
-	auto task2 = NOU::NOU_THREAD::makeTask(&taskTestFunction2, i2);
+		IsTrue(reused.getIndex() == h0.getIndex());
+		IsTrue(reused.getGeneration() != h0.getGeneration());
+		IsTrue(pool.resolve(reused) == address0);
+		IsTrue(pool.resolve(reused)->get() == 42);
+		IsTrue(pool.resolve(h0) == nullptr);
 
-	task2.getResult();
+		IsTrue(!pool.giveBack(h0));
+		IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() ==
+			NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT);
 
-	//error is only pushed in Debug
-#ifdef NOU_DEBUG
+		IsTrue(!pool.giveBack(null));
+		IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() ==
+			NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT);
+
+		IsTrue(pool.giveBack(h1));
+		IsTrue(pool.size() == 9);
+
+		//the remaining objects are destructed by the pool
+	}
+
+	IsTrue(NOU::DebugClass::getCounter() == 0);
+
+	{
+		//multiple threads create and give back objects at the same time
+		NOU::NOU_DAT_ALG::ConcurrentObjectPool<NOU::int64> pool(16);
+
+		using Handle = NOU::NOU_DAT_ALG::ConcurrentObjectPool<NOU::int64>::Handle;
+
+		const NOU::sizeType COUNT = 20000;
+
+		NOU::NOU_DAT_ALG::Vector<Handle> handles(COUNT);
+
+		for (NOU::sizeType i = 0; i < COUNT; i++)
+			handles.pushBack(pool.emplaceObject(static_cast<NOU::int64>(i)));
+
+		std::atomic<NOU::sizeType> errors(0);
+
+		NOU::NOU_THREAD::parallelFor(0, COUNT, 256, [&pool, &handles, &errors](NOU::sizeType i)
+		{
+			if (*pool.resolve(handles[i]) != static_cast<NOU::int64>(i))
+				errors++;
+
+			if (!pool.giveBack(handles[i]))
+				errors++;
+
+			Handle local = pool.emplaceObject(static_cast<NOU::int64>(i) * 2);
+
+			if (*pool.resolve(local) != static_cast<NOU::int64>(i) * 2)
+				errors++;
+
+			if (!pool.giveBack(local))
+				errors++;
+		});
+
+		IsTrue(errors == 0);
+		IsTrue(pool.size() == 0);
+
+		//all slots have been reused, no slab was allocated after the initial ones
+		IsTrue(pool.capacity() <= COUNT + 16);
+
+		NOU::boolean stale = true;
+
+		for (NOU::sizeType i = 0; i < COUNT; i++)
+			stale = stale && !pool.isValid(handles[i]);
+
+		IsTrue(stale);
+	}
+
+	{
+		//the slab size is clamped, so that the indices of the slots can not overflow
+		using Pool = NOU::NOU_DAT_ALG::ConcurrentObjectPool<NOU::int32>;
+
+		Pool pool(NOU::sizeType(1) << 40);
+
+		Pool::Handle handle = pool.emplaceObject(1);
+
+		IsTrue(pool.capacity() == Pool::MAX_SLAB_SIZE);
+		IsTrue(*pool.resolve(handle) == 1);
+		IsTrue(pool.giveBack(handle));
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+static void taskTestFunction1(NOU::int32 i, NOU::int32 *out)
+{
+	*out = i;
+}
+
+static NOU::int32 taskTestFunction2(NOU::int32 i)
+{
+	return i;
+}
+
+class DummyClass
+{
+	//empty class
+};
+
+static NOU::int32 taskTestFunction3(const DummyClass dc)
+{
+	return 1;
+}
+
+static void taskTestFunction4(const DummyClass dc)
+{
+
+}
+
+TEST_METHOD(Task)
+{
+	NOU::int32 i1 = 5;
+	NOU::int32 out;
+
+	auto task1 = NOU::NOU_THREAD::makeTask(&taskTestFunction1, i1, &out);
+
+	task1.execute();
+
+	IsTrue(out == i1);
+
+
+
+	//just to make sure that INVALID_OBJECT is the first error in the handler later
+	IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 0);
+
+	NOU::int32 i2 = 5;
+
+	auto task2 = NOU::NOU_THREAD::makeTask(&taskTestFunction2, i2);
+
+	task2.getResult();
+
+	//error is only pushed in Debug
+#ifdef NOU_DEBUG
 	IsTrue(NOU::NOU_CORE::getErrorHandler().getErrorCount() == 1);
 	IsTrue(NOU::NOU_CORE::getErrorHandler().popError().getID() ==
 		NOU::NOU_CORE::ErrorCodes::INVALID_OBJECT);
@@ -1969,6 +3724,1233 @@ TEST_METHOD(ThreadManager)
 		IsTrue(manager.maximumAvailableThreads() == NOU::NOU_THREAD::ThreadWrapper::maxThreads() - 1);
 	}
 
+	IsTrue(manager.getConfiguration().schedulerMode == NOU::NOU_THREAD::SchedulerMode::TASK_HEAP);
+
+	//the manager has already been constructed, the configuration can not be changed anymore
+	NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+	configuration.schedulerMode = NOU::NOU_THREAD::SchedulerMode::WORK_STEALING;
+	IsTrue(!NOU::NOU_THREAD::ThreadManager::configure(configuration));
+	IsTrue(manager.getConfiguration().schedulerMode == NOU::NOU_THREAD::SchedulerMode::TASK_HEAP);
+
+	{
+		const NOU::sizeType taskCount = 1000;
+
+		std::atomic<NOU::sizeType> counter(0);
+
+		//the increment is the last access to the task, after that it may be destroyed
+		struct CountingTask : public NOU::NOU_THREAD::internal::AbstractTask
+		{
+			std::atomic<NOU::sizeType> *m_counter;
+
+			virtual void execute() override
+			{
+				m_counter->fetch_add(1);
+			}
+		};
+
+		NOU::NOU_DAT_ALG::Vector<CountingTask> tasks(taskCount);
+		NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::internal::AbstractTask*> taskPtrs(taskCount);
+
+		for (NOU::sizeType i = 0; i < taskCount; i++)
+		{
+			tasks.pushBack(CountingTask());
+			tasks[i].m_counter = &counter;
+		}
+
+		for (NOU::sizeType i = 0; i < taskCount; i++)
+			taskPtrs.pushBack(&tasks[i]);
+
+		manager.pushTasks(taskPtrs.data(), taskPtrs.size(), 5);
+
+		//pushing nothing is valid
+		manager.pushTasks(nullptr, 0, 5);
+
+		while (counter.load() != taskCount)
+			std::this_thread::yield();
+
+		IsTrue(counter.load() == taskCount);
+	}
+
+	//each task submits two children until the depth is 0, the children are pushed to the deques of the worker
+	struct NestedSubmitter
+	{
+		static void run(NOU::NOU_THREAD::ThreadManager *manager, std::atomic<NOU::sizeType> *counter,
+			NOU::sizeType depth)
+		{
+			counter->fetch_add(1);
+
+			if (depth > 0)
+			{
+				manager->submit(&run, manager, counter, depth - 1);
+				manager->submit(&run, manager, counter, depth - 1);
+			}
+		}
+	};
+
+	{
+		NOU::NOU_THREAD::ThreadManagerConfiguration workStealingConfiguration;
+		workStealingConfiguration.schedulerMode = NOU::NOU_THREAD::SchedulerMode::WORK_STEALING;
+		workStealingConfiguration.threadCount = 4;
+
+		std::atomic<NOU::sizeType> counter(0);
+		std::atomic<NOU::sizeType> errors(0);
+
+		{
+			NOU::NOU_THREAD::ThreadManager workStealing(workStealingConfiguration);
+
+			IsTrue(workStealing.getConfiguration().schedulerMode ==
+				NOU::NOU_THREAD::SchedulerMode::WORK_STEALING);
+			IsTrue(workStealing.maximumAvailableThreads() == 4);
+			IsTrue(manager.getConfiguration().schedulerMode == NOU::NOU_THREAD::SchedulerMode::TASK_HEAP);
+
+			//tasks that are pushed from outside of the workers go to their inboxes
+			for (NOU::sizeType i = 0; i < 1000; i++)
+			{
+				IsTrue(workStealing.submit([](std::atomic<NOU::sizeType> *c, std::atomic<NOU::sizeType> *e)
+				{
+					//the handler of the worker is found without the singleton knowing the thread
+					if (&NOU::NOU_CORE::getErrorHandler() == &NOU::NOU_CORE::ErrorHandler::getMainThreadHandler())
+						e->fetch_add(1);
+
+					c->fetch_add(1);
+				}, &counter, &errors));
+			}
+
+			while (counter.load() != 1000)
+				std::this_thread::yield();
+
+			IsTrue(errors.load() == 0);
+
+			//2^11 - 1 tasks, all but the first one are pushed by the workers themselves
+			IsTrue(workStealing.submit(&NestedSubmitter::run, &workStealing, &counter, NOU::sizeType(10)));
+
+			while (counter.load() != 1000 + 2047)
+				std::this_thread::yield();
+
+			IsTrue(counter.load() == 1000 + 2047);
+
+			//the manager is destroyed while the workers are still busy, the remaining tasks are discarded
+			IsTrue(workStealing.submit(&NestedSubmitter::run, &workStealing, &counter, NOU::sizeType(16)));
+
+			while (counter.load() < 1000 + 2047 + 100)
+				std::this_thread::yield();
+		}
+
+		IsTrue(counter.load() <= 1000 + 2047 + 131071);
+	}
+
+	{
+		NOU::NOU_THREAD::ThreadManagerConfiguration taskHeapConfiguration;
+		taskHeapConfiguration.threadCount = 2;
+
+		NOU::NOU_THREAD::ThreadManager taskHeap(taskHeapConfiguration);
+
+		std::atomic<NOU::sizeType> counter(0);
+
+		IsTrue(taskHeap.maximumAvailableThreads() == 2);
+		IsTrue(taskHeap.submit(&NestedSubmitter::run, &taskHeap, &counter, NOU::sizeType(6)));
+
+		while (counter.load() != 127)
+			std::this_thread::yield();
+
+		IsTrue(counter.load() == 127);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(ThreadManagerConfiguration)
+{
+	using Clock = std::chrono::steady_clock;
+
+	//waits at most 5 seconds for the condition
+	auto waitFor = [](auto condition)
+	{
+		Clock::time_point deadline = Clock::now() + std::chrono::seconds(5);
+
+		while (!condition() && Clock::now() < deadline)
+			std::this_thread::yield();
+
+		return condition();
+	};
+
+	//submits one task at a time, each one is handed to a thread that has just finished the previous one
+	auto pingPong = [&waitFor](NOU::NOU_THREAD::ThreadManager &manager, NOU::sizeType count)
+	{
+		std::atomic<NOU::sizeType> counter(0);
+
+		for (NOU::sizeType i = 0; i < count; i++)
+		{
+			manager.submit([](std::atomic<NOU::sizeType> *c) { c->fetch_add(1); }, &counter);
+
+			if (!waitFor([&counter, i]() { return counter.load() == i + 1; }))
+				return false;
+		}
+
+		return true;
+	};
+
+	{
+		NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+		configuration.threadCount = 3;
+
+		//threads are created lazily
+		NOU::NOU_THREAD::ThreadManager lazy(configuration);
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+		IsTrue(lazy.currentlyPreparedThreads() == 0);
+		IsTrue(lazy.currentlyAvailableThreads() == 3);
+
+		configuration.prespawnThreads = true;
+
+		NOU::NOU_THREAD::ThreadManager prespawned(configuration);
+
+		IsTrue(waitFor([&prespawned]() { return prespawned.currentlyPreparedThreads() == 3; }));
+		IsTrue(prespawned.currentlyAvailableThreads() == 3);
+		IsTrue(pingPong(prespawned, 100));
+	}
+
+	{
+		//without spinning, the thread waits for m_taskReady each time, a lost wake up would stall the test
+		NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+		configuration.threadCount = 1;
+
+		NOU::NOU_THREAD::ThreadManager blocking(configuration);
+
+		IsTrue(pingPong(blocking, 2000));
+
+		//the tasks are picked up while the thread spins or yields
+		configuration.idleSpinCount = 1000;
+		configuration.idleYieldCount = 100;
+
+		NOU::NOU_THREAD::ThreadManager spinning(configuration);
+
+		IsTrue(pingPong(spinning, 2000));
+	}
+
+	{
+		NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+		configuration.schedulerMode = NOU::NOU_THREAD::SchedulerMode::WORK_STEALING;
+		configuration.threadCount = 2;
+
+		//idle workers park right away
+		{
+			NOU::NOU_THREAD::ThreadManager parking(configuration);
+
+			IsTrue(waitFor([&parking]() { return parking.currentlyAvailableThreads() == 2; }));
+			IsTrue(pingPong(parking, 500));
+		}
+
+		//idle workers keep spinning (or yielding) instead of parking, the shutdown interrupts them
+		configuration.idleSpinCount = NOU::uint32(-1);
+
+		{
+			NOU::NOU_THREAD::ThreadManager spinning(configuration);
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+			IsTrue(spinning.currentlyAvailableThreads() == 0);
+			IsTrue(pingPong(spinning, 500));
+		}
+
+		configuration.idleSpinCount = 0;
+		configuration.idleYieldCount = NOU::uint32(-1);
+
+		{
+			NOU::NOU_THREAD::ThreadManager yielding(configuration);
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+			IsTrue(yielding.currentlyAvailableThreads() == 0);
+			IsTrue(pingPong(yielding, 500));
+		}
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(AdaptiveMutex)
+{
+	IsTrue(sizeof(NOU::NOU_THREAD::AdaptiveMutex) == 4);
+	IsTrue(sizeof(NOU::NOU_THREAD::ByteMutex) == 1);
+
+	auto testMutex = [](auto &mutex)
+	{
+		IsTrue(mutex.tryLock());
+		IsTrue(!mutex.tryLock());
+		mutex.unlock();
+
+		const NOU::sizeType threadCount = 8;
+		const NOU::sizeType iterations = 20000;
+
+		//not atomic on purpose, the mutex needs to protect it
+		NOU::sizeType counter = 0;
+
+		NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> threads;
+
+		for (NOU::sizeType i = 0; i < threadCount; i++)
+		{
+			threads.pushBack(NOU::NOU_THREAD::ThreadWrapper([&mutex, &counter, iterations]()
+			{
+				for (NOU::sizeType j = 0; j < iterations; j++)
+				{
+					mutex.lock();
+					counter++;
+					mutex.unlock();
+				}
+			}));
+		}
+
+		for (NOU::sizeType i = 0; i < threads.size(); i++)
+			threads[i].join();
+
+		IsTrue(counter == threadCount * iterations);
+	};
+
+	NOU::NOU_THREAD::AdaptiveMutex adaptiveMutex;
+	testMutex(adaptiveMutex);
+
+	NOU::NOU_THREAD::ByteMutex byteMutex;
+	testMutex(byteMutex);
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(ParkingLot)
+{
+	int address;
+
+	//nothing is parked
+	IsTrue(!NOU::NOU_THREAD::ParkingLot::unparkOne(&address).m_unparked);
+	IsTrue(NOU::NOU_THREAD::ParkingLot::unparkAll(&address) == 0);
+
+	//validate() prevents parking
+	IsTrue(!NOU::NOU_THREAD::ParkingLot::park(&address, []() { return false; }, []() {}));
+
+	//producer/consumer with a ParkingConditionVariable
+	IsTrue(sizeof(NOU::NOU_THREAD::ParkingConditionVariable) == 1);
+
+	NOU::NOU_THREAD::ByteMutex mutex;
+	NOU::NOU_THREAD::ParkingConditionVariable notEmpty;
+	NOU::NOU_THREAD::ParkingConditionVariable notFull;
+	NOU::NOU_DAT_ALG::Vector<NOU::int32> queue;
+
+	const NOU::int32 elementCount = 10000;
+	const NOU::sizeType consumerCount = 4;
+	std::atomic<NOU::int64> sum(0);
+
+	NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> consumers;
+
+	for (NOU::sizeType i = 0; i < consumerCount; i++)
+	{
+		consumers.pushBack(NOU::NOU_THREAD::ThreadWrapper([&]()
+		{
+			while (true)
+			{
+				mutex.lock();
+				notEmpty.wait(mutex, [&queue]() { return queue.size() > 0; });
+
+				NOU::int32 value = queue.pop();
+
+				mutex.unlock();
+				notFull.notifyOne();
+
+				//-1 is the signal to stop
+				if (value == -1)
+					break;
+
+				sum += value;
+			}
+		}));
+	}
+
+	for (NOU::int32 i = 1; i <= elementCount + NOU::int32(consumerCount); i++)
+	{
+		mutex.lock();
+		notFull.wait(mutex, [&queue]() { return queue.size() < 16; });
+
+		queue.pushBack(i <= elementCount ? i : -1);
+
+		mutex.unlock();
+		notEmpty.notifyOne();
+	}
+
+	for (NOU::sizeType i = 0; i < consumers.size(); i++)
+		consumers[i].join();
+
+	IsTrue(sum == NOU::int64(elementCount) * (elementCount + 1) / 2);
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(SharedMutex)
+{
+	auto testPolicy = [](NOU::NOU_THREAD::SharedMutexPolicy policy)
+	{
+		NOU::NOU_THREAD::SharedMutex mutex(policy);
+
+		IsTrue(mutex.getPolicy() == policy);
+
+		//multiple readers at once, but no writer
+		IsTrue(mutex.tryLockShared());
+		IsTrue(mutex.tryLockShared());
+		IsTrue(!mutex.tryLock());
+		mutex.unlockShared();
+		mutex.unlockShared();
+
+		//a writer excludes everyone else
+		IsTrue(mutex.tryLock());
+		IsTrue(!mutex.tryLock());
+		IsTrue(!mutex.tryLockShared());
+		mutex.unlock();
+
+		{
+			NOU::NOU_THREAD::SharedLock lock(mutex);
+
+			IsTrue(!mutex.tryLock());
+		}
+
+		IsTrue(mutex.tryLock());
+		mutex.unlock();
+
+		const NOU::sizeType threadCount = 8;
+		const NOU::sizeType iterations = 5000;
+
+		//the writers keep both values equal, a reader must never see them differ
+		NOU::sizeType first = 0;
+		NOU::sizeType second = 0;
+		std::atomic<NOU::boolean> consistent(true);
+
+		NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> threads;
+
+		for (NOU::sizeType i = 0; i < threadCount; i++)
+		{
+			threads.pushBack(NOU::NOU_THREAD::ThreadWrapper([&, i]()
+			{
+				for (NOU::sizeType j = 0; j < iterations; j++)
+				{
+					if ((i + j) % 10 == 0)
+					{
+						mutex.lock();
+						first++;
+						second++;
+						mutex.unlock();
+					}
+					else
+					{
+						NOU::NOU_THREAD::SharedLock lock(mutex);
+
+						if (first != second)
+							consistent = false;
+					}
+				}
+			}));
+		}
+
+		for (NOU::sizeType i = 0; i < threads.size(); i++)
+			threads[i].join();
+
+		IsTrue(consistent);
+		IsTrue(first == threadCount * iterations / 10);
+		IsTrue(second == first);
+	};
+
+	testPolicy(NOU::NOU_THREAD::SharedMutexPolicy::READER_PREFERRING);
+	testPolicy(NOU::NOU_THREAD::SharedMutexPolicy::WRITER_PREFERRING);
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(SeqLock)
+{
+	NOU::NOU_THREAD::SeqLock<NOU::NOU_MATH::Mat4> matrix(NOU::NOU_MATH::Mat4::identity());
+
+	IsTrue(matrix.load() == NOU::NOU_MATH::Mat4::identity());
+
+	matrix.store(NOU::NOU_MATH::Mat4::zeroes());
+	IsTrue(matrix.load() == NOU::NOU_MATH::Mat4::zeroes());
+
+	struct Counters
+	{
+		NOU::uint64 m_first;
+		NOU::uint64 m_second;
+	};
+
+	NOU::NOU_THREAD::SeqLock<Counters> counters;
+
+	IsTrue(counters.load().m_first == 0);
+	IsTrue(counters.load().m_second == 0);
+
+	const NOU::uint64 writes = 20000;
+	std::atomic<NOU::boolean> done(false);
+	std::atomic<NOU::boolean> consistent(true);
+
+	NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::ThreadWrapper> threads;
+
+	for (NOU::sizeType i = 0; i < 2; i++)
+	{
+		threads.pushBack(NOU::NOU_THREAD::ThreadWrapper([&]()
+		{
+			for (NOU::uint64 j = 0; j < writes; j++)
+			{
+				counters.modify([](Counters &c)
+				{
+					c.m_first++;
+					c.m_second++;
+				});
+			}
+		}));
+	}
+
+	for (NOU::sizeType i = 0; i < 2; i++)
+	{
+		threads.pushBack(NOU::NOU_THREAD::ThreadWrapper([&]()
+		{
+			while (!done)
+			{
+				Counters c = counters.load();
+
+				if (c.m_first != c.m_second)
+					consistent = false;
+			}
+		}));
+	}
+
+	threads[0].join();
+	threads[1].join();
+
+	done = true;
+
+	threads[2].join();
+	threads[3].join();
+
+	IsTrue(consistent);
+	IsTrue(counters.load().m_first == 2 * writes);
+	IsTrue(counters.load().m_second == 2 * writes);
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(Topology)
+{
+	NOU::NOU_THREAD::CpuSet set;
+
+	IsTrue(set.count() == 0);
+	IsTrue(set.first() == NOU::NOU_THREAD::CpuSet::MAX_CPU_COUNT);
+
+	set.set(3);
+	set.set(70);
+	set.set(NOU::NOU_THREAD::CpuSet::MAX_CPU_COUNT); //ignored
+
+	IsTrue(set.count() == 2);
+	IsTrue(set.isSet(3));
+	IsTrue(set.isSet(70));
+	IsTrue(!set.isSet(4));
+	IsTrue(set.first() == 3);
+
+	set.clear(3);
+	IsTrue(!set.isSet(3));
+	IsTrue(set.first() == 70);
+
+	IsTrue(NOU::NOU_THREAD::Topology::cpuCount() > 0);
+	IsTrue(NOU::NOU_THREAD::Topology::numaNodeCount() > 0);
+
+	//each CPU belongs to exactly one node and the CPUs are ordered by their node
+	NOU::sizeType cpusInNodes = 0;
+
+	for (NOU::sizeType i = 0; i < NOU::NOU_THREAD::Topology::numaNodeCount(); i++)
+		cpusInNodes += NOU::NOU_THREAD::Topology::numaNodeCpus(i).count();
+
+	IsTrue(cpusInNodes == NOU::NOU_THREAD::Topology::cpuCount());
+
+	for (NOU::sizeType i = 1; i < NOU::NOU_THREAD::Topology::cpuCount(); i++)
+	{
+		IsTrue(NOU::NOU_THREAD::Topology::numaNodeOf(NOU::NOU_THREAD::Topology::cpuAt(i - 1)) <= 
+			NOU::NOU_THREAD::Topology::numaNodeOf(NOU::NOU_THREAD::Topology::cpuAt(i)));
+	}
+
+#if NOU_OS == NOU_OS_LINUX
+	NOU::NOU_THREAD::ThreadWrapper thread([]()
+	{
+		NOU::NOU_THREAD::CpuSet cpus;
+		cpus.set(NOU::NOU_THREAD::Topology::cpuAt(0));
+
+		IsTrue(NOU::NOU_THREAD::Topology::setCurrentThreadAffinity(cpus));
+		IsTrue(NOU::NOU_THREAD::Topology::setCurrentThreadName("nou-unittest-with-a-long-name"));
+	});
+
+	thread.join();
+#endif
+
+	NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+
+	IsTrue(configuration.threadCount == 0);
+	IsTrue(configuration.threadAffinity == NOU::NOU_THREAD::ThreadAffinity::NONE);
+	IsTrue(configuration.affinityMasks.size() == 0);
+	IsTrue(configuration.preferLocalStealing);
+	IsTrue(configuration.idleSpinCount == 0);
+	IsTrue(configuration.idleYieldCount == 0);
+	IsTrue(!configuration.prespawnThreads);
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(SchedulerStatistics)
+{
+	using Histogram = NOU::NOU_THREAD::LatencyHistogram;
+
+	//the lower bound of a bucket is at most 1 / SUB_BUCKET_COUNT smaller than the values in the bucket
+	for (NOU::uint64 value : { NOU::uint64(0), NOU::uint64(7), NOU::uint64(8), NOU::uint64(1000), 
+		NOU::uint64(123456789), NOU::uint64(1) << 40, ~NOU::uint64(0) })
+	{
+		NOU::uint64 lowerBound = Histogram::bucketLowerBound(Histogram::bucketOf(value));
+
+		IsTrue(lowerBound <= value);
+		IsTrue(value - lowerBound <= value / Histogram::SUB_BUCKET_COUNT);
+	}
+
+	IsTrue(Histogram::bucketOf(~NOU::uint64(0)) == Histogram::BUCKET_COUNT - 1);
+
+	Histogram histogram;
+
+	IsTrue(histogram.totalCount() == 0);
+	IsTrue(histogram.percentile(50) == 0);
+
+	for (NOU::uint64 i = 1; i <= 1000; i++)
+		histogram.record(i);
+
+	IsTrue(histogram.totalCount() == 1000);
+	IsTrue(histogram.percentile(0) == 1);
+	IsTrue(histogram.percentile(50) <= 500);
+	IsTrue(histogram.percentile(50) >= 500 - 500 / Histogram::SUB_BUCKET_COUNT);
+	IsTrue(histogram.percentile(100) <= 1000);
+	IsTrue(histogram.percentile(100) >= 1000 - 1000 / Histogram::SUB_BUCKET_COUNT);
+
+	Histogram other;
+	other.record(5);
+	histogram.merge(other);
+
+	IsTrue(histogram.totalCount() == 1001);
+	IsTrue(histogram.countAt(Histogram::bucketOf(5)) == 2);
+
+	//the statistics of the thread manager
+	std::atomic<NOU::sizeType> counter(0);
+	const NOU::sizeType count = 100;
+
+	for (NOU::sizeType i = 0; i < count; i++)
+	{
+		NOU::NOU_THREAD::getThreadManager().submit([](std::atomic<NOU::sizeType> *c)
+		{
+			(*c)++;
+		}, &counter);
+	}
+
+	while (counter != count)
+		std::this_thread::yield();
+
+	NOU::NOU_THREAD::SchedulerStatistics statistics = NOU::NOU_THREAD::getThreadManager().getStatistics();
+
+#ifdef NOU_ENABLE_THREAD_INSTRUMENTATION
+	IsTrue(statistics.enabled);
+	IsTrue(statistics.workers.size() == NOU::NOU_THREAD::getThreadManager().maximumAvailableThreads());
+
+	//a task is only counted once the thread returns from it
+	for (NOU::sizeType i = 0; i < 100000 && statistics.totalTasksExecuted() < count; i++)
+	{
+		std::this_thread::yield();
+		statistics = NOU::NOU_THREAD::getThreadManager().getStatistics();
+	}
+
+	IsTrue(statistics.totalTasksExecuted() >= count);
+	IsTrue(statistics.totalQueueLatency().totalCount() == statistics.totalTasksExecuted());
+	IsTrue(statistics.totalExecutionLatency().totalCount() == statistics.totalTasksExecuted());
+#else
+	IsTrue(!statistics.enabled);
+	IsTrue(statistics.workers.size() == 0);
+	IsTrue(statistics.heapHighWaterMark == 0);
+#endif
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(AsyncTaskResult)
+{
+	using State = NOU::NOU_THREAD::AsyncTaskResultState;
+
+	auto waitUntilDone = [](const NOU::NOU_THREAD::internal::AbstractAsyncTaskResult &result)
+	{
+		for (NOU::sizeType i = 0; i < 100000 && result.getState() != State::DONE; i++)
+			std::this_thread::yield();
+
+		return result.getState() == State::DONE;
+	};
+
+	{
+		NOU::NOU_THREAD::AsyncTaskResult<NOU::int32, NOU::int32(*)(NOU::int32), NOU::int32>
+			result(+[](NOU::int32 value) { return value * 2; }, 5);
+
+		//continuations are executed without a thread waiting for them
+		auto first = result.then([](const NOU::int32 &value) { return value + 1; });
+		auto second = first.then([](const NOU::int32 &value) { return NOU::int64(value) * 3; });
+		auto third = second.then([](const NOU::int64 &value) { return value - 3; });
+
+		IsTrue(waitUntilDone(third));
+		IsTrue(result.getState() == State::DONE);
+		IsTrue(third.getResult() == 30);
+		IsTrue(first.getResult() == 11);
+	}
+
+	{
+		NOU::NOU_THREAD::AsyncTaskResult<NOU::int32, NOU::int32(*)(NOU::int32), NOU::int32>
+			result(+[](NOU::int32 value) { return value; }, 7);
+
+		std::atomic<NOU::int32> counter(0);
+
+		//void continuations
+		auto first = result.then([&counter](const NOU::int32 &value) { counter += value; });
+		auto second = first.then([&counter]() { counter += 1; });
+
+		//getResult() on a continuation forces the execution of the whole chain
+		second.getResult();
+
+		IsTrue(counter == 8);
+		IsTrue(first.getState() == State::DONE);
+	}
+
+	{
+		NOU::NOU_THREAD::AsyncTaskResult<NOU::int32, NOU::int32(*)(NOU::int32), NOU::int32>
+			a(+[](NOU::int32 value) { return value; }, 1);
+		NOU::NOU_THREAD::AsyncTaskResult<NOU::int32, NOU::int32(*)(NOU::int32), NOU::int32>
+			b(+[](NOU::int32 value) { return value; }, 2);
+		NOU::NOU_THREAD::AsyncTaskResult<NOU::int32, NOU::int32(*)(NOU::int32), NOU::int32>
+			c(+[](NOU::int32 value) { return value; }, 3);
+
+		auto all = NOU::NOU_THREAD::whenAll(a, b, c);
+		auto sum = all.then([&a, &b, &c]() { return a.getResult() + b.getResult() + c.getResult(); });
+
+		IsTrue(waitUntilDone(sum));
+		IsTrue(a.getState() == State::DONE);
+		IsTrue(b.getState() == State::DONE);
+		IsTrue(c.getState() == State::DONE);
+		IsTrue(sum.getResult() == 6);
+
+		NOU::NOU_DAT_ALG::Vector<NOU::NOU_THREAD::internal::AbstractAsyncTaskResult*> results;
+		results.pushBack(&a);
+		results.pushBack(&b);
+
+		//all dependencies have already finished
+		auto allVec = NOU::NOU_THREAD::whenAll(results);
+		allVec.getResult();
+		IsTrue(allVec.getState() == State::DONE);
+	}
+
+	{
+		std::atomic<NOU::boolean> release(false);
+
+		NOU::NOU_THREAD::AsyncTaskResult<void, void(*)(std::atomic<NOU::boolean>*), std::atomic<NOU::boolean>*>
+			slow(+[](std::atomic<NOU::boolean> *flag) 
+			{ 
+				while (!flag->load()) 
+					std::this_thread::yield(); 
+			}, &release);
+
+		NOU::NOU_THREAD::AsyncTaskResult<NOU::int32, NOU::int32(*)(NOU::int32), NOU::int32>
+			fast(+[](NOU::int32 value) { return value; }, 1);
+
+		auto any = NOU::NOU_THREAD::whenAny(slow, fast);
+
+		IsTrue(waitUntilDone(any));
+		IsTrue(any.getFirstFinishedDependency() == 1);
+		IsTrue(slow.getState() != State::DONE);
+
+		release = true;
+		slow.getResult();
+	}
+
+	{
+		std::atomic<NOU::boolean> release(false);
+		std::atomic<NOU::int32> counter(0);
+
+		NOU::NOU_THREAD::AsyncTaskResult<void, void(*)(std::atomic<NOU::boolean>*), std::atomic<NOU::boolean>*>
+			parent(+[](std::atomic<NOU::boolean> *flag)
+			{
+				while (!flag->load())
+					std::this_thread::yield();
+			}, &release);
+
+		//dropping continuations and groups while the parent is still running deregisters them
+		{
+			auto continuation = parent.then([&counter]() { counter += 1; });
+			auto all = NOU::NOU_THREAD::whenAll(parent);
+			auto any = NOU::NOU_THREAD::whenAny(parent);
+		}
+
+		IsTrue(parent.getState() != State::DONE);
+
+		auto kept = parent.then([&counter]() { counter += 10; });
+
+		release = true;
+		parent.getResult();
+		kept.getResult();
+
+		IsTrue(counter == 10);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+//counts its live instances, it is too large to be stored inline by an InlineTask
+struct InlineTaskTracker
+{
+	static std::atomic<NOU::int64> s_instances;
+
+	NOU::int32 m_padding[32];
+	std::atomic<NOU::sizeType> *m_executed;
+
+	explicit InlineTaskTracker(std::atomic<NOU::sizeType> *executed) :
+		m_padding{},
+		m_executed(executed)
+	{
+		s_instances++;
+	}
+
+	InlineTaskTracker(const InlineTaskTracker &other) :
+		m_padding{},
+		m_executed(other.m_executed)
+	{
+		s_instances++;
+	}
+
+	~InlineTaskTracker()
+	{
+		s_instances--;
+	}
+
+	void operator () ()
+	{
+		m_executed->fetch_add(1);
+	}
+};
+
+std::atomic<NOU::int64> InlineTaskTracker::s_instances(0);
+
+TEST_METHOD(InlineTask)
+{
+	NOU::int32 value = 0;
+
+	NOU::NOU_THREAD::InlineTask small([](NOU::int32 *out, NOU::int32 add) { *out += add; }, &value, 5);
+
+	IsTrue(small.isValid());
+	IsTrue(small.isInline());
+
+	small.execute();
+	IsTrue(value == 5);
+
+	struct Large
+	{
+		NOU::int32 data[32];
+	};
+
+	Large large{};
+	large.data[0] = 7;
+
+	NOU::NOU_THREAD::InlineTask big([](NOU::int32 *out, Large l) { *out += l.data[0]; }, &value, large);
+
+	IsTrue(big.isValid());
+	IsTrue(!big.isInline());
+
+	NOU::NOU_THREAD::InlineTask moved(NOU::NOU_CORE::move(big));
+
+	IsTrue(!big.isValid());
+	IsTrue(!moved.isInline());
+
+	moved.execute();
+	IsTrue(value == 12);
+
+	small = NOU::NOU_CORE::move(moved);
+
+	IsTrue(small.isValid());
+	IsTrue(!moved.isValid());
+
+	small.execute();
+	IsTrue(value == 19);
+
+	IsTrue(!NOU::NOU_THREAD::InlineTask().isValid());
+
+	std::atomic<NOU::sizeType> counter(0);
+
+	for (NOU::sizeType i = 0; i < 1000; i++)
+	{
+		IsTrue(NOU::NOU_THREAD::getThreadManager().submit([](std::atomic<NOU::sizeType> *c, NOU::sizeType add) 
+		{ 
+			c->fetch_add(add); 
+		}, &counter, NOU::sizeType(1)));
+	}
+
+	for (NOU::sizeType i = 0; i < 5000 && counter.load() != 1000; i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	IsTrue(counter.load() == 1000);
+
+	for (NOU::NOU_THREAD::SchedulerMode mode : { NOU::NOU_THREAD::SchedulerMode::TASK_HEAP, 
+		NOU::NOU_THREAD::SchedulerMode::WORK_STEALING })
+	{
+		NOU::NOU_THREAD::ThreadManagerConfiguration configuration;
+		configuration.schedulerMode = mode;
+		configuration.threadCount = 1;
+
+		std::atomic<NOU::sizeType> executed(0);
+
+		{
+			NOU::NOU_THREAD::ThreadManager manager(configuration);
+
+			//keeps the only thread busy while the manager is destroyed
+			IsTrue(manager.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+
+			for (NOU::sizeType i = 0; i < 100; i++)
+				IsTrue(manager.submit(InlineTaskTracker(&executed)));
+		}
+
+		//the tasks that were never executed have been destroyed by the manager
+		IsTrue(executed.load() < 100);
+		IsTrue(InlineTaskTracker::s_instances.load() == 0);
+	}
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+#ifdef NOU_EXISTS_FEATURE_COROUTINES
+TEST_METHOD(Coroutine)
+{
+	using NOU::NOU_THREAD::Co;
+
+	auto add = [](NOU::int32 a, NOU::int32 b) -> Co<NOU::int32>
+	{
+		co_return a + b;
+	};
+
+	IsTrue(add(1, 2).getResult() == 3);
+
+	//awaiting other coroutines, switching to a worker in between
+	auto sum = [](decltype(add) *function) -> Co<NOU::int32>
+	{
+		NOU::int32 first = co_await (*function)(1, 2);
+
+		co_await NOU::NOU_THREAD::schedule();
+
+		NOU::int32 second = co_await (*function)(first, 10);
+
+		co_return second;
+	};
+
+	Co<NOU::int32> coroutine = sum(&add);
+	IsTrue(coroutine.isValid());
+	IsTrue(coroutine.getResult() == 13);
+	IsTrue(coroutine.getResult() == 13);
+
+	//awaiting an async task result
+	auto awaitTask = []() -> Co<NOU::int64>
+	{
+		NOU::NOU_THREAD::AsyncTaskResult<NOU::int64, NOU::int64(*)(NOU::int64), NOU::int64>
+			result(+[](NOU::int64 value) { return value * 3; }, 14);
+
+		NOU::int64 value = co_await result;
+
+		co_return value + 1;
+	};
+
+	IsTrue(awaitTask().getResult() == 43);
+
+	//timer
+	auto sleep = [](NOU::uint64 milliseconds) -> Co<>
+	{
+		co_await NOU::NOU_THREAD::sleepFor(milliseconds);
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	sleep(20).getResult();
+	IsTrue(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+	//detached coroutines
+	std::atomic<NOU::sizeType> counter(0);
+
+	auto increment = [](std::atomic<NOU::sizeType> *counter) -> Co<>
+	{
+		co_await NOU::NOU_THREAD::sleepFor(1);
+
+		counter->fetch_add(1);
+	};
+
+	for (NOU::sizeType i = 0; i < 1000; i++)
+		NOU::NOU_THREAD::spawn(increment(&counter));
+
+	for (NOU::sizeType i = 0; i < 5000 && counter.load() != 1000; i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	IsTrue(counter.load() == 1000);
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+#endif
+
+TEST_METHOD(WorkStealingDeque)
+{
+	using Element = NOU::NOU_DAT_ALG::Pair<NOU::int64, NOU::int64>;
+
+	NOU::NOU_THREAD::WorkStealingDeque<Element> deque;
+
+	IsTrue(deque.empty());
+	IsTrue(deque.capacity() == NOU::NOU_THREAD::WorkStealingDeque<Element>::MIN_CAPACITY);
+
+	Element element(0, 0);
+	IsTrue(!deque.popBack(element));
+	IsTrue(!deque.steal(element));
+
+	//push more than MIN_CAPACITY elements to force the deque to grow
+	for (NOU::int64 i = 0; i < 100; i++)
+		deque.pushBack(Element(i, -i));
+
+	IsTrue(deque.size() == 100);
+	IsTrue(deque.capacity() >= 100);
+
+	//owner pops LIFO
+	IsTrue(deque.popBack(element));
+	IsTrue(element.dataOne == 99);
+	IsTrue(element.dataTwo == -99);
+
+	//thieves steal FIFO
+	IsTrue(deque.steal(element));
+	IsTrue(element.dataOne == 0);
+	IsTrue(element.dataTwo == 0);
+
+	IsTrue(deque.steal(element));
+	IsTrue(element.dataOne == 1);
+
+	IsTrue(deque.size() == 97);
+
+	for (NOU::int64 i = 98; i >= 2; i--)
+	{
+		IsTrue(deque.popBack(element));
+		IsTrue(element.dataOne == i);
+	}
+
+	IsTrue(deque.empty());
+	IsTrue(!deque.popBack(element));
+
+	//concurrent stealing: every element must be taken exactly once
+	NOU::NOU_THREAD::WorkStealingDeque<NOU::int64> concurrentDeque;
+	const NOU::int64 elementCount = 10000;
+	std::atomic<NOU::int64> stolenSum(0);
+	std::atomic<NOU::int64> takenCount(0);
+	std::atomic<NOU::boolean> ownerDone(false);
+
+	auto thief = [&]()
+	{
+		NOU::int64 value;
+
+		while (!ownerDone || !concurrentDeque.empty())
+		{
+			if (concurrentDeque.steal(value))
+			{
+				stolenSum += value;
+				takenCount++;
+			}
+		}
+	};
+
+	NOU::NOU_THREAD::ThreadWrapper thief0(thief);
+	NOU::NOU_THREAD::ThreadWrapper thief1(thief);
+
+	NOU::int64 ownerSum = 0;
+	NOU::int64 value;
+
+	for (NOU::int64 i = 1; i <= elementCount; i++)
+	{
+		concurrentDeque.pushBack(i);
+
+		if (i % 3 == 0 && concurrentDeque.popBack(value))
+		{
+			ownerSum += value;
+			takenCount++;
+		}
+	}
+
+	while (concurrentDeque.popBack(value))
+	{
+		ownerSum += value;
+		takenCount++;
+	}
+
+	ownerDone = true;
+
+	thief0.join();
+	thief1.join();
+
+	IsTrue(takenCount == elementCount);
+	IsTrue(ownerSum + stolenSum == elementCount * (elementCount + 1) / 2);
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+static NOU::int64 taskQueueTestSquare(NOU::int64 i)
+{
+	return i * i;
+}
+
+static std::atomic<NOU::int64> taskQueueTestSum(0);
+
+static void taskQueueTestAdd(NOU::int64 i)
+{
+	taskQueueTestSum += i;
+}
+
+TEST_METHOD(TaskQueue)
+{
+	using SquareQueue = NOU::NOU_THREAD::TaskQueue<NOU::int64, NOU::int64(*)(NOU::int64), 
+		NOU::NOU_THREAD::TaskQueueAccumulators::FunctionPtr<NOU::int64>, NOU::int64>;
+
+	const NOU::int64 count = 1000;
+	const NOU::int64 expected = count * (count + 1) * (2 * count + 1) / 6;
+
+	//ordered mode
+	SquareQueue ordered(NOU::NOU_THREAD::TaskQueueAccumulators::addition<NOU::int64>);
+
+	for (NOU::int64 i = 1; i <= count; i++)
+		ordered.pushTask(NOU::NOU_THREAD::makeTask(&taskQueueTestSquare, i));
+
+	IsTrue(ordered.getResult() == expected);
+
+	//unordered parallel mode, the results must be the same
+	SquareQueue parallel(NOU::NOU_THREAD::TaskQueueAccumulators::addition<NOU::int64>, 1, 
+		NOU::NOU_THREAD::TaskQueueMode::UNORDERED_PARALLEL, 4);
+
+	for (NOU::int64 i = 1; i <= count; i++)
+		parallel.pushTask(NOU::NOU_THREAD::makeTask(&taskQueueTestSquare, i));
+
+	IsTrue(parallel.getResult() == expected);
+
+	//the queue can be used again after the result was retrieved
+	for (NOU::int64 i = 1; i <= count; i++)
+		parallel.pushTask(NOU::NOU_THREAD::makeTask(&taskQueueTestSquare, i));
+
+	IsTrue(parallel.getResult() == 2 * expected);
+
+	//default concurrency and a void result
+	NOU::NOU_THREAD::TaskQueue<void, void(*)(NOU::int64), 
+		NOU::NOU_THREAD::TaskQueueAccumulators::FunctionPtr<NOU::NOU_THREAD::TaskQueueAccumulators::Void>, 
+		NOU::int64> voidQueue(1, NOU::NOU_THREAD::TaskQueueMode::UNORDERED_PARALLEL);
+
+	for (NOU::int64 i = 1; i <= count; i++)
+		voidQueue.pushTask(NOU::NOU_THREAD::makeTask(&taskQueueTestAdd, i));
+
+	voidQueue.getResult();
+
+	IsTrue(taskQueueTestSum == count * (count + 1) / 2);
+
+	NOU_CHECK_ERROR_HANDLER;
+}
+
+TEST_METHOD(Parallel)
+{
+	//parallelFor: every index must be visited exactly once
+	const NOU::sizeType count = 10000;
+	std::atomic<NOU::int32> visited[count] = {};
+
+	NOU::NOU_THREAD::parallelFor(0, count, [&visited](NOU::sizeType i)
+	{
+		visited[i]++;
+	});
+
+	NOU::boolean allVisitedOnce = true;
+
+	for (NOU::sizeType i = 0; i < count; i++)
+		allVisitedOnce = allVisitedOnce && visited[i] == 1;
+
+	IsTrue(allVisitedOnce);
+
+	//explicit grain and a range that does not start at 0
+	std::atomic<NOU::sizeType> sum(0);
+
+	NOU::NOU_THREAD::parallelFor(100, 200, 7, [&sum](NOU::sizeType i)
+	{
+		sum += i;
+	});
+
+	IsTrue(sum == 14950);
+
+	//empty range
+	NOU::NOU_THREAD::parallelFor(5, 5, [](NOU::sizeType)
+	{
+		IsTrue(false);
+	});
+
+	//parallelReduce
+	IsTrue(NOU::NOU_THREAD::parallelReduce(1, count + 1, 0, [](NOU::sizeType i)
+	{
+		return static_cast<NOU::int64>(i);
+	}) == static_cast<NOU::int64>(count * (count + 1) / 2));
+
+	IsTrue(NOU::NOU_THREAD::parallelReduce(1, 11, 3, [](NOU::sizeType i)
+	{
+		return static_cast<NOU::int64>(i);
+	}, NOU::NOU_THREAD::TaskQueueAccumulators::multiply<NOU::int64>) == 3628800);
+
+	IsTrue(NOU::NOU_THREAD::parallelReduce(0, 0, 0, [](NOU::sizeType i)
+	{
+		return static_cast<NOU::int64>(i);
+	}) == 0);
+
+	//the accumulation must keep the order of the chunks
+	NOU::NOU_DAT_ALG::String8 string = NOU::NOU_THREAD::parallelReduce(0, 26, 4, [](NOU::sizeType i)
+	{
+		return NOU::NOU_DAT_ALG::String8(static_cast<NOU::char8>('a' + i));
+	});
+
+	IsTrue(string == "abcdefghijklmnopqrstuvwxyz");
+
+	//parallelQuicksort
+	const NOU::sizeType sortCount = 50000;
+	NOU::NOU_DAT_ALG::Vector<NOU::int32> random(sortCount);
+	NOU::NOU_DAT_ALG::Vector<NOU::int32> sorted(sortCount);
+	NOU::NOU_DAT_ALG::Vector<NOU::int32> duplicates(sortCount);
+
+	NOU::uint32 state = 12345;
+
+	for (NOU::sizeType i = 0; i < sortCount; i++)
+	{
+		state = state * 1103515245 + 12345;
+
+		random.pushBack(static_cast<NOU::int32>(state >> 8));
+		sorted.pushBack(static_cast<NOU::int32>(i));
+		duplicates.pushBack(static_cast<NOU::int32>(state % 5));
+	}
+
+	NOU::NOU_THREAD::parallelQuicksort(random);
+	NOU::NOU_THREAD::parallelQuicksort(sorted);
+	NOU::NOU_THREAD::parallelQuicksort(duplicates.data(), duplicates.size());
+
+	NOU::boolean isSorted = true;
+
+	for (NOU::sizeType i = 1; i < sortCount; i++)
+	{
+		isSorted = isSorted && random[i - 1] <= random[i];
+		isSorted = isSorted && sorted[i - 1] <= sorted[i];
+		isSorted = isSorted && duplicates[i - 1] <= duplicates[i];
+	}
+
+	IsTrue(isSorted);
+
+	//descending using a comparator
+	NOU::NOU_THREAD::parallelQuicksort(random, NOU::NOU_DAT_ALG::genericInvertedComparator<NOU::int32>);
+
+	isSorted = true;
+
+	for (NOU::sizeType i = 1; i < sortCount; i++)
+		isSorted = isSorted && random[i - 1] >= random[i];
+
+	IsTrue(isSorted);
+
 	NOU_CHECK_ERROR_HANDLER;
 }
 